@@ -45,6 +45,9 @@
 #include <map>
 #include <string>
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 namespace cluster {
   class BlurredClustering;
 }
@@ -56,8 +59,15 @@ public:
 private:
   void produce(art::Event& evt) override;
 
+  /// Blurs the image of the hits of a plane and returns the clusters found in it
+  std::vector<art::PtrVector<recob::Hit>> ClusterPlane(
+    std::pair<int, int> const& plane,
+    std::vector<art::Ptr<recob::Hit>> const& hits,
+    int readoutWindowSize);
+
   std::string const fHitsModuleLabel, fTrackModuleLabel, fVertexModuleLabel, fPFParticleModuleLabel;
   bool const fCreateDebugPDF, fMergeClusters, fGlobalTPCRecon, fShowerReconOnly;
+  bool const fRunParallel; ///< cluster the planes concurrently (not with CreateDebugPDF)
 
   // Create instances of algorithm classes to perform the clustering
   cluster::BlurredClusteringAlg fBlurredClusteringAlg;
@@ -75,6 +85,7 @@ cluster::BlurredClustering::BlurredClustering(fhicl::ParameterSet const& pset)
   , fMergeClusters{pset.get<bool>("MergeClusters")}
   , fGlobalTPCRecon{pset.get<bool>("GlobalTPCRecon")}
   , fShowerReconOnly{pset.get<bool>("ShowerReconOnly")}
+  , fRunParallel{pset.get<bool>("RunParallel", false)}
   , fBlurredClusteringAlg{pset.get<fhicl::ParameterSet>("BlurredClusterAlg")}
   , fMergeClusterAlg{pset.get<fhicl::ParameterSet>("MergeClusterAlg")}
   , fTrackShowerSeparationAlg{pset.get<fhicl::ParameterSet>("TrackShowerSeparationAlg")}
@@ -160,54 +171,24 @@ cluster::BlurredClustering::produce(art::Event& evt)
     planeToHits[std::make_pair(planeNo, tpc)].push_back(hitToCluster);
   }
 
-  // Loop over views
-  for (auto const& [plane, hits] : planeToHits) {
-    std::vector<art::PtrVector<recob::Hit>> finalClusters;
-
-    // Implement the algorithm
-    if (hits.size() >= fBlurredClusteringAlg.GetMinSize()) {
-
-      // Convert hit map to TH2 histogram and blur it
-      auto const image = fBlurredClusteringAlg.ConvertRecobHitsToVector(hits, readoutWindowSize);
-      auto const blurred = fBlurredClusteringAlg.GaussianBlur(image);
-
-      // Find clusters in histogram
-      std::vector<std::vector<int>>
-        allClusterBins; // Vector of clusters (clusters are vectors of hits)
-      int numClusters = fBlurredClusteringAlg.FindClusters(blurred, allClusterBins);
-      mf::LogVerbatim("Blurred Clustering") << "Found " << numClusters << " clusters" << std::endl;
-
-      // Create output clusters from the vector of clusters made in FindClusters
-      std::vector<art::PtrVector<recob::Hit>> planeClusters;
-      fBlurredClusteringAlg.ConvertBinsToClusters(image, allClusterBins, planeClusters);
-
-      // Use the cluster merging algorithm
-      if (fMergeClusters) {
-        int numMergedClusters = fMergeClusterAlg.MergeClusters(planeClusters, finalClusters);
-        mf::LogVerbatim("Blurred Clustering")
-          << "After merging, there are " << numMergedClusters << " clusters" << std::endl;
-      }
-      else
-        finalClusters = planeClusters;
-
-      // Make the debug PDF
-      if (fCreateDebugPDF) {
-        std::stringstream name;
-        name << "blurred_image";
-        TH2F* imageHist = fBlurredClusteringAlg.MakeHistogram(image, TString{name.str()});
-        name << "_convolved";
-        TH2F* blurredHist = fBlurredClusteringAlg.MakeHistogram(blurred, TString{name.str()});
-        auto const [planeNo, tpc] = plane;
-        fBlurredClusteringAlg.SaveImage(imageHist, 1, tpc, planeNo);
-        fBlurredClusteringAlg.SaveImage(blurredHist, 2, tpc, planeNo);
-        fBlurredClusteringAlg.SaveImage(blurredHist, allClusterBins, 3, tpc, planeNo);
-        fBlurredClusteringAlg.SaveImage(imageHist, finalClusters, 4, tpc, planeNo);
-        imageHist->Delete();
-        blurredHist->Delete();
-      }
-
-    } // End min hits check
+  // Cluster the planes; the debug PDF is drawn one plane at a time
+  std::vector<decltype(planeToHits)::value_type const*> planes;
+  for (auto const& planeHits : planeToHits)
+    planes.push_back(&planeHits);
+  std::vector<std::vector<art::PtrVector<recob::Hit>>> planeFinalClusters(planes.size());
+  auto clusterPlanes = [&](const tbb::blocked_range<std::size_t>& range) {
+    for (std::size_t iPlane = range.begin(); iPlane < range.end(); ++iPlane) {
+      auto const& [plane, hits] = *planes[iPlane];
+      planeFinalClusters[iPlane] = ClusterPlane(plane, hits, readoutWindowSize);
+    }
+  };
+  if (fRunParallel && !fCreateDebugPDF)
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, planes.size(), 1), clusterPlanes);
+  else
+    clusterPlanes(tbb::blocked_range<std::size_t>(0, planes.size()));
 
+  // Loop over views
+  for (auto const& finalClusters : planeFinalClusters) {
     // Make the output cluster objects
     for (auto const& clusterHits : finalClusters) {
       if (clusterHits.empty()) continue;
@@ -247,4 +228,55 @@ cluster::BlurredClustering::produce(art::Event& evt)
   evt.put(std::move(associations));
 }
 
+std::vector<art::PtrVector<recob::Hit>>
+cluster::BlurredClustering::ClusterPlane(std::pair<int, int> const& plane,
+                                         std::vector<art::Ptr<recob::Hit>> const& hits,
+                                         int const readoutWindowSize)
+{
+  std::vector<art::PtrVector<recob::Hit>> finalClusters;
+
+  // Implement the algorithm
+  if (hits.size() < fBlurredClusteringAlg.GetMinSize()) return finalClusters;
+
+  // Convert hit map to an image and blur it
+  auto const image = fBlurredClusteringAlg.ConvertRecobHitsToImage(hits, readoutWindowSize);
+  auto const blurred = fBlurredClusteringAlg.GaussianBlur(image);
+
+  // Find clusters in histogram
+  std::vector<std::vector<int>> allClusterBins; // Vector of clusters (clusters are vectors of hits)
+  int numClusters = fBlurredClusteringAlg.FindClusters(image, blurred, allClusterBins);
+  mf::LogVerbatim("Blurred Clustering") << "Found " << numClusters << " clusters" << std::endl;
+
+  // Create output clusters from the vector of clusters made in FindClusters
+  std::vector<art::PtrVector<recob::Hit>> planeClusters;
+  fBlurredClusteringAlg.ConvertBinsToClusters(image, allClusterBins, planeClusters);
+
+  // Use the cluster merging algorithm
+  if (fMergeClusters) {
+    int numMergedClusters = fMergeClusterAlg.MergeClusters(planeClusters, finalClusters);
+    mf::LogVerbatim("Blurred Clustering")
+      << "After merging, there are " << numMergedClusters << " clusters" << std::endl;
+  }
+  else
+    finalClusters = planeClusters;
+
+  // Make the debug PDF
+  if (fCreateDebugPDF) {
+    std::stringstream name;
+    name << "blurred_image";
+    TH2F* imageHist = fBlurredClusteringAlg.MakeHistogram(image, image.charge, TString{name.str()});
+    name << "_convolved";
+    TH2F* blurredHist = fBlurredClusteringAlg.MakeHistogram(image, blurred, TString{name.str()});
+    auto const [planeNo, tpc] = plane;
+    fBlurredClusteringAlg.SaveImage(imageHist, 1, tpc, planeNo);
+    fBlurredClusteringAlg.SaveImage(blurredHist, 2, tpc, planeNo);
+    fBlurredClusteringAlg.SaveImage(blurredHist, allClusterBins, 3, tpc, planeNo);
+    fBlurredClusteringAlg.SaveImage(imageHist, finalClusters, 4, tpc, planeNo);
+    imageHist->Delete();
+    blurredHist->Delete();
+  }
+
+  return finalClusters;
+}
+
 DEFINE_ART_MODULE(cluster::BlurredClustering)
@@ -498,6 +498,8 @@ namespace lar_cluster3d {
     float m_makeHitsTime;          ///< Keeps track of time to build 3D hits
     float m_buildNeighborhoodTime; ///< Keeps track of time to build epsilon neighborhood
     float m_dbscanTime;            ///< Keeps track of time to run DBScan
+    float m_buildNeighborhoodCPUTime; ///< Keeps track of cpu time to build epsilon neighborhood
+    float m_dbscanCPUTime;         ///< Keeps track of cpu time to run DBScan
     float m_clusterMergeTime;      ///< Keeps track of the time to merge clusters
     float m_pathFindingTime;       ///< Keeps track of the path finding time
     float m_finishTime;            ///< Keeps track of time to run output module
@@ -674,6 +676,9 @@ namespace lar_cluster3d {
       m_buildNeighborhoodTime = m_clusterAlg->getTimeToExecute(IClusterAlg::BUILDHITTOHITMAP);
       m_dbscanTime = m_clusterAlg->getTimeToExecute(IClusterAlg::RUNDBSCAN) +
                      m_clusterAlg->getTimeToExecute(IClusterAlg::BUILDCLUSTERINFO);
+      m_buildNeighborhoodCPUTime = m_clusterAlg->getCPUTimeToExecute(IClusterAlg::BUILDHITTOHITMAP);
+      m_dbscanCPUTime = m_clusterAlg->getCPUTimeToExecute(IClusterAlg::RUNDBSCAN) +
+                        m_clusterAlg->getCPUTimeToExecute(IClusterAlg::BUILDCLUSTERINFO);
       m_clusterMergeTime = m_clusterMergeAlg->getTimeToExecute();
       m_pathFindingTime = m_clusterPathAlg->getTimeToExecute();
       m_finishTime = theClockFinish.accumulated_real_time();
@@ -684,7 +689,9 @@ namespace lar_cluster3d {
       mf::LogDebug("Cluster3D") << "*** Cluster3D total time: " << m_totalTime
                                 << ", art: " << m_artHitsTime << ", make: " << m_makeHitsTime
                                 << ", build: " << m_buildNeighborhoodTime
+                                << " (cpu " << m_buildNeighborhoodCPUTime << ")"
                                 << ", clustering: " << m_dbscanTime
+                                << " (cpu " << m_dbscanCPUTime << ")"
                                 << ", merge: " << m_clusterMergeTime
                                 << ", path: " << m_pathFindingTime << ", finish: " << m_finishTime
                                 << std::endl;
@@ -710,6 +717,8 @@ namespace lar_cluster3d {
     m_pRecoTree->Branch("makeHitsTime", &m_makeHitsTime, "time/F");
     m_pRecoTree->Branch("buildneigborhoodTime", &m_buildNeighborhoodTime, "time/F");
     m_pRecoTree->Branch("dbscanTime", &m_dbscanTime, "time/F");
+    m_pRecoTree->Branch("buildneigborhoodCPUTime", &m_buildNeighborhoodCPUTime, "time/F");
+    m_pRecoTree->Branch("dbscanCPUTime", &m_dbscanCPUTime, "time/F");
     m_pRecoTree->Branch("clusterMergeTime", &m_clusterMergeTime, "time/F");
     m_pRecoTree->Branch("pathfindingtime", &m_pathFindingTime, "time/F");
     m_pRecoTree->Branch("finishTime", &m_finishTime, "time/F");
@@ -731,6 +740,8 @@ namespace lar_cluster3d {
     m_makeHitsTime = 0.f;
     m_buildNeighborhoodTime = 0.f;
     m_dbscanTime = 0.f;
+    m_buildNeighborhoodCPUTime = 0.f;
+    m_dbscanCPUTime = 0.f;
     m_pathFindingTime = 0.f;
     m_finishTime = 0.f;
   }
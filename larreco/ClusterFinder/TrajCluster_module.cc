@@ -234,6 +234,8 @@ namespace cluster {
     // pointers to the slices in the event
     std::vector<art::Ptr<recob::Slice>> slices;
     std::vector<int> slcIDs;
+    // the TrajClusterAlg results for this event
+    tca::TCContext tcx = fTCAlg.NewContext();
     unsigned int nInputHits = 0;
 
     // get a reference to the Hit collection
@@ -242,7 +244,7 @@ namespace cluster {
       throw cet::exception("TrajClusterModule")
         << "Failed to get a handle to hit collection '" << fHitModuleLabel.label() << "'\n";
     nInputHits = (*inputHits).size();
-    if (!fTCAlg.SetInputHits(*inputHits, evt.run(), evt.event()))
+    if (!fTCAlg.SetInputHits(tcx, *inputHits, evt.run(), evt.event()))
       throw cet::exception("TrajClusterModule")
         << "Failed to process hits from '" << fHitModuleLabel.label() << "'\n";
     // Try to determine the source of the hit collection using the assumption that it was
@@ -251,13 +253,13 @@ namespace cluster {
     if (fHitModuleLabel != "gaushit") {
       auto sourceHits = art::Handle<std::vector<recob::Hit>>();
       art::InputTag sourceModuleLabel("gaushit");
-      if (evt.getByLabel(sourceModuleLabel, sourceHits)) fTCAlg.SetSourceHits(*sourceHits);
+      if (evt.getByLabel(sourceModuleLabel, sourceHits)) fTCAlg.SetSourceHits(tcx, *sourceHits);
     } // look for gaushit collection
 
     // get an optional reference to the Slice collection
     auto inputSlices = art::Handle<std::vector<recob::Slice>>();
     if (fSliceModuleLabel != "NA") {
-      fTCAlg.ExpectSlicedHits();
+      fTCAlg.ExpectSlicedHits(tcx);
       if (!evt.getByLabel(fSliceModuleLabel, inputSlices))
         throw cet::exception("TrajClusterModule") << "Failed to get a inputSlices";
     } // fSliceModuleLabel specified
@@ -267,11 +269,11 @@ namespace cluster {
     if (fSpacePointModuleLabel != "NA") {
       if (!evt.getByLabel(fSpacePointModuleLabel, InputSpts))
         throw cet::exception("TrajClusterModule") << "Failed to get a handle to SpacePoints\n";
-      tca::evt.sptHits.resize((*InputSpts).size(), {{UINT_MAX, UINT_MAX, UINT_MAX}});
+      tcx.evt.sptHits.resize((*InputSpts).size(), {{UINT_MAX, UINT_MAX, UINT_MAX}});
       art::FindManyP<recob::Hit> hitsFromSpt(InputSpts, evt, fSpacePointHitAssnLabel);
       // TrajClusterAlg doesn't use the SpacePoint positions (only the assns to hits) but pass it
       // anyway in case it is useful
-      fTCAlg.SetInputSpts(*InputSpts);
+      fTCAlg.SetInputSpts(tcx, *InputSpts);
       if (!hitsFromSpt.isValid())
         throw cet::exception("TrajClusterModule")
           << "Failed to get a handle to SpacePoint -> Hit assns\n";
@@ -280,12 +282,12 @@ namespace cluster {
       if (firstHit.id() != inputHits.id())
         throw cet::exception("TrajClusterModule")
           << "The SpacePoint -> Hit assn doesn't reference the input hit collection\n";
-      tca::evt.sptHits.resize((*InputSpts).size(), {{UINT_MAX, UINT_MAX, UINT_MAX}});
+      tcx.evt.sptHits.resize((*InputSpts).size(), {{UINT_MAX, UINT_MAX, UINT_MAX}});
       for (unsigned int isp = 0; isp < (*InputSpts).size(); ++isp) {
         auto& hits = hitsFromSpt.at(isp);
         for (unsigned short iht = 0; iht < hits.size(); ++iht) {
           unsigned short plane = hits[iht]->WireID().Plane;
-          tca::evt.sptHits[isp][plane] = hits[iht].key();
+          tcx.evt.sptHits[isp][plane] = hits[iht].key();
         } // iht
       }   // isp
     }     // fSpacePointModuleLabel specified
@@ -315,6 +317,8 @@ namespace cluster {
           slcIDs[0] = 1;
         }
         if (sltpcHits.empty()) continue;
+        // the slices are reconstructed one at a time when looking for a debug hit
+        bool const dbgStp = tcx.tcc.dbgStp;
         for (unsigned short isl = 0; isl < sltpcHits.size(); ++isl) {
           auto& tpcHits = sltpcHits[isl];
           if (tpcHits.empty()) continue;
@@ -338,7 +342,7 @@ namespace cluster {
           tmp.resize(0);
           sortVec.resize(0);
           // look for a debug hit
-          if (tca::tcc.dbgStp) {
+          if (dbgStp) {
             tca::debug.Hit = UINT_MAX;
             for (unsigned short indx = 0; indx < tpcHits.size(); ++indx) {
               auto& hit = (*inputHits)[tpcHits[indx]];
@@ -355,13 +359,15 @@ namespace cluster {
                 break;
               } // Look for debug hit
             }   // iht
-          }     // tca::tcc.dbgStp
-          fTCAlg.RunTrajClusterAlg(clockData, detProp, tpcHits, slcIDs[isl]);
-        } // isl
-      }   // TPC
+            fTCAlg.RunTrajClusterAlg(clockData, detProp, tcx, tpcHits, slcIDs[isl]);
+          } // dbgStp
+        }   // isl
+        // reconstruct all slices in this TPC
+        if (!dbgStp) fTCAlg.RunTrajClusterAlg(clockData, detProp, tcx, sltpcHits, slcIDs);
+      } // TPC
       // stitch PFParticles between TPCs, create PFP start vertices, etc
-      fTCAlg.FinishEvent();
-      if (tca::tcc.dbgSummary) tca::PrintAll(detProp, "TCM");
+      fTCAlg.FinishEvent(tcx);
+      if (tcx.tcc.dbgSummary) tca::PrintAll(detProp, tcx, "TCM");
     } // nInputHits > 0
 
     // Vectors to hold all data products that will go into the event
@@ -422,7 +428,7 @@ namespace cluster {
     std::vector<slcVxStruct> vx3StrList;
 
     if (nInputHits > 0) {
-      unsigned short nSlices = fTCAlg.GetSlicesSize();
+      unsigned short nSlices = tcx.slices.size();
       // define a hit collection begin index to pass to CreateAssn for each cluster
       unsigned int hitColBeginIndex = 0;
       for (unsigned short isl = 0; isl < nSlices; ++isl) {
@@ -432,7 +438,7 @@ namespace cluster {
             if (slices[slcIndex]->ID() == slcIDs[isl]) break;
           if (slcIndex == slices.size()) continue;
         }
-        auto& slc = fTCAlg.GetSlice(isl);
+        auto& slc = tcx.slices[isl];
         // See if there was a serious reconstruction failure that made the sub-slice invalid
         if (!slc.isValid) continue;
         // make EndPoint2Ds
@@ -444,8 +450,8 @@ namespace cluster {
           unsigned int wire = std::nearbyint(vx2.Pos[0]);
           geo::PlaneID plID = tca::DecodeCTP(vx2.CTP);
           geo::WireID wID = geo::WireID(plID.Cryostat, plID.TPC, plID.Plane, wire);
-          geo::View_t view = tca::tcc.geom->View(wID);
-          vx2Col.emplace_back((double)vx2.Pos[1] / tca::tcc.unitsPerTick, // Time
+          geo::View_t view = tcx.tcc.geom->View(wID);
+          vx2Col.emplace_back((double)vx2.Pos[1] / tcx.tcc.unitsPerTick,  // Time
                               wID,                                        // WireID
                               vx2.Score,                                  // strength = score
                               vtxID,                                      // ID
@@ -520,7 +526,7 @@ namespace cluster {
               } // iht
             }
             else {
-              fTCAlg.MergeTPHits(tpHits, hitCol, newIndex);
+              fTCAlg.MergeTPHits(tcx, tpHits, hitCol, newIndex);
             }
           } // tp
           if (hitCol.empty()) continue;
@@ -547,14 +553,14 @@ namespace cluster {
           unsigned int nclhits = hitCol.size() - hitColBeginIndex + 1;
           clsCol.emplace_back(firstTP.Pos[0],                         // Start wire
                               0,                                      // sigma start wire
-                              firstTP.Pos[1] / tca::tcc.unitsPerTick, // start tick
+                              firstTP.Pos[1] / tcx.tcc.unitsPerTick,  // start tick
                               0,                                      // sigma start tick
                               firstTP.AveChg,                         // start charge
                               firstTP.Ang,                            // start angle
                               0,             // start opening angle (0 for line-like clusters)
                               lastTP.Pos[0], // end wire
                               0,             // sigma end wire
-                              lastTP.Pos[1] / tca::tcc.unitsPerTick, // end tick
+                              lastTP.Pos[1] / tcx.tcc.unitsPerTick,  // end tick
                               0,                                     // sigma end tick
                               lastTP.AveChg,                         // end charge
                               lastTP.Ang,                            // end angle
@@ -655,7 +661,7 @@ namespace cluster {
             if (slices[slcIndex]->ID() == slcIDs[isl]) break;
           if (slcIndex == slices.size()) continue;
         }
-        auto& slc = fTCAlg.GetSlice(isl);
+        auto& slc = tcx.slices[isl];
         // See if there was a serious reconstruction failure that made the slice invalid
         if (!slc.isValid) continue;
         // make PFParticles
@@ -752,7 +758,7 @@ namespace cluster {
             }   // valid shwIndex
           }     // pfp -> Shower
           // PFParticle cosmic tag
-          if (tca::tcc.modes[tca::kTagCosmics]) {
+          if (tcx.tcc.modes[tca::kTagCosmics]) {
             std::vector<float> tempPt1, tempPt2;
             tempPt1.push_back(-999);
             tempPt1.push_back(-999);
@@ -772,13 +778,13 @@ namespace cluster {
 
       // add the hits that weren't used in any slice to hitCol unless this is a
       // special debugging mode and would be a waste of time
-      if (!slices.empty() && tca::tcc.recoSlice == 0) {
+      if (!slices.empty() && tcx.tcc.recoSlice == 0) {
         auto inputSlices = evt.getValidHandle<std::vector<recob::Slice>>(fSliceModuleLabel);
         art::FindManyP<recob::Hit> hitFromSlc(inputSlices, evt, fSliceModuleLabel);
         for (unsigned int allHitsIndex = 0; allHitsIndex < nInputHits; ++allHitsIndex) {
           if (newIndex[allHitsIndex] != UINT_MAX) continue;
           std::vector<unsigned int> oneHit(1, allHitsIndex);
-          fTCAlg.MergeTPHits(oneHit, hitCol, newIndex);
+          fTCAlg.MergeTPHits(tcx, oneHit, hitCol, newIndex);
           // find out which slice it is in
           bool gotit = false;
           for (size_t isl = 0; isl < slices.size(); ++isl) {
@@ -802,7 +808,7 @@ namespace cluster {
         for (unsigned int allHitsIndex = 0; allHitsIndex < nInputHits; ++allHitsIndex) {
           if (newIndex[allHitsIndex] != UINT_MAX) continue;
           std::vector<unsigned int> oneHit(1, allHitsIndex);
-          fTCAlg.MergeTPHits(oneHit, hitCol, newIndex);
+          fTCAlg.MergeTPHits(tcx, oneHit, hitCol, newIndex);
         } // allHitsIndex
       }   // recob::Slices
     }     // input hits exist
@@ -829,7 +835,7 @@ namespace cluster {
     }         // nInputHits > 0
 
     // clear the alg data structures
-    fTCAlg.ClearResults();
+    fTCAlg.ClearResults(tcx);
 
     // convert vectors to unique_ptrs
     std::unique_ptr<std::vector<recob::Hit>> hcol(new std::vector<recob::Hit>(std::move(hitCol)));
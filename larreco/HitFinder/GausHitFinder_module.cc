@@ -33,7 +33,6 @@
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Core/SharedProducer.h"
 #include "art/Framework/Principal/Event.h"
-#include "art/Utilities/Globals.h"
 #include "art/Utilities/make_tool.h"
 #include "art_root_io/TFileService.h"
 #include "canvas/Persistency/Common/FindOneP.h"
@@ -49,6 +48,7 @@
 
 #include "larreco/HitFinder/HitFinderTools/ICandidateHitFinder.h"
 #include "larreco/HitFinder/HitFinderTools/IPeakFitter.h"
+#include "larreco/HitFinder/HitFinderTools/ThreadLocalHistogram.h"
 
 // ROOT Includes
 #include "TH1F.h"
@@ -65,6 +65,7 @@ namespace hit {
   private:
     void produce(art::Event& evt, art::ProcessingFrame const&) override;
     void beginJob(art::ProcessingFrame const&) override;
+    void endJob(art::ProcessingFrame const&) override;
 
     std::vector<double> FillOutHitParameterVector(const std::vector<double>& input);
 
@@ -89,17 +90,17 @@ namespace hit {
 
     std::atomic<size_t> fEventCount{0};
 
-    //only Standard and Morphological implementation is threadsafe.
+    // all the tool implementations are threadsafe; their diagnostic histograms are
+    // filled per thread and merged at endJob.
     std::vector<std::unique_ptr<reco_tool::ICandidateHitFinder>>
       fHitFinderToolVec; ///< For finding candidate hits
-    // only Marqdt implementation is threadsafe.
     std::unique_ptr<reco_tool::IPeakFitter> fPeakFitterTool; ///< Perform fit to candidate peaks
     //HitFilterAlg implementation is threadsafe.
     std::unique_ptr<HitFilterAlg> fHitFilterAlg; ///< algorithm used to filter out noise hits
 
-    //only used when fFillHists is true and in single threaded mode.
-    TH1F* fFirstChi2;
-    TH1F* fChi2;
+    //only used when fFillHists is true; filled per thread and merged at endJob.
+    reco_tool::ThreadLocalHistogram fFirstChi2;
+    reco_tool::ThreadLocalHistogram fChi2;
 
   }; // class GausHitFinder
 
@@ -125,11 +126,6 @@ namespace hit {
     , fPulseRatioCuts(
         pset.get<std::vector<float>>("PulseRatioCuts", std::vector<float>() = {0.35, 0.40, 0.20}))
   {
-    if (fFillHists && art::Globals::instance()->nthreads() > 1u) {
-      throw art::Exception(art::errors::Configuration)
-        << "Cannot fill histograms when multiple threads configured, please set fFillHists to "
-           "false or change number of threads to 1\n";
-    }
     async<art::InEvent>();
     if (fFilterHits) {
       fHitFilterAlg = std::make_unique<HitFilterAlg>(pset.get<fhicl::ParameterSet>("HitFilterAlg"));
@@ -205,11 +201,24 @@ namespace hit {
     // ======================================
     // === Hit Information for Histograms ===
     if (fFillHists) {
-      fFirstChi2 = tfs->make<TH1F>("fFirstChi2", "#chi^{2}", 10000, 0, 5000);
-      fChi2 = tfs->make<TH1F>("fChi2", "#chi^{2}", 10000, 0, 5000);
+      fFirstChi2.setHistogram(tfs->make<TH1F>("fFirstChi2", "#chi^{2}", 10000, 0, 5000));
+      fChi2.setHistogram(tfs->make<TH1F>("fChi2", "#chi^{2}", 10000, 0, 5000));
     }
   }
 
+  //-------------------------------------------------
+  void
+  GausHitFinder::endJob(art::ProcessingFrame const&)
+  {
+    // Collect what the worker threads filled
+    fFirstChi2.Merge();
+    fChi2.Merge();
+
+    for (auto& hitFinderTool : fHitFinderToolVec)
+      hitFinderTool->endJob();
+    fPeakFitterTool->endJob();
+  }
+
   //  This algorithm uses the fact that deconvolved signals are very smooth
   //  and looks for hits as areas between local minima that have signal above
   //  threshold.
@@ -375,7 +384,7 @@ namespace hit {
                 NDF = 2;
               }
 
-              if (fFillHists) fFirstChi2->Fill(chi2PerNDF);
+              if (fFillHists) fFirstChi2.Fill(chi2PerNDF);
             }
 
             // #######################################################
@@ -556,7 +565,7 @@ namespace hit {
                   filthitstruct_vec.push_back(std::move(tmp));
                 }
 
-              if (fFillHists) fChi2->Fill(chi2PerNDF);
+              if (fFillHists) fChi2.Fill(chi2PerNDF);
             }
           } //<---End loop over merged candidate hits
 
@@ -1,11 +1,14 @@
 ////////////////////////////////////////////////////////////////////////
 /// \file   CandHitDerivative.cc
 /// \author T. Usher
-//note for MT: this implementation is not thread-safe
+// MT note: per-call scratch vectors are thread local, summary histograms are
+// accumulated per thread and merged at endJob; only the (very large) per-wire
+// waveform output is serialized.
 ////////////////////////////////////////////////////////////////////////
 
 #include "larreco/HitFinder/HitFinderTools/ICandidateHitFinder.h"
 #include "larreco/HitFinder/HitFinderTools/IWaveformTool.h"
+#include "larreco/HitFinder/HitFinderTools/ThreadLocalHistogram.h"
 
 #include "art/Utilities/ToolMacros.h"
 #include "art/Utilities/make_tool.h"
@@ -15,7 +18,10 @@
 
 #include "TProfile.h"
 
+#include "tbb/enumerable_thread_specific.h"
+
 #include <cmath>
+#include <mutex>
 
 namespace reco_tool {
 
@@ -33,6 +39,8 @@ namespace reco_tool {
                             const HitCandidateVec&,
                             MergeHitCandidateVec&) const override;
 
+    void endJob() override;
+
   private:
     // Internal functions
     void findHitCandidates(Waveform::const_iterator,
@@ -64,13 +72,23 @@ namespace reco_tool {
 
     art::TFileDirectory* fHistDirectory;
 
-    // Global histograms
-    TH1F* fDStopStartHist;
-    TH1F* fDMaxTickMinTickHist;
-    TH1F* fDMaxDerivMinDerivHist;
+    // Global histograms, filled per thread
+    ThreadLocalHistogram fDStopStartHist;
+    ThreadLocalHistogram fDMaxTickMinTickHist;
+    ThreadLocalHistogram fDMaxDerivMinDerivHist;
 
+    // The per wire histograms are created in the output file so must be serialized
+    mutable std::mutex fWaveformOutputMutex;
     mutable std::map<size_t, int> fChannelCntMap;
 
+    // Scratch vectors, one set per thread so they are only allocated once
+    struct Workspace {
+      Waveform rawDerivativeVec;
+      Waveform derivativeVec;
+    };
+
+    mutable tbb::enumerable_thread_specific<Workspace> fWorkspace;
+
     // Member variables from the fhicl file
     std::unique_ptr<reco_tool::IWaveformTool> fWaveformTool;
 
@@ -104,12 +122,12 @@ namespace reco_tool {
       // Make a directory for these histograms
       art::TFileDirectory dir = fHistDirectory->mkdir(Form("HitPlane_%1zu", fPlane));
 
-      fDStopStartHist =
-        dir.make<TH1F>(Form("DStopStart_%1zu", fPlane), ";Delta Stop/Start;", 200, 0., 200.);
-      fDMaxTickMinTickHist =
-        dir.make<TH1F>(Form("DMaxTMinT_%1zu", fPlane), ";Delta Max/Min Tick;", 200, 0., 200.);
-      fDMaxDerivMinDerivHist =
-        dir.make<TH1F>(Form("DMaxDMinD_%1zu", fPlane), ";Delta Max/Min Deriv;", 200, 0., 200.);
+      fDStopStartHist.setHistogram(
+        dir.make<TH1F>(Form("DStopStart_%1zu", fPlane), ";Delta Stop/Start;", 200, 0., 200.));
+      fDMaxTickMinTickHist.setHistogram(
+        dir.make<TH1F>(Form("DMaxTMinT_%1zu", fPlane), ";Delta Max/Min Tick;", 200, 0., 200.));
+      fDMaxDerivMinDerivHist.setHistogram(
+        dir.make<TH1F>(Form("DMaxDMinD_%1zu", fPlane), ";Delta Max/Min Deriv;", 200, 0., 200.));
     }
 
     return;
@@ -125,12 +143,16 @@ namespace reco_tool {
   {
     // In this case we want to find hit candidates based on the derivative of of the input waveform
     // We get this from our waveform algs too...
-    Waveform rawDerivativeVec;
-    Waveform derivativeVec;
+    Workspace& workspace = fWorkspace.local();
+    Waveform& rawDerivativeVec = workspace.rawDerivativeVec;
+    Waveform& derivativeVec = workspace.derivativeVec;
 
     // Recover the actual waveform
     const Waveform& waveform = dataRange.data();
 
+    // The derivative does not set the end points, make sure they are not left over
+    rawDerivativeVec.clear();
+
     fWaveformTool->firstDerivative(waveform, rawDerivativeVec);
     fWaveformTool->triangleSmooth(rawDerivativeVec, derivativeVec);
 
@@ -174,6 +196,8 @@ namespace reco_tool {
       //        size_t                   tpc   = wids[0].TPC;
       //        size_t                   wire  = wids[0].Wire;
 
+      std::lock_guard<std::mutex> lock(fWaveformOutputMutex);
+
       size_t channelCnt = fChannelCntMap[channel]++;
 
       // Make a directory for these histograms
@@ -229,15 +253,23 @@ namespace reco_tool {
         maxDerivHist->Fill(hitCandidate.maxTick, hitCandidate.maxDerivative);
         maxDerivHist->Fill(hitCandidate.minTick, hitCandidate.minDerivative);
 
-        fDStopStartHist->Fill(hitCandidate.stopTick - hitCandidate.startTick, 1.);
-        fDMaxTickMinTickHist->Fill(hitCandidate.minTick - hitCandidate.maxTick, 1.);
-        fDMaxDerivMinDerivHist->Fill(hitCandidate.maxDerivative - hitCandidate.minDerivative, 1.);
+        fDStopStartHist.Fill(hitCandidate.stopTick - hitCandidate.startTick, 1.);
+        fDMaxTickMinTickHist.Fill(hitCandidate.minTick - hitCandidate.maxTick, 1.);
+        fDMaxDerivMinDerivHist.Fill(hitCandidate.maxDerivative - hitCandidate.minDerivative, 1.);
       }
     }
 
     return;
   }
 
+  void
+  CandHitDerivative::endJob()
+  {
+    fDStopStartHist.Merge();
+    fDMaxTickMinTickHist.Merge();
+    fDMaxDerivMinDerivHist.Merge();
+  }
+
   void
   CandHitDerivative::findHitCandidates(Waveform::const_iterator startItr,
                                        Waveform::const_iterator stopItr,
@@ -1,11 +1,14 @@
 ////////////////////////////////////////////////////////////////////////
 /// \file   CandHitMorphological.cc
 /// \author T. Usher
-// MT note: This implementation is not thread-safe.
+// MT note: per-call scratch vectors are thread local, summary histograms are
+// accumulated per thread and merged at endJob; only the (very large) per-wire
+// waveform output is serialized.
 ////////////////////////////////////////////////////////////////////////
 
 #include "larreco/HitFinder/HitFinderTools/ICandidateHitFinder.h"
 #include "larreco/HitFinder/HitFinderTools/IWaveformTool.h"
+#include "larreco/HitFinder/HitFinderTools/ThreadLocalHistogram.h"
 
 #include "art/Utilities/ToolMacros.h"
 #include "art/Utilities/make_tool.h"
@@ -15,7 +18,10 @@
 
 #include "TProfile.h"
 
+#include "tbb/enumerable_thread_specific.h"
+
 #include <cmath>
+#include <mutex>
 
 namespace reco_tool {
 
@@ -33,6 +39,8 @@ namespace reco_tool {
                             const HitCandidateVec&,
                             MergeHitCandidateVec&) const override;
 
+    void endJob() override;
+
   private:
     // Internal functions
     //< Top level hit finding using erosion/dilation vectors
@@ -97,20 +105,32 @@ namespace reco_tool {
 
     art::TFileDirectory* fHistDirectory;
 
-    // Global histograms
-    TH1F* fDStopStartHist;        //< Basically keeps track of the length of hit regions
-    TH1F* fDMaxTickMinTickHist;   //< This will be a measure of the width of candidate hits
-    TH1F* fDMaxDerivMinDerivHist; //< This is the difference peak to peak of derivative for cand hit
-    TH1F* fMaxErosionHist;        //< Keep track of the maximum erosion
-    TH1F* fMaxDilationHist;       //< Keep track of the maximum dilation
-    TH1F* fMaxDilEroRatHist;      //< Ratio of the maxima of the two
-
-    //MT note: The mutable data members are only used in the histogram filling functions
-    //and histogram filling can only be done in single-threaded mode.
-    //Will need to consider design changes if this behavior changes.
-    mutable size_t
-      fLastChannel; //< Kludge to keep track of last channel when histogramming in effect
-    mutable size_t fChannelCnt; //< Counts the number of times a channel is used (assumed in order)
+    // Global histograms, filled per thread
+    ThreadLocalHistogram fDStopStartHist;  //< Basically keeps track of the length of hit regions
+    ThreadLocalHistogram fDMaxTickMinTickHist; //< This will be a measure of the width of candidate hits
+    ThreadLocalHistogram
+      fDMaxDerivMinDerivHist; //< This is the difference peak to peak of derivative for cand hit
+    ThreadLocalHistogram fMaxErosionHist;   //< Keep track of the maximum erosion
+    ThreadLocalHistogram fMaxDilationHist;  //< Keep track of the maximum dilation
+    ThreadLocalHistogram fMaxDilEroRatHist; //< Ratio of the maxima of the two
+
+    //MT note: the waveform output creates histograms in the output file, so it is serialized
+    //with this mutex, which also protects the channel counters
+    mutable std::mutex fWaveformOutputMutex;
+    mutable std::map<size_t, size_t>
+      fChannelCntMap; //< Counts the number of times a channel is used
+
+    // Scratch vectors, one set per thread so they are only allocated once
+    struct Workspace {
+      Waveform rawDerivativeVec;
+      Waveform derivativeVec;
+      Waveform erosionVec;
+      Waveform dilationVec;
+      Waveform averageVec;
+      Waveform differenceVec;
+    };
+
+    mutable tbb::enumerable_thread_specific<Workspace> fWorkspace;
 
     //< All of the real work is done in the waveform tool
     std::unique_ptr<reco_tool::IWaveformTool> fWaveformTool;
@@ -134,27 +154,12 @@ namespace reco_tool {
     , fOutputWaveforms(pset.get<bool>("OutputWaveforms", false))
     , fFitNSigmaFromCenter(pset.get<float>("FitNSigmaFromCenter", 5.))
   {
-
-    if (art::Globals::instance()->nthreads() > 1u) {
-      if (fOutputHistograms) {
-        throw art::Exception(art::errors::Configuration)
-          << "Cannot fill histograms when multiple threads configured, please set "
-             "fOutputHistograms to false or change number of threads to 1\n";
-      }
-
-      if (fOutputWaveforms) {
-        throw art::Exception(art::errors::Configuration)
-          << "Cannot write output waveforms when multiple threads configured, please set "
-             "fOutputHistograms to false or change number of threads to 1\n";
-      }
-    }
     // Recover the baseline tool
     fWaveformTool =
       art::make_tool<reco_tool::IWaveformTool>(pset.get<fhicl::ParameterSet>("WaveformAlgs"));
 
-    // Set the last channel to some nonsensical value
-    fLastChannel = std::numeric_limits<size_t>::max();
-    fChannelCnt = 0;
+    // The waveform output needs the directory too
+    if (fOutputWaveforms) fHistDirectory = art::ServiceHandle<art::TFileService>().get();
 
     // If asked, define the global histograms
     if (fOutputHistograms) {
@@ -167,18 +172,18 @@ namespace reco_tool {
       // Make a directory for these histograms
       art::TFileDirectory dir = fHistDirectory->mkdir(Form("HitPlane_%1zu", fPlane));
 
-      fDStopStartHist =
-        dir.make<TH1F>(Form("DStopStart_%1zu", fPlane), ";Delta Stop/Start;", 100, 0., 100.);
-      fDMaxTickMinTickHist =
-        dir.make<TH1F>(Form("DMaxTMinT_%1zu", fPlane), ";Delta Max/Min Tick;", 100, 0., 100.);
-      fDMaxDerivMinDerivHist =
-        dir.make<TH1F>(Form("DMaxDMinD_%1zu", fPlane), ";Delta Max/Min Deriv;", 200, 0., 100.);
-      fMaxErosionHist =
-        dir.make<TH1F>(Form("MaxErosion_%1zu", fPlane), ";Max Erosion;", 200, -50., 150.);
-      fMaxDilationHist =
-        dir.make<TH1F>(Form("MaxDilation_%1zu", fPlane), ";Max Dilation;", 200, -50., 150.);
-      fMaxDilEroRatHist =
-        dir.make<TH1F>(Form("MaxDilEroRat_%1zu", fPlane), ";Max Dil/Ero;", 200, -1., 1.);
+      fDStopStartHist.setHistogram(
+        dir.make<TH1F>(Form("DStopStart_%1zu", fPlane), ";Delta Stop/Start;", 100, 0., 100.));
+      fDMaxTickMinTickHist.setHistogram(
+        dir.make<TH1F>(Form("DMaxTMinT_%1zu", fPlane), ";Delta Max/Min Tick;", 100, 0., 100.));
+      fDMaxDerivMinDerivHist.setHistogram(
+        dir.make<TH1F>(Form("DMaxDMinD_%1zu", fPlane), ";Delta Max/Min Deriv;", 200, 0., 100.));
+      fMaxErosionHist.setHistogram(
+        dir.make<TH1F>(Form("MaxErosion_%1zu", fPlane), ";Max Erosion;", 200, -50., 150.));
+      fMaxDilationHist.setHistogram(
+        dir.make<TH1F>(Form("MaxDilation_%1zu", fPlane), ";Max Dilation;", 200, -50., 150.));
+      fMaxDilEroRatHist.setHistogram(
+        dir.make<TH1F>(Form("MaxDilEroRat_%1zu", fPlane), ";Max Dil/Ero;", 200, -1., 1.));
     }
 
     return;
@@ -194,20 +199,24 @@ namespace reco_tool {
   {
     // In this case we want to find hit candidates based on the derivative of of the input waveform
     // We get this from our waveform algs too...
-    Waveform rawDerivativeVec;
-    Waveform derivativeVec;
+    Workspace& workspace = fWorkspace.local();
+    Waveform& rawDerivativeVec = workspace.rawDerivativeVec;
+    Waveform& derivativeVec = workspace.derivativeVec;
 
     // Recover the actual waveform
     const Waveform& waveform = dataRange.data();
 
+    // The derivative does not set the end points, make sure they are not left over
+    rawDerivativeVec.clear();
+
     fWaveformTool->firstDerivative(waveform, rawDerivativeVec);
     fWaveformTool->triangleSmooth(rawDerivativeVec, derivativeVec);
 
     // Now we get the erosion/dilation vectors
-    Waveform erosionVec;
-    Waveform dilationVec;
-    Waveform averageVec;
-    Waveform differenceVec;
+    Waveform& erosionVec = workspace.erosionVec;
+    Waveform& dilationVec = workspace.dilationVec;
+    Waveform& averageVec = workspace.averageVec;
+    Waveform& differenceVec = workspace.differenceVec;
 
     reco_tool::HistogramMap histogramMap;
 
@@ -257,7 +266,9 @@ namespace reco_tool {
       size_t tpc = wids[0].TPC;
       size_t wire = wids[0].Wire;
 
-      if (channel != fLastChannel) fChannelCnt = 0;
+      std::lock_guard<std::mutex> lock(fWaveformOutputMutex);
+
+      size_t channelCnt = fChannelCntMap[channel]++;
 
       // Make a directory for these histograms
       art::TFileDirectory dir = fHistDirectory->mkdir(
@@ -267,7 +278,7 @@ namespace reco_tool {
       size_t waveStart = dataRange.begin_index();
 
       TProfile* waveHist =
-        dir.make<TProfile>(Form("HWfm_%03zu_roiStart-%05zu", fChannelCnt, waveStart),
+        dir.make<TProfile>(Form("HWfm_%03zu_roiStart-%05zu", channelCnt, waveStart),
                            "Waveform",
                            waveformSize,
                            0,
@@ -275,7 +286,7 @@ namespace reco_tool {
                            -500.,
                            500.);
       TProfile* derivHist =
-        dir.make<TProfile>(Form("HDer_%03zu_roiStart-%05zu", fChannelCnt, waveStart),
+        dir.make<TProfile>(Form("HDer_%03zu_roiStart-%05zu", channelCnt, waveStart),
                            "Derivative",
                            waveformSize,
                            0,
@@ -283,7 +294,7 @@ namespace reco_tool {
                            -500.,
                            500.);
       TProfile* erosionHist =
-        dir.make<TProfile>(Form("HEro_%03zu_roiStart-%05zu", fChannelCnt, waveStart),
+        dir.make<TProfile>(Form("HEro_%03zu_roiStart-%05zu", channelCnt, waveStart),
                            "Erosion",
                            waveformSize,
                            0,
@@ -291,7 +302,7 @@ namespace reco_tool {
                            -500.,
                            500.);
       TProfile* dilationHist =
-        dir.make<TProfile>(Form("HDil_%03zu_roiStart-%05zu", fChannelCnt, waveStart),
+        dir.make<TProfile>(Form("HDil_%03zu_roiStart-%05zu", channelCnt, waveStart),
                            "Dilation",
                            waveformSize,
                            0,
@@ -299,7 +310,7 @@ namespace reco_tool {
                            -500.,
                            500.);
       TProfile* candHitHist =
-        dir.make<TProfile>(Form("HCan_%03zu_roiStart-%05zu", fChannelCnt, waveStart),
+        dir.make<TProfile>(Form("HCan_%03zu_roiStart-%05zu", channelCnt, waveStart),
                            "Cand Hits",
                            waveformSize,
                            0,
@@ -307,7 +318,7 @@ namespace reco_tool {
                            -500.,
                            500.);
       TProfile* maxDerivHist =
-        dir.make<TProfile>(Form("HMax_%03zu_roiStart-%05zu", fChannelCnt, waveStart),
+        dir.make<TProfile>(Form("HMax_%03zu_roiStart-%05zu", channelCnt, waveStart),
                            "Maxima",
                            waveformSize,
                            0,
@@ -315,7 +326,7 @@ namespace reco_tool {
                            -500.,
                            500.);
       TProfile* strtStopHist =
-        dir.make<TProfile>(Form("HSSS_%03zu_roiStart-%05zu", fChannelCnt, waveStart),
+        dir.make<TProfile>(Form("HSSS_%03zu_roiStart-%05zu", channelCnt, waveStart),
                            "Start/Stop",
                            waveformSize,
                            0,
@@ -339,17 +350,14 @@ namespace reco_tool {
         strtStopHist->Fill(hitCandidate.startTick, waveform.at(hitCandidate.startTick));
         strtStopHist->Fill(hitCandidate.stopTick, waveform.at(hitCandidate.stopTick));
       }
-
-      fLastChannel = channel;
-      fChannelCnt++;
     }
 
     if (fOutputHistograms) {
       // Fill hits
       for (const auto& hitCandidate : hitCandidateVec) {
-        fDStopStartHist->Fill(hitCandidate.stopTick - hitCandidate.startTick, 1.);
-        fDMaxTickMinTickHist->Fill(hitCandidate.minTick - hitCandidate.maxTick, 1.);
-        fDMaxDerivMinDerivHist->Fill(hitCandidate.maxDerivative - hitCandidate.minDerivative, 1.);
+        fDStopStartHist.Fill(hitCandidate.stopTick - hitCandidate.startTick, 1.);
+        fDMaxTickMinTickHist.Fill(hitCandidate.minTick - hitCandidate.maxTick, 1.);
+        fDMaxDerivMinDerivHist.Fill(hitCandidate.maxDerivative - hitCandidate.minDerivative, 1.);
       }
 
       // Get the max dilation/erosion
@@ -362,14 +370,25 @@ namespace reco_tool {
 
       if (std::abs(*maxDilationItr) > 0.) dilEroRat = *maxErosionItr / *maxDilationItr;
 
-      fMaxErosionHist->Fill(*maxErosionItr, 1.);
-      fMaxDilationHist->Fill(*maxDilationItr, 1.);
-      fMaxDilEroRatHist->Fill(dilEroRat, 1.);
+      fMaxErosionHist.Fill(*maxErosionItr, 1.);
+      fMaxDilationHist.Fill(*maxDilationItr, 1.);
+      fMaxDilEroRatHist.Fill(dilEroRat, 1.);
     }
 
     return;
   }
 
+  void
+  CandHitMorphological::endJob()
+  {
+    fDStopStartHist.Merge();
+    fDMaxTickMinTickHist.Merge();
+    fDMaxDerivMinDerivHist.Merge();
+    fMaxErosionHist.Merge();
+    fMaxDilationHist.Merge();
+    fMaxDilEroRatHist.Merge();
+  }
+
   void
   CandHitMorphological::findHitCandidates(Waveform::const_iterator derivStartItr,
                                           Waveform::const_iterator derivStopItr,
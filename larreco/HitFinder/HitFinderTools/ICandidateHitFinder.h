@@ -49,6 +49,9 @@ namespace reco_tool {
     virtual void MergeHitCandidates(const recob::Wire::RegionsOfInterest_t::datarange_t&,
                                     const HitCandidateVec&,
                                     MergeHitCandidateVec&) const = 0;
+
+    // Called once at the end of the job, e.g. to merge per-thread diagnostic histograms
+    virtual void endJob() {}
   };
 }
 
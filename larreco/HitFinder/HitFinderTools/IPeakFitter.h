@@ -42,6 +42,9 @@ namespace reco_tool
                                         PeakParamsVec&,
                                         double&,
                                         int&) const = 0;
+
+        // Called once at the end of the job, e.g. to merge per-thread diagnostic histograms
+        virtual void endJob() {}
     };
 }
 
@@ -1,22 +1,38 @@
 ////////////////////////////////////////////////////////////////////////
 /// \file   PeakFitterGaussian.cc
 /// \author T. Usher
+// MT note: the fit histogram and functions are kept per thread, and with
+// more than one thread the fits of this tool use Minuit2 (TMinuit is not
+// thread safe); the global default minimizer is left untouched.
 ////////////////////////////////////////////////////////////////////////
 
 #include "larreco/HitFinder/HitFinderTools/IPeakFitter.h"
+#include "larreco/HitFinder/HitFinderTools/ThreadLocalHistogram.h"
 #include "larreco/RecoAlg/GausFitCache.h" // hit::GausFitCache
 
+#include "art/Utilities/Globals.h"
 #include "art/Utilities/ToolMacros.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "art_root_io/TFileService.h"
 #include "larcore/Geometry/Geometry.h"
 
+#include <atomic>
 #include <cassert>
 #include <fstream>
 
+#include "Fit/BinData.h"
+#include "Fit/Fitter.h"
+#include "HFitInterface.h"
+#include "Math/MinimizerOptions.h"
+#include "Math/WrappedMultiTF1.h"
 #include "TF1.h"
 #include "TH1F.h"
 
+#include <limits>
+#include <string>
+
+#include "tbb/enumerable_thread_specific.h"
+
 namespace reco_tool
 {
 
@@ -44,8 +60,9 @@ protected:
          while (iGaus < nFunc) formula += "gaus(" + std::to_string(3 * (iGaus++)) + ") + ";
          formula += "[" + std::to_string(3 * nFunc) + "]";
 
+         // keep the function out of the global list: each thread has its own cache
          std::string const func_name = FunctionName(nFunc);
-         auto* pF = new TF1(func_name.c_str(), formula.c_str());
+         auto* pF = new TF1(func_name.c_str(), formula.c_str(), 0., 1., TF1::EAddToList::kNo);
          pF->SetParName(iGaus * 3, "baseline");
          return pF;
     } // CreateFunction()
@@ -64,7 +81,19 @@ public:
                             double&,
                             int&) const override;
 
+    void endJob() override;
+
 private:
+    /// Histogram and functions used for the fits, one set per thread
+    struct FitWorkspace
+    {
+        FitWorkspace();
+
+        const unsigned int    index;    ///< Unique index, used to name the ROOT objects
+        BaselinedGausFitCache fitCache; ///< Preallocated ROOT functions for the fits.
+        TH1F                  histogram;
+    };
+
     // Member variables from the fhicl file
     const double                   fMinWidth;          ///< minimum initial width for gaussian fit
     const double                   fMaxWidthMult;      ///< multiplier for max width for gaussian fit
@@ -72,25 +101,40 @@ private:
     const double                   fAmpRange;          ///< set range limit for peak amplitude
     const bool                     fFloatBaseline;     ///< Allow baseline to "float" away from zero
     const bool                     fOutputHistograms;  ///< If true will generate summary style histograms
-
-    TH1F*                    fNumCandHitsHist;
-    TH1F*                    fROISizeHist;
-    TH1F*                    fCandPeakPositionHist;
-    TH1F*                    fCandPeakWidHist;
-    TH1F*                    fCandPeakAmpitudeHist;
-    TH1F*                    fCandBaselineHist;
-    TH1F*                    fFitPeakPositionHist;
-    TH1F*                    fFitPeakWidHist;
-    TH1F*                    fFitPeakAmpitudeHist;
-    TH1F*                    fFitBaselineHist;
-
-    mutable BaselinedGausFitCache fFitCache; ///< Preallocated ROOT functions for the fits.
-
-    mutable TH1F             fHistogram;
+    const std::string              fMinimizerType;     ///< minimizer of the fits: Minuit2 with more than one thread
+
+    // Summary histograms, filled per thread and merged at endJob
+    ThreadLocalHistogram     fNumCandHitsHist;
+    ThreadLocalHistogram     fROISizeHist;
+    ThreadLocalHistogram     fCandPeakPositionHist;
+    ThreadLocalHistogram     fCandPeakWidHist;
+    ThreadLocalHistogram     fCandPeakAmpitudeHist;
+    ThreadLocalHistogram     fCandBaselineHist;
+    ThreadLocalHistogram     fFitPeakPositionHist;
+    ThreadLocalHistogram     fFitPeakWidHist;
+    ThreadLocalHistogram     fFitPeakAmpitudeHist;
+    ThreadLocalHistogram     fFitBaselineHist;
+
+    mutable tbb::enumerable_thread_specific<FitWorkspace> fFitWorkspace;
 
     const geo::GeometryCore* fGeometry = lar::providerFrom<geo::Geometry>();
 };
 
+//----------------------------------------------------------------------
+// Workspace constructor: each one gets unique names for its ROOT objects.
+static std::atomic<unsigned int> workspaceCount{0};
+
+PeakFitterGaussian::FitWorkspace::FitWorkspace() :
+    index(workspaceCount++),
+    fitCache("BaselinedGausFitCache_" + std::to_string(index))
+{
+    // The default constructed histogram is not attached to any directory, which would
+    // not be thread safe; give it its binning here
+    histogram.SetName(("PeakFitterHitSignal_" + std::to_string(index)).c_str());
+    histogram.SetBins(500,0.,500.);
+    histogram.Sumw2();
+}
+
 //----------------------------------------------------------------------
 // Constructor.
 PeakFitterGaussian::PeakFitterGaussian(const fhicl::ParameterSet& pset):
@@ -99,13 +143,13 @@ PeakFitterGaussian::PeakFitterGaussian(const fhicl::ParameterSet& pset):
     fPeakRange(pset.get<double>("PeakRangeFact",    2.)),
     fAmpRange(pset.get<double>("PeakAmpRange",     2.)),
     fFloatBaseline(pset.get< bool >("FloatBaseline",    false)),
-    fOutputHistograms(pset.get< bool >("OutputHistograms", false))
+    fOutputHistograms(pset.get< bool >("OutputHistograms", false)),
+    // TMinuit, the default minimizer, keeps global state
+    fMinimizerType(art::Globals::instance()->nthreads() > 1u? "Minuit2": ROOT::Math::MinimizerOptions::DefaultMinimizerType())
 {
-    fHistogram = TH1F("PeakFitterHitSignal","",500,0.,500.);
-
-    fHistogram.Sumw2();
-
-    std::string function = "Gaus(0)";
+    if (fMinimizerType != ROOT::Math::MinimizerOptions::DefaultMinimizerType())
+        mf::LogInfo("PeakFitterGaussian") << "Multiple threads configured, fitting peaks with Minuit2 instead of "
+                                          << ROOT::Math::MinimizerOptions::DefaultMinimizerType();
 
     // If asked, define the global histograms
     if (fOutputHistograms)
@@ -117,16 +161,16 @@ PeakFitterGaussian::PeakFitterGaussian(const fhicl::ParameterSet& pset):
         // Make a directory for these histograms
         art::TFileDirectory dir = tfs->mkdir("PeakFit");
 
-        fNumCandHitsHist      = dir.make<TH1F>("NumCandHits",    "# Candidate Hits", 100,   0., 100.);
-        fROISizeHist          = dir.make<TH1F>("ROISize",        "ROI Size",         400,   0., 400.);
-        fCandPeakPositionHist = dir.make<TH1F>("CPeakPosition",  "Peak Position",    200,   0., 400.);
-        fCandPeakWidHist      = dir.make<TH1F>("CPeadWidth",     "Peak Width",       100,   0.,  25.);
-        fCandPeakAmpitudeHist = dir.make<TH1F>("CPeakAmplitude", "Peak Amplitude",   100,   0., 200.);
-        fCandBaselineHist     = dir.make<TH1F>("CBaseline",      "Baseline",         200, -25.,  25.);
-        fFitPeakPositionHist  = dir.make<TH1F>("FPeakPosition",  "Peak Position",    200,   0., 400.);
-        fFitPeakWidHist       = dir.make<TH1F>("FPeadWidth",     "Peak Width",       100,   0.,  25.);
-        fFitPeakAmpitudeHist  = dir.make<TH1F>("FPeakAmplitude", "Peak Amplitude",   100,   0., 200.);
-        fFitBaselineHist      = dir.make<TH1F>("FBaseline",      "Baseline",         200, -25.,  25.);
+        fNumCandHitsHist.setHistogram(dir.make<TH1F>("NumCandHits",    "# Candidate Hits", 100,   0., 100.));
+        fROISizeHist.setHistogram(dir.make<TH1F>("ROISize",        "ROI Size",         400,   0., 400.));
+        fCandPeakPositionHist.setHistogram(dir.make<TH1F>("CPeakPosition",  "Peak Position",    200,   0., 400.));
+        fCandPeakWidHist.setHistogram(dir.make<TH1F>("CPeadWidth",     "Peak Width",       100,   0.,  25.));
+        fCandPeakAmpitudeHist.setHistogram(dir.make<TH1F>("CPeakAmplitude", "Peak Amplitude",   100,   0., 200.));
+        fCandBaselineHist.setHistogram(dir.make<TH1F>("CBaseline",      "Baseline",         200, -25.,  25.));
+        fFitPeakPositionHist.setHistogram(dir.make<TH1F>("FPeakPosition",  "Peak Position",    200,   0., 400.));
+        fFitPeakWidHist.setHistogram(dir.make<TH1F>("FPeadWidth",     "Peak Width",       100,   0.,  25.));
+        fFitPeakAmpitudeHist.setHistogram(dir.make<TH1F>("FPeakAmplitude", "Peak Amplitude",   100,   0., 200.));
+        fFitBaselineHist.setHistogram(dir.make<TH1F>("FBaseline",      "Baseline",         200, -25.,  25.));
     }
 
     return;
@@ -154,15 +198,14 @@ void PeakFitterGaussian::findPeakParameters(const std::vector<float>&
     int endTime   = hitCandidateVec.back().stopTick;
     int roiSize   = endTime - startTime;
 
+    // Recover this thread's histogram and functions
+    FitWorkspace& workspace = fFitWorkspace.local();
+    TH1F&         histogram = workspace.histogram;
+
     // Check to see if we need a bigger histogram for fitting
-    if (roiSize > fHistogram.GetNbinsX())
-    {
-        std::string histName = "PeakFitterHitSignal_" + std::to_string(roiSize);
-        fHistogram = TH1F(histName.c_str(),"",roiSize,0.,roiSize);
-        fHistogram.Sumw2();
-    }
+    if (roiSize > histogram.GetNbinsX()) histogram.SetBins(roiSize,0.,roiSize);
 
-    for(int idx = 0; idx < roiSize; idx++) fHistogram.SetBinContent(idx+1,roiSignalVec[startTime+idx]);
+    for(int idx = 0; idx < roiSize; idx++) histogram.SetBinContent(idx+1,roiSignalVec[startTime+idx]);
 
     // Build the string to describe the fit formula
 #if 0
@@ -184,8 +227,8 @@ void PeakFitterGaussian::findPeakParameters(const std::vector<float>&
     TF1 Gaus("Gaus",equation.c_str(),0,roiSize,TF1::EAddToList::kNo);
 #else
     unsigned int const nGaus = hitCandidateVec.size();
-    assert(fFitCache.Get(nGaus));
-    TF1& Gaus = *(fFitCache.Get(nGaus));
+    assert(workspace.fitCache.Get(nGaus));
+    TF1& Gaus = *(workspace.fitCache.Get(nGaus));
 
     // Set the baseline if so desired
     float baseline(0.);
@@ -202,9 +245,9 @@ void PeakFitterGaussian::findPeakParameters(const std::vector<float>&
 
     if (fOutputHistograms)
     {
-        fNumCandHitsHist->Fill(hitCandidateVec.size(), 1.);
-        fROISizeHist->Fill(roiSize, 1.);
-        fCandBaselineHist->Fill(baseline, 1.);
+        fNumCandHitsHist.Fill(hitCandidateVec.size(), 1.);
+        fROISizeHist.Fill(roiSize, 1.);
+        fCandBaselineHist.Fill(baseline, 1.);
     }
 
     // ### Setting the parameters for the Gaussian Fit ###
@@ -219,9 +262,9 @@ void PeakFitterGaussian::findPeakParameters(const std::vector<float>&
 
         if (fOutputHistograms)
         {
-            fCandPeakPositionHist->Fill(peakMean, 1.);
-            fCandPeakWidHist->Fill(peakWidth, 1.);
-            fCandPeakAmpitudeHist->Fill(amplitude, 1.);
+            fCandPeakPositionHist.Fill(peakMean, 1.);
+            fCandPeakWidHist.Fill(peakWidth, 1.);
+            fCandPeakAmpitudeHist.Fill(amplitude, 1.);
         }
 
         Gaus.SetParameter(  parIdx, amplitude);
@@ -234,16 +277,60 @@ void PeakFitterGaussian::findPeakParameters(const std::vector<float>&
         parIdx += 3;
     }
 
+    // The fit is set up as TH1::Fit(&Gaus,"QNWB","", 0., roiSize) would do, but with
+    // this tool's own choice of minimizer
+    ROOT::Fit::DataOptions dataOptions;
+    dataOptions.fErrors1 = true; // "W": all bins have the same weight
+
+    ROOT::Fit::BinData fitData(dataOptions, ROOT::Fit::DataRange(0., roiSize));
+    ROOT::Fit::FillData(fitData, &histogram, &Gaus);
+
+    ROOT::Math::WrappedMultiTF1 fitFunction(Gaus, 1);
+    ROOT::Fit::Fitter           fitter;
+
+    fitter.Config().SetMinimizer(fMinimizerType.c_str());
+    fitter.SetFunction(fitFunction, false);
+
+    // "B": the parameter limits of the function, and their steps
+    for(int ipar = 0; ipar < Gaus.GetNpar(); ipar++)
+    {
+        ROOT::Fit::ParameterSettings& parSettings = fitter.Config().ParSettings(ipar);
+        double parMin, parMax;
+
+        Gaus.GetParLimits(ipar, parMin, parMax);
+
+        if (parMin * parMax != 0. && parMin >= parMax) parSettings.Fix();
+        else if (parMin < parMax) parSettings.SetLimits(parMin, parMax);
+
+        double const parError = Gaus.GetParError(ipar);
+
+        if (parError > 0.) parSettings.SetStepSize(parError);
+        else if (parMin < parMax && parMax < std::numeric_limits<double>::max() && parMin > -std::numeric_limits<double>::max())
+        {
+            double step = 0.1 * (parMax - parMin);
+
+            if      (parSettings.Value() < parMax && parMax - parSettings.Value() < 2. * step) step = (parMax - parSettings.Value()) / 2.;
+            else if (parSettings.Value() > parMin && parSettings.Value() - parMin < 2. * step) step = (parSettings.Value() - parMin) / 2.;
+
+            parSettings.SetStepSize(step);
+        }
+    }
+
     int fitResult{-1};
 
     try
-    { fitResult = fHistogram.Fit(&Gaus,"QNWB","", 0., roiSize);}
+    {
+        fitter.Fit(fitData);
+        fitResult = fitter.Result().Status();
+    }
     catch(...)
     {mf::LogWarning("GausHitFinder") << "Fitter failed finding a hit";}
 
     // If the fit result is not zero there was an error
     if (!fitResult)
     {
+        Gaus.SetFitResult(fitter.Result());
+
         // ##################################################
         // ### Getting the fitted parameters from the fit ###
         // ##################################################
@@ -264,9 +351,9 @@ void PeakFitterGaussian::findPeakParameters(const std::vector<float>&
 
             if (fOutputHistograms)
             {
-                fFitPeakPositionHist->Fill(peakParams.peakCenter, 1.);
-                fFitPeakWidHist->Fill(peakParams.peakSigma, 1.);
-                fFitPeakAmpitudeHist->Fill(peakParams.peakAmplitude, 1.);
+                fFitPeakPositionHist.Fill(peakParams.peakCenter, 1.);
+                fFitPeakWidHist.Fill(peakParams.peakSigma, 1.);
+                fFitPeakAmpitudeHist.Fill(peakParams.peakAmplitude, 1.);
             }
 
             peakParamsVec.emplace_back(peakParams);
@@ -274,7 +361,7 @@ void PeakFitterGaussian::findPeakParameters(const std::vector<float>&
             parIdx += 3;
         }
 
-        if (fOutputHistograms) fFitBaselineHist->Fill(Gaus.GetParameter(3*nGaus), 1.);
+        if (fOutputHistograms) fFitBaselineHist.Fill(Gaus.GetParameter(3*nGaus), 1.);
     }
 #if 0
     Gaus.Delete();
@@ -282,5 +369,22 @@ void PeakFitterGaussian::findPeakParameters(const std::vector<float>&
     return;
 }
 
+// --------------------------------------------------------------------------------------------
+void PeakFitterGaussian::endJob()
+{
+    fNumCandHitsHist.Merge();
+    fROISizeHist.Merge();
+    fCandPeakPositionHist.Merge();
+    fCandPeakWidHist.Merge();
+    fCandPeakAmpitudeHist.Merge();
+    fCandBaselineHist.Merge();
+    fFitPeakPositionHist.Merge();
+    fFitPeakWidHist.Merge();
+    fFitPeakAmpitudeHist.Merge();
+    fFitBaselineHist.Merge();
+
+    return;
+}
+
 DEFINE_ART_CLASS_TOOL(PeakFitterGaussian)
 }
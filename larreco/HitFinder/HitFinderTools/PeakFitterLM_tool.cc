@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////
+/// \file   PeakFitterLM_tool.cc
+/// \brief  Multi-Gaussian peak fitter using an analytic Levenberg-Marquardt
+///         minimisation (hit::MultiGausFitter) directly on the ROI samples.
+///
+/// No ROOT object is involved and the tool keeps no mutable state, so it
+/// is safe to use from the parallel wire loop of GausHitFinder.
+////////////////////////////////////////////////////////////////////////
+
+#include "larreco/HitFinder/HitFinderTools/IPeakFitter.h"
+#include "larreco/RecoAlg/MultiGausFitter.h"
+
+#include "art/Utilities/ToolMacros.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace reco_tool {
+
+  class PeakFitterLM : IPeakFitter {
+  public:
+    explicit PeakFitterLM(const fhicl::ParameterSet& pset);
+
+    void findPeakParameters(const std::vector<float>&,
+                            const ICandidateHitFinder::HitCandidateVec&,
+                            PeakParamsVec&,
+                            double&,
+                            int&) const override;
+
+  private:
+    //Variables from the fhicl file
+    const double fMinWidth;     ///< minimum initial width for gaussian fit
+    const double fMaxWidthMult; ///< multiplier for max width for gaussian fit
+    const double fPeakRange;    ///< set range limits for peak center
+    const double fAmpRange;     ///< set range limit for peak amplitude
+    const bool fFloatBaseline;  ///< Allow baseline to "float" away from zero
+
+    const hit::MultiGausFitter fFitter; ///< the actual (stateless) fitter
+  };
+
+  //--------------------------
+  //constructor
+
+  PeakFitterLM::PeakFitterLM(const fhicl::ParameterSet& pset)
+    : fMinWidth(pset.get<double>("MinWidth", 0.5))
+    , fMaxWidthMult(pset.get<double>("MaxWidthMult", 3.))
+    , fPeakRange(pset.get<double>("PeakRangeFact", 2.))
+    , fAmpRange(pset.get<double>("PeakAmpRange", 2.))
+    , fFloatBaseline(pset.get<bool>("FloatBaseline", false))
+    , fFitter(pset.get<unsigned int>("MaxIterations", 100),
+              pset.get<double>("Chi2Tolerance", 1e-5))
+  {}
+
+  //------------------------
+  void
+  PeakFitterLM::findPeakParameters(const std::vector<float>& roiSignalVec,
+                                   const ICandidateHitFinder::HitCandidateVec& hitCandidateVec,
+                                   PeakParamsVec& peakParamsVec,
+                                   double& chi2PerNDF,
+                                   int& NDF) const
+  {
+    // *** NOTE: as for PeakFitterGaussian, the reference time for input hit
+    //           candidates is the first tick of the input waveform (ie 0)
+    if (hitCandidateVec.empty()) return;
+
+    // in case of a fit failure, set the chi-square to infinity
+    chi2PerNDF = std::numeric_limits<double>::infinity();
+
+    // too many Gaussians for the fixed size storage of the fitter: let the
+    // caller fall back to its long pulse treatment
+    if (hitCandidateVec.size() > hit::MultiGausFitter::MaxGaussians) {
+      mf::LogDebug("PeakFitterLM") << "Skipping fit of " << hitCandidateVec.size()
+                                   << " candidates (maximum is "
+                                   << hit::MultiGausFitter::MaxGaussians << ")";
+      return;
+    }
+
+    int startTime = hitCandidateVec.front().startTick;
+    int endTime = hitCandidateVec.back().stopTick;
+    int roiSize = endTime - startTime;
+
+    hit::MultiGausFitter::Parameters_t params;
+    params.nGaus = hitCandidateVec.size();
+    params.floatBaseline = fFloatBaseline;
+
+    // Set the baseline if so desired
+    float baseline(0.);
+
+    if (fFloatBaseline) {
+      baseline = roiSignalVec[startTime];
+      params.SetBaseline(baseline, baseline - 12., baseline + 12.);
+    }
+    else
+      params.SetBaseline(baseline, baseline, baseline);
+
+    size_t iGaus(0);
+    for (auto const& candidateHit : hitCandidateVec) {
+      double const peakMean = candidateHit.hitCenter - float(startTime);
+      double const peakWidth = candidateHit.hitSigma;
+      double const amplitude = candidateHit.hitHeight - baseline;
+      double const meanLowLim = std::max(peakMean - fPeakRange * peakWidth, 0.);
+      double const meanHiLim = std::min(peakMean + fPeakRange * peakWidth, double(roiSize));
+
+      params.SetGaussian(iGaus++,
+                         amplitude,
+                         0.1 * amplitude,
+                         fAmpRange * amplitude,
+                         peakMean,
+                         meanLowLim,
+                         meanHiLim,
+                         peakWidth,
+                         std::max(fMinWidth, 0.1 * peakWidth),
+                         fMaxWidthMult * peakWidth);
+    }
+
+    float const* roiStart = roiSignalVec.data() + startTime;
+    hit::MultiGausFitter::FitResult_t const fitResult =
+      fFitter.Fit(roiStart, roiStart + roiSize, params);
+
+    if (!fitResult.valid) return;
+
+    NDF = fitResult.NDF;
+    chi2PerNDF = fitResult.chi2 / NDF;
+
+    for (size_t parIdx = 0; parIdx < 3 * params.nGaus; parIdx += 3) {
+      PeakFitParams_t peakParams;
+
+      peakParams.peakAmplitude = params.value[parIdx];
+      peakParams.peakAmplitudeError = params.error[parIdx];
+      peakParams.peakCenter = params.value[parIdx + 1] + float(startTime);
+      peakParams.peakCenterError = params.error[parIdx + 1];
+      peakParams.peakSigma = params.value[parIdx + 2];
+      peakParams.peakSigmaError = params.error[parIdx + 2];
+
+      peakParamsVec.emplace_back(peakParams);
+    }
+
+    return;
+  }
+
+  DEFINE_ART_CLASS_TOOL(PeakFitterLM)
+}
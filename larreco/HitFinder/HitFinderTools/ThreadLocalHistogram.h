@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////
+///
+/// \file   ThreadLocalHistogram.h
+///
+/// \brief  Accumulates the fills of a 1D histogram separately for each
+///         thread, and adds them to the actual histogram on request
+///
+///         This allows tools called from a parallel loop to keep
+///         diagnostic histograms: fills only touch thread local storage,
+///         and the ROOT histogram is modified only by Merge(), which is
+///         meant to be called once, serially, at the end of the job.
+///
+////////////////////////////////////////////////////////////////////////
+
+#ifndef ThreadLocalHistogram_H
+#define ThreadLocalHistogram_H
+
+#include "TAxis.h"
+#include "TH1.h"
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include <vector>
+
+namespace reco_tool {
+  class ThreadLocalHistogram {
+  public:
+    ThreadLocalHistogram() = default;
+    explicit ThreadLocalHistogram(TH1* hist) { setHistogram(hist); }
+
+    // Set the histogram the fills will eventually go to (nullptr disables filling)
+    void
+    setHistogram(TH1* hist)
+    {
+      fHist = hist;
+      fNumBins = hist ? hist->GetNbinsX() + 2 : 0; // includes under/overflow
+    }
+
+    // Fill this thread's copy of the bins; safe to call concurrently
+    void
+    Fill(double x, double weight = 1.) const
+    {
+      if (!fHist) return;
+
+      LocalBins& localBins = fLocalBins.local();
+
+      if (localBins.content.empty()) localBins.content.resize(fNumBins, 0.);
+
+      localBins.content[fHist->GetXaxis()->FindFixBin(x)] += weight;
+      localBins.entries += 1.;
+    }
+
+    // Add the content of all the threads to the histogram; not thread safe
+    void
+    Merge()
+    {
+      if (!fHist) return;
+
+      for (const auto& localBins : fLocalBins) {
+        for (size_t bin = 0; bin < localBins.content.size(); bin++) {
+          if (localBins.content[bin] != 0.) fHist->AddBinContent(bin, localBins.content[bin]);
+        }
+
+        fHist->SetEntries(fHist->GetEntries() + localBins.entries);
+      }
+
+      fLocalBins.clear();
+    }
+
+  private:
+    struct LocalBins {
+      std::vector<double> content;
+      double entries = 0.;
+    };
+
+    TH1* fHist = nullptr;
+    size_t fNumBins = 0;
+
+    // Filling only modifies the storage of the calling thread
+    mutable tbb::enumerable_thread_specific<LocalBins> fLocalBins;
+  };
+}
+
+#endif
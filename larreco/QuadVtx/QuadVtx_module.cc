@@ -3,6 +3,8 @@
 #include "larreco/QuadVtx/HeatMap.h"
 
 // C/C++ standard libraries
+#include <atomic>
+#include <cstring>
 #include <iostream>
 #include <random>
 #include <string>
@@ -15,6 +17,7 @@
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art_root_io/TFileService.h"
 #include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Utilities/Exception.h"
 #include "cetlib/pow.h"
 #include "fhiclcpp/ParameterSet.h"
 
@@ -24,10 +27,13 @@
 #include "lardataobj/RecoBase/Hit.h"
 #include "lardataobj/RecoBase/Vertex.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+
 #include "TGraph.h"
 #include "TH2F.h"
 #include "TMatrixD.h"
-#include "TVectorD.h"
 
 namespace quad {
 
@@ -87,6 +93,10 @@ namespace quad {
 
     bool fSavePlots;
 
+    size_t fMaxLines;   ///< cap on the lines built from pairs of hits in a view
+    size_t fMaxMapPts;  ///< cap on the line intersections filled in a heat map
+    bool fRunParallel;  ///< fill the heat maps and search the peak concurrently
+
     const geo::GeometryCore* geom;
   };
 
@@ -97,7 +107,15 @@ namespace quad {
     : EDProducer(pset)
     , fHitLabel(pset.get<std::string>("HitLabel"))
     , fSavePlots(pset.get<bool>("SavePlots"))
+    , fMaxLines(pset.get<size_t>("MaxLines", 10 * 1000 * 1000))
+    , fMaxMapPts(pset.get<size_t>("MaxMapPoints", 10 * 1000 * 1000))
+    , fRunParallel(pset.get<bool>("RunParallel", false))
   {
+    // both are divisors of the number of candidates, when computing the stride
+    if (fMaxLines == 0 || fMaxMapPts == 0)
+      throw art::Exception(art::errors::Configuration)
+        << "QuadVtx: MaxLines and MaxMapPoints must be positive";
+
     produces<std::vector<recob::Vertex>>();
   }
 
@@ -141,16 +159,15 @@ namespace quad {
   void
   LinesFromPoints(const std::vector<Pt2D>& pts,
                   std::vector<Line2D>& lines,
+                  size_t maxLines, // 10M lines is 150MB...
                   float z0 = 0,
                   float x0 = 0,
                   float R = -1)
   {
-    constexpr size_t kMaxLines = 10 * 1000 * 1000; // This is 150MB of lines...
-
     const size_t product = (pts.size() * (pts.size() - 1)) / 2;
-    const int stride = product / kMaxLines + 1;
+    const int stride = product / maxLines + 1;
 
-    lines.reserve(std::min(product, kMaxLines));
+    lines.reserve(std::min(product, maxLines));
 
     for (int offset = 0; offset < stride; ++offset) {
       for (unsigned int i = 0; i < pts.size(); ++i) {
@@ -166,7 +183,7 @@ namespace quad {
           }
 
           lines.push_back(std::move(l));
-          if (lines.size() == kMaxLines) goto end; // break out of 3 loops
+          if (lines.size() == maxLines) goto end; // break out of 3 loops
         }
       }
     }
@@ -176,7 +193,7 @@ namespace quad {
     lines.shrink_to_fit();
 
     mf::LogInfo() << "Made " << lines.size() << " lines using stride " << stride
-                  << " to fit under cap of " << kMaxLines << std::endl;
+                  << " to fit under cap of " << maxLines << std::endl;
 
     // Lines are required to be sorted by gradient for a later optimization
     std::sort(lines.begin(), lines.end());
@@ -191,71 +208,165 @@ namespace quad {
     return cet::square(dot) > (1 + cet::square(ma)) * (1 + cet::square(mb)) * cet::square(cosCrit);
   }
 
+  // ---------------------------------------------------------------------------
+  // Move [j0, jmax) on to the lines that line i is combined with: the ones
+  // following the run of lines with angles close to it. The window only moves
+  // forward as i increases.
+  inline void
+  AdvanceWindow(const std::vector<Line2D>& lines,
+                unsigned int i,
+                unsigned int& j0,
+                unsigned int& jmax)
+  {
+    const float m = lines[i].m;
+
+    j0 = std::max(j0, i + 1);
+    while (j0 < lines.size() && CloseAngles(m, lines[j0].m))
+      ++j0;
+    jmax = std::max(jmax, j0);
+    while (jmax < lines.size() && !CloseAngles(m, lines[jmax].m))
+      ++jmax;
+  }
+
   // ---------------------------------------------------------------------------
   void
-  MapFromLines(const std::vector<Line2D>& lines, HeatMap& hm)
+  MapFromLines(const std::vector<Line2D>& lines, HeatMap& hm, size_t maxPts, bool parallel)
   {
-    // This maximum is driven by runtime
-    constexpr size_t kMaxPts = 10 * 1000 * 1000;
+    // Lines are filled in blocks, each starting from the window the serial
+    // scan had reached, so the blocks can be filled independently
+    constexpr unsigned int kBlockSize = 4096;
+    std::vector<std::pair<unsigned int, unsigned int>> blockWindows;
 
     unsigned int j0 = 0;
     unsigned int jmax = 0;
 
     long npts = 0;
     for (unsigned int i = 0; i + 1 < lines.size(); ++i) {
-      const Line2D a = lines[i];
+      if (i % kBlockSize == 0) blockWindows.emplace_back(j0, jmax);
 
-      j0 = std::max(j0, i + 1);
-      while (j0 < lines.size() && CloseAngles(a.m, lines[j0].m))
-        ++j0;
-      jmax = std::max(jmax, j0);
-      while (jmax < lines.size() && !CloseAngles(a.m, lines[jmax].m))
-        ++jmax;
+      AdvanceWindow(lines, i, j0, jmax);
 
       npts += jmax - j0;
     }
 
     const size_t product = (lines.size() * (lines.size() - 1)) / 2;
-    const int stride = npts / kMaxPts + 1;
+    const int stride = npts / maxPts + 1;
 
     mf::LogInfo() << "Combining lines to points with stride " << stride << std::endl;
 
     mf::LogInfo() << npts << " cf " << product << " ie " << double(npts) / product << std::endl;
 
-    j0 = 0;
-    jmax = 0;
+    auto fillBlock = [&lines, stride](unsigned int block,
+                                      unsigned int j0,
+                                      unsigned int jmax,
+                                      HeatMap& map) {
+      const unsigned int iend = std::min<size_t>((block + 1) * kBlockSize, lines.size() - 1);
+      for (unsigned int i = block * kBlockSize; i < iend; ++i) {
+        const Line2D a = lines[i];
+
+        AdvanceWindow(lines, i, j0, jmax);
+
+        for (unsigned int j = j0; j < jmax; j += stride) {
+          const Line2D& b = lines[j];
+
+          // x = mA * z + cA = mB * z + cB
+          const float z = (b.c - a.c) / (a.m - b.m);
+          const float x = a.m * z + a.c;
+
+          // No solutions within a line
+          if ((z < a.minz || z > a.maxz) && (z < b.minz || z > b.maxz)) {
+            const int iz = map.ZToBin(z);
+            const int ix = map.XToBin(x);
+            if (iz >= 0 && iz < map.Nz && ix >= 0 && ix < map.Nx) {
+              map.map[iz * map.Nx + ix] += stride;
+            }
+          }
+        } // end for j
+      }   // end for i
+    };
 
-    for (unsigned int i = 0; i + 1 < lines.size(); ++i) {
-      const Line2D a = lines[i];
-
-      j0 = std::max(j0, i + 1);
-      while (j0 < lines.size() && CloseAngles(a.m, lines[j0].m))
-        ++j0;
-      jmax = std::max(jmax, j0);
-      while (jmax < lines.size() && !CloseAngles(a.m, lines[jmax].m))
-        ++jmax;
-
-      for (unsigned int j = j0; j < jmax; j += stride) {
-        const Line2D& b = lines[j];
-
-        // x = mA * z + cA = mB * z + cB
-        const float z = (b.c - a.c) / (a.m - b.m);
-        const float x = a.m * z + a.c;
-
-        // No solutions within a line
-        if ((z < a.minz || z > a.maxz) && (z < b.minz || z > b.maxz)) {
-          const int iz = hm.ZToBin(z);
-          const int ix = hm.XToBin(x);
-          if (iz >= 0 && iz < hm.Nz && ix >= 0 && ix < hm.Nx) { hm.map[iz * hm.Nx + ix] += stride; }
-        }
-      } // end for i
+    if (!parallel) {
+      for (unsigned int block = 0; block < blockWindows.size(); ++block) {
+        fillBlock(block, blockWindows[block].first, blockWindows[block].second, hm);
+      }
+      return;
+    }
+
+    // Each thread fills its own map. Bin contents are whole numbers, so the
+    // sum does not depend on how the blocks were shared out.
+    tbb::enumerable_thread_specific<HeatMap> localMaps(
+      HeatMap(hm.Nz, hm.minz, hm.maxz, hm.Nx, hm.minx, hm.maxx));
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, blockWindows.size(), 1),
+                      [&](const tbb::blocked_range<size_t>& range) {
+                        HeatMap& local = localMaps.local();
+                        for (size_t block = range.begin(); block < range.end(); ++block) {
+                          fillBlock(block,
+                                    blockWindows[block].first,
+                                    blockWindows[block].second,
+                                    local);
+                        }
+                      });
+
+    for (const HeatMap& local : localMaps) {
+      for (size_t bin = 0; bin < hm.map.size(); ++bin)
+        hm.map[bin] += local.map[bin];
+    }
+  }
+
+  // ---------------------------------------------------------------------------
+  // Four floats handled as one SIMD register (GCC/clang vector extension)
+  typedef float Float4 __attribute__((vector_size(16)));
+  typedef int Int4 __attribute__((vector_size(16)));
+
+  // The first x bin with the highest sum of the three rows, if that sum is
+  // above minscore, and -1 otherwise. The maximum is found four bins at a
+  // time, and the rows are only scanned again for its position when it beats
+  // minscore, which is rare once a good candidate has been found.
+  inline int
+  BestXBin(const float* __restrict__ h0,
+           const float* __restrict__ h1,
+           const float* __restrict__ h2,
+           int Nx,
+           float bonus,
+           float minscore,
+           float& score)
+  {
+    Float4 lanemax = {-1, -1, -1, -1};
+    int ix = 1;
+    for (; ix + 4 <= Nx - 1; ix += 4) {
+      Float4 a, b, c;
+      std::memcpy(&a, h0 + ix, sizeof(a));
+      std::memcpy(&b, h1 + ix, sizeof(b));
+      std::memcpy(&c, h2 + ix, sizeof(c));
+      const Float4 s = bonus * (a + b + c);
+      const Int4 better = s > lanemax;
+      lanemax = (Float4)((better & (Int4)s) | (~better & (Int4)lanemax));
+    }
+
+    float rowmax = std::max(std::max(lanemax[0], lanemax[1]), std::max(lanemax[2], lanemax[3]));
+    for (; ix < Nx - 1; ++ix) {
+      const float s = bonus * (h0[ix] + h1[ix] + h2[ix]);
+      if (s > rowmax) rowmax = s;
     }
+
+    if (!(rowmax > minscore)) return -1;
+
+    for (ix = 1; ix < Nx - 1; ++ix) {
+      if (bonus * (h0[ix] + h1[ix] + h2[ix]) == rowmax) {
+        score = rowmax;
+        return ix;
+      }
+    }
+    return -1;
   }
 
   // ---------------------------------------------------------------------------
   // Assumes that all three maps have the same vertical stride
   TVector3
-  FindPeak3D(const std::vector<HeatMap>& hs, const std::vector<TVector3>& dirs) noexcept
+  FindPeak3D(const std::vector<HeatMap>& hs,
+             const std::vector<TVector3>& dirs,
+             bool parallel)
   {
     assert(hs.size() == 3);
     assert(dirs.size() == 3);
@@ -273,8 +384,10 @@ namespace quad {
 
     M.Invert();
 
-    float bestscore = -1;
-    TVector3 bestr;
+    // Plain copies, to keep ROOT objects out of the loops below
+    const double Minv[2][2] = {{M(0, 0), M(0, 1)}, {M(1, 0), M(1, 1)}};
+    const double dirVY = dirs[2].Y();
+    const double dirVZ = dirs[2].Z();
 
     // Accumulate some statistics up front that will enable us to optimize
     std::vector<float> colMax[3];
@@ -285,43 +398,79 @@ namespace quad {
       }
     }
 
-    for (int iz = 0; iz < hs[0].Nz; ++iz) {
+    // Best score, and its x bin and y position, in each z row
+    std::vector<float> bestscores(hs[0].Nz, -1);
+    std::vector<int> bestixs(hs[0].Nz, -1);
+    std::vector<double> bestys(hs[0].Nz, 0);
+
+    // Best score of any row so far. It is only used to skip the (z, u) cells
+    // that cannot reach it, so the result does not depend on the order in
+    // which the rows are scanned.
+    std::atomic<float> record{-1};
+
+    // Serially bestscore is the best of all the rows so far, concurrently the
+    // best of row iz
+    auto scanZ = [&](int iz, float& bestscore) {
       const float z = hs[0].ZBinCenter(iz);
       const float bonus = 1; // works badly... exp((hs[0].maxz-z)/1000.);
 
       for (int iu = 0; iu < hs[1].Nz; ++iu) {
         const float u = hs[1].ZBinCenter(iu);
         // r.Dot(d0) = z && r.Dot(d1) = u
-        TVectorD p(2);
-        p(0) = z;
-        p(1) = u;
-        const TVectorD r = M * p;
-        const float v = r[0] * dirs[2].Y() + r[1] * dirs[2].Z();
+        const double r[2] = {Minv[0][0] * z + Minv[0][1] * u, Minv[1][0] * z + Minv[1][1] * u};
+        const float v = r[0] * dirVY + r[1] * dirVZ;
         const int iv = hs[2].ZToBin(v);
         if (iv < 0 || iv >= hs[2].Nz) continue;
-        const double y = r(0);
+        const double y = r[0];
 
         // Even if the maxes were all at the same x we couldn't beat the record
-        if (colMax[0][iz] + colMax[1][iu] + colMax[2][iv] < bestscore) continue;
-
-        // Attempt to micro-optimize the dx loop below
-        const float* __restrict__ h0 = &hs[0].map[Nx * iz];
-        const float* __restrict__ h1 = &hs[1].map[Nx * iu];
-        const float* __restrict__ h2 = &hs[2].map[Nx * iv];
-
-        int bestix = -1;
-        for (int ix = 1; ix < Nx - 1; ++ix) {
-          const float score = bonus * (h0[ix] + h1[ix] + h2[ix]);
-
-          if (score > bestscore) {
-            bestscore = score;
-            bestix = ix;
-          }
-        } // end for dx
-
-        if (bestix != -1) { bestr = TVector3(hs[0].XBinCenter(bestix), y, z); }
+        if (colMax[0][iz] + colMax[1][iu] + colMax[2][iv] <
+            std::max(bestscore, record.load(std::memory_order_relaxed)))
+          continue;
+
+        const int bestix = BestXBin(&hs[0].map[Nx * iz],
+                                    &hs[1].map[Nx * iu],
+                                    &hs[2].map[Nx * iv],
+                                    Nx,
+                                    bonus,
+                                    bestscore,
+                                    bestscore);
+
+        if (bestix != -1) {
+          bestscores[iz] = bestscore;
+          bestixs[iz] = bestix;
+          bestys[iz] = y;
+
+          float prev = record.load(std::memory_order_relaxed);
+          while (bestscore > prev && !record.compare_exchange_weak(prev, bestscore))
+            ;
+        }
       } // end for u
-    }   // end for z
+    };
+
+    if (parallel) {
+      tbb::parallel_for(tbb::blocked_range<int>(0, hs[0].Nz, 1),
+                        [&](const tbb::blocked_range<int>& range) {
+                          for (int iz = range.begin(); iz < range.end(); ++iz) {
+                            float bestscore = -1;
+                            scanZ(iz, bestscore);
+                          }
+                        });
+    }
+    else {
+      float bestscore = -1;
+      for (int iz = 0; iz < hs[0].Nz; ++iz)
+        scanZ(iz, bestscore);
+    } // end for z
+
+    // The first row with the best score, as the serial scan keeps it
+    float bestscore = -1;
+    TVector3 bestr;
+    for (int iz = 0; iz < hs[0].Nz; ++iz) {
+      if (bestixs[iz] == -1 || !(bestscores[iz] > bestscore)) continue;
+      bestscore = bestscores[iz];
+      bestr = TVector3(hs[0].XBinCenter(bestixs[iz]), bestys[iz], hs[0].ZBinCenter(iz));
+    }
 
     return bestr;
   }
@@ -439,16 +588,16 @@ namespace quad {
       if (pts[view].empty()) return false;
 
       std::vector<Line2D> lines;
-      LinesFromPoints(pts[view], lines);
+      LinesFromPoints(pts[view], lines, fMaxLines);
 
       if (lines.empty()) return false;
 
       // Approximately cm bins
       hms.emplace_back(maxz[view] - minz[view], minz[view], maxz[view], maxx - minx, minx, maxx);
-      MapFromLines(lines, hms.back());
+      MapFromLines(lines, hms.back(), fMaxMapPts, fRunParallel);
     } // end for view
 
-    vtx = FindPeak3D(hms, dirs);
+    vtx = FindPeak3D(hms, dirs, fRunParallel);
 
     std::vector<HeatMap> hms_zoom;
     hms_zoom.reserve(3);
@@ -457,17 +606,17 @@ namespace quad {
       const double z0 = vtx.Dot(dirs[view]);
 
       std::vector<Line2D> lines;
-      LinesFromPoints(pts[view], lines, z0, x0, 2.5);
+      LinesFromPoints(pts[view], lines, fMaxLines, z0, x0, 2.5);
 
       if (lines.empty()) return false; // How does this happen??
 
       // mm granularity
       hms_zoom.emplace_back(50, z0 - 2.5, z0 + 2.5, 50, x0 - 2.5, x0 + 2.5);
 
-      MapFromLines(lines, hms_zoom.back());
+      MapFromLines(lines, hms_zoom.back(), fMaxMapPts, fRunParallel);
     }
 
-    vtx = FindPeak3D(hms_zoom, dirs);
+    vtx = FindPeak3D(hms_zoom, dirs, fRunParallel);
 
     if (fSavePlots) {
       art::TFileDirectory evt_dir =
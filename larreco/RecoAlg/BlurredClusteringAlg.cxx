@@ -31,6 +31,7 @@
 
 #include "range/v3/view.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -50,9 +51,9 @@ cluster::BlurredClusteringAlg::BlurredClusteringAlg(fhicl::ParameterSet const& p
   , fMinSeed{pset.get<double>("MinSeed")}
   , fTimeThreshold{pset.get<double>("TimeThreshold")}
   , fChargeThreshold{pset.get<double>("ChargeThreshold")}
-  , fKernelWidth{2 * fBlurWire + 1}
-  , fKernelHeight{2 * fBlurTick * fMaxTickWidthBlur + 1}
-  , fAllKernels{MakeKernels()}
+  , fWireKernels{MakeKernels(std::round(fSigmaWire), fBlurWire)}
+  , fTickKernels{MakeKernels(std::round(fSigmaTick) * fMaxTickWidthBlur,
+                             fBlurTick * fMaxTickWidthBlur)}
 {}
 
 cluster::BlurredClusteringAlg::~BlurredClusteringAlg()
@@ -108,7 +109,7 @@ cluster::BlurredClusteringAlg::CreateDebugPDF(int run, int subrun, int event)
 
 void
 cluster::BlurredClusteringAlg::ConvertBinsToClusters(
-  std::vector<std::vector<double>> const& image,
+  Image const& image,
   std::vector<std::vector<int>> const& allClusterBins,
   std::vector<art::PtrVector<recob::Hit>>& clusters) const
 {
@@ -132,80 +133,87 @@ cluster::BlurredClusteringAlg::ConvertBinsToClusters(
   }
 }
 
-std::vector<std::vector<double>>
-cluster::BlurredClusteringAlg::ConvertRecobHitsToVector(
+cluster::BlurredClusteringAlg::Image
+cluster::BlurredClusteringAlg::ConvertRecobHitsToImage(
   std::vector<art::Ptr<recob::Hit>> const& hits,
-  int const readoutWindowSize)
+  int const readoutWindowSize) const
 {
   // Define the size of this particular plane -- dynamically to avoid huge histograms
   int lowerTick = readoutWindowSize, upperTick{}, lowerWire = fGeom->MaxWires(), upperWire{};
+  std::vector<int> hitWires;
+  hitWires.reserve(hits.size());
   using lar::to_element;
   using ranges::views::transform;
   for (auto const& hit : hits | transform(to_element)) {
     int histWire = GlobalWire(hit.WireID());
+    hitWires.push_back(histWire);
     if (hit.PeakTime() < lowerTick) lowerTick = hit.PeakTime();
     if (hit.PeakTime() > upperTick) upperTick = hit.PeakTime();
     if (histWire < lowerWire) lowerWire = histWire;
     if (histWire > upperWire) upperWire = histWire;
   }
-  fLowerTick = lowerTick - 20;
-  fUpperTick = upperTick + 20;
-  fLowerWire = lowerWire - 20;
-  fUpperWire = upperWire + 20;
+  Image image;
+  image.lowerTick = lowerTick - 20;
+  image.lowerWire = lowerWire - 20;
+  image.nTicks = upperTick + 20 - image.lowerTick;
+  image.nWires = upperWire + 20 - image.lowerWire;
 
-  // Use a map to keep a track of the real hits and their wire/ticks
-  fHitMap.clear();
-  fHitMap.resize(fUpperWire - fLowerWire,
-                 std::vector<art::Ptr<recob::Hit>>(fUpperTick - fLowerTick));
-
-  // Create a 2D vector
-  std::vector<std::vector<double>> image(fUpperWire - fLowerWire,
-                                         std::vector<double>(fUpperTick - fLowerTick));
+  // Use the image to keep a track of the real hits and their wire/ticks
+  std::size_t const nbins = static_cast<std::size_t>(image.nWires) * image.nTicks;
+  image.charge.assign(nbins, 0.f);
+  image.hits.resize(nbins);
 
   // Look through the hits
-  for (auto const& hit : hits) {
-    int const wire = GlobalWire(hit->WireID());
-    auto const tick = static_cast<int>(hit->PeakTime());
+  for (std::size_t iHit = 0; iHit < hits.size(); ++iHit) {
+    auto const& hit = hits[iHit];
+    int const wire = hitWires[iHit] - image.lowerWire;
+    auto const tick = static_cast<int>(hit->PeakTime()) - image.lowerTick;
     float const charge = hit->Integral();
 
     // Fill hit map and keep a note of all real hits for later
-    if (charge > image.at(wire - fLowerWire).at(tick - fLowerTick)) {
-      image.at(wire - fLowerWire).at(tick - fLowerTick) = charge;
-      fHitMap[wire - fLowerWire][tick - fLowerTick] = hit;
+    std::size_t const bin = static_cast<std::size_t>(wire) * image.nTicks + tick;
+    if (charge > image.charge.at(bin)) {
+      if (image.hits[bin].isNull()) image.hitBins.push_back(bin);
+      image.charge[bin] = charge;
+      image.hits[bin] = hit;
     }
   }
+  std::sort(image.hitBins.begin(), image.hitBins.end());
 
   // Keep a note of dead wires
-  fDeadWires = std::vector<bool>(fUpperWire - fLowerWire, false);
+  image.deadWires = std::vector<bool>(image.nWires, false);
   geo::PlaneID const planeID = hits.front()->WireID().planeID();
 
-  for (int wire = fLowerWire; wire < fUpperWire; ++wire) {
-    raw::ChannelID_t const channel =
-      fGeom->PlaneWireToChannel(planeID.Plane, wire, planeID.TPC, planeID.Cryostat);
-    fDeadWires[wire - fLowerWire] = !fChanStatus.IsGood(channel);
+  for (int wire = 0; wire < image.nWires; ++wire) {
+    raw::ChannelID_t const channel = fGeom->PlaneWireToChannel(
+      planeID.Plane, wire + image.lowerWire, planeID.TPC, planeID.Cryostat);
+    image.deadWires[wire] = !fChanStatus.IsGood(channel);
   }
 
   return image;
 }
 
 int
-cluster::BlurredClusteringAlg::FindClusters(std::vector<std::vector<double>> const& blurred,
+cluster::BlurredClusteringAlg::FindClusters(Image const& image,
+                                            std::vector<float> const& blurred,
                                             std::vector<std::vector<int>>& allcluster) const
 {
   // Size of image in x and y
-  int const nbinsx = blurred.size();
-  int const nbinsy = blurred.at(0).size();
+  int const nbinsx = image.nWires;
+  int const nbinsy = image.nTicks;
   int const nbins = nbinsx * nbinsy;
 
   // Vectors to hold hit information
   std::vector<bool> used(nbins);
   std::vector<std::pair<double, int>> values;
 
-  // Place the bin number and contents as a pair in the values vector
+  // Place the bin number and contents as a pair in the values vector; only
+  // the bins above the seed threshold can start a cluster
   for (int xbin = 0; xbin < nbinsx; ++xbin) {
     for (int ybin = 0; ybin < nbinsy; ++ybin) {
-      int const bin = ConvertWireTickToBin(blurred, xbin, ybin);
-      values.emplace_back(ConvertBinToCharge(blurred, bin), bin);
+      double const blurred_binval = blurred[static_cast<std::size_t>(xbin) * nbinsy + ybin];
+      if (blurred_binval < fMinSeed) continue;
+      values.emplace_back(blurred_binval, ConvertWireTickToBin(image, xbin, ybin));
     }
   }
 
@@ -213,20 +221,17 @@ cluster::BlurredClusteringAlg::FindClusters(std::vector<std::vector<double>> con
   std::sort(values.rbegin(), values.rend());
 
   // Count the number of iterations of the cluster forming loop (== number of clusters)
-  int niter = 0;
+  std::size_t niter = 0;
 
   // Clustering loops
   // First loop - considers highest charge hits in decreasing order, and puts them in a new cluster if they aren't already clustered (makes new cluster every iteration)
   // Second loop - looks at the direct neighbours of this seed and clusters to this if above charge/time thresholds. Runs recursively over all hits in cluster (inc. new ones)
-  while (true) {
+  while (niter < values.size()) {
 
     // Start a new cluster each time loop is executed
     std::vector<int> cluster;
     std::vector<double> times;
 
-    // Get the highest charge bin (go no further if below seed threshold)
-    if (double const blurred_binval = values[niter].first; blurred_binval < fMinSeed) break;
-
     // Iterate through the bins from highest charge down
     int const bin = values[niter++].second;
 
@@ -238,7 +243,7 @@ cluster::BlurredClusteringAlg::FindClusters(std::vector<std::vector<double>> con
     cluster.push_back(bin);
 
     // Get the time of this hit
-    if (double const time = GetTimeOfBin(blurred, bin); time > 0) times.push_back(time);
+    if (double const time = GetTimeOfBin(image, bin); time > 0) times.push_back(time);
 
     // Now cluster neighbouring hits to this seed
     while (true) {
@@ -259,14 +264,14 @@ cluster::BlurredClusteringAlg::FindClusters(std::vector<std::vector<double>> con
             if (x == binx and y == biny) continue;
 
             // Get this bin
-            auto const bin = ConvertWireTickToBin(blurred, x, y);
+            auto const bin = ConvertWireTickToBin(image, x, y);
             if (bin >= nbinsx * nbinsy or bin < 0) continue;
             if (used[bin]) continue;
 
             // Get the blurred value and time for this bin
-            double const blurred_binval = ConvertBinToCharge(blurred, bin);
+            double const blurred_binval = blurred[ConvertBinToIndex(image, bin)];
             double const time =
-              GetTimeOfBin(blurred, bin); // NB for 'fake' hits, time is defaulted to -10000
+              GetTimeOfBin(image, bin); // NB for 'fake' hits, time is defaulted to -10000
 
             // Check real hits pass time cut (ignores fake hits)
             if (time > 0 && times.size() > 0 && !PassesTimeCut(times, time)) continue;
@@ -310,7 +315,7 @@ cluster::BlurredClusteringAlg::FindClusters(std::vector<std::vector<double>> con
               neighbouringBin % nbinsx == nbinsx - 1 || neighbouringBin >= nbinsx * (nbinsy - 1))
             continue;
 
-          double const time = GetTimeOfBin(blurred, neighbouringBin);
+          double const time = GetTimeOfBin(image, neighbouringBin);
 
           // If not already clustered and passes neighbour/time thresholds, add to cluster
           if (!used[neighbouringBin] &&
@@ -429,92 +434,212 @@ cluster::BlurredClusteringAlg::GlobalWire(const geo::WireID& wireID) const
   return std::round(globalWire);
 }
 
-std::vector<std::vector<double>>
-cluster::BlurredClusteringAlg::GaussianBlur(std::vector<std::vector<double>> const& image) const
+std::vector<float>
+cluster::BlurredClusteringAlg::GaussianBlur(Image const& image) const
 {
-  if (fSigmaWire == 0 and fSigmaTick == 0) return image;
-
-  auto const [blur_wire, blur_tick, sigma_wire, sigma_tick] = FindBlurringParameters();
+  if (fSigmaWire == 0 and fSigmaTick == 0) return image.charge;
+
+  auto const [blur_wire, blur_tick, sigma_wire, sigma_tick] = FindBlurringParameters(image);
+
+  // The Gaussian is separable: blur the hits in the tick direction first, then
+  // the result in the wire direction. Hits with dead wires in their blurring
+  // region are blurred one by one with the dead wire offsets, as they were before
+  int const nbinsx = image.nWires;
+  int const nbinsy = image.nTicks;
+  int const width = 2 * blur_wire + 1;
+  auto const tick_origin = fBlurTick * fMaxTickWidthBlur;
+  std::vector<float> tick_blurred(image.charge.size(), 0);
+  std::vector<float> blurred(image.charge.size(), 0);
+
+  // Ranges of ticks reached on each wire, which are all the wire blurring needs
+  std::vector<std::vector<std::pair<int, int>>> tick_ranges(nbinsx);
+
+  for (std::size_t const bin : image.hitBins) {
+    int const x = bin / nbinsy;
+    int const y = bin % nbinsy;
+
+    // Scale the tick blurring based on the width of the hit
+    int tick_scale = std::sqrt(cet::square(image.hits[bin]->RMS()) + cet::square(sigma_tick)) /
+                     (double)sigma_tick;
+    tick_scale = std::max(std::min(tick_scale, fMaxTickWidthBlur), 1);
+
+    // Find any dead wires in the potential blurring region
+    auto const [lower_bin_dead, upper_bin_dead] = DeadWireCount(image, x, width);
+    if (lower_bin_dead > 0 or upper_bin_dead > 0) {
+      BlurAcrossDeadWires(image,
+                          bin,
+                          {blur_wire, blur_tick, sigma_wire, sigma_tick * tick_scale},
+                          tick_scale,
+                          {lower_bin_dead, upper_bin_dead},
+                          blurred);
+      continue;
+    }
 
-  // Convolve the Gaussian
-  int width = 2 * blur_wire + 1;
-  int height = 2 * blur_tick + 1;
-  int nbinsx = image.size();
-  int nbinsy = image.at(0).size();
+    // Smear the charge of this hit
+    auto const& kernel = fTickKernels[sigma_tick * tick_scale];
+    int const first = std::max(y - blur_tick * tick_scale, 0);
+    int const last = std::min(y + blur_tick * tick_scale + 1, nbinsy);
+    float const charge = image.charge[bin];
+    float* const wire_bins = tick_blurred.data() + bin - y;
+    for (int tick = first; tick < last; ++tick)
+      wire_bins[tick] += kernel[tick_origin + tick - y] * charge;
+    tick_ranges[x].emplace_back(first, last);
+  } // hits to blur
 
-  // Blurred histogram and normalisation for each bin
-  std::vector<std::vector<double>> copy(nbinsx, std::vector<double>(nbinsy, 0));
+  auto const& kernel = fWireKernels[sigma_wire];
+  auto smear = [&](int from, int to, float weight, int first, int last) {
+    float const* const in = tick_blurred.data() + static_cast<std::size_t>(from) * nbinsy;
+    float* const out = blurred.data() + static_cast<std::size_t>(to) * nbinsy;
+    for (int tick = first; tick < last; ++tick)
+      out[tick] += weight * in[tick];
+  };
 
-  // Loop through all the bins in the histogram to blur
   for (int x = 0; x < nbinsx; ++x) {
-    for (int y = 0; y < nbinsy; ++y) {
-
-      if (image[x][y] == 0) continue;
-
-      // Scale the tick blurring based on the width of the hit
-      int tick_scale =
-        std::sqrt(cet::square(fHitMap[x][y]->RMS()) + cet::square(sigma_tick)) / (double)sigma_tick;
-      tick_scale = std::max(std::min(tick_scale, fMaxTickWidthBlur), 1);
-      auto const& correct_kernel = fAllKernels[sigma_wire][sigma_tick * tick_scale];
-
-      // Find any dead wires in the potential blurring region
-      auto const [lower_bin_dead, upper_bin_dead] = DeadWireCount(x, width);
-
-      // Note of how many dead wires we have passed whilst blurring in the wire direction
-      // If blurring below the seed hit, need to keep a note of how many dead wires to come
-      // If blurring above, need to keep a note of how many dead wires have passed
-      auto dead_wires_passed{lower_bin_dead};
-
-      // Loop over the blurring region around this hit
-      for (int blurx = -(width / 2 + lower_bin_dead); blurx < (width + 1) / 2 + upper_bin_dead;
-           ++blurx) {
-        if (x + blurx < 0) continue;
-        for (int blury = -height / 2 * tick_scale;
-             blury < ((((height + 1) / 2) - 1) * tick_scale) + 1;
-             ++blury) {
-          if (blurx < 0 and fDeadWires[x + blurx]) dead_wires_passed -= 1;
-
-          // Smear the charge of this hit
-          double const weight = correct_kernel[fKernelWidth * (fKernelHeight / 2 + blury) +
-                                               (fKernelWidth / 2 + (blurx - dead_wires_passed))];
-          if (x + blurx >= 0 and x + blurx < nbinsx and y + blury >= 0 and y + blury < nbinsy)
-            copy[x + blurx][y + blury] += weight * image[x][y];
-
-          if (blurx > 0 and fDeadWires[x + blurx]) dead_wires_passed += 1;
-        }
-      } // blurring region
+    auto& ranges = tick_ranges[x];
+    if (ranges.empty()) continue;
+
+    // Merge the overlapping ranges
+    std::sort(ranges.begin(), ranges.end());
+    std::size_t nranges = 0;
+    for (auto const& range : ranges) {
+      if (nranges > 0 && range.first <= ranges[nranges - 1].second)
+        ranges[nranges - 1].second = std::max(ranges[nranges - 1].second, range.second);
+      else
+        ranges[nranges++] = range;
     }
-  } // hits to blur
+    ranges.resize(nranges);
+
+    int const first_wire = std::max(x - blur_wire, 0);
+    int const last_wire = std::min(x + blur_wire + 1, nbinsx);
+    for (auto const& [first, last] : ranges) {
+      for (int wire = first_wire; wire < last_wire; ++wire)
+        smear(x, wire, kernel[fBlurWire + wire - x], first, last);
+    }
+  } // wires to blur
 
   // HAVE REMOVED NOMALISATION CODE
   // WHEN USING DIFFERENT KERNELS, THERE'S NO EASY WAY OF DOING THIS...
   // RECONSIDER...
 
   // Return the blurred histogram
-  return copy;
+  return blurred;
+}
+
+void
+cluster::BlurredClusteringAlg::BlurAcrossDeadWires(Image const& image,
+                                                   std::size_t const bin,
+                                                   std::array<int, 4> const& blurring,
+                                                   int const tick_scale,
+                                                   std::pair<int, int> const& deadWires,
+                                                   std::vector<float>& blurred) const
+{
+  auto const [blur_wire, blur_tick, sigma_wire, sigma_tick] = blurring;
+  int const nbinsx = image.nWires;
+  int const nbinsy = image.nTicks;
+  int const x = bin / nbinsy;
+  int const y = bin % nbinsy;
+  int const width = 2 * blur_wire + 1;
+  int const height = 2 * blur_tick + 1;
+  int const kernel_width = 2 * fBlurWire + 1;
+  int const kernel_height = 2 * fBlurTick * fMaxTickWidthBlur + 1;
+  double const charge = image.charge[bin];
+  auto const isDead = [&image](int wire) {
+    return wire < image.nWires and image.deadWires[wire];
+  };
+
+  // Note of how many dead wires we have passed whilst blurring in the wire direction
+  // If blurring below the seed hit, need to keep a note of how many dead wires to come
+  // If blurring above, need to keep a note of how many dead wires have passed
+  auto dead_wires_passed{deadWires.first};
+
+  // Loop over the blurring region around this hit
+  for (int blurx = -(width / 2 + deadWires.first); blurx < (width + 1) / 2 + deadWires.second;
+       ++blurx) {
+    if (x + blurx < 0) continue;
+    for (int blury = -height / 2 * tick_scale;
+         blury < ((((height + 1) / 2) - 1) * tick_scale) + 1;
+         ++blury) {
+      if (blurx < 0 and isDead(x + blurx)) dead_wires_passed -= 1;
+
+      // Smear the charge of this hit
+      double const weight = KernelWeight(sigma_wire,
+                                         sigma_tick,
+                                         kernel_width * (kernel_height / 2 + blury) +
+                                           (kernel_width / 2 + (blurx - dead_wires_passed)));
+      if (x + blurx >= 0 and x + blurx < nbinsx and y + blury >= 0 and y + blury < nbinsy)
+        blurred[static_cast<std::size_t>(x + blurx) * nbinsy + y + blury] += weight * charge;
+
+      if (blurx > 0 and isDead(x + blurx)) dead_wires_passed += 1;
+    }
+  } // blurring region
+}
+
+std::pair<int, int>
+cluster::BlurredClusteringAlg::DeadWireCount(Image const& image,
+                                             int const wire_bin,
+                                             int const width) const
+{
+  auto deadWires = std::make_pair(0, 0);
+
+  int const lower_bin = width / 2;
+  int const upper_bin = (width + 1) / 2;
+
+  for (int wire = std::max(wire_bin - lower_bin, 0);
+       wire < std::min(wire_bin + upper_bin, image.nWires);
+       ++wire) {
+    if (!image.deadWires[wire]) continue;
+
+    if (wire < wire_bin)
+      ++deadWires.first;
+    else if (wire > wire_bin)
+      ++deadWires.second;
+  }
+
+  return deadWires;
+}
+
+double
+cluster::BlurredClusteringAlg::KernelWeight(int const sigma_wire,
+                                            int const sigma_tick,
+                                            int const key) const
+{
+  // The weights of the two-dimensional kernel, stored tick by tick with the
+  // wires of a tick side by side. The dead wire offsets can move the key into
+  // the row of another tick, which is how the kernel was read before
+  int const kernel_width = 2 * fBlurWire + 1;
+  int const kernel_height = 2 * fBlurTick * fMaxTickWidthBlur + 1;
+  if (key < 0 or key >= kernel_width * kernel_height) return 0;
+  int const i = key % kernel_width - fBlurWire;
+  int const j = key / kernel_width - fBlurTick * fMaxTickWidthBlur;
+
+  double const sig2i = 2. * sigma_wire * sigma_wire;
+  double const sig2j = 2. * sigma_tick * sigma_tick;
+  return 1. / std::sqrt(sig2i * M_PI) * std::exp(-i * i / sig2i) * 1. / std::sqrt(sig2j * M_PI) *
+         std::exp(-j * j / sig2j);
 }
 
 TH2F*
-cluster::BlurredClusteringAlg::MakeHistogram(std::vector<std::vector<double>> const& image,
+cluster::BlurredClusteringAlg::MakeHistogram(Image const& image,
+                                             std::vector<float> const& charge,
                                              TString const name) const
 {
   auto hist = new TH2F(name,
                        name,
-                       fUpperWire - fLowerWire,
-                       fLowerWire - 0.5,
-                       fUpperWire - 0.5,
-                       fUpperTick - fLowerTick,
-                       fLowerTick - 0.5,
-                       fUpperTick - 0.5);
+                       image.nWires,
+                       image.lowerWire - 0.5,
+                       image.lowerWire + image.nWires - 0.5,
+                       image.nTicks,
+                       image.lowerTick - 0.5,
+                       image.lowerTick + image.nTicks - 0.5);
   hist->SetXTitle("Wire number");
   hist->SetYTitle("Tick number");
   hist->SetZTitle("Charge");
 
-  for (unsigned int imageWireIt = 0; imageWireIt < image.size(); ++imageWireIt) {
-    int const wire = imageWireIt + fLowerWire;
-    for (unsigned int imageTickIt = 0; imageTickIt < image.at(imageWireIt).size(); ++imageTickIt) {
-      int const tick = imageTickIt + fLowerTick;
-      hist->Fill(wire, tick, image.at(imageWireIt).at(imageTickIt));
+  for (int imageWireIt = 0; imageWireIt < image.nWires; ++imageWireIt) {
+    int const wire = imageWireIt + image.lowerWire;
+    for (int imageTickIt = 0; imageTickIt < image.nTicks; ++imageTickIt) {
+      int const tick = imageTickIt + image.lowerTick;
+      hist->Fill(wire, tick, charge[static_cast<std::size_t>(imageWireIt) * image.nTicks + imageTickIt]);
     }
   }
 
@@ -528,6 +653,10 @@ cluster::BlurredClusteringAlg::SaveImage(TH2F* image,
                                          int const tpc,
                                          int const plane)
 {
+  // The histogram bins start at the lowest wire and tick of the image
+  int const lowerWire = std::lround(image->GetXaxis()->GetXmin() + 0.5);
+  int const lowerTick = std::lround(image->GetYaxis()->GetXmin() + 0.5);
+
   // Make a vector of clusters
   std::vector<std::vector<int>> allClusterBins;
 
@@ -539,7 +668,7 @@ cluster::BlurredClusteringAlg::SaveImage(TH2F* image,
     for (auto const& hit : cluster) {
       unsigned int const wire = GlobalWire(hit->WireID());
       float const tick = hit->PeakTime();
-      int bin = image->GetBin((wire - fLowerWire) + 1, (tick - fLowerTick) + 1);
+      int bin = image->GetBin((wire - lowerWire) + 1, (tick - lowerTick) + 1);
       if (cluster.size() < fMinSize) bin *= -1;
 
       clusterBins.push_back(bin);
@@ -584,6 +713,8 @@ cluster::BlurredClusteringAlg::SaveImage(TH2F* image,
   image->DrawCopy("colz");
 
   // Draw the clustered hits on the histograms
+  int const lowerWire = std::lround(image->GetXaxis()->GetXmin() + 0.5);
+  int const lowerTick = std::lround(image->GetYaxis()->GetXmin() + 0.5);
   int clusterNum = 2;
   for (auto const& bins : allClusterBins) {
     TMarker mark(0, 0, 20);
@@ -599,7 +730,7 @@ cluster::BlurredClusteringAlg::SaveImage(TH2F* image,
 
       int wire, tick, z;
       image->GetBinXYZ(bin, wire, tick, z);
-      mark.DrawMarker(wire + fLowerWire - 1, tick + fLowerTick - 1);
+      mark.DrawMarker(wire + lowerWire - 1, tick + lowerTick - 1);
       mark.SetMarkerStyle(20);
     }
   }
@@ -613,7 +744,7 @@ cluster::BlurredClusteringAlg::SaveImage(TH2F* image,
 // Private member functions
 
 art::PtrVector<recob::Hit>
-cluster::BlurredClusteringAlg::ConvertBinsToRecobHits(std::vector<std::vector<double>> const& image,
+cluster::BlurredClusteringAlg::ConvertBinsToRecobHits(Image const& image,
                                                       std::vector<int> const& bins) const
 {
   // Create the vector of hits to output
@@ -633,70 +764,40 @@ cluster::BlurredClusteringAlg::ConvertBinsToRecobHits(std::vector<std::vector<do
 }
 
 art::Ptr<recob::Hit>
-cluster::BlurredClusteringAlg::ConvertBinToRecobHit(std::vector<std::vector<double>> const& image,
-                                                    int const bin) const
+cluster::BlurredClusteringAlg::ConvertBinToRecobHit(Image const& image, int const bin) const
 {
-  int const wire = bin % image.size();
-  int const tick = bin / image.size();
-  return fHitMap[wire][tick];
+  return image.hits[ConvertBinToIndex(image, bin)];
 }
 
 int
-cluster::BlurredClusteringAlg::ConvertWireTickToBin(std::vector<std::vector<double>> const& image,
+cluster::BlurredClusteringAlg::ConvertWireTickToBin(Image const& image,
                                                     int const xbin,
                                                     int const ybin) const
 {
-  return ybin * image.size() + xbin;
+  return ybin * image.nWires + xbin;
 }
 
-double
-cluster::BlurredClusteringAlg::ConvertBinToCharge(std::vector<std::vector<double>> const& image,
-                                                  int const bin) const
+std::size_t
+cluster::BlurredClusteringAlg::ConvertBinToIndex(Image const& image, int const bin) const
 {
-  int const x = bin % image.size();
-  int const y = bin / image.size();
-  return image.at(x).at(y);
-}
-
-std::pair<int, int>
-cluster::BlurredClusteringAlg::DeadWireCount(int const wire_bin, int const width) const
-{
-  auto deadWires = std::make_pair(0, 0);
-
-  int const lower_bin = width / 2;
-  int const upper_bin = (width + 1) / 2;
-
-  auto const offset = wire_bin + fLowerWire;
-  for (int wire = std::max(offset - lower_bin, fLowerWire);
-       wire < std::min(offset + upper_bin, fUpperWire);
-       ++wire) {
-    if (!fDeadWires[wire - fLowerWire]) continue;
-
-    if (wire < offset)
-      ++deadWires.first;
-    else if (wire > offset)
-      ++deadWires.second;
-  }
-
-  return deadWires;
+  int const wire = bin % image.nWires;
+  int const tick = bin / image.nWires;
+  return static_cast<std::size_t>(wire) * image.nTicks + tick;
 }
 
 std::array<int, 4>
-cluster::BlurredClusteringAlg::FindBlurringParameters() const
+cluster::BlurredClusteringAlg::FindBlurringParameters(Image const& image) const
 {
   // Calculate least squares slope
   double nhits{}, sumx{}, sumy{}, sumx2{}, sumxy{};
-  for (unsigned int wireIt = 0; wireIt < fHitMap.size(); ++wireIt) {
-    for (unsigned int tickIt = 0; tickIt < fHitMap.at(wireIt).size(); ++tickIt) {
-      if (fHitMap[wireIt][tickIt].isNull()) continue;
-      ++nhits;
-      int const x = wireIt + fLowerWire;
-      int const y = tickIt + fLowerTick;
-      sumx += x;
-      sumy += y;
-      sumx2 += x * x;
-      sumxy += x * y;
-    }
+  for (std::size_t const bin : image.hitBins) {
+    ++nhits;
+    int const x = bin / image.nTicks + image.lowerWire;
+    int const y = bin % image.nTicks + image.lowerTick;
+    sumx += x;
+    sumy += y;
+    sumx2 += x * x;
+    sumxy += x * y;
   }
   double const gradient = (nhits * sumxy - sumx * sumy) / (nhits * sumx2 - sumx * sumx);
 
@@ -714,47 +815,27 @@ cluster::BlurredClusteringAlg::FindBlurringParameters() const
 }
 
 double
-cluster::BlurredClusteringAlg::GetTimeOfBin(std::vector<std::vector<double>> const& image,
-                                            int const bin) const
+cluster::BlurredClusteringAlg::GetTimeOfBin(Image const& image, int const bin) const
 {
   auto const hit = ConvertBinToRecobHit(image, bin);
   return hit.isNull() ? -10000. : hit->PeakTime();
 }
 
-std::vector<std::vector<std::vector<double>>>
-cluster::BlurredClusteringAlg::MakeKernels() const
+std::vector<std::vector<float>>
+cluster::BlurredClusteringAlg::MakeKernels(int const maxSigma, int const radius) const
 {
   // Kernel size is the largest possible given the hit width rescaling
-  std::vector<std::vector<std::vector<double>>> allKernels(
-    fSigmaWire + 1,
-    std::vector<std::vector<double>>(fSigmaTick * fMaxTickWidthBlur + 1,
-                                     std::vector<double>(fKernelWidth * fKernelHeight)));
+  // (at least sigma 1, which the dynamic fixing always allows)
+  int const nSigmas = std::max(maxSigma, 1);
+  std::vector<std::vector<float>> allKernels(nSigmas + 1);
 
-  // Ranges of kernels to make
   // Complete range of sigmas possible after dynamic fixing and hit width convolution
-  for (int sigma_wire = 1; sigma_wire <= fSigmaWire; ++sigma_wire) {
-    for (int sigma_tick = 1; sigma_tick <= fSigmaTick * fMaxTickWidthBlur; ++sigma_tick) {
-
-      // New kernel
-      std::vector<double> kernel(fKernelWidth * fKernelHeight, 0);
-
-      // Smear out according to the blur radii in each direction
-      for (int i = -fBlurWire; i <= fBlurWire; i++) {
-        for (int j = -fBlurTick * fMaxTickWidthBlur; j <= fBlurTick * fMaxTickWidthBlur; j++) {
-
-          // Fill kernel
-          double const sig2i = 2. * sigma_wire * sigma_wire;
-          double const sig2j = 2. * sigma_tick * sigma_tick;
-
-          int const key = (fKernelWidth * (j + fBlurTick * fMaxTickWidthBlur)) + (i + fBlurWire);
-          double const value = 1. / std::sqrt(sig2i * M_PI) * std::exp(-i * i / sig2i) * 1. /
-                               std::sqrt(sig2j * M_PI) * std::exp(-j * j / sig2j);
-          kernel.at(key) = value;
-        }
-      } // End loop over blurring region
-
-      allKernels[sigma_wire][sigma_tick] = move(kernel);
-    }
+  for (int sigma = 1; sigma <= nSigmas; ++sigma) {
+    double const sig2 = 2. * sigma * sigma;
+    std::vector<float> kernel(2 * radius + 1, 0);
+    for (int i = -radius; i <= radius; ++i)
+      kernel[i + radius] = 1. / std::sqrt(sig2 * M_PI) * std::exp(-i * i / sig2);
+    allKernels[sigma] = move(kernel);
   }
   return allKernels;
 }
@@ -48,6 +48,17 @@ namespace cluster {
 
 class cluster::BlurredClusteringAlg {
 public:
+  /// Image of the hits of one plane, in a contiguous buffer where the bins
+  /// of each wire follow each other: (wire, tick) is at wire * nTicks + tick
+  struct Image {
+    int lowerWire{}, lowerTick{};
+    int nWires{}, nTicks{};
+    std::vector<float> charge;              ///< charge of the hit in each bin
+    std::vector<art::Ptr<recob::Hit>> hits; ///< hit in each bin, if any
+    std::vector<std::size_t> hitBins;       ///< bins with a hit, in increasing order
+    std::vector<bool> deadWires;
+  };
+
   BlurredClusteringAlg(fhicl::ParameterSet const& pset);
   ~BlurredClusteringAlg();
 
@@ -55,25 +66,24 @@ public:
   void CreateDebugPDF(int run, int subrun, int event);
 
   /// Takes a vector of clusters (itself a vector of hits) and turns them into clusters using the initial hit selection
-  void ConvertBinsToClusters(std::vector<std::vector<double>> const& image,
+  void ConvertBinsToClusters(Image const& image,
                              std::vector<std::vector<int>> const& allClusterBins,
                              std::vector<art::PtrVector<recob::Hit>>& clusters) const;
 
-  /// Takes hit map and returns a 2D vector representing wire and tick, filled with the charge
-  std::vector<std::vector<double>> ConvertRecobHitsToVector(
-    std::vector<art::Ptr<recob::Hit>> const& hits,
-    int readoutWindowSize);
+  /// Takes hit map and returns an image of the plane in wire and tick, filled with the charge
+  Image ConvertRecobHitsToImage(std::vector<art::Ptr<recob::Hit>> const& hits,
+                                int readoutWindowSize) const;
 
-  /// Find clusters in the histogram
-  int FindClusters(std::vector<std::vector<double>> const& image,
+  /// Find clusters in the blurred image
+  int FindClusters(Image const& image,
+                   std::vector<float> const& blurred,
                    std::vector<std::vector<int>>& allcluster) const;
 
   /// Find the global wire position
   int GlobalWire(geo::WireID const& wireID) const;
 
-  /// Applies Gaussian blur to image
-  std::vector<std::vector<double>> GaussianBlur(
-    std::vector<std::vector<double>> const& image) const;
+  /// Applies Gaussian blur to image, returning the blurred charge of each bin
+  std::vector<float> GaussianBlur(Image const& image) const;
 
   /// Minimum size of cluster to save
   unsigned int
@@ -82,8 +92,8 @@ public:
     return fMinSize;
   }
 
-  /// Converts a 2D vector in a histogram for the debug pdf
-  TH2F* MakeHistogram(std::vector<std::vector<double>> const& image, TString name) const;
+  /// Converts the charge of each bin of an image in a histogram for the debug pdf
+  TH2F* MakeHistogram(Image const& image, std::vector<float> const& charge, TString name) const;
 
   /// Save the images for debugging
   /// This version takes the final clusters and overlays on the hit map
@@ -105,32 +115,42 @@ public:
                  int plane);
 
 private:
+  /// Blurs the hit in a bin one wire and tick at a time, skipping the dead wires
+  /// in the blurring region by shifting the kernel
+  void BlurAcrossDeadWires(Image const& image,
+                           std::size_t bin,
+                           std::array<int, 4> const& blurring,
+                           int tick_scale,
+                           std::pair<int, int> const& deadWires,
+                           std::vector<float>& blurred) const;
+
+  /// Counts the dead wires below and above a wire within the blurring width
+  std::pair<int, int> DeadWireCount(Image const& image, int wire_bin, int width) const;
+
+  /// Weight of the two-dimensional kernel at an index (tick * kernel width + wire)
+  double KernelWeight(int sigma_wire, int sigma_tick, int key) const;
+
   /// Converts a vector of bins into a hit selection - not all the hits in the bins vector are real hits
-  art::PtrVector<recob::Hit> ConvertBinsToRecobHits(std::vector<std::vector<double>> const& image,
+  art::PtrVector<recob::Hit> ConvertBinsToRecobHits(Image const& image,
                                                     std::vector<int> const& bins) const;
 
   /// Converts a bin into a recob::Hit (not all of these bins correspond to recob::Hits - some are fake hits created by the blurring)
-  art::Ptr<recob::Hit> ConvertBinToRecobHit(std::vector<std::vector<double>> const& image,
-                                            int bin) const;
+  art::Ptr<recob::Hit> ConvertBinToRecobHit(Image const& image, int bin) const;
 
   /// Converts an xbin and a ybin to a global bin number
-  int ConvertWireTickToBin(std::vector<std::vector<double>> const& image, int xbin, int ybin) const;
+  int ConvertWireTickToBin(Image const& image, int xbin, int ybin) const;
 
-  /// Returns the charge stored in the global bin value
-  double ConvertBinToCharge(std::vector<std::vector<double>> const& image, int bin) const;
-
-  /// Count how many dead wires there are in the blurring region for a particular hit
-  /// Returns a pair of counters representing how many dead wires there are below and above the hit respectively
-  std::pair<int, int> DeadWireCount(int wire_bin, int width) const;
+  /// Converts a global bin number to the index of the bin in the image buffers
+  std::size_t ConvertBinToIndex(Image const& image, int bin) const;
 
   /// Dynamically find the blurring radii and Gaussian sigma in each dimension
-  std::array<int, 4> FindBlurringParameters() const;
+  std::array<int, 4> FindBlurringParameters(Image const& image) const;
 
   /// Returns the hit time of a hit in a particular bin
-  double GetTimeOfBin(std::vector<std::vector<double>> const& image, int bin) const;
+  double GetTimeOfBin(Image const& image, int bin) const;
 
-  /// Makes all the kernels which could be required given the tuned parameters
-  std::vector<std::vector<std::vector<double>>> MakeKernels() const;
+  /// Makes the one-dimensional kernels for each sigma from 1 to maxSigma, over the blur radius
+  std::vector<std::vector<float>> MakeKernels(int maxSigma, int radius) const;
 
   /// Determines the number of clustered neighbours of a hit
   unsigned int NumNeighbours(int nx, std::vector<bool> const& used, int bin) const;
@@ -156,16 +176,10 @@ private:
   double fTimeThreshold;   // time threshold for clustering
   double fChargeThreshold; // charge threshold for clustering
 
-  // Blurring stuff
-  int fKernelWidth, fKernelHeight;
-  std::vector<std::vector<std::vector<double>>> fAllKernels;
-
-  // Hit containers
-  std::vector<std::vector<art::Ptr<recob::Hit>>> fHitMap;
-  std::vector<bool> fDeadWires;
-
-  int fLowerTick, fUpperTick;
-  int fLowerWire, fUpperWire;
+  // Blurring stuff: the Gaussian kernel is separable, with one kernel in wire
+  // and one in tick for each sigma, centred in the middle of the vector
+  std::vector<std::vector<float>> fWireKernels;
+  std::vector<std::vector<float>> fTickKernels;
 
   // For the debug pdf
   TCanvas* fDebugCanvas{nullptr};
@@ -1,5 +1,7 @@
 #include "CBAlgoArray.h"
 
+#include <algorithm>
+
 namespace cmtool {
 
   //------------------------------------------
@@ -88,6 +90,43 @@ namespace cmtool {
     return status;
   }
 
+  //--------------------------------------------
+  double CBAlgoArray::MaxPairDistance() const
+  //--------------------------------------------
+  {
+    std::vector<double> dists;
+    for(auto const& algo : _algo_array) {
+      double const dist = algo->MaxPairDistance();
+      if(dist >= 0) dists.push_back(dist);
+    }
+    std::sort(dists.begin(),dists.end());
+
+    //
+    // Try the declared distances from the shortest: beyond it, the algorithms
+    // declaring it (or a shorter one) are false. Walk through the combination
+    // as Bool() does, keeping track of whether status may still be true.
+    //
+    for(double const max_dist : dists) {
+      bool maybe = true;
+      for(size_t i=0; i<_algo_array.size(); ++i) {
+	double const dist = _algo_array.at(i)->MaxPairDistance();
+	bool const maybe_algo = (dist < 0 || dist > max_dist);
+	if(!i) maybe = maybe_algo;
+	else if( _ask_and.at(i) ) {
+	  if(!maybe) break;
+	  maybe = maybe_algo;
+	}
+	else {
+	  // Bool() stops at an OR step once status is true
+	  if(maybe) break;
+	  maybe = maybe_algo;
+	}
+      }
+      if(!maybe) return max_dist;
+    }
+    return -1.;
+  }
+
   //------------------------
   void CBAlgoArray::Report()
   //------------------------
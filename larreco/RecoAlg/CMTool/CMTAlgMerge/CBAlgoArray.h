@@ -69,6 +69,12 @@ namespace cmtool {
     virtual bool Bool(const ::cluster::ClusterParamsAlg &cluster1,
 		      const ::cluster::ClusterParamsAlg &cluster2);
 
+    /**
+       Distance beyond which the combination of the algorithms is false for
+       sure, given the distances declared by each of them (if any).
+    */
+    virtual double MaxPairDistance() const;
+
     /**
        Optional function: called after each Merge() function call by CMergeManager IFF
        CMergeManager is run with verbosity level kPerMerging. Maybe useful for debugging.
@@ -39,6 +39,9 @@ namespace cmtool {
     virtual bool Bool(const ::cluster::ClusterParamsAlg &cluster1,
 		      const ::cluster::ClusterParamsAlg &cluster2);
 
+    /// A contained polygon has an envelope inside the other one
+    virtual double MaxPairDistance() const { return 0.; }
+
     /// Method to re-configure the instance
     void reconfigure();
 
@@ -39,6 +39,9 @@ namespace cmtool {
     virtual bool Bool(const ::cluster::ClusterParamsAlg &cluster1,
 		      const ::cluster::ClusterParamsAlg &cluster2);
 
+    /// Overlapping polygons have touching envelopes
+    virtual double MaxPairDistance() const { return 0.; }
+
     void SetDebug(bool debug) { _debug = debug; }
 
     //both clusters must have > this # of hits to be considered for merging
@@ -86,9 +86,8 @@ namespace cmtool {
 	float pt2t = cluster2.GetParams().PolyObject.Point(j).second;
 	double distsqrd = pow(pt2w-pt1w,2)+pow(pt2t-pt1t,2);
 
-	if(distsqrd < tmp_min_dist) tmp_min_dist = distsqrd;
-
 	if(_debug){
+	  if(distsqrd < tmp_min_dist) tmp_min_dist = distsqrd;
 	  std::cout<<"two polygon points dist2 is "<<distsqrd<<std::endl;
 	  std::cout<<"minimum dist was "<<tmp_min_dist<<std::endl;
 	}
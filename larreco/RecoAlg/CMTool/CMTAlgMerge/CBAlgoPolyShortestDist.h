@@ -14,6 +14,7 @@
 #ifndef RECOTOOL_CBALGOPOLYSHORTESTDIST_H
 #define RECOTOOL_CBALGOPOLYSHORTESTDIST_H
 
+#include <cmath>
 #include <vector>
 
 #include "larreco/RecoAlg/CMTool/CMToolBase/CBoolAlgoBase.h"
@@ -64,6 +65,9 @@ namespace cmtool {
     virtual bool Bool(const ::cluster::ClusterParamsAlg &cluster1,
 		      const ::cluster::ClusterParamsAlg &cluster2);
 
+    /// Polygon vertices closer than the cut have envelopes closer than that
+    virtual double MaxPairDistance() const { return std::sqrt(_dist_sqrd_cut); }
+
     /**
        Optional function: called after each Merge() function call by CMergeManager IFF
        CMergeManager is run with verbosity level kPerMerging. Maybe useful for debugging.
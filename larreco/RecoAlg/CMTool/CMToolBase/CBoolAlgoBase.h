@@ -44,6 +44,16 @@ namespace cmtool {
       else return true;
     }
 
+    /**
+       Optional function: the largest distance between the envelopes of two
+       clusters (the box around their hits and polygon vertices) for which
+       Bool() may return true. CMergeManager does not inspect the pairs further
+       apart when its broad phase is enabled. A negative value (default) means
+       there is no such distance.
+    */
+    virtual double MaxPairDistance() const
+    { return -1.; }
+
   };
 
 }
@@ -2,23 +2,113 @@
 
 #include "RtypesCore.h"
 #include "TString.h"
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <set>
 #include <string>
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include "lardata/Utilities/PxUtils.h"
+#include "larreco/ClusterFinder/RStarTree/RStarTree.h"
 #include "larreco/RecoAlg/CMTool/CMToolBase/CBoolAlgoBase.h"
 #include "larreco/RecoAlg/CMTool/CMToolBase/CMManagerBase.h"
 #include "larreco/RecoAlg/CMTool/CMToolBase/CMTException.h"
 #include "larreco/RecoAlg/CMTool/CMToolBase/CMergeBookKeeper.h"
 #include "larreco/RecoAlg/CMTool/CMToolBase/CPriorityAlgoBase.h"
 
+namespace {
+
+  // Index of the cluster envelopes of a plane; payload is the position in the priority order
+  using RTree = RStarTree<uint32_t, 2, 4, 8>;
+  using BoundingBox = RTree::BoundingBox;
+
+  /// Box around the hits and the polygon vertices of a cluster (the whole plane if none)
+  BoundingBox
+  Envelope(const cluster::ClusterParamsAlg& cluster)
+  {
+    BoundingBox bb;
+    for (size_t axis = 0; axis < 2; ++axis) {
+      bb.edges[axis].first = std::numeric_limits<double>::max();
+      bb.edges[axis].second = -std::numeric_limits<double>::max();
+    }
+    auto stretch = [&bb](double w, double t) {
+      bb.edges[0].first = std::min(bb.edges[0].first, w);
+      bb.edges[0].second = std::max(bb.edges[0].second, w);
+      bb.edges[1].first = std::min(bb.edges[1].first, t);
+      bb.edges[1].second = std::max(bb.edges[1].second, t);
+    };
+    for (auto const& hit : cluster.GetHitVector())
+      stretch(hit.w, hit.t);
+    auto const& poly = cluster.GetParams().PolyObject;
+    for (unsigned int i = 0; i < poly.Size(); ++i)
+      stretch(poly.Point(i).first, poly.Point(i).second);
+
+    if (bb.edges[0].first > bb.edges[0].second) {
+      for (size_t axis = 0; axis < 2; ++axis)
+        std::swap(bb.edges[axis].first, bb.edges[axis].second);
+    }
+    return bb;
+  }
+
+  /// Accepts the boxes not further than a distance from a bound
+  struct AcceptNear {
+    const BoundingBox& fBound;
+    double fDist2;
+
+    AcceptNear(const BoundingBox& b, double dist) : fBound(b), fDist2(dist * dist) {}
+
+    bool
+    isNear(const BoundingBox& b) const
+    {
+      double dist2 = 0.;
+      for (size_t axis = 0; axis < 2; ++axis) {
+        double const gap = std::max({0.,
+                                     b.edges[axis].first - fBound.edges[axis].second,
+                                     fBound.edges[axis].first - b.edges[axis].second});
+        dist2 += gap * gap;
+      }
+      return dist2 <= fDist2;
+    }
+
+    bool
+    operator()(const RTree::Node* const node) const
+    {
+      return isNear(node->bound);
+    }
+
+    bool
+    operator()(const RTree::Leaf* const leaf) const
+    {
+      return isNear(leaf->bound);
+    }
+  };
+
+  /// Collects the payload of the accepted leaves
+  struct CollectVisitor {
+    std::vector<uint32_t> vResult;
+    const bool ContinueVisiting = true;
+
+    void
+    operator()(const RTree::Leaf* const leaf)
+    {
+      vResult.push_back(leaf->leaf);
+    }
+  };
+
+}
+
 namespace cmtool {
 
   CMergeManager::CMergeManager()
   {
     _iter_ctr = 0;
+    _use_broad_phase = false;
+    _broad_phase_dist = -1.;
+    _run_parallel = false;
     _merge_algo = nullptr;
     _separate_algo = nullptr;
     Reset();
@@ -260,53 +350,55 @@ namespace cmtool {
     // Merging
     //
 
-    // Run over clusters and execute merging algorithms
-    for (auto citer1 = _priority.rbegin(); citer1 != _priority.rend(); ++citer1) {
-
-      auto citer2 = citer1;
-
-      UChar_t plane1 = in_clusters.at((*citer1).second).Plane();
-
-      while (1) {
-        citer2++;
-        if (citer2 == _priority.rend()) break;
-
-        // Skip if not on the same plane
-        UChar_t plane2 = in_clusters.at((*citer2).second).Plane();
-        if (plane1 != plane2) continue;
+    auto const pairs = MergeCandidates(in_clusters, merge_flag, book_keeper);
+
+    // Evaluate the pairs up front if running in parallel: the book keeping is
+    // still done in order below, so the result is the same
+    bool const parallel = _run_parallel && _debug_mode > kPerMerging;
+    std::vector<char> merge_v;
+    if (parallel) {
+      merge_v.resize(pairs.size(), false);
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, pairs.size(), 1),
+                        [&](const tbb::blocked_range<size_t>& range) {
+                          for (size_t i = range.begin(); i < range.end(); ++i)
+                            merge_v[i] = _merge_algo->Bool(in_clusters.at(pairs[i].first),
+                                                           in_clusters.at(pairs[i].second));
+                        });
+    }
 
-        // Skip if this combination is not meant to be compared
-        if (!(merge_flag.at((*citer2).second)) && !(merge_flag.at((*citer1).second))) continue;
+    // Run over cluster pairs and execute merging algorithms
+    for (size_t ipair = 0; ipair < pairs.size(); ++ipair) {
 
-        // Skip if this combination is not allowed to merge
-        if (!(book_keeper.MergeAllowed((*citer1).second, (*citer2).second))) continue;
+      size_t const index1 = pairs[ipair].first;
+      size_t const index2 = pairs[ipair].second;
 
-        if (_debug_mode <= kPerMerging) {
+      // Skip if this combination is not allowed to merge
+      if (!(book_keeper.MergeAllowed(index1, index2))) continue;
 
-          std::cout << Form("    \033[93mInspecting a pair (%zu, %zu) for merging... \033[00m",
-                            (*citer1).second,
-                            (*citer2).second)
-                    << std::endl;
-        }
+      if (_debug_mode <= kPerMerging) {
 
-        bool merge =
-          _merge_algo->Bool(in_clusters.at((*citer1).second), in_clusters.at((*citer2).second));
+        std::cout << Form("    \033[93mInspecting a pair (%zu, %zu) for merging... \033[00m",
+                          index1,
+                          index2)
+                  << std::endl;
+      }
 
-        if (_debug_mode <= kPerMerging) {
+      bool merge = parallel ? merge_v[ipair] :
+                              _merge_algo->Bool(in_clusters.at(index1), in_clusters.at(index2));
 
-          if (merge)
-            std::cout << "    \033[93mfound to be merged!\033[00m " << std::endl << std::endl;
+      if (_debug_mode <= kPerMerging) {
 
-          else
-            std::cout << "    \033[93mfound NOT to be merged...\033[00m" << std::endl << std::endl;
+        if (merge)
+          std::cout << "    \033[93mfound to be merged!\033[00m " << std::endl << std::endl;
 
-        } // end looping over all sets of algorithms
+        else
+          std::cout << "    \033[93mfound NOT to be merged...\033[00m" << std::endl << std::endl;
 
-        if (merge) book_keeper.Merge((*citer1).second, (*citer2).second);
+      } // end looping over all sets of algorithms
 
-      } // end looping over all cluster pairs for citer1
+      if (merge) book_keeper.Merge(index1, index2);
 
-    } // end looping over clusters
+    } // end looping over cluster pairs
 
     if (_debug_mode <= kPerIteration && book_keeper.GetResult().size() != in_clusters.size()) {
 
@@ -323,6 +415,70 @@ namespace cmtool {
     }
   }
 
+  std::vector<std::pair<size_t, size_t>>
+  CMergeManager::MergeCandidates(const std::vector<cluster::ClusterParamsAlg>& in_clusters,
+                                 const std::vector<bool>& merge_flag,
+                                 CMergeBookKeeper& book_keeper) const
+  {
+    // Clusters in the order they are inspected, highest priority first
+    std::vector<size_t> order;
+    order.reserve(_priority.size());
+    for (auto citer = _priority.rbegin(); citer != _priority.rend(); ++citer)
+      order.push_back((*citer).second);
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+    auto add_pair = [&](size_t index1, size_t index2) {
+      // Skip if this combination is not meant to be compared
+      if (!(merge_flag.at(index2)) && !(merge_flag.at(index1))) return;
+
+      // Skip if this combination is not allowed to merge (it won't be later either)
+      if (!(book_keeper.MergeAllowed(index1, index2))) return;
+
+      pairs.emplace_back(index1, index2);
+    };
+
+    double dist = -1.;
+    if (_use_broad_phase)
+      dist = (_broad_phase_dist < 0) ? _merge_algo->MaxPairDistance() : _broad_phase_dist;
+
+    if (dist < 0) {
+      for (size_t i1 = 0; i1 < order.size(); ++i1) {
+        UChar_t plane1 = in_clusters.at(order[i1]).Plane();
+        for (size_t i2 = i1 + 1; i2 < order.size(); ++i2) {
+          // Skip if not on the same plane
+          if (in_clusters.at(order[i2]).Plane() != plane1) continue;
+          add_pair(order[i1], order[i2]);
+        }
+      }
+      return pairs;
+    }
+
+    // Broad phase: index the envelopes of the clusters of each plane
+    std::map<UChar_t, RTree> trees;
+    std::vector<BoundingBox> envelopes;
+    envelopes.reserve(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+      envelopes.push_back(Envelope(in_clusters.at(order[i])));
+      trees[in_clusters.at(order[i]).Plane()].Insert(i, envelopes.back());
+    }
+
+    for (size_t i1 = 0; i1 < order.size(); ++i1) {
+      auto& tree = trees[in_clusters.at(order[i1]).Plane()];
+      auto neighbours = tree.Query(AcceptNear(envelopes[i1], dist), CollectVisitor()).vResult;
+      std::sort(neighbours.begin(), neighbours.end());
+      for (auto i2 : neighbours)
+        if (i2 > i1) add_pair(order[i1], order[i2]);
+    }
+
+    if (_debug_mode <= kPerIteration) {
+
+      std::cout << Form("  Broad phase (distance %g) kept %zu cluster pairs", dist, pairs.size())
+                << std::endl;
+    }
+
+    return pairs;
+  }
+
   void
   CMergeManager::RunSeparate(const std::vector<cluster::ClusterParamsAlg>& in_clusters,
                              CMergeBookKeeper& book_keeper) const
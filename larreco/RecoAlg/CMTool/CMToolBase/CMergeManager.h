@@ -18,6 +18,7 @@
 #include "CMergeBookKeeper.h"
 
 #include "larreco/RecoAlg/ClusterRecoUtil/ClusterParamsAlg.h"
+#include <utility>
 #include <vector>
 
 namespace cmtool {
@@ -53,6 +54,34 @@ namespace cmtool {
       _separate_algo = algo;
     }
 
+    /**
+       Switch to inspect only the pairs of clusters whose envelopes (the box
+       around the hits and the polygon) are closer than the distance set by
+       SetBroadPhaseDistance(), or else declared by the merging algorithm
+       (CBoolAlgoBase::MaxPairDistance()). The envelopes of each plane are
+       indexed in a R*-tree. Without a distance, all the pairs are inspected.
+    */
+    void
+    UseBroadPhase(bool doit = true)
+    {
+      _use_broad_phase = doit;
+    }
+
+    /// Distance for the broad phase: negative (default) uses the one of the merging algorithm
+    void
+    SetBroadPhaseDistance(double dist)
+    {
+      _broad_phase_dist = dist;
+    }
+
+    /// Switch to run the merging algorithm on the pairs of an iteration concurrently
+    /// (its Bool() must then be thread safe and not depend on the order of the calls)
+    void
+    RunParallel(bool doit = true)
+    {
+      _run_parallel = doit;
+    }
+
     /// A method to obtain output clusters
     const std::vector<cluster::ClusterParamsAlg>&
     GetClusters() const
@@ -95,6 +124,12 @@ namespace cmtool {
                   const std::vector<bool>& merge_flag,
                   CMergeBookKeeper& book_keeper) const;
 
+    /// Pairs of cluster indices to be inspected for merging, in the order to inspect them
+    std::vector<std::pair<size_t, size_t>> MergeCandidates(
+      const std::vector<cluster::ClusterParamsAlg>& in_clusters,
+      const std::vector<bool>& merge_flag,
+      CMergeBookKeeper& book_keeper) const;
+
     void RunSeparate(const std::vector<cluster::ClusterParamsAlg>& in_clusters,
                      CMergeBookKeeper& book_keeper) const;
 
@@ -111,6 +146,15 @@ namespace cmtool {
     /// Separation algorithm
     ::cmtool::CBoolAlgoBase* _separate_algo;
 
+    /// Broad phase switch
+    bool _use_broad_phase;
+
+    /// Broad phase distance (negative: the one of the merging algorithm)
+    double _broad_phase_dist;
+
+    /// Concurrent merging algorithm switch
+    bool _run_parallel;
+
     size_t _iter_ctr;
 
     std::vector<CMergeBookKeeper> _book_keeper_v;
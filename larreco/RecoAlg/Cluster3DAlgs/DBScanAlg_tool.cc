@@ -18,9 +18,16 @@
 #include "larreco/RecoAlg/Cluster3DAlgs/Cluster3D.h"
 #include "larreco/RecoAlg/Cluster3DAlgs/IClusterAlg.h"
 #include "larreco/RecoAlg/Cluster3DAlgs/IClusterParamsBuilder.h"
+#include "larreco/RecoAlg/Cluster3DAlgs/FlatKdTree.h"
 #include "larreco/RecoAlg/Cluster3DAlgs/kdTree.h"
 
+// TBB
+#include "tbb/parallel_for.h"
+
 // std includes
+#include <algorithm>
+#include <atomic>
+#include <limits>
 #include <memory>
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -71,6 +78,11 @@ public:
      */
     float getTimeToExecute(IClusterAlg::TimeValues index) const override {return m_timeVector[index];}
 
+    /**
+     *  @brief If monitoring, recover the cpu time used by a particular function
+     */
+    float getCPUTimeToExecute(IClusterAlg::TimeValues index) const override {return m_cpuTimeVector[index];}
+
 private:
 
     /**
@@ -81,15 +93,49 @@ private:
                        reco::ClusterParameters&,
                        size_t) const;
 
+    /**
+     *  @brief DBScan using the flat kdTree, with all neighborhoods computed up front
+     */
+    template <typename HitList>
+    void RunDBScan(HitList&, reco::ClusterParametersList&) const;
+
+    /**
+     *  @brief Compute the neighborhoods of all hits, in parallel over blocks of hits
+     */
+    void BuildNeighborhoods(const FlatKdTree::TreeData&, FlatKdTree::Neighborhoods&) const;
+
+    /**
+     *  @brief The DBScan loop over hits in input order
+     */
+    void RunSerialDBScan(const FlatKdTree::TreeData&, const FlatKdTree::Neighborhoods&, reco::ClusterParametersList&) const;
+
+    /**
+     *  @brief DBScan with a concurrent union-find of the core hits, giving the same clusters as RunSerialDBScan
+     */
+    void RunParallelDBScan(const FlatKdTree::TreeData&, const FlatKdTree::Neighborhoods&, reco::ClusterParametersList&) const;
+
+    /**
+     *  @brief the main routine for DBScan with the flat kdTree
+     */
+    void expandCluster(const FlatKdTree::TreeData&,
+                       const FlatKdTree::Neighborhoods&,
+                       size_t,
+                       reco::ClusterParameters&,
+                       size_t) const;
+
     /**
      *  @brief Data members to follow
      */
     bool                                                      m_enableMonitoring;      ///<
     size_t                                                    m_minPairPts;
+    bool                                                      m_useFlatKdTree;         ///< Use the flat kdTree for neighborhoods
+    bool                                                      m_runParallel;           ///< Multithreaded neighborhoods and DBScan (implies flat kdTree)
     mutable std::vector<float>                                m_timeVector;            ///<
+    mutable std::vector<float>                                m_cpuTimeVector;         ///<
 
     std::unique_ptr<lar_cluster3d::IClusterParametersBuilder> m_clusterBuilder;        ///<  Common cluster builder tool
     kdTree                                                    m_kdTree;                // For the kdTree
+    FlatKdTree                                                m_flatKdTree;            // For the flat kdTree
 };
 
 DBScanAlg::DBScanAlg(fhicl::ParameterSet const &pset)
@@ -109,6 +155,11 @@ void DBScanAlg::configure(fhicl::ParameterSet const &pset)
 {
     m_enableMonitoring  = pset.get<bool>  ("EnableMonitoring",  true  );
     m_minPairPts        = pset.get<size_t>("MinPairPts",        2     );
+    m_useFlatKdTree     = pset.get<bool>  ("UseFlatKdTree",     false );
+    m_runParallel       = pset.get<bool>  ("RunParallel",       false );
+
+    m_timeVector.resize(NUMTIMEVALUES, 0.);
+    m_cpuTimeVector.resize(NUMTIMEVALUES, 0.);
 
     m_clusterBuilder    = art::make_tool<lar_cluster3d::IClusterParametersBuilder>(pset.get<fhicl::ParameterSet>("ClusterParamsBuilder"));
 
@@ -129,7 +180,8 @@ void DBScanAlg::configure(fhicl::ParameterSet const &pset)
 
     kdTreeParams.put_or_replace<float>("RefLeafBestDist", maxBestDist);
 
-    m_kdTree = kdTree(kdTreeParams);
+    m_kdTree     = kdTree(kdTreeParams);
+    m_flatKdTree = FlatKdTree(kdTreeParams);
 }
 
 void DBScanAlg::Cluster3DHits(reco::HitPairList&           hitPairList,
@@ -142,6 +194,14 @@ void DBScanAlg::Cluster3DHits(reco::HitPairList&           hitPairList,
     cet::cpu_timer theClockDBScan;
 
     m_timeVector.resize(NUMTIMEVALUES, 0.);
+    m_cpuTimeVector.resize(NUMTIMEVALUES, 0.);
+
+    if (m_useFlatKdTree || m_runParallel)
+    {
+        RunDBScan(hitPairList, clusterParametersList);
+
+        return;
+    }
 
     // DBScan is driven of its "epsilon neighborhood". Computing adjacency within DBScan can be time
     // consuming so the idea is the prebuild the adjaceny map and then run DBScan.
@@ -192,7 +252,8 @@ void DBScanAlg::Cluster3DHits(reco::HitPairList&           hitPairList,
     {
         theClockDBScan.stop();
 
-        m_timeVector[RUNDBSCAN] = theClockDBScan.accumulated_real_time();
+        m_timeVector[RUNDBSCAN]    = theClockDBScan.accumulated_real_time();
+        m_cpuTimeVector[RUNDBSCAN] = theClockDBScan.accumulated_cpu_time();
     }
 
     // Initial clustering is done, now trim the list and get output parameters
@@ -207,7 +268,8 @@ void DBScanAlg::Cluster3DHits(reco::HitPairList&           hitPairList,
     {
         theClockBuildClusters.stop();
 
-        m_timeVector[BUILDCLUSTERINFO] = theClockBuildClusters.accumulated_real_time();
+        m_timeVector[BUILDCLUSTERINFO]    = theClockBuildClusters.accumulated_real_time();
+        m_cpuTimeVector[BUILDCLUSTERINFO] = theClockBuildClusters.accumulated_cpu_time();
     }
 
     mf::LogDebug("Cluster3D") << ">>>>> DBScan done, found " << clusterParametersList.size() << " clusters" << std::endl;
@@ -225,6 +287,14 @@ void DBScanAlg::Cluster3DHits(reco::HitPairListPtr&        hitPairList,
     cet::cpu_timer theClockDBScan;
 
     m_timeVector.resize(NUMTIMEVALUES, 0.);
+    m_cpuTimeVector.resize(NUMTIMEVALUES, 0.);
+
+    if (m_useFlatKdTree || m_runParallel)
+    {
+        RunDBScan(hitPairList, clusterParametersList);
+
+        return;
+    }
 
     // DBScan is driven of its "epsilon neighborhood". Computing adjacency within DBScan can be time
     // consuming so the idea is the prebuild the adjaceny map and then run DBScan.
@@ -275,7 +345,8 @@ void DBScanAlg::Cluster3DHits(reco::HitPairListPtr&        hitPairList,
     {
         theClockDBScan.stop();
 
-        m_timeVector[RUNDBSCAN] = theClockDBScan.accumulated_real_time();
+        m_timeVector[RUNDBSCAN]    = theClockDBScan.accumulated_real_time();
+        m_cpuTimeVector[RUNDBSCAN] = theClockDBScan.accumulated_cpu_time();
     }
 
     // Initial clustering is done, now trim the list and get output parameters
@@ -290,7 +361,8 @@ void DBScanAlg::Cluster3DHits(reco::HitPairListPtr&        hitPairList,
     {
         theClockBuildClusters.stop();
 
-        m_timeVector[BUILDCLUSTERINFO] = theClockBuildClusters.accumulated_real_time();
+        m_timeVector[BUILDCLUSTERINFO]    = theClockBuildClusters.accumulated_real_time();
+        m_cpuTimeVector[BUILDCLUSTERINFO] = theClockBuildClusters.accumulated_cpu_time();
     }
 
     mf::LogDebug("Cluster3D") << ">>>>> DBScan done, found " << clusterParametersList.size() << " clusters" << std::endl;
@@ -343,6 +415,362 @@ void DBScanAlg::expandCluster(const kdTree::KdTreeNode& topNode,
     return;
 }
 
+template <typename HitList>
+void DBScanAlg::RunDBScan(HitList&                     hitPairList,
+                          reco::ClusterParametersList& clusterParametersList) const
+{
+    // With the flat kdTree the "epsilon neighborhood" of every hit is computed in one batched query
+    // which we then use to drive DBScan
+    cet::cpu_timer theClockNeighborhoods;
+
+    if (m_enableMonitoring) theClockNeighborhoods.start();
+
+    FlatKdTree::TreeData      treeData;
+    FlatKdTree::Neighborhoods neighborhoods;
+
+    m_flatKdTree.BuildTree(hitPairList, treeData);
+
+    if (m_runParallel) BuildNeighborhoods(treeData, neighborhoods);
+    else               m_flatKdTree.FindNearestNeighbors(treeData, neighborhoods);
+
+    if (m_enableMonitoring)
+    {
+        theClockNeighborhoods.stop();
+
+        m_timeVector[BUILDHITTOHITMAP]    = theClockNeighborhoods.accumulated_real_time();
+        m_cpuTimeVector[BUILDHITTOHITMAP] = theClockNeighborhoods.accumulated_cpu_time();
+    }
+
+    cet::cpu_timer theClockDBScan;
+
+    if (m_enableMonitoring) theClockDBScan.start();
+
+    if (m_runParallel) RunParallelDBScan(treeData, neighborhoods, clusterParametersList);
+    else               RunSerialDBScan(treeData, neighborhoods, clusterParametersList);
+
+    if (m_enableMonitoring)
+    {
+        theClockDBScan.stop();
+
+        m_timeVector[RUNDBSCAN]    = theClockDBScan.accumulated_real_time();
+        m_cpuTimeVector[RUNDBSCAN] = theClockDBScan.accumulated_cpu_time();
+    }
+
+    // Initial clustering is done, now trim the list and get output parameters
+    cet::cpu_timer theClockBuildClusters;
+
+    // Start clocks if requested
+    if (m_enableMonitoring) theClockBuildClusters.start();
+
+    m_clusterBuilder->BuildClusterInfo(clusterParametersList);
+
+    if (m_enableMonitoring)
+    {
+        theClockBuildClusters.stop();
+
+        m_timeVector[BUILDCLUSTERINFO]    = theClockBuildClusters.accumulated_real_time();
+        m_cpuTimeVector[BUILDCLUSTERINFO] = theClockBuildClusters.accumulated_cpu_time();
+    }
+
+    mf::LogDebug("Cluster3D") << ">>>>> DBScan done, found " << clusterParametersList.size() << " clusters" << std::endl;
+
+    return;
+}
+
+void DBScanAlg::BuildNeighborhoods(const FlatKdTree::TreeData& treeData,
+                                   FlatKdTree::Neighborhoods&  neighborhoods) const
+{
+    // Each block of consecutive slots (which are also close in space) is searched by one task into its
+    // own output, the blocks are then concatenated in slot order
+    const size_t blockSize = 1024;
+    size_t       nHits     = treeData.size();
+    size_t       nBlocks   = (nHits + blockSize - 1) / blockSize;
+
+    std::vector<std::vector<size_t>>               blockOffsets(nBlocks);
+    std::vector<std::vector<FlatKdTree::Neighbor>> blockNeighbors(nBlocks);
+
+    tbb::parallel_for(size_t(0), nBlocks, [&](size_t block)
+    {
+        size_t firstSlot = block * blockSize;
+        size_t lastSlot  = std::min(firstSlot + blockSize, nHits);
+
+        blockOffsets[block].reserve(lastSlot - firstSlot);
+
+        m_flatKdTree.FindNearestNeighbors(treeData, firstSlot, lastSlot, blockOffsets[block], blockNeighbors[block]);
+    });
+
+    std::vector<size_t> blockStart(nBlocks + 1, 0);
+
+    for(size_t block = 0; block < nBlocks; block++) blockStart[block+1] = blockStart[block] + blockNeighbors[block].size();
+
+    neighborhoods.offsets.resize(nHits + 1);
+    neighborhoods.neighbors.resize(blockStart[nBlocks]);
+    neighborhoods.offsets[nHits] = blockStart[nBlocks];
+
+    tbb::parallel_for(size_t(0), nBlocks, [&](size_t block)
+    {
+        size_t firstSlot = block * blockSize;
+
+        for(size_t idx = 0; idx < blockOffsets[block].size(); idx++)
+            neighborhoods.offsets[firstSlot + idx] = blockStart[block] + blockOffsets[block][idx];
+
+        std::copy(blockNeighbors[block].begin(),blockNeighbors[block].end(),neighborhoods.neighbors.begin() + blockStart[block]);
+    });
+
+    return;
+}
+
+void DBScanAlg::RunSerialDBScan(const FlatKdTree::TreeData&      treeData,
+                                const FlatKdTree::Neighborhoods& neighborhoods,
+                                reco::ClusterParametersList&     clusterParametersList) const
+{
+    // Loop through the hits in input order and do the clustering
+    for(const auto& slot : treeData.inputToSlot)
+    {
+        const reco::ClusterHit3D* hit = treeData.hits[slot];
+
+        // Check if the hit has already been visited
+        if (hit->getStatusBits() & reco::ClusterHit3D::CLUSTERVISITED) continue;
+
+        // Mark as visited
+        hit->setStatusBit(reco::ClusterHit3D::CLUSTERVISITED);
+
+        if (neighborhoods.size(slot) < m_minPairPts)
+        {
+            hit->setStatusBit(reco::ClusterHit3D::CLUSTERNOISE);
+        }
+        else
+        {
+            // "Create" a new cluster and get a reference to it
+            clusterParametersList.push_back(reco::ClusterParameters());
+
+            reco::ClusterParameters& curCluster = clusterParametersList.back();
+
+            hit->setStatusBit(reco::ClusterHit3D::CLUSTERATTACHED);
+            curCluster.addHit3D(hit);
+
+            // expand the cluster
+            expandCluster(treeData, neighborhoods, slot, curCluster, m_minPairPts);
+        }
+    }
+
+    return;
+}
+
+namespace {
+    // Concurrent union-find over hit slots. Links always go from the larger to the smaller root, so the
+    // parent of a slot can only decrease and path halving can race harmlessly with linking
+    using ParentVec = std::vector<std::atomic<uint32_t>>;
+
+    uint32_t findRoot(ParentVec& parent, uint32_t slot)
+    {
+        while(true)
+        {
+            uint32_t parentSlot = parent[slot].load(std::memory_order_relaxed);
+
+            if (parentSlot == slot) return slot;
+
+            uint32_t grandParentSlot = parent[parentSlot].load(std::memory_order_relaxed);
+
+            if (grandParentSlot != parentSlot) parent[slot].compare_exchange_weak(parentSlot, grandParentSlot, std::memory_order_relaxed);
+
+            slot = grandParentSlot;
+        }
+    }
+
+    void unite(ParentVec& parent, uint32_t slot1, uint32_t slot2)
+    {
+        while(true)
+        {
+            uint32_t root1 = findRoot(parent, slot1);
+            uint32_t root2 = findRoot(parent, slot2);
+
+            if (root1 == root2) return;
+
+            if (root1 < root2) std::swap(root1, root2);
+
+            // Only succeeds if root1 is still a root
+            uint32_t expected = root1;
+
+            if (parent[root1].compare_exchange_strong(expected, root2, std::memory_order_relaxed)) return;
+        }
+    }
+}
+
+void DBScanAlg::RunParallelDBScan(const FlatKdTree::TreeData&      treeData,
+                                  const FlatKdTree::Neighborhoods& neighborhoods,
+                                  reco::ClusterParametersList&     clusterParametersList) const
+{
+    // The serial algorithm gives clusters which are the connected sets of "core" hits (those with at least
+    // minPairPts neighbors) plus the non core hits next to them, each given to the first cluster (in order of
+    // creation) that reaches it. Clusters are created in input order of their first core hit. All of this can
+    // be worked out without walking the clusters in order, which is what we do here.
+    // Note that this assumes the clustering status bits have been cleared, as BuildTree does for HitPairListPtr
+    const uint32_t noCluster = std::numeric_limits<uint32_t>::max();
+    size_t         nHits     = treeData.size();
+
+    std::vector<uint8_t> isCore(nHits);
+    ParentVec            parent(nHits);
+
+    tbb::parallel_for(size_t(0), nHits, [&](size_t slot)
+    {
+        isCore[slot] = neighborhoods.size(slot) >= m_minPairPts;
+        parent[slot].store(slot, std::memory_order_relaxed);
+    });
+
+    // Link core hits to their core neighbors (the neighborhood relation is symmetric so each pair once)
+    tbb::parallel_for(size_t(0), nHits, [&](size_t slot)
+    {
+        if (!isCore[slot]) return;
+
+        for(const auto* neighbor = neighborhoods.begin(slot); neighbor != neighborhoods.end(slot); neighbor++)
+            if (neighbor->slot < slot && isCore[neighbor->slot]) unite(parent, slot, neighbor->slot);
+    });
+
+    // Number the clusters in input order of their first core hit, which is the seed of the serial algorithm
+    std::vector<uint32_t> rootToCluster(nHits, noCluster);
+    std::vector<uint32_t> seedSlotVec;
+    std::vector<uint32_t> slotToInput(nHits);
+
+    for(size_t inputIdx = 0; inputIdx < nHits; inputIdx++)
+    {
+        uint32_t slot = treeData.inputToSlot[inputIdx];
+
+        slotToInput[slot] = inputIdx;
+
+        if (!isCore[slot]) continue;
+
+        uint32_t root = findRoot(parent, slot);
+
+        if (rootToCluster[root] == noCluster)
+        {
+            rootToCluster[root] = seedSlotVec.size();
+            seedSlotVec.push_back(slot);
+        }
+    }
+
+    // Core hits go to the cluster of their root, the others to the lowest numbered cluster of their core
+    // neighbors. The status bits follow: a non core hit is labelled noise if the main loop reaches it before
+    // any cluster does, that is if it comes before the seed of its cluster in input order
+    std::vector<uint32_t> clusterVec(nHits, noCluster);
+
+    tbb::parallel_for(size_t(0), nHits, [&](size_t slot)
+    {
+        uint32_t cluster = noCluster;
+
+        if (isCore[slot]) cluster = rootToCluster[findRoot(parent, slot)];
+        else
+        {
+            for(const auto* neighbor = neighborhoods.begin(slot); neighbor != neighborhoods.end(slot); neighbor++)
+                if (isCore[neighbor->slot]) cluster = std::min(cluster, rootToCluster[findRoot(parent, neighbor->slot)]);
+        }
+
+        clusterVec[slot] = cluster;
+
+        const reco::ClusterHit3D* hit = treeData.hits[slot];
+
+        hit->setStatusBit(reco::ClusterHit3D::CLUSTERVISITED);
+
+        if (cluster != noCluster) hit->setStatusBit(reco::ClusterHit3D::CLUSTERATTACHED);
+
+        if (!isCore[slot] && (cluster == noCluster || slotToInput[slot] < slotToInput[seedSlotVec[cluster]]))
+            hit->setStatusBit(reco::ClusterHit3D::CLUSTERNOISE);
+    });
+
+    // Finally fill the clusters, each with the same breadth first walk as expandCluster so the hits come out
+    // in the same order. The flags are only ever touched by the cluster owning the hit
+    size_t firstCluster = clusterParametersList.size();
+
+    clusterParametersList.resize(firstCluster + seedSlotVec.size());
+
+    std::vector<reco::ClusterParameters*> clusterPtrVec;
+
+    for(auto clusterItr = std::next(clusterParametersList.begin(), firstCluster); clusterItr != clusterParametersList.end(); clusterItr++)
+        clusterPtrVec.push_back(&(*clusterItr));
+
+    std::vector<uint8_t> expanded(nHits, 0);
+    std::vector<uint8_t> attached(nHits, 0);
+
+    tbb::parallel_for(size_t(0), seedSlotVec.size(), [&](size_t cluster)
+    {
+        reco::ClusterParameters& curCluster = *clusterPtrVec[cluster];
+        uint32_t                 seedSlot   = seedSlotVec[cluster];
+        std::vector<uint32_t>    slotQueue;
+
+        expanded[seedSlot] = 1;
+        attached[seedSlot] = 1;
+        curCluster.addHit3D(treeData.hits[seedSlot]);
+
+        for(const auto* neighbor = neighborhoods.begin(seedSlot); neighbor != neighborhoods.end(seedSlot); neighbor++)
+            slotQueue.push_back(neighbor->slot);
+
+        for(size_t queueIdx = 0; queueIdx < slotQueue.size(); queueIdx++)
+        {
+            uint32_t slot = slotQueue[queueIdx];
+
+            // Only core hits of this cluster can be reached here, and only they expand
+            if (isCore[slot] && !expanded[slot])
+            {
+                expanded[slot] = 1;
+
+                for(const auto* neighbor = neighborhoods.begin(slot); neighbor != neighborhoods.end(slot); neighbor++)
+                    slotQueue.push_back(neighbor->slot);
+            }
+
+            // Non core hits belonging to an earlier cluster have already been attached there
+            if (clusterVec[slot] == cluster && !attached[slot])
+            {
+                attached[slot] = 1;
+                curCluster.addHit3D(treeData.hits[slot]);
+            }
+        }
+    });
+
+    return;
+}
+
+void DBScanAlg::expandCluster(const FlatKdTree::TreeData&      treeData,
+                              const FlatKdTree::Neighborhoods& neighborhoods,
+                              size_t                           seedSlot,
+                              reco::ClusterParameters&         cluster,
+                              size_t                           minPts) const
+{
+    // Same as above but the queue holds slots and is consumed by index rather than popped
+    std::vector<uint32_t> slotQueue;
+
+    for(const auto* neighbor = neighborhoods.begin(seedSlot); neighbor != neighborhoods.end(seedSlot); neighbor++)
+        slotQueue.push_back(neighbor->slot);
+
+    for(size_t queueIdx = 0; queueIdx < slotQueue.size(); queueIdx++)
+    {
+        uint32_t                  slot        = slotQueue[queueIdx];
+        const reco::ClusterHit3D* neighborHit = treeData.hits[slot];
+
+        // Process if we've not been here before
+        if (!(neighborHit->getStatusBits() & reco::ClusterHit3D::CLUSTERVISITED))
+        {
+            // set as visited
+            neighborHit->setStatusBit(reco::ClusterHit3D::CLUSTERVISITED);
+
+            // If the epsilon neighborhood of this point is large enough then add its points to our list
+            if (neighborhoods.size(slot) >= minPts)
+            {
+                for(const auto* neighbor = neighborhoods.begin(slot); neighbor != neighborhoods.end(slot); neighbor++)
+                    slotQueue.push_back(neighbor->slot);
+            }
+        }
+
+        // If the point is not yet in a cluster then we now add
+        if (!(neighborHit->getStatusBits() & reco::ClusterHit3D::CLUSTERATTACHED))
+        {
+            neighborHit->setStatusBit(reco::ClusterHit3D::CLUSTERATTACHED);
+            cluster.addHit3D(neighborHit);
+        }
+    }
+
+    return;
+}
+
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 DEFINE_ART_CLASS_TOOL(DBScanAlg)
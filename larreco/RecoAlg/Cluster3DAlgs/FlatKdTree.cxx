@@ -0,0 +1,352 @@
+/**
+ *  @file   FlatKdTree.cxx
+ *
+ *  @brief  Implements a kdTree stored in contiguous arrays for use in clustering
+ *
+ */
+
+// Framework Includes
+#include "cetlib/cpu_timer.h"
+#include "fhiclcpp/ParameterSet.h"
+
+// LArSoft includes
+#include "larreco/RecoAlg/Cluster3DAlgs/FlatKdTree.h"
+
+// std includes
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+// implementation follows
+
+namespace lar_cluster3d {
+
+FlatKdTree::FlatKdTree(fhicl::ParameterSet const &pset)
+{
+    this->configure(pset);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void FlatKdTree::configure(fhicl::ParameterSet const &pset)
+{
+    fEnableMonitoring  = pset.get<bool>    ("EnableMonitoring",  true);
+    fPairSigmaPeakTime = pset.get<float>   ("PairSigmaPeakTime", 3.  );
+    fRefLeafBestDist   = pset.get<float>   ("RefLeafBestDist",   0.5 );
+    fLeafSize          = pset.get<uint32_t>("LeafSize",          8   );
+
+    if (fLeafSize < 1) fLeafSize = 1;
+
+    fTimeToBuild = 0;
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void FlatKdTree::TreeData::clear()
+{
+    nodes.clear();
+    hits.clear();
+    posY.clear();
+    posZ.clear();
+    peakTime.clear();
+    sigmaPeakTime.clear();
+    wire0.clear();
+    wire1.clear();
+    wire2.clear();
+    tpcKey.clear();
+    inputToSlot.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+void FlatKdTree::BuildTree(const reco::HitPairList& hitPairList, TreeData& treeData) const
+{
+    cet::cpu_timer theClockBuildNeighborhood;
+
+    if (fEnableMonitoring) theClockBuildNeighborhood.start();
+
+    treeData.clear();
+    treeData.hits.reserve(hitPairList.size());
+
+    for(const auto& hit : hitPairList) treeData.hits.emplace_back(&hit);
+
+    FillTreeData(treeData);
+
+    if (fEnableMonitoring)
+    {
+        theClockBuildNeighborhood.stop();
+        fTimeToBuild = theClockBuildNeighborhood.accumulated_real_time();
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+void FlatKdTree::BuildTree(const reco::HitPairListPtr& hitPairList, TreeData& treeData) const
+{
+    cet::cpu_timer theClockBuildNeighborhood;
+
+    if (fEnableMonitoring) theClockBuildNeighborhood.start();
+
+    treeData.clear();
+    treeData.hits.reserve(hitPairList.size());
+
+    for(const auto& hit3D : hitPairList)
+    {
+        // Make sure all the bits used by the clustering stage have been cleared
+        hit3D->clearStatusBits(~(reco::ClusterHit3D::HITINVIEW0 | reco::ClusterHit3D::HITINVIEW1 | reco::ClusterHit3D::HITINVIEW2));
+        for(const auto& hit2D : hit3D->getHits())
+            if (hit2D) hit2D->clearStatusBits(0xFFFFFFFF);
+        treeData.hits.emplace_back(hit3D);
+    }
+
+    FillTreeData(treeData);
+
+    if (fEnableMonitoring)
+    {
+        theClockBuildNeighborhood.stop();
+        fTimeToBuild = theClockBuildNeighborhood.accumulated_real_time();
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+void FlatKdTree::FillTreeData(TreeData& treeData) const
+{
+    // On input only the hits are filled, in input order. Start by copying the coordinates we split on
+    // so the build does not have to chase the hit pointers
+    size_t nHits = treeData.hits.size();
+
+    treeData.posY.resize(nHits);
+    treeData.posZ.resize(nHits);
+
+    for(size_t idx = 0; idx < nHits; idx++)
+    {
+        treeData.posY[idx] = treeData.hits[idx]->getY();
+        treeData.posZ[idx] = treeData.hits[idx]->getZ();
+    }
+
+    // The build works on a vector of input indices which, at the end, gives the input index of each slot
+    std::vector<uint32_t> slotToInput(nHits);
+
+    std::iota(slotToInput.begin(),slotToInput.end(),0);
+
+    treeData.nodes.reserve(2 * (nHits / fLeafSize + 1));
+
+    if (nHits > 0) BuildNodes(treeData, slotToInput, 0, nHits);
+
+    // Now reorder everything into slot order and fill the rest of the search data
+    std::vector<const reco::ClusterHit3D*> hitVec(nHits);
+    std::vector<float>                     posYVec(nHits);
+    std::vector<float>                     posZVec(nHits);
+
+    treeData.peakTime.resize(nHits);
+    treeData.sigmaPeakTime.resize(nHits);
+    treeData.wire0.resize(nHits);
+    treeData.wire1.resize(nHits);
+    treeData.wire2.resize(nHits);
+    treeData.tpcKey.resize(nHits);
+    treeData.inputToSlot.resize(nHits);
+
+    for(size_t slot = 0; slot < nHits; slot++)
+    {
+        uint32_t                  inputIdx = slotToInput[slot];
+        const reco::ClusterHit3D* hit      = treeData.hits[inputIdx];
+        const geo::WireID&        wireID   = hit->getWireIDs()[0];
+
+        hitVec[slot]                   = hit;
+        posYVec[slot]                  = treeData.posY[inputIdx];
+        posZVec[slot]                  = treeData.posZ[inputIdx];
+        treeData.peakTime[slot]        = hit->getAvePeakTime();
+        treeData.sigmaPeakTime[slot]   = hit->getSigmaPeakTime();
+        treeData.wire0[slot]           = hit->getWireIDs()[0].Wire;
+        treeData.wire1[slot]           = hit->getWireIDs()[1].Wire;
+        treeData.wire2[slot]           = hit->getWireIDs()[2].Wire;
+        treeData.tpcKey[slot]          = (wireID.Cryostat << 16) | wireID.TPC;
+        treeData.inputToSlot[inputIdx] = slot;
+    }
+
+    treeData.hits.swap(hitVec);
+    treeData.posY.swap(posYVec);
+    treeData.posZ.swap(posZVec);
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+uint32_t FlatKdTree::BuildNodes(TreeData& treeData, std::vector<uint32_t>& slotToInput, uint32_t first, uint32_t last) const
+{
+    // Nodes are stored depth first, the left child of a split node is always the next node
+    uint32_t nodeIdx = treeData.nodes.size();
+
+    treeData.nodes.push_back(Node{Node::leaf, 0., 0, first, last});
+
+    // Small enough to be a leaf bucket?
+    if (last - first <= fLeafSize) return nodeIdx;
+
+    // Find the axis with the largest range, only Y and Z enter the neighborhood distance
+    auto minMaxY = std::minmax_element(slotToInput.begin()+first,slotToInput.begin()+last,[&treeData](const auto& left, const auto& right){return treeData.posY[left] < treeData.posY[right];});
+    auto minMaxZ = std::minmax_element(slotToInput.begin()+first,slotToInput.begin()+last,[&treeData](const auto& left, const auto& right){return treeData.posZ[left] < treeData.posZ[right];});
+
+    float rangeY = treeData.posY[*minMaxY.second] - treeData.posY[*minMaxY.first];
+    float rangeZ = treeData.posZ[*minMaxZ.second] - treeData.posZ[*minMaxZ.first];
+
+    // All hits on top of each other in YZ, no point in splitting further
+    if (!(rangeY > 0.) && !(rangeZ > 0.)) return nodeIdx;
+
+    Node::SplitAxis           axis = rangeZ > rangeY ? Node::zPlane : Node::yPlane;
+    const std::vector<float>& pos  = axis == Node::yPlane ? treeData.posY : treeData.posZ;
+
+    auto firstItr  = slotToInput.begin() + first;
+    auto middleItr = slotToInput.begin() + (first + last) / 2;
+    auto lastItr   = slotToInput.begin() + last;
+
+    // Partial sort to find the median
+    std::nth_element(firstItr,middleItr,lastItr,[&pos](const auto& left, const auto& right){return pos[left] < pos[right];});
+
+    float median = pos[*middleItr];
+
+    // As in kdTree, make sure the median value is not split between the two sides. If everything on the
+    // left is at the median (which is then also the minimum) move the values equal to it to the left
+    auto splitItr = std::partition(firstItr,middleItr,[&pos,median](const auto& idx){return pos[idx] < median;});
+
+    if (splitItr == firstItr) splitItr = std::partition(middleItr,lastItr,[&pos,median](const auto& idx){return !(median < pos[idx]);});
+
+    float leftMax  = pos[*std::max_element(firstItr,splitItr,[&pos](const auto& left, const auto& right){return pos[left] < pos[right];})];
+    float rightMin = pos[*std::min_element(splitItr,lastItr, [&pos](const auto& left, const auto& right){return pos[left] < pos[right];})];
+    uint32_t split = std::distance(slotToInput.begin(),splitItr);
+
+    BuildNodes(treeData, slotToInput, first, split);
+
+    uint32_t rightNode = BuildNodes(treeData, slotToInput, split, last);
+
+    treeData.nodes[nodeIdx] = Node{axis, float(0.5 * (leftMax + rightMin)), rightNode, first, last};
+
+    return nodeIdx;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+FlatKdTree::RefHit FlatKdTree::makeRefHit(const TreeData& treeData, size_t slot) const
+{
+    return RefHit{treeData.hits[slot],
+                  treeData.posY[slot],
+                  treeData.posZ[slot],
+                  treeData.peakTime[slot],
+                  treeData.sigmaPeakTime[slot],
+                  {treeData.wire0[slot], treeData.wire1[slot], treeData.wire2[slot]},
+                  treeData.tpcKey[slot]};
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+template <typename Accept>
+void FlatKdTree::SearchNode(const RefHit& refHit, const TreeData& treeData, uint32_t nodeIdx, Accept& accept) const
+{
+    const Node& node = treeData.nodes[nodeIdx];
+
+    // If at a leaf then check all the hits in the bucket
+    if (node.axis == Node::leaf)
+    {
+        // Slightly loose cut on the squared distance so the square root is only taken for candidates
+        float bestDist  = fRefLeafBestDist;
+        float bestDist2 = 1.0001 * bestDist * bestDist;
+
+        for(uint32_t slot = node.firstSlot; slot < node.lastSlot; slot++)
+        {
+            // This distance is the same as in kdTree::DistanceBetweenNodesYZ
+            float deltaY = refHit.posY - treeData.posY[slot];
+            float deltaZ = refHit.posZ - treeData.posZ[slot];
+            float yzDist2 = deltaY * deltaY + deltaZ * deltaZ;
+
+            if (yzDist2 > bestDist2 || treeData.tpcKey[slot] != refHit.tpcKey || treeData.hits[slot] == refHit.hit) continue;
+
+            // From here on this follows kdTree::consistentPairs
+            if (!(std::fabs(refHit.peakTime - treeData.peakTime[slot]) < fPairSigmaPeakTime * (refHit.sigmaPeakTime + treeData.sigmaPeakTime[slot]))) continue;
+
+            int maxWireDelta = std::max({std::abs(refHit.wire[0] - treeData.wire0[slot]),
+                                         std::abs(refHit.wire[1] - treeData.wire1[slot]),
+                                         std::abs(refHit.wire[2] - treeData.wire2[slot])});
+
+            if (maxWireDelta >= 3) continue;
+
+            float hitSeparation = std::max(float(0.0001),std::sqrt(yzDist2));
+
+            if (hitSeparation < bestDist) accept(slot, hitSeparation);
+        }
+    }
+    // Otherwise descend into the children that can hold hits within range
+    else
+    {
+        float refPosition = node.axis == Node::yPlane ? refHit.posY : refHit.posZ;
+
+        if (refPosition - fRefLeafBestDist <= node.axisValue) SearchNode(refHit, treeData, nodeIdx + 1,   accept);
+        if (refPosition + fRefLeafBestDist >= node.axisValue) SearchNode(refHit, treeData, node.rightNode, accept);
+    }
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+size_t FlatKdTree::FindNearestNeighbors(const reco::ClusterHit3D* hit, const TreeData& treeData, CandPairVec& candPairVec) const
+{
+    size_t nInitial = candPairVec.size();
+
+    if (treeData.nodes.empty()) return 0;
+
+    const geo::WireID& wireID = hit->getWireIDs()[0];
+
+    RefHit refHit{hit,
+                  hit->getY(),
+                  hit->getZ(),
+                  hit->getAvePeakTime(),
+                  hit->getSigmaPeakTime(),
+                  {int32_t(hit->getWireIDs()[0].Wire), int32_t(hit->getWireIDs()[1].Wire), int32_t(hit->getWireIDs()[2].Wire)},
+                  (wireID.Cryostat << 16) | wireID.TPC};
+
+    auto accept = [&treeData,&candPairVec](uint32_t slot, float distance){candPairVec.emplace_back(distance,treeData.hits[slot]);};
+
+    SearchNode(refHit, treeData, 0, accept);
+
+    return candPairVec.size() - nInitial;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+void FlatKdTree::FindNearestNeighbors(const TreeData& treeData, Neighborhoods& neighborhoods) const
+{
+    neighborhoods.offsets.clear();
+    neighborhoods.neighbors.clear();
+
+    neighborhoods.offsets.reserve(treeData.size() + 1);
+
+    FindNearestNeighbors(treeData, 0, treeData.size(), neighborhoods.offsets, neighborhoods.neighbors);
+
+    neighborhoods.offsets.push_back(neighborhoods.neighbors.size());
+
+    return;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+void FlatKdTree::FindNearestNeighbors(const TreeData&        treeData,
+                                      size_t                 firstSlot,
+                                      size_t                 lastSlot,
+                                      std::vector<size_t>&   offsets,
+                                      std::vector<Neighbor>& neighbors) const
+{
+    if (treeData.nodes.empty()) return;
+
+    auto accept = [&neighbors](uint32_t slot, float distance){neighbors.push_back(Neighbor{slot, distance});};
+
+    // Consecutive slots are neighbors in space so successive queries walk the same part of the tree
+    for(size_t slot = firstSlot; slot < lastSlot; slot++)
+    {
+        offsets.push_back(neighbors.size());
+
+        SearchNode(makeRefHit(treeData, slot), treeData, 0, accept);
+    }
+
+    return;
+}
+
+} // namespace lar_cluster3d
@@ -0,0 +1,187 @@
+/**
+ *  @file   FlatKdTree.h
+ *
+ *  @brief  Implements a kdTree stored in contiguous arrays for use in clustering
+ *
+ *          This is a drop in alternative to the node based kdTree: the nodes live
+ *          in a single vector (in depth first order, so the left child of a node
+ *          is always the next node) and the hits are grouped into leaf buckets
+ *          whose search data are packed in parallel arrays.
+ *
+ */
+#ifndef FlatKdTree_h
+#define FlatKdTree_h
+
+// Framework Includes
+#include "fhiclcpp/fwd.h"
+
+// Algorithm includes
+#include "larreco/RecoAlg/Cluster3DAlgs/Cluster3D.h"
+
+// std includes
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+namespace lar_cluster3d
+{
+/**
+ *  @brief  FlatKdTree class definiton
+ *
+ *          Neighborhoods are defined exactly as in kdTree::consistentPairs: two hits are neighbors if
+ *          they are in the same cryostat/TPC, their peak times agree within PairSigmaPeakTime "sigmas",
+ *          no plane has a wire difference larger than 2 and their distance in the YZ plane is less than
+ *          RefLeafBestDist. Since the distance only involves the Y and Z coordinates the tree is only
+ *          split along those two axes, which makes the search exact (and independent of the visiting
+ *          order) rather than dependent on the order the leaves are reached.
+ *
+ *          The tree itself is stateless after configuration; all the data for a given set of hits is
+ *          held by the caller in a TreeData object, so a single instance can serve concurrent callers.
+ */
+class FlatKdTree
+{
+public:
+    /**
+     *  @brief  Default Constructor
+     */
+    FlatKdTree() : fEnableMonitoring(false),
+                   fTimeToBuild(0.),
+                   fPairSigmaPeakTime(0.),
+                   fRefLeafBestDist(0.),
+                   fLeafSize(8) {}
+
+    /**
+     *  @brief  Constructor
+     *
+     *  @param  pset
+     */
+    FlatKdTree(fhicl::ParameterSet const &pset);
+
+    /**
+     *  @brief Configure our kdTree...
+     *
+     *  @param ParameterSet  The input set of parameters for configuration
+     */
+    void configure(fhicl::ParameterSet const &pset);
+
+    /**
+     *  @brief A node of the tree: either a split in Y or Z or a leaf bucket of hits
+     */
+    struct Node
+    {
+        enum SplitAxis : uint32_t { yPlane = 1, zPlane = 2, leaf = 3 };
+
+        SplitAxis axis;        ///< Split axis (index into the hit position) or leaf
+        float     axisValue;   ///< Split value (for internal nodes)
+        uint32_t  rightNode;   ///< Index of the right child (the left one is the next node)
+        uint32_t  firstSlot;   ///< First hit slot of a leaf
+        uint32_t  lastSlot;    ///< One past the last hit slot of a leaf
+    };
+
+    /**
+     *  @brief Everything the tree knows about a set of hits. Hits are stored in "slots", ordered so that
+     *         the hits of each leaf are contiguous; the search quantities are kept in parallel arrays.
+     */
+    struct TreeData
+    {
+        std::vector<Node>                      nodes;          ///< The nodes, root first
+        std::vector<const reco::ClusterHit3D*> hits;           ///< Hit in each slot
+        std::vector<float>                     posY;           ///< Y position of the hit in each slot
+        std::vector<float>                     posZ;           ///< Z position of the hit in each slot
+        std::vector<float>                     peakTime;       ///< Average peak time
+        std::vector<float>                     sigmaPeakTime;  ///< Peak time "sigma"
+        std::vector<int32_t>                   wire0;          ///< Wire number in plane 0
+        std::vector<int32_t>                   wire1;          ///< Wire number in plane 1
+        std::vector<int32_t>                   wire2;          ///< Wire number in plane 2
+        std::vector<uint32_t>                  tpcKey;         ///< Packed cryostat and TPC numbers
+        std::vector<uint32_t>                  inputToSlot;    ///< Slot of each hit, in input order
+
+        size_t size() const {return hits.size();}
+        void   clear();
+    };
+
+    using CandPair    = std::pair<double,const reco::ClusterHit3D*>;
+    using CandPairVec = std::vector<CandPair>;
+
+    /**
+     *  @brief Neighbors of all the hits in a tree, in compressed row format indexed by slot
+     */
+    struct Neighbor
+    {
+        uint32_t slot;      ///< Slot of the neighboring hit
+        float    distance;  ///< Its distance in the YZ plane
+    };
+
+    struct Neighborhoods
+    {
+        std::vector<size_t>   offsets;     ///< Neighbors of slot i are [offsets[i], offsets[i+1])
+        std::vector<Neighbor> neighbors;   ///< All the neighbors, concatenated
+
+        size_t          size (size_t slot) const {return offsets[slot+1] - offsets[slot];}
+        const Neighbor* begin(size_t slot) const {return neighbors.data() + offsets[slot];}
+        const Neighbor* end  (size_t slot) const {return neighbors.data() + offsets[slot+1];}
+    };
+
+    /**
+     *  @brief Given an input HitPairList, build out the tree
+     */
+    void BuildTree(const reco::HitPairList&, TreeData&) const;
+
+    /**
+     *  @brief Given an input HitPairListPtr, build out the tree (status bits are cleared as in kdTree)
+     */
+    void BuildTree(const reco::HitPairListPtr&, TreeData&) const;
+
+    /**
+     *  @brief Append the neighbors of the given hit to the output vector, return the number found
+     */
+    size_t FindNearestNeighbors(const reco::ClusterHit3D*, const TreeData&, CandPairVec&) const;
+
+    /**
+     *  @brief Batched query: compute the neighborhoods of all the hits in the tree
+     */
+    void FindNearestNeighbors(const TreeData&, Neighborhoods&) const;
+
+    /**
+     *  @brief Batched query for the slots in [firstSlot,lastSlot), appending to the output in slot order
+     *
+     *  @param offsets   one entry per slot is added, the index in "neighbors" where its neighbors start
+     */
+    void FindNearestNeighbors(const TreeData&, size_t firstSlot, size_t lastSlot, std::vector<size_t>& offsets, std::vector<Neighbor>& neighbors) const;
+
+    float getTimeToExecute() const {return fTimeToBuild;}
+
+private:
+
+    /**
+     *  @brief Search quantities of the reference hit for a query
+     */
+    struct RefHit
+    {
+        const reco::ClusterHit3D* hit;
+        float                     posY;
+        float                     posZ;
+        float                     peakTime;
+        float                     sigmaPeakTime;
+        int32_t                   wire[3];
+        uint32_t                  tpcKey;
+    };
+
+    void     FillTreeData(TreeData&) const;
+    uint32_t BuildNodes(TreeData&, std::vector<uint32_t>&, uint32_t, uint32_t) const;
+    RefHit   makeRefHit(const TreeData&, size_t) const;
+
+    template <typename Accept>
+    void     SearchNode(const RefHit&, const TreeData&, uint32_t, Accept&) const;
+
+    bool           fEnableMonitoring;      ///<
+    mutable float  fTimeToBuild;           ///<
+    float          fPairSigmaPeakTime;     ///< Consider hits consistent if "significance" less than this
+    float          fRefLeafBestDist;       ///< Neighborhood distance in the YZ plane
+    uint32_t       fLeafSize;              ///< Maximum number of hits in a leaf bucket
+};
+
+} // namespace lar_cluster3d
+#endif
@@ -71,6 +71,11 @@ public:
      */
     virtual float getTimeToExecute(TimeValues index) const = 0;
 
+    /**
+     *  @brief If monitoring, recover the (process) cpu time used by a particular function
+     */
+    virtual float getCPUTimeToExecute(TimeValues) const {return 0.;}
+
 };
 
 } // namespace lar_cluster3d
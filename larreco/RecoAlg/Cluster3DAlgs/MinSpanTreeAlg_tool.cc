@@ -22,6 +22,7 @@
 #include "larreco/RecoAlg/Cluster3DAlgs/IClusterAlg.h"
 #include "larreco/RecoAlg/Cluster3DAlgs/Cluster3D.h"
 #include "larreco/RecoAlg/Cluster3DAlgs/PrincipalComponentsAlg.h"
+#include "larreco/RecoAlg/Cluster3DAlgs/FlatKdTree.h"
 #include "larreco/RecoAlg/Cluster3DAlgs/kdTree.h"
 #include "larreco/RecoAlg/Cluster3DAlgs/IClusterParamsBuilder.h"
 
@@ -80,7 +81,7 @@ private:
     /**
      *  @brief Driver for Prim's algorithm
      */
-    void RunPrimsAlgorithm(reco::HitPairList&, kdTree::KdTreeNode&, reco::ClusterParametersList&) const;
+    void RunPrimsAlgorithm(reco::HitPairList&, kdTree::KdTreeNode&, const FlatKdTree::TreeData&, reco::ClusterParametersList&) const;
 
     /**
      *  @brief Prune the obvious ambiguous hits
@@ -134,6 +135,7 @@ private:
      *  @brief Data members to follow
      */
     bool                                                      m_enableMonitoring;      ///<
+    bool                                                      m_useFlatKdTree;         ///< Use the flat kdTree for neighborhoods
     mutable std::vector<float>                                m_timeVector;            ///<
     std::vector<std::vector<float>>                           m_wireDir;               ///<
 
@@ -141,13 +143,15 @@ private:
 
     PrincipalComponentsAlg                                    m_pcaAlg;                // For running Principal Components Analysis
     kdTree                                                    m_kdTree;                // For the kdTree
+    FlatKdTree                                                m_flatKdTree;            // For the flat kdTree
 
     std::unique_ptr<lar_cluster3d::IClusterParametersBuilder> m_clusterBuilder;        ///<  Common cluster builder tool
 };
 
 MinSpanTreeAlg::MinSpanTreeAlg(fhicl::ParameterSet const &pset) :
     m_pcaAlg(pset.get<fhicl::ParameterSet>("PrincipalComponentsAlg")),
-    m_kdTree(pset.get<fhicl::ParameterSet>("kdTree"))
+    m_kdTree(pset.get<fhicl::ParameterSet>("kdTree")),
+    m_flatKdTree(pset.get<fhicl::ParameterSet>("kdTree"))
 {
     this->configure(pset);
 }
@@ -163,6 +167,7 @@ MinSpanTreeAlg::~MinSpanTreeAlg()
 void MinSpanTreeAlg::configure(fhicl::ParameterSet const &pset)
 {
     m_enableMonitoring         = pset.get<bool>  ("EnableMonitoring",  true  );
+    m_useFlatKdTree            = pset.get<bool>  ("UseFlatKdTree",     false );
 
     art::ServiceHandle<geo::Geometry const> geometry;
 
@@ -220,12 +225,15 @@ void MinSpanTreeAlg::Cluster3DHits(reco::HitPairList&           hitPairList,
     // consuming so the idea is the prebuild the adjaceny map and then run DBScan.
     // The following call does this work
     kdTree::KdTreeNodeList kdTreeNodeContainer;
-    kdTree::KdTreeNode     topNode = m_kdTree.BuildKdTree(hitPairList, kdTreeNodeContainer);
+    FlatKdTree::TreeData   flatTreeData;
+    kdTree::KdTreeNode     topNode = m_useFlatKdTree ? kdTree::KdTreeNode() : m_kdTree.BuildKdTree(hitPairList, kdTreeNodeContainer);
 
-    if (m_enableMonitoring) m_timeVector.at(BUILDHITTOHITMAP) = m_kdTree.getTimeToExecute();
+    if (m_useFlatKdTree) m_flatKdTree.BuildTree(hitPairList, flatTreeData);
+
+    if (m_enableMonitoring) m_timeVector.at(BUILDHITTOHITMAP) = m_useFlatKdTree ? m_flatKdTree.getTimeToExecute() : m_kdTree.getTimeToExecute();
 
     // Run DBScan to get candidate clusters
-    RunPrimsAlgorithm(hitPairList, topNode, clusterParametersList);
+    RunPrimsAlgorithm(hitPairList, topNode, flatTreeData, clusterParametersList);
 
     // Initial clustering is done, now trim the list and get output parameters
     cet::cpu_timer theClockBuildClusters;
@@ -253,6 +261,7 @@ void MinSpanTreeAlg::Cluster3DHits(reco::HitPairList&           hitPairList,
 //------------------------------------------------------------------------------------------------------------------------------------------
 void MinSpanTreeAlg::RunPrimsAlgorithm(reco::HitPairList&           hitPairList,
                                        kdTree::KdTreeNode&          topNode,
+                                       const FlatKdTree::TreeData&  flatTreeData,
                                        reco::ClusterParametersList& clusterParametersList) const
 {
     // If no hits then no work
@@ -270,6 +279,9 @@ void MinSpanTreeAlg::RunPrimsAlgorithm(reco::HitPairList&           hitPairList,
     // This will contain our list of edges
     reco::EdgeList curEdgeList;
 
+    // Neighbor buffer reused for each query of the flat kdTree
+    FlatKdTree::CandPairVec candPairVec;
+
     // Get the first point
     reco::HitPairList::iterator freeHitItr   = hitPairList.begin();
     const reco::ClusterHit3D*   lastAddedHit = &(*freeHitItr++);
@@ -303,24 +315,40 @@ void MinSpanTreeAlg::RunPrimsAlgorithm(reco::HitPairList&           hitPairList,
         // Add the lastUsedHit to the current cluster
         curCluster->push_back(lastAddedHit);
 
-        // Set up to find the list of nearest neighbors to the last used hit...
-        kdTree::CandPairList CandPairList;
-        float                bestDistance(1.5); //std::numeric_limits<float>::max());
-
-        // And find them... result will be an unordered list of neigbors
-        m_kdTree.FindNearestNeighbors(lastAddedHit, topNode, CandPairList, bestDistance);
-
         // Copy edges to the current list (but only for hits not already in a cluster)
-//        for(auto& pair : CandPairList)
-//            if (!(pair.second->getStatusBits() & reco::ClusterHit3D::CLUSTERATTACHED)) curEdgeList.push_back(reco::EdgeTuple(lastAddedHit,pair.second,pair.first));
-        for(auto& pair : CandPairList)
+        auto addEdges = [&curEdgeList, lastAddedHit](const auto& candPairs)
         {
-            if (!(pair.second->getStatusBits() & reco::ClusterHit3D::CLUSTERATTACHED))
+//            for(auto& pair : candPairs)
+//                if (!(pair.second->getStatusBits() & reco::ClusterHit3D::CLUSTERATTACHED)) curEdgeList.push_back(reco::EdgeTuple(lastAddedHit,pair.second,pair.first));
+            for(auto& pair : candPairs)
             {
-                double edgeWeight = lastAddedHit->getHitChiSquare() * pair.second->getHitChiSquare();
-                
-                curEdgeList.push_back(reco::EdgeTuple(lastAddedHit,pair.second,edgeWeight));
+                if (!(pair.second->getStatusBits() & reco::ClusterHit3D::CLUSTERATTACHED))
+                {
+                    double edgeWeight = lastAddedHit->getHitChiSquare() * pair.second->getHitChiSquare();
+
+                    curEdgeList.push_back(reco::EdgeTuple(lastAddedHit,pair.second,edgeWeight));
+                }
             }
+        };
+
+        // Set up to find the list of nearest neighbors to the last used hit...
+        if (m_useFlatKdTree)
+        {
+            candPairVec.clear();
+
+            m_flatKdTree.FindNearestNeighbors(lastAddedHit, flatTreeData, candPairVec);
+
+            addEdges(candPairVec);
+        }
+        else
+        {
+            kdTree::CandPairList CandPairList;
+            float                bestDistance(1.5); //std::numeric_limits<float>::max());
+
+            // And find them... result will be an unordered list of neigbors
+            m_kdTree.FindNearestNeighbors(lastAddedHit, topNode, CandPairList, bestDistance);
+
+            addEdges(CandPairList);
         }
 
         // If the edge list is empty then we have a complete cluster
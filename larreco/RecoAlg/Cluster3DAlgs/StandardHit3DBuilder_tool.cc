@@ -34,10 +34,17 @@
 // Eigen
 #include <Eigen/Core>
 
+// TBB
+#include "tbb/parallel_for.h"
+
 // std includes
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 // Ack!
 #include "TH1F.h"
@@ -63,9 +70,6 @@ namespace lar_cluster3d {
   using TPCToPlaneToHitVectorMap = std::map<geo::TPCID, PlaneToHitVectorMap>;
   using Hit2DList = std::list<reco::ClusterHit2D>;
   using Hit2DSet = std::set<const reco::ClusterHit2D*, Hit2DSetCompare>;
-  using WireToHitSetMap = std::map<unsigned int, Hit2DSet>;
-  using PlaneToWireToHitSetMap = std::map<geo::PlaneID, WireToHitSetMap>;
-  using TPCToPlaneToWireToHitSetMap = std::map<geo::TPCID, PlaneToWireToHitSetMap>;
   using HitVectorMap = std::map<size_t, HitVector>;
 
   //using HitPairVector               = std::vector<std::unique_ptr<reco::ClusterHit3D>>;
@@ -149,31 +153,39 @@ namespace lar_cluster3d {
                            reco::HitPairList& hitPairList) const;
 
     /**
-     *  @brief Given the ClusterHit2D objects, build the HitPairMap
+     *  @brief The hits of one plane in "earliest" time order, with the time range covered by each hit
+     *         kept in parallel arrays so the sweep over the planes only looks at contiguous floats
      */
-    using PlaneHitVectorItrPairVec =
-      std::vector<std::pair<HitVector::iterator, HitVector::iterator>>;
+    struct PlaneHits {
+      HitVector hits;
+      std::vector<float> startTime; ///< Peak time less NumSigmaPeakTime * RMS
+      std::vector<float> endTime;   ///< Peak time plus NumSigmaPeakTime * RMS
+    };
 
-    size_t BuildHitPairMapByTPC(PlaneHitVectorItrPairVec& planeHitVectorItrPairVec,
+    using PlaneHitsVec = std::vector<PlaneHits>;
+
+    /**
+     *  @brief Given the ClusterHit2D objects of the three planes of a TPC, build the HitPairMap
+     */
+    size_t BuildHitPairMapByTPC(const PlaneHitsVec& planeHitsVec,
                                 reco::HitPairList& hitPairList) const;
 
     /**
-     *  @brief This builds a list of candidate hit pairs from lists of hits on two planes
+     *  @brief This builds a list of candidate hit pairs, in wire order, from lists of hits on two planes
      */
     using HitMatchPair = std::pair<const reco::ClusterHit2D*, reco::ClusterHit3D>;
     using HitMatchPairVec = std::vector<HitMatchPair>;
-    using HitMatchPairVecMap = std::map<geo::WireID, HitMatchPairVec>;
 
     int findGoodHitPairs(const reco::ClusterHit2D*,
-                         HitVector::iterator&,
-                         HitVector::iterator&,
-                         HitMatchPairVecMap&) const;
+                         HitVector::const_iterator,
+                         HitVector::const_iterator,
+                         HitMatchPairVec&) const;
 
     /**
      *  @brief This algorithm takes lists of hit pairs and finds good triplets
      */
-    void findGoodTriplets(HitMatchPairVecMap&,
-                          HitMatchPairVecMap&,
+    void findGoodTriplets(const HitMatchPairVec&,
+                          const HitMatchPairVec&,
                           reco::HitPairList&,
                           bool = false) const;
 
@@ -227,10 +239,42 @@ namespace lar_cluster3d {
     float DistanceFromPointToHitWire(const Eigen::Vector3f& position,
                                      const geo::WireID& wireID) const;
 
+    /**
+     *  @brief The geometry of the wires of each TPC is looked up once and kept in dense tables indexed by
+     *         plane and wire number. The wire intersections checked while building the 3D hits of an event
+     *         are also kept since the same pair of wires is typically checked many times.
+     */
+    struct WireGeometry {
+      Eigen::Vector3d start; ///< Start point of the wire
+      Eigen::Vector3d dir;   ///< Unit vector along the wire
+    };
+
+    struct WireIntersection {
+      bool intersect;
+      geo::WireIDIntersection intersection;
+    };
+
+    struct TPCWireTable {
+      bool filled = false;
+      std::vector<WireGeometry> planeWires[3];
+      std::unordered_map<uint64_t, WireIntersection> intersectionMap;
+    };
+
+    void BuildTPCWireTable(TPCWireTable& wireTable, const geo::TPCID& tpcID) const;
+
+    TPCWireTable* FindTPCWireTable(const geo::PlaneID& planeID) const;
+
+    /**
+     *  @brief Jacket the geometry's check for intersecting wires to use the cache in the wire tables
+     */
+    bool WireIDsIntersect(const geo::WireID& wireID1,
+                          const geo::WireID& wireID2,
+                          geo::WireIDIntersection& widIntersect) const;
+
     /**
      *  @brief Create the internal channel status vector (assume will eventually be event-by-event)
      */
-    void BuildChannelStatusVec(PlaneToWireToHitSetMap& planeToWiretoHitSetMap) const;
+    void BuildChannelStatusVec() const;
 
     /**
      * @brief Perform charge integration between limits
@@ -260,6 +304,7 @@ namespace lar_cluster3d {
       m_wirePitchScaleFactor; ///< Scaling factor to determine max distance allowed between candidate pairs
     float m_maxHit3DChiSquare; ///< Provide ability to select hits based on "chi square"
     bool m_outputHistograms;   ///< Take the time to create and fill some histograms for diagnostics
+    bool m_runParallel;        ///< Build the 3D hits of the TPCs concurrently
 
     bool m_enableMonitoring; ///<
     float m_wirePitch[3];
@@ -287,7 +332,9 @@ namespace lar_cluster3d {
     // Get instances of the primary data structures needed
     mutable Hit2DList m_clusterHit2DMasterList;
     mutable PlaneToHitVectorMap m_planeToHitVectorMap;
-    mutable PlaneToWireToHitSetMap m_planeToWireToHitSetMap;
+
+    mutable std::vector<TPCWireTable> m_tpcWireTables; ///< Wire tables, by cryostat and TPC
+    mutable size_t m_numTPCs;                           ///< Number of TPCs per cryostat
 
     mutable ChannelStatusByPlaneVec m_channelStatus;
     mutable size_t m_numBadChannels;
@@ -331,6 +378,7 @@ namespace lar_cluster3d {
     m_wirePitchScaleFactor = pset.get<float>("WirePitchScaleFactor", 1.9);
     m_maxHit3DChiSquare = pset.get<float>("MaxHitChiSquare", 6.0);
     m_outputHistograms = pset.get<bool>("OutputHistograms", false);
+    m_runParallel = pset.get<bool>("RunParallel", false);
 
     m_geometry = art::ServiceHandle<geo::Geometry const>{}.get();
 
@@ -339,6 +387,10 @@ namespace lar_cluster3d {
     m_wirePitch[1] = m_geometry->WirePitch(1);
     m_wirePitch[2] = m_geometry->WirePitch(2);
 
+    // The wire tables are filled as TPCs with hits are encountered
+    m_tpcWireTables.clear();
+    m_numTPCs = 0;
+
     // Access ART's TFileService, which will handle creating and writing
     // histograms and n-tuples for us.
     art::ServiceHandle<art::TFileService> tfs;
@@ -387,7 +439,7 @@ namespace lar_cluster3d {
   }
 
   void
-  StandardHit3DBuilder::BuildChannelStatusVec(PlaneToWireToHitSetMap& planeToWireToHitSetMap) const
+  StandardHit3DBuilder::BuildChannelStatusVec() const
   {
     // This is called each event, clear out the previous version and start over
     if (!m_channelStatus.empty()) m_channelStatus.clear();
@@ -458,7 +510,6 @@ namespace lar_cluster3d {
     // Clear the internal data structures
     m_clusterHit2DMasterList.clear();
     m_planeToHitVectorMap.clear();
-    m_planeToWireToHitSetMap.clear();
 
     m_timeVector.resize(NUMTIMEVALUES, 0.);
 
@@ -470,7 +521,7 @@ namespace lar_cluster3d {
     this->CollectArtHits(evt);
 
     // If there are no hits in our view/wire data structure then do not proceed with the full analysis
-    if (!m_planeToWireToHitSetMap.empty()) {
+    if (!m_clusterHit2DMasterList.empty()) {
       // Call the algorithm that builds 3D hits
       this->BuildHit3D(hitPairList);
 
@@ -520,7 +571,7 @@ namespace lar_cluster3d {
 
     // The first task is to take the lists of input 2D hits (a map of view to sorted lists of 2D hits)
     // and then to build a list of 3D hits to be used in downstream processing
-    BuildChannelStatusVec(m_planeToWireToHitSetMap);
+    BuildChannelStatusVec();
 
     size_t numHitPairs = BuildHitPairMap(m_planeToHitVectorMap, hitPairList);
 
@@ -555,30 +606,6 @@ namespace lar_cluster3d {
       float m_numRMS;
     };
 
-    using HitVectorItrPair = std::pair<HitVector::iterator, HitVector::iterator>;
-
-    class SetStartTimeOrder {
-    public:
-      SetStartTimeOrder() : m_numRMS(1.) {}
-      SetStartTimeOrder(float numRMS) : m_numRMS(numRMS) {}
-
-      bool
-      operator()(const HitVectorItrPair& left, const HitVectorItrPair& right) const
-      {
-        // Protect against possible issue?
-        if (left.first != left.second && right.first != right.second) {
-          // Sort by "modified start time" of pulse
-          return (*left.first)->getTimeTicks() - m_numRMS * (*left.first)->getHit()->RMS() <
-                 (*right.first)->getTimeTicks() - m_numRMS * (*right.first)->getHit()->RMS();
-        }
-
-        return left.first != left.second;
-      }
-
-    private:
-      float m_numRMS;
-    };
-
     bool
     SetPairStartTimeOrder(const reco::ClusterHit3D& left, const reco::ClusterHit3D& right)
     {
@@ -604,12 +631,19 @@ namespace lar_cluster3d {
      *         will evaluate the situation and in some instances keep the U-W pairs in order to keep efficiency high.
      */
     size_t totalNumHits(0);
-    size_t hitPairCntr(0);
 
     size_t nTriplets(0);
     size_t nDeadChanHits(0);
 
-    // Set up to loop over cryostats and tpcs...
+    // The wire tables are sized on the first pass and filled as we encounter TPCs with hits
+    if (m_tpcWireTables.empty()) {
+      m_numTPCs = m_geometry->NTPC();
+      m_tpcWireTables.resize(m_geometry->Ncryostats() * m_numTPCs);
+    }
+
+    // Set up to loop over cryostats and tpcs, keeping those with hits in at least two planes
+    std::vector<geo::TPCID> tpcIDVec;
+
     for (size_t cryoIdx = 0; cryoIdx < m_geometry->Ncryostats(); cryoIdx++) {
       for (size_t tpcIdx = 0; tpcIdx < m_geometry->NTPC(); tpcIdx++) {
         PlaneToHitVectorMap::iterator mapItr0 =
@@ -626,27 +660,75 @@ namespace lar_cluster3d {
 
         if (nPlanesWithHits < 2) continue;
 
-        HitVector& hitVector0 = mapItr0->second;
-        HitVector& hitVector1 = mapItr1->second;
-        HitVector& hitVector2 = mapItr2->second;
+        tpcIDVec.emplace_back(cryoIdx, tpcIdx);
+      }
+    }
+
+    // The TPCs are independent of each other so each builds its 3D hits into its own list
+    std::vector<reco::HitPairList> tpcHitPairListVec(tpcIDVec.size());
+
+    auto buildTPCHits = [&](size_t tpcVecIdx) {
+      const geo::TPCID& tpcID = tpcIDVec[tpcVecIdx];
+      TPCWireTable& wireTable = m_tpcWireTables[tpcID.Cryostat * m_numTPCs + tpcID.TPC];
+
+      if (!wireTable.filled) BuildTPCWireTable(wireTable, tpcID);
+
+      wireTable.intersectionMap.clear();
+
+      PlaneHitsVec planeHitsVec(3);
+
+      for (size_t planeIdx = 0; planeIdx < 3; planeIdx++) {
+        PlaneToHitVectorMap::iterator mapItr =
+          planeToHitVectorMap.find(geo::PlaneID(tpcID, planeIdx));
+
+        // A plane without hits is simply left empty
+        if (mapItr == planeToHitVectorMap.end()) continue;
+
+        HitVector& hitVector = mapItr->second;
 
         // We are going to resort the hits into "start time" order...
-        std::sort(hitVector0.begin(),
-                  hitVector0.end(),
-                  SetHitEarliestTimeOrder(m_numSigmaPeakTime)); //SetHitStartTimeOrder);
-        std::sort(hitVector1.begin(),
-                  hitVector1.end(),
-                  SetHitEarliestTimeOrder(m_numSigmaPeakTime)); //SetHitStartTimeOrder);
-        std::sort(hitVector2.begin(),
-                  hitVector2.end(),
-                  SetHitEarliestTimeOrder(m_numSigmaPeakTime)); //SetHitStartTimeOrder);
-
-        PlaneHitVectorItrPairVec hitItrVec = {
-          HitVectorItrPair(hitVector0.begin(), hitVector0.end()),
-          HitVectorItrPair(hitVector1.begin(), hitVector1.end()),
-          HitVectorItrPair(hitVector2.begin(), hitVector2.end())};
-
-        totalNumHits += BuildHitPairMapByTPC(hitItrVec, hitPairList);
+        std::sort(hitVector.begin(), hitVector.end(), SetHitEarliestTimeOrder(m_numSigmaPeakTime));
+
+        PlaneHits& planeHits = planeHitsVec[planeIdx];
+
+        planeHits.hits = hitVector;
+        planeHits.startTime.reserve(hitVector.size());
+        planeHits.endTime.reserve(hitVector.size());
+
+        for (const auto& hit2D : hitVector) {
+          planeHits.startTime.push_back(hit2D->getTimeTicks() -
+                                        m_numSigmaPeakTime * hit2D->getHit()->RMS());
+          planeHits.endTime.push_back(hit2D->getTimeTicks() +
+                                      m_numSigmaPeakTime * hit2D->getHit()->RMS());
+        }
+      }
+
+      BuildHitPairMapByTPC(planeHitsVec, tpcHitPairListVec[tpcVecIdx]);
+    };
+
+    // Note that the histogram vectors are shared so only go multithreaded if not filling them
+    if (m_runParallel && !m_outputHistograms)
+      tbb::parallel_for(size_t(0), tpcIDVec.size(), buildTPCHits);
+    else {
+      for (size_t tpcVecIdx = 0; tpcVecIdx < tpcIDVec.size(); tpcVecIdx++)
+        buildTPCHits(tpcVecIdx);
+    }
+
+    // Now collect the hits in TPC order, the id of a 3D hit is its index in the full list
+    for (const auto& tpcHitPairList : tpcHitPairListVec) {
+      totalNumHits += tpcHitPairList.size();
+
+      for (const auto& hit3D : tpcHitPairList) {
+        hitPairList.push_back(hit3D);
+        hitPairList.back().setID(hitPairList.size() - 1);
+
+        // Pairs kept because of a dead channel have no hit in the third plane
+        const reco::ClusterHit2DVec& hit2DVec = hit3D.getHits();
+
+        if (std::find(hit2DVec.begin(), hit2DVec.end(), nullptr) == hit2DVec.end())
+          nTriplets++;
+        else
+          nDeadChanHits++;
       }
     }
 
@@ -655,8 +737,8 @@ namespace lar_cluster3d {
 
     // Where are we?
     mf::LogDebug("Cluster3D") << "Total number hits: " << totalNumHits << std::endl;
-    mf::LogDebug("Cluster3D") << "Created a total of " << hitPairList.size()
-                              << " hit pairs, counted: " << hitPairCntr << std::endl;
+    mf::LogDebug("Cluster3D") << "Created a total of " << hitPairList.size() << " hit pairs"
+                              << std::endl;
     mf::LogDebug("Cluster3D") << "-- Triplets: " << nTriplets
                               << ", dead channel pairs: " << nDeadChanHits << std::endl;
 
@@ -664,7 +746,7 @@ namespace lar_cluster3d {
   }
 
   size_t
-  StandardHit3DBuilder::BuildHitPairMapByTPC(PlaneHitVectorItrPairVec& hitItrVec,
+  StandardHit3DBuilder::BuildHitPairMapByTPC(const PlaneHitsVec& planeHitsVec,
                                              reco::HitPairList& hitPairList) const
   {
     /**
@@ -675,87 +757,101 @@ namespace lar_cluster3d {
      *         be prepared to deal with. The idea, then, is to first make the association of hits in the U and W planes
      *         and then look for the match in the V plane. In the event we don't find the match in the V plane then we
      *         will evaluate the situation and in some instances keep the U-W pairs in order to keep efficiency high.
+     *
+     *         The hits of the three planes are swept in order of start time. Each hit in turn is the "golden" hit and
+     *         is paired with the hits in the other two planes which overlap it in time. As the golden hits come in
+     *         order of increasing start time the first overlapping hit in each plane only ever moves forward.
      */
+    struct PlaneCursor {
+      const PlaneHits* planeHits;
+      size_t head;        ///< Next golden hit candidate in this plane
+      size_t windowStart; ///< First hit which can overlap the current golden hit
 
-    // Define functions to set start/end iterators in the loop below
-    auto SetStartIterator =
-      [](HitVector::iterator startItr, HitVector::iterator endItr, float rms, float startTime) {
-        while (startItr != endItr) {
-          float numRMS(rms);
-          if ((*startItr)->getTimeTicks() + numRMS * (*startItr)->getHit()->RMS() < startTime)
-            startItr++;
-          else
-            break;
-        }
-        return startItr;
-      };
-
-    auto SetEndIterator =
-      [](HitVector::iterator firstItr, HitVector::iterator endItr, float rms, float endTime) {
-        while (firstItr != endItr) {
-          float numRMS(rms);
-          if ((*firstItr)->getTimeTicks() - numRMS * (*firstItr)->getHit()->RMS() < endTime)
-            firstItr++;
-          else
-            break;
-        }
-        return firstItr;
-      };
+      bool
+      done() const
+      {
+        return head == planeHits->hits.size();
+      }
+    };
 
-    size_t nTriplets(0);
-    size_t nDeadChanHits(0);
+    // Define the ordering of the planes so the earliest hit time will be the first element, etc.
+    auto SetStartTimeOrder = [](const PlaneCursor& left, const PlaneCursor& right) {
+      // Protect against possible issue?
+      if (!left.done() && !right.done())
+        return left.planeHits->startTime[left.head] < right.planeHits->startTime[right.head];
+
+      return !left.done();
+    };
+
+    std::vector<PlaneCursor> cursorVec;
+
+    for (const auto& planeHits : planeHitsVec)
+      cursorVec.push_back({&planeHits, 0, 0});
+
+    // Since we'll use these many times in the internal loops, keep the containers for the pairs
+    HitMatchPairVec pair12Vec;
+    HitMatchPairVec pair13Vec;
 
     //*********************************************************************************
     // Basically, we try to loop until done...
     while (1) {
       // Sort so that the earliest hit time will be the first element, etc.
-      std::sort(hitItrVec.begin(), hitItrVec.end(), SetStartTimeOrder(m_numSigmaPeakTime));
+      std::sort(cursorVec.begin(), cursorVec.end(), SetStartTimeOrder);
 
       // This loop iteration's golden hit
-      const reco::ClusterHit2D* goldenHit = *hitItrVec[0].first;
+      PlaneCursor& goldenCursor = cursorVec[0];
+      const reco::ClusterHit2D* goldenHit = goldenCursor.planeHits->hits[goldenCursor.head];
 
       // The range of history... (for this hit)
-      float goldenTimeStart = goldenHit->getTimeTicks() -
-                              m_numSigmaPeakTime * goldenHit->getHit()->RMS() -
+      float goldenTimeStart = goldenCursor.planeHits->startTime[goldenCursor.head] -
                               std::numeric_limits<float>::epsilon();
-      float goldenTimeEnd = goldenHit->getTimeTicks() +
-                            m_numSigmaPeakTime * goldenHit->getHit()->RMS() +
+      float goldenTimeEnd = goldenCursor.planeHits->endTime[goldenCursor.head] +
                             std::numeric_limits<float>::epsilon();
 
-      // Set iterators to insure we'll be in the overlap ranges
-      HitVector::iterator hitItr1Start = SetStartIterator(
-        hitItrVec[1].first, hitItrVec[1].second, m_numSigmaPeakTime, goldenTimeStart);
-      HitVector::iterator hitItr1End =
-        SetEndIterator(hitItr1Start, hitItrVec[1].second, m_numSigmaPeakTime, goldenTimeEnd);
-      HitVector::iterator hitItr2Start = SetStartIterator(
-        hitItrVec[2].first, hitItrVec[2].second, m_numSigmaPeakTime, goldenTimeStart);
-      HitVector::iterator hitItr2End =
-        SetEndIterator(hitItr2Start, hitItrVec[2].second, m_numSigmaPeakTime, goldenTimeEnd);
+      // Set the windows to insure we'll be in the overlap ranges
+      size_t windowEnd[3];
 
-      // Since we'll use these many times in the internal loops, pre make the pairs for the second set of hits
-      size_t curHitListSize(hitPairList.size());
-      HitMatchPairVecMap pair12Map;
-      HitMatchPairVecMap pair13Map;
+      for (size_t idx = 1; idx < 3; idx++) {
+        PlaneCursor& cursor = cursorVec[idx];
+        const std::vector<float>& startTime = cursor.planeHits->startTime;
+        const std::vector<float>& endTime = cursor.planeHits->endTime;
+        size_t windowStart = std::max(cursor.windowStart, cursor.head);
 
-      size_t n12Pairs = findGoodHitPairs(goldenHit, hitItr1Start, hitItr1End, pair12Map);
-      size_t n13Pairs = findGoodHitPairs(goldenHit, hitItr2Start, hitItr2End, pair13Map);
+        while (windowStart < endTime.size() && endTime[windowStart] < goldenTimeStart)
+          windowStart++;
 
-      nDeadChanHits += hitPairList.size() - curHitListSize;
-      curHitListSize = hitPairList.size();
+        cursor.windowStart = windowStart;
+        windowEnd[idx] =
+          std::lower_bound(startTime.begin() + windowStart, startTime.end(), goldenTimeEnd) -
+          startTime.begin();
+      }
+
+      const HitVector& hitVector1 = cursorVec[1].planeHits->hits;
+      const HitVector& hitVector2 = cursorVec[2].planeHits->hits;
+
+      pair12Vec.clear();
+      pair13Vec.clear();
+
+      size_t n12Pairs = findGoodHitPairs(goldenHit,
+                                         hitVector1.begin() + cursorVec[1].windowStart,
+                                         hitVector1.begin() + windowEnd[1],
+                                         pair12Vec);
+      size_t n13Pairs = findGoodHitPairs(goldenHit,
+                                         hitVector2.begin() + cursorVec[2].windowStart,
+                                         hitVector2.begin() + windowEnd[2],
+                                         pair13Vec);
 
       if (n12Pairs > n13Pairs)
-        findGoodTriplets(pair12Map, pair13Map, hitPairList);
+        findGoodTriplets(pair12Vec, pair13Vec, hitPairList);
       else
-        findGoodTriplets(pair13Map, pair12Map, hitPairList);
-
-      nTriplets += hitPairList.size() - curHitListSize;
+        findGoodTriplets(pair13Vec, pair12Vec, hitPairList);
 
-      hitItrVec[0].first++;
+      goldenCursor.head++;
 
       int nPlanesWithHits(0);
 
-      for (auto& pair : hitItrVec)
-        if (pair.first != pair.second) nPlanesWithHits++;
+      for (const auto& cursor : cursorVec)
+        if (!cursor.done()) nPlanesWithHits++;
 
       if (nPlanesWithHits < 2) break;
     }
@@ -765,9 +861,9 @@ namespace lar_cluster3d {
 
   int
   StandardHit3DBuilder::findGoodHitPairs(const reco::ClusterHit2D* goldenHit,
-                                         HitVector::iterator& startItr,
-                                         HitVector::iterator& endItr,
-                                         HitMatchPairVecMap& hitMatchMap) const
+                                         HitVector::const_iterator startItr,
+                                         HitVector::const_iterator endItr,
+                                         HitMatchPairVec& hitMatchPairVec) const
   {
     int numPairs(0);
 
@@ -779,82 +875,71 @@ namespace lar_cluster3d {
       // pair returned with a negative ave time is signal of failure
       if (!makeHitPair(pair, goldenHit, hit, m_hitWidthSclFctr)) continue;
 
-      geo::WireID wireID = hit->WireID();
-
-      hitMatchMap[wireID].emplace_back(hit, pair);
+      hitMatchPairVec.emplace_back(hit, pair);
 
       numPairs++;
     }
 
+    // Put the pairs in wire order, pairs on the same wire are kept in time order
+    std::stable_sort(
+      hitMatchPairVec.begin(), hitMatchPairVec.end(), [](const auto& left, const auto& right) {
+        return left.first->WireID() < right.first->WireID();
+      });
+
     return numPairs;
   }
 
   void
-  StandardHit3DBuilder::findGoodTriplets(HitMatchPairVecMap& pair12Map,
-                                         HitMatchPairVecMap& pair13Map,
+  StandardHit3DBuilder::findGoodTriplets(const HitMatchPairVec& pair12Vec,
+                                         const HitMatchPairVec& pair13Vec,
                                          reco::HitPairList& hitPairList,
                                          bool tagged) const
   {
     // Build triplets from the two lists of hit pairs
-    if (!pair12Map.empty()) {
+    if (!pair12Vec.empty()) {
       // temporary container for dead channel hits
       std::vector<reco::ClusterHit3D> tempDeadChanVec;
       reco::ClusterHit3D deadChanPair;
 
-      // Keep track of which third plane hits have been used
-      std::map<const reco::ClusterHit3D*, bool> usedPairMap;
-
-      // Initial population of this map with the pair13Map hits
-      for (const auto& pair13 : pair13Map) {
-        for (const auto& hit2Dhit3DPair : pair13.second)
-          usedPairMap[&hit2Dhit3DPair.second] = false;
-      }
+      // Keep track of which pairs have been used in a triplet
+      std::vector<bool> used12Vec(pair12Vec.size(), false);
+      std::vector<bool> used13Vec(pair13Vec.size(), false);
 
       // The outer loop is over all hit pairs made from the first two plane combinations
-      for (const auto& pair12 : pair12Map) {
-        if (pair12.second.empty()) continue;
+      for (size_t idx12 = 0; idx12 < pair12Vec.size(); idx12++) {
+        const reco::ClusterHit3D& pair1 = pair12Vec[idx12].second;
 
-        // This loop is over hit pairs that share the same first two plane wires but may have different
-        // hit times on those wires
-        for (const auto& hit2Dhit3DPair12 : pair12.second) {
-          const reco::ClusterHit3D& pair1 = hit2Dhit3DPair12.second;
+        // The simplest approach here is to loop over all possibilities and let the triplet builder weed out the weak candidates
+        for (size_t idx13 = 0; idx13 < pair13Vec.size(); idx13++) {
+          const reco::ClusterHit2D* hit2 = pair13Vec[idx13].first;
 
-          // populate the map with initial value
-          usedPairMap[&pair1] = false;
+          // If success try for the triplet
+          reco::ClusterHit3D triplet;
 
-          // The simplest approach here is to loop over all possibilities and let the triplet builder weed out the weak candidates
-          for (const auto& pair13 : pair13Map) {
-            if (pair13.second.empty()) continue;
-
-            for (const auto& hit2Dhit3DPair13 : pair13.second) {
-              const reco::ClusterHit2D* hit2 = hit2Dhit3DPair13.first;
-              const reco::ClusterHit3D& pair2 = hit2Dhit3DPair13.second;
-
-              // If success try for the triplet
-              reco::ClusterHit3D triplet;
-
-              if (makeHitTriplet(triplet, pair1, hit2)) {
-                triplet.setID(hitPairList.size());
-                hitPairList.emplace_back(triplet);
-                usedPairMap[&pair1] = true;
-                usedPairMap[&pair2] = true;
-              }
-            }
+          if (makeHitTriplet(triplet, pair1, hit2)) {
+            triplet.setID(hitPairList.size());
+            hitPairList.emplace_back(triplet);
+            used12Vec[idx12] = true;
+            used13Vec[idx13] = true;
           }
         }
       }
 
       // One more loop through the other pairs to check for sick channels
       if (m_numBadChannels > 0) {
-        for (const auto& pairMapPair : usedPairMap) {
-          if (pairMapPair.second) continue;
-
-          const reco::ClusterHit3D* pair = pairMapPair.first;
+        auto checkDeadChannels = [&](const HitMatchPairVec& pairVec,
+                                     const std::vector<bool>& usedVec) {
+          for (size_t idx = 0; idx < pairVec.size(); idx++) {
+            if (usedVec[idx]) continue;
+
+            // Here we look to see if we failed to make a triplet because the partner wire was dead/noisy/sick
+            if (makeDeadChannelPair(deadChanPair, pairVec[idx].second, 4, 0, 0.))
+              tempDeadChanVec.emplace_back(deadChanPair);
+          }
+        };
 
-          // Here we look to see if we failed to make a triplet because the partner wire was dead/noisy/sick
-          if (makeDeadChannelPair(deadChanPair, *pair, 4, 0, 0.))
-            tempDeadChanVec.emplace_back(deadChanPair);
-        }
+        checkDeadChannels(pair12Vec, used12Vec);
+        checkDeadChannels(pair13Vec, used13Vec);
 
         // Handle the dead wire triplets
         if (!tempDeadChanVec.empty()) {
@@ -925,7 +1010,7 @@ namespace lar_cluster3d {
 
     geo::WireIDIntersection widIntersect;
 
-    if (m_geometry->WireIDsIntersect(hit1WireID, hit2WireID, widIntersect)) {
+    if (WireIDsIntersect(hit1WireID, hit2WireID, widIntersect)) {
       // Wires intersect so now we can check the timing
       float hit1Peak = hit1->getTimeTicks();
       float hit1Sigma = hit1->getHit()->RMS();
@@ -1362,10 +1447,10 @@ namespace lar_cluster3d {
       // Want to refine position since we "know" the missing wire
       geo::WireIDIntersection widIntersect0;
 
-      if (m_geometry->WireIDsIntersect(wireID0, wireID, widIntersect0)) {
+      if (WireIDsIntersect(wireID0, wireID, widIntersect0)) {
         geo::WireIDIntersection widIntersect1;
 
-        if (m_geometry->WireIDsIntersect(wireID1, wireID, widIntersect1)) {
+        if (WireIDsIntersect(wireID1, wireID, widIntersect1)) {
           Eigen::Vector3f newPosition(
             pair.getPosition()[0], pair.getPosition()[1], pair.getPosition()[2]);
 
@@ -1481,6 +1566,23 @@ namespace lar_cluster3d {
   StandardHit3DBuilder::DistanceFromPointToHitWire(const Eigen::Vector3f& position,
                                                    const geo::WireID& wireIDIn) const
   {
+    // Use the wire table if we have one for this TPC
+    const TPCWireTable* wireTable = FindTPCWireTable(wireIDIn.planeID());
+
+    if (wireTable && wireIDIn.Wire < wireTable->planeWires[wireIDIn.Plane].size()) {
+      const WireGeometry& wire = wireTable->planeWires[wireIDIn.Plane][wireIDIn.Wire];
+
+      // Want the hit position to have same x value as wire coordinates
+      Eigen::Vector3d hitPosition(wire.start[0], position[1], position[2]);
+
+      // Get arc length to doca
+      double arcLen = (hitPosition - wire.start).dot(wire.dir);
+
+      Eigen::Vector3d docaVec = hitPosition - (wire.start + arcLen * wire.dir);
+
+      return docaVec.norm();
+    }
+
     float distance;
 
     // Embed the call to the geometry's services nearest wire id method in a try-catch block
@@ -1518,6 +1620,75 @@ namespace lar_cluster3d {
     return distance;
   }
 
+  void
+  StandardHit3DBuilder::BuildTPCWireTable(TPCWireTable& wireTable, const geo::TPCID& tpcID) const
+  {
+    for (size_t planeIdx = 0; planeIdx < std::min(size_t(3), size_t(m_geometry->Nplanes(tpcID)));
+         planeIdx++) {
+      geo::PlaneID planeID(tpcID, planeIdx);
+      std::vector<WireGeometry>& wireVec = wireTable.planeWires[planeIdx];
+
+      wireVec.resize(m_geometry->Nwires(planeID));
+
+      for (size_t wireIdx = 0; wireIdx < wireVec.size(); wireIdx++) {
+        WireGeometry& wire = wireVec[wireIdx];
+        Eigen::Vector3d wireEnd;
+
+        m_geometry->WireEndPoints(geo::WireID(planeID, wireIdx), &wire.start[0], &wireEnd[0]);
+
+        wire.dir = wireEnd - wire.start;
+        wire.dir.normalize();
+      }
+    }
+
+    wireTable.filled = true;
+
+    return;
+  }
+
+  StandardHit3DBuilder::TPCWireTable*
+  StandardHit3DBuilder::FindTPCWireTable(const geo::PlaneID& planeID) const
+  {
+    size_t tableIdx = planeID.Cryostat * m_numTPCs + planeID.TPC;
+
+    if (planeID.Plane >= 3 || tableIdx >= m_tpcWireTables.size() ||
+        !m_tpcWireTables[tableIdx].filled)
+      return nullptr;
+
+    return &m_tpcWireTables[tableIdx];
+  }
+
+  bool
+  StandardHit3DBuilder::WireIDsIntersect(const geo::WireID& wireID1,
+                                         const geo::WireID& wireID2,
+                                         geo::WireIDIntersection& widIntersect) const
+  {
+    // We only cache intersections of wires in the same TPC
+    TPCWireTable* wireTable = FindTPCWireTable(wireID1.planeID());
+
+    if (!wireTable || wireID2.Plane >= 3 || wireID1.Cryostat != wireID2.Cryostat ||
+        wireID1.TPC != wireID2.TPC || wireID1.Wire >= (1 << 24) || wireID2.Wire >= (1 << 24))
+      return m_geometry->WireIDsIntersect(wireID1, wireID2, widIntersect);
+
+    uint64_t key = (uint64_t(3 * wireID1.Plane + wireID2.Plane) << 48) |
+                   (uint64_t(wireID1.Wire) << 24) | uint64_t(wireID2.Wire);
+
+    auto intersectionItr = wireTable->intersectionMap.find(key);
+
+    if (intersectionItr == wireTable->intersectionMap.end()) {
+      WireIntersection wireIntersection;
+
+      wireIntersection.intersect =
+        m_geometry->WireIDsIntersect(wireID1, wireID2, wireIntersection.intersection);
+
+      intersectionItr = wireTable->intersectionMap.emplace(key, wireIntersection).first;
+    }
+
+    widIntersect = intersectionItr->second.intersection;
+
+    return intersectionItr->second.intersect;
+  }
+
   //------------------------------------------------------------------------------------------------------------------------------------------
   bool
   SetHitTimeOrder(const reco::ClusterHit2D* left, const reco::ClusterHit2D* right)
@@ -1649,7 +1820,6 @@ namespace lar_cluster3d {
         m_clusterHit2DMasterList.emplace_back(0, 0., 0., xPosition, hitPeakTime, wireID, recobHit);
 
         m_planeToHitVectorMap[planeID].push_back(&m_clusterHit2DMasterList.back());
-        m_planeToWireToHitSetMap[planeID][wireID.Wire].insert(&m_clusterHit2DMasterList.back());
       }
     }
 
@@ -36,6 +36,9 @@
 #include "larevt/CalibrationDBI/Interface/ChannelStatusService.h"
 #include "larreco/RecoAlg/ClusterCrawlerAlg.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 namespace {
   struct CluLen {
     int index;
@@ -51,6 +54,14 @@ namespace {
 
 namespace cluster {
 
+  /// A plane crawled by its own copy of the algorithm
+  struct ClusterCrawlerAlg::PlaneWorker {
+    ClusterCrawlerAlg alg;     ///< the algorithm, with the hits of the plane only
+    geo::PlaneID planeID;      ///< the plane being crawled
+    unsigned int firstHit = 0; ///< index in the event hits of the first hit of the plane
+    bool crawled = false;      ///< whether the plane was crawled (false if no hits)
+  };
+
   //------------------------------------------------------------------------------
   ClusterCrawlerAlg::ClusterCrawlerAlg(fhicl::ParameterSet const& pset)
   {
@@ -98,6 +109,9 @@ namespace cluster {
     fVertex2DWireErrCut = pset.get<float>("Vertex2DWireErrCut", 5);
     fVertex3DCut = pset.get<float>("Vertex3DCut", 5);
 
+    fRunParallel = pset.get<bool>("RunParallel", false);
+    fCheckParallel = pset.get<bool>("CheckParallel", false);
+
     fDebugPlane = pset.get<int>("DebugPlane", -1);
     fDebugWire = pset.get<int>("DebugWire", -1);
     fDebugHit = pset.get<int>("DebugHit", -1);
@@ -236,34 +250,46 @@ namespace cluster {
       mergeAvailable[iht] = false;
     }
 
+    fNumEventHits = fHits.size();
+    // the wire pitch is the one of the view of the first hit, in all planes
+    fPitchView = geom->View(fHits[0].Channel());
+
+    if (fRunParallel && fCheckParallel) {
+      // crawl a serial copy as well and compare the results
+      ClusterCrawlerAlg serial(*this);
+      serial.fRunParallel = false;
+      serial.CrawlAllPlanes(clock_data, det_prop);
+      CrawlAllPlanes(clock_data, det_prop);
+      if (!SameResults(serial))
+        mf::LogWarning("CC") << "RunCrawler: the serial and concurrent crawls differ";
+      return;
+    }
+
+    CrawlAllPlanes(clock_data, det_prop);
+
+  } // RunCrawler
+
+  ////////////////////////////////////////////////
+  void
+  ClusterCrawlerAlg::CrawlAllPlanes(detinfo::DetectorClocksData const& clock_data,
+                                    detinfo::DetectorPropertiesData const& det_prop)
+  {
+    // Crawls all the planes of the sorted hits, matches the vertices in 3D and
+    // removes the obsolete hits
+    // with RunParallel, all the planes are crawled first, each by a copy of
+    // the algorithm owning only the hits of that plane; the results are then
+    // merged in the same order as the serial loop would produce them
+    std::vector<PlaneWorker> workers;
+    if (fRunParallel) workers = CrawlPlanesParallel(clock_data, det_prop);
+    auto iWorker = workers.begin();
+
     for (geo::TPCID const& tpcid : geom->IterateTPCIDs()) {
       geo::TPCGeo const& TPC = geom->TPC(tpcid);
       for (plane = 0; plane < TPC.Nplanes(); ++plane) {
-        WireHitRange.clear();
-        // define a code to ensure clusters are compared within the same plane
-        clCTP = EncodeCTP(tpcid.Cryostat, tpcid.TPC, plane);
-        cstat = tpcid.Cryostat;
-        tpc = tpcid.TPC;
-        // fill the WireHitRange vector with first/last hit on each wire
-        // dead wires and wires with no hits are flagged < 0
-        GetHitRange(clCTP);
-
-        // sanity check
-        if (WireHitRange.empty() || (fFirstWire == fLastWire)) continue;
-        raw::ChannelID_t channel = fHits[fFirstHit].Channel();
-        // get the scale factor to convert dTick/dWire to dX/dU. This is used
-        // to make the kink and merging cuts
-        float wirePitch = geom->WirePitch(geom->View(channel));
-        float tickToDist = det_prop.DriftVelocity(det_prop.Efield(), det_prop.Temperature());
-        tickToDist *= 1.e-3 * sampling_rate(clock_data); // 1e-3 is conversion of 1/us to 1/ns
-        fScaleF = tickToDist / wirePitch;
-        // convert Large Angle Cluster crawling cut to a slope cut
-        if (fLAClusAngleCut > 0)
-          fLAClusSlopeCut = std::tan(3.142 * fLAClusAngleCut / 180.) / fScaleF;
-        fMaxTime = det_prop.NumberTimeSamples();
-        fNumWires = geom->Nwires(plane, tpc, cstat);
-        // look for clusters
-        if (fNumPass > 0) ClusterLoop();
+        if (fRunParallel)
+          MergePlane(clock_data, det_prop, *(iWorker++));
+        else
+          CrawlPlane(clock_data, det_prop, geo::PlaneID(tpcid, plane));
       } // plane
       if (fVertex3DCut > 0) {
         // Match vertices in 3 planes
@@ -289,7 +315,282 @@ namespace cluster {
     // remove the hits that have become obsolete
     RemoveObsoleteHits();
 
-  } // RunCrawler
+  } // CrawlAllPlanes
+
+  ////////////////////////////////////////////////
+  bool
+  ClusterCrawlerAlg::SameResults(ClusterCrawlerAlg const& serial) const
+  {
+    // Compares the hits, clusters and vertices with those of a serial crawl.
+    // The differences are printed. Returns true if there are none
+    std::string diff;
+    if (fHits.size() != serial.fHits.size()) diff += " number of hits\n";
+    else {
+      for (unsigned int iht = 0; iht < fHits.size(); ++iht) {
+        auto const& h1 = fHits[iht];
+        auto const& h2 = serial.fHits[iht];
+        if (h1.WireID() != h2.WireID() || h1.PeakTime() != h2.PeakTime() ||
+            h1.Integral() != h2.Integral() || h1.RMS() != h2.RMS() ||
+            inClus[iht] != serial.inClus[iht])
+          diff += " hit " + std::to_string(iht) + "\n";
+      } // iht
+    }
+    if (tcl.size() != serial.tcl.size())
+      diff += " number of clusters\n";
+    else {
+      for (unsigned short icl = 0; icl < tcl.size(); ++icl) {
+        auto const& c1 = tcl[icl];
+        auto const& c2 = serial.tcl[icl];
+        if (c1.ID != c2.ID || c1.CTP != c2.CTP || c1.ProcCode != c2.ProcCode ||
+            c1.StopCode != c2.StopCode || c1.BeginWir != c2.BeginWir ||
+            c1.BeginTim != c2.BeginTim || c1.BeginSlp != c2.BeginSlp ||
+            c1.BeginVtx != c2.BeginVtx || c1.EndWir != c2.EndWir || c1.EndTim != c2.EndTim ||
+            c1.EndSlp != c2.EndSlp || c1.EndVtx != c2.EndVtx || c1.tclhits != c2.tclhits)
+          diff += " cluster " + std::to_string(c1.ID) + "\n";
+      } // icl
+    }
+    if (vtx.size() != serial.vtx.size())
+      diff += " number of 2D vertices\n";
+    else {
+      for (unsigned short iv = 0; iv < vtx.size(); ++iv) {
+        auto const& v1 = vtx[iv];
+        auto const& v2 = serial.vtx[iv];
+        if (v1.CTP != v2.CTP || v1.Wire != v2.Wire || v1.Time != v2.Time ||
+            v1.NClusters != v2.NClusters || v1.Topo != v2.Topo || v1.ChiDOF != v2.ChiDOF)
+          diff += " 2D vertex " + std::to_string(iv) + "\n";
+      } // iv
+    }
+    if (vtx3.size() != serial.vtx3.size())
+      diff += " number of 3D vertices\n";
+    else {
+      for (unsigned short iv = 0; iv < vtx3.size(); ++iv) {
+        auto const& v1 = vtx3[iv];
+        auto const& v2 = serial.vtx3[iv];
+        if (v1.Ptr2D != v2.Ptr2D || v1.X != v2.X || v1.Y != v2.Y || v1.Z != v2.Z ||
+            v1.Wire != v2.Wire || v1.ProcCode != v2.ProcCode)
+          diff += " 3D vertex " + std::to_string(iv) + "\n";
+      } // iv
+    }
+    if (diff.empty()) return true;
+    mf::LogWarning("CC") << "SameResults: serial and concurrent crawls differ:\n" << diff;
+    return false;
+  } // SameResults
+
+  ////////////////////////////////////////////////
+  bool
+  ClusterCrawlerAlg::CrawlPlane(detinfo::DetectorClocksData const& clock_data,
+                                detinfo::DetectorPropertiesData const& det_prop,
+                                geo::PlaneID const& planeID)
+  {
+    // Looks for clusters in a plane; returns false if there are no hits to crawl
+    WireHitRange.clear();
+    // define a code to ensure clusters are compared within the same plane
+    clCTP = EncodeCTP(planeID);
+    cstat = planeID.Cryostat;
+    tpc = planeID.TPC;
+    plane = planeID.Plane;
+    // fill the WireHitRange vector with first/last hit on each wire
+    // dead wires and wires with no hits are flagged < 0
+    GetHitRange(clCTP);
+
+    // sanity check
+    if (WireHitRange.empty() || (fFirstWire == fLastWire)) return false;
+    // get the scale factor to convert dTick/dWire to dX/dU. This is used
+    // to make the kink and merging cuts
+    float wirePitch = geom->WirePitch(fPitchView);
+    float tickToDist = det_prop.DriftVelocity(det_prop.Efield(), det_prop.Temperature());
+    tickToDist *= 1.e-3 * sampling_rate(clock_data); // 1e-3 is conversion of 1/us to 1/ns
+    fScaleF = tickToDist / wirePitch;
+    // convert Large Angle Cluster crawling cut to a slope cut
+    if (fLAClusAngleCut > 0) fLAClusSlopeCut = std::tan(3.142 * fLAClusAngleCut / 180.) / fScaleF;
+    fMaxTime = det_prop.NumberTimeSamples();
+    fNumWires = geom->Nwires(plane, tpc, cstat);
+    // look for clusters
+    if (fNumPass > 0) ClusterLoop();
+    return true;
+  } // CrawlPlane
+
+  ////////////////////////////////////////////////
+  std::vector<ClusterCrawlerAlg::PlaneWorker>
+  ClusterCrawlerAlg::CrawlPlanesParallel(detinfo::DetectorClocksData const& clock_data,
+                                         detinfo::DetectorPropertiesData const& det_prop)
+  {
+    // the workers are copies of the algorithm as it is before crawling,
+    // without the hits of the event
+    std::vector<recob::Hit> hits;
+    std::swap(hits, fHits);
+    std::vector<short> hitClus;
+    std::swap(hitClus, inClus);
+    std::vector<bool> hitMerge;
+    std::swap(hitMerge, mergeAvailable);
+
+    std::vector<PlaneWorker> workers;
+    for (geo::TPCID const& tpcid : geom->IterateTPCIDs()) {
+      for (unsigned int ipl = 0; ipl < geom->TPC(tpcid).Nplanes(); ++ipl)
+        workers.push_back({*this, geo::PlaneID(tpcid, ipl), 0, false});
+    }
+
+    std::swap(hits, fHits);
+    std::swap(hitClus, inClus);
+    std::swap(hitMerge, mergeAvailable);
+
+    // hits are sorted by plane, so each plane has a contiguous range of them
+    auto const hitPlaneLess = [](recob::Hit const& hit, geo::PlaneID const& planeID) {
+      return hit.WireID().asPlaneID() < planeID;
+    };
+    auto const planeHitLess = [](geo::PlaneID const& planeID, recob::Hit const& hit) {
+      return planeID < hit.WireID().asPlaneID();
+    };
+
+    tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, workers.size(), 1),
+      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t iw = range.begin(); iw < range.end(); ++iw) {
+          PlaneWorker& worker = workers[iw];
+          auto const begin =
+            std::lower_bound(fHits.cbegin(), fHits.cend(), worker.planeID, hitPlaneLess);
+          auto const end = std::upper_bound(begin, fHits.cend(), worker.planeID, planeHitLess);
+          worker.firstHit = begin - fHits.cbegin();
+          ClusterCrawlerAlg& alg = worker.alg;
+          alg.fHits.assign(begin, end);
+          alg.inClus.assign(alg.fHits.size(), 0);
+          alg.mergeAvailable.assign(alg.fHits.size(), false);
+          alg.fSaveVtxQueries = true;
+          worker.crawled = alg.CrawlPlane(clock_data, det_prop, worker.planeID);
+        } // for workers
+      });
+
+    return workers;
+  } // CrawlPlanesParallel
+
+  ////////////////////////////////////////////////
+  void
+  ClusterCrawlerAlg::MergePlane(detinfo::DetectorClocksData const& clock_data,
+                                detinfo::DetectorPropertiesData const& det_prop,
+                                PlaneWorker& worker)
+  {
+    // Appends the results of a plane crawled by a worker, and takes over its
+    // per-plane working state, as if the plane had just been crawled by this
+    // object
+    ClusterCrawlerAlg& alg = worker.alg;
+    unsigned int const hitOffset = worker.firstHit;
+    short const clusterOffset = NClusters;
+    short const vtxOffset = vtx.size();
+
+    if (NClusters + alg.NClusters > SHRT_MAX) {
+      // the cluster IDs would have run out while crawling this plane, and
+      // TmpStore would have refused the clusters from then on. Crawl it again
+      // from the current state as the serial loop does
+      CrawlPlane(clock_data, det_prop, worker.planeID);
+      return;
+    }
+    if (NearEarlierVertex(alg.fVtxQueries)) {
+      // the serial crawl of this plane could have been affected by a vertex
+      // of a plane crawled before it, which the worker didn't know about
+      CrawlPlane(clock_data, det_prop, worker.planeID);
+      return;
+    }
+
+    // hits may have been merged, and are assigned to clusters with new IDs
+    std::copy(alg.fHits.cbegin(), alg.fHits.cend(), fHits.begin() + hitOffset);
+    std::copy(alg.mergeAvailable.cbegin(), alg.mergeAvailable.cend(),
+              mergeAvailable.begin() + hitOffset);
+    for (unsigned int iht = 0; iht < alg.inClus.size(); ++iht) {
+      short const clID = alg.inClus[iht];
+      inClus[hitOffset + iht] = (clID > 0) ? clID + clusterOffset : clID;
+    }
+
+    for (ClusterStore& clstr : alg.tcl) {
+      // obsolete clusters have negative ID
+      clstr.ID += (clstr.ID > 0) ? clusterOffset : -clusterOffset;
+      for (unsigned int& iht : clstr.tclhits)
+        iht += hitOffset;
+      if (clstr.BeginVtx >= 0) clstr.BeginVtx += vtxOffset;
+      if (clstr.EndVtx >= 0) clstr.EndVtx += vtxOffset;
+      tcl.push_back(std::move(clstr));
+    }
+    vtx.insert(vtx.end(), alg.vtx.cbegin(), alg.vtx.cend());
+    NClusters += alg.NClusters;
+
+    // working state, as the serial crawl of the plane leaves it; hit indices
+    // are moved into the full hit list. The configuration and the event state
+    // (e.g. the 3D vertices) are this object's own, and are left untouched
+    for (auto& range : alg.WireHitRange) {
+      if (range.first < 0) continue;
+      range.first += hitOffset;
+      range.second += hitOffset;
+    }
+    clCTP = alg.clCTP;
+    cstat = alg.cstat;
+    tpc = alg.tpc;
+    plane = alg.plane;
+    fFirstWire = alg.fFirstWire;
+    fLastWire = alg.fLastWire;
+    fFirstHit = alg.fFirstHit;
+    WireHitRange = std::move(alg.WireHitRange);
+    // only the hit range was looked for
+    if (!worker.crawled) return;
+
+    for (unsigned int& iht : alg.fcl2hits)
+      iht += hitOffset;
+    fScaleF = alg.fScaleF;
+    fLAClusSlopeCut = alg.fLAClusSlopeCut;
+    fMaxTime = alg.fMaxTime;
+    fNumWires = alg.fNumWires;
+    pass = alg.pass;
+    fcl2hits = std::move(alg.fcl2hits);
+    chifits = std::move(alg.chifits);
+    hitNear = std::move(alg.hitNear);
+    chgNear = std::move(alg.chgNear);
+    std::copy(std::begin(alg.clpar), std::end(alg.clpar), std::begin(clpar));
+    std::copy(std::begin(alg.clparerr), std::end(alg.clparerr), std::begin(clparerr));
+    clChisq = alg.clChisq;
+    fAveChg = alg.fAveChg;
+    fChgSlp = alg.fChgSlp;
+    fAveHitWidth = alg.fAveHitWidth;
+    prt = alg.prt;
+    vtxprt = alg.vtxprt;
+    clBeginSlp = alg.clBeginSlp;
+    clBeginAng = alg.clBeginAng;
+    clBeginSlpErr = alg.clBeginSlpErr;
+    clBeginWir = alg.clBeginWir;
+    clBeginTim = alg.clBeginTim;
+    clBeginChg = alg.clBeginChg;
+    clBeginChgNear = alg.clBeginChgNear;
+    clEndSlp = alg.clEndSlp;
+    clEndAng = alg.clEndAng;
+    clEndSlpErr = alg.clEndSlpErr;
+    clEndWir = alg.clEndWir;
+    clEndTim = alg.clEndTim;
+    clEndChg = alg.clEndChg;
+    clEndChgNear = alg.clEndChgNear;
+    clStopCode = alg.clStopCode;
+    clProcCode = alg.clProcCode;
+    clLA = alg.clLA;
+  } // MergePlane
+
+  ////////////////////////////////////////////////
+  bool
+  ClusterCrawlerAlg::NearEarlierVertex(std::vector<VtxQuery> const& queries) const
+  {
+    // Returns true if a 2D vertex that is already stored is close enough to the
+    // position of a query to change its result. ClusterVertex only uses the
+    // vertices of other planes if they are within 2 wires of a short cluster end,
+    // and AddHit if they are within 10 wires and 20 ticks of the hit
+    for (auto const& query : queries) {
+      for (auto const& vx : vtx) {
+        if (query.addHit) {
+          if (std::abs(query.wire - vx.Wire) < 10 && std::abs(int(query.time - vx.Time)) < 20)
+            return true;
+        }
+        else {
+          if (std::abs(vx.Time - query.time) < 50 && std::abs(vx.Wire - query.wire) < 3)
+            return true;
+        }
+      } // vx
+    }   // query
+    return false;
+  } // NearEarlierVertex
 
   ////////////////////////////////////////////////
   void
@@ -456,7 +757,7 @@ namespace cluster {
               }
               ClusterAdded = true;
               nHitsUsed += fcl2hits.size();
-              AllDone = (nHitsUsed == fHits.size());
+              AllDone = (nHitsUsed == fNumEventHits);
               break;
             }
             else {
@@ -1473,7 +1774,7 @@ namespace cluster {
         // DS side
         if (vtxprt)
           mf::LogVerbatim("CC") << " Chk cluster ID " << tcl[icl].ID << " with vertex " << ivx;
-        short ihvx = -99;
+        int ihvx = -99;
         // nSplit is the index of the hit in the cluster where we will
         // split it if all requirements are met
         unsigned short nSplit = 0;
@@ -2319,6 +2620,10 @@ namespace cluster {
         if (dwie > 2) dwie = 2;
         dwjb = 999;
         dwje = 999;
+        if (fSaveVtxQueries) {
+          fVtxQueries.push_back({tcl[it].BeginWir, tcl[it].BeginTim, false});
+          fVtxQueries.push_back({tcl[it].EndWir, tcl[it].EndTim, false});
+        }
         for (jv = 0; jv < vtx.size(); ++jv) {
           if (iv == jv) continue;
           if (std::abs(vtx[jv].Time - tcl[it].BeginTim) < 50) {
@@ -4903,6 +5208,7 @@ namespace cluster {
     if (lastClHit != UINT_MAX && fAveHitWidth > 0 && fHitMergeChiCut > 0 &&
         hit.Multiplicity() == 2) {
       bool doMerge = true;
+      if (fSaveVtxQueries) fVtxQueries.push_back({kwire, hit.PeakTime(), true});
       for (unsigned short ivx = 0; ivx < vtx.size(); ++ivx) {
         if (std::abs(kwire - vtx[ivx].Wire) < 10 &&
             std::abs(int(hit.PeakTime() - vtx[ivx].Time)) < 20) {
@@ -221,6 +221,9 @@ namespace cluster {
     float fVertex2DWireErrCut;
     float fVertex3DCut; ///< 2D vtx -> 3D vtx matching cut (chisq/dof)
 
+    bool fRunParallel;   ///< crawl all the planes concurrently, then merge the results
+    bool fCheckParallel; ///< also crawl them serially and compare the results
+
     int fDebugPlane;
     int fDebugWire; ///< set to the Begin Wire and Hit of a cluster to print
     int fDebugHit;  ///< out detailed information while crawling
@@ -304,6 +307,9 @@ namespace cluster {
 
     unsigned short pass;
 
+    unsigned int fNumEventHits; ///< number of hits in the event, in all planes
+    geo::View_t fPitchView;     ///< view of the first hit, which defines the wire pitch
+
     // vector of pairs of first (.first) and last+1 (.second) hit on each wire
     // in the range fFirstWire to fLastWire. A value of -2 indicates that there
     // are no hits on the wire. A value of -1 indicates that the wire is dead
@@ -320,6 +326,42 @@ namespace cluster {
                                 ///< to define a shower-like cluster
 
     std::string fhitsModuleLabel;
+
+    struct PlaneWorker;
+
+    // A position at which ClusterVertex or AddHit looked for 2D vertices of all
+    // planes. A plane worker doesn't have the vertices of the planes crawled
+    // before its plane, so MergePlane checks its queries against them
+    struct VtxQuery {
+      unsigned int wire;
+      float time;
+      bool addHit; ///< made by AddHit, otherwise by ClusterVertex
+    };
+    bool fSaveVtxQueries{false};
+    std::vector<VtxQuery> fVtxQueries;
+
+    // ******** plane routines *****************
+
+    // Crawls all the planes, serially or concurrently
+    void CrawlAllPlanes(detinfo::DetectorClocksData const& clock_data,
+                        detinfo::DetectorPropertiesData const& det_prop);
+    // Compares the results with those of a serial crawl; returns true if they are the same
+    bool SameResults(ClusterCrawlerAlg const& serial) const;
+
+    // Crawls the plane; returns false if it has no hits
+    bool CrawlPlane(detinfo::DetectorClocksData const& clock_data,
+                    detinfo::DetectorPropertiesData const& det_prop,
+                    geo::PlaneID const& planeID);
+    // Crawls all the planes concurrently, each one with its own copy of this algorithm
+    std::vector<PlaneWorker> CrawlPlanesParallel(detinfo::DetectorClocksData const& clock_data,
+                                                 detinfo::DetectorPropertiesData const& det_prop);
+    // Adds the results of a plane crawled by CrawlPlanesParallel
+    void MergePlane(detinfo::DetectorClocksData const& clock_data,
+                    detinfo::DetectorPropertiesData const& det_prop,
+                    PlaneWorker& worker);
+    // Returns true if a stored 2D vertex could change the result of one of the queries
+    bool NearEarlierVertex(std::vector<VtxQuery> const& queries) const;
+
     // ******** crawling routines *****************
 
     // Loops over wires looking for seed clusters
@@ -3,7 +3,6 @@
 #include "lardataobj/RecoBase/Hit.h"
 #include "larcore/Geometry/Geometry.h"
 #include "larcorealg/Geometry/GeometryCore.h"
-#include "larcorealg/CoreUtils/NumericUtils.h" // util::absDiff()
 #include "larevt/CalibrationDBI/Interface/ChannelStatusService.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusProvider.h"
 
@@ -11,15 +10,19 @@
 #include "cetlib/pow.h"
 #include "fhiclcpp/ParameterSet.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 #include <algorithm>
-#include <stdio.h>
-#include <stdlib.h>
+#include <cmath>
+#include <iostream>
 
 cluster::DBScan3DAlg::DBScan3DAlg(fhicl::ParameterSet const& pset)
   : epsilon(pset.get< float >("epsilon"))
   , minpts(pset.get<unsigned int>("minpts"))
   , badchannelweight(pset.get<double>("badchannelweight"))
   , neighbors(pset.get<unsigned int>("neighbors"))
+  , runparallel(pset.get<bool>("RunParallel", false))
 {
   // square epsilon to eliminate the use of sqrt later on
   epsilon *= epsilon;
@@ -32,16 +35,23 @@ void cluster::DBScan3DAlg::init(const std::vector<art::Ptr<recob::SpacePoint>>&
   if (badchannelmap.empty()){
     lariov::ChannelStatusProvider const& channelStatus = art::ServiceHandle<lariov::ChannelStatusService const>()->GetProvider();
     geo::GeometryCore const* geom = &*(art::ServiceHandle<geo::Geometry const>());
-    // build a map to count bad channels around each wire ID
+    // count the bad channels within `neighbors` wires of each wire ID, from
+    // the running count of bad wires along each plane
     for (auto &pid : geom->IteratePlaneIDs()){
-      for (auto& wid1: geom->IterateWireIDs(pid)) {
-        unsigned int nbadchs = 0;
-        for (auto& wid2: geom->IterateWireIDs(pid)) {
-          if (wid1==wid2) continue;
-          if (util::absDiff(wid1.Wire,wid2.Wire)<neighbors &&
-              !channelStatus.IsGood(geom->PlaneWireToChannel(wid2))) ++nbadchs;
-        }
-        badchannelmap[wid1] = nbadchs;
+      unsigned int const nwires = geom->Nwires(pid);
+      std::vector<unsigned int> nbadbefore(nwires + 1, 0);
+      for (unsigned int wire = 0; wire < nwires; ++wire) {
+        bool const bad = !channelStatus.IsGood(geom->PlaneWireToChannel(geo::WireID(pid, wire)));
+        nbadbefore[wire + 1] = nbadbefore[wire] + (bad ? 1 : 0);
+      }
+      std::vector<unsigned int>& nbadchs = badchannelmap[pid];
+      nbadchs.assign(nwires, 0);
+      if (neighbors == 0) continue;
+      for (unsigned int wire = 0; wire < nwires; ++wire) {
+        unsigned int const first = (wire >= neighbors - 1) ? wire - (neighbors - 1) : 0;
+        unsigned int const last = std::min(nwires, wire + neighbors);
+        unsigned int const self = nbadbefore[wire + 1] - nbadbefore[wire];
+        nbadchs[wire] = nbadbefore[last] - nbadbefore[first] - self;
       }
     }
     std::cout<<"Done building bad channel map."<<std::endl;
@@ -56,82 +66,136 @@ void cluster::DBScan3DAlg::init(const std::vector<art::Ptr<recob::SpacePoint>>&
     point.nbadchannels = 0;
     auto &hits = hitFromSp.at(spt.key());
     for (auto & hit : hits){
-      point.nbadchannels += badchannelmap[hit->WireID()];
+      geo::WireID const& wid = hit->WireID();
+      auto const iplane = badchannelmap.find(wid);
+      if (iplane != badchannelmap.end() && wid.Wire < iplane->second.size())
+        point.nbadchannels += iplane->second[wid.Wire];
     }
     points.push_back(point);
   }
 }
 
-node_t *cluster::DBScan3DAlg::create_node(unsigned int index)
+//----------------------------------------------------------
+void cluster::DBScan3DAlg::build_grid()
 {
-  node_t *n = (node_t *) calloc(1, sizeof(node_t));
-  if (n == NULL)
-    perror("Failed to allocate node.");
-  else {
-    n->index = index;
-    n->next = NULL;
+  cellkeys.clear();
+  cellpoints.clear();
+  maxnbadchannels = 0;
+  cellsize = std::sqrt(epsilon);
+  if (!(cellsize > 0.)) cellsize = 1.;
+  if (points.empty()) return;
+
+  for (unsigned int i = 0; i < 3; ++i)
+    gridorigin[i] = points[0].sp->XYZ()[i];
+  for (auto const& point : points) {
+    Double32_t const* xyz = point.sp->XYZ();
+    for (unsigned int i = 0; i < 3; ++i)
+      gridorigin[i] = std::min<double>(gridorigin[i], xyz[i]);
+    maxnbadchannels = std::max(maxnbadchannels, point.nbadchannels);
   }
-  return n;
-}
 
-int cluster::DBScan3DAlg::append_at_end(unsigned int index,
-                                        epsilon_neighbours_t *en)
-{
-  node_t *n = create_node(index);
-  if (n == NULL) {
-    free(en);
-    return FAILURE;
+  std::vector<std::pair<std::uint64_t, unsigned int>> keyed;
+  keyed.reserve(points.size());
+  for (unsigned int i = 0; i < points.size(); ++i) {
+    Double32_t const* xyz = points[i].sp->XYZ();
+    keyed.emplace_back(cell_key(std::floor((xyz[0] - gridorigin[0]) / cellsize),
+                                std::floor((xyz[1] - gridorigin[1]) / cellsize),
+                                std::floor((xyz[2] - gridorigin[2]) / cellsize)),
+                       i);
   }
-  if (en->head == NULL) {
-    en->head = n;
-    en->tail = n;
-  } else {
-    en->tail->next = n;
-    en->tail = n;
+  std::sort(keyed.begin(), keyed.end());
+  cellkeys.reserve(keyed.size());
+  cellpoints.reserve(keyed.size());
+  for (auto const& [key, index] : keyed) {
+    cellkeys.push_back(key);
+    cellpoints.push_back(index);
   }
-  ++(en->num_members);
-  return SUCCESS;
 }
 
-epsilon_neighbours_t *cluster::DBScan3DAlg::get_epsilon_neighbours(unsigned int index)
+std::uint64_t cluster::DBScan3DAlg::cell_key(long ix, long iy, long iz) const
 {
-  epsilon_neighbours_t *en = (epsilon_neighbours_t *)
-    calloc(1, sizeof(epsilon_neighbours_t));
-  if (en == NULL) {
-    perror("Failed to allocate epsilon neighbours.");
-    return en;
+  // 21 bits per axis; voxels further apart than that may share a key, which
+  // only adds candidates that the distance test then rejects
+  constexpr std::uint64_t mask = (std::uint64_t{1} << 21) - 1;
+  return ((static_cast<std::uint64_t>(ix) & mask) << 42) |
+         ((static_cast<std::uint64_t>(iy) & mask) << 21) |
+         (static_cast<std::uint64_t>(iz) & mask);
+}
+
+template <typename Op>
+void cluster::DBScan3DAlg::for_each_neighbour(unsigned int index, Op op) const
+{
+  point_t const& p = points[index];
+
+  // bad channels shrink the distance, so points with more of them reach
+  // further; the small margin covers the rounding of dist()
+  double const reach2 =
+    epsilon + cet::square((p.nbadchannels + maxnbadchannels) * badchannelweight);
+  long const ncells = std::ceil(std::sqrt(reach2) * (1. + 1e-5) / cellsize);
+
+  if (cet::cube(2. * ncells + 1.) > points.size()) {
+    for (unsigned int i = 0; i < points.size(); ++i) {
+      if (i == index) continue;
+      if (dist(&p, &points[i]) > epsilon) continue;
+      op(i);
+    }
+    return;
   }
-  for (unsigned int i = 0; i < points.size(); ++i) {
-    if (i == index)
-      continue;
-    if (dist(&points[index], &points[i]) > epsilon)
-      continue;
-    else {
-      if (append_at_end(i, en) == FAILURE) {
-        destroy_epsilon_neighbours(en);
-        en = NULL;
-        break;
+
+  Double32_t const* xyz = p.sp->XYZ();
+  long const ix = std::floor((xyz[0] - gridorigin[0]) / cellsize);
+  long const iy = std::floor((xyz[1] - gridorigin[1]) / cellsize);
+  long const iz = std::floor((xyz[2] - gridorigin[2]) / cellsize);
+  for (long dx = -ncells; dx <= ncells; ++dx) {
+    for (long dy = -ncells; dy <= ncells; ++dy) {
+      for (long dz = -ncells; dz <= ncells; ++dz) {
+        auto const key = cell_key(ix + dx, iy + dy, iz + dz);
+        auto const first = std::lower_bound(cellkeys.begin(), cellkeys.end(), key);
+        for (auto it = first; it != cellkeys.end() && *it == key; ++it) {
+          unsigned int const i = cellpoints[it - cellkeys.begin()];
+          if (i == index) continue;
+          if (dist(&p, &points[i]) > epsilon) continue;
+          op(i);
+        }
       }
     }
   }
-  return en;
 }
 
-void cluster::DBScan3DAlg::destroy_epsilon_neighbours(epsilon_neighbours_t *en)
+unsigned int cluster::DBScan3DAlg::count_epsilon_neighbours(unsigned int index) const
 {
-  if (en) {
-    node_t *t, *h = en->head;
-    while (h) {
-      t = h->next;
-      free(h);
-      h = t;
-    }
-    free(en);
-  }
+  unsigned int count = 0;
+  for_each_neighbour(index, [&count](unsigned int) { ++count; });
+  return count;
+}
+
+void cluster::DBScan3DAlg::get_epsilon_neighbours(unsigned int index,
+                                                  std::vector<unsigned int>& neighbours) const
+{
+  neighbours.clear();
+  for_each_neighbour(index, [&neighbours](unsigned int i) { neighbours.push_back(i); });
+  // in the order of the points, as a scan of all of them would find them
+  std::sort(neighbours.begin(), neighbours.end());
 }
 
 void cluster::DBScan3DAlg::dbscan()
 {
+  build_grid();
+
+  // whether a point is a core point is all that most queries need
+  nneighbours.assign(points.size(), 0);
+  if (runparallel) {
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, points.size()),
+                      [&](const tbb::blocked_range<std::size_t>& range) {
+                        for (std::size_t i = range.begin(); i < range.end(); ++i)
+                          nneighbours[i] = count_epsilon_neighbours(i);
+                      });
+  }
+  else {
+    for (std::size_t i = 0; i < points.size(); ++i)
+      nneighbours[i] = count_epsilon_neighbours(i);
+  }
+
   unsigned int i, cluster_id = 0;
   for (i = 0; i < points.size(); ++i) {
     if (points[i].cluster_id == UNCLASSIFIED) {
@@ -144,67 +208,43 @@ void cluster::DBScan3DAlg::dbscan()
 int cluster::DBScan3DAlg::expand(unsigned int index,
                                  unsigned int cluster_id)
 {
-  int return_value = NOT_CORE_POINT;
-  epsilon_neighbours_t *seeds =
-    get_epsilon_neighbours(index);
-  if (seeds == NULL)
-    return FAILURE;
-
-  if (seeds->num_members < minpts)
+  if (nneighbours[index] < minpts) {
     points[index].cluster_id = NOISE;
-  else {
-    points[index].cluster_id = cluster_id;
-    node_t *h = seeds->head;
-    while (h) {
-      points[h->index].cluster_id = cluster_id;
-      h = h->next;
-    }
+    return NOT_CORE_POINT;
+  }
 
-    h = seeds->head;
-    while (h) {
-      spread(h->index, seeds, cluster_id);
-      h = h->next;
-    }
+  std::vector<unsigned int>& seeds = seedbuffer;
+  get_epsilon_neighbours(index, seeds);
+  points[index].cluster_id = cluster_id;
+  for (unsigned int seed : seeds)
+    points[seed].cluster_id = cluster_id;
 
-    return_value = CORE_POINT;
-  }
-  destroy_epsilon_neighbours(seeds);
-  return return_value;
+  // spread() appends to the seeds
+  for (std::size_t i = 0; i < seeds.size(); ++i)
+    spread(seeds[i], cluster_id);
+
+  return CORE_POINT;
 }
 
 int cluster::DBScan3DAlg::spread(unsigned int index,
-                                 epsilon_neighbours_t *seeds,
                                  unsigned int cluster_id)
 {
-  epsilon_neighbours_t *spread =
-    get_epsilon_neighbours(index);
-  if (spread == NULL)
-    return FAILURE;
-  if (spread->num_members >= minpts) {
-    node_t *n = spread->head;
-    point_t *d;
-    while (n) {
-      d = &points[n->index];
-      if (d->cluster_id == NOISE ||
-          d->cluster_id == UNCLASSIFIED) {
-        if (d->cluster_id == UNCLASSIFIED) {
-          if (append_at_end(n->index, seeds)
-              == FAILURE) {
-            destroy_epsilon_neighbours(spread);
-            return FAILURE;
-          }
-        }
-        d->cluster_id = cluster_id;
-      }
-      n = n->next;
+  if (nneighbours[index] < minpts) return SUCCESS;
+
+  get_epsilon_neighbours(index, spreadbuffer);
+  for (unsigned int neighbour : spreadbuffer) {
+    point_t& d = points[neighbour];
+    if (d.cluster_id == NOISE ||
+        d.cluster_id == UNCLASSIFIED) {
+      if (d.cluster_id == UNCLASSIFIED)
+        seedbuffer.push_back(neighbour);
+      d.cluster_id = cluster_id;
     }
   }
-
-  destroy_epsilon_neighbours(spread);
   return SUCCESS;
 }
 
-float cluster::DBScan3DAlg::dist(point_t *a, point_t *b) const
+float cluster::DBScan3DAlg::dist(point_t const* a, point_t const* b) const
 {
   Double32_t const* a_xyz = a->sp->XYZ();
   Double32_t const* b_xyz = b->sp->XYZ();
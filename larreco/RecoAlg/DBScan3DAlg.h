@@ -43,7 +43,9 @@
 #include "canvas/Persistency/Common/FindManyP.h"
 namespace fhicl { class ParameterSet; }
 
+#include <cstdint>
 #include <map>
+#include <vector>
 
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"  // for WireID
 
@@ -59,18 +61,6 @@ struct point_s {
   int cluster_id;
 };
 
-typedef struct node_s node_t;
-struct node_s {
-  unsigned int index;
-  node_t *next;
-};
-
-typedef struct epsilon_neighbours_s epsilon_neighbours_t;
-struct epsilon_neighbours_s {
-  unsigned int num_members;
-  node_t *head, *tail;
-};
-
 namespace cluster{
 
 //---------------------------------------------------------------
@@ -92,19 +82,36 @@ class DBScan3DAlg {
     unsigned int minpts;
     double badchannelweight;
     unsigned int neighbors;
-    std::map<geo::WireID, int> badchannelmap;
-
-    node_t *create_node(unsigned int index);
-    int append_at_end(unsigned int index,
-                      epsilon_neighbours_t *en);
-    epsilon_neighbours_t *get_epsilon_neighbours(unsigned int index);
-    void destroy_epsilon_neighbours(epsilon_neighbours_t *en);
+    bool runparallel;
+    /// Number of bad channels around each wire, indexed by wire, per plane
+    std::map<geo::PlaneID, std::vector<unsigned int>> badchannelmap;
+
+    // Uniform voxel grid of side sqrt(epsilon) over the points: the indices
+    // of the points sorted by voxel key, and the sorted keys themselves.
+    double cellsize;
+    double gridorigin[3];
+    std::vector<std::uint64_t> cellkeys;
+    std::vector<unsigned int> cellpoints;
+    unsigned int maxnbadchannels;
+    /// Number of epsilon neighbours of each point
+    std::vector<unsigned int> nneighbours;
+    /// Neighbour buffers of the cluster being expanded and of the point
+    /// being spread, reused from one cluster to the next
+    std::vector<unsigned int> seedbuffer;
+    std::vector<unsigned int> spreadbuffer;
+
+    void build_grid();
+    std::uint64_t cell_key(long ix, long iy, long iz) const;
+    template <typename Op>
+    void for_each_neighbour(unsigned int index, Op op) const;
+    unsigned int count_epsilon_neighbours(unsigned int index) const;
+    void get_epsilon_neighbours(unsigned int index,
+                                std::vector<unsigned int>& neighbours) const;
     int expand(unsigned int index,
                unsigned int cluster_id);
     int spread(unsigned int index,
-               epsilon_neighbours_t *seeds,
                unsigned int cluster_id);
-    float dist(point_t *a, point_t *b) const;
+    float dist(point_t const* a, point_t const* b) const;
 
 
   }; // class DBScan3DAlg
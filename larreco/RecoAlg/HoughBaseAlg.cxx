@@ -73,19 +73,29 @@ constexpr double PI = M_PI; // or CLHEP::pi in CLHEP/Units/PhysicalConstants.h
 namespace cluster {
   class HoughTransform {
   public:
-    void Init(unsigned int dx, unsigned int dy, float rhores, unsigned int numACells);
+    /// Type of the dense Hough transform (angle, distance) accumulator
+    typedef HoughTransformTiledCounters<signed char> DenseImage_t;
+
+    void Init(unsigned int dx,
+              unsigned int dy,
+              float rhores,
+              unsigned int numACells,
+              DenseImage_t* denseAccum = nullptr);
     std::array<int, 3> AddPointReturnMax(int x, int y);
     bool SubtractPoint(int x, int y);
     int GetCell(int row, int col) const;
     void
     SetCell(int row, int col, int value)
     {
-      m_accum[row].set(col, value);
+      if (m_denseAccum)
+        m_denseAccum->set(row, col, value);
+      else
+        m_accum[row].set(col, value);
     }
     void
     GetAccumSize(int& numRows, int& numCols)
     {
-      numRows = m_accum.size();
+      numRows = (int)m_numAngleCells;
       numCols = (int)m_rowLength;
     }
     int
@@ -115,9 +125,11 @@ namespace cluster {
     // the vector elements are called by rho, theta is the container key,
     // the number of hits is the value corresponding to the key
     HoughImage_t m_accum; ///< column (map key)=rho, row (vector index)=theta
+    DenseImage_t* m_denseAccum = nullptr; ///< if set, used instead of m_accum (not owned)
     int m_numAccumulated;
     std::vector<double> m_cosTable;
     std::vector<double> m_sinTable;
+    std::vector<int> m_dist; ///< distances of the point being added, per angle
 
     std::array<int, 3> DoAddPointReturnMax(int x, int y, bool bSubtract = false);
   }; // class HoughTransform
@@ -158,9 +170,9 @@ cluster::HoughTransformCounters<K, C, S, A, SC>::get_max(SubCounter_t current_ma
     for (size_t index = 0; index < block.size(); ++index) {
       if (block[index] > max.second)
         max = {Base_t::make_const_iterator(iCBlock, index), block[index]};
-      ++iCBlock;
     } // for elements in this block
-  }   // while blocks
+    ++iCBlock;
+  } // while blocks
   return max;
 } // cluster::HoughTransformCounters<>::get_max(SubCounter_t)
 
@@ -273,6 +285,7 @@ cluster::HoughBaseAlg::HoughBaseAlg(fhicl::ParameterSet const& pset)
   fMissedHits = pset.get<int>("MissedHits");
   fMissedHitsDistance = pset.get<float>("MissedHitsDistance");
   fMissedHitsToLineSize = pset.get<float>("MissedHitsToLineSize");
+  fDenseAccumulator = pset.get<bool>("DenseAccumulator", false);
 }
 
 //------------------------------------------------------------------------------
@@ -388,7 +401,8 @@ cluster::HoughBaseAlg::Transform(detinfo::DetectorClocksData const& clockData,
 
   ///Init specifies the size of the two-dimensional accumulator
   ///(based on the arguments, number of wires and number of time samples).
-  c.Init(dx, dy, fRhoResolutionFactor, fNumAngleCells);
+  c.Init(
+    dx, dy, fRhoResolutionFactor, fNumAngleCells, fDenseAccumulator ? &fDenseAccum : nullptr);
   /// Adds all of the hits to the accumulator
 
   c.GetAccumSize(accDy, accDx);
@@ -650,7 +664,7 @@ cluster::HoughBaseAlg::Transform(detinfo::DetectorClocksData const& clockData,
 inline int
 cluster::HoughTransform::GetCell(int row, int col) const
 {
-  return m_accum[row][col];
+  return m_denseAccum ? m_denseAccum->get(row, col) : m_accum[row][col];
 } // cluster::HoughTransform::GetCell()
 
 //------------------------------------------------------------------------------
@@ -681,10 +695,12 @@ void
 cluster::HoughTransform::Init(unsigned int dx,
                               unsigned int dy,
                               float rhores,
-                              unsigned int numACells)
+                              unsigned int numACells,
+                              DenseImage_t* denseAccum /* = nullptr */)
 {
   m_numAngleCells = numACells;
   m_rhoResolutionFactor = rhores;
+  m_denseAccum = denseAccum;
 
   m_accum.clear();
   //--- BEGIN issue #19494 -----------------------------------------------------
@@ -712,7 +728,14 @@ cluster::HoughTransform::Init(unsigned int dx,
   m_dx = dx;
   m_dy = dy;
   m_rowLength = (unsigned int)(m_rhoResolutionFactor * 2 * std::sqrt(dx * dx + dy * dy));
-  m_accum.resize(m_numAngleCells);
+  if (m_denseAccum) {
+    // the rounding in DoAddPointReturnMax() may take a distance a cell
+    // out of [ 0, m_rowLength [; a couple of cells of margin cover it,
+    // and the accumulator extends itself for the rare ones further out
+    m_denseAccum->init(m_numAngleCells, -2, m_rowLength + 3);
+  }
+  else
+    m_accum.resize(m_numAngleCells);
 
   // this math must be coherent with the one in GetEquation()
   double angleStep = PI / m_numAngleCells;
@@ -738,6 +761,18 @@ int
 cluster::HoughTransform::GetMax(int& xmax, int& ymax) const
 {
   int maxVal = -1;
+  if (m_denseAccum) {
+    for (unsigned int i = 0; i < m_numAngleCells; i++) {
+      DenseImage_t::PairValue_t max_counter = m_denseAccum->get_max(i, maxVal);
+      if (max_counter.second > maxVal) {
+        maxVal = max_counter.second;
+        xmax = i;
+        ymax = max_counter.first;
+      }
+    } // for angle
+    return maxVal;
+  }
+
   for (unsigned int i = 0; i < m_accum.size(); i++) {
 
     DistancesMap_t::PairValue_t max_counter = m_accum[i].get_max(maxVal);
@@ -770,16 +805,27 @@ cluster::HoughTransform::DoAddPointReturnMax(int x, int y, bool bSubtract /* = f
   // lastDist represents next distance to be incremented (but see below)
   int lastDist = (int)(distCenter + (m_rhoResolutionFactor * x));
 
+  // Calculate the basic line equation dist = cos(a)*x + sin(a)*y for all the
+  // angles first: this loop does not touch the accumulator and it can be
+  // vectorized. Shift to center of row to cover negative values;
+  // this math must also be coherent with the one in GetEquation()
+  m_dist.resize(m_numAngleCells);
+  int* dists = m_dist.data();
+  double const* cosTable = m_cosTable.data();
+  double const* sinTable = m_sinTable.data();
+  float const rhoResolutionFactor = m_rhoResolutionFactor;
+  for (size_t iAngleStep = 1; iAngleStep < m_numAngleCells; ++iAngleStep) {
+    dists[iAngleStep] =
+      (int)(distCenter +
+            rhoResolutionFactor * (cosTable[iAngleStep] * x + sinTable[iAngleStep] * y));
+  }
+
   // loop through all angles a from 0 to 180 degrees
   // (the value of the angle is established in definition of m_cosTable and
   // m_sinTable in HoughTransform::Init()
   for (size_t iAngleStep = 1; iAngleStep < m_numAngleCells; ++iAngleStep) {
 
-    // Calculate the basic line equation dist = cos(a)*x + sin(a)*y.
-    // Shift to center of row to cover negative values;
-    // this math must also be coherent with the one in GetEquation()
-    const int dist = (int)(distCenter + m_rhoResolutionFactor * (m_cosTable[iAngleStep] * x +
-                                                                 m_sinTable[iAngleStep] * y));
+    const int dist = dists[iAngleStep];
 
     /*
      * For this angle, we are going to increment all the cells starting from the
@@ -814,11 +860,24 @@ cluster::HoughTransform::DoAddPointReturnMax(int x, int y, bool bSubtract /* = f
       end_dist = dist > lastDist ? dist : lastDist + 1;
     }
 
-    DistancesMap_t& distMap = m_accum[iAngleStep];
-    if (bSubtract) { distMap.decrement(first_dist, end_dist); }
+    if (bSubtract) {
+      if (m_denseAccum)
+        m_denseAccum->decrement(iAngleStep, first_dist, end_dist);
+      else
+        m_accum[iAngleStep].decrement(first_dist, end_dist);
+    }
+    else if (m_denseAccum) {
+      DenseImage_t::PairValue_t max_counter =
+        m_denseAccum->increment_and_get_max(iAngleStep, first_dist, end_dist, max_val);
+
+      if (max_counter.second > max_val) {
+        max = {{max_counter.second, max_counter.first, (int)iAngleStep}};
+        max_val = max_counter.second;
+      }
+    }
     else {
       DistancesMap_t::PairValue_t max_counter =
-        distMap.increment_and_get_max(first_dist, end_dist, max_val);
+        m_accum[iAngleStep].increment_and_get_max(first_dist, end_dist, max_val);
 
       if (max_counter.second > max_val) {
         // DEBUG
@@ -1111,7 +1170,8 @@ cluster::HoughBaseAlg::FastTransform(detinfo::DetectorClocksData const& clockDat
   //Init specifies the size of the two-dimensional accumulator
   //(based on the arguments, number of wires and number of time samples).
   //adds all of the hits (that have not yet been associated with a line) to the accumulator
-  c.Init(dx, dy, fRhoResolutionFactor, fNumAngleCells);
+  c.Init(
+    dx, dy, fRhoResolutionFactor, fNumAngleCells, fDenseAccumulator ? &fDenseAccum : nullptr);
 
   // count is how many points are left to randomly insert
   unsigned int count = hit.size();
@@ -1384,7 +1444,8 @@ cluster::HoughBaseAlg::Transform(detinfo::DetectorPropertiesData const& detProp,
   int dx = geom->Nwires(0);                   // number of wires
   const int dy = detProp.ReadOutWindowSize(); // number of time samples.
 
-  c.Init(dx, dy, fRhoResolutionFactor, fNumAngleCells);
+  c.Init(
+    dx, dy, fRhoResolutionFactor, fNumAngleCells, fDenseAccumulator ? &fDenseAccum : nullptr);
 
   for (unsigned int i = 0; i < hits.size(); ++i) {
     c.AddPointReturnMax(hits[i]->WireID().Wire, (int)(hits[i]->PeakTime()));
@@ -120,12 +120,31 @@
 // architectures. No check is performed for overflow; that can also be
 // implemented at a small cost.
 //
+// Dense accumulator
+// ----------------------------------------------------------------------------
+//
+// As an alternative (DenseAccumulator configuration parameter), the
+// accumulator can be a two-dimensional array after all, as long as only the
+// parts of it that are used are allocated: HoughTransformTiledCounters splits
+// the (angle, distance) plane in tiles of 16 angles times 64 distances, and
+// allocates a tile the first time one of its counters is touched. A flat
+// directory of the tiles replaces the map look up with an index computation.
+// The distances of a new hit are computed for all the angles at once, in a
+// loop the compiler can vectorize, before the counters are increased.
+// The two accumulators are meant to yield the same lines; the dense one trades
+// some memory when the hits are sparse for fewer allocations. Its storage is
+// kept by HoughBaseAlg and reused by the following transforms.
+//
 //
 ////////////////////////////////////////////////////////////////////////
 #ifndef HOUGHBASEALG_H
 #define HOUGHBASEALG_H
 
+#include <algorithm> // std::min(), std::max()
 #include <array>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint32_t
+#include <limits>
 #include <map>
 #include <utility> // std::pair<>
 #include <vector>
@@ -465,6 +484,253 @@ namespace cluster {
 
   }; // class HoughTransformCounters
 
+  /**
+   * @brief Dense Hough transform accumulator, allocated in tiles on demand
+   * @param COUNTER the type of a basic counter (can be signed or unsigned)
+   * @param ANGLEBLOCK number of angle cells in a tile
+   * @param RHOBLOCK number of distance cells in a tile
+   * @see HoughTransformCounters
+   *
+   * This is an alternative to a vector of HoughTransformCounters (one per
+   * angle) with the same range increment, decrement and maximum interface,
+   * with the angle as an additional argument.
+   * The (angle, distance) plane is a two-dimensional array split in tiles of
+   * ANGLEBLOCK x RHOBLOCK counters; a tile is allocated (and zeroed) the first
+   * time one of its counters is touched, and a flat directory of all the tiles
+   * makes the look up of a counter constant-time, with no node to create or
+   * rebalance. Within a tile the counters are stored by angle, so that a range
+   * of distances at a given angle is contiguous in memory, and the following
+   * angles of the same sinusoidal curve are usually in the same tile.
+   *
+   * The range of distances specified in init() is extended by whole tiles
+   * when a counter outside of it is set, incremented or decremented, so that
+   * no counter is lost; the counters never touched always count 0.
+   * The memory is kept from one init() to the next: when the shape of the
+   * accumulator does not change, only the directory entries of the tiles
+   * allocated in the meanwhile are reset.
+   * Compared to the map, the memory is larger when the curves are sparse (the
+   * tile is the smallest unit of allocation) and smaller when they are
+   * crowded (no per-node overhead).
+   */
+  template <typename COUNTER, unsigned int ANGLEBLOCK = 16, unsigned int RHOBLOCK = 64>
+  class HoughTransformTiledCounters {
+  public:
+    using Counter_t = COUNTER; ///< type of a single counter
+    using Key_t = int;         ///< type of the distance key
+
+    /// Pair with the key of a counter and its current value
+    using PairValue_t = std::pair<Key_t, Counter_t>;
+
+    /// Number of counters in a tile
+    static constexpr std::size_t TileSize = ANGLEBLOCK * RHOBLOCK;
+
+    /**
+     * @brief Removes all the counters and sets the size of the accumulator
+     * @param numAngles number of angle cells
+     * @param key_min lowest distance key stored
+     * @param key_end first distance key after key_min not stored
+     */
+    void
+    init(unsigned int numAngles, Key_t key_min, Key_t key_end)
+    {
+      std::size_t const nAngleTiles = (numAngles + ANGLEBLOCK - 1) / ANGLEBLOCK;
+      std::size_t const nKeyTiles = (std::max(key_end - key_min, 0) + RHOBLOCK - 1) / RHOBLOCK;
+      if ((nAngleTiles == m_nAngleTiles) && (nKeyTiles == m_nKeyTiles) && (key_min == m_keyMin)) {
+        for (std::size_t index : m_usedTiles)
+          m_tileIndex[index] = NoTile;
+      }
+      else {
+        m_keyMin = key_min;
+        m_nAngleTiles = nAngleTiles;
+        m_nKeyTiles = nKeyTiles;
+        m_keyEnd = m_keyMin + m_nKeyTiles * RHOBLOCK;
+        m_tileIndex.assign(m_nAngleTiles * m_nKeyTiles, NoTile);
+      }
+      m_usedTiles.clear();
+      m_tiles.clear();
+    }
+
+    /// Returns the value of the counter at the specified angle and distance
+    Counter_t
+    get(unsigned int angle, Key_t key) const
+    {
+      if ((key < m_keyMin) || (key >= m_keyEnd)) return 0;
+      TileOffset_t const tile = m_tileIndex[tile_index(angle, key)];
+      return (tile == NoTile) ? 0 : m_tiles[tile + cell_offset(angle, key)];
+    }
+
+    /// Sets the counter at the specified angle and distance to a value
+    void
+    set(unsigned int angle, Key_t key, Counter_t value)
+    {
+      if ((key < m_keyMin) || (key >= m_keyEnd)) extend(key, key + 1);
+      get_tile(angle, key)[cell_offset(angle, key)] = value;
+    }
+
+    /**
+     * @brief Increments by 1 the specified counters and returns the maximum
+     * @param angle the angle cell of the counters
+     * @param key_begin key of the first counter to be increased
+     * @param key_end key of the first counter not to be increased
+     * @param current_max only counters larger than this will be considered
+     * @return pair with the key of the largest counter and its value
+     *
+     * Same as HoughTransformCounters::increment_and_get_max(): the first
+     * (lowest key) counter with the largest value is returned, provided that
+     * value is (strictly) larger than current_max. Otherwise, the returned
+     * value is current_max and the key is key_end.
+     */
+    PairValue_t
+    increment_and_get_max(unsigned int angle,
+                          Key_t key_begin,
+                          Key_t key_end,
+                          Counter_t current_max)
+    {
+      return add_range_max(angle, key_begin, key_end, +1, current_max);
+    }
+
+    /// Decrements by 1 the counters in [ key_begin, key_end [ at angle
+    void
+    decrement(unsigned int angle, Key_t key_begin, Key_t key_end)
+    {
+      add_range_max(angle, key_begin, key_end, -1, std::numeric_limits<Counter_t>::max());
+    }
+
+    /**
+     * @brief Returns the largest counter at the specified angle
+     * @param angle the angle cell of the counters
+     * @param current_max only counters larger than this will be considered
+     * @return pair with the key of the largest counter and its value
+     *
+     * The first (lowest key) counter with the largest value is returned; if
+     * no counter is larger than current_max, the returned value is current_max.
+     */
+    PairValue_t get_max(unsigned int angle, Counter_t current_max) const;
+
+    /// Returns the number of tiles allocated so far
+    std::size_t
+    n_tiles() const
+    {
+      return m_tiles.size() / TileSize;
+    }
+
+  private:
+    /// Offset of a tile in m_tiles (4 bytes keep the directory small)
+    using TileOffset_t = std::uint32_t;
+
+    static constexpr TileOffset_t NoTile = std::numeric_limits<TileOffset_t>::max();
+
+    Key_t m_keyMin = 0;             ///< lowest stored key
+    Key_t m_keyEnd = 0;             ///< first key not stored after m_keyMin
+    std::size_t m_nAngleTiles = 0;  ///< number of tiles along the angle
+    std::size_t m_nKeyTiles = 0;    ///< number of tiles along the distance
+    std::vector<TileOffset_t> m_tileIndex; ///< offset of each tile in m_tiles
+    std::vector<std::size_t> m_usedTiles;  ///< directory entries of m_tiles
+    std::vector<Counter_t> m_tiles;        ///< all the allocated tiles
+
+    std::size_t
+    tile_index(unsigned int angle, Key_t key) const
+    {
+      return (angle / ANGLEBLOCK) * m_nKeyTiles + (key - m_keyMin) / RHOBLOCK;
+    }
+
+    std::size_t
+    cell_offset(unsigned int angle, Key_t key) const
+    {
+      return (angle % ANGLEBLOCK) * RHOBLOCK + (key - m_keyMin) % RHOBLOCK;
+    }
+
+    /// Returns the first counter of the tile with (angle, key), allocating it
+    Counter_t*
+    get_tile(unsigned int angle, Key_t key)
+    {
+      TileOffset_t& tile = m_tileIndex[tile_index(angle, key)];
+      if (tile == NoTile) {
+        tile = m_tiles.size();
+        m_usedTiles.push_back(tile_index(angle, key));
+        m_tiles.resize(m_tiles.size() + TileSize, 0);
+      }
+      return m_tiles.data() + tile;
+    }
+
+    /// Adds whole tiles to the stored keys until [ key_begin, key_end [ is in
+    void extend(Key_t key_begin, Key_t key_end);
+
+    PairValue_t add_range_max(unsigned int angle,
+                              Key_t key_begin,
+                              Key_t key_end,
+                              Counter_t delta,
+                              Counter_t current_max);
+
+  }; // class HoughTransformTiledCounters
+
+  //----------------------------------------------------------------------------
+  template <typename C, unsigned int A, unsigned int R>
+  typename HoughTransformTiledCounters<C, A, R>::PairValue_t
+  HoughTransformTiledCounters<C, A, R>::get_max(unsigned int angle, Counter_t current_max) const
+  {
+    PairValue_t max{m_keyEnd, current_max};
+    TileOffset_t const* tiles = m_tileIndex.data() + (angle / A) * m_nKeyTiles;
+    for (std::size_t iTile = 0; iTile < m_nKeyTiles; ++iTile) {
+      if (tiles[iTile] == NoTile) continue;
+      Counter_t const* counters = m_tiles.data() + tiles[iTile] + (angle % A) * R;
+      for (unsigned int i = 0; i < R; ++i) {
+        if (counters[i] > max.second) max = {Key_t(m_keyMin + iTile * R + i), counters[i]};
+      }
+    } // for tiles
+    return max;
+  } // HoughTransformTiledCounters<>::get_max()
+
+  //----------------------------------------------------------------------------
+  template <typename C, unsigned int A, unsigned int R>
+  typename HoughTransformTiledCounters<C, A, R>::PairValue_t
+  HoughTransformTiledCounters<C, A, R>::add_range_max(unsigned int angle,
+                                                      Key_t key_begin,
+                                                      Key_t key_end,
+                                                      Counter_t delta,
+                                                      Counter_t current_max)
+  {
+    PairValue_t max{key_end, current_max};
+    if ((key_begin < key_end) && ((key_begin < m_keyMin) || (key_end > m_keyEnd)))
+      extend(key_begin, key_end);
+    Key_t key = key_begin;
+    Key_t const end = key_end;
+    while (key < end) {
+      // the range in this tile ends at its border or at the end of the range
+      Key_t const tile_end = std::min(end, Key_t(key + (R - (key - m_keyMin) % R)));
+      Counter_t* counter = get_tile(angle, key) + cell_offset(angle, key);
+      for (; key < tile_end; ++key, ++counter) {
+        Counter_t const value = (*counter += delta);
+        if (value > max.second) max = {key, value};
+      }
+    } // while
+    return max;
+  } // HoughTransformTiledCounters<>::add_range_max()
+
+  //----------------------------------------------------------------------------
+  template <typename C, unsigned int A, unsigned int R>
+  void
+  HoughTransformTiledCounters<C, A, R>::extend(Key_t key_begin, Key_t key_end)
+  {
+    Key_t const below =
+      (key_begin < m_keyMin) ? (m_keyMin - key_begin + Key_t(R) - 1) / Key_t(R) : 0;
+    Key_t const above =
+      (key_end > m_keyEnd) ? (key_end - m_keyEnd + Key_t(R) - 1) / Key_t(R) : 0;
+    std::size_t const nKeyTiles = m_nKeyTiles + below + above;
+
+    // the allocated tiles are moved to their place in the new directory
+    std::vector<TileOffset_t> tileIndex(m_nAngleTiles * nKeyTiles, NoTile);
+    for (std::size_t& index : m_usedTiles) {
+      std::size_t const newIndex = (index / m_nKeyTiles) * nKeyTiles + index % m_nKeyTiles + below;
+      tileIndex[newIndex] = m_tileIndex[index];
+      index = newIndex;
+    }
+    m_tileIndex = std::move(tileIndex);
+    m_nKeyTiles = nKeyTiles;
+    m_keyMin -= below * Key_t(R);
+    m_keyEnd += above * Key_t(R);
+  } // HoughTransformTiledCounters<>::extend()
+
   class HoughBaseAlg {
   public:
     /// Data structure collecting charge information to be filled in cluster
@@ -553,6 +819,10 @@ namespace cluster {
       fMissedHitsDistance; ///< Distance between hits in a hough line before a hit is considered missed
     float
       fMissedHitsToLineSize; ///< Ratio of missed hits to line size for a line to be considered a fake
+    bool fDenseAccumulator; ///< Use HoughTransformTiledCounters instead of the counter maps
+
+    /// Storage of the dense accumulator, reused by all the transforms
+    HoughTransformTiledCounters<signed char> fDenseAccum;
   };
 
 } // namespace
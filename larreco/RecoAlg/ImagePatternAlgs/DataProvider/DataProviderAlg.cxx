@@ -23,6 +23,8 @@ namespace geo {
 
 #include "CLHEP/Random/RandGauss.h"
 
+#include <algorithm>
+
 img::DataProviderAlg::DataProviderAlg(const Config& config)
   : fAlgView{}
   , fDownscaleMode(img::DataProviderAlg::kMax)
@@ -119,7 +121,9 @@ img::DataProviderAlg::resizeView(detinfo::DetectorClocksData const& clock_data,
 
   result.fWireChannels.resize(wires, raw::InvalidChannelID);
 
-  result.fWireDriftData.resize(wires, std::vector<float>(result.fNCachedDrifts, fAdcZero));
+  // take over the buffer of the previous view, so it is only reallocated when it grows
+  result.fWireDriftData = std::move(fAlgView.fWireDriftData);
+  result.fWireDriftData.assign(wires * result.fNCachedDrifts, fAdcZero);
 
   result.fLifetimeCorrFactors.resize(drifts);
   if (fCalibrateLifetime) {
@@ -155,7 +159,7 @@ img::DataProviderAlg::poolMax(int wire, int drift, size_t r) const
 
   float adc, max_adc = 0;
   for (int w = w0; w <= w1; ++w) {
-    auto const* col = fAlgView.fWireDriftData[w].data();
+    auto const* col = fAlgView.wireData(w);
     for (int d = d0; d <= d1; ++d) {
       adc = col[d];
       if (adc > max_adc) { max_adc = adc; }
@@ -188,42 +192,53 @@ img::DataProviderAlg::poolMax(int wire, int drift, size_t r) const
 //    return sum;
 //}
 // ------------------------------------------------------
-std::vector<float>
-img::DataProviderAlg::downscaleMax(std::size_t dst_size,
-                                   std::vector<float> const& adc,
+void
+img::DataProviderAlg::downscaleMax(float* dst,
+                                   std::size_t dst_size,
+                                   float const* adc,
+                                   std::size_t adc_size,
                                    size_t tick0) const
 {
   size_t kStop = dst_size;
-  std::vector<float> result(dst_size);
-  if (adc.size() < kStop) { kStop = adc.size(); }
+  if (adc_size < kStop) { kStop = adc_size; }
+  // windows past the lifetime corrections are left empty, as in downscaleMean()
+  size_t const nCorr = fAlgView.fLifetimeCorrFactors.size();
+  size_t const kCorr = (tick0 < nCorr) ? nCorr - tick0 : 0;
+  kStop = std::min(kStop, (kCorr + fDriftWindow - 1) / fDriftWindow);
+  float const* lifetime = fAlgView.fLifetimeCorrFactors.data() + tick0;
   for (size_t i = 0, k0 = 0; i < kStop; ++i, k0 += fDriftWindow) {
-    size_t k1 = k0 + fDriftWindow;
+    size_t k1 = std::min(k0 + fDriftWindow, kCorr);
 
-    float max_adc = adc[k0] * fAlgView.fLifetimeCorrFactors[k0 + tick0];
+    float max_adc = adc[k0] * lifetime[k0];
     for (size_t k = k0 + 1; k < k1; ++k) {
-      float ak = adc[k] * fAlgView.fLifetimeCorrFactors[k + tick0];
-      if (ak > max_adc) max_adc = ak;
+      max_adc = std::max(max_adc, adc[k] * lifetime[k]);
     }
-    result[i] = max_adc;
+    dst[i] = max_adc;
   }
-  scaleAdcSamples(result);
-  return result;
+  std::fill(dst + kStop, dst + dst_size, 0.F);
+  scaleAdcSamples(dst, dst_size);
 }
 
-std::vector<float>
-img::DataProviderAlg::downscaleMaxMean(std::size_t dst_size,
-                                       std::vector<float> const& adc,
+void
+img::DataProviderAlg::downscaleMaxMean(float* dst,
+                                       std::size_t dst_size,
+                                       float const* adc,
+                                       std::size_t adc_size,
                                        size_t tick0) const
 {
   size_t kStop = dst_size;
-  std::vector<float> result(dst_size);
-  if (adc.size() < kStop) { kStop = adc.size(); }
+  if (adc_size < kStop) { kStop = adc_size; }
+  // windows past the lifetime corrections are left empty, as in downscaleMean()
+  size_t const nCorr = fAlgView.fLifetimeCorrFactors.size();
+  size_t const kCorr = (tick0 < nCorr) ? nCorr - tick0 : 0;
+  kStop = std::min(kStop, (kCorr + fDriftWindow - 1) / fDriftWindow);
+  float const* lifetime = fAlgView.fLifetimeCorrFactors.data() + tick0;
   for (size_t i = 0, k0 = 0; i < kStop; ++i, k0 += fDriftWindow) {
-    size_t k1 = k0 + fDriftWindow;
+    size_t k1 = std::min(k0 + fDriftWindow, kCorr);
     size_t max_idx = k0;
-    float max_adc = adc[k0] * fAlgView.fLifetimeCorrFactors[k0 + tick0];
+    float max_adc = adc[k0] * lifetime[k0];
     for (size_t k = k0 + 1; k < k1; ++k) {
-      float ak = adc[k] * fAlgView.fLifetimeCorrFactors[k + tick0];
+      float ak = adc[k] * lifetime[k];
       if (ak > max_adc) {
         max_adc = ak;
         max_idx = k;
@@ -232,63 +247,88 @@ img::DataProviderAlg::downscaleMaxMean(std::size_t dst_size,
 
     size_t n = 1;
     if (max_idx > 0) {
-      max_adc += adc[max_idx - 1] * fAlgView.fLifetimeCorrFactors[max_idx - 1 + tick0];
+      max_adc += adc[max_idx - 1] * lifetime[max_idx - 1];
       n++;
     }
-    if (max_idx + 1 < adc.size()) {
-      max_adc += adc[max_idx + 1] * fAlgView.fLifetimeCorrFactors[max_idx + 1 + tick0];
+    if (max_idx + 1 < std::min(adc_size, kCorr)) {
+      max_adc += adc[max_idx + 1] * lifetime[max_idx + 1];
       n++;
     }
 
-    result[i] = max_adc / n;
+    dst[i] = max_adc / n;
   }
-  scaleAdcSamples(result);
-  return result;
+  std::fill(dst + kStop, dst + dst_size, 0.F);
+  scaleAdcSamples(dst, dst_size);
 }
 
-std::vector<float>
-img::DataProviderAlg::downscaleMean(std::size_t dst_size,
-                                    std::vector<float> const& adc,
+void
+img::DataProviderAlg::downscaleMean(float* dst,
+                                    std::size_t dst_size,
+                                    float const* adc,
+                                    std::size_t adc_size,
                                     size_t tick0) const
 {
   size_t kStop = dst_size;
-  std::vector<float> result(dst_size);
-  if (adc.size() < kStop) { kStop = adc.size(); }
+  if (adc_size < kStop) { kStop = adc_size; }
+  // samples past the lifetime corrections are left out of the mean
+  size_t const nCorr = fAlgView.fLifetimeCorrFactors.size();
+  size_t const kCorr = (tick0 < nCorr) ? nCorr - tick0 : 0;
+  float const* lifetime = fAlgView.fLifetimeCorrFactors.data() + tick0;
   for (size_t i = 0, k0 = 0; i < kStop; ++i, k0 += fDriftWindow) {
-    size_t k1 = k0 + fDriftWindow;
+    size_t k1 = std::min(k0 + fDriftWindow, kCorr);
 
     float sum_adc = 0;
     for (size_t k = k0; k < k1; ++k) {
-      if (k + tick0 < fAlgView.fLifetimeCorrFactors.size())
-        sum_adc += adc[k] * fAlgView.fLifetimeCorrFactors[k + tick0];
+      sum_adc += adc[k] * lifetime[k];
     }
-    result[i] = sum_adc * fDriftWindowInv;
+    dst[i] = sum_adc * fDriftWindowInv;
   }
-  scaleAdcSamples(result);
-  return result;
+  std::fill(dst + kStop, dst + dst_size, 0.F);
+  scaleAdcSamples(dst, dst_size);
 }
 
-std::optional<std::vector<float>>
-img::DataProviderAlg::setWireData(std::vector<float> const& adc, size_t wireIdx) const
+bool
+img::DataProviderAlg::fillWireData(std::vector<float> const& adc, size_t wireIdx)
 {
-  if (wireIdx >= fAlgView.fWireDriftData.size()) return std::nullopt;
-  auto& wData = fAlgView.fWireDriftData[wireIdx];
+  if ((wireIdx >= fAlgView.fNWires) || adc.empty()) return false;
+  float* wData = fAlgView.wireData(wireIdx);
 
   if (fDownscaleFullView) {
-    if (!adc.empty()) { return downscale(wData.size(), adc, 0); }
-    else {
-      return std::nullopt;
-    }
+    downscale(wData, fAlgView.fNCachedDrifts, adc.data(), adc.size(), 0);
   }
   else {
-    if (adc.empty()) { return std::nullopt; }
-    else if (adc.size() <= wData.size())
-      return adc;
-    else {
-      return std::vector<float>(adc.begin(), adc.begin() + wData.size());
+    std::copy_n(adc.data(), std::min<size_t>(adc.size(), fAlgView.fNCachedDrifts), wData);
+  }
+  return true;
+}
+
+std::optional<std::vector<float>>
+img::DataProviderAlg::setWireData(std::vector<float> const& adc, size_t wireIdx) const
+{
+  if ((wireIdx >= fAlgView.fNWires) || adc.empty()) return std::nullopt;
+
+  if (fDownscaleFullView) { return downscale(fAlgView.fNCachedDrifts, adc, 0); }
+  else {
+    return std::vector<float>(
+      adc.begin(), adc.begin() + std::min<size_t>(adc.size(), fAlgView.fNCachedDrifts));
+  }
+}
+// ------------------------------------------------------
+
+void
+img::DataProviderAlg::getPatches(std::vector<std::pair<size_t, float>> const& centers,
+                                 size_t patchSizeW,
+                                 size_t patchSizeD,
+                                 std::vector<float>& patches) const
+{
+  size_t const patchSize = patchSizeW * patchSizeD;
+  patches.assign(centers.size() * patchSize, fAdcZero);
+  for (size_t i = 0; i < centers.size(); ++i) {
+    PatchView const patch{patches.data() + i * patchSize, patchSizeD};
+    if (!getPatch(centers[i].first, centers[i].second, patchSizeW, patchSizeD, patch)) {
+      throw cet::exception("img::DataProviderAlg") << "Patch filling failed." << std::endl;
     }
   }
-  return std::make_optional(wData);
 }
 // ------------------------------------------------------
 
@@ -333,12 +373,10 @@ img::DataProviderAlg::setWireDriftData(detinfo::DetectorClocksData const& clock_
           mf::LogWarning("DataProviderAlg") << "Wire ADC vector size lower than NumberTimeSamples.";
           continue; // not critical, maybe other wires are OK, so continue
         }
-        auto wire_data = setWireData(adc, w_idx);
-        if (!wire_data) {
+        if (!fillWireData(adc, w_idx)) {
           mf::LogWarning("DataProviderAlg") << "Wire data not set.";
           continue; // also not critical, try to set other wires
         }
-        fAlgView.fWireDriftData[w_idx] = *wire_data;
         for (auto v : adc) {
           if (v >= fAdcSumThr) {
             fAdcSumOverThr += v;
@@ -381,12 +419,11 @@ img::DataProviderAlg::scaleAdcSample(float val) const
 }
 // ------------------------------------------------------
 void
-img::DataProviderAlg::scaleAdcSamples(std::vector<float>& values) const
+img::DataProviderAlg::scaleAdcSamples(float* data, size_t size) const
 {
   float calib = fAmplCalibConst[fPlane];
-  auto* data = values.data();
 
-  size_t k = 0, size4 = values.size() >> 2, size = values.size();
+  size_t k = 0, size4 = size >> 2;
   for (size_t i = 0; i < size4; ++i) // vectorize if you can
   {
     data[k] *= calib; // prescale by plane-to-plane calibration factors
@@ -428,18 +465,20 @@ img::DataProviderAlg::applyBlur()
   size_t margin_left = (fBlurKernel.size() - 1) >> 1,
          margin_right = fBlurKernel.size() - margin_left - 1;
 
-  std::vector<std::vector<float>> src(fAlgView.fWireDriftData.size());
-  for (size_t w = 0; w < fAlgView.fWireDriftData.size(); ++w) {
-    src[w] = fAlgView.fWireDriftData[w];
-  }
+  size_t nwires = fAlgView.fNWires, ndrifts = fAlgView.fNCachedDrifts;
+  if (nwires < fBlurKernel.size()) return;
 
-  for (size_t w = margin_left; w < fAlgView.fWireDriftData.size() - margin_right; ++w) {
-    for (size_t d = 0; d < fAlgView.fWireDriftData[w].size(); ++d) {
-      float sum = 0;
-      for (size_t i = 0; i < fBlurKernel.size(); ++i) {
-        sum += fBlurKernel[i] * src[w + i - margin_left][d];
+  std::vector<float> const src(fAlgView.fWireDriftData);
+
+  for (size_t w = margin_left; w < nwires - margin_right; ++w) {
+    float* dst = fAlgView.wireData(w);
+    std::fill(dst, dst + ndrifts, 0.F);
+    for (size_t i = 0; i < fBlurKernel.size(); ++i) {
+      float const weight = fBlurKernel[i];
+      float const* col = src.data() + (w + i - margin_left) * ndrifts;
+      for (size_t d = 0; d < ndrifts; ++d) {
+        dst[d] += weight * col[d];
       }
-      fAlgView.fWireDriftData[w][d] = sum;
     }
   }
 }
@@ -451,7 +490,7 @@ img::DataProviderAlg::patchFromDownsampledView(size_t wire,
                                                float drift,
                                                size_t size_w,
                                                size_t size_d,
-                                               std::vector<std::vector<float>>& patch) const
+                                               PatchView patch) const
 {
   int halfSizeW = size_w / 2;
   int halfSizeD = size_d / 2;
@@ -463,21 +502,29 @@ img::DataProviderAlg::patchFromDownsampledView(size_t wire,
   int d0 = sd - halfSizeD;
   int d1 = sd + halfSizeD;
 
-  int wsize = fAlgView.fWireDriftData.size();
+  int wsize = fAlgView.fNWires;
+  int dsize = fAlgView.fNCachedDrifts;
   for (int w = w0, wpatch = 0; w < w1; ++w, ++wpatch) {
-    auto& dst = patch[wpatch];
+    float* dst = patch[wpatch];
     if ((w >= 0) && (w < wsize)) {
-      auto& src = fAlgView.fWireDriftData[w];
-      int dsize = src.size();
-      for (int d = d0, dpatch = 0; d < d1; ++d, ++dpatch) {
-        if ((d >= 0) && (d < dsize)) { dst[dpatch] = src[d]; }
-        else {
-          dst[dpatch] = fAdcZero;
-        }
+      float const* src = fAlgView.wireData(w);
+      // zero level before and after the view, the pixels of the wire in between
+      int d = d0, dpatch = 0;
+      for (; (d < 0) && (d < d1); ++d, ++dpatch) {
+        dst[dpatch] = fAdcZero;
+      }
+      int dcopy = std::min(d1, dsize);
+      if (d < dcopy) {
+        std::copy(src + d, src + dcopy, dst + dpatch);
+        dpatch += dcopy - d;
+        d = dcopy;
+      }
+      for (; d < d1; ++d, ++dpatch) {
+        dst[dpatch] = fAdcZero;
       }
     }
     else {
-      std::fill(dst.begin(), dst.end(), fAdcZero);
+      std::fill(dst, dst + size_d, fAdcZero);
     }
   }
 
@@ -489,7 +536,7 @@ img::DataProviderAlg::patchFromOriginalView(size_t wire,
                                             float drift,
                                             size_t size_w,
                                             size_t size_d,
-                                            std::vector<std::vector<float>>& patch) const
+                                            PatchView patch) const
 {
   int dsize = fDriftWindow * size_d;
   int halfSizeW = size_w / 2;
@@ -503,12 +550,14 @@ img::DataProviderAlg::patchFromOriginalView(size_t wire,
 
   if (d0 < 0) d0 = 0;
 
-  std::vector<float> tmp(dsize);
-  int wsize = fAlgView.fWireDriftData.size();
+  // samples of one wire, kept from one call to the next to spare the allocation
+  thread_local std::vector<float> tmp;
+  tmp.assign(dsize, 0);
+  int wsize = fAlgView.fNWires;
+  int src_size = fAlgView.fNCachedDrifts;
   for (int w = w0, wpatch = 0; w < w1; ++w, ++wpatch) {
     if ((w >= 0) && (w < wsize)) {
-      auto& src = fAlgView.fWireDriftData[w];
-      int src_size = src.size();
+      float const* src = fAlgView.wireData(w);
       for (int d = d0, dpatch = 0; d < d1; ++d, ++dpatch) {
         if ((d >= 0) && (d < src_size)) { tmp[dpatch] = src[d]; }
         else {
@@ -519,11 +568,54 @@ img::DataProviderAlg::patchFromOriginalView(size_t wire,
     else {
       std::fill(tmp.begin(), tmp.end(), fAdcZero);
     }
-    patch[wpatch] = downscale(patch[wpatch].size(), tmp, d0);
+    downscale(patch[wpatch], size_d, tmp.data(), tmp.size(), d0);
   }
 
   return true;
 }
+
+bool
+img::DataProviderAlg::patchFromDownsampledView(size_t wire,
+                                               float drift,
+                                               size_t size_w,
+                                               size_t size_d,
+                                               std::vector<std::vector<float>>& patch) const
+{
+  std::vector<float> buffer(size_w * size_d, fAdcZero);
+  if (!patchFromDownsampledView(wire, drift, size_w, size_d, PatchView{buffer.data(), size_d})) {
+    return false;
+  }
+  copyPatchRows(buffer, size_w, size_d, patch);
+  return true;
+}
+
+bool
+img::DataProviderAlg::patchFromOriginalView(size_t wire,
+                                            float drift,
+                                            size_t size_w,
+                                            size_t size_d,
+                                            std::vector<std::vector<float>>& patch) const
+{
+  std::vector<float> buffer(size_w * size_d, fAdcZero);
+  if (!patchFromOriginalView(wire, drift, size_w, size_d, PatchView{buffer.data(), size_d})) {
+    return false;
+  }
+  copyPatchRows(buffer, size_w, size_d, patch);
+  return true;
+}
+
+void
+img::DataProviderAlg::copyPatchRows(std::vector<float> const& buffer,
+                                    size_t size_w,
+                                    size_t size_d,
+                                    std::vector<std::vector<float>>& patch) const
+{
+  // only the rows filled by the patch functions, the others are left as they were
+  size_t const nrows = std::min(2 * (size_w / 2), patch.size());
+  for (size_t w = 0; w < nrows; ++w) {
+    patch[w].assign(buffer.begin() + w * size_d, buffer.begin() + (w + 1) * size_d);
+  }
+}
 // ------------------------------------------------------
 
 void
@@ -536,9 +628,10 @@ img::DataProviderAlg::addWhiteNoise()
 
   CLHEP::RandGauss gauss(fRndEngine);
   std::vector<double> noise(fAlgView.fNCachedDrifts);
-  for (auto& wire : fAlgView.fWireDriftData) {
+  for (size_t w = 0; w < fAlgView.fNWires; ++w) {
     gauss.fireArray(fAlgView.fNCachedDrifts, noise.data(), 0., effectiveSigma);
-    for (size_t d = 0; d < wire.size(); ++d) {
+    float* wire = fAlgView.wireData(w);
+    for (size_t d = 0; d < fAlgView.fNCachedDrifts; ++d) {
       wire[d] += noise[d];
     }
   }
@@ -554,21 +647,21 @@ img::DataProviderAlg::addCoherentNoise()
   if (fDownscaleFullView) effectiveSigma /= fDriftWindow;
 
   CLHEP::RandGauss gauss(fRndEngine);
-  std::vector<double> amps1(fAlgView.fWireDriftData.size());
-  std::vector<double> amps2(1 + (fAlgView.fWireDriftData.size() / 32));
+  std::vector<double> amps1(fAlgView.fNWires);
+  std::vector<double> amps2(1 + (fAlgView.fNWires / 32));
   gauss.fireArray(amps1.size(), amps1.data(), 1., 0.1); // 10% wire-wire ampl. variation
   gauss.fireArray(amps2.size(), amps2.data(), 1., 0.1); // 10% group-group ampl. variation
 
   double group_amp = 1.0;
   std::vector<double> noise(fAlgView.fNCachedDrifts);
-  for (size_t w = 0; w < fAlgView.fWireDriftData.size(); ++w) {
+  for (size_t w = 0; w < fAlgView.fNWires; ++w) {
     if ((w & 31) == 0) {
       group_amp = amps2[w >> 5]; // div by 32
       gauss.fireArray(fAlgView.fNCachedDrifts, noise.data(), 0., effectiveSigma);
     } // every 32 wires
 
-    auto& wire = fAlgView.fWireDriftData[w];
-    for (size_t d = 0; d < wire.size(); ++d) {
+    float* wire = fAlgView.wireData(w);
+    for (size_t d = 0; d < fAlgView.fNCachedDrifts; ++d) {
       wire[d] += group_amp * amps1[w] * noise[d];
     }
   }
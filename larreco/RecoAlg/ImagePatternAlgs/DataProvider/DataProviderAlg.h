@@ -28,6 +28,9 @@
 
 // ROOT & C++
 #include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
 namespace detinfo {
   class DetectorClocksData;
@@ -42,8 +45,23 @@ namespace img {
     unsigned int fNScaledDrifts;
     unsigned int fNCachedDrifts;
     std::vector<raw::ChannelID_t> fWireChannels;
-    std::vector<std::vector<float>> fWireDriftData;
+    /// Pixels of all the wires, row-major: the fNCachedDrifts pixels of
+    /// wire w start at w * fNCachedDrifts. This used to be one vector per
+    /// wire (std::vector<std::vector<float>>); code indexing it as
+    /// fWireDriftData[w][d] has to use wireData(w)[d] instead.
+    std::vector<float> fWireDriftData;
     std::vector<float> fLifetimeCorrFactors;
+
+    float*
+    wireData(size_t w)
+    {
+      return fWireDriftData.data() + w * fNCachedDrifts;
+    }
+    float const*
+    wireData(size_t w) const
+    {
+      return fWireDriftData.data() + w * fNCachedDrifts;
+    }
   };
 }
 
@@ -55,6 +73,19 @@ class img::DataProviderAlg {
 public:
   enum EDownscaleMode { kMax = 1, kMaxMean = 2, kMean = 3 };
 
+  /// Patch in memory owned by the caller: the pixels of each wire are
+  /// contiguous, and the wires are `stride` pixels apart.
+  struct PatchView {
+    float* data;
+    size_t stride;
+
+    float*
+    operator[](size_t w) const
+    {
+      return data + w * stride;
+    }
+  };
+
   struct Config {
     using Name = fhicl::Name;
     using Comment = fhicl::Comment;
@@ -107,10 +138,33 @@ public:
                         unsigned int tpc,
                         unsigned int cryo);
 
-  std::vector<float> const&
+  /// The NCachedDrifts() pixels of the wire.
+  float const*
+  wirePixels(size_t widx) const
+  {
+    return fAlgView.wireData(widx);
+  }
+
+  /// Copy of the pixels of the wire.
+  /// @deprecated Kept for the code written when each wire had its own vector;
+  /// it allocates on each call, use wirePixels() instead.
+  std::vector<float>
   wireData(size_t widx) const
   {
-    return fAlgView.fWireDriftData[widx];
+    float const* pixels = wirePixels(widx);
+    return std::vector<float>(pixels, pixels + fAlgView.fNCachedDrifts);
+  }
+
+  /// Fill the patch of data centered on the wire and drift, with the size in (downscaled) pixels
+  /// given with patchSizeW and patchSizeD, into memory provided by the caller. Pad with the
+  /// zero-level value if patch extends beyond the event projection.
+  bool
+  getPatch(size_t wire, float drift, size_t patchSizeW, size_t patchSizeD, PatchView patch) const
+  {
+    if (fDownscaleFullView)
+      return patchFromDownsampledView(wire, drift, patchSizeW, patchSizeD, patch);
+    else
+      return patchFromOriginalView(wire, drift, patchSizeW, patchSizeD, patch);
   }
 
   /// Return patch of data centered on the wire and drift, witht the size in (downscaled) pixels givent
@@ -119,20 +173,25 @@ public:
   std::vector<std::vector<float>>
   getPatch(size_t wire, float drift, size_t patchSizeW, size_t patchSizeD) const
   {
-    bool ok = false;
-    std::vector<std::vector<float>> patch;
-    if (fDownscaleFullView) {
-      ok = patchFromDownsampledView(wire, drift, patchSizeW, patchSizeD, patch);
-    }
-    else {
-      ok = patchFromOriginalView(wire, drift, patchSizeW, patchSizeD, patch);
-    }
+    std::vector<float> buffer(patchSizeW * patchSizeD, fAdcZero);
+    if (!getPatch(wire, drift, patchSizeW, patchSizeD, PatchView{buffer.data(), patchSizeD}))
+      throw cet::exception("img::DataProviderAlg") << "Patch filling failed." << std::endl;
 
-    if (ok)
-      return patch;
-    throw cet::exception("img::DataProviderAlg") << "Patch filling failed." << std::endl;
+    std::vector<std::vector<float>> patch(patchSizeW);
+    for (size_t w = 0; w < patchSizeW; ++w) {
+      patch[w].assign(buffer.begin() + w * patchSizeD, buffer.begin() + (w + 1) * patchSizeD);
+    }
+    return patch;
   }
 
+  /// Fill the patches centered on each of the (wire, drift) pairs, one after the other in
+  /// `patches`, each stored as in getPatch() with a stride of patchSizeD. The vector is
+  /// resized, so that it can be reused from one call to the next without new allocations.
+  void getPatches(std::vector<std::pair<size_t, float>> const& centers,
+                  size_t patchSizeW,
+                  size_t patchSizeD,
+                  std::vector<float>& patches) const;
+
   /// Return value from the ADC buffer, or zero if coordinates are out of the view;
   /// will scale the drift according to the downscale settings.
   float
@@ -140,8 +199,8 @@ public:
   {
     size_t didx = getDriftIndex(drift), widx = (size_t)wire;
 
-    if ((widx < fAlgView.fWireDriftData.size()) && (didx < fAlgView.fNCachedDrifts)) {
-      return fAlgView.fWireDriftData[widx][didx];
+    if ((widx < fAlgView.fNWires) && (didx < fAlgView.fNCachedDrifts)) {
+      return fAlgView.wireData(widx)[didx];
     }
       return 0;
   }
@@ -224,25 +283,44 @@ protected:
   bool fDownscaleFullView;
   float fDriftWindowInv;
 
-  std::vector<float> downscaleMax(std::size_t dst_size,
-                                  std::vector<float> const& adc,
-                                  size_t tick0) const;
-  std::vector<float> downscaleMaxMean(std::size_t dst_size,
-                                      std::vector<float> const& adc,
-                                      size_t tick0) const;
-  std::vector<float> downscaleMean(std::size_t dst_size,
-                                   std::vector<float> const& adc,
-                                   size_t tick0) const;
-  std::vector<float>
-  downscale(std::size_t dst_size, std::vector<float> const& adc, size_t tick0) const
+  // The downscaling functions write dst_size pixels to dst, from the adc_size samples of adc
+  void downscaleMax(float* dst,
+                    std::size_t dst_size,
+                    float const* adc,
+                    std::size_t adc_size,
+                    size_t tick0) const;
+  void downscaleMaxMean(float* dst,
+                        std::size_t dst_size,
+                        float const* adc,
+                        std::size_t adc_size,
+                        size_t tick0) const;
+  void downscaleMean(float* dst,
+                     std::size_t dst_size,
+                     float const* adc,
+                     std::size_t adc_size,
+                     size_t tick0) const;
+  void
+  downscale(float* dst,
+            std::size_t dst_size,
+            float const* adc,
+            std::size_t adc_size,
+            size_t tick0) const
   {
     switch (fDownscaleMode) {
-    case img::DataProviderAlg::kMean: return downscaleMean(dst_size, adc, tick0);
-    case img::DataProviderAlg::kMaxMean: return downscaleMaxMean(dst_size, adc, tick0);
-    case img::DataProviderAlg::kMax: return downscaleMax(dst_size, adc, tick0);
+    case img::DataProviderAlg::kMean: return downscaleMean(dst, dst_size, adc, adc_size, tick0);
+    case img::DataProviderAlg::kMaxMean:
+      return downscaleMaxMean(dst, dst_size, adc, adc_size, tick0);
+    case img::DataProviderAlg::kMax: return downscaleMax(dst, dst_size, adc, adc_size, tick0);
     }
     throw cet::exception("img::DataProviderAlg") << "Downscale mode not supported." << std::endl;
   }
+  std::vector<float>
+  downscale(std::size_t dst_size, std::vector<float> const& adc, size_t tick0) const
+  {
+    std::vector<float> result(dst_size);
+    downscale(result.data(), dst_size, adc.data(), adc.size(), tick0);
+    return result;
+  }
 
   size_t
   getDriftIndex(float drift) const
@@ -253,9 +331,27 @@ protected:
       return (size_t)drift;
   }
 
+  /// Fill the pixels of the wire from its ADC samples; false if there are none to use.
+  bool fillWireData(std::vector<float> const& adc, size_t wireIdx);
+
+  /// Pixels the wire would get from its ADC samples, without storing them.
+  /// @deprecated Use fillWireData(), which writes the pixels in place.
   std::optional<std::vector<float>> setWireData(std::vector<float> const& adc,
                                                 size_t wireIdx) const;
 
+  bool patchFromDownsampledView(size_t wire,
+                                float drift,
+                                size_t size_w,
+                                size_t size_d,
+                                PatchView patch) const;
+  bool patchFromOriginalView(size_t wire,
+                             float drift,
+                             size_t size_w,
+                             size_t size_d,
+                             PatchView patch) const;
+
+  /// @deprecated Use the PatchView overloads, these copy the patch row by row
+  /// into vectors of size_d pixels.
   bool patchFromDownsampledView(size_t wire,
                                 float drift,
                                 size_t size_w,
@@ -279,8 +375,12 @@ protected:
   geo::GeometryCore const* fGeometry;
 
 private:
+  void copyPatchRows(std::vector<float> const& buffer,
+                     size_t size_w,
+                     size_t size_d,
+                     std::vector<std::vector<float>>& patch) const;
   float scaleAdcSample(float val) const;
-  void scaleAdcSamples(std::vector<float>& values) const;
+  void scaleAdcSamples(float* values, size_t size) const;
   std::vector<float> fAmplCalibConst;
   bool fCalibrateAmpl, fCalibrateLifetime;
   unsigned int fCryo = 9999, fTPC = 9999, fPlane = 9999;
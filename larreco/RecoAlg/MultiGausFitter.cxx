@@ -0,0 +1,285 @@
+/**
+ * @file   MultiGausFitter.cxx
+ * @brief  Levenberg-Marquardt fit of a sum of Gaussians, without ROOT
+ * @see    MultiGausFitter.h
+ */
+
+// Library header
+#include "larreco/RecoAlg/MultiGausFitter.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min(), std::max(), std::fill_n()
+#include <cmath> // std::exp(), std::sqrt(), std::isfinite()
+
+namespace {
+
+  using Params_t = hit::MultiGausFitter::Parameters_t;
+  using ParamArray_t = hit::MultiGausFitter::ParamArray_t;
+
+  constexpr std::size_t MaxParams = hit::MultiGausFitter::MaxParams;
+
+  /// Square matrix of the largest size, stored row-major
+  using Matrix_t = std::array<double, MaxParams * MaxParams>;
+
+  /// Gaussians are considered null beyond this squared distance (in sigma)
+  constexpr double MaxZ2 = 64.;
+
+  /// Damping beyond which no improvement is expected any more
+  constexpr double MaxLambda = 1e10;
+
+  template <typename T>
+  inline T sqr(T v) { return v*v; }
+
+
+  //----------------------------------------------------------------------------
+  /// Fills `deriv` with the derivatives of the model at `x`, returns the model
+  double EvaluateWithDerivatives
+    (Params_t const& params, double x, ParamArray_t& deriv)
+  {
+    double value = params.value[params.BaselineIndex()];
+    for (std::size_t iGaus = 0; iGaus < params.nGaus; ++iGaus) {
+      std::size_t const iPar = 3 * iGaus;
+      double const sigma = params.value[iPar + 2];
+      double const z = (x - params.value[iPar + 1]) / sigma;
+      double const z2 = sqr(z);
+      if (z2 > MaxZ2) {
+        deriv[iPar] = deriv[iPar + 1] = deriv[iPar + 2] = 0.;
+        continue;
+      }
+      double const e = std::exp(-0.5 * z2);
+      double const g = params.value[iPar] * e;
+      deriv[iPar]     = e;              // d/d(amplitude)
+      deriv[iPar + 1] = g * z / sigma;  // d/d(mean)
+      deriv[iPar + 2] = g * z2 / sigma; // d/d(sigma)
+      value += g;
+    } // for
+    if (params.floatBaseline) deriv[params.BaselineIndex()] = 1.;
+    return value;
+  } // EvaluateWithDerivatives()
+
+
+  //----------------------------------------------------------------------------
+  /// Returns the sum of squared residuals of the model on the samples
+  double ComputeChi2(float const* begin, float const* end, Params_t const& params)
+  {
+    double chi2 = 0.;
+    double x = 0.5;
+    for (float const* y = begin; y != end; ++y, x += 1.)
+      chi2 += sqr(*y - hit::MultiGausFitter::Evaluate(params, x));
+    return chi2;
+  } // ComputeChi2()
+
+
+  //----------------------------------------------------------------------------
+  /// Fills curvature matrix (J^T J) and gradient (J^T r); returns chi^2
+  double BuildNormalEquations(
+    float const* begin, float const* end, Params_t const& params,
+    Matrix_t& alpha, ParamArray_t& beta
+  ) {
+    std::size_t const nPar = params.NParams();
+    std::fill_n(alpha.begin(), nPar * MaxParams, 0.);
+    std::fill_n(beta.begin(), nPar, 0.);
+
+    ParamArray_t deriv;
+    double chi2 = 0.;
+    double x = 0.5;
+    for (float const* y = begin; y != end; ++y, x += 1.) {
+      double const residual = *y - EvaluateWithDerivatives(params, x, deriv);
+      chi2 += sqr(residual);
+      for (std::size_t i = 0; i < nPar; ++i) {
+        double const d = deriv[i];
+        if (d == 0.) continue;
+        beta[i] += d * residual;
+        double* row = alpha.data() + i * MaxParams;
+        for (std::size_t j = i; j < nPar; ++j) row[j] += d * deriv[j];
+      } // for i
+    } // for samples
+
+    // the matrix is symmetric: copy the upper triangle into the lower one
+    for (std::size_t i = 1; i < nPar; ++i)
+      for (std::size_t j = 0; j < i; ++j)
+        alpha[i * MaxParams + j] = alpha[j * MaxParams + i];
+
+    return chi2;
+  } // BuildNormalEquations()
+
+
+  //----------------------------------------------------------------------------
+  /// Cholesky decomposition in place (lower triangle); false if not positive
+  bool CholeskyDecompose(Matrix_t& A, std::size_t n)
+  {
+    for (std::size_t j = 0; j < n; ++j) {
+      double* rowJ = A.data() + j * MaxParams;
+      double diag = rowJ[j];
+      for (std::size_t k = 0; k < j; ++k) diag -= sqr(rowJ[k]);
+      if (!(diag > 0.)) return false;
+      diag = std::sqrt(diag);
+      rowJ[j] = diag;
+      for (std::size_t i = j + 1; i < n; ++i) {
+        double* rowI = A.data() + i * MaxParams;
+        double sum = rowI[j];
+        for (std::size_t k = 0; k < j; ++k) sum -= rowI[k] * rowJ[k];
+        rowI[j] = sum / diag;
+      } // for i
+    } // for j
+    return true;
+  } // CholeskyDecompose()
+
+
+  //----------------------------------------------------------------------------
+  /// Solves L L^T x = b in place, with L from `CholeskyDecompose()`
+  void CholeskySolve(Matrix_t const& L, std::size_t n, ParamArray_t& b)
+  {
+    for (std::size_t i = 0; i < n; ++i) {
+      double const* row = L.data() + i * MaxParams;
+      double sum = b[i];
+      for (std::size_t k = 0; k < i; ++k) sum -= row[k] * b[k];
+      b[i] = sum / row[i];
+    } // for
+    for (std::size_t i = n; i-- > 0;) {
+      double sum = b[i];
+      for (std::size_t k = i + 1; k < n; ++k) sum -= L[k * MaxParams + i] * b[k];
+      b[i] = sum / L[i * MaxParams + i];
+    } // for
+  } // CholeskySolve()
+
+
+  //----------------------------------------------------------------------------
+  /// Moves the parameters inside their limits (lower limit wins if swapped)
+  void ClampToLimits(Params_t& params) {
+    for (std::size_t i = 0; i < params.NParams(); ++i) {
+      params.value[i] = std::max
+        (params.lower[i], std::min(params.value[i], params.upper[i]));
+    }
+  } // ClampToLimits()
+
+} // local namespace
+
+
+namespace hit {
+
+  //----------------------------------------------------------------------------
+  //--- MultiGausFitter::Parameters_t
+  //---
+  void MultiGausFitter::Parameters_t::SetGaussian(
+    std::size_t iGaus,
+    double amplitude, double ampMin, double ampMax,
+    double mean, double meanMin, double meanMax,
+    double sigma, double sigmaMin, double sigmaMax
+  ) {
+    std::size_t const iPar = 3 * iGaus;
+    value[iPar]     = amplitude;
+    lower[iPar]     = ampMin;
+    upper[iPar]     = ampMax;
+    value[iPar + 1] = mean;
+    lower[iPar + 1] = meanMin;
+    upper[iPar + 1] = meanMax;
+    value[iPar + 2] = sigma;
+    lower[iPar + 2] = sigmaMin;
+    upper[iPar + 2] = sigmaMax;
+  } // MultiGausFitter::Parameters_t::SetGaussian()
+
+
+  //----------------------------------------------------------------------------
+  void MultiGausFitter::Parameters_t::SetBaseline
+    (double baseline, double minBaseline, double maxBaseline)
+  {
+    value[BaselineIndex()] = baseline;
+    lower[BaselineIndex()] = minBaseline;
+    upper[BaselineIndex()] = maxBaseline;
+  } // MultiGausFitter::Parameters_t::SetBaseline()
+
+
+  //----------------------------------------------------------------------------
+  //--- MultiGausFitter
+  //---
+  MultiGausFitter::MultiGausFitter
+    (unsigned int maxIterations, double chi2Tolerance)
+    : fMaxIterations(maxIterations)
+    , fChi2Tolerance(chi2Tolerance)
+    {}
+
+
+  //----------------------------------------------------------------------------
+  double MultiGausFitter::Evaluate(Parameters_t const& params, double x) {
+    double value = params.value[params.BaselineIndex()];
+    for (std::size_t iPar = 0; iPar < 3 * params.nGaus; iPar += 3) {
+      double const z2 = sqr((x - params.value[iPar + 1]) / params.value[iPar + 2]);
+      if (z2 <= MaxZ2) value += params.value[iPar] * std::exp(-0.5 * z2);
+    } // for
+    return value;
+  } // MultiGausFitter::Evaluate()
+
+
+  //----------------------------------------------------------------------------
+  MultiGausFitter::FitResult_t MultiGausFitter::Fit
+    (float const* begin, float const* end, Parameters_t& params) const
+  {
+    FitResult_t result;
+
+    std::size_t const nPar = params.NParams();
+    std::size_t const nData = end - begin;
+    if ((params.nGaus == 0) || (params.nGaus > MaxGaussians) || (nData <= nPar))
+      return result;
+
+    ClampToLimits(params);
+
+    Matrix_t alpha, A;
+    ParamArray_t beta, step;
+    double chi2 = BuildNormalEquations(begin, end, params, alpha, beta);
+    double lambda = 1e-3;
+
+    Parameters_t trial = params;
+    while (result.nIterations < fMaxIterations) {
+
+      // damped normal equations: (alpha + lambda diag(alpha)) step = beta
+      A = alpha;
+      for (std::size_t i = 0; i < nPar; ++i) {
+        double& diag = A[i * MaxParams + i];
+        diag = (diag > 0.)? diag * (1. + lambda): lambda;
+      }
+      step = beta;
+      bool const solved = CholeskyDecompose(A, nPar);
+      double trialChi2 = std::numeric_limits<double>::infinity();
+      if (solved) {
+        CholeskySolve(A, nPar, step);
+        for (std::size_t i = 0; i < nPar; ++i)
+          trial.value[i] = params.value[i] + step[i];
+        ClampToLimits(trial);
+        trialChi2 = ComputeChi2(begin, end, trial);
+      }
+
+      if (trialChi2 < chi2) {
+        ++result.nIterations;
+        double const dChi2 = chi2 - trialChi2;
+        params.value = trial.value;
+        chi2 = BuildNormalEquations(begin, end, params, alpha, beta);
+        lambda = std::max(lambda * 0.1, 1e-12);
+        if (dChi2 <= fChi2Tolerance * chi2) break;
+      }
+      else {
+        // no improvement possible even with tiny steps: we are at the minimum
+        lambda *= 10.;
+        if (lambda > MaxLambda) break;
+      }
+    } // while
+
+    if (!std::isfinite(chi2)) return result;
+
+    // errors from the inverse of the undamped curvature matrix
+    if (!CholeskyDecompose(alpha, nPar)) return result;
+    for (std::size_t i = 0; i < nPar; ++i) {
+      std::fill_n(step.begin(), nPar, 0.);
+      step[i] = 1.;
+      CholeskySolve(alpha, nPar, step);
+      params.error[i] = std::sqrt(std::abs(step[i]));
+    } // for
+    if (!params.floatBaseline) params.error[params.BaselineIndex()] = 0.;
+
+    result.valid = true;
+    result.chi2 = chi2;
+    result.NDF = nData - nPar;
+    return result;
+  } // MultiGausFitter::Fit()
+
+} // namespace hit
@@ -0,0 +1,127 @@
+/**
+ * @file   MultiGausFitter.h
+ * @brief  Levenberg-Marquardt fit of a sum of Gaussians, without ROOT
+ * @see    MultiGausFitter.cxx
+ *
+ * The fitter works directly on a span of waveform samples and keeps all its
+ * working storage on the stack, so a single (constant) instance can be shared
+ * among threads.
+ */
+
+#ifndef MULTIGAUSFITTER_H
+#define MULTIGAUSFITTER_H 1
+
+// C/C++ standard libraries
+#include <array>
+#include <cstddef> // std::size_t
+#include <limits>
+
+namespace hit {
+
+  /** **************************************************************************
+   * @brief Fits a sum of Gaussians plus a baseline to a sampled waveform
+   *
+   * The model is
+   *
+   *     f(x) = sum_i A_i exp(-(x - m_i)^2 / (2 s_i^2)) + b
+   *
+   * where the Gaussian parameters are stored in the order amplitude, mean,
+   * sigma for each Gaussian, and the baseline `b` is the last parameter.
+   * Sample `i` of the input is evaluated at the bin center `x = i + 0.5`,
+   * which is the same convention of a histogram with unit bins starting at 0.
+   *
+   * The minimisation is a Levenberg-Marquardt one with analytic derivatives.
+   * Parameters are kept within their limits by clamping after each step.
+   * The baseline is fitted only if `Parameters_t::floatBaseline` is set,
+   * otherwise it is kept to its starting value.
+   *
+   * All the storage is in fixed-size arrays sized for `MaxGaussians`
+   * Gaussians; fits with more Gaussians than that are rejected.
+   * `Fit()` is constant and holds no state, and it is safe to call it
+   * concurrently from multiple threads.
+   */
+  class MultiGausFitter {
+      public:
+
+    /// Maximum number of Gaussians that can be fitted together
+    static constexpr std::size_t MaxGaussians = 16;
+
+    /// Maximum number of fit parameters (Gaussians plus baseline)
+    static constexpr std::size_t MaxParams = 3 * MaxGaussians + 1;
+
+    using ParamArray_t = std::array<double, MaxParams>;
+
+    /// Starting values, limits and (after the fit) results and errors
+    struct Parameters_t {
+      std::size_t nGaus = 0;      ///< number of Gaussians in the model
+      bool floatBaseline = false; ///< whether the baseline is a free parameter
+
+      ParamArray_t value {}; ///< parameter values
+      ParamArray_t lower {}; ///< lower limit of each parameter
+      ParamArray_t upper {}; ///< upper limit of each parameter
+      ParamArray_t error {}; ///< parameter errors (filled by the fit)
+
+      /// Number of free parameters
+      std::size_t NParams() const
+        { return 3 * nGaus + (floatBaseline? 1: 0); }
+
+      /// Index of the baseline parameter
+      std::size_t BaselineIndex() const { return 3 * nGaus; }
+
+      /// Sets starting value and limits of the Gaussian `iGaus`
+      void SetGaussian(
+        std::size_t iGaus,
+        double amplitude, double ampMin, double ampMax,
+        double mean, double meanMin, double meanMax,
+        double sigma, double sigmaMin, double sigmaMax
+        );
+
+      /// Sets starting value and limits of the baseline
+      void SetBaseline(double baseline, double minBaseline, double maxBaseline);
+
+    }; // struct Parameters_t
+
+    /// Outcome of a fit
+    struct FitResult_t {
+      bool valid = false; ///< whether the fit converged to a usable minimum
+      double chi2 = std::numeric_limits<double>::infinity(); ///< sum of squared residuals
+      int NDF = 0;                  ///< number of degrees of freedom
+      unsigned int nIterations = 0; ///< number of accepted steps
+    }; // struct FitResult_t
+
+
+    /**
+     * @brief Constructor
+     * @param maxIterations maximum number of Levenberg-Marquardt iterations
+     * @param chi2Tolerance relative change of chi^2 declaring convergence
+     */
+    MultiGausFitter(unsigned int maxIterations = 100, double chi2Tolerance = 1e-5);
+
+    /**
+     * @brief Fits the samples in `[begin, end)`
+     * @param begin pointer to the first sample
+     * @param end pointer after the last sample
+     * @param params starting values and limits; replaced by the fit results
+     * @return the outcome of the fit
+     *
+     * The errors are the square root of the diagonal of the inverse of the
+     * curvature matrix computed with unit weights for all the samples.
+     * If the fit is not valid, the content of `params` is unspecified.
+     */
+    FitResult_t Fit
+      (float const* begin, float const* end, Parameters_t& params) const;
+
+    /// Returns the value of the model with the specified parameters at `x`
+    static double Evaluate(Parameters_t const& params, double x);
+
+      private:
+
+    unsigned int fMaxIterations; ///< maximum number of iterations
+    double fChi2Tolerance;       ///< relative chi^2 change for convergence
+
+  }; // class MultiGausFitter
+
+} // namespace hit
+
+
+#endif // MULTIGAUSFITTER_H
@@ -17,6 +17,9 @@
 
 #include "TMath.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 using Point_t = recob::tracking::Point_t;
 using Vector_t = recob::tracking::Vector_t;
 using SMatrixSym55 = recob::tracking::SMatrixSym55;
@@ -113,6 +116,7 @@ pma::PMAlgFitter::PMAlgFitter(const std::vector<art::Ptr<recob::Hit>>& allhitlis
   , fTrackingOnlyPdg(pmalgFitterConfig.TrackingOnlyPdg())
   , fTrackingSkipPdg(pmalgFitterConfig.TrackingSkipPdg())
   , fRunVertexing(pmalgFitterConfig.RunVertexing())
+  , fRunParallel(pmalgFitterConfig.RunParallel())
 {
   mf::LogVerbatim("PMAlgFitter") << "Found " << allhitlist.size() << "hits in the event.";
   mf::LogVerbatim("PMAlgFitter") << "Sort hits by clusters assigned to PFParticles...";
@@ -180,6 +184,8 @@ pma::PMAlgFitter::buildTracks(detinfo::DetectorPropertiesData const& detProp)
   bool selectPdg = true;
   if (!fTrackingOnlyPdg.empty() && (fTrackingOnlyPdg.front() == 0)) selectPdg = false;
 
+  std::vector<pma::TrkCandidate> candidates;
+  std::vector<std::vector<art::Ptr<recob::Hit>>> candidateHits;
   for (const auto& pfpCluEntry : fPfpClusters) {
     int pfPartIdx = pfpCluEntry.first;
     int pdg = fPfpPdgCodes[pfPartIdx];
@@ -209,20 +215,41 @@ pma::PMAlgFitter::buildTracks(detinfo::DetectorPropertiesData const& detProp)
     {
       candidate.SetKey(pfpCluEntry.first);
 
-      candidate.SetTrack(fProjectionMatchingAlg.buildMultiTPCTrack(detProp, allHits));
+      candidates.push_back(candidate);
+      candidateHits.push_back(std::move(allHits));
+    }
+  }
 
-      if (candidate.IsValid() && candidate.Track()->HasTwoViews() &&
-          (candidate.Track()->Nodes().size() > 1)) {
-        if (!std::isnan(candidate.Track()->Length())) { fResult.push_back(candidate); }
-        else {
-          mf::LogError("PMAlgFitter") << "Trajectory fit lenght is nan.";
-          candidate.DeleteTrack();
-        }
-      }
+  // the tracks of different PFParticles are built independently: buildMultiTPCTrack()
+  // does not change the state of fProjectionMatchingAlg and each track owns its hits
+  auto buildCandidate = [&](size_t i) {
+    candidates[i].SetTrack(fProjectionMatchingAlg.buildMultiTPCTrack(detProp, candidateHits[i]));
+  };
+  if (fRunParallel) {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, candidates.size(), 1),
+                      [&](tbb::blocked_range<size_t> const& range) {
+                        for (size_t i = range.begin(); i < range.end(); ++i)
+                          buildCandidate(i);
+                      });
+  }
+  else {
+    for (size_t i = 0; i < candidates.size(); ++i)
+      buildCandidate(i);
+  }
+
+  // collect in the PFParticle key order, as if built serially
+  for (auto& candidate : candidates) {
+    if (candidate.IsValid() && candidate.Track()->HasTwoViews() &&
+        (candidate.Track()->Nodes().size() > 1)) {
+      if (!std::isnan(candidate.Track()->Length())) { fResult.push_back(candidate); }
       else {
+        mf::LogError("PMAlgFitter") << "Trajectory fit lenght is nan.";
         candidate.DeleteTrack();
       }
     }
+    else {
+      candidate.DeleteTrack();
+    }
   }
 }
 // ------------------------------------------------------
@@ -112,6 +112,11 @@ public:
       Name("RunVertexing"),
       Comment(
         "find vertices from PFP hierarchy, join with tracks, reoptimize track-vertex structure")};
+
+    fhicl::Atom<bool> RunParallel{
+      Name("RunParallel"),
+      Comment("build tracks of different PFParticles concurrently; results do not depend on it"),
+      false};
   };
 
   PMAlgFitter(const std::vector<art::Ptr<recob::Hit>>& allhitlist,
@@ -150,6 +155,7 @@ private:
   std::vector<int> fTrackingSkipPdg; // skip tracks with this pdg's when using
                                      // input from PFParticles
   bool fRunVertexing;                // run vertex finding
+  bool fRunParallel;                 // build PFParticle tracks concurrently
 };
 
 class pma::PMAlgTracker : public pma::PMAlgTrackingBase {
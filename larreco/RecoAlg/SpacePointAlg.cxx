@@ -13,16 +13,24 @@
 #include "cetlib_except/exception.h"
 #include "larcore/Geometry/Geometry.h"
 #include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/GeometryCore.h"
 #include "larcorealg/Geometry/PlaneGeo.h"
 #include "larcorealg/Geometry/TPCGeo.h"
 #include "larcorealg/Geometry/WireGeo.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <iostream>
 #include <map>
+#include <numeric>
+#include <set>
+#include <utility>
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 //\todo Remove include of BackTrackerService.h once this algorithm is stripped of test for MC
 #include "lardata/RecoObjects/KHitTrack.h"
 #include "lardata/RecoObjects/KHitWireX.h"
@@ -30,6 +38,188 @@
 #include "lardataobj/RecoBase/SpacePoint.h"
 #include "larsim/MCCheater/BackTrackerService.h"
 
+namespace {
+
+  // Hits of one plane in flat arrays, sorted by wire and corrected time.
+  struct PlaneHits {
+
+    // Angle, pitch and offset of the plane wires (from wire 0).
+
+    double s = 0.;
+    double c = 0.;
+    double offset = 0.;
+    double pitch = 0.;
+    geo::View_t view = geo::kUnknown;
+
+    // Per hit.
+
+    std::vector<art::Ptr<recob::Hit>> hits;
+    std::vector<unsigned int> wire;
+    std::vector<double> time;                ///< Peak time minus plane time offset.
+    std::vector<std::array<double, 4>> ends; ///< (y, z) of the wire endpoints.
+    std::vector<double> sinth;               ///< Wire angle and distance from origin,
+    std::vector<double> costh;               ///< as compatible() calculates them.
+    std::vector<double> dist;
+
+    // Hit indices in the order of a map by wire (input order on the same wire).
+
+    std::vector<unsigned int> byRank;
+    std::vector<unsigned int> rank;
+
+    std::size_t
+    size() const
+    {
+      return hits.size();
+    }
+    bool
+    empty() const
+    {
+      return hits.empty();
+    }
+  };
+
+  // Hits of a space point candidate (plane and index in PlaneHits).
+  struct HitCombination {
+    unsigned int nhits;
+    std::array<unsigned int, 3> plane;
+    std::array<unsigned int, 3> hit;
+  };
+
+  //----------------------------------------------------------------------
+  // Sort the hits of a plane and fill the flat arrays.
+  void
+  sortPlaneHits(PlaneHits& p,
+                geo::PlaneID const& planeid,
+                geo::GeometryCore const& geom,
+                detinfo::DetectorPropertiesData const& detProp)
+  {
+    const geo::WireGeo& wgeo0 =
+      geom.Cryostat(planeid.Cryostat).TPC(planeid.TPC).Plane(planeid.Plane).Wire(0);
+    double hl0 = wgeo0.HalfL();
+    double xyz01[3];
+    double xyz02[3];
+    wgeo0.GetCenter(xyz01, -hl0);
+    wgeo0.GetCenter(xyz02, hl0);
+    p.s = (xyz02[1] - xyz01[1]) / (2. * hl0);
+    p.c = (xyz02[2] - xyz01[2]) / (2. * hl0);
+    p.offset = -xyz01[1] * p.c + xyz01[2] * p.s;
+    p.pitch = geom.WirePitch(planeid.Plane, planeid.TPC, planeid.Cryostat);
+    p.view = geom.View(planeid);
+    const double ticksOffset =
+      detProp.GetXTicksOffset(planeid.Plane, planeid.TPC, planeid.Cryostat);
+
+    std::size_t const nhits = p.hits.size();
+    std::vector<unsigned int> wire(nhits);
+    std::vector<double> time(nhits);
+    for (std::size_t i = 0; i < nhits; ++i) {
+      wire[i] = p.hits[i]->WireID().Wire;
+      time[i] = p.hits[i]->PeakTime() - ticksOffset;
+    }
+
+    std::vector<unsigned int> order(nhits);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&wire](unsigned int a, unsigned int b) {
+      return wire[a] < wire[b];
+    });
+    std::vector<unsigned int> rank(nhits);
+    for (std::size_t r = 0; r < nhits; ++r)
+      rank[order[r]] = r;
+    std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+      if (wire[a] != wire[b]) return wire[a] < wire[b];
+      if (time[a] != time[b]) return time[a] < time[b];
+      return rank[a] < rank[b];
+    });
+
+    std::vector<art::Ptr<recob::Hit>> sorted;
+    sorted.reserve(nhits);
+    p.wire.resize(nhits);
+    p.time.resize(nhits);
+    p.ends.resize(nhits);
+    p.sinth.resize(nhits);
+    p.costh.resize(nhits);
+    p.dist.resize(nhits);
+    p.rank.resize(nhits);
+    p.byRank.resize(nhits);
+    for (std::size_t i = 0; i < nhits; ++i) {
+      unsigned int const j = order[i];
+      sorted.push_back(p.hits[j]);
+      p.wire[i] = wire[j];
+      p.time[i] = time[j];
+      p.rank[i] = rank[j];
+      p.byRank[rank[j]] = i;
+
+      // Wire geometry, once per wire.
+
+      if (i > 0 && p.wire[i] == p.wire[i - 1]) {
+        p.ends[i] = p.ends[i - 1];
+        p.sinth[i] = p.sinth[i - 1];
+        p.costh[i] = p.costh[i - 1];
+        p.dist[i] = p.dist[i - 1];
+        continue;
+      }
+      const geo::WireGeo& wgeo = geom.WireIDToWireGeo(sorted.back()->WireID());
+      double hl = wgeo.HalfL();
+      double xyz[3];
+      double xyz1[3];
+      double xyz2[3];
+      wgeo.GetCenter(xyz);
+      wgeo.GetCenter(xyz1, -hl);
+      wgeo.GetCenter(xyz2, hl);
+      p.ends[i] = {{xyz1[1], xyz1[2], xyz2[1], xyz2[2]}};
+      p.sinth[i] = (xyz2[1] - xyz[1]) / hl;
+      p.costh[i] = (xyz2[2] - xyz[2]) / hl;
+      p.dist[i] = xyz[2] * p.sinth[i] - xyz[1] * p.costh[i];
+    }
+    p.hits = std::move(sorted);
+  }
+
+  //----------------------------------------------------------------------
+  // Range of wires of plane p2 crossing the wire of hit ihit1 of plane p1.
+  std::pair<int, int>
+  wireWindow(PlaneHits const& p1, unsigned int ihit1, PlaneHits const& p2)
+  {
+    auto const& ends = p1.ends[ihit1];
+    double wire21 = (-ends[0] * p2.c + ends[1] * p2.s - p2.offset) / p2.pitch;
+    double wire22 = (-ends[2] * p2.c + ends[3] * p2.s - p2.offset) / p2.pitch;
+
+    int wmin = std::max(0., std::min(wire21, wire22));
+    int wmax = std::max(0., std::max(wire21, wire22) + 1.);
+    return {wmin, wmax};
+  }
+
+  //----------------------------------------------------------------------
+  // Indices of the hits of a plane with wire in [wmin, wmax] and corrected
+  // time in [tmin, tmax], in the order of a map by wire.
+  void
+  hitsInWindow(PlaneHits const& p,
+               int wmin,
+               int wmax,
+               double tmin,
+               double tmax,
+               std::vector<unsigned int>& result)
+  {
+    result.clear();
+    if (wmin > wmax) return;
+
+    auto const wbegin = p.wire.cbegin();
+    auto iw = std::lower_bound(wbegin, p.wire.cend(), (unsigned int)wmin);
+    auto const wend = std::upper_bound(iw, p.wire.cend(), (unsigned int)wmax);
+    while (iw != wend) {
+      auto const iwnext = std::upper_bound(iw, wend, *iw);
+      auto const tend = p.time.cbegin() + (iwnext - wbegin);
+      for (auto it = std::lower_bound(p.time.cbegin() + (iw - wbegin), tend, tmin);
+           it != tend && *it <= tmax;
+           ++it)
+        result.push_back(it - p.time.cbegin());
+      iw = iwnext;
+    }
+    std::sort(result.begin(), result.end(), [&p](unsigned int a, unsigned int b) {
+      return p.rank[a] < p.rank[b];
+    });
+  }
+
+}
+
 //----------------------------------------------------------------------
 // Constructor.
 //
@@ -48,6 +238,7 @@ namespace trkf {
     , fTickOffsetU{pset.get<double>("TickOffsetU", 0.)}
     , fTickOffsetV{pset.get<double>("TickOffsetV", 0.)}
     , fTickOffsetW{pset.get<double>("TickOffsetW", 0.)}
+    , fRunParallel{pset.get<bool>("RunParallel", false)}
   {
     // Only allow one of fFilter and fMerge to be true.
 
@@ -68,7 +259,8 @@ namespace trkf {
               << "  PreferColl = " << fPreferColl << "\n"
               << "  TickOffsetU = " << fTickOffsetU << "\n"
               << "  TickOffsetV = " << fTickOffsetV << "\n"
-              << "  TickOffsetW = " << fTickOffsetW << std::endl;
+              << "  TickOffsetW = " << fTickOffsetW << "\n"
+              << "  RunParallel = " << fRunParallel << std::endl;
   }
 
   //----------------------------------------------------------------------
@@ -845,11 +1037,13 @@ namespace trkf {
     int n2filt = 0; // Number of two-hit space points after filtering/merging.
     int n3filt = 0; // Number of three-hit space pointe after filtering/merging.
 
-    // Sort hits into maps indexed by [cryostat][tpc][plane][wire].
+    // Sort hits into flat arrays indexed by [cryostat][tpc][plane],
+    // ordered by wire and corrected time.
     // If using mc information, also generate maps of sim::IDEs and mc
     // position indexed by hit.
 
-    std::vector<std::vector<std::vector<std::multimap<unsigned int, art::Ptr<recob::Hit>>>>> hitmap;
+    std::vector<std::vector<std::vector<PlaneHits>>> hitmap;
+    std::vector<geo::TPCID> tpcids;
     fHitMCMap.clear();
 
     unsigned int ncstat = geom->Ncryostats();
@@ -860,6 +1054,7 @@ namespace trkf {
       for (unsigned int tpc = 0; tpc < ntpc; ++tpc) {
         int nplane = geom->Cryostat(cstat).TPC(tpc).Nplanes();
         hitmap[cstat][tpc].resize(nplane);
+        tpcids.emplace_back(cstat, tpc);
       }
     }
 
@@ -870,8 +1065,15 @@ namespace trkf {
       if ((view == geo::kU && fEnableU) || (view == geo::kV && fEnableV) ||
           (view == geo::kZ && fEnableW)) {
         geo::WireID phitWireID = phit->WireID();
-        hitmap[phitWireID.Cryostat][phitWireID.TPC][phitWireID.Plane].insert(
-          std::make_pair(phitWireID.Wire, phit));
+        hitmap[phitWireID.Cryostat][phitWireID.TPC][phitWireID.Plane].hits.push_back(phit);
+      }
+    }
+
+    for (geo::TPCID const& tpcid : tpcids) {
+      std::vector<PlaneHits>& tpcHits = hitmap[tpcid.Cryostat][tpcid.TPC];
+      for (unsigned int plane = 0; plane < tpcHits.size(); ++plane) {
+        if (!tpcHits[plane].empty())
+          sortPlaneHits(tpcHits[plane], geo::PlaneID(tpcid, plane), *geom, detProp);
       }
     }
 
@@ -887,11 +1089,9 @@ namespace trkf {
         for (unsigned int tpc = 0; tpc < geom->Cryostat(cstat).NTPC(); ++tpc) {
           int nplane = geom->Cryostat(cstat).TPC(tpc).Nplanes();
           for (int plane = 0; plane < nplane; ++plane) {
-            for (std::map<unsigned int, art::Ptr<recob::Hit>>::const_iterator ihit =
-                   hitmap[cstat][tpc][plane].begin();
-                 ihit != hitmap[cstat][tpc][plane].end();
-                 ++ihit) {
-              const art::Ptr<recob::Hit>& phit = ihit->second;
+            const PlaneHits& planeHits = hitmap[cstat][tpc][plane];
+            for (unsigned int ihit : planeHits.byRank) {
+              const art::Ptr<recob::Hit>& phit = planeHits.hits[ihit];
               const recob::Hit& hit = *phit;
               HitMCInfo& mcinfo = fHitMCMap[&hit]; // Default HitMCInfo.
 
@@ -929,12 +1129,9 @@ namespace trkf {
         for (unsigned int tpc = 0; tpc < geom->Cryostat(cstat).NTPC(); ++tpc) {
           int nplane = geom->Cryostat(cstat).TPC(tpc).Nplanes();
           for (int plane = 0; plane < nplane; ++plane) {
-            for (std::map<unsigned int, art::Ptr<recob::Hit>>::const_iterator ihit =
-                   hitmap[cstat][tpc][plane].begin();
-                 ihit != hitmap[cstat][tpc][plane].end();
-                 ++ihit) {
-              const art::Ptr<recob::Hit>& phit = ihit->second;
-              const recob::Hit& hit = *phit;
+            const PlaneHits& planeHits = hitmap[cstat][tpc][plane];
+            for (unsigned int ihit : planeHits.byRank) {
+              const recob::Hit& hit = *planeHits.hits[ihit];
               HitMCInfo& mcinfo = fHitMCMap[&hit];
               if (mcinfo.xyz.size() != 0) {
                 assert(mcinfo.xyz.size() == 3);
@@ -942,12 +1139,9 @@ namespace trkf {
                 // Fill nearest neighbor information for this hit.
 
                 for (int plane2 = 0; plane2 < nplane; ++plane2) {
-                  for (std::map<unsigned int, art::Ptr<recob::Hit>>::const_iterator jhit =
-                         hitmap[cstat][tpc][plane2].begin();
-                       jhit != hitmap[cstat][tpc][plane2].end();
-                       ++jhit) {
-                    const art::Ptr<recob::Hit>& phit2 = jhit->second;
-                    const recob::Hit& hit2 = *phit2;
+                  const PlaneHits& planeHits2 = hitmap[cstat][tpc][plane2];
+                  for (unsigned int jhit : planeHits2.byRank) {
+                    const recob::Hit& hit2 = *planeHits2.hits[jhit];
                     const HitMCInfo& mcinfo2 = fHitMCMap[&hit2];
 
                     if (mcinfo2.xyz.size() != 0) {
@@ -987,498 +1181,440 @@ namespace trkf {
       } // end loop over cryostats
     }   // if debug
 
-    // Make empty multimap from hit pointer on preferred
-    // (most-populated or collection) plane to space points that
-    // include that hit (used for sorting, filtering, and
-    // merging).
+    // Check compatibility of hit pairs and triplets found by the search
+    // below.  With mc information this is done by compatible(), otherwise
+    // the same tests are done on the flat arrays.
 
-    typedef const recob::Hit* sptkey_type;
-    std::multimap<sptkey_type, recob::SpacePoint> sptmap;
-    std::set<sptkey_type> sptkeys; // Keys of multimap.
-
-    // Loop over TPCs.
-    for (unsigned int cstat = 0; cstat < ncstat; ++cstat) {
-      for (unsigned int tpc = 0; tpc < geom->Cryostat(cstat).NTPC(); ++tpc) {
-
-        geo::TPCID tpcid(cstat, tpc);
-
-        // Sort maps in increasing order of number of hits.
-        // This is so that we can do the outer loops over hits
-        // over the views with fewer hits.
-        //
-        // If config parameter PreferColl is true, treat the colleciton
-        // plane as if it had the most hits, regardless of how many
-        // hits it actually has.  This will force space points to be
-        // filtered and merged with respect to the collection plane
-        // wires.  It will also force space points to be sorted by
-        // collection plane wire.
+    auto pairCompatible =
+      [&](const PlaneHits& p1, unsigned int ihit1, const PlaneHits& p2, unsigned int ihit2) {
+        if (useMC) {
+          art::PtrVector<recob::Hit> hitvec;
+          hitvec.push_back(p1.hits[ihit1]);
+          hitvec.push_back(p2.hits[ihit2]);
+          return compatible(detProp, hitvec, useMC);
+        }
+        return p1.view != p2.view && std::abs(p1.time[ihit1] - p2.time[ihit2]) <= fMaxDT;
+      };
+
+    auto tripletCompatible = [&](const std::vector<PlaneHits>& tpcHits,
+                                 const HitCombination& comb) {
+      if (useMC) {
+        art::PtrVector<recob::Hit> hitvec;
+        for (unsigned int k = 0; k < 3; ++k)
+          hitvec.push_back(tpcHits[comb.plane[k]].hits[comb.hit[k]]);
+        return compatible(detProp, hitvec, useMC);
+      }
 
-        int nplane = hitmap[cstat][tpc].size();
-        std::vector<int> index(nplane);
+      // Pairwise tests.
 
-        for (int i = 0; i < nplane; ++i)
-          index[i] = i;
+      for (unsigned int k1 = 0; k1 < 2; ++k1) {
+        for (unsigned int k2 = k1 + 1; k2 < 3; ++k2) {
+          if (!pairCompatible(tpcHits[comb.plane[k1]],
+                              comb.hit[k1],
+                              tpcHits[comb.plane[k2]],
+                              comb.hit[k2]))
+            return false;
+        }
+      }
 
-        for (int i = 0; i < nplane - 1; ++i) {
+      // Space cut.
 
-          for (int j = i + 1; j < nplane; ++j) {
-            bool icoll =
-              fPreferColl && geom->SignalType(geo::PlaneID(tpcid, index[i])) == geo::kCollection;
-            bool jcoll =
-              fPreferColl && geom->SignalType(geo::PlaneID(tpcid, index[j])) == geo::kCollection;
-            if ((hitmap[cstat][tpc][index[i]].size() > hitmap[cstat][tpc][index[j]].size() &&
-                 !jcoll) ||
-                icoll) {
-              int temp = index[i];
-              index[i] = index[j];
-              index[j] = temp;
-            }
+      double dist[3] = {0., 0., 0.};
+      double sinth[3] = {0., 0., 0.};
+      double costh[3] = {0., 0., 0.};
+      for (unsigned int k = 0; k < 3; ++k) {
+        const PlaneHits& p = tpcHits[comb.plane[k]];
+        sinth[comb.plane[k]] = p.sinth[comb.hit[k]];
+        costh[comb.plane[k]] = p.costh[comb.hit[k]];
+        dist[comb.plane[k]] = p.dist[comb.hit[k]];
+      }
+      double S = ((sinth[1] * costh[2] - costh[1] * sinth[2]) * dist[0] +
+                  (sinth[2] * costh[0] - costh[2] * sinth[0]) * dist[1] +
+                  (sinth[0] * costh[1] - costh[0] * sinth[1]) * dist[2]);
+      return std::abs(S) < fMaxS;
+    };
+
+    // Search each TPC for compatible combinations of hits.
+    // The combinations are listed in the order space points are made of them.
+
+    std::vector<std::vector<HitCombination>> combinations(tpcids.size());
+
+    auto findCombinations = [&](std::size_t itpc) {
+      geo::TPCID const& tpcid = tpcids[itpc];
+      const std::vector<PlaneHits>& tpcHits = hitmap[tpcid.Cryostat][tpcid.TPC];
+      std::vector<HitCombination>& tpcCombinations = combinations[itpc];
+
+      // Sort planes in increasing order of number of hits.
+      // This is so that we can do the outer loops over hits
+      // over the views with fewer hits.
+      //
+      // If config parameter PreferColl is true, treat the colleciton
+      // plane as if it had the most hits, regardless of how many
+      // hits it actually has.  This will force space points to be
+      // filtered and merged with respect to the collection plane
+      // wires.  It will also force space points to be sorted by
+      // collection plane wire.
+
+      int nplane = tpcHits.size();
+      std::vector<int> index(nplane);
+
+      for (int i = 0; i < nplane; ++i)
+        index[i] = i;
+
+      for (int i = 0; i < nplane - 1; ++i) {
+
+        for (int j = i + 1; j < nplane; ++j) {
+          bool icoll =
+            fPreferColl && geom->SignalType(geo::PlaneID(tpcid, index[i])) == geo::kCollection;
+          bool jcoll =
+            fPreferColl && geom->SignalType(geo::PlaneID(tpcid, index[j])) == geo::kCollection;
+          if ((tpcHits[index[i]].size() > tpcHits[index[j]].size() && !jcoll) || icoll) {
+            int temp = index[i];
+            index[i] = index[j];
+            index[j] = temp;
           }
-        } // end loop over i
-
-        // how many views with hits?
-        // This will allow for the special case where we might have only 2 planes of information and
-        // still want space points even if a three plane TPC
-        std::vector<std::multimap<unsigned int, art::Ptr<recob::Hit>>>& hitsByPlaneVec =
-          hitmap[cstat][tpc];
-        int nViewsWithHits(0);
-
-        for (int i = 0; i < nplane; i++) {
-          if (hitsByPlaneVec[index[i]].size() > 0) nViewsWithHits++;
         }
+      } // end loop over i
 
-        // If two-view space points are allowed, make a double loop
-        // over hits and produce space points for compatible hit-pairs.
-
-        if ((nViewsWithHits == 2 || nplane == 2) && fMinViews <= 2) {
-
-          // Loop over pairs of views.
-          for (int i = 0; i < nplane - 1; ++i) {
-            unsigned int plane1 = index[i];
-
-            if (hitmap[cstat][tpc][plane1].empty()) continue;
-
-            for (int j = i + 1; j < nplane; ++j) {
-              unsigned int plane2 = index[j];
-
-              if (hitmap[cstat][tpc][plane2].empty()) continue;
-
-              // Get angle, pitch, and offset of plane2 wires.
-              const geo::WireGeo& wgeo2 = geom->Cryostat(cstat).TPC(tpc).Plane(plane2).Wire(0);
-              double hl2 = wgeo2.HalfL();
-              double xyz21[3];
-              double xyz22[3];
-              wgeo2.GetCenter(xyz21, -hl2);
-              wgeo2.GetCenter(xyz22, hl2);
-              double s2 = (xyz22[1] - xyz21[1]) / (2. * hl2);
-              double c2 = (xyz22[2] - xyz21[2]) / (2. * hl2);
-              double dist2 = -xyz21[1] * c2 + xyz21[2] * s2;
-              double pitch2 = geom->WirePitch(plane2, tpc, cstat);
-
-              if (!fPreferColl &&
-                  hitmap[cstat][tpc][plane1].size() > hitmap[cstat][tpc][plane2].size())
-                throw cet::exception("SpacePointAlg")
-                  << "makeSpacePoints(): hitmaps with incompatible size\n";
+      // how many views with hits?
+      // This will allow for the special case where we might have only 2 planes of information and
+      // still want space points even if a three plane TPC
+      int nViewsWithHits(0);
 
-              // Loop over pairs of hits.
-
-              art::PtrVector<recob::Hit> hitvec;
-              hitvec.reserve(2);
+      for (int i = 0; i < nplane; i++) {
+        if (tpcHits[index[i]].size() > 0) nViewsWithHits++;
+      }
 
-              for (std::map<unsigned int, art::Ptr<recob::Hit>>::const_iterator ihit1 =
-                     hitmap[cstat][tpc][plane1].begin();
-                   ihit1 != hitmap[cstat][tpc][plane1].end();
-                   ++ihit1) {
+      std::vector<unsigned int> hits2;
+      std::vector<unsigned int> hits3;
 
-                const art::Ptr<recob::Hit>& phit1 = ihit1->second;
-                geo::WireID phit1WireID = phit1->WireID();
-                const geo::WireGeo& wgeo = geom->WireIDToWireGeo(phit1WireID);
+      // If two-view space points are allowed, make a double loop
+      // over hits and produce space points for compatible hit-pairs.
 
-                // Get endpoint coordinates of this wire.
-                // (kept as assertions for performance reasons)
-                assert(phit1WireID.Cryostat == cstat);
-                assert(phit1WireID.TPC == tpc);
-                assert(phit1WireID.Plane == plane1);
-                double hl1 = wgeo.HalfL();
-                double xyz1[3];
-                double xyz2[3];
-                wgeo.GetCenter(xyz1, -hl1);
-                wgeo.GetCenter(xyz2, hl1);
+      if ((nViewsWithHits == 2 || nplane == 2) && fMinViews <= 2) {
 
-                // Find the plane2 wire numbers corresponding to the endpoints.
+        // Loop over pairs of views.
+        for (int i = 0; i < nplane - 1; ++i) {
+          unsigned int plane1 = index[i];
+          const PlaneHits& p1 = tpcHits[plane1];
 
-                double wire21 = (-xyz1[1] * c2 + xyz1[2] * s2 - dist2) / pitch2;
-                double wire22 = (-xyz2[1] * c2 + xyz2[2] * s2 - dist2) / pitch2;
+          if (p1.empty()) continue;
 
-                int wmin = std::max(0., std::min(wire21, wire22));
-                int wmax = std::max(0., std::max(wire21, wire22) + 1.);
+          for (int j = i + 1; j < nplane; ++j) {
+            unsigned int plane2 = index[j];
+            const PlaneHits& p2 = tpcHits[plane2];
 
-                std::map<unsigned int, art::Ptr<recob::Hit>>::const_iterator
-                  ihit2 = hitmap[cstat][tpc][plane2].lower_bound(wmin),
-                  ihit2end = hitmap[cstat][tpc][plane2].upper_bound(wmax);
+            if (p2.empty()) continue;
 
-                for (; ihit2 != ihit2end; ++ihit2) {
+            if (!fPreferColl && p1.size() > p2.size())
+              throw cet::exception("SpacePointAlg")
+                << "makeSpacePoints(): hitmaps with incompatible size\n";
 
-                  const art::Ptr<recob::Hit>& phit2 = ihit2->second;
+            // Loop over pairs of hits.
 
-                  // Check current pair of hits for compatibility.
-                  // By construction, hits should always have compatible views
-                  // and times, but may not have compatible mc information.
+            for (unsigned int ihit1 : p1.byRank) {
 
-                  hitvec.clear();
-                  hitvec.push_back(phit1);
-                  hitvec.push_back(phit2);
-                  bool ok = compatible(detProp, hitvec, useMC);
-                  if (ok) {
+              // Find the plane2 hits on wires crossing this one, and within
+              // the time difference (with some margin, the cut is done by
+              // the compatibility test).
 
-                    // Add a space point.
+              auto const [wmin, wmax] = wireWindow(p1, ihit1, p2);
+              double const t1 = p1.time[ihit1];
+              hitsInWindow(p2, wmin, wmax, t1 - fMaxDT - 1., t1 + fMaxDT + 1., hits2);
 
-                    ++n2;
+              for (unsigned int ihit2 : hits2) {
 
-                    // make a dummy vector of recob::SpacePoints
-                    // as we are filtering or merging and don't want to
-                    // add the created SpacePoint to the final collection just yet
-                    // This dummy vector will hold just one recob::SpacePoint,
-                    // which will go into the multimap and then the vector
-                    // will go out of scope.
+                // Check current pair of hits for compatibility.
+                // By construction, hits should always have compatible views
+                // and times, but may not have compatible mc information.
 
-                    std::vector<recob::SpacePoint> sptv;
-                    fillSpacePoint(detProp, hitvec, sptv, sptmap.size());
-                    sptkey_type key = &*phit2;
-                    sptmap.insert(std::pair<sptkey_type, recob::SpacePoint>(key, sptv.back()));
-                    sptkeys.insert(key);
-                  }
-                }
+                if (pairCompatible(p1, ihit1, p2, ihit2))
+                  tpcCombinations.push_back({2, {plane1, plane2, 0}, {ihit1, ihit2, 0}});
               }
             }
           }
-        } // end if fMinViews <= 2
-
-        // If three-view space points are allowed, make a triple loop
-        // over hits and produce space points for compatible triplets.
+        }
+      } // end if fMinViews <= 2
 
-        if (nplane >= 3 && fMinViews <= 3) {
+      // If three-view space points are allowed, make a triple loop
+      // over hits and produce space points for compatible triplets.
 
-          // Loop over triplets of hits.
+      if (nplane >= 3 && fMinViews <= 3) {
 
-          art::PtrVector<recob::Hit> hitvec;
-          hitvec.reserve(3);
-
-          unsigned int plane1 = index[0];
-          unsigned int plane2 = index[1];
-          unsigned int plane3 = index[2];
-
-          // Get angle, pitch, and offset of plane1 wires.
-
-          const geo::WireGeo& wgeo1 = geom->Cryostat(cstat).TPC(tpc).Plane(plane1).Wire(0);
-          double hl1 = wgeo1.HalfL();
-          double xyz11[3];
-          double xyz12[3];
-          wgeo1.GetCenter(xyz11, -hl1);
-          wgeo1.GetCenter(xyz12, hl1);
-          double s1 = (xyz12[1] - xyz11[1]) / (2. * hl1);
-          double c1 = (xyz12[2] - xyz11[2]) / (2. * hl1);
-          double dist1 = -xyz11[1] * c1 + xyz11[2] * s1;
-          double pitch1 = geom->WirePitch(plane1, tpc, cstat);
-          const double TicksOffset1 = detProp.GetXTicksOffset(plane1, tpc, cstat);
-
-          // Get angle, pitch, and offset of plane2 wires.
+        unsigned int plane1 = index[0];
+        unsigned int plane2 = index[1];
+        unsigned int plane3 = index[2];
+        const PlaneHits& p1 = tpcHits[plane1];
+        const PlaneHits& p2 = tpcHits[plane2];
+        const PlaneHits& p3 = tpcHits[plane3];
 
-          const geo::WireGeo& wgeo2 = geom->Cryostat(cstat).TPC(tpc).Plane(plane2).Wire(0);
-          double hl2 = wgeo2.HalfL();
-          double xyz21[3];
-          double xyz22[3];
-          wgeo2.GetCenter(xyz21, -hl2);
-          wgeo2.GetCenter(xyz22, hl2);
-          double s2 = (xyz22[1] - xyz21[1]) / (2. * hl2);
-          double c2 = (xyz22[2] - xyz21[2]) / (2. * hl2);
-          double dist2 = -xyz21[1] * c2 + xyz21[2] * s2;
-          double pitch2 = geom->WirePitch(plane2, tpc, cstat);
-          const double TicksOffset2 = detProp.GetXTicksOffset(plane2, tpc, cstat);
+        if (p1.empty() || p2.empty() || p3.empty()) return;
 
-          // Get angle, pitch, and offset of plane3 wires.
+        // Get sine of angle differences.
 
-          const geo::WireGeo& wgeo3 = geom->Cryostat(cstat).TPC(tpc).Plane(plane3).Wire(0);
-          double hl3 = wgeo3.HalfL();
-          double xyz31[3];
-          double xyz32[3];
-          wgeo3.GetCenter(xyz31, -hl3);
-          wgeo3.GetCenter(xyz32, hl3);
-          double s3 = (xyz32[1] - xyz31[1]) / (2. * hl3);
-          double c3 = (xyz32[2] - xyz31[2]) / (2. * hl3);
-          double dist3 = -xyz31[1] * c3 + xyz31[2] * s3;
-          double pitch3 = geom->WirePitch(plane3, tpc, cstat);
-          const double TicksOffset3 = detProp.GetXTicksOffset(plane3, tpc, cstat);
+        double s12 = p1.s * p2.c - p2.s * p1.c; // sin(theta1 - theta2).
+        double s23 = p2.s * p3.c - p3.s * p2.c; // sin(theta2 - theta3).
+        double s31 = p3.s * p1.c - p1.s * p3.c; // sin(theta3 - theta1).
 
-          // Get sine of angle differences.
+        // Loop over hits in plane1.
 
-          double s12 = s1 * c2 - s2 * c1; // sin(theta1 - theta2).
-          double s23 = s2 * c3 - s3 * c2; // sin(theta2 - theta3).
-          double s31 = s3 * c1 - s1 * c3; // sin(theta3 - theta1).
+        for (unsigned int ihit1 : p1.byRank) {
 
-          // Loop over hits in plane1.
+          // Get corrected time and oblique coordinate of first hit.
 
-          std::map<unsigned int, art::Ptr<recob::Hit>>::const_iterator
-            ihit1 = hitmap[cstat][tpc][plane1].begin(),
-            ihit1end = hitmap[cstat][tpc][plane1].end();
-          for (; ihit1 != ihit1end; ++ihit1) {
+          double t1 = p1.time[ihit1];
+          double u1 = p1.wire[ihit1] * p1.pitch + p1.offset;
 
-            unsigned int wire1 = ihit1->first;
-            const art::Ptr<recob::Hit>& phit1 = ihit1->second;
-            geo::WireID phit1WireID = phit1->WireID();
-            const geo::WireGeo& wgeo = geom->WireIDToWireGeo(phit1WireID);
+          // Find the plane2 hits on wires crossing this one.
 
-            // Get endpoint coordinates of this wire from plane1.
-            // (kept as assertions for performance reasons)
-            assert(phit1WireID.Cryostat == cstat);
-            assert(phit1WireID.TPC == tpc);
-            assert(phit1WireID.Plane == plane1);
-            assert(phit1WireID.Wire == wire1);
-            double hl1 = wgeo.HalfL();
-            double xyz1[3];
-            double xyz2[3];
-            wgeo.GetCenter(xyz1, -hl1);
-            wgeo.GetCenter(xyz2, hl1);
+          auto const [wmin, wmax] = wireWindow(p1, ihit1, p2);
+          hitsInWindow(p2, wmin, wmax, t1 - fMaxDT - 1., t1 + fMaxDT + 1., hits2);
 
-            // Get corrected time and oblique coordinate of first hit.
+          for (unsigned int ihit2 : hits2) {
 
-            double t1 = phit1->PeakTime() - TicksOffset1;
-            double u1 = wire1 * pitch1 + dist1;
+            // Get corrected time of second hit.
 
-            // Find the plane2 wire numbers corresponding to the endpoints.
+            double t2 = p2.time[ihit2];
 
-            double wire21 = (-xyz1[1] * c2 + xyz1[2] * s2 - dist2) / pitch2;
-            double wire22 = (-xyz2[1] * c2 + xyz2[2] * s2 - dist2) / pitch2;
+            // Check maximum time difference with first hit.
 
-            int wmin = std::max(0., std::min(wire21, wire22));
-            int wmax = std::max(0., std::max(wire21, wire22) + 1.);
+            bool dt12ok = std::abs(t1 - t2) <= fMaxDT;
+            if (!dt12ok) continue;
 
-            std::map<unsigned int, art::Ptr<recob::Hit>>::const_iterator
-              ihit2 = hitmap[cstat][tpc][plane2].lower_bound(wmin),
-              ihit2end = hitmap[cstat][tpc][plane2].upper_bound(wmax);
+            // Test first two hits for compatibility before looping
+            // over third hit.
 
-            for (; ihit2 != ihit2end; ++ihit2) {
+            bool h12ok = pairCompatible(p1, ihit1, p2, ihit2);
+            if (!h12ok) continue;
 
-              int wire2 = ihit2->first;
-              const art::Ptr<recob::Hit>& phit2 = ihit2->second;
+            // Get oblique coordinate of second hit.
 
-              // Get corrected time of second hit.
+            double u2 = p2.wire[ihit2] * p2.pitch + p2.offset;
 
-              double t2 = phit2->PeakTime() - TicksOffset2;
+            // Predict plane3 oblique coordinate and wire number.
 
-              // Check maximum time difference with first hit.
+            double u3pred = (-u1 * s23 - u2 * s31) / s12;
+            double w3pred = (u3pred - p3.offset) / p3.pitch;
+            double w3delta = std::abs(fMaxS / (s12 * p3.pitch));
+            int w3min = std::max(0., std::ceil(w3pred - w3delta));
+            int w3max = std::max(0., std::floor(w3pred + w3delta));
 
-              bool dt12ok = std::abs(t1 - t2) <= fMaxDT;
-              if (dt12ok) {
+            hitsInWindow(p3,
+                         w3min,
+                         w3max,
+                         std::max(t1, t2) - fMaxDT - 1.,
+                         std::min(t1, t2) + fMaxDT + 1.,
+                         hits3);
 
-                // Test first two hits for compatibility before looping
-                // over third hit.
+            for (unsigned int ihit3 : hits3) {
 
-                hitvec.clear();
-                hitvec.push_back(phit1);
-                hitvec.push_back(phit2);
-                bool h12ok = compatible(detProp, hitvec, useMC);
-                if (h12ok) {
+              // Check time difference of third hit compared to first two hits.
 
-                  // Get oblique coordinate of second hit.
+              double t3 = p3.time[ihit3];
+              bool dt123ok = std::abs(t1 - t3) <= fMaxDT && std::abs(t2 - t3) <= fMaxDT;
+              if (!dt123ok) continue;
 
-                  double u2 = wire2 * pitch2 + dist2;
+              // Get oblique coordinate of third hit and check spatial separation.
 
-                  // Predict plane3 oblique coordinate and wire number.
+              double u3 = p3.wire[ihit3] * p3.pitch + p3.offset;
+              double S = s23 * u1 + s31 * u2 + s12 * u3;
+              bool sok = std::abs(S) <= fMaxS;
+              if (!sok) continue;
 
-                  double u3pred = (-u1 * s23 - u2 * s31) / s12;
-                  double w3pred = (u3pred - dist3) / pitch3;
-                  double w3delta = std::abs(fMaxS / (s12 * pitch3));
-                  int w3min = std::max(0., std::ceil(w3pred - w3delta));
-                  int w3max = std::max(0., std::floor(w3pred + w3delta));
+              // Test triplet for compatibility.
 
-                  std::map<unsigned int, art::Ptr<recob::Hit>>::const_iterator
-                    ihit3 = hitmap[cstat][tpc][plane3].lower_bound(w3min),
-                    ihit3end = hitmap[cstat][tpc][plane3].upper_bound(w3max);
+              HitCombination comb{3, {plane1, plane2, plane3}, {ihit1, ihit2, ihit3}};
+              if (tripletCompatible(tpcHits, comb)) tpcCombinations.push_back(comb);
+            }
+          }
+        }
+      } // end if fMinViews <= 3
+    };
 
-                  for (; ihit3 != ihit3end; ++ihit3) {
+    // The compatibility test with mc information is not thread safe.
 
-                    int wire3 = ihit3->first;
-                    const art::Ptr<recob::Hit>& phit3 = ihit3->second;
+    if (fRunParallel && !useMC) {
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0, tpcids.size(), 1),
+                        [&](const tbb::blocked_range<std::size_t>& range) {
+                          for (std::size_t itpc = range.begin(); itpc < range.end(); ++itpc)
+                            findCombinations(itpc);
+                        });
+    }
+    else {
+      for (std::size_t itpc = 0; itpc < tpcids.size(); ++itpc)
+        findCombinations(itpc);
+    }
 
-                    // Get corrected time of third hit.
+    // Make empty multimap from hit pointer on preferred
+    // (most-populated or collection) plane to space points that
+    // include that hit (used for sorting, filtering, and
+    // merging).
 
-                    double t3 = phit3->PeakTime() - TicksOffset3;
+    typedef const recob::Hit* sptkey_type;
+    std::multimap<sptkey_type, recob::SpacePoint> sptmap;
+    std::set<sptkey_type> sptkeys; // Keys of multimap.
 
-                    // Check time difference of third hit compared to first two hits.
+    // Loop over TPCs.
+    for (std::size_t itpc = 0; itpc < tpcids.size(); ++itpc) {
+      geo::TPCID const& tpcid = tpcids[itpc];
+      const std::vector<PlaneHits>& tpcHits = hitmap[tpcid.Cryostat][tpcid.TPC];
+
+      // Add a space point for each compatible combination of hits.
+
+      art::PtrVector<recob::Hit> hitvec;
+      hitvec.reserve(3);
+
+      for (const HitCombination& comb : combinations[itpc]) {
+        hitvec.clear();
+        for (unsigned int k = 0; k < comb.nhits; ++k)
+          hitvec.push_back(tpcHits[comb.plane[k]].hits[comb.hit[k]]);
+
+        // make a dummy vector of recob::SpacePoints
+        // as we are filtering or merging and don't want to
+        // add the created SpacePoint to the final collection just yet
+        // This dummy vector will hold just one recob::SpacePoint,
+        // which will go into the multimap and then the vector
+        // will go out of scope.
+
+        std::vector<recob::SpacePoint> sptv;
+        if (comb.nhits == 2) {
+          ++n2;
+          fillSpacePoint(detProp, hitvec, sptv, sptmap.size());
+        }
+        else {
+          ++n3;
+          fillSpacePoint(detProp, hitvec, sptv, sptmap.size() - 1);
+        }
+        sptkey_type key = &*hitvec.back();
+        sptmap.insert(std::pair<sptkey_type, recob::SpacePoint>(key, sptv.back()));
+        sptkeys.insert(key);
+      }
 
-                    bool dt123ok = std::abs(t1 - t3) <= fMaxDT && std::abs(t2 - t3) <= fMaxDT;
-                    if (dt123ok) {
+      // Do Filtering.
 
-                      // Get oblique coordinate of third hit and check spatial separation.
+      if (fFilter) {
 
-                      double u3 = wire3 * pitch3 + dist3;
-                      double S = s23 * u1 + s31 * u2 + s12 * u3;
-                      bool sok = std::abs(S) <= fMaxS;
-                      if (sok) {
+        // Transfer (some) space points from sptmap to spts.
 
-                        // Test triplet for compatibility.
+        spts.reserve(spts.size() + sptkeys.size());
 
-                        hitvec.clear();
-                        hitvec.push_back(phit1);
-                        hitvec.push_back(phit2);
-                        hitvec.push_back(phit3);
-                        bool h123ok = compatible(detProp, hitvec, useMC);
-                        if (h123ok) {
+        // Loop over keys of space point map.
+        // Space points that have the same key are candidates for filtering.
 
-                          // Add a space point.
+        for (std::set<sptkey_type>::const_iterator i = sptkeys.begin(); i != sptkeys.end(); ++i) {
+          sptkey_type key = *i;
 
-                          ++n3;
+          // Loop over space points corresponding to the current key.
+          // Choose the single best space point from among this group.
 
-                          // make a dummy vector of recob::SpacePoints
-                          // as we are filtering or merging and don't want to
-                          // add the created SpacePoint to the final collection just yet
-                          // This dummy vector will hold just one recob::SpacePoint,
-                          // which will go into the multimap and then the vector
-                          // will go out of scope.
+          double best_chisq = 0.;
+          const recob::SpacePoint* best_spt = 0;
 
-                          std::vector<recob::SpacePoint> sptv;
-                          fillSpacePoint(detProp, hitvec, sptv, sptmap.size() - 1);
-                          sptkey_type key = &*phit3;
-                          sptmap.insert(
-                            std::pair<sptkey_type, recob::SpacePoint>(key, sptv.back()));
-                          sptkeys.insert(key);
-                        }
-                      }
-                    }
-                  }
-                }
-              }
+          for (std::multimap<sptkey_type, recob::SpacePoint>::const_iterator j =
+                 sptmap.lower_bound(key);
+               j != sptmap.upper_bound(key);
+               ++j) {
+            const recob::SpacePoint& spt = j->second;
+            if (best_spt == 0 || spt.Chisq() < best_chisq) {
+              best_spt = &spt;
+              best_chisq = spt.Chisq();
             }
           }
-        } // end if fMinViews <= 3
-
-        // Do Filtering.
-
-        if (fFilter) {
-
-          // Transfer (some) space points from sptmap to spts.
-
-          spts.reserve(spts.size() + sptkeys.size());
-
-          // Loop over keys of space point map.
-          // Space points that have the same key are candidates for filtering.
-
-          for (std::set<sptkey_type>::const_iterator i = sptkeys.begin(); i != sptkeys.end(); ++i) {
-            sptkey_type key = *i;
-
-            // Loop over space points corresponding to the current key.
-            // Choose the single best space point from among this group.
-
-            double best_chisq = 0.;
-            const recob::SpacePoint* best_spt = 0;
-
-            for (std::multimap<sptkey_type, recob::SpacePoint>::const_iterator j =
-                   sptmap.lower_bound(key);
-                 j != sptmap.upper_bound(key);
-                 ++j) {
-              const recob::SpacePoint& spt = j->second;
-              if (best_spt == 0 || spt.Chisq() < best_chisq) {
-                best_spt = &spt;
-                best_chisq = spt.Chisq();
-              }
-            }
 
-            // Transfer best filtered space point to result vector.
+          // Transfer best filtered space point to result vector.
 
-            if (!best_spt)
-              throw cet::exception("SpacePointAlg") << "makeSpacePoints(): no best point\n";
-            spts.push_back(*best_spt);
-            if (fMinViews <= 2)
-              ++n2filt;
-            else
-              ++n3filt;
-          }
-        } // end if filtering
+          if (!best_spt)
+            throw cet::exception("SpacePointAlg") << "makeSpacePoints(): no best point\n";
+          spts.push_back(*best_spt);
+          if (fMinViews <= 2)
+            ++n2filt;
+          else
+            ++n3filt;
+        }
+      } // end if filtering
 
-        // Do merging.
+      // Do merging.
 
-        else if (fMerge) {
+      else if (fMerge) {
 
-          // Transfer merged space points from sptmap to spts.
+        // Transfer merged space points from sptmap to spts.
 
-          spts.reserve(spts.size() + sptkeys.size());
+        spts.reserve(spts.size() + sptkeys.size());
 
-          // Loop over keys of space point map.
-          // Space points that have the same key are candidates for merging.
+        // Loop over keys of space point map.
+        // Space points that have the same key are candidates for merging.
 
-          for (std::set<sptkey_type>::const_iterator i = sptkeys.begin(); i != sptkeys.end(); ++i) {
-            sptkey_type key = *i;
+        for (std::set<sptkey_type>::const_iterator i = sptkeys.begin(); i != sptkeys.end(); ++i) {
+          sptkey_type key = *i;
 
-            // Loop over space points corresponding to the current key.
-            // Make a collection of hits that is the union of the hits
-            // from each candidate space point.
+          // Loop over space points corresponding to the current key.
+          // Make a collection of hits that is the union of the hits
+          // from each candidate space point.
 
-            std::multimap<sptkey_type, recob::SpacePoint>::const_iterator jSPT =
-                                                                            sptmap.lower_bound(key),
-                                                                          jSPTend =
-                                                                            sptmap.upper_bound(key);
+          std::multimap<sptkey_type, recob::SpacePoint>::const_iterator jSPT =
+                                                                          sptmap.lower_bound(key),
+                                                                        jSPTend =
+                                                                          sptmap.upper_bound(key);
 
-            art::PtrVector<recob::Hit> merged_hits;
-            for (; jSPT != jSPTend; ++jSPT) {
-              const recob::SpacePoint& spt = jSPT->second;
+          art::PtrVector<recob::Hit> merged_hits;
+          for (; jSPT != jSPTend; ++jSPT) {
+            const recob::SpacePoint& spt = jSPT->second;
 
-              // Loop over hits from this space points.
-              // Add each hit to the collection of all hits.
+            // Loop over hits from this space points.
+            // Add each hit to the collection of all hits.
 
-              const art::PtrVector<recob::Hit>& spt_hits = getAssociatedHits(spt);
-              merged_hits.reserve(merged_hits.size() +
-                                  spt_hits.size()); // better than nothing, but not ideal
-              for (art::PtrVector<recob::Hit>::const_iterator k = spt_hits.begin();
-                   k != spt_hits.end();
-                   ++k) {
-                const art::Ptr<recob::Hit>& hit = *k;
-                merged_hits.push_back(hit);
-              }
+            const art::PtrVector<recob::Hit>& spt_hits = getAssociatedHits(spt);
+            merged_hits.reserve(merged_hits.size() +
+                                spt_hits.size()); // better than nothing, but not ideal
+            for (art::PtrVector<recob::Hit>::const_iterator k = spt_hits.begin();
+                 k != spt_hits.end();
+                 ++k) {
+              const art::Ptr<recob::Hit>& hit = *k;
+              merged_hits.push_back(hit);
             }
+          }
 
-            // Remove duplicates.
+          // Remove duplicates.
 
-            std::sort(merged_hits.begin(), merged_hits.end());
-            art::PtrVector<recob::Hit>::iterator it =
-              std::unique(merged_hits.begin(), merged_hits.end());
-            merged_hits.erase(it, merged_hits.end());
+          std::sort(merged_hits.begin(), merged_hits.end());
+          art::PtrVector<recob::Hit>::iterator it =
+            std::unique(merged_hits.begin(), merged_hits.end());
+          merged_hits.erase(it, merged_hits.end());
 
-            // Construct a complex space points using merged hits.
+          // Construct a complex space points using merged hits.
 
-            fillComplexSpacePoint(detProp, merged_hits, spts, sptmap.size() + spts.size() - 1);
+          fillComplexSpacePoint(detProp, merged_hits, spts, sptmap.size() + spts.size() - 1);
 
-            if (fMinViews <= 2)
-              ++n2filt;
-            else
-              ++n3filt;
-          }
-        } // end if merging
+          if (fMinViews <= 2)
+            ++n2filt;
+          else
+            ++n3filt;
+        }
+      } // end if merging
 
-        // No filter, no merge.
+      // No filter, no merge.
 
-        else {
+      else {
 
-          // Transfer all space points from sptmap to spts.
+        // Transfer all space points from sptmap to spts.
 
-          spts.reserve(spts.size() + sptkeys.size());
+        spts.reserve(spts.size() + sptkeys.size());
 
-          // Loop over space points.
+        // Loop over space points.
 
-          for (std::multimap<sptkey_type, recob::SpacePoint>::const_iterator j = sptmap.begin();
-               j != sptmap.end();
-               ++j) {
-            const recob::SpacePoint& spt = j->second;
-            spts.push_back(spt);
-          }
+        for (std::multimap<sptkey_type, recob::SpacePoint>::const_iterator j = sptmap.begin();
+             j != sptmap.end();
+             ++j) {
+          const recob::SpacePoint& spt = j->second;
+          spts.push_back(spt);
+        }
 
-          // Update statistics.
+        // Update statistics.
 
-          n2filt = n2;
-          n3filt = n3;
-        }
-      } // end loop over tpcs
-    }   // end loop over cryostats
+        n2filt = n2;
+        n3filt = n3;
+      }
+    } // end loop over tpcs
 
     if (mf::isDebugEnabled()) {
       debug << "\n2-hit space points = " << n2 << "\n"
@@ -22,6 +22,7 @@
 /// Merge - Merge space points flag.
 /// PreferColl - Collection view will be used for filtering and merging, and
 ///              space points will be sorted by collection wire.
+/// RunParallel - Search the TPCs for compatible hits concurrently.
 ///
 /// The parameters fMaxDT and fMaxS are used to implement a notion of whether
 /// the input hits are compatible with being a space point.  Parameter
@@ -213,6 +214,7 @@ namespace trkf {
     double fTickOffsetU; ///< Tick offset for plane U.
     double fTickOffsetV; ///< Tick offset for plane V.
     double fTickOffsetW; ///< Tick offset for plane W.
+    bool fRunParallel;   ///< Search the TPCs concurrently.
 
     // Temporary variables.
 
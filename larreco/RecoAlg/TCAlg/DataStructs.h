@@ -12,6 +12,8 @@
 // C/C++ standard libraries
 #include <array>
 #include <bitset>
+#include <climits>
+#include <mutex>
 #include <vector>
 
 // LArSoft libraries
@@ -639,18 +641,24 @@ namespace tca {
     unsigned int eventsProcessed;
     std::vector<float> aveHitRMS; ///< average RMS of an isolated hit
     std::vector<TCWireIntersection> wireIntersections;
-    int WorkID;
-    int globalT_UID;
-    int globalP_UID;
-    int global2V_UID;
-    int global3V_UID;
-    int global2S_UID;
-    int global3S_UID;
+    unsigned int wireIntersectionsTPC{UINT_MAX}; ///< the TPC that wireIntersections were found in
+    std::mutex wireIntersectionsMutex; ///< guards the filling of wireIntersections
     bool aveHitRMSValid{false}; ///< set true when the average hit RMS is well-known
     bool expectSlicedHits{
       false}; ///< info passed from the module - used to (not) define wireHitRange
   };
 
+  // Work ID and unique ID counters
+  struct TCIDs {
+    int WorkID{0};
+    int globalT_UID{0};
+    int globalP_UID{0};
+    int global2V_UID{0};
+    int global3V_UID{0};
+    int global2S_UID{0};
+    int global3S_UID{0};
+  };
+
   struct TCSlice {
     std::vector<unsigned int> nWires;
     std::vector<unsigned int> firstWire; ///< the first wire with a hit
@@ -682,18 +690,26 @@ namespace tca {
     std::vector<DontClusterStruct>
       dontCluster;                       // pairs of Tjs that shouldn't clustered in one shower
     std::vector<ShowerStruct3D> showers; // 3D showers
-    bool isValid{false};                 // set false if this slice failed reconstruction
+    // The variables below are only used while the slice is reconstructed
+    TCIDs ids;                    ///< the ID counters, continued from the previous slice
+    std::vector<TjForecast> tjfs; ///< forecasts made while stepping a Tj
+    std::vector<TrajPoint> seeds; ///< seed TPs saved before reverse propagation
+    bool isValid{false};          // set false if this slice failed reconstruction
   };
 
-  extern TCEvent evt;
-  extern TCConfig tcc;
-  extern ShowerTreeVars stv;
-  extern std::vector<TjForecast> tjfs;
-
-  // vector of hits, tjs, etc in each slice
-  extern std::vector<TCSlice> slices;
-  // vector of seed TPs
-  extern std::vector<TrajPoint> seeds;
+  // The state used to reconstruct one event, passed to every function that needs it.
+  // The configuration, the event inputs and the shower tree variables belong to the
+  // TrajClusterAlg, which outlives the event. The slices are reconstructed using only
+  // their own TCSlice, so that they can be reconstructed concurrently. The event ID
+  // counters and the vector of slices are updated when a slice is finished
+  struct TCContext {
+    TCConfig& tcc;
+    TCEvent& evt;
+    ShowerTreeVars& stv;
+    TCIDs ids;
+    // vector of hits, tjs, etc in each slice
+    std::vector<TCSlice> slices;
+  };
 
 } // namespace tca
 
@@ -14,7 +14,9 @@
 #include <iostream>
 #include <limits.h>
 #include <limits>
+#include <mutex>
 #include <stdlib.h>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -34,42 +36,46 @@
 #include "larreco/RecoAlg/TCAlg/Utils.h"
 #include "nusimdata/SimulationBase/MCParticle.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
 namespace tca {
 
   /////////////////////////////////////////
   void
-  StitchPFPs()
+  StitchPFPs(TCContext& tcx)
   {
     // Stitch PFParticles in different TPCs. This does serious damage to PFPStruct and should
     // only be called from TrajCluster module just before making PFParticles to put in the event
-    if (slices.size() < 2) return;
-    if (tcc.geom->NTPC() == 1) return;
-    if (tcc.pfpStitchCuts.size() < 2) return;
-    if (tcc.pfpStitchCuts[0] <= 0) return;
+    if (tcx.slices.size() < 2) return;
+    if (tcx.tcc.geom->NTPC() == 1) return;
+    if (tcx.tcc.pfpStitchCuts.size() < 2) return;
+    if (tcx.tcc.pfpStitchCuts[0] <= 0) return;
 
-    bool prt = tcc.dbgStitch;
+    bool prt = tcx.tcc.dbgStitch;
 
     if (prt) {
       mf::LogVerbatim myprt("TC");
       std::string fcnLabel = "SP";
-      myprt << fcnLabel << " cuts " << sqrt(tcc.pfpStitchCuts[0]) << " " << tcc.pfpStitchCuts[1]
-            << "\n";
+      myprt << fcnLabel << " cuts " << sqrt(tcx.tcc.pfpStitchCuts[0]) << " "
+            << tcx.tcc.pfpStitchCuts[1] << "\n";
       bool printHeader = true;
-      for (size_t isl = 0; isl < slices.size(); ++isl) {
+      for (size_t isl = 0; isl < tcx.slices.size(); ++isl) {
         if (debug.Slice >= 0 && int(isl) != debug.Slice) continue;
-        auto& slc = slices[isl];
+        auto& slc = tcx.slices[isl];
         if (slc.pfps.empty()) continue;
         for (auto& pfp : slc.pfps)
-          PrintP(fcnLabel, myprt, pfp, printHeader);
+          PrintP(fcnLabel, myprt, tcx, slc, isl, pfp, printHeader);
       } // slc
     }   // prt
 
     // lists of pfp UIDs to stitch
     std::vector<std::vector<int>> stLists;
-    for (std::size_t sl1 = 0; sl1 < slices.size() - 1; ++sl1) {
-      auto& slc1 = slices[sl1];
-      for (std::size_t sl2 = sl1 + 1; sl2 < slices.size(); ++sl2) {
-        auto& slc2 = slices[sl2];
+    for (std::size_t sl1 = 0; sl1 < tcx.slices.size() - 1; ++sl1) {
+      auto& slc1 = tcx.slices[sl1];
+      for (std::size_t sl2 = sl1 + 1; sl2 < tcx.slices.size(); ++sl2) {
+        auto& slc2 = tcx.slices[sl2];
         // look for PFParticles in the same recob::Slice
         if (slc1.ID != slc2.ID) continue;
         for (auto& p1 : slc1.pfps) {
@@ -80,8 +86,8 @@ namespace tca {
             if (p2.ID <= 0) continue;
             // Can't stitch shower PFPs
             if (p2.PDGCode == 1111) continue;
-            float maxSep2 = tcc.pfpStitchCuts[0];
-            float maxCth = tcc.pfpStitchCuts[1];
+            float maxSep2 = tcx.tcc.pfpStitchCuts[0];
+            float maxCth = tcx.tcc.pfpStitchCuts[1];
             bool gotit = false;
             for (unsigned short e1 = 0; e1 < 2; ++e1) {
               auto pos1 = PosAtEnd(p1, e1);
@@ -139,9 +145,9 @@ namespace tca {
       std::pair<unsigned short, unsigned short> minZIndx;
       unsigned short minZEnd = 2;
       for (auto puid : stl) {
-        auto slcIndex = GetSliceIndex("P", puid);
+        auto slcIndex = GetSliceIndex(tcx, "P", puid);
         if (slcIndex.first == USHRT_MAX) continue;
-        auto& pfp = slices[slcIndex.first].pfps[slcIndex.second];
+        auto& pfp = tcx.slices[slcIndex.first].pfps[slcIndex.second];
         for (unsigned short end = 0; end < 2; ++end) {
           auto pos = PosAtEnd(pfp, end);
           if (pos[2] < minZ) {
@@ -153,29 +159,29 @@ namespace tca {
       }   // puid
       if (minZEnd > 1) continue;
       // preserve the pfp with the min Z position
-      auto& pfp = slices[minZIndx.first].pfps[minZIndx.second];
+      auto& pfp = tcx.slices[minZIndx.first].pfps[minZIndx.second];
       if (prt) mf::LogVerbatim("TC") << "SP: P" << pfp.UID;
       // add the Tjs in the other slices to it
       for (auto puid : stl) {
         if (puid == pfp.UID) continue;
-        auto sIndx = GetSliceIndex("P", puid);
+        auto sIndx = GetSliceIndex(tcx, "P", puid);
         if (sIndx.first == USHRT_MAX) continue;
-        auto& opfp = slices[sIndx.first].pfps[sIndx.second];
+        auto& opfp = tcx.slices[sIndx.first].pfps[sIndx.second];
         if (prt) mf::LogVerbatim("TC") << " +P" << opfp.UID;
         pfp.TjUIDs.insert(pfp.TjUIDs.end(), opfp.TjUIDs.begin(), opfp.TjUIDs.end());
         if (prt) mf::LogVerbatim();
         // Check for parents and daughters
         if (opfp.ParentUID > 0) {
-          auto pSlcIndx = GetSliceIndex("P", opfp.ParentUID);
-          if (pSlcIndx.first < slices.size()) {
-            auto& parpfp = slices[pSlcIndx.first].pfps[pSlcIndx.second];
+          auto pSlcIndx = GetSliceIndex(tcx, "P", opfp.ParentUID);
+          if (pSlcIndx.first < tcx.slices.size()) {
+            auto& parpfp = tcx.slices[pSlcIndx.first].pfps[pSlcIndx.second];
             std::replace(parpfp.DtrUIDs.begin(), parpfp.DtrUIDs.begin(), opfp.UID, pfp.UID);
           } // valid pSlcIndx
         }   // has a parent
         for (auto dtruid : opfp.DtrUIDs) {
-          auto dSlcIndx = GetSliceIndex("P", dtruid);
-          if (dSlcIndx.first < slices.size()) {
-            auto& dtrpfp = slices[dSlcIndx.first].pfps[dSlcIndx.second];
+          auto dSlcIndx = GetSliceIndex(tcx, "P", dtruid);
+          if (dSlcIndx.first < tcx.slices.size()) {
+            auto& dtrpfp = tcx.slices[dSlcIndx.first].pfps[dSlcIndx.second];
             dtrpfp.ParentUID = pfp.UID;
           } // valid dSlcIndx
         }   // dtruid
@@ -189,13 +195,14 @@ namespace tca {
   void
   FindPFParticles(detinfo::DetectorClocksData const& clockData,
                   detinfo::DetectorPropertiesData const& detProp,
+                  TCContext& tcx,
                   TCSlice& slc)
   {
     // Match Tjs in 3D and create PFParticles
 
-    if (tcc.match3DCuts[0] <= 0) return;
+    if (tcx.tcc.match3DCuts[0] <= 0) return;
 
-    FillWireIntersections(slc);
+    FillWireIntersections(tcx, slc);
 
     // clear the TP -> P assn Tjs so that all are considered
     for (auto& tj : slc.tjs) {
@@ -203,7 +210,7 @@ namespace tca {
         tp.InPFP = 0;
     } // tj
 
-    bool prt = (tcc.dbgPFP && tcc.dbgSlc);
+    bool prt = (tcx.tcc.dbgPFP && tcx.tcc.dbgSlc);
 
     // Match these points in 3D
     std::vector<MatchStruct> matVec;
@@ -215,18 +222,18 @@ namespace tca {
 
     unsigned short maxNit = 2;
     if (slc.nPlanes == 2) maxNit = 1;
-    if (std::nearbyint(tcc.match3DCuts[2]) == 0) maxNit = 1;
+    if (std::nearbyint(tcx.tcc.match3DCuts[2]) == 0) maxNit = 1;
     // fill the mAllTraj vector with TPs if we aren't using SpacePoints
-    if (evt.sptHits.empty()) FillmAllTraj(detProp, slc);
+    if (tcx.evt.sptHits.empty()) FillmAllTraj(detProp, tcx, slc);
     for (unsigned short nit = 0; nit < maxNit; ++nit) {
       matVec.clear();
       if (slc.nPlanes == 3 && nit == 0) {
         // look for match triplets
-        Match3Planes(slc, matVec);
+        Match3Planes(tcx, slc, matVec);
       }
       else {
         // look for match doublets requiring a dead region in the 3rd plane for 3-plane TPCs
-        Match2Planes(slc, matVec);
+        Match2Planes(tcx, slc, matVec);
       }
       if (matVec.empty()) continue;
       if (prt) {
@@ -241,21 +248,21 @@ namespace tca {
           float tpCnt = 0;
           for (auto tid : ms.TjIDs) {
             auto& tj = slc.tjs[tid - 1];
-            tpCnt += NumPtsWithCharge(slc, tj, false);
+            tpCnt += NumPtsWithCharge(tcx, slc, tj, false);
           } // tid
           float frac = ms.Count / tpCnt;
           myprt << " matFrac " << std::fixed << std::setprecision(3) << frac;
           myprt << "\n";
         } // indx
       }   // prt
-      MakePFParticles(clockData, detProp, slc, matVec, nit);
+      MakePFParticles(clockData, detProp, tcx, slc, matVec, nit);
     } // nit
 
     // a last debug print
-    if (tcc.dbgPFP && debug.MVI != UINT_MAX) {
+    if (tcx.tcc.dbgPFP && debug.MVI != UINT_MAX) {
       for (auto& pfp : slc.pfps)
-        if (tcc.dbgPFP && pfp.MVI == debug.MVI)
-          PrintTP3Ds(clockData, detProp, "FPFP", slc, pfp, -1);
+        if (tcx.tcc.dbgPFP && pfp.MVI == debug.MVI)
+          PrintTP3Ds(clockData, detProp, "FPFP", tcx, slc, pfp, -1);
     } // last debug print
 
     slc.mallTraj.resize(0);
@@ -266,6 +273,7 @@ namespace tca {
   void
   MakePFParticles(detinfo::DetectorClocksData const& clockData,
                   detinfo::DetectorPropertiesData const& detProp,
+                  TCContext& tcx,
                   TCSlice& slc,
                   std::vector<MatchStruct> matVec,
                   unsigned short matVec_Iter)
@@ -273,12 +281,12 @@ namespace tca {
     // Makes PFParticles using Tjs listed in matVec
     if (matVec.empty()) return;
 
-    bool prt = (tcc.dbgPFP && tcc.dbgSlc);
+    bool prt = (tcx.tcc.dbgPFP && tcx.tcc.dbgSlc);
 
     // create a PFParticle for each valid match combination
     for (std::size_t indx = 0; indx < matVec.size(); ++indx) {
       // tone down the level of printing in ReSection
-      bool foundMVI = (tcc.dbgPFP && indx == debug.MVI && matVec_Iter == debug.MVI_Iter);
+      bool foundMVI = (tcx.tcc.dbgPFP && indx == debug.MVI && matVec_Iter == debug.MVI_Iter);
       if (foundMVI) prt = true;
       auto& ms = matVec[indx];
       if (foundMVI) {
@@ -301,17 +309,17 @@ namespace tca {
       pfpVec[0].MVI = indx;
       // fill the TP3D points using the 2D trajectory points for Tjs in TjIDs. All
       // points are put in one section
-      if (!MakeTP3Ds(detProp, slc, pfpVec[0], foundMVI)) {
+      if (!MakeTP3Ds(detProp, tcx, slc, pfpVec[0], foundMVI)) {
         if (foundMVI) mf::LogVerbatim("TC") << " MakeTP3Ds failed. Too many points already used ";
         continue;
       }
       // fit all the points to get the general direction
-      if (!FitSection(clockData, detProp, slc, pfpVec[0], 0)) continue;
+      if (!FitSection(clockData, detProp, tcx, slc, pfpVec[0], 0)) continue;
       if (pfpVec[0].SectionFits[0].ChiDOF > 500 && !pfpVec[0].Flags[kSmallAngle]) {
         if (foundMVI)
           mf::LogVerbatim("TC") << " crazy high ChiDOF P" << pfpVec[0].ID << " "
                                 << pfpVec[0].SectionFits[0].ChiDOF << "\n";
-        Recover(clockData, detProp, slc, pfpVec[0], foundMVI);
+        Recover(clockData, detProp, tcx, slc, pfpVec[0], foundMVI);
         continue;
       }
       // sort the points by the distance along the general direction vector
@@ -320,7 +328,8 @@ namespace tca {
       // pfps. A simple 3D line fit will be done. No attempt will be made to reconstruct it
       // in sections or to look for kinks
       npts = pfpVec[0].TP3Ds.size();
-      pfpVec[0].AlgMod[kJunk3D] = (npts < 20 && MCSMom(slc, pfpVec[0].TjIDs) < 50) || (npts < 10);
+      pfpVec[0].AlgMod[kJunk3D] =
+        (npts < 20 && MCSMom(tcx, slc, pfpVec[0].TjIDs) < 50) || (npts < 10);
       if (prt) {
         auto& pfp = pfpVec[0];
         mf::LogVerbatim myprt("TC");
@@ -333,17 +342,18 @@ namespace tca {
         myprt << " projInPlane";
         for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
           CTP_t inCTP = EncodeCTP(pfp.TPCID.Cryostat, pfp.TPCID.TPC, plane);
-          auto tp = MakeBareTP(detProp, slc, pfp.SectionFits[0].Pos, pfp.SectionFits[0].Dir, inCTP);
+          auto tp =
+            MakeBareTP(detProp, tcx, slc, pfp.SectionFits[0].Pos, pfp.SectionFits[0].Dir, inCTP);
           myprt << " " << std::setprecision(2) << tp.Delta;
         } // plane
         myprt << " maxTjLen " << (int)MaxTjLen(slc, pfp.TjIDs);
-        myprt << " MCSMom " << MCSMom(slc, pfp.TjIDs);
-        myprt << " PDGCodeVote " << PDGCodeVote(clockData, detProp, slc, pfp);
+        myprt << " MCSMom " << MCSMom(tcx, slc, pfp.TjIDs);
+        myprt << " PDGCodeVote " << PDGCodeVote(clockData, detProp, tcx, slc, pfp);
         myprt << " nTP3Ds " << pfp.TP3Ds.size();
         myprt << " Reco3DRange "
-              << Find3DRecoRange(slc, pfp, 0, (unsigned short)tcc.match3DCuts[3], 1);
+              << Find3DRecoRange(slc, pfp, 0, (unsigned short)tcx.tcc.match3DCuts[3], 1);
       } // prt
-      if (foundMVI) { PrintTP3Ds(clockData, detProp, "FF", slc, pfpVec[0], -1); }
+      if (foundMVI) { PrintTP3Ds(clockData, detProp, "FF", tcx, slc, pfpVec[0], -1); }
       for (unsigned short ip = 0; ip < pfpVec.size(); ++ip) {
         auto& pfp = pfpVec[ip];
         // set the end flag bits
@@ -352,7 +362,7 @@ namespace tca {
           // first set them all to 0
           pfp.EndFlag[end].reset();
           auto pos = PosAtEnd(pfp, end);
-          if (!InsideTPC(pos, tpcid)) pfp.EndFlag[end][kOutFV] = true;
+          if (!InsideTPC(tcx, pos, tpcid)) pfp.EndFlag[end][kOutFV] = true;
         } // end
         // Set kink flag and create a vertex between this pfp and the previous one that was stored
         if (ip > 0) {
@@ -368,8 +378,8 @@ namespace tca {
           vx3.Wire = -2;
           vx3.ID = slc.vtx3s.size() + 1;
           vx3.Primary = false;
-          ++evt.global3V_UID;
-          vx3.UID = evt.global3V_UID;
+          ++slc.ids.global3V_UID;
+          vx3.UID = slc.ids.global3V_UID;
           slc.vtx3s.push_back(vx3);
           pfp.Vx3ID[0] = vx3.ID;
           auto& prevPFP = slc.pfps[slc.pfps.size() - 1];
@@ -379,42 +389,42 @@ namespace tca {
         // For short pfps, it is possible that a Tj would be too short to be reconstructed
         // in the third plane.
         if (pfp.TjIDs.size() == 2 && slc.nPlanes == 3 && pfp.TP3Ds.size() > 20 &&
-            !ValidTwoPlaneMatch(detProp, slc, pfp)) {
+            !ValidTwoPlaneMatch(detProp, tcx, slc, pfp)) {
           continue;
         }
         // Skip this combination if it isn't reconstructable in 3D
-        if (Find3DRecoRange(slc, pfp, 0, (unsigned short)tcc.match3DCuts[3], 1) == USHRT_MAX)
+        if (Find3DRecoRange(slc, pfp, 0, (unsigned short)tcx.tcc.match3DCuts[3], 1) == USHRT_MAX)
           continue;
         // See if it possible to reconstruct in more than one section
         pfp.Flags[kCanSection] = CanSection(slc, pfp);
         // Do a fit in multiple sections if the initial fit is poor
-        if (pfp.SectionFits[0].ChiDOF < tcc.match3DCuts[5]) {
+        if (pfp.SectionFits[0].ChiDOF < tcx.tcc.match3DCuts[5]) {
           // Good fit with one section
           pfp.Flags[kNeedsUpdate] = false;
         }
         else if (pfp.Flags[kCanSection]) {
-          if (!ReSection(clockData, detProp, slc, pfp, foundMVI)) continue;
+          if (!ReSection(clockData, detProp, tcx, slc, pfp, foundMVI)) continue;
         } // CanSection
-        if (foundMVI) { PrintTP3Ds(clockData, detProp, "RS", slc, pfp, -1); }
+        if (foundMVI) { PrintTP3Ds(clockData, detProp, "RS", tcx, slc, pfp, -1); }
         // FillGaps3D looks for gaps in the TP3Ds vector caused by broken trajectories and
         // inserts new TP3Ds if there are hits in the gaps. This search is only done in a
         // plane if the projection of the pfp results in a large angle where 2D reconstruction
         // is likely to be poor - not true for TCWork2
-        FillGaps3D(clockData, detProp, slc, pfp, foundMVI);
+        FillGaps3D(clockData, detProp, tcx, slc, pfp, foundMVI);
         // Check the TP3D -> TP assn, resolve conflicts and set TP -> InPFP
-        if (!ReconcileTPs(slc, pfp, foundMVI)) continue;
+        if (!ReconcileTPs(tcx, slc, pfp, foundMVI)) continue;
         // Look for mis-placed 2D and 3D vertices
-        ReconcileVertices(slc, pfp, foundMVI);
+        ReconcileVertices(tcx, slc, pfp, foundMVI);
         // Set isGood
         for (auto& tp3d : pfp.TP3Ds) {
           if (tp3d.Flags[kTP3DBad]) continue;
           auto& tp = slc.tjs[tp3d.TjID - 1].Pts[tp3d.TPIndex];
           if (tp.Environment[kEnvOverlap]) tp3d.Flags[kTP3DGood] = false;
         } // tp3d
-        FilldEdx(clockData, detProp, slc, pfp);
-        pfp.PDGCode = PDGCodeVote(clockData, detProp, slc, pfp);
-        if (tcc.dbgPFP && pfp.MVI == debug.MVI)
-          PrintTP3Ds(clockData, detProp, "STORE", slc, pfp, -1);
+        FilldEdx(clockData, detProp, tcx, slc, pfp);
+        pfp.PDGCode = PDGCodeVote(clockData, detProp, tcx, slc, pfp);
+        if (tcx.tcc.dbgPFP && pfp.MVI == debug.MVI)
+          PrintTP3Ds(clockData, detProp, "STORE", tcx, slc, pfp, -1);
         if (!StorePFP(slc, pfp)) break;
       } // ip (iterate over split pfps)
     }   // indx (iterate over matchVec entries)
@@ -423,14 +433,14 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  ReconcileTPs(TCSlice& slc, PFPStruct& pfp, bool prt)
+  ReconcileTPs(TCContext& tcx, TCSlice& slc, PFPStruct& pfp, bool prt)
   {
     // Reconcile TP -> P assns before the pfp is stored. The TP3D -> TP is defined but
     // the TP -> P assn may not have been done. This function overwrites the TjIDs
     // vector to be the list of Tjs that contribute > 80% of their TPs to this pfp.
     // This function returns true if the assns are consistent.
 
-    if (!tcc.useAlg[kRTPs3D]) return true;
+    if (!tcx.tcc.useAlg[kRTPs3D]) return true;
     if(pfp.Flags[kSmallAngle]) return true;
     if (pfp.TjIDs.empty()) return false;
     if (pfp.TP3Ds.empty()) return false;
@@ -457,7 +467,7 @@ namespace tca {
     std::vector<int> nTjIDs;
     for (auto& tjtpcnt : tjTPCnt) {
       auto& tj = slc.tjs[tjtpcnt.first - 1];
-      float npwc = NumPtsWithCharge(slc, tj, false);
+      float npwc = NumPtsWithCharge(tcx, slc, tj, false);
       if (tjtpcnt.second > 0.8 * npwc) nTjIDs.push_back(tjtpcnt.first);
     } // tjtpcnt
     if (prt) { mf::LogVerbatim("TC") << "RTPs3D: P" << pfp.ID << " nTjIDs " << nTjIDs.size(); }
@@ -470,7 +480,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  ReconcileTPs(TCSlice& slc)
+  ReconcileTPs(TCContext& tcx, TCSlice& slc)
   {
     // Reconciles TP ownership conflicts between PFParticles
     // Make a one-to-one TP -> P assn and look for one-to-many assns.
@@ -479,7 +489,7 @@ namespace tca {
     // the order in which they were created. This comparison has been commented out in favor
     // of simply keeping the old assn and removing the new one by setting IsBad true.
 
-    if (!tcc.useAlg[kRTPs3D]) return;
+    if (!tcx.tcc.useAlg[kRTPs3D]) return;
 
     // make a list of T -> P assns
     std::vector<int> TinP;
@@ -509,12 +519,12 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  MakePFPTjs(TCSlice& slc)
+  MakePFPTjs(TCContext& tcx, TCSlice& slc)
   {
     // This function clobbers all of the tjs that are used in TP3Ds in the pfp and replaces
     // them with new tjs that have a consistent set of TPs to prepare for putting them
     // into the event. Note that none of the Tjs are attached to 2D vertices.
-    if (!tcc.useAlg[kMakePFPTjs]) return;
+    if (!tcx.tcc.useAlg[kMakePFPTjs]) return;
 
     // kill trajectories
     std::vector<int> killme;
@@ -528,7 +538,7 @@ namespace tca {
       } // tp3d
     }   // pfp
 
-    bool prt = (tcc.dbgPFP);
+    bool prt = (tcx.tcc.dbgPFP);
 
     for (auto tid : killme)
       MakeTrajectoryObsolete(slc, (unsigned int)(tid - 1));
@@ -554,9 +564,9 @@ namespace tca {
       // initialize the tjs
       for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
         ptjs[plane].Pts.clear();
-        --evt.WorkID;
-        if (evt.WorkID == INT_MIN) evt.WorkID = -1;
-        ptjs[plane].ID = evt.WorkID;
+        --slc.ids.WorkID;
+        if (slc.ids.WorkID == INT_MIN) slc.ids.WorkID = -1;
+        ptjs[plane].ID = slc.ids.WorkID;
       } // plane
       pfp.TjIDs.clear();
       // iterate through all of the TP3Ds, adding TPs to the TJ in the appropriate plane.
@@ -581,8 +591,8 @@ namespace tca {
         auto& tj = ptjs[plane];
         if (tj.Pts.size() < 2) continue;
         tj.PDGCode = pfp.PDGCode;
-        tj.MCSMom = MCSMom(slc, tj);
-        if (!StoreTraj(slc, tj)) continue;
+        tj.MCSMom = MCSMom(tcx, slc, tj);
+        if (!StoreTraj(tcx, slc, tj)) continue;
         // associate it with the pfp
         auto& newTj = slc.tjs.back();
         pfp.TjIDs.push_back(newTj.ID);
@@ -608,17 +618,21 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  FillWireIntersections(TCSlice& slc)
+  FillWireIntersections(TCContext& tcx, TCSlice& slc)
   {
-    // Find wire intersections and put them in evt.wireIntersections
+    // Find wire intersections and put them in evt.wireIntersections. The first slice
+    // in a TPC fills them while holding the lock; slices reconstructed concurrently in
+    // the same TPC wait for it and then only read evt.wireIntersections
+    std::lock_guard<std::mutex> lock(tcx.evt.wireIntersectionsMutex);
 
-    // see if anything needs to be done
-    if (!evt.wireIntersections.empty() && evt.wireIntersections[0].tpc == slc.TPCID.TPC) return;
+    // see if anything needs to be done. This is also the case if no intersection was found
+    if (tcx.evt.wireIntersectionsTPC == slc.TPCID.TPC) return;
 
-    evt.wireIntersections.clear();
+    tcx.evt.wireIntersections.clear();
 
     unsigned int cstat = slc.TPCID.Cryostat;
     unsigned int tpc = slc.TPCID.TPC;
+    tcx.evt.wireIntersectionsTPC = tpc;
     // find the minMax number of wires in each plane of the TPC
     unsigned int maxWire = slc.nWires[0];
     for (auto nw : slc.nWires)
@@ -635,14 +649,15 @@ namespace tca {
         // find two wires that have a valid intersection
         for (unsigned int wire = firstWire; wire < maxWire; ++wire) {
           double y00, z00;
-          if (!tcc.geom->IntersectionPoint(wire, wire, pln1, pln2, cstat, tpc, y00, z00)) continue;
+          if (!tcx.tcc.geom->IntersectionPoint(wire, wire, pln1, pln2, cstat, tpc, y00, z00))
+            continue;
           // increment by one wire in pln1 and find another valid intersection
           double y10, z10;
-          if (!tcc.geom->IntersectionPoint(wire + 10, wire, pln1, pln2, cstat, tpc, y10, z10))
+          if (!tcx.tcc.geom->IntersectionPoint(wire + 10, wire, pln1, pln2, cstat, tpc, y10, z10))
             continue;
           // increment by one wire in pln2 and find another valid intersection
           double y01, z01;
-          if (!tcc.geom->IntersectionPoint(wire, wire + 10, pln1, pln2, cstat, tpc, y01, z01))
+          if (!tcx.tcc.geom->IntersectionPoint(wire, wire + 10, pln1, pln2, cstat, tpc, y01, z01))
             continue;
           TCWireIntersection tcwi;
           tcwi.tpc = tpc;
@@ -656,7 +671,7 @@ namespace tca {
           tcwi.dzdw1 = (z10 - z00) / 10;
           tcwi.dydw2 = (y01 - y00) / 10;
           tcwi.dzdw2 = (z01 - z00) / 10;
-          evt.wireIntersections.push_back(tcwi);
+          tcx.evt.wireIntersections.push_back(tcwi);
           break;
         } // wire
       }   // pln2
@@ -665,7 +680,7 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  TCIntersectionPoint(unsigned int wir1,
+  TCIntersectionPoint(TCContext& tcx, unsigned int wir1,
                       unsigned int wir2,
                       unsigned int pln1,
                       unsigned int pln2,
@@ -674,7 +689,7 @@ namespace tca {
   {
     // A TrajCluster analog of geometry IntersectionPoint that uses local wireIntersections with
     // float precision. The (y,z) position is only used to match TPs between planes - not for 3D fitting
-    if (evt.wireIntersections.empty()) return false;
+    if (tcx.evt.wireIntersections.empty()) return false;
     if (pln1 == pln2) return false;
 
     if (pln1 > pln2) {
@@ -682,7 +697,7 @@ namespace tca {
       std::swap(wir1, wir2);
     }
 
-    for (auto& wi : evt.wireIntersections) {
+    for (auto& wi : tcx.evt.wireIntersections) {
       if (wi.pln1 != pln1) continue;
       if (wi.pln2 != pln2) continue;
       // estimate the position using the wire differences
@@ -697,13 +712,13 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  Match3PlanesSpt(TCSlice& slc, std::vector<MatchStruct>& matVec)
+  Match3PlanesSpt(TCContext& tcx, TCSlice& slc, std::vector<MatchStruct>& matVec)
   {
     // fill matVec using SpacePoint -> Hit -> TP -> tj assns
-    if (evt.sptHits.empty()) return;
+    if (tcx.evt.sptHits.empty()) return;
 
     // create a local vector of allHit -> Tj assns and populate it
-    std::vector<int> inTraj((*evt.allHits).size(), 0);
+    std::vector<int> inTraj((*tcx.evt.allHits).size(), 0);
     for (auto& tch : slc.slHits)
       inTraj[tch.allHitsIndex] = tch.InTraj;
 
@@ -715,16 +730,16 @@ namespace tca {
     std::vector<unsigned short> mCnt;
     // ignore Tj matches after hitting a user-defined limit
     unsigned short maxCnt = USHRT_MAX;
-    if (tcc.match3DCuts[1] < (float)USHRT_MAX) maxCnt = (unsigned short)tcc.match3DCuts[1];
+    if (tcx.tcc.match3DCuts[1] < (float)USHRT_MAX) maxCnt = (unsigned short)tcx.tcc.match3DCuts[1];
     // a list of those Tjs
     std::vector<unsigned short> tMaxed;
 
     unsigned int tpc = slc.TPCID.TPC;
 
-    for (auto& sptHits : evt.sptHits) {
+    for (auto& sptHits : tcx.evt.sptHits) {
       if (sptHits.size() != 3) continue;
       // ensure that the SpacePoint is in the requested TPC
-      if (!SptInTPC(sptHits, tpc)) continue;
+      if (!SptInTPC(tcx, sptHits, tpc)) continue;
       unsigned short cnt = 0;
       for (unsigned short plane = 0; plane < 3; ++plane) {
         unsigned int iht = sptHits[plane];
@@ -761,7 +776,7 @@ namespace tca {
       float minTPCnt = USHRT_MAX;
       for (auto tid : tIDs) {
         auto& tj = slc.tjs[tid - 1];
-        float tpcnt = NumPtsWithCharge(slc, tj, false);
+        float tpcnt = NumPtsWithCharge(tcx, slc, tj, false);
         if (tpcnt < minTPCnt) minTPCnt = tpcnt;
       } // tid
       float frac = (float)mCnt[indx] / minTPCnt;
@@ -789,7 +804,7 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  SptInTPC(const std::array<unsigned int, 3>& sptHits, unsigned int tpc)
+  SptInTPC(TCContext& tcx, const std::array<unsigned int, 3>& sptHits, unsigned int tpc)
   {
     // returns true if a hit referenced in sptHits resides in the requested tpc. We assume
     // that if one does, then all of them do
@@ -800,9 +815,9 @@ namespace tca {
         ahi = ii;
         break;
       }
-    if (ahi >= (*evt.allHits).size()) return false;
+    if (ahi >= (*tcx.evt.allHits).size()) return false;
     // get a reference to the hit and see if it is in the desired tpc
-    auto& hit = (*evt.allHits)[ahi];
+    auto& hit = (*tcx.evt.allHits)[ahi];
     if (hit.WireID().TPC == tpc) return true;
     return false;
 
@@ -810,99 +825,159 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  Match3Planes(TCSlice& slc, std::vector<MatchStruct>& matVec)
+  Match3Planes(TCContext& tcx, TCSlice& slc, std::vector<MatchStruct>& matVec)
   {
     // A simpler and faster version of MatchPlanes that only creates three plane matches
 
     if (slc.nPlanes != 3) return;
 
     // use SpacePoint -> Hit -> TP assns?
-    if (!evt.sptHits.empty()) {
-      Match3PlanesSpt(slc, matVec);
+    if (!tcx.evt.sptHits.empty()) {
+      Match3PlanesSpt(tcx, slc, matVec);
       return;
     }
 
     if (slc.mallTraj.empty()) return;
-    float xcut = tcc.match3DCuts[0];
-    double yzcut = 1.5 * tcc.wirePitch;
+    double yzcut = 1.5 * tcx.tcc.wirePitch;
+    auto const& mallTraj = slc.mallTraj;
+    std::size_t const npts = mallTraj.size();
+
+    // the wire of each point when it starts a match (rounded) and when it is matched to
+    // the starting point (truncated), and the points in each plane in x order
+    std::vector<unsigned int> firstWire(npts), otherWire(npts);
+    std::array<std::vector<unsigned int>, 3> planePts;
+    for (std::size_t ipt = 0; ipt < npts; ++ipt) {
+      auto& tjPt = mallTraj[ipt];
+      auto& tp = slc.tjs[tjPt.id - 1].Pts[tjPt.ipt];
+      firstWire[ipt] = std::nearbyint(tp.Pos[0]);
+      otherWire[ipt] = tp.Pos[0];
+      if (tjPt.plane < 3) planePts[tjPt.plane].push_back(ipt);
+    } // ipt
+    // the wire intersection that TCIntersectionPoint uses for each pair of planes
+    std::array<std::array<TCWireIntersection const*, 3>, 3> planeWI{};
+    for (auto& wi : tcx.evt.wireIntersections) {
+      if (wi.pln1 >= wi.pln2 || wi.pln2 > 2) continue;
+      if (!planeWI[wi.pln1][wi.pln2]) planeWI[wi.pln1][wi.pln2] = &wi;
+    } // wi
 
     // the TJ IDs for one match
     std::array<unsigned short, 3> tIDs;
-    // vector for matched Tjs
+    // vector for matched Tjs, with the index of each one
     std::vector<std::array<unsigned short, 3>> mtIDs;
+    std::unordered_map<unsigned long long, unsigned int> mtIndex;
     // and a matching vector for the count
     std::vector<unsigned short> mCnt;
     // ignore Tj matches after hitting a user-defined limit
     unsigned short maxCnt = USHRT_MAX;
-    if (tcc.match3DCuts[1] < (float)USHRT_MAX) maxCnt = (unsigned short)tcc.match3DCuts[1];
-    // a list of those Tjs
-    std::vector<unsigned short> tMaxed;
-
-    for (std::size_t ipt = 0; ipt < slc.mallTraj.size() - 1; ++ipt) {
-      auto& iTjPt = slc.mallTraj[ipt];
-      // see if we hit the maxCnt limit
-      if (std::find(tMaxed.begin(), tMaxed.end(), iTjPt.id) != tMaxed.end()) continue;
-      auto& itp = slc.tjs[iTjPt.id - 1].Pts[iTjPt.ipt];
+    if (tcx.tcc.match3DCuts[1] < (float)USHRT_MAX) maxCnt = (unsigned short)tcx.tcc.match3DCuts[1];
+    // flags for those Tjs, indexed by Tj ID
+    std::vector<bool> tMaxed(slc.tjs.size() + 1, false);
+
+    // Finds the points (jpt, kpt) in the other two planes that match ipt, in the order of
+    // the loops over mallTraj. Points of Tjs that are already maxed out are skipped
+    auto findMatches = [&](std::size_t ipt,
+                           std::vector<Point2_t>& ijPos,
+                           std::vector<char>& inter,
+                           std::vector<std::pair<unsigned int, unsigned int>>& matches) {
+      matches.clear();
+      auto& iTjPt = mallTraj[ipt];
+      if (tMaxed[iTjPt.id]) return;
       unsigned int iPlane = iTjPt.plane;
-      unsigned int iWire = std::nearbyint(itp.Pos[0]);
-      tIDs[iPlane] = iTjPt.id;
-      bool hitMaxCnt = false;
-      for (std::size_t jpt = ipt + 1; jpt < slc.mallTraj.size() - 1; ++jpt) {
-        auto& jTjPt = slc.mallTraj[jpt];
-        // ensure that the planes are different
-        if (jTjPt.plane == iTjPt.plane) continue;
-        // check for x range overlap. We know that jTjPt.xlo is >= iTjPt.xlo because of the sort
-        if (jTjPt.xlo > iTjPt.xhi) continue;
-        // break out if the x range difference becomes large
-        if (jTjPt.xlo > iTjPt.xhi + xcut) break;
+      unsigned int iWire = firstWire[ipt];
+      // the points that overlap in x. We know that xlo is >= iTjPt.xlo because of the sort
+      std::size_t const end =
+        std::upper_bound(mallTraj.begin() + ipt + 1,
+                         mallTraj.end(),
+                         iTjPt.xhi,
+                         [](float xhi, Tj2Pt const& tjPt) { return xhi < tjPt.xlo; }) -
+        mallTraj.begin();
+      // intersect them with the wire of ipt, as TCIntersectionPoint does
+      ijPos.resize(end - ipt);
+      inter.assign(end - ipt, false);
+      for (std::size_t jpt = ipt + 1; jpt < end; ++jpt) {
+        auto& jTjPt = mallTraj[jpt];
+        if (jTjPt.plane == iPlane || tMaxed[jTjPt.id]) continue;
+        unsigned int wir1 = iWire, wir2 = otherWire[jpt];
+        unsigned int pln1 = iPlane, pln2 = jTjPt.plane;
+        if (pln1 > pln2) {
+          std::swap(pln1, pln2);
+          std::swap(wir1, wir2);
+        }
+        if (pln2 > 2) continue;
+        auto wi = planeWI[pln1][pln2];
+        if (!wi) continue;
+        // estimate the position using the wire differences
+        double dw1 = wir1 - wi->wir1;
+        double dw2 = wir2 - wi->wir2;
+        auto& pos = ijPos[jpt - ipt];
+        pos[0] = (float)(wi->y + dw1 * wi->dydw1 + dw2 * wi->dydw2);
+        pos[1] = (float)(wi->z + dw1 * wi->dzdw1 + dw2 * wi->dzdw2);
+        inter[jpt - ipt] = true;
+      } // jpt
+      for (std::size_t jpt = ipt + 1; jpt < end && jpt < npts - 1; ++jpt) {
+        if (!inter[jpt - ipt]) continue;
+        unsigned short kPlane = 3 - iPlane - mallTraj[jpt].plane;
+        auto& kPts = planePts[kPlane];
+        auto& jPos = ijPos[jpt - ipt];
+        for (auto kk = std::upper_bound(kPts.begin(), kPts.end(), jpt); kk != kPts.end(); ++kk) {
+          std::size_t kpt = *kk;
+          if (kpt >= end) break;
+          if (!inter[kpt - ipt]) continue;
+          auto& kPos = ijPos[kpt - ipt];
+          if (std::abs(jPos[0] - kPos[0]) > yzcut) continue;
+          if (std::abs(jPos[1] - kPos[1]) > yzcut) continue;
+          matches.emplace_back(jpt, kpt);
+        } // kk
+      }   // jpt
+    };    // findMatches
+
+    // The matches of a block of points are found concurrently and then counted in order,
+    // since the Tjs that reach maxCnt are not considered afterwards
+    constexpr std::size_t blockSize = 1024;
+    std::vector<std::vector<std::pair<unsigned int, unsigned int>>> blockMatches(blockSize);
+    for (std::size_t first = 0; first < npts - 1; first += blockSize) {
+      std::size_t const last = std::min(first + blockSize, npts - 1);
+      tbb::this_task_arena::isolate([&] {
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(first, last, 16),
+                          [&](tbb::blocked_range<std::size_t> const& range) {
+                            std::vector<Point2_t> ijPos;
+                            std::vector<char> inter;
+                            for (std::size_t ipt = range.begin(); ipt < range.end(); ++ipt)
+                              findMatches(ipt, ijPos, inter, blockMatches[ipt - first]);
+                          });
+      });
+      for (std::size_t ipt = first; ipt < last; ++ipt) {
+        auto& iTjPt = mallTraj[ipt];
         // see if we hit the maxCnt limit
-        if (std::find(tMaxed.begin(), tMaxed.end(), jTjPt.id) != tMaxed.end()) continue;
-        auto& jtp = slc.tjs[jTjPt.id - 1].Pts[jTjPt.ipt];
-        unsigned short jPlane = jTjPt.plane;
-        unsigned int jWire = jtp.Pos[0];
-        Point2_t ijPos;
-        if (!TCIntersectionPoint(iWire, jWire, iPlane, jPlane, ijPos[0], ijPos[1])) continue;
-        tIDs[jPlane] = jTjPt.id;
-        for (std::size_t kpt = jpt + 1; kpt < slc.mallTraj.size(); ++kpt) {
-          auto& kTjPt = slc.mallTraj[kpt];
-          // ensure that the planes are different
-          if (kTjPt.plane == iTjPt.plane || kTjPt.plane == jTjPt.plane) continue;
-          if (kTjPt.xlo > iTjPt.xhi) continue;
-          // break out if the x range difference becomes large
-          if (kTjPt.xlo > iTjPt.xhi + xcut) break;
-          // see if we hit the maxCnt limit
-          if (std::find(tMaxed.begin(), tMaxed.end(), kTjPt.id) != tMaxed.end()) continue;
-          auto& ktp = slc.tjs[kTjPt.id - 1].Pts[kTjPt.ipt];
-          unsigned short kPlane = kTjPt.plane;
-          unsigned int kWire = ktp.Pos[0];
-          Point2_t ikPos;
-          if (!TCIntersectionPoint(iWire, kWire, iPlane, kPlane, ikPos[0], ikPos[1])) continue;
-          if (std::abs(ijPos[0] - ikPos[0]) > yzcut) continue;
-          if (std::abs(ijPos[1] - ikPos[1]) > yzcut) continue;
+        if (tMaxed[iTjPt.id]) continue;
+        tIDs[iTjPt.plane] = iTjPt.id;
+        for (auto const& [jpt, kpt] : blockMatches[ipt - first]) {
+          auto& jTjPt = mallTraj[jpt];
+          auto& kTjPt = mallTraj[kpt];
+          if (tMaxed[jTjPt.id] || tMaxed[kTjPt.id]) continue;
           // we have a match
-          tIDs[kPlane] = kTjPt.id;
+          tIDs[jTjPt.plane] = jTjPt.id;
+          tIDs[kTjPt.plane] = kTjPt.id;
           // look for it in the list
-          unsigned int indx = 0;
-          for (indx = 0; indx < mtIDs.size(); ++indx)
-            if (tIDs == mtIDs[indx]) break;
-          if (indx == mtIDs.size()) {
+          unsigned long long key = ((unsigned long long)tIDs[0] << 32) |
+                                   ((unsigned long long)tIDs[1] << 16) | tIDs[2];
+          auto [iIndx, isNew] = mtIndex.emplace(key, mtIDs.size());
+          if (isNew) {
             // not found so add it to mtIDs and add another element to mCnt
             mtIDs.push_back(tIDs);
             mCnt.push_back(0);
           }
+          unsigned int indx = iIndx->second;
           ++mCnt[indx];
           if (mCnt[indx] == maxCnt) {
-            // add the Tjs to the list
-            tMaxed.insert(tMaxed.end(), tIDs[0]);
-            tMaxed.insert(tMaxed.end(), tIDs[1]);
-            tMaxed.insert(tMaxed.end(), tIDs[2]);
-            hitMaxCnt = true;
+            // flag the Tjs
+            for (auto tid : tIDs)
+              tMaxed[tid] = true;
             break;
           } // hit maxCnt
-        }   // kpt
-        if (hitMaxCnt) break;
-      } // jpt
-    }   // ipt
+        }   // match
+      }     // ipt
+    }       // first
 
     if (mCnt.empty()) return;
 
@@ -913,7 +988,7 @@ namespace tca {
       float tpCnt = 0;
       for (auto tid : tIDs) {
         auto& tj = slc.tjs[tid - 1];
-        tpCnt += NumPtsWithCharge(slc, tj, false);
+        tpCnt += NumPtsWithCharge(tcx, slc, tj, false);
       } // tid
       float frac = mCnt[indx] / tpCnt;
       frac /= 3;
@@ -941,7 +1016,7 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  Match2Planes(TCSlice& slc, std::vector<MatchStruct>& matVec)
+  Match2Planes(TCContext& tcx, TCSlice& slc, std::vector<MatchStruct>& matVec)
   {
     // A simpler faster version of MatchPlanes that only creates two plane matches
 
@@ -951,7 +1026,7 @@ namespace tca {
     int cstat = slc.TPCID.Cryostat;
     int tpc = slc.TPCID.TPC;
 
-    float xcut = tcc.match3DCuts[0];
+    float xcut = tcx.tcc.match3DCuts[0];
 
     // the TJ IDs for one match
     std::array<unsigned short, 2> tIDs;
@@ -961,7 +1036,7 @@ namespace tca {
     std::vector<unsigned short> mCnt;
     // ignore Tj matches after hitting a user-defined limit
     unsigned short maxCnt = USHRT_MAX;
-    if (tcc.match3DCuts[1] < (float)USHRT_MAX) maxCnt = (unsigned short)tcc.match3DCuts[1];
+    if (tcx.tcc.match3DCuts[1] < (float)USHRT_MAX) maxCnt = (unsigned short)tcx.tcc.match3DCuts[1];
     // a list of those Tjs
     std::vector<unsigned short> tMaxed;
 
@@ -988,7 +1063,7 @@ namespace tca {
         unsigned int jWire = jtp.Pos[0];
         Point3_t ijPos;
         ijPos[0] = itp.Pos[0];
-        if (!tcc.geom->IntersectionPoint(
+        if (!tcx.tcc.geom->IntersectionPoint(
               iWire, jWire, iPlane, jPlane, cstat, tpc, ijPos[1], ijPos[2]))
           continue;
         tIDs[0] = iTjPt.id;
@@ -1025,7 +1100,7 @@ namespace tca {
       float tpCnt = 0;
       for (auto tid : tIDs) {
         auto& tj = slc.tjs[tid - 1];
-        tpCnt += NumPtsWithCharge(slc, tj, false);
+        tpCnt += NumPtsWithCharge(tcx, slc, tj, false);
       } // tid
       float frac = mCnt[indx] / tpCnt;
       frac /= 2;
@@ -1055,6 +1130,7 @@ namespace tca {
   bool
   Update(detinfo::DetectorClocksData const& clockData,
          detinfo::DetectorPropertiesData const& detProp,
+         TCContext& tcx,
          const TCSlice& slc,
          PFPStruct& pfp,
          bool prt)
@@ -1093,14 +1169,14 @@ namespace tca {
     for (std::size_t sfi = 0; sfi < pfp.SectionFits.size(); ++sfi) {
       auto& sf = pfp.SectionFits[sfi];
       if (!sf.NeedsUpdate) continue;
-      if (!FitSection(clockData, detProp, slc, pfp, sfi)) return false;
+      if (!FitSection(clockData, detProp, tcx, slc, pfp, sfi)) return false;
       if (!SortSection(pfp, sfi)) return false;
       sf.NeedsUpdate = false;
     } // sfi
 
     // ensure that all points (good or not) have a valid SFIndex
     for (auto& tp3d : pfp.TP3Ds) {
-      if (tp3d.SFIndex >= pfp.SectionFits.size()) SetSection(detProp, slc, pfp, tp3d);
+      if (tp3d.SFIndex >= pfp.SectionFits.size()) SetSection(detProp, tcx, slc, pfp, tp3d);
     } // tp3d
     pfp.Flags[kNeedsUpdate] = false;
     return true;
@@ -1110,6 +1186,7 @@ namespace tca {
   bool
   ReSection(detinfo::DetectorClocksData const& clockData,
             detinfo::DetectorPropertiesData const& detProp,
+            TCContext& tcx,
             const TCSlice& slc,
             PFPStruct& pfp,
             bool prt)
@@ -1131,8 +1208,8 @@ namespace tca {
     prt = (pfp.MVI == debug.MVI);
 
     // try to keep ChiDOF between chiLo and chiHi
-    float chiLo = 0.5 * tcc.match3DCuts[5];
-    float chiHi = 1.5 * tcc.match3DCuts[5];
+    float chiLo = 0.5 * tcx.tcc.match3DCuts[5];
+    float chiHi = 1.5 * tcx.tcc.match3DCuts[5];
 
     // clobber the old sections if more than one exists
     if (pfp.SectionFits.size() > 1) {
@@ -1144,8 +1221,8 @@ namespace tca {
         tp3d.Flags[kTP3DGood] = true;
       }
       auto& sf = pfp.SectionFits[0];
-      if (!FitSection(clockData, detProp, slc, pfp, 0)) { return false; }
-      if (sf.ChiDOF < tcc.match3DCuts[5]) return true;
+      if (!FitSection(clockData, detProp, tcx, slc, pfp, 0)) { return false; }
+      if (sf.ChiDOF < tcx.tcc.match3DCuts[5]) return true;
     } // > 1 SectionFit
     // sort by distance from the start
     if (!SortSection(pfp, 0)) return false;
@@ -1170,8 +1247,8 @@ namespace tca {
     // Try to reduce the number of iterations for long pfps
     if (pfp.TP3Ds.size() > 100) {
       unsigned short nhalf = pfp.TP3Ds.size() / 2;
-      FitTP3Ds(detProp, slc, pfp, fromPt, nhalf, USHRT_MAX, chiDOF);
-      if (chiDOF < tcc.match3DCuts[5]) nPts = nhalf;
+      FitTP3Ds(detProp, tcx, slc, pfp, fromPt, nhalf, USHRT_MAX, chiDOF);
+      if (chiDOF < tcx.tcc.match3DCuts[5]) nPts = nhalf;
     }
     bool lastSection = false;
     for (unsigned short sfIndex = 0; sfIndex < 20; ++sfIndex) {
@@ -1181,7 +1258,7 @@ namespace tca {
       for (unsigned short nit = 0; nit < 10; ++nit) {
         // Decide how many points to add or subtract after doing the fit
         unsigned short nPtsNext = nPts;
-        if (!FitTP3Ds(detProp, slc, pfp, fromPt, nPts, USHRT_MAX, chiDOF)) {
+        if (!FitTP3Ds(detProp, tcx, slc, pfp, fromPt, nPts, USHRT_MAX, chiDOF)) {
           nPtsNext += 1.5 * nPtsToAdd;
         }
         else if (chiDOF < chiLo) {
@@ -1198,7 +1275,7 @@ namespace tca {
         else if (chiDOF > chiHi) {
           // high chiDOF
           ++nHiChi;
-          if (nHiChi == 1 && chiDOFPrev > tcc.match3DCuts[5]) {
+          if (nHiChi == 1 && chiDOFPrev > tcx.tcc.match3DCuts[5]) {
             // reduce the number of points by 1/2 on the first attempt
             nPtsNext /= 2;
           }
@@ -1259,7 +1336,7 @@ namespace tca {
         }
       } // !lastSection
       // Do a final fit and update the points. Don't worry about a poor ChiDOF
-      FitSection(clockData, detProp, slc, pfp, sfIndex);
+      FitSection(clockData, detProp, tcx, slc, pfp, sfIndex);
       if (!SortSection(pfp, 0)) { return false; }
       if (lastSection) break;
       // Prepare for the next section.
@@ -1293,11 +1370,11 @@ namespace tca {
       pfp.SectionFits[tp3d.SFIndex].NeedsUpdate = true;
     } // tp3d
 
-    Update(clockData, detProp, slc, pfp, prt);
+    Update(clockData, detProp, tcx, slc, pfp, prt);
 
     // set CanSection false if the chisq is poor in any section
     for (auto& sf : pfp.SectionFits) {
-      if (sf.ChiDOF > tcc.match3DCuts[5]) pfp.Flags[kCanSection] = false;
+      if (sf.ChiDOF > tcx.tcc.match3DCuts[5]) pfp.Flags[kCanSection] = false;
     }
 
     return true;
@@ -1305,7 +1382,7 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  CountBadPoints(const TCSlice& slc,
+  CountBadPoints(TCContext& tcx, const TCSlice& slc,
                  const PFPStruct& pfp,
                  unsigned short fromPt,
                  unsigned short toPt,
@@ -1328,7 +1405,7 @@ namespace tca {
       // happen for points close to a vertex and when trajectories cross
       auto& tp = slc.tjs[tp3d.TjID - 1].Pts[tp3d.TPIndex];
       if (tp.Environment[kEnvOverlap]) continue;
-      if (PointPull(pfp, tp3d) < tcc.match3DCuts[4]) continue;
+      if (PointPull(tcx, pfp, tp3d) < tcx.tcc.match3DCuts[4]) continue;
       ++nBadPts;
       if (first) {
         first = false;
@@ -1412,6 +1489,7 @@ namespace tca {
   bool
   FitSection(detinfo::DetectorClocksData const& clockData,
              detinfo::DetectorPropertiesData const& detProp,
+             TCContext& tcx,
              const TCSlice& slc,
              PFPStruct& pfp,
              unsigned short sfIndex)
@@ -1437,13 +1515,14 @@ namespace tca {
 
     // fit these points and update
     float chiDOF = 999;
-    return FitTP3Ds(detProp, slc, pfp, fromPt, npts, sfIndex, chiDOF);
+    return FitTP3Ds(detProp, tcx, slc, pfp, fromPt, npts, sfIndex, chiDOF);
 
   } // FitSection
 
   /////////////////////////////////////////
   SectionFit
   FitTP3Ds(detinfo::DetectorPropertiesData const& detProp,
+           TCContext& tcx,
            const TCSlice& slc,
            const std::vector<TP3D>& tp3ds,
            unsigned short fromPt,
@@ -1465,11 +1544,11 @@ namespace tca {
     for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
       auto planeID = geo::PlaneID(slc.TPCID.Cryostat, slc.TPCID.TPC, plane);
       // plane offset
-      ocs[plane][0] = tcc.geom->WireCoordinate(0, 0, planeID);
+      ocs[plane][0] = tcx.tcc.geom->WireCoordinate(0, 0, planeID);
       // get the "cosine-like" component
-      ocs[plane][1] = tcc.geom->WireCoordinate(1, 0, planeID) - ocs[plane][0];
+      ocs[plane][1] = tcx.tcc.geom->WireCoordinate(1, 0, planeID) - ocs[plane][0];
       // the "sine-like" component
-      ocs[plane][2] = tcc.geom->WireCoordinate(0, 1, planeID) - ocs[plane][0];
+      ocs[plane][2] = tcx.tcc.geom->WireCoordinate(0, 1, planeID) - ocs[plane][0];
     } // plane
 
     const unsigned int nvars = 4;
@@ -1551,7 +1630,7 @@ namespace tca {
     std::vector<TrajPoint> plnTP(slc.nPlanes);
     for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
       CTP_t inCTP = EncodeCTP(slc.TPCID.Cryostat, slc.TPCID.TPC, plane);
-      plnTP[plane] = MakeBareTP(detProp, slc, sf.Pos, sf.Dir, inCTP);
+      plnTP[plane] = MakeBareTP(detProp, tcx, slc, sf.Pos, sf.Dir, inCTP);
     } // plane
     // a local position
     Point3_t pos;
@@ -1584,6 +1663,7 @@ namespace tca {
   /////////////////////////////////////////
   bool
   FitTP3Ds(detinfo::DetectorPropertiesData const& detProp,
+           TCContext& tcx,
            const TCSlice& slc,
            PFPStruct& pfp,
            unsigned short fromPt,
@@ -1598,7 +1678,7 @@ namespace tca {
     if (nPtsFit < 5) return false;
     if (fromPt + nPtsFit > pfp.TP3Ds.size()) return false;
 
-    auto sf = FitTP3Ds(detProp, slc, pfp.TP3Ds, fromPt, 1, nPtsFit);
+    auto sf = FitTP3Ds(detProp, tcx, slc, pfp.TP3Ds, fromPt, 1, nPtsFit);
     if (sf.ChiDOF > 900) return false;
 
     // don't update the pfp?
@@ -1611,7 +1691,7 @@ namespace tca {
     std::vector<TrajPoint> plnTP(slc.nPlanes);
     for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
       CTP_t inCTP = EncodeCTP(pfp.TPCID.Cryostat, pfp.TPCID.TPC, plane);
-      plnTP[plane] = MakeBareTP(detProp, slc, sf.Pos, sf.Dir, inCTP);
+      plnTP[plane] = MakeBareTP(detProp, tcx, slc, sf.Pos, sf.Dir, inCTP);
     } // plane
     Point3_t pos;
     bool needsSort = false;
@@ -1646,7 +1726,7 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  ReconcileVertices(TCSlice& slc, PFPStruct& pfp, bool prt)
+  ReconcileVertices(TCContext& tcx, TCSlice& slc, PFPStruct& pfp, bool prt)
   {
     // Checks for mis-placed 2D and 3D vertices and either attaches them
     // to a vertex or deletes(?) the vertex while attempting to preserve or
@@ -1656,7 +1736,7 @@ namespace tca {
     // a re-definition of the pfp, e.g. adding or removing TP3Ds. Note that this
     // never occurs as the function is currently written
 
-    if (tcc.vtx3DCuts.size() < 3) return;
+    if (tcx.tcc.vtx3DCuts.size() < 3) return;
     if (pfp.TP3Ds.empty()) return;
     if (pfp.Flags[kJunk3D]) return;
     if(pfp.Flags[kSmallAngle]) return;
@@ -1713,11 +1793,11 @@ namespace tca {
     // algorithm that doesn't yet exist...
     for (auto vid : vx2List) {
       auto& vx2 = slc.vtxs[vid - 1];
-      MakeVertexObsolete("RV", slc, vx2, true);
+      MakeVertexObsolete("RV", tcx, slc, vx2, true);
     } // vx2List
     // ignore the T -> 2V -> 3V assns (if any exist) and try to directly
     // attach to 3D vertices at both ends
-    AttachToAnyVertex(slc, pfp, tcc.vtx3DCuts[2], prt);
+    AttachToAnyVertex(slc, pfp, tcx.tcc.vtx3DCuts[2], prt);
     // check for differences and while we are here, see if the pfp was attached
     // to a neutrino vertex and the direction is wrong
     int neutrinoVx = 0;
@@ -1743,6 +1823,7 @@ namespace tca {
   void
   FillGaps3D(detinfo::DetectorClocksData const& clockData,
              detinfo::DetectorPropertiesData const& detProp,
+             TCContext& tcx,
              TCSlice& slc,
              PFPStruct& pfp,
              bool prt)
@@ -1755,12 +1836,12 @@ namespace tca {
     if (pfp.ID <= 0) return;
     if (pfp.TP3Ds.empty()) return;
     if (pfp.SectionFits.empty()) return;
-    if (!tcc.useAlg[kFillGaps3D]) return;
+    if (!tcx.tcc.useAlg[kFillGaps3D]) return;
     if (pfp.Flags[kJunk3D]) return;
     if (pfp.Flags[kSmallAngle]) return;
 
     // Only print APIR details if MVI is set
-    bool foundMVI = (tcc.dbgPFP && pfp.MVI == debug.MVI);
+    bool foundMVI = (tcx.tcc.dbgPFP && pfp.MVI == debug.MVI);
 
     // make a copy in case something goes wrong
     auto pWork = pfp;
@@ -1773,20 +1854,21 @@ namespace tca {
       unsigned short nWires, nAdd;
       AddPointsInRange(clockData,
                        detProp,
+                       tcx,
                        slc,
                        pWork,
                        fromPt,
                        toPt,
                        inCTP,
-                       tcc.match3DCuts[4],
+                       tcx.tcc.match3DCuts[4],
                        nWires,
                        nAdd,
                        foundMVI);
-      if (pWork.Flags[kNeedsUpdate]) Update(clockData, detProp, slc, pWork, prt);
+      if (pWork.Flags[kNeedsUpdate]) Update(clockData, detProp, tcx, slc, pWork, prt);
       nPtsAdded += nAdd;
     } // plane
     if (prt) mf::LogVerbatim("TC") << "FG3D P" << pWork.ID << " added " << nPtsAdded << " points";
-    if (pWork.Flags[kNeedsUpdate] && !Update(clockData, detProp, slc, pWork, prt)) return;
+    if (pWork.Flags[kNeedsUpdate] && !Update(clockData, detProp, tcx, slc, pWork, prt)) return;
     pfp = pWork;
     return;
   } // FillGaps3D
@@ -1794,6 +1876,7 @@ namespace tca {
   /////////////////////////////////////////
   bool
   ValidTwoPlaneMatch(detinfo::DetectorPropertiesData const& detProp,
+                     TCContext& tcx,
                      const TCSlice& slc,
                      const PFPStruct& pfp)
   {
@@ -1811,23 +1894,23 @@ namespace tca {
     unsigned short thirdPlane = 3 - planes[0] - planes[1];
     CTP_t inCTP = EncodeCTP(slc.TPCID.Cryostat, slc.TPCID.TPC, thirdPlane);
     // Project the 3D position at the start into the third plane
-    auto tp = MakeBareTP(detProp, slc, pfp.TP3Ds[0].Pos, inCTP);
+    auto tp = MakeBareTP(detProp, tcx, slc, pfp.TP3Ds[0].Pos, inCTP);
     unsigned int wire0 = 0;
     if (tp.Pos[0] > 0) wire0 = std::nearbyint(tp.Pos[0]);
     if (wire0 > slc.nWires[thirdPlane]) wire0 = slc.nWires[thirdPlane];
     // Do the same for the end
     unsigned short lastPt = pfp.TP3Ds.size() - 1;
-    tp = MakeBareTP(detProp, slc, pfp.TP3Ds[lastPt].Pos, inCTP);
+    tp = MakeBareTP(detProp, tcx, slc, pfp.TP3Ds[lastPt].Pos, inCTP);
     unsigned int wire1 = 0;
     if (tp.Pos[0] > 0) wire1 = std::nearbyint(tp.Pos[0]);
     if (wire1 > slc.nWires[thirdPlane]) wire1 = slc.nWires[thirdPlane];
-    if (wire0 == wire1) return !evt.goodWire[thirdPlane][wire0];
+    if (wire0 == wire1) return !tcx.evt.goodWire[thirdPlane][wire0];
     if (wire1 < wire0) std::swap(wire0, wire1);
     // count the number of good wires
     int dead = 0;
     int wires = wire1 - wire0;
     for (unsigned int wire = wire0; wire < wire1; ++wire)
-      if (!evt.goodWire[thirdPlane][wire]) ++dead;
+      if (!tcx.evt.goodWire[thirdPlane][wire]) ++dead;
     // require that most of the wires are dead
     return (dead > 0.8 * wires);
   } // ValidTwoPlaneMatch
@@ -1836,6 +1919,7 @@ namespace tca {
   void
   AddPointsInRange(detinfo::DetectorClocksData const& clockData,
                    detinfo::DetectorPropertiesData const& detProp,
+                   TCContext& tcx,
                    TCSlice& slc,
                    PFPStruct& pfp,
                    unsigned short fromPt,
@@ -1858,7 +1942,7 @@ namespace tca {
     // Find the average dE/dx so we can apply a generous min/max dE/dx cut
     float dEdXAve = 0;
     float dEdXRms = 0;
-    Average_dEdX(clockData, detProp, slc, pfp, dEdXAve, dEdXRms);
+    Average_dEdX(clockData, detProp, tcx, slc, pfp, dEdXAve, dEdXRms);
     float dEdxMin = 0.5, dEdxMax = 50.;
     if (dEdXAve > 0.5) {
       dEdxMin = dEdXAve - maxPull * dEdXRms;
@@ -1896,7 +1980,7 @@ namespace tca {
       else {
         // Found the first tp3d in a new SectionFit and it is in a different CTP.
         // Make a TP in the right CTP
-        auto tp = MakeBareTP(detProp, slc, tp3d.Pos, tp3d.Dir, inCTP);
+        auto tp = MakeBareTP(detProp, tcx, slc, tp3d.Pos, tp3d.Dir, inCTP);
         wire = std::nearbyint(tp.Pos[0]);
         if (wire >= slc.nWires[pln]) break;
         sfTPs.push_back(tp);
@@ -1923,7 +2007,7 @@ namespace tca {
       auto& fromTP = sfTPs[subr];
       unsigned int toWireInSF = toWire;
       if (subr < sfTPs.size() - 1) toWireInSF = std::nearbyint(sfTPs[subr + 1].Pos[0]);
-      SetAngleCode(fromTP);
+      SetAngleCode(tcx, fromTP);
       unsigned int fromWire = std::nearbyint(fromTP.Pos[0]);
       if (fromWire > toWire) continue;
       if (prt)
@@ -1931,7 +2015,7 @@ namespace tca {
                               << " toWireInSF " << toWireInSF;
       for (unsigned int wire = fromWire; wire <= toWireInSF; ++wire) {
         MoveTPToWire(fromTP, (float)wire);
-        if (!FindCloseHits(slc, fromTP, window, kUsedHits)) continue;
+        if (!FindCloseHits(tcx, slc, fromTP, window, kUsedHits)) continue;
         if (fromTP.Environment[kEnvNotGoodWire]) continue;
         float bestPull = maxPull;
         TP3D bestTP3D;
@@ -1956,12 +2040,12 @@ namespace tca {
           if (utp.InPFP > 0) continue;
           // or if it overlaps another trajectory near a 2D vertex
           if (utp.Environment[kEnvOverlap]) continue;
-          auto newTP3D = CreateTP3D(detProp, slc, utj.ID, tpIndex);
-          if (!SetSection(detProp, slc, pfp, newTP3D)) continue;
+          auto newTP3D = CreateTP3D(detProp, tcx, slc, utj.ID, tpIndex);
+          if (!SetSection(detProp, tcx, slc, pfp, newTP3D)) continue;
           // set the direction to the direction of the SectionFit it is in so we can calculate dE/dx
           newTP3D.Dir = pfp.SectionFits[newTP3D.SFIndex].Dir;
-          float pull = PointPull(pfp, newTP3D);
-          float dedx = dEdx(clockData, detProp, slc, newTP3D);
+          float pull = PointPull(tcx, pfp, newTP3D);
+          float dedx = dEdx(clockData, detProp, tcx, slc, newTP3D);
           // Require a good pull and a consistent dE/dx (MeV/cm)
           bool useIt = (pull < bestPull && dedx > dEdxMin && dedx < dEdxMax);
           if (!useIt) continue;
@@ -1972,7 +2056,7 @@ namespace tca {
           if (prt && bestPull < 10) {
             mf::LogVerbatim myprt("TC");
             auto& tp = slc.tjs[bestTP3D.TjID - 1].Pts[bestTP3D.TPIndex];
-            myprt << "APIR: P" << pfp.ID << " added TP " << PrintPos(slc, tp);
+            myprt << "APIR: P" << pfp.ID << " added TP " << PrintPos(tcx, slc, tp);
             myprt << " pull " << std::fixed << std::setprecision(2) << bestPull;
             myprt << " dx " << bestTP3D.TPX - bestTP3D.Pos[0] << " in section " << bestTP3D.SFIndex;
           }
@@ -2087,6 +2171,7 @@ namespace tca {
   void
   Recover(detinfo::DetectorClocksData const& clockData,
           detinfo::DetectorPropertiesData const& detProp,
+          TCContext& tcx,
           TCSlice& slc, PFPStruct& pfp, bool prt)
   {
     // try to recover from a poor initial fit
@@ -2106,7 +2191,7 @@ namespace tca {
     if(toPt > p2.TP3Ds.size()) return;
     toPt = Find3DRecoRange(slc, p2, halfPt, 3, 1);
     if(toPt > p2.TP3Ds.size()) return;
-    if(!FitSection(clockData, detProp, slc, p2, 0) || !FitSection(clockData, detProp, slc, p2, 1)) {
+    if(!FitSection(clockData, detProp, tcx, slc, p2, 0) || !FitSection(clockData, detProp, tcx, slc, p2, 1)) {
       if(prt) {
         mf::LogVerbatim myprt("TC");
         myprt << "Recover failed MVI " << p2.MVI << " in TPC " << p2.TPCID.TPC;
@@ -2121,7 +2206,11 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  MakeTP3Ds(detinfo::DetectorPropertiesData const& detProp, TCSlice& slc, PFPStruct& pfp, bool prt)
+  MakeTP3Ds(detinfo::DetectorPropertiesData const& detProp,
+            TCContext& tcx,
+            TCSlice& slc,
+            PFPStruct& pfp,
+            bool prt)
   {
     // Create and populate the TP3Ds vector. This function is called before the first
     // fit is done so the TP3D along variable can't be determined. It returns false
@@ -2173,7 +2262,7 @@ namespace tca {
     if(nSA > 1) pfp.AlgMod[kSmallAngle] = true;
     if(prt) mf::LogVerbatim("TC")<<" P"<<pfp.ID<<" MVI "<<pfp.MVI<<" nJunkTj "<<nJunk<<" SmallAngle? "<<pfp.AlgMod[kSmallAngle];
 
-    if(pfp.AlgMod[kSmallAngle]) return MakeSmallAnglePFP(detProp, slc, pfp, prt);
+    if(pfp.AlgMod[kSmallAngle]) return MakeSmallAnglePFP(detProp, tcx, slc, pfp, prt);
 
     // Add the points associated with the Tjs that were used to create the PFP
     for (auto tid : pfp.TjIDs) {
@@ -2188,7 +2277,7 @@ namespace tca {
         if (tp.Chg <= 0) continue;
         if (tp.InPFP > 0) continue;
         ++avail;
-        auto tp3d = CreateTP3D(detProp, slc, tid, ipt);
+        auto tp3d = CreateTP3D(detProp, tcx, slc, tid, ipt);
         if(tp3d.Flags[kTP3DBad]) continue;
         tp3d.SFIndex = 0;
         if(isJunk) tp3d.TPXErr2 *= 4;
@@ -2203,6 +2292,7 @@ namespace tca {
 
   /////////////////////////////////////////
   bool MakeSmallAnglePFP(detinfo::DetectorPropertiesData const& detProp,
+                         TCContext& tcx,
                          TCSlice& slc, PFPStruct& pfp,
                          bool prt)
   {
@@ -2211,7 +2301,7 @@ namespace tca {
     // is set true. Assume that the calling function, MakeTP3Ds, has decided that this is a
     // small-angle track. 
 
-    if(!tcc.useAlg[kSmallAngle]) return false;
+    if(!tcx.tcc.useAlg[kSmallAngle]) return false;
     if(pfp.TjIDs.size() < 2) return false;
 
     std::vector<SortEntry> sortVec(pfp.TjIDs.size());
@@ -2219,7 +2309,7 @@ namespace tca {
     for (unsigned short itj = 0; itj < pfp.TjIDs.size(); ++itj) {
       sortVec[itj].index = itj;
       auto& tj = slc.tjs[pfp.TjIDs[itj] - 1];
-      sortVec[itj].val = NumPtsWithCharge(slc, tj, false);
+      sortVec[itj].val = NumPtsWithCharge(tcx, slc, tj, false);
       if(pfp.TjUIDs[itj] > 0) ++sbCnt;
     } // ipt
     std::sort(sortVec.begin(), sortVec.end(), valsDecreasing);
@@ -2254,16 +2344,16 @@ namespace tca {
       auto& ntp0 = nlong.Pts[nStartPt];
       auto& ntp1 = nlong.Pts[nEndPt];
       // Get the 3D end points
-      auto start = MakeTP3D(detProp, slc, ltp0, ntp0);
-      auto end = MakeTP3D(detProp, slc, ltp1, ntp1);
+      auto start = MakeTP3D(detProp, tcx, slc, ltp0, ntp0);
+      auto end = MakeTP3D(detProp, tcx, slc, ltp1, ntp1);
       if(!start.Flags[kTP3DGood] || !end.Flags[kTP3DGood]) {
         std::cout<<" Start/end fail in section "<<isf<<". Add recovery code\n";
         return false;
       } // failure
-      if(!InsideTPC(start.Pos, pfp.TPCID)) {
+      if(!InsideTPC(tcx, start.Pos, pfp.TPCID)) {
         mf::LogVerbatim("TC")<<" Start is outside the TPC "<<start.Pos[0]<<" "<<start.Pos[1]<<" "<<start.Pos[2];
       }
-      if(!InsideTPC(end.Pos, pfp.TPCID)) {
+      if(!InsideTPC(tcx, end.Pos, pfp.TPCID)) {
         mf::LogVerbatim("TC")<<" End is outside the TPC "<<end.Pos[0]<<" "<<end.Pos[1]<<" "<<end.Pos[2];
       }
       if(isf == 0) sfEndPos.push_back(start.Pos);
@@ -2306,7 +2396,7 @@ namespace tca {
       for(unsigned short ipt = tj.EndPt[0]; ipt <= tj.EndPt[1]; ++ipt) {
         auto& tp = tj.Pts[ipt];
         if(tp.Chg <= 0) continue;
-        auto tp3d = CreateTP3D(detProp, slc, tid, ipt);
+        auto tp3d = CreateTP3D(detProp, tcx, slc, tid, ipt);
         if(tp3d.Flags[kTP3DBad]) continue;
         if(ipt == sb + 1) {
           sfi = 1;
@@ -2378,7 +2468,7 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  FillmAllTraj(detinfo::DetectorPropertiesData const& detProp, TCSlice& slc)
+  FillmAllTraj(detinfo::DetectorPropertiesData const& detProp, TCContext& tcx, TCSlice& slc)
   {
     // Fills the mallTraj vector with trajectory points in the tpc and sorts
     // them by increasing X
@@ -2392,9 +2482,9 @@ namespace tca {
     unsigned short cnt = 0;
 
     // try to reduce CPU time by not attempting to match tjs that are near muons
-    bool muFuzzCut = (tcc.match3DCuts.size() > 6 && tcc.match3DCuts[6] > 0);
+    bool muFuzzCut = (tcx.tcc.match3DCuts.size() > 6 && tcx.tcc.match3DCuts[6] > 0);
 
-    float rms = tcc.match3DCuts[0];
+    float rms = tcx.tcc.match3DCuts[0];
     for (auto& tj : slc.tjs) {
       if (tj.AlgMod[kKilled] || tj.AlgMod[kHaloTj]) continue;
       // ignore already matched
@@ -2415,8 +2505,8 @@ namespace tca {
         tj2pt.wire = std::nearbyint(tp.Pos[0]);
         ++cnt;
         // don't try matching if the wire doesn't exist
-        if (!tcc.geom->HasWire(geo::WireID(cstat, tpc, plane, tj2pt.wire))) continue;
-        float xpos = detProp.ConvertTicksToX(tp.Pos[1] / tcc.unitsPerTick, plane, tpc, cstat);
+        if (!tcx.tcc.geom->HasWire(geo::WireID(cstat, tpc, plane, tj2pt.wire))) continue;
+        float xpos = detProp.ConvertTicksToX(tp.Pos[1] / tcx.tcc.unitsPerTick, plane, tpc, cstat);
         tj2pt.xlo = xpos - rms;
         tj2pt.xhi = xpos + rms;
         tj2pt.plane = plane;
@@ -2445,6 +2535,7 @@ namespace tca {
 
   /////////////////////////////////////////
   TP3D MakeTP3D(detinfo::DetectorPropertiesData const& detProp, 
+                TCContext& tcx, 
                 TCSlice& slc, const TrajPoint& itp, const TrajPoint& jtp)
   {
     // Make a 3D trajectory point using two 2D trajectory points. The TP3D Pos and Wire
@@ -2460,7 +2551,7 @@ namespace tca {
     geo::PlaneID iPlnID = DecodeCTP(itp.CTP);
     geo::PlaneID jPlnID = DecodeCTP(jtp.CTP);
     if(iPlnID == jPlnID) return tp3d;
-    double upt = tcc.unitsPerTick;
+    double upt = tcx.tcc.unitsPerTick;
     double ix = detProp.ConvertTicksToX(itp.Pos[1] / upt, iPlnID);
     double jx = detProp.ConvertTicksToX(jtp.Pos[1] / upt, jPlnID);
     
@@ -2474,14 +2565,14 @@ namespace tca {
     // determine the wire orientation and offsets using WireCoordinate
     // wire = yp * OrthY + zp * OrthZ - Wire0 = cs * yp + sn * zp - wire0
     // wire offset
-    double iw0 = tcc.geom->WireCoordinate(0, 0, iPlnID);
+    double iw0 = tcx.tcc.geom->WireCoordinate(0, 0, iPlnID);
     // cosine-like component
-    double ics = tcc.geom->WireCoordinate(1, 0, iPlnID) - iw0;
+    double ics = tcx.tcc.geom->WireCoordinate(1, 0, iPlnID) - iw0;
     // sine-like component
-    double isn = tcc.geom->WireCoordinate(0, 1, iPlnID) - iw0;
-    double jw0 = tcc.geom->WireCoordinate(0, 0, jPlnID);
-    double jcs = tcc.geom->WireCoordinate(1, 0, jPlnID) - jw0;
-    double jsn = tcc.geom->WireCoordinate(0, 1, jPlnID) - jw0;
+    double isn = tcx.tcc.geom->WireCoordinate(0, 1, iPlnID) - iw0;
+    double jw0 = tcx.tcc.geom->WireCoordinate(0, 0, jPlnID);
+    double jcs = tcx.tcc.geom->WireCoordinate(1, 0, jPlnID) - jw0;
+    double jsn = tcx.tcc.geom->WireCoordinate(0, 1, jPlnID) - jw0;
     double den = isn * jcs - ics * jsn;
     if(den == 0) return tp3d;
     double iPos0 = itp.Pos[0];
@@ -2595,6 +2686,7 @@ namespace tca {
   void
   FilldEdx(detinfo::DetectorClocksData const& clockData,
            detinfo::DetectorPropertiesData const& detProp,
+           TCContext& tcx,
            const TCSlice& slc,
            PFPStruct& pfp)
   {
@@ -2611,7 +2703,7 @@ namespace tca {
     } // end
 
     // square of the maximum length that is used for finding the average dE/dx
-    float maxSep2 = 5 * tcc.wirePitch;
+    float maxSep2 = 5 * tcx.tcc.wirePitch;
     maxSep2 *= maxSep2;
 
     for (unsigned short end = 0; end < numEnds; ++end) {
@@ -2630,7 +2722,7 @@ namespace tca {
         if (PosSep2(tp3d.Pos, endPos) > maxSep2) break;
         // require good points
         if (!tp3d.Flags[kTP3DGood]) continue;
-        float dedx = dEdx(clockData, detProp, slc, tp3d);
+        float dedx = dEdx(clockData, detProp, tcx, slc, tp3d);
         if (dedx < 0.5) continue;
         unsigned short plane = DecodeCTP(tp3d.CTP).Plane;
         pfp.dEdx[end][plane] += dedx;
@@ -2648,6 +2740,7 @@ namespace tca {
   void
   Average_dEdX(detinfo::DetectorClocksData const& clockData,
                detinfo::DetectorPropertiesData const& detProp,
+               TCContext& tcx,
                const TCSlice& slc,
                PFPStruct& pfp,
                float& dEdXAve,
@@ -2663,7 +2756,7 @@ namespace tca {
     double cnt = 0;
     for (auto& tp3d : pfp.TP3Ds) {
       if (!tp3d.Flags[kTP3DGood] || tp3d.Flags[kTP3DBad]) continue;
-      double dedx = dEdx(clockData, detProp, slc, tp3d);
+      double dedx = dEdx(clockData, detProp, tcx, slc, tp3d);
       if (dedx < 0.5 || dedx > 80.) continue;
       sum += dedx;
       sum2 += dedx * dedx;
@@ -2685,6 +2778,7 @@ namespace tca {
   float
   dEdx(detinfo::DetectorClocksData const& clockData,
        detinfo::DetectorPropertiesData const& detProp,
+       TCContext& tcx,
        const TCSlice& slc,
        TP3D& tp3d)
   {
@@ -2699,20 +2793,20 @@ namespace tca {
     double time = 0;
     for (unsigned short ii = 0; ii < tp.Hits.size(); ++ii) {
       if (!tp.UseHit[ii]) continue;
-      auto& hit = (*evt.allHits)[slc.slHits[tp.Hits[ii]].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[tp.Hits[ii]].allHitsIndex];
       dQ += hit.Integral();
     } // ii
-    time = tp.Pos[1] / tcc.unitsPerTick;
+    time = tp.Pos[1] / tcx.tcc.unitsPerTick;
     geo::PlaneID plnID = DecodeCTP(tp.CTP);
     if (dQ == 0) return 0;
-    double angleToVert = tcc.geom->Plane(plnID).ThetaZ() - 0.5 * ::util::pi<>();
+    double angleToVert = tcx.tcc.geom->Plane(plnID).ThetaZ() - 0.5 * ::util::pi<>();
     double cosgamma =
       std::abs(std::sin(angleToVert) * tp3d.Dir[1] + std::cos(angleToVert) * tp3d.Dir[2]);
     if (cosgamma < 1.E-5) return 0;
-    double dx = tcc.geom->WirePitch(plnID) / cosgamma;
+    double dx = tcx.tcc.geom->WirePitch(plnID) / cosgamma;
     double dQdx = dQ / dx;
     double t0 = 0;
-    float dedx = tcc.caloAlg->dEdx_AREA(clockData, detProp, dQdx, time, plnID.Plane, t0);
+    float dedx = tcx.tcc.caloAlg->dEdx_AREA(clockData, detProp, dQdx, time, plnID.Plane, t0);
     if (std::isinf(dedx)) dedx = 0;
     return dedx;
   } // dEdx
@@ -2720,6 +2814,7 @@ namespace tca {
   ////////////////////////////////////////////////
   TP3D
   CreateTP3D(detinfo::DetectorPropertiesData const& detProp,
+             TCContext& tcx,
              const TCSlice& slc,
              int tjID,
              unsigned short tpIndex)
@@ -2738,10 +2833,10 @@ namespace tca {
     auto& tp2 = tj.Pts[tp3d.TPIndex];
     auto plnID = DecodeCTP(tp2.CTP);
     tp3d.CTP = tp2.CTP;
-    double tick = tp2.HitPos[1] / tcc.unitsPerTick;
+    double tick = tp2.HitPos[1] / tcx.tcc.unitsPerTick;
     tp3d.TPX = detProp.ConvertTicksToX(tick, plnID);
     // Get the RMS of the TP in WSE units and convert to cm
-    float rms = TPHitsRMSTime(slc, tp2, kAllHits) * tcc.wirePitch;
+    float rms = TPHitsRMSTime(tcx, slc, tp2, kAllHits) * tcx.tcc.wirePitch;
     // inflate the error for large angle TPs
     if (tp2.AngleCode == 1) rms *= 2;
     // a more careful treatment for long-pulse hits
@@ -2749,10 +2844,10 @@ namespace tca {
       std::vector<unsigned int> hitMultiplet;
       for (std::size_t ii = 0; ii < tp2.Hits.size(); ++ii) {
         if (!tp2.UseHit[ii]) continue;
-        GetHitMultiplet(slc, tp2.Hits[ii], hitMultiplet, true);
+        GetHitMultiplet(tcx, slc, tp2.Hits[ii], hitMultiplet, true);
         if (hitMultiplet.size() > 1) break;
       } // ii
-      rms = HitsRMSTime(slc, hitMultiplet, kAllHits) * tcc.wirePitch;
+      rms = HitsRMSTime(tcx, slc, hitMultiplet, kAllHits) * tcx.tcc.wirePitch;
       // the returned RMS is closer to the FWHM, so divide by 2
       rms /= 2;
     } // tp2.AngleCode > 1
@@ -2767,6 +2862,7 @@ namespace tca {
   /////////////////////////////////////////
   bool
   SetSection(detinfo::DetectorPropertiesData const& detProp,
+             TCContext& tcx,
              const TCSlice& slc,
              PFPStruct& pfp,
              TP3D& tp3d)
@@ -2787,7 +2883,7 @@ namespace tca {
       float best = 1E6;
       for (std::size_t sfi = 0; sfi < pfp.SectionFits.size(); ++sfi) {
         auto& sf = pfp.SectionFits[sfi];
-        float sfWire = tcc.geom->WireCoordinate(sf.Pos[1], sf.Pos[2], plnID);
+        float sfWire = tcx.tcc.geom->WireCoordinate(sf.Pos[1], sf.Pos[2], plnID);
         float sep = std::abs(sfWire - tp3d.Wire);
         if (sep < best) {
           best = sep;
@@ -2796,7 +2892,7 @@ namespace tca {
       } // sfi
     }   // pfp.SectionFits.size() > 1
     auto& sf = pfp.SectionFits[tp3d.SFIndex];
-    auto plnTP = MakeBareTP(detProp, slc, sf.Pos, sf.Dir, tp3d.CTP);
+    auto plnTP = MakeBareTP(detProp, tcx, slc, sf.Pos, sf.Dir, tp3d.CTP);
     // the number of wires relative to the SectionFit center
     double dw = tp3d.Wire - plnTP.Pos[0];
     // dt/dW was stored in DeltaRMS
@@ -2811,7 +2907,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   float
-  PointPull(const PFPStruct& pfp, const TP3D& tp3d)
+  PointPull(TCContext& tcx, const PFPStruct& pfp, const TP3D& tp3d)
   {
     // returns the pull that the tp3d will cause in the pfp section fit. This
     // currently only uses position but eventually will include charge
@@ -2871,8 +2967,8 @@ namespace tca {
       vx3.Z = startPos[2];
       vx3.ID = slc.vtx3s.size() + 1;
       vx3.Primary = false;
-      ++evt.global3V_UID;
-      vx3.UID = evt.global3V_UID;
+      ++slc.ids.global3V_UID;
+      vx3.UID = slc.ids.global3V_UID;
       slc.vtx3s.push_back(vx3);
       pfp.Vx3ID[0] = vx3.ID;
     } // pfp
@@ -2880,7 +2976,7 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  DefinePFPParents(TCSlice& slc, bool prt)
+  DefinePFPParents(TCContext& tcx, TCSlice& slc, bool prt)
   {
     /*
      This function reconciles vertices, PFParticles and slc, then
@@ -2917,12 +3013,13 @@ namespace tca {
 
      */
     if (slc.pfps.empty()) return;
-    if (tcc.modes[kTestBeam]) return;
+    if (tcx.tcc.modes[kTestBeam]) return;
 
     int neutrinoPFPID = 0;
     for (auto& pfp : slc.pfps) {
       if (pfp.ID == 0) continue;
-      if (!tcc.modes[kTestBeam] && neutrinoPFPID == 0 && (pfp.PDGCode == 12 || pfp.PDGCode == 14)) {
+      if (!tcx.tcc.modes[kTestBeam] && neutrinoPFPID == 0 &&
+          (pfp.PDGCode == 12 || pfp.PDGCode == 14)) {
         neutrinoPFPID = pfp.ID;
         break;
       }
@@ -3026,8 +3123,8 @@ namespace tca {
     if (nNotSet > 0) return false;
     // check the ID and correct it if it is wrong
     if (pfp.ID != (int)slc.pfps.size() + 1) pfp.ID = slc.pfps.size() + 1;
-    ++evt.globalP_UID;
-    pfp.UID = evt.globalP_UID;
+    ++slc.ids.globalP_UID;
+    pfp.UID = slc.ids.globalP_UID;
 
     // set the 3D match flag
     for (auto tjid : pfp.TjIDs) {
@@ -3068,23 +3165,23 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  InsideTPC(const Point3_t& pos, geo::TPCID& inTPCID)
+  InsideTPC(TCContext& tcx, const Point3_t& pos, geo::TPCID& inTPCID)
   {
     // determine which TPC this point is in. This function returns false
     // if the point is not inside any TPC
     float abit = 5;
-    for (const geo::TPCID& tpcid : tcc.geom->IterateTPCIDs()) {
-      const geo::TPCGeo& TPC = tcc.geom->TPC(tpcid);
+    for (const geo::TPCID& tpcid : tcx.tcc.geom->IterateTPCIDs()) {
+      const geo::TPCGeo& TPC = tcx.tcc.geom->TPC(tpcid);
       double local[3] = {0., 0., 0.};
       double world[3] = {0., 0., 0.};
       TPC.LocalToWorld(local, world);
       // reduce the active area of the TPC by a bit to be consistent with FillWireHitRange
-      if (pos[0] < world[0] - tcc.geom->DetHalfWidth(tpcid) + abit) continue;
-      if (pos[0] > world[0] + tcc.geom->DetHalfWidth(tpcid) - abit) continue;
-      if (pos[1] < world[1] - tcc.geom->DetHalfHeight(tpcid) + abit) continue;
-      if (pos[1] > world[1] + tcc.geom->DetHalfHeight(tpcid) - abit) continue;
-      if (pos[2] < world[2] - tcc.geom->DetLength(tpcid) / 2 + abit) continue;
-      if (pos[2] > world[2] + tcc.geom->DetLength(tpcid) / 2 - abit) continue;
+      if (pos[0] < world[0] - tcx.tcc.geom->DetHalfWidth(tpcid) + abit) continue;
+      if (pos[0] > world[0] + tcx.tcc.geom->DetHalfWidth(tpcid) - abit) continue;
+      if (pos[1] < world[1] - tcx.tcc.geom->DetHalfHeight(tpcid) + abit) continue;
+      if (pos[1] > world[1] + tcx.tcc.geom->DetHalfHeight(tpcid) - abit) continue;
+      if (pos[2] < world[2] - tcx.tcc.geom->DetLength(tpcid) / 2 + abit) continue;
+      if (pos[2] > world[2] + tcx.tcc.geom->DetLength(tpcid) / 2 - abit) continue;
       inTPCID = tpcid;
       return true;
     } // tpcid
@@ -3194,6 +3291,7 @@ namespace tca {
   ////////////////////////////////////////////////
   float
   ChgFracBetween(detinfo::DetectorPropertiesData const& detProp,
+                 TCContext& tcx,
                  const TCSlice& slc,
                  Point3_t pos1,
                  Point3_t pos2)
@@ -3204,22 +3302,22 @@ namespace tca {
     // positions
     float sep = PosSep(pos1, pos2);
     if (sep == 0) return -1;
-    unsigned short nstep = sep / tcc.wirePitch;
+    unsigned short nstep = sep / tcx.tcc.wirePitch;
     auto dir = PointDirection(pos1, pos2);
     float sum = 0;
     float cnt = 0;
     TrajPoint tp;
     for (unsigned short step = 0; step < nstep; ++step) {
       for (unsigned short xyz = 0; xyz < 3; ++xyz)
-        pos1[xyz] += tcc.wirePitch * dir[xyz];
+        pos1[xyz] += tcx.tcc.wirePitch * dir[xyz];
       for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
         tp.CTP = EncodeCTP(slc.TPCID.Cryostat, slc.TPCID.TPC, plane);
         tp.Pos[0] =
-          tcc.geom->WireCoordinate(pos1[1], pos1[2], plane, slc.TPCID.TPC, slc.TPCID.Cryostat);
+          tcx.tcc.geom->WireCoordinate(pos1[1], pos1[2], plane, slc.TPCID.TPC, slc.TPCID.Cryostat);
         tp.Pos[1] = detProp.ConvertXToTicks(pos1[0], plane, slc.TPCID.TPC, slc.TPCID.Cryostat) *
-                    tcc.unitsPerTick;
+                    tcx.tcc.unitsPerTick;
         ++cnt;
-        if (SignalAtTp(tp)) ++sum;
+        if (SignalAtTp(tcx, slc, tp)) ++sum;
       } // plane
     }   // step
     if (cnt == 0) return -1;
@@ -3229,6 +3327,7 @@ namespace tca {
   ////////////////////////////////////////////////
   float
   ChgFracNearEnd(detinfo::DetectorPropertiesData const& detProp,
+                 TCContext& tcx,
                  const TCSlice& slc,
                  const PFPStruct& pfp,
                  unsigned short end)
@@ -3256,14 +3355,14 @@ namespace tca {
         tjids[0] = tjid;
         Point2_t pos2;
         geo::PlaneID planeID = geo::PlaneID(pfp.TPCID.Cryostat, pfp.TPCID.TPC, plane);
-        pos2[0] = tcc.geom->WireCoordinate(pos3[1], pos3[2], planeID);
+        pos2[0] = tcx.tcc.geom->WireCoordinate(pos3[1], pos3[2], planeID);
         if (pos2[0] < -0.4) continue;
         // check for dead wires
         unsigned int wire = std::nearbyint(pos2[0]);
         if (wire > slc.nWires[plane]) continue;
         if (slc.wireHitRange[plane][wire].first == UINT_MAX) continue;
-        pos2[1] = detProp.ConvertXToTicks(pos3[0], planeID) * tcc.unitsPerTick;
-        float cf = ChgFracNearPos(slc, pos2, tjids);
+        pos2[1] = detProp.ConvertXToTicks(pos3[0], planeID) * tcx.tcc.unitsPerTick;
+        float cf = ChgFracNearPos(tcx, slc, pos2, tjids);
         if (cf < lo) lo = cf;
         if (cf > hi) hi = cf;
         sum += cf;
@@ -3350,6 +3449,7 @@ namespace tca {
   int
   PDGCodeVote(detinfo::DetectorClocksData const& clockData,
               detinfo::DetectorPropertiesData const& detProp,
+              TCContext& tcx,
               const TCSlice& slc,
               PFPStruct& pfp)
   {
@@ -3360,7 +3460,7 @@ namespace tca {
     // try to do better using dE/dx
     float dEdXAve = 0;
     float dEdXRms = 0;
-    Average_dEdX(clockData, detProp, slc, pfp, dEdXAve, dEdXRms);
+    Average_dEdX(clockData, detProp, tcx, slc, pfp, dEdXAve, dEdXRms);
     if (dEdXAve < 0) return 0;
     // looks like a proton if dE/dx is high and the rms is low
     dEdXRms /= dEdXAve;
@@ -3370,9 +3470,9 @@ namespace tca {
     float cnt = 0;
     for (auto tjid : pfp.TjIDs) {
       auto& tj = slc.tjs[tjid - 1];
-      float el = ElectronLikelihood(slc, tj);
+      float el = ElectronLikelihood(tcx, slc, tj);
       if (el <= 0) continue;
-      mcsmom += MCSMom(slc, tj);
+      mcsmom += MCSMom(tcx, slc, tj);
       chgrms += tj.ChgRMS;
       ++cnt;
     } // tjid
@@ -3396,6 +3496,7 @@ namespace tca {
   PrintTP3Ds(detinfo::DetectorClocksData const& clockData,
              detinfo::DetectorPropertiesData const& detProp,
              std::string someText,
+             TCContext& tcx,
              const TCSlice& slc,
              const PFPStruct& pfp,
              short printPts)
@@ -3463,22 +3564,22 @@ namespace tca {
       myprt << std::setw(7) << tp3d.Pos[0] << std::setw(7) << tp3d.Pos[1] << std::setw(7)
             << tp3d.Pos[2];
       myprt << std::setprecision(1) << std::setw(6) << (tp3d.Pos[0] - tp3d.TPX);
-      float pull = PointPull(pfp, tp3d);
+      float pull = PointPull(tcx, pfp, tp3d);
       myprt << std::setprecision(1) << std::setw(6) << pull;
       myprt << std::setw(3) << tp3d.Flags[kTP3DGood] << tp3d.Flags[kTP3DBad];
       myprt << std::setw(7) << std::setprecision(1) << PosSep(tp3d.Pos, pfp.TP3Ds[0].Pos);
       myprt << std::setw(7) << std::setprecision(1) << tp3d.along;
-      myprt << std::setw(6) << std::setprecision(2) << dEdx(clockData, detProp, slc, tp3d);
+      myprt << std::setw(6) << std::setprecision(2) << dEdx(clockData, detProp, tcx, slc, tp3d);
       // print SignalAtTP in each plane
       myprt << " ";
       for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
         CTP_t inCTP = EncodeCTP(pfp.TPCID.Cryostat, pfp.TPCID.TPC, plane);
-        auto tp = MakeBareTP(detProp, slc, tp3d.Pos, inCTP);
-        myprt << " " << SignalAtTp(tp);
+        auto tp = MakeBareTP(detProp, tcx, slc, tp3d.Pos, inCTP);
+        myprt << " " << SignalAtTp(tcx, slc, tp);
       } // plane
       if (tp3d.TjID > 0) {
         auto& tp = slc.tjs[tp3d.TjID - 1].Pts[tp3d.TPIndex];
-        myprt << " T" << tp3d.TjID << "_" << tp3d.TPIndex << "_" << PrintPos(slc, tp) << " "
+        myprt << " T" << tp3d.TjID << "_" << tp3d.TPIndex << "_" << PrintPos(tcx, slc, tp) << " "
               << TPEnvString(tp);
       }
       else {
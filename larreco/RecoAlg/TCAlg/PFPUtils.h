@@ -24,39 +24,43 @@ namespace geo {
 
 namespace tca {
 
-  void StitchPFPs();
+  void StitchPFPs(TCContext& tcx);
   void FindPFParticles(detinfo::DetectorClocksData const& clockData,
                        detinfo::DetectorPropertiesData const& detProp,
+                       TCContext& tcx,
                        TCSlice& slc);
   void MakePFParticles(detinfo::DetectorClocksData const& clockData,
                        detinfo::DetectorPropertiesData const& detProp,
+                       TCContext& tcx,
                        TCSlice& slc,
                        std::vector<MatchStruct> matVec,
                        unsigned short matVec_Iter);
-  bool ReconcileTPs(TCSlice& slc, PFPStruct& pfp, bool prt);
-  void ReconcileTPs(TCSlice& slc);
-  void MakePFPTjs(TCSlice& slc);
-  void FillWireIntersections(TCSlice& slc);
-  bool TCIntersectionPoint(unsigned int wir1,
+  bool ReconcileTPs(TCContext& tcx, TCSlice& slc, PFPStruct& pfp, bool prt);
+  void ReconcileTPs(TCContext& tcx, TCSlice& slc);
+  void MakePFPTjs(TCContext& tcx, TCSlice& slc);
+  void FillWireIntersections(TCContext& tcx, TCSlice& slc);
+  bool TCIntersectionPoint(TCContext& tcx, unsigned int wir1,
                            unsigned int wir2,
                            unsigned int pln1,
                            unsigned int pln2,
                            float& y,
                            float& z);
-  void Match3Planes(TCSlice& slc, std::vector<MatchStruct>& matVec);
-  bool SptInTPC(const std::array<unsigned int, 3>& sptHits, unsigned int tpc);
-  void Match2Planes(TCSlice& slc, std::vector<MatchStruct>& matVec);
+  void Match3Planes(TCContext& tcx, TCSlice& slc, std::vector<MatchStruct>& matVec);
+  bool SptInTPC(TCContext& tcx, const std::array<unsigned int, 3>& sptHits, unsigned int tpc);
+  void Match2Planes(TCContext& tcx, TCSlice& slc, std::vector<MatchStruct>& matVec);
   bool Update(detinfo::DetectorClocksData const& clockData,
               detinfo::DetectorPropertiesData const& detProp,
+              TCContext& tcx,
               const TCSlice& slc,
               PFPStruct& pfp,
               bool prt);
   bool ReSection(detinfo::DetectorClocksData const& clockData,
                  detinfo::DetectorPropertiesData const& detProp,
+                 TCContext& tcx,
                  const TCSlice& slc,
                  PFPStruct& pfp,
                  bool prt);
-  void CountBadPoints(const TCSlice& slc,
+  void CountBadPoints(TCContext& tcx, const TCSlice& slc,
                       const PFPStruct& pfp,
                       unsigned short fromPt,
                       unsigned short toPt,
@@ -74,33 +78,39 @@ namespace tca {
                 unsigned short& npts);
   bool FitSection(detinfo::DetectorClocksData const& clockData,
                   detinfo::DetectorPropertiesData const& detProp,
+                  TCContext& tcx,
                   const TCSlice& slc,
                   PFPStruct& pfp,
                   unsigned short sfIndex);
   SectionFit FitTP3Ds(detinfo::DetectorPropertiesData const& detProp,
+                      TCContext& tcx,
                       const TCSlice& slc,
                       const std::vector<TP3D>& tp3ds,
                       unsigned short fromPt,
                       short fitDir,
                       unsigned short nPtsFit);
   bool FitTP3Ds(detinfo::DetectorPropertiesData const& detProp,
+                TCContext& tcx,
                 const TCSlice& slc,
                 PFPStruct& pfp,
                 unsigned short fromPt,
                 unsigned short npts,
                 unsigned short sfIndex,
                 float& chiDOF);
-  void ReconcileVertices(TCSlice& slc, PFPStruct& pfp, bool prt);
+  void ReconcileVertices(TCContext& tcx, TCSlice& slc, PFPStruct& pfp, bool prt);
   void FillGaps3D(detinfo::DetectorClocksData const& clockData,
                   detinfo::DetectorPropertiesData const& detProp,
+                  TCContext& tcx,
                   TCSlice& slc,
                   PFPStruct& pfp,
                   bool prt);
   bool ValidTwoPlaneMatch(detinfo::DetectorPropertiesData const& detProp,
+                          TCContext& tcx,
                           const TCSlice& slc,
                           const PFPStruct& pfp);
   void AddPointsInRange(detinfo::DetectorClocksData const& clockData,
                         detinfo::DetectorPropertiesData const& detProp,
+                        TCContext& tcx,
                         TCSlice& slc,
                         PFPStruct& pfp,
                         unsigned short fromPt,
@@ -114,14 +124,17 @@ namespace tca {
   bool SortSection(PFPStruct& pfp, unsigned short sectionFitIndex);
   void Recover(detinfo::DetectorClocksData const& clockData,
                detinfo::DetectorPropertiesData const& detProp,
+               TCContext& tcx,
                TCSlice& slc, PFPStruct& pfp, bool prt);
-  bool MakeTP3Ds(detinfo::DetectorPropertiesData const& detProp, TCSlice& slc,
+  bool MakeTP3Ds(detinfo::DetectorPropertiesData const& detProp, TCContext& tcx, TCSlice& slc,
                  PFPStruct& pfp, bool prt);
   bool MakeSmallAnglePFP(detinfo::DetectorPropertiesData const& detProp,
+                         TCContext& tcx,
                          TCSlice& slc, PFPStruct& pfp, bool prt);
   void Reverse(TCSlice& slc, PFPStruct& pfp);
-  void FillmAllTraj(detinfo::DetectorPropertiesData const& detProp, TCSlice& slc);
+  void FillmAllTraj(detinfo::DetectorPropertiesData const& detProp, TCContext& tcx, TCSlice& slc);
   TP3D MakeTP3D(detinfo::DetectorPropertiesData const& detProp, 
+                TCContext& tcx, 
                 TCSlice& slc, const TrajPoint& itp, const TrajPoint& jtp);
   double DeltaAngle(const Vector3_t v1, const Vector3_t v2);
   inline double
@@ -135,33 +148,38 @@ namespace tca {
   bool SetMag(Vector3_t& v1, double mag);
   void FilldEdx(detinfo::DetectorClocksData const& clockData,
                 detinfo::DetectorPropertiesData const& detProp,
+                TCContext& tcx,
                 const TCSlice& slc,
                 PFPStruct& pfp);
   float dEdx(detinfo::DetectorClocksData const& clockData,
              detinfo::DetectorPropertiesData const& detProp,
+             TCContext& tcx,
              const TCSlice& slc,
              TP3D& tp3d);
   void Average_dEdX(detinfo::DetectorClocksData const& clockData,
                     detinfo::DetectorPropertiesData const& detProp,
+                    TCContext& tcx,
                     const TCSlice& slc,
                     PFPStruct& pfp,
                     float& dEdXAve,
                     float& dEdXRms);
   TP3D CreateTP3D(detinfo::DetectorPropertiesData const& detProp,
+                  TCContext& tcx,
                   const TCSlice& slc,
                   int tjID,
                   unsigned short tjPt);
   bool SetSection(detinfo::DetectorPropertiesData const& detProp,
+                  TCContext& tcx,
                   const TCSlice& slc,
                   PFPStruct& pfp,
                   TP3D& tp3d);
-  float PointPull(const PFPStruct& pfp, const TP3D& tp3d);
+  float PointPull(TCContext& tcx, const PFPStruct& pfp, const TP3D& tp3d);
   PFPStruct CreatePFP(const TCSlice& slc);
   void PFPVertexCheck(TCSlice& tcs);
-  void DefinePFPParents(TCSlice& slc, bool prt);
+  void DefinePFPParents(TCContext& tcx, TCSlice& slc, bool prt);
   bool StorePFP(TCSlice& slc, PFPStruct& pfp);
   bool InsideFV(const TCSlice& slc, const PFPStruct& pfp, unsigned short end);
-  bool InsideTPC(const Point3_t& pos, geo::TPCID& inTPCID);
+  bool InsideTPC(TCContext& tcx, const Point3_t& pos, geo::TPCID& inTPCID);
   void FindAlongTrans(Point3_t pos1, Vector3_t dir1, Point3_t pos2, Point2_t& alongTrans);
   bool PointDirIntersect(Point3_t p1,
                          Vector3_t p1Dir,
@@ -176,10 +194,12 @@ namespace tca {
                          Point3_t& intersect,
                          float& doca);
   float ChgFracBetween(detinfo::DetectorPropertiesData const& detProp,
+                       TCContext& tcx,
                        const TCSlice& slc,
                        Point3_t pos1,
                        Point3_t pos2);
   float ChgFracNearEnd(detinfo::DetectorPropertiesData const& detProp,
+                       TCContext& tcx,
                        const TCSlice& slc,
                        const PFPStruct& pfp,
                        unsigned short end);
@@ -193,11 +213,13 @@ namespace tca {
   unsigned short FarEnd(const TCSlice& slc, const PFPStruct& pfp, const Point3_t& pos);
   int PDGCodeVote(detinfo::DetectorClocksData const& clockData,
                   detinfo::DetectorPropertiesData const& detProp,
+                  TCContext& tcx,
                   const TCSlice& slc,
                   PFPStruct& pfp);
   void PrintTP3Ds(detinfo::DetectorClocksData const& clockData,
                   detinfo::DetectorPropertiesData const& detProp,
                   std::string someText,
+                  TCContext& tcx,
                   const TCSlice& slc,
                   const PFPStruct& pfp,
                   short printPts);
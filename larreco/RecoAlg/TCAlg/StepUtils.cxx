@@ -25,7 +25,7 @@
 namespace tca {
 
   //////////////////////////////////////////
-  void StepAway(TCSlice& slc, Trajectory& tj)
+  void StepAway(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Step along the direction specified in the traj vector in steps of size step
     // (wire spacing equivalents). Find hits between the last trajectory point and
@@ -59,31 +59,31 @@ namespace tca {
     bool useMaxChiCut = (tj.PDGCode == 13 || !tj.Strategy[kSlowing]);
 
     // Get the first forecast when there are 6 points with charge
-    tjfs.resize(1);
-    tjfs[0].nextForecastUpdate = 6;
+    slc.tjfs.resize(1);
+    slc.tjfs[0].nextForecastUpdate = 6;
 
     for(unsigned short step = 1; step < 10000; ++step) {
-      unsigned short npwc = NumPtsWithCharge(slc, tj, false);
+      unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
       // analyze the Tj when there are 6 points to see if we should stop
-      if(npwc == 6 && StopShort(slc, tj, tcc.dbgStp)) break;
+      if(npwc == 6 && StopShort(tcx, slc, tj, tcx.tcc.dbgStp)) break;
       // Get a forecast of what is ahead.
-      if(tcc.doForecast && !tj.AlgMod[kRvPrp] && npwc == tjfs[tjfs.size() - 1].nextForecastUpdate) {
-        Forecast(slc, tj);
-        SetStrategy(slc, tj);
-        SetPDGCode(slc, tj);
+      if(tcx.tcc.doForecast && !tj.AlgMod[kRvPrp] && npwc == slc.tjfs[slc.tjfs.size() - 1].nextForecastUpdate) {
+        Forecast(tcx, slc, tj);
+        SetStrategy(tcx, slc, tj);
+        SetPDGCode(tcx, slc, tj);
       }
       // make a copy of the previous TP
       lastPt = tj.Pts.size() - 1;
       tp = tj.Pts[lastPt];
       ++tp.Step;
-      double stepSize = tcc.VLAStepSize;
+      double stepSize = tcx.tcc.VLAStepSize;
       if(tp.AngleCode < 2) stepSize = std::abs(1/ltp.Dir[0]);
       // move the local TP position by one step in the right direction
       for(unsigned short iwt = 0; iwt < 2; ++iwt) ltp.Pos[iwt] += ltp.Dir[iwt] * stepSize;
       // copy this position into tp
       tp.Pos = ltp.Pos;
       tp.Dir = ltp.Dir;
-      if(tcc.dbgStp) {
+      if(tcx.tcc.dbgStp) {
         mf::LogVerbatim myprt("TC");
         myprt<<"StepAway "<<step<<" Pos "<<tp.Pos[0]<<" "<<tp.Pos[1]<<" Dir "<<tp.Dir[0]<<" "<<tp.Dir[1]<<" stepSize "<<stepSize<<" AngCode "<<tp.AngleCode<<" Strategy";
         for(unsigned short ibt = 0; ibt < StrategyBitNames.size(); ++ibt) {
@@ -91,22 +91,22 @@ namespace tca {
         } // ib
       } // tcc.dbgStp
       // hit the boundary of the TPC?
-      if(tp.Pos[0] < 0 || tp.Pos[0] > tcc.maxPos0[plane] ||
-         tp.Pos[1] < 0 || tp.Pos[1] > tcc.maxPos1[plane]) break;
+      if(tp.Pos[0] < 0 || tp.Pos[0] > tcx.tcc.maxPos0[plane] ||
+         tp.Pos[1] < 0 || tp.Pos[1] > tcx.tcc.maxPos1[plane]) break;
       // remove the old hits and other stuff
       tp.Hits.clear();
       tp.UseHit.reset();
       tp.FitChi = 0; tp.Chg = 0;
       tp.Environment.reset();
       unsigned int wire = std::nearbyint(tp.Pos[0]);
-      if(!evt.goodWire[plane][wire]) tp.Environment[kEnvNotGoodWire] = true;
+      if(!tcx.evt.goodWire[plane][wire]) tp.Environment[kEnvNotGoodWire] = true;
       // append to the trajectory
       tj.Pts.push_back(tp);
       // update the index of the last TP
       lastPt = tj.Pts.size() - 1;
       // look for hits
       bool sigOK = false;
-      AddHits(slc, tj, lastPt, sigOK);
+      AddHits(tcx, slc, tj, lastPt, sigOK);
       // Check the stop flag
       if(tj.EndFlag[1][kAtTj]) break;
       // If successfull, AddHits has defined UseHit for this TP,
@@ -119,7 +119,7 @@ namespace tca {
         ++nMissedSteps;
         // First check for no signal in the vicinity. AddHits checks the hit collection for
         // the current slice. This version of SignalAtTp checks the allHits collection.
-        sigOK = SignalAtTp(ltp);
+        sigOK = SignalAtTp(tcx, slc, ltp);
         if(lastPt > 0) {
           // break if this is a reverse propagate activity and there was no signal (not on a dead wire)
           if(!sigOK && tj.AlgMod[kRvPrp]) break;
@@ -128,11 +128,11 @@ namespace tca {
           // the last point with hits (used or not) is the previous point
           unsigned short lastPtWithHits = lastPt - 1;
           float tps = TrajPointSeparation(tj.Pts[lastPtWithHits], ltp);
-          float dwc = DeadWireCount(slc, ltp, tj.Pts[lastPtWithHits]);
+          float dwc = DeadWireCount(tcx, slc, ltp, tj.Pts[lastPtWithHits]);
           float nMissedWires = tps * std::abs(ltp.Dir[0]) - dwc;
-          float maxWireSkip = tcc.maxWireSkipNoSignal;
-          if(sigOK) maxWireSkip = tcc.maxWireSkipWithSignal;
-          if(tcc.dbgStp) mf::LogVerbatim("TC")<<" StepAway: no hits found at ltp "<<PrintPos(slc, ltp)
+          float maxWireSkip = tcx.tcc.maxWireSkipNoSignal;
+          if(sigOK) maxWireSkip = tcx.tcc.maxWireSkipWithSignal;
+          if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" StepAway: no hits found at ltp "<<PrintPos(tcx, slc, ltp)
               <<" nMissedWires "<<std::fixed<<std::setprecision(1)<<nMissedWires
               <<" dead wire count "<<dwc<<" maxWireSkip "<<maxWireSkip<<" tj.PDGCode "<<tj.PDGCode;
           if(nMissedWires > maxWireSkip) {
@@ -145,11 +145,11 @@ namespace tca {
               if(slc.slHits[iht].InTraj == 0 && tj.Pts[lastLonelyPoint].Delta < 3 * tj.Pts[lastLonelyPoint].DeltaRMS) {
                 slc.slHits[iht].InTraj = tj.ID;
                 tj.Pts[lastLonelyPoint].UseHit[0] = true;
-                DefineHitPos(slc, tj.Pts[lastLonelyPoint]);
+                DefineHitPos(tcx, slc, tj.Pts[lastLonelyPoint]);
                 SetEndPoints(tj);
-                if(tcc.dbgStp) {
+                if(tcx.tcc.dbgStp) {
                   mf::LogVerbatim("TC")<<" Added a Last Lonely Hit before breaking ";
-                  PrintTP("LLH", slc, lastPt, tj.StepDir, tj.Pass, tj.Pts[lastLonelyPoint]);
+                  PrintTP("LLH", tcx, slc, lastPt, tj.StepDir, tj.Pass, tj.Pts[lastLonelyPoint]);
                 }
               }
             }
@@ -165,31 +165,31 @@ namespace tca {
       // Found hits at this location so reset the missed steps counter
       nMissedSteps = 0;
       // Update the last point fit, etc using the just added hit(s)
-      UpdateTraj(slc, tj);
+      UpdateTraj(tcx, slc, tj);
       // a failure occurred
       if(tj.NeedsUpdate) return;
       if(tj.Pts[lastPt].Chg == 0) {
         // There are points on the trajectory by none used in the last step. See
         // how long this has been going on
         float tps = TrajPointSeparation(tj.Pts[tj.EndPt[1]], ltp);
-        float dwc = DeadWireCount(slc, ltp, tj.Pts[tj.EndPt[1]]);
+        float dwc = DeadWireCount(tcx, slc, ltp, tj.Pts[tj.EndPt[1]]);
         float nMissedWires = tps * std::abs(ltp.Dir[0]) - dwc;
-        if(tcc.dbgStp)  mf::LogVerbatim("TC")<<" Hits exist on the trajectory but are not used. Missed wires "<<std::nearbyint(nMissedWires)<<" dead wire count "<<(int)dwc;
+        if(tcx.tcc.dbgStp)  mf::LogVerbatim("TC")<<" Hits exist on the trajectory but are not used. Missed wires "<<std::nearbyint(nMissedWires)<<" dead wire count "<<(int)dwc;
         // break if this is a reverse propagate activity with no dead wires
         if(tj.AlgMod[kRvPrp] && dwc == 0) break;
-        if(nMissedWires > tcc.maxWireSkipWithSignal) break;
+        if(nMissedWires > tcx.tcc.maxWireSkipWithSignal) break;
         // try this out
-        if(!MaskedHitsOK(slc, tj)) {
+        if(!MaskedHitsOK(tcx, slc, tj)) {
           return;
         }
         // check for a series of bad fits and stop stepping
-        if(tcc.useAlg[kStopBadFits] && nMissedWires > 4 && StopIfBadFits(slc, tj)) break;
+        if(tcx.tcc.useAlg[kStopBadFits] && nMissedWires > 4 && StopIfBadFits(tcx, slc, tj)) break;
         // Keep stepping
-        if(tcc.dbgStp) {
+        if(tcx.tcc.dbgStp) {
           if(tj.AlgMod[kRvPrp]) {
-            PrintTrajectory("RP", slc, tj, lastPt);
+            PrintTrajectory("RP", tcx, slc, tj, lastPt);
           } else {
-            PrintTrajectory("SC", slc, tj, lastPt);
+            PrintTrajectory("SC", tcx, slc, tj, lastPt);
           }
         }
         continue;
@@ -200,7 +200,7 @@ namespace tca {
         bool badTj = (PosSep2(tj.Pts[0].HitPos, tj.Pts[2].HitPos) < PosSep2(tj.Pts[0].HitPos, tj.Pts[1].HitPos));
         // ensure that this didn't start as a small angle trajectory and immediately turn
         // into a large angle one
-        if(!badTj && tj.Pts[lastPt].AngleCode > tcc.maxAngleCode[tj.Pass]) badTj = true;
+        if(!badTj && tj.Pts[lastPt].AngleCode > tcx.tcc.maxAngleCode[tj.Pass]) badTj = true;
         // check for a large change in angle
         if(!badTj) {
           float dang = DeltaAngle(tj.Pts[0].Ang, tj.Pts[2].Ang);
@@ -209,7 +209,7 @@ namespace tca {
         //check for a wacky delta
         if(!badTj && tj.Pts[2].Delta > 2) badTj = true;
         if(badTj) {
-          if(tcc.dbgStp) mf::LogVerbatim("TC")<<" Bad Tj found on the third point. Quit stepping.";
+          if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" Bad Tj found on the third point. Quit stepping.";
           tj.IsGood = false;
           return;
         }
@@ -221,60 +221,60 @@ namespace tca {
         // see if TPs have been masked off many times and if the
         // environment is clean. If so, return and try with next pass
         // cuts
-        if(!MaskedHitsOK(slc, tj)) {
-          if(tcc.dbgStp) {
+        if(!MaskedHitsOK(tcx, slc, tj)) {
+          if(tcx.tcc.dbgStp) {
             if(tj.AlgMod[kRvPrp]) {
-              PrintTrajectory("RP", slc, tj, lastPt);
+              PrintTrajectory("RP", tcx, slc, tj, lastPt);
             } else {
-              PrintTrajectory("SC", slc, tj, lastPt);
+              PrintTrajectory("SC", tcx, slc, tj, lastPt);
             }
           }
           return;
         }
-        if(tcc.dbgStp) {
+        if(tcx.tcc.dbgStp) {
           if(tj.AlgMod[kRvPrp]) {
-            PrintTrajectory("RP", slc, tj, lastPt);
+            PrintTrajectory("RP", tcx, slc, tj, lastPt);
           } else {
-            PrintTrajectory("SC", slc, tj, lastPt);
+            PrintTrajectory("SC", tcx, slc, tj, lastPt);
           }
         }
         continue;
       }
       // We have added a TP with hits
       // check for a kink. Stop crawling if one is found
-      GottaKink(slc, tj, true);
+      GottaKink(tcx, slc, tj, true);
       if(tj.EndFlag[1][kAtKink]) {
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<"   stop at kink";
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"   stop at kink";
         break;
       }
       // See if the Chisq/DOF exceeds the maximum.
       // UpdateTraj should have reduced the number of points fit
       // as much as possible for this pass, so this trajectory is in trouble.
-      if(tj.Pts[lastPt].FitChi > tcc.maxChi && useMaxChiCut) {
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<"   bad FitChi "<<tj.Pts[lastPt].FitChi<<" cut "<<tcc.maxChi;
+      if(tj.Pts[lastPt].FitChi > tcx.tcc.maxChi && useMaxChiCut) {
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"   bad FitChi "<<tj.Pts[lastPt].FitChi<<" cut "<<tcx.tcc.maxChi;
         // remove the last point before quitting
         UnsetUsedHits(slc, tj.Pts[lastPt]);
         SetEndPoints(tj);
-        tj.IsGood = (NumPtsWithCharge(slc, tj, true) > tcc.minPtsFit[tj.Pass]);
+        tj.IsGood = (NumPtsWithCharge(tcx, slc, tj, true) > tcx.tcc.minPtsFit[tj.Pass]);
         break;
       }
-      if(tcc.dbgStp) {
+      if(tcx.tcc.dbgStp) {
         if(tj.AlgMod[kRvPrp]) {
-          PrintTrajectory("RP", slc, tj, lastPt);
+          PrintTrajectory("RP", tcx, slc, tj, lastPt);
         } else {
-          PrintTrajectory("SC", slc, tj, lastPt);
+          PrintTrajectory("SC", tcx, slc, tj, lastPt);
         }
       } // tcc.dbgStp
     } // step
 
-    SetPDGCode(slc, tj);
+    SetPDGCode(tcx, slc, tj);
 
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<"End StepAway with tj size "<<tj.Pts.size();
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"End StepAway with tj size "<<tj.Pts.size();
 
   } // StepAway
 
 //////////////////////////////////////////
-  bool StopShort(TCSlice& slc, Trajectory& tj, bool prt)
+  bool StopShort(TCContext& tcx, TCSlice& slc, Trajectory& tj, bool prt)
   {
     // Analyze the trajectory when it is short (~6 points) to look for a pattern like
     // this QQQqqq, where Q is a large charge hit and q is a low charge hit. If this
@@ -283,15 +283,15 @@ namespace tca {
 
     // don't use this function during reverse propagation
     if(tj.AlgMod[kRvPrp]) return false;
-    if(!tcc.useAlg[kStopShort]) return false;
+    if(!tcx.tcc.useAlg[kStopShort]) return false;
 
-    unsigned short npwc = NumPtsWithCharge(slc, tj, false);
+    unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
     if(npwc > 10) return false;
     ParFit chgFit;
     FitPar(slc, tj, tj.EndPt[0], npwc, 1, chgFit, 1);
     if(prt) {
       mf::LogVerbatim myprt("TC");
-      myprt<<"StopShort: chgFit at "<<PrintPos(slc, tj.Pts[tj.EndPt[0]]);
+      myprt<<"StopShort: chgFit at "<<PrintPos(tcx, slc, tj.Pts[tj.EndPt[0]]);
       myprt<<" ChiDOF "<<chgFit.ChiDOF;
       myprt<<" chg0 "<<chgFit.Par0<<" +/- "<<chgFit.ParErr;
       myprt<<" slp "<<chgFit.ParSlp<<" +/- "<<chgFit.ParSlpErr;
@@ -301,7 +301,7 @@ namespace tca {
     // a good ChiDOF
     if(chgFit.ChiDOF < 2) return false;
     if(chgFit.ParSlp > -20) return false;
-    if(prt) PrintTrajectory("SS", slc, tj, USHRT_MAX);
+    if(prt) PrintTrajectory("SS", tcx, slc, tj, USHRT_MAX);
     // Find the average charge using the first 3 points
     float cnt = 0;
     float aveChg = 0;
@@ -325,22 +325,22 @@ namespace tca {
       firstLoPt = ipt;
       break;
     } // ipt
-    if(prt) mf::LogVerbatim("TC")<<"    stop tracking at "<<PrintPos(slc, tj.Pts[firstLoPt]);
+    if(prt) mf::LogVerbatim("TC")<<"    stop tracking at "<<PrintPos(tcx, slc, tj.Pts[firstLoPt]);
     // Remove everything from the firstLoPt to the end of the trajectory
     for(unsigned short ipt = firstLoPt; ipt <= tj.EndPt[1]; ++ipt) UnsetUsedHits(slc, tj.Pts[ipt]);
     SetEndPoints(tj);
-    UpdateTjChgProperties("SS", slc, tj, prt);
+    UpdateTjChgProperties("SS", tcx, slc, tj, prt);
     tj.AlgMod[kStopShort] = true;
     return true;
   } // StopShort
 
 //////////////////////////////////////////
-  void SetStrategy(TCSlice& slc, Trajectory& tj)
+  void SetStrategy(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Determine if the tracking strategy is appropriate and make some tweaks if it isn't
-    if(tjfs.empty()) return;
+    if(slc.tjfs.empty()) return;
     // analyze the last forecast
-    auto& tjf = tjfs[tjfs.size() - 1];
+    auto& tjf = slc.tjfs[slc.tjfs.size() - 1];
 
     auto& lastTP = tj.Pts[tj.EndPt[1]];
     // Stay in Slowing strategy if we are in it and reduce the number of points fit further
@@ -349,10 +349,10 @@ namespace tca {
       return;
     }
 
-    float npwc = NumPtsWithCharge(slc, tj, false);
+    float npwc = NumPtsWithCharge(tcx, slc, tj, false);
     // Keep using the StiffMu strategy if the tj is long and MCSMom is high
     if(tj.Strategy[kStiffMu] && tj.MCSMom > 800 && npwc > 200) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: Keep using the StiffMu strategy";
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: Keep using the StiffMu strategy";
       return;
     }
     bool tkLike = (tjf.outlook < 1.5);
@@ -363,7 +363,7 @@ namespace tca {
     if(!shLike) shLike = tjf.showerLikeFraction > 0.5;
     float momRat = 0;
     if(tj.MCSMom > 0) momRat = (float)tjf.MCSMom / (float)tj.MCSMom;
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim myprt("TC");
       myprt<<"SetStrategy: npwc "<<npwc<<" outlook "<<tjf.outlook;
       myprt<<" tj MCSMom "<<tj.MCSMom<<" forecast MCSMom "<<tjf.MCSMom;
@@ -377,28 +377,28 @@ namespace tca {
     // Look for a long clean muon in the forecast
     bool stiffMu = (tkLike && tjf.MCSMom > 600 && tjf.nextForecastUpdate > 100);
     if(stiffMu) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: High MCSMom, long forecast. Use the StiffMu strategy";
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: High MCSMom, long forecast. Use the StiffMu strategy";
       tj.Strategy.reset();
       tj.Strategy[kStiffMu] = true;
       return;
     } // StiffMu
     bool notStiff = (!tj.Strategy[kStiffEl] && !tj.Strategy[kStiffMu]);
     if(notStiff && !shLike && tj.MCSMom < 100 && tjf.MCSMom < 100 && chgIncreasing) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: Low MCSMom. Use the Slowing Tj strategy";
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: Low MCSMom. Use the Slowing Tj strategy";
       tj.Strategy.reset();
       tj.Strategy[kSlowing] = true;
       lastTP.NTPsFit = 5;
       return;
     } // Low MCSMom
     if(notStiff && !shLike && tj.MCSMom < 200 && momRat < 0.7 && chgIncreasing) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: Low MCSMom & low momRat. Use the Slowing Tj strategy";
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: Low MCSMom & low momRat. Use the Slowing Tj strategy";
       tj.Strategy.reset();
       tj.Strategy[kSlowing] = true;
       lastTP.NTPsFit = 5;
       return;
     } // low MCSMom
     if(!tjf.leavesBeforeEnd && tjf.endBraggPeak) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: Found a Bragg peak. Use the Slowing Tj strategy";
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: Found a Bragg peak. Use the Slowing Tj strategy";
       tj.Strategy.reset();
       tj.Strategy[kSlowing] = true;
       lastTP.NTPsFit = 5;
@@ -408,12 +408,12 @@ namespace tca {
       // A long track-like trajectory that has many points fit and the outlook is track-like and
       // it leaves the forecast polygon. Don't change the strategy but decrease the number of points fit
       lastTP.NTPsFit /= 2;
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: Long track-like wandered out of forecast envelope. Reduce NTPsFit to "<<lastTP.NTPsFit;
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: Long track-like wandered out of forecast envelope. Reduce NTPsFit to "<<lastTP.NTPsFit;
       return;
     } // fairly long and leaves the side
     // a track-like trajectory that has high MCSMom in the forecast and hits a shower
     if(tkLike && tjf.MCSMom > 600 && (tjf.foundShower || tjf.chgFitChiDOF > 20)) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: high MCSMom "<<tjf.MCSMom<<" and a shower ahead. Use the StiffEl strategy";
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: high MCSMom "<<tjf.MCSMom<<" and a shower ahead. Use the StiffEl strategy";
       tj.Strategy.reset();
       tj.Strategy[kStiffEl] = true;
       // we think we know the direction (towards the shower) so  startEnd is 0
@@ -421,7 +421,7 @@ namespace tca {
       return;
     } // Stiff electron
     if(shLike && !tjf.leavesBeforeEnd) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: Inside a shower. Use the StiffEl strategy";
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"SetStrategy: Inside a shower. Use the StiffEl strategy";
       tj.Strategy.reset();
       tj.Strategy[kStiffEl] = true;
       // we think we know the direction (towards the shower) so  startEnd is 0
@@ -431,7 +431,7 @@ namespace tca {
   } // SetStrategy
 
   //////////////////////////////////////////
-  void Forecast(TCSlice& slc, const Trajectory& tj)
+  void Forecast(TCContext& tcx, TCSlice& slc, const Trajectory& tj)
   {
     // Extrapolate the last TP of tj by many steps and return a forecast of what is ahead
     // -1       error or not sure
@@ -443,19 +443,19 @@ namespace tca {
     if(tj.Pts[tj.EndPt[1]].AngleCode == 2) return;
 
     // add a new forecast
-    tjfs.resize(tjfs.size() + 1);
+    slc.tjfs.resize(slc.tjfs.size() + 1);
     // assume there is insufficient info to make a decision
-    auto& tjf = tjfs[tjfs.size() - 1];
+    auto& tjf = slc.tjfs[slc.tjfs.size() - 1];
     tjf.outlook = -1;
     tjf.nextForecastUpdate = USHRT_MAX;
 
-    unsigned short npwc = NumPtsWithCharge(slc, tj, false);
+    unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
     unsigned short istp = 0;
     unsigned short nMissed = 0;
 
-    bool doPrt = tcc.dbgStp;
+    bool doPrt = tcx.tcc.dbgStp;
     // turn off annoying output from DefineHitPos
-    if(doPrt) tcc.dbgStp = false;
+    if(doPrt) tcx.tcc.dbgStp = false;
     // find the minimum average TP charge. This will be used to calculate the
     // 'effective number of hits' on a wire = total charge on the wire within the
     // window / (minimum average TP charge). This is intended to reduce the sensitivity
@@ -470,7 +470,7 @@ namespace tca {
     // start a forecast Tj comprised of the points in the forecast envelope
     Trajectory fctj;
     fctj.CTP = tj.CTP;
-    fctj.ID = evt.WorkID;
+    fctj.ID = slc.ids.WorkID;
     // make a local copy of the last point
     auto ltp = tj.Pts[tj.EndPt[1]];
     // Use the hits position instead of the fitted position so that a bad
@@ -479,7 +479,7 @@ namespace tca {
     if(forecastWin0 < 1) forecastWin0 = 1;
     ltp.Pos = ltp.HitPos;
     double stepSize = std::abs(1/ltp.Dir[0]);
-    float window = tcc.showerTag[7] * stepSize;
+    float window = tcx.tcc.showerTag[7] * stepSize;
     if(doPrt) {
       mf::LogVerbatim("TC")<<"Forecast T"<<tj.ID<<" PDGCode "<<tj.PDGCode<<" npwc "<<npwc<<" minAveChg "<<(int)minAveChg<<" stepSize "<<std::setprecision(2)<<stepSize<<" window "<<window;
       mf::LogVerbatim("TC")<<" stp ___Pos____  nTPH  Chg ChgPull  Delta  DRMS  chgWid nTkLk nShLk";
@@ -504,7 +504,7 @@ namespace tca {
       if(wire > slc.lastWire[plane]-1) break;
       MoveTPToWire(ltp, (float)wire);
       ++ltp.Step;
-      if(FindCloseHits(slc, ltp, window, kAllHits)) {
+      if(FindCloseHits(tcx, slc, ltp, window, kAllHits)) {
         // Found hits or the wire is dead
         // set all hits used so that we can use DefineHitPos. Note that
         // the hit InTraj is not used or tested in DefineHitPos so this doesn't
@@ -512,9 +512,9 @@ namespace tca {
         if(!ltp.Environment[kEnvNotGoodWire]) {
           nMissed = 0;
           ltp.UseHit.set();
-          DefineHitPos(slc, ltp);
+          DefineHitPos(tcx, slc, ltp);
           fctj.TotChg += ltp.Chg;
-          ltp.Delta = PointTrajDOCA(slc, ltp.HitPos[0], ltp.HitPos[1], ltp);
+          ltp.Delta = PointTrajDOCA(tcx, slc, ltp.HitPos[0], ltp.HitPos[1], ltp);
           ltp.DeltaRMS = ltp.Delta / window;
           ltp.Environment.reset();
           totHits += ltp.Hits.size();
@@ -552,7 +552,7 @@ namespace tca {
           fctj.Pts.push_back(ltp);
           if(doPrt) {
             mf::LogVerbatim myprt("TC");
-            myprt<<std::setw(4)<<npwc + fctj.Pts.size()<<" "<<PrintPos(slc, ltp);
+            myprt<<std::setw(4)<<npwc + fctj.Pts.size()<<" "<<PrintPos(tcx, slc, ltp);
             myprt<<std::setw(5)<<ltp.Hits.size();
             myprt<<std::setw(5)<<(int)ltp.Chg;
             myprt<<std::fixed<<std::setprecision(1);
@@ -574,7 +574,8 @@ namespace tca {
       } // no hits found
     } // istp
     // not enuf info to make a forecast
-    tcc.dbgStp = doPrt;
+    // don't write to tcc unless debugging. It is shared by slices reconstructed concurrently
+    if(doPrt || tcx.tcc.dbgStp) tcx.tcc.dbgStp = doPrt;
     if(fctj.Pts.size() < 3) return;
     // truncate and re-calculate totChg?
     if(trimPts > 0) {
@@ -585,7 +586,7 @@ namespace tca {
       for(auto& tp : fctj.Pts) fctj.TotChg += tp.Chg;
     } // showerEndNear != USHRT_MAX
     SetEndPoints(fctj);
-    fctj.MCSMom = MCSMom(slc, fctj);
+    fctj.MCSMom = MCSMom(tcx, slc, fctj);
     tjf.MCSMom = fctj.MCSMom;
     ParFit chgFit;
     if(maxChgPt > 0.3 * fctj.Pts.size() && maxChg > 3 * tj.AveChg) {
@@ -598,8 +599,8 @@ namespace tca {
     tjf.chgSlope = chgFit.ParSlp;
     tjf.chgSlopeErr = chgFit.ParSlpErr;
     tjf.chgFitChiDOF = chgFit.ChiDOF;
-    ChkStop(slc, fctj);
-    UpdateTjChgProperties("Fc", slc, fctj, false);
+    ChkStop(tcx, slc, fctj);
+    UpdateTjChgProperties("Fc", tcx, slc, fctj, false);
     tjf.chgRMS = fctj.ChgRMS;
     tjf.endBraggPeak = fctj.EndFlag[1][kBragg];
     // Set outlook = Estimate of the number of hits per wire
@@ -626,8 +627,8 @@ namespace tca {
     if(doPrt) {
       mf::LogVerbatim myprt("TC");
       myprt<<"Forecast T"<<tj.ID<<" tj.AveChg "<<(int)tj.AveChg;
-      myprt<<" start "<<PrintPos(slc, tj.Pts[tj.EndPt[1]])<<" cnt "<<fctj.Pts.size()<<" totChg "<<(int)fctj.TotChg;
-      myprt<<" last pos "<<PrintPos(slc, ltp);
+      myprt<<" start "<<PrintPos(tcx, slc, tj.Pts[tj.EndPt[1]])<<" cnt "<<fctj.Pts.size()<<" totChg "<<(int)fctj.TotChg;
+      myprt<<" last pos "<<PrintPos(tcx, slc, ltp);
       myprt<<" MCSMom "<<tjf.MCSMom;
       myprt<<" outlook "<<std::fixed<<std::setprecision(2)<<tjf.outlook;
       myprt<<" chgSlope "<<std::setprecision(1)<<tjf.chgSlope<<" +/- "<<tjf.chgSlopeErr;
@@ -643,19 +644,19 @@ namespace tca {
   } // Forecast
 
   //////////////////////////////////////////
-  void UpdateStiffEl(TCSlice& slc, Trajectory& tj)
+  void UpdateStiffEl(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // A different stategy for updating a high energy electron trajectories
     if(!tj.Strategy[kStiffEl]) return;
     TrajPoint& lastTP = tj.Pts[tj.EndPt[1]];
     // Set the lastPT delta before doing the fit
-    lastTP.Delta = PointTrajDOCA(slc, lastTP.HitPos[0], lastTP.HitPos[1], lastTP);
+    lastTP.Delta = PointTrajDOCA(tcx, slc, lastTP.HitPos[0], lastTP.HitPos[1], lastTP);
     if(tj.Pts.size() < 30) lastTP.NTPsFit += 1;
-    FitTraj(slc, tj);
-    UpdateTjChgProperties("UET", slc, tj, tcc.dbgStp);
-    UpdateDeltaRMS(slc, tj);
-    tj.MCSMom = MCSMom(slc, tj);
-    if(tcc.dbgStp) {
+    FitTraj(tcx, slc, tj);
+    UpdateTjChgProperties("UET", tcx, slc, tj, tcx.tcc.dbgStp);
+    UpdateDeltaRMS(tcx, slc, tj);
+    tj.MCSMom = MCSMom(tcx, slc, tj);
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim("TC")<<"UpdateStiffEl: lastPt "<<tj.EndPt[1]<<" Delta "<<lastTP.Delta<<" AngleCode "<<lastTP.AngleCode<<" FitChi "<<lastTP.FitChi<<" NTPsFit "<<lastTP.NTPsFit<<" MCSMom "<<tj.MCSMom;
     }
     tj.NeedsUpdate = false;
@@ -664,7 +665,7 @@ namespace tca {
   } // UpdateStiffTj
 
   //////////////////////////////////////////
-  void UpdateTraj(TCSlice& slc, Trajectory& tj)
+  void UpdateTraj(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Updates the last added trajectory point fit, average hit rms, etc.
 
@@ -674,7 +675,7 @@ namespace tca {
     if(tj.EndPt[1] < 1) return;
 
     if(tj.Strategy[kStiffEl]) {
-      UpdateStiffEl(slc, tj);
+      UpdateStiffEl(tcx, slc, tj);
       return;
     }
     unsigned int lastPt = tj.EndPt[1];
@@ -685,7 +686,7 @@ namespace tca {
       tj.NeedsUpdate = false;
       return;
     }
-    unsigned short npwc = NumPtsWithCharge(slc, tj, false);
+    unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
 
     // find the previous TP that has hits (and was therefore in the fit)
     unsigned short prevPtWithHits = USHRT_MAX;
@@ -702,28 +703,28 @@ namespace tca {
 
     // define the FitChi threshold above which something will be done
     float maxChi = 2;
-    unsigned short minPtsFit = tcc.minPtsFit[tj.Pass];
+    unsigned short minPtsFit = tcx.tcc.minPtsFit[tj.Pass];
     // just starting out?
     if(lastPt < 4) minPtsFit = 2;
-    bool cleanMuon = (tj.PDGCode == 13 && TrajIsClean(slc, tj, tcc.dbgStp) && !tj.Strategy[kSlowing]);
+    bool cleanMuon = (tj.PDGCode == 13 && TrajIsClean(slc, tj, tcx.tcc.dbgStp) && !tj.Strategy[kSlowing]);
     // was !TrajIsClean...
     if(cleanMuon) {
       // Fitting a clean muon
-      maxChi = tcc.maxChi;
+      maxChi = tcx.tcc.maxChi;
       minPtsFit = lastPt / 3;
     }
 
     // Set the lastPT delta before doing the fit
-    lastTP.Delta = PointTrajDOCA(slc, lastTP.HitPos[0], lastTP.HitPos[1], lastTP);
+    lastTP.Delta = PointTrajDOCA(tcx, slc, lastTP.HitPos[0], lastTP.HitPos[1], lastTP);
 
     // update MCSMom. First ensure that nothing bad has happened
     if(npwc > 3 && tj.Pts[lastPt].Chg > 0 && !tj.Strategy[kSlowing]) {
-      short newMCSMom = MCSMom(slc, tj);
+      short newMCSMom = MCSMom(tcx, slc, tj);
       short minMCSMom = 0.5 * tj.MCSMom;
       if(lastPt > 10 && newMCSMom < minMCSMom) {
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<"UT: MCSMom took a nose-dive "<<newMCSMom;
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"UT: MCSMom took a nose-dive "<<newMCSMom;
         UnsetUsedHits(slc, lastTP);
-        DefineHitPos(slc, lastTP);
+        DefineHitPos(tcx, slc, lastTP);
         SetEndPoints(tj);
         tj.NeedsUpdate = false;
         return;
@@ -731,32 +732,32 @@ namespace tca {
       tj.MCSMom = newMCSMom;
     } // npwc > 3
 
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim("TC")<<"UT: lastPt "<<lastPt<<" lastTP.Delta "<<lastTP.Delta<<" previous point with hits "<<prevPtWithHits<<" tj.Pts size "<<tj.Pts.size()<<" AngleCode "<<lastTP.AngleCode<<" PDGCode "<<tj.PDGCode<<" maxChi "<<maxChi<<" minPtsFit "<<minPtsFit<<" MCSMom "<<tj.MCSMom;
     }
 
-    UpdateTjChgProperties("UT", slc, tj, tcc.dbgStp);
+    UpdateTjChgProperties("UT", tcx, slc, tj, tcx.tcc.dbgStp);
 
     if(lastPt == 1) {
       // Handle the second trajectory point. No error calculation. Just update
       // the position and direction
       lastTP.NTPsFit = 2;
-      FitTraj(slc, tj);
+      FitTraj(tcx, slc, tj);
       lastTP.FitChi = 0.01;
       lastTP.AngErr = tj.Pts[0].AngErr;
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"UT: Second traj point pos "<<lastTP.Pos[0]<<" "<<lastTP.Pos[1]<<"  dir "<<lastTP.Dir[0]<<" "<<lastTP.Dir[1];
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"UT: Second traj point pos "<<lastTP.Pos[0]<<" "<<lastTP.Pos[1]<<"  dir "<<lastTP.Dir[0]<<" "<<lastTP.Dir[1];
       tj.NeedsUpdate = false;
-      SetAngleCode(lastTP);
+      SetAngleCode(tcx, lastTP);
       return;
     }
 
     if(lastPt == 2) {
       // Third trajectory point. Keep it simple
       lastTP.NTPsFit = 3;
-      FitTraj(slc, tj);
+      FitTraj(tcx, slc, tj);
       tj.NeedsUpdate = false;
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"UT: Third traj point fit "<<lastTP.FitChi;
-      SetAngleCode(lastTP);
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"UT: Third traj point fit "<<lastTP.FitChi;
+      SetAngleCode(tcx, lastTP);
       return;
     }
 
@@ -767,14 +768,14 @@ namespace tca {
     if(lastPt > 20 && tj.Pts[prevPtWithHits].FitChi > 1.5 && lastTP.NTPsFit > minPtsFit) lastTP.NTPsFit -= 2;
     // don't let long muon fits get too long
     if(cleanMuon && lastPt > 200 && tj.Pts[prevPtWithHits].FitChi > 1.0) lastTP.NTPsFit -= 2;
-    FitTraj(slc, tj);
+    FitTraj(tcx, slc, tj);
 
     // don't get too fancy when we are starting out
     if(lastPt < 6) {
       tj.NeedsUpdate = false;
-      UpdateDeltaRMS(slc, tj);
-      SetAngleCode(lastTP);
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<" Return with lastTP.FitChi "<<lastTP.FitChi<<" Chg "<<lastTP.Chg;
+      UpdateDeltaRMS(tcx, slc, tj);
+      SetAngleCode(tcx, lastTP);
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" Return with lastTP.FitChi "<<lastTP.FitChi<<" Chg "<<lastTP.Chg;
       return;
     }
 
@@ -790,7 +791,7 @@ namespace tca {
       if(ipt == 0) break;
     }
 
-    unsigned short ndead = DeadWireCount(slc, lastTP.HitPos[0], tj.Pts[firstFitPt].HitPos[0], tj.CTP);
+    unsigned short ndead = DeadWireCount(tcx, slc, lastTP.HitPos[0], tj.Pts[firstFitPt].HitPos[0], tj.CTP);
     if(lastTP.FitChi > 1.5 && tj.Pts.size() > 6) {
       // A large chisq jump can occur if we just jumped a large block of dead wires. In
       // this case we don't want to mask off the last TP but reduce the number of fitted points
@@ -807,39 +808,39 @@ namespace tca {
         float chirat = 0;
         if(prevPtWithHits != USHRT_MAX && tj.Pts[prevPtWithHits].FitChi > 0) chirat = lastTP.FitChi / tj.Pts[prevPtWithHits].FitChi;
         // Don't mask hits when doing RevProp. Reduce NTPSFit instead
-        tj.MaskedLastTP = (chirat > 1.5 && lastTP.NTPsFit > 0.3 * NumPtsWithCharge(slc, tj, false) && !tj.AlgMod[kRvPrp]);
+        tj.MaskedLastTP = (chirat > 1.5 && lastTP.NTPsFit > 0.3 * NumPtsWithCharge(tcx, slc, tj, false) && !tj.AlgMod[kRvPrp]);
         // BB April 19, 2018: Don't mask TPs on low MCSMom Tjs
         if(tj.MaskedLastTP && tj.MCSMom < 30) tj.MaskedLastTP = false;
-        if(tcc.dbgStp) {
-          mf::LogVerbatim("TC")<<" First fit chisq too large "<<lastTP.FitChi<<" prevPtWithHits chisq "<<tj.Pts[prevPtWithHits].FitChi<<" chirat "<<chirat<<" NumPtsWithCharge "<<NumPtsWithCharge(slc, tj, false)<<" tj.MaskedLastTP "<<tj.MaskedLastTP;
+        if(tcx.tcc.dbgStp) {
+          mf::LogVerbatim("TC")<<" First fit chisq too large "<<lastTP.FitChi<<" prevPtWithHits chisq "<<tj.Pts[prevPtWithHits].FitChi<<" chirat "<<chirat<<" NumPtsWithCharge "<<NumPtsWithCharge(tcx, slc, tj, false)<<" tj.MaskedLastTP "<<tj.MaskedLastTP;
         }
         // we should also mask off the last TP if there aren't enough hits
         // to satisfy the minPtsFit constraint
-        if(!tj.MaskedLastTP && NumPtsWithCharge(slc, tj, true) < minPtsFit) tj.MaskedLastTP = true;
+        if(!tj.MaskedLastTP && NumPtsWithCharge(tcx, slc, tj, true) < minPtsFit) tj.MaskedLastTP = true;
       } // few dead wires
     } // lastTP.FitChi > 2 ...
 
     // Deal with a really long trajectory that is in trouble (uB cosmic).
-    if(tj.PDGCode == 13 && lastTP.FitChi > tcc.maxChi) {
-      if(lastTP.NTPsFit > 1.3 * tcc.muonTag[0]) {
+    if(tj.PDGCode == 13 && lastTP.FitChi > tcx.tcc.maxChi) {
+      if(lastTP.NTPsFit > 1.3 * tcx.tcc.muonTag[0]) {
         lastTP.NTPsFit *= 0.8;
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<" Muon - Reduce NTPsFit "<<lastPt;
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" Muon - Reduce NTPsFit "<<lastPt;
       } else {
         tj.MaskedLastTP = true;
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<" Muon - mask last point "<<lastPt;
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" Muon - mask last point "<<lastPt;
       }
     }
 
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<"UT: First fit "<<lastTP.Pos[0]<<" "<<lastTP.Pos[1]<<"  dir "<<lastTP.Dir[0]<<" "<<lastTP.Dir[1]<<" FitChi "<<lastTP.FitChi<<" NTPsFit "<<lastTP.NTPsFit<<" ndead wires "<<ndead<<" tj.MaskedLastTP "<<tj.MaskedLastTP;
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"UT: First fit "<<lastTP.Pos[0]<<" "<<lastTP.Pos[1]<<"  dir "<<lastTP.Dir[0]<<" "<<lastTP.Dir[1]<<" FitChi "<<lastTP.FitChi<<" NTPsFit "<<lastTP.NTPsFit<<" ndead wires "<<ndead<<" tj.MaskedLastTP "<<tj.MaskedLastTP;
       if(tj.MaskedLastTP) {
         UnsetUsedHits(slc, lastTP);
-        DefineHitPos(slc, lastTP);
+        DefineHitPos(tcx, slc, lastTP);
         SetEndPoints(tj);
         lastPt = tj.EndPt[1];
         lastTP.NTPsFit -= 1;
-        FitTraj(slc, tj);
-        UpdateTjChgProperties("UT", slc, tj, tcc.dbgStp);
-        SetAngleCode(lastTP);
+        FitTraj(tcx, slc, tj);
+        UpdateTjChgProperties("UT", tcx, slc, tj, tcx.tcc.dbgStp);
+        SetAngleCode(tcx, lastTP);
         return;
       }  else {
         // a more gradual change in chisq. Maybe reduce the number of points
@@ -863,12 +864,12 @@ namespace tca {
           lastTP.NTPsFit = newNTPSFit;
           // BB April 19: try to add a last lonely hit on a low MCSMom tj on the last try
           if(newNTPSFit == minPtsFit && tj.MCSMom < 30) chiCut = 2;
-          if(tcc.dbgStp) mf::LogVerbatim("TC")<<"  Bad FitChi "<<lastTP.FitChi<<" Reduced NTPsFit to "<<lastTP.NTPsFit<<" Pass "<<tj.Pass<<" chiCut "<<chiCut;
-          FitTraj(slc, tj);
+          if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"  Bad FitChi "<<lastTP.FitChi<<" Reduced NTPsFit to "<<lastTP.NTPsFit<<" Pass "<<tj.Pass<<" chiCut "<<chiCut;
+          FitTraj(tcx, slc, tj);
           tj.NeedsUpdate = true;
           if(lastTP.FitChi > prevChi) {
-            if(tcc.dbgStp) mf::LogVerbatim("TC")<<"  Chisq is increasing "<<lastTP.FitChi<<"  Try to remove an earlier bad hit";
-            MaskBadTPs(slc, tj, chiCut);
+            if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"  Chisq is increasing "<<lastTP.FitChi<<"  Try to remove an earlier bad hit";
+            MaskBadTPs(tcx, slc, tj, chiCut);
             ++ntry;
             if(ntry == 2) break;
           }
@@ -877,19 +878,19 @@ namespace tca {
         } // lastTP.FitChi > 2 && lastTP.NTPsFit > 2
       }
       // last ditch attempt if things look bad. Drop the last hit
-      if(tj.Pts.size() > tcc.minPtsFit[tj.Pass] && lastTP.FitChi > maxChi) {
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<"  Last try. Drop last TP "<<lastTP.FitChi<<" NTPsFit "<<lastTP.NTPsFit;
+      if(tj.Pts.size() > tcx.tcc.minPtsFit[tj.Pass] && lastTP.FitChi > maxChi) {
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"  Last try. Drop last TP "<<lastTP.FitChi<<" NTPsFit "<<lastTP.NTPsFit;
         UnsetUsedHits(slc, lastTP);
-        DefineHitPos(slc, lastTP);
+        DefineHitPos(tcx, slc, lastTP);
         SetEndPoints(tj);
         lastPt = tj.EndPt[1];
-        FitTraj(slc, tj);
+        FitTraj(tcx, slc, tj);
         tj.MaskedLastTP = true;
       }
 
-    if(tj.NeedsUpdate) UpdateTjChgProperties("UT", slc, tj, tcc.dbgStp);
+    if(tj.NeedsUpdate) UpdateTjChgProperties("UT", tcx, slc, tj, tcx.tcc.dbgStp);
 
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<"  Fit done. Chi "<<lastTP.FitChi<<" NTPsFit "<<lastTP.NTPsFit;
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"  Fit done. Chi "<<lastTP.FitChi<<" NTPsFit "<<lastTP.NTPsFit;
 
     if(tj.EndPt[0] == tj.EndPt[1]) return;
 
@@ -902,8 +903,8 @@ namespace tca {
       lastTP.AngErr = defFrac * tj.Pts[0].AngErr + (1 - defFrac) * lastTP.AngErr;
     }
 
-    UpdateDeltaRMS(slc, tj);
-    SetAngleCode(lastTP);
+    UpdateDeltaRMS(tcx, slc, tj);
+    SetAngleCode(tcx, lastTP);
 
     tj.NeedsUpdate = false;
     return;
@@ -911,20 +912,20 @@ namespace tca {
   } // UpdateTraj
 
   ////////////////////////////////////////////////
-  void CheckStiffEl(TCSlice& slc, Trajectory& tj)
+  void CheckStiffEl(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     if(!tj.Strategy[kStiffEl]) return;
-    if(tcc.dbgStp) {
-      mf::LogVerbatim("TC")<<"inside CheckStiffTj with NumPtsWithCharge = "<<NumPtsWithCharge(slc, tj, false);
+    if(tcx.tcc.dbgStp) {
+      mf::LogVerbatim("TC")<<"inside CheckStiffTj with NumPtsWithCharge = "<<NumPtsWithCharge(tcx, slc, tj, false);
     }
     // Fill in any gaps with hits that were skipped, most likely delta rays on muon tracks
-    FillGaps(slc, tj);
+    FillGaps(tcx, slc, tj);
     // Update the trajectory parameters at the beginning of the trajectory
-    ChkBegin(slc, tj);
+    ChkBegin(tcx, slc, tj);
   } // CheckStiffTj
 
   ////////////////////////////////////////////////
-  void CheckTraj(TCSlice& slc, Trajectory& tj)
+  void CheckTraj(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Check the quality of the trajectory and possibly trim it or flag it for deletion
 
@@ -935,15 +936,15 @@ namespace tca {
     if(tj.EndPt[0] == tj.EndPt[1]) return;
 
     if(tj.Strategy[kStiffEl]) {
-      CheckStiffEl(slc, tj);
+      CheckStiffEl(tcx, slc, tj);
       return;
     }
 
-    if(tcc.dbgStp) {
-      mf::LogVerbatim("TC")<<"inside CheckTraj with NumPtsWithCharge = "<<NumPtsWithCharge(slc, tj, false);
+    if(tcx.tcc.dbgStp) {
+      mf::LogVerbatim("TC")<<"inside CheckTraj with NumPtsWithCharge = "<<NumPtsWithCharge(tcx, slc, tj, false);
     }
 
-    if(NumPtsWithCharge(slc, tj, false) < tcc.minPts[tj.Pass]) {
+    if(NumPtsWithCharge(tcx, slc, tj, false) < tcx.tcc.minPts[tj.Pass]) {
       tj.IsGood = false;
       return;
     }
@@ -953,34 +954,34 @@ namespace tca {
 
     // Look for a charge asymmetry between points on both sides of a high-
     // charge point and trim points in the vicinity
-    ChkChgAsymmetry(slc, tj, tcc.dbgStp);
+    ChkChgAsymmetry(tcx, slc, tj, tcx.tcc.dbgStp);
 
     // flag this tj as a junk Tj (even though it wasn't created in FindJunkTraj).
     // Drop it and let FindJunkTraj do it's job
-    TagJunkTj(slc, tj, tcc.dbgStp);
+    TagJunkTj(slc, tj, tcx.tcc.dbgStp);
     if(tj.AlgMod[kJunkTj]) {
       tj.IsGood = false;
       return;
     }
 
-    tj.MCSMom = MCSMom(slc, tj);
+    tj.MCSMom = MCSMom(tcx, slc, tj);
 
     // See if the points at the stopping end can be included in the Tj
-    ChkStopEndPts(slc, tj, tcc.dbgStp);
+    ChkStopEndPts(tcx, slc, tj, tcx.tcc.dbgStp);
 
     // remove any points at the end that don't have charge
     tj.Pts.resize(tj.EndPt[1] + 1);
 
     // Ensure that a hit only appears once in the TJ
-    if(HasDuplicateHits(slc, tj, tcc.dbgStp)) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<" HasDuplicateHits ";
+    if(HasDuplicateHits(tcx, slc, tj, tcx.tcc.dbgStp)) {
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" HasDuplicateHits ";
       tj.IsGood = false;
       return;
     }
 
     // See if this is a ghost trajectory
-    if(IsGhost(slc, tj)) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<" CT: Ghost trajectory - trimmed hits ";
+    if(IsGhost(tcx, slc, tj)) {
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" CT: Ghost trajectory - trimmed hits ";
       if(!tj.IsGood) return;
     }
 
@@ -992,49 +993,49 @@ namespace tca {
     tj.Pts.resize(tj.EndPt[1] + 1);
 
     // Fill in any gaps with hits that were skipped, most likely delta rays on muon tracks
-    if(!isVLA) FillGaps(slc, tj);
+    if(!isVLA) FillGaps(tcx, slc, tj);
 
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<" CheckTraj MCSMom "<<tj.MCSMom<<" isVLA? "<<isVLA<<" NumPtsWithCharge "<<NumPtsWithCharge(slc, tj, false)<<" Min Req'd "<<tcc.minPts[tj.Pass];
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" CheckTraj MCSMom "<<tj.MCSMom<<" isVLA? "<<isVLA<<" NumPtsWithCharge "<<NumPtsWithCharge(tcx, slc, tj, false)<<" Min Req'd "<<tcx.tcc.minPts[tj.Pass];
 
     // Trim the end points until the TJ meets the quality cuts
-    TrimEndPts("CT", slc, tj, tcc.qualityCuts, tcc.dbgStp);
+    TrimEndPts("CT", tcx, slc, tj, tcx.tcc.qualityCuts, tcx.tcc.dbgStp);
     if(tj.AlgMod[kKilled]) {
       tj.IsGood = false;
       return;
     }
 
-    TrimHiChgEndPts(slc, tj, tcc.dbgStp);
+    TrimHiChgEndPts(tcx, slc, tj, tcx.tcc.dbgStp);
 
     // Check for a Bragg peak at both ends. This may be used by FixBegin.
-    ChkStop(slc, tj);
+    ChkStop(tcx, slc, tj);
 
     // Update the trajectory parameters at the beginning of the trajectory
-    ChkBegin(slc, tj);
+    ChkBegin(tcx, slc, tj);
 
     // ignore short trajectories
     if(tj.EndPt[1] < 4) return;
 
     // final quality check
-    float npwc = NumPtsWithCharge(slc, tj, true);
+    float npwc = NumPtsWithCharge(tcx, slc, tj, true);
     float npts = tj.EndPt[1] - tj.EndPt[0] + 1;
     float frac = npwc / npts;
-    tj.IsGood = (frac >= tcc.qualityCuts[0]);
-    if(tj.IsGood && tj.Pass < tcc.minMCSMom.size() && !tj.Strategy[kSlowing]) tj.IsGood = (tj.MCSMom >= tcc.minMCSMom[tj.Pass]);
-    if(tcc.dbgStp) {
+    tj.IsGood = (frac >= tcx.tcc.qualityCuts[0]);
+    if(tj.IsGood && tj.Pass < tcx.tcc.minMCSMom.size() && !tj.Strategy[kSlowing]) tj.IsGood = (tj.MCSMom >= tcx.tcc.minMCSMom[tj.Pass]);
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim("TC")<<"CheckTraj: fraction of points with charge "<<frac<<" good traj? "<<tj.IsGood;
     }
     if(!tj.IsGood || !slc.isValid) return;
 
     // lop off high multiplicity hits at the end
-    CheckHiMultEndHits(slc, tj);
+    CheckHiMultEndHits(tcx, slc, tj);
 
     // Check for a Bragg peak at both ends. This may be used by FixBegin.
-    ChkStop(slc, tj);
+    ChkStop(tcx, slc, tj);
 
   } // CheckTraj
 
   ////////////////////////////////////////////////
-  void AddHits(TCSlice& slc, Trajectory& tj, unsigned short ipt, bool& sigOK)
+  void AddHits(TCContext& tcx, TCSlice& slc, Trajectory& tj, unsigned short ipt, bool& sigOK)
   {
     // Try to add hits to the trajectory point ipt on the supplied
     // trajectory
@@ -1047,7 +1048,7 @@ namespace tca {
 
     // Call large angle hit finding if the last tp is large angle
     if(tj.Pts[ipt].AngleCode == 2) {
-      AddLAHits(slc, tj, ipt, sigOK);
+      AddLAHits(tcx, slc, tj, ipt, sigOK);
       return;
     }
 
@@ -1074,8 +1075,8 @@ namespace tca {
     float minDeltaCut = 1.1 * tj.Pts[lastPtWithUsedHits].Delta;
     if(deltaCut < minDeltaCut) deltaCut = minDeltaCut;
 
-    deltaCut *= tcc.projectionErrFactor;
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<" AddHits: calculated deltaCut "<<deltaCut<<" dw "<<dw<<" dpos "<<dpos;
+    deltaCut *= tcx.tcc.projectionErrFactor;
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" AddHits: calculated deltaCut "<<deltaCut<<" dw "<<dw<<" dpos "<<dpos;
 
     if(deltaCut < 0.5) deltaCut = 0.5;
     if(deltaCut > 3) deltaCut = 3;
@@ -1084,7 +1085,7 @@ namespace tca {
     if(tj.AlgMod[kRvPrp]) deltaCut *= 2;
 
     // loosen up a bit if we just passed a block of dead wires
-    bool passedDeadWires = (abs(dw) > 20 && DeadWireCount(slc, tp.Pos[0], tj.Pts[lastPtWithUsedHits].Pos[0], tj.CTP) > 10);
+    bool passedDeadWires = (abs(dw) > 20 && DeadWireCount(tcx, slc, tp.Pos[0], tj.Pts[lastPtWithUsedHits].Pos[0], tj.CTP) > 10);
     if(passedDeadWires) deltaCut *= 2;
     // open it up for StiffEl and Slowing strategies
     if(tj.Strategy[kStiffEl] || tj.Strategy[kSlowing]) deltaCut = 3;
@@ -1102,9 +1103,9 @@ namespace tca {
     }
 
     // projected time in ticks for testing the existence of a hit signal
-    raw::TDCtick_t rawProjTick = (float)(tp.Pos[1] / tcc.unitsPerTick);
-    if(tcc.dbgStp) {
-      mf::LogVerbatim("TC")<<" AddHits: wire "<<wire<<" tp.Pos[0] "<<tp.Pos[0]<<" projTick "<<rawProjTick<<" deltaRMS "<<tp.DeltaRMS<<" tp.Dir[0] "<<tp.Dir[0]<<" deltaCut "<<deltaCut<<" dpos "<<dpos<<" projErr "<<projErr<<" ExpectedHitsRMS "<<ExpectedHitsRMS(slc, tp);
+    raw::TDCtick_t rawProjTick = (float)(tp.Pos[1] / tcx.tcc.unitsPerTick);
+    if(tcx.tcc.dbgStp) {
+      mf::LogVerbatim("TC")<<" AddHits: wire "<<wire<<" tp.Pos[0] "<<tp.Pos[0]<<" projTick "<<rawProjTick<<" deltaRMS "<<tp.DeltaRMS<<" tp.Dir[0] "<<tp.Dir[0]<<" deltaCut "<<deltaCut<<" dpos "<<dpos<<" projErr "<<projErr<<" ExpectedHitsRMS "<<ExpectedHitsRMS(tcx, slc, tp);
     }
 
     std::vector<unsigned int> hitsInMultiplet;
@@ -1113,7 +1114,7 @@ namespace tca {
     unsigned int ipl = planeID.Plane;
     if(wire > slc.lastWire[ipl]) return;
     // Assume a signal exists on a dead wire
-    if(!evt.goodWire[ipl][wire]) sigOK = true;
+    if(!tcx.evt.goodWire[ipl][wire]) sigOK = true;
     if(slc.wireHitRange[ipl][wire].first == UINT_MAX) return;
     unsigned int firstHit = slc.wireHitRange[ipl][wire].first;
     unsigned int lastHit = slc.wireHitRange[ipl][wire].second;
@@ -1121,10 +1122,10 @@ namespace tca {
     for(unsigned int iht = firstHit; iht <= lastHit; ++iht) {
       if(slc.slHits[iht].InTraj == tj.ID) continue;
       if(slc.slHits[iht].InTraj == SHRT_MAX) continue;
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       if(rawProjTick > hit.StartTick() && rawProjTick < hit.EndTick()) sigOK = true;
-      float ftime = tcc.unitsPerTick * hit.PeakTime();
-      float delta = PointTrajDOCA(slc, fwire, ftime, tp);
+      float ftime = tcx.tcc.unitsPerTick * hit.PeakTime();
+      float delta = PointTrajDOCA(tcx, slc, fwire, ftime, tp);
       // increase the delta cut if this is a long pulse hit
       bool longPulseHit = LongPulseHit(hit);
       if(longPulseHit) {
@@ -1133,11 +1134,11 @@ namespace tca {
         if(delta > maxDeltaCut) continue;
       }
       float dt = std::abs(ftime - tp.Pos[1]);
-      GetHitMultiplet(slc, iht, hitsInMultiplet, false);
-      if(tcc.dbgStp && delta < 100 && dt < 100) {
+      GetHitMultiplet(tcx, slc, iht, hitsInMultiplet, false);
+      if(tcx.tcc.dbgStp && delta < 100 && dt < 100) {
         mf::LogVerbatim myprt("TC");
         myprt<<"  iht "<<iht;
-        myprt<<" "<<PrintHit(slc.slHits[iht]);
+        myprt<<" "<<PrintHit(tcx, slc.slHits[iht]);
         myprt<<" delta "<<std::fixed<<std::setprecision(2)<<delta<<" deltaCut "<<deltaCut<<" dt "<<dt;
         myprt<<" BB Mult "<<hitsInMultiplet.size()<<" RMS "<<std::setprecision(1)<<hit.RMS();
         myprt<<" Chi "<<std::setprecision(1)<<hit.GoodnessOfFit();
@@ -1168,12 +1169,12 @@ namespace tca {
       } // multiplicity > 1
     } // iht
 
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim myprt("TC");
       myprt<<"closeHits ";
-      for(auto iht : closeHits) myprt<<" "<<PrintHit(slc.slHits[iht]);
+      for(auto iht : closeHits) myprt<<" "<<PrintHit(tcx, slc.slHits[iht]);
       if(imBig < slc.slHits.size()) {
-        myprt<<" imBig "<<PrintHit(slc.slHits[imBig]);
+        myprt<<" imBig "<<PrintHit(tcx, slc.slHits[imBig]);
       } else {
         myprt<<" imBig "<<imBig;
       }
@@ -1182,16 +1183,16 @@ namespace tca {
     // there is NO hit in the allHits collection but there is a hit in srcHit collection. We
     // can't use it for fitting, etc however
     bool nearSrcHit = false;
-    if(!sigOK) nearSrcHit = NearbySrcHit(planeID, wire, (float)rawProjTick, (float)rawProjTick);
+    if(!sigOK) nearSrcHit = NearbySrcHit(tcx, planeID, wire, (float)rawProjTick, (float)rawProjTick);
     sigOK = sigOK || !closeHits.empty() || nearSrcHit;
 
     if(!sigOK) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<" no signal on any wire at tp.Pos "<<tp.Pos[0]<<" "<<tp.Pos[1]<<" tick "<<(int)tp.Pos[1]/tcc.unitsPerTick<<" closeHits size "<<closeHits.size();
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" no signal on any wire at tp.Pos "<<tp.Pos[0]<<" "<<tp.Pos[1]<<" tick "<<(int)tp.Pos[1]/tcx.tcc.unitsPerTick<<" closeHits size "<<closeHits.size();
       return;
     }
     if(imBig < slc.slHits.size() && closeHits.empty()) {
       closeHits.push_back(imBig);
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<" Added bigDelta hit "<<PrintHit(slc.slHits[imBig])<<" w delta = "<<bigDelta;
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" Added bigDelta hit "<<PrintHit(tcx, slc.slHits[imBig])<<" w delta = "<<bigDelta;
     }
     if(closeHits.size() > 16) closeHits.resize(16);
     if(nearSrcHit) tp.Environment[kEnvNearSrcHit] = true;
@@ -1203,15 +1204,15 @@ namespace tca {
     // and require a charge check if we're not just starting out
     bool useChg = true;
     if(tj.Strategy[kStiffEl] || tj.Strategy[kSlowing]) useChg = false;
-    FindUseHits(slc, tj, ipt, 10, useChg);
-    DefineHitPos(slc, tp);
+    FindUseHits(tcx, slc, tj, ipt, 10, useChg);
+    DefineHitPos(tcx, slc, tp);
     SetEndPoints(tj);
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<" number of close hits "<<closeHits.size()<<" used hits "<<NumHitsInTP(tp, kUsedHits);
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" number of close hits "<<closeHits.size()<<" used hits "<<NumHitsInTP(tp, kUsedHits);
   } // AddHits
 
 
   ////////////////////////////////////////////////
-  void AddLAHits(TCSlice& slc, Trajectory& tj, unsigned short ipt, bool& sigOK)
+  void AddLAHits(TCContext& tcx, TCSlice& slc, Trajectory& tj, unsigned short ipt, bool& sigOK)
   {
     // Very Large Angle version of AddHits to be called for the last angle range
 
@@ -1245,9 +1246,9 @@ namespace tca {
       }
     } // ipt > 0 ...
 
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim myprt("TC");
-      myprt<<" AddLAHits: Pos "<<PrintPos(slc, tp)<<" tp.AngleCode "<<tp.AngleCode<<" Wires under consideration";
+      myprt<<" AddLAHits: Pos "<<PrintPos(tcx, slc, tp)<<" tp.AngleCode "<<tp.AngleCode<<" Wires under consideration";
       for(auto& wire : wires) myprt<<" "<<wire;
     }
 
@@ -1259,7 +1260,7 @@ namespace tca {
     tp.Hits.clear();
     std::array<int, 2> wireWindow;
     std::array<float, 2> timeWindow;
-    float pos1Window = tcc.VLAStepSize/2;
+    float pos1Window = tcx.tcc.VLAStepSize/2;
     timeWindow[0] = ltp.Pos[1] - pos1Window;
     timeWindow[1] = ltp.Pos[1] + pos1Window;
     // Put the existing hits in to a vector so we can ensure that they aren't added again
@@ -1275,7 +1276,7 @@ namespace tca {
       wireWindow[1] = wire;
       bool hitsNear;
       // Look for hits using the requirement that the timeWindow overlaps with the hit StartTick and EndTick
-      std::vector<unsigned int> closeHits = FindCloseHits(slc, wireWindow, timeWindow, plane, kAllHits, true, hitsNear);
+      std::vector<unsigned int> closeHits = FindCloseHits(tcx, slc, wireWindow, timeWindow, plane, kAllHits, true, hitsNear);
       if(hitsNear) sigOK = true;
       for(auto& iht : closeHits) {
         // Ensure that none of these hits are already used by this trajectory
@@ -1286,10 +1287,10 @@ namespace tca {
       }
     } // ii
 
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim myprt("TC");
-      myprt<<" LAPos "<<PrintPos(slc, ltp)<<" Tick window "<<(int)(timeWindow[0]/tcc.unitsPerTick)<<" to "<<(int)(timeWindow[1]/tcc.unitsPerTick);
-      for(auto& iht : tp.Hits) myprt<<" "<<PrintHit(slc.slHits[iht]);
+      myprt<<" LAPos "<<PrintPos(tcx, slc, ltp)<<" Tick window "<<(int)(timeWindow[0]/tcx.tcc.unitsPerTick)<<" to "<<(int)(timeWindow[1]/tcx.tcc.unitsPerTick);
+      for(auto& iht : tp.Hits) myprt<<" "<<PrintHit(tcx, slc.slHits[iht]);
     } // prt
 
     // no hits found
@@ -1304,19 +1305,19 @@ namespace tca {
       tp.UseHit[ii] = true;
       slc.slHits[iht].InTraj = tj.ID;
     } // ii
-    DefineHitPos(slc, tp);
+    DefineHitPos(tcx, slc, tp);
     SetEndPoints(tj);
-    UpdateTjChgProperties("ALAH", slc, tj, tcc.dbgStp);
+    UpdateTjChgProperties("ALAH", tcx, slc, tj, tcx.tcc.dbgStp);
 
   } // AddLAHits
 
   //////////////////////////////////////////
-  void ReversePropagate(TCSlice& slc, Trajectory& tj)
+  void ReversePropagate(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Reverse the trajectory and step in the opposite direction. The
     // updated trajectory is returned if this process is successful
 
-    if(!tcc.useAlg[kRvPrp]) return;
+    if(!tcx.tcc.useAlg[kRvPrp]) return;
 
     if(tj.Pts.size() < 6) return;
     // only do this once
@@ -1325,7 +1326,7 @@ namespace tca {
     // This code can't handle VLA trajectories
     if(tj.Pts[tj.EndPt[0]].AngleCode == 2) return;
 
-    bool prt = (tcc.dbgStp || tcc.dbgAlg[kRvPrp]);
+    bool prt = (tcx.tcc.dbgStp || tcx.tcc.dbgAlg[kRvPrp]);
 
     // this function requires the first TP be included in the trajectory.
     if(tj.EndPt[0] > 0) {
@@ -1345,7 +1346,7 @@ namespace tca {
     geo::PlaneID planeID = DecodeCTP(tj.CTP);
     unsigned short ipl = planeID.Plane;
     while(nextWire > slc.firstWire[ipl] && nextWire < slc.lastWire[ipl]) {
-      if(evt.goodWire[ipl][nextWire]) break;
+      if(tcx.evt.goodWire[ipl][nextWire]) break;
       nextWire -= tj.StepDir;
     }
     if(nextWire == slc.lastWire[ipl] - 1) return;
@@ -1357,15 +1358,15 @@ namespace tca {
     MoveTPToWire(tp, (float)nextWire);
     // find close unused hits near this position
     float maxDelta = 10 * tj.Pts[tj.EndPt[1]].DeltaRMS;
-    if(!FindCloseHits(slc, tp, maxDelta, kUnusedHits)) return;
-    if(prt) mf::LogVerbatim("TC")<<" nUnused hits "<<tp.Hits.size()<<" at Pos "<<PrintPos(slc, tp);
+    if(!FindCloseHits(tcx, slc, tp, maxDelta, kUnusedHits)) return;
+    if(prt) mf::LogVerbatim("TC")<<" nUnused hits "<<tp.Hits.size()<<" at Pos "<<PrintPos(tcx, slc, tp);
     if(tp.Hits.empty()) return;
     // There are hits on the next wire. Make a working copy of the trajectory, reverse it and try
     // to extend it with StepAway
     if(prt) {
       mf::LogVerbatim myprt("TC");
       myprt<<" tp.Hits ";
-      for(auto& iht : tp.Hits) myprt<<" "<<PrintHit(slc.slHits[iht])<<"_"<<slc.slHits[iht].InTraj;
+      for(auto& iht : tp.Hits) myprt<<" "<<PrintHit(tcx, slc.slHits[iht])<<"_"<<slc.slHits[iht].InTraj;
     } // tcc.dbgStp
     //
     // Make a working copy of tj
@@ -1392,25 +1393,25 @@ namespace tca {
     } // ii
     if(cnt == 0) return;
     if(cnt > 1) tjWork.Pts[lastPt].AveChg = chg / cnt;
-    StepAway(slc, tjWork);
+    StepAway(tcx, slc, tjWork);
     if(!tj.IsGood) {
       if(prt) mf::LogVerbatim("TC")<<" ReversePropagate StepAway failed";
       return;
     }
     tjWork.Strategy = saveStrategy;
     // check the new stopping point
-    ChkStopEndPts(slc, tjWork, tcc.dbgStp);
+    ChkStopEndPts(tcx, slc, tjWork, tcx.tcc.dbgStp);
     // restore the original direction
     if(tjWork.StepDir != stepDir) ReverseTraj(slc, tjWork);
     tj = tjWork;
     // TODO: Maybe UpdateTjChgProperties should be called here
     // re-check the ends
-    ChkStop(slc, tj);
+    ChkStop(tcx, slc, tj);
 
   } // ReversePropagate
 
   ////////////////////////////////////////////////
-  void GetHitMultiplet(const TCSlice& slc, unsigned int theHit, std::vector<unsigned int>& hitsInMultiplet, bool useLongPulseHits)
+  void GetHitMultiplet(TCContext& tcx, const TCSlice& slc, unsigned int theHit, std::vector<unsigned int>& hitsInMultiplet, bool useLongPulseHits)
   {
     // This function attempts to return a list of hits in the current slice that are close to the
     // hit specified by theHit and that are similar to it. If theHit is a high-pulseheight hit (aka imTall)
@@ -1423,9 +1424,9 @@ namespace tca {
     // check for flagrant errors
     if(theHit >= slc.slHits.size()) return;
     if(slc.slHits[theHit].InTraj == INT_MAX) return;
-    if(slc.slHits[theHit].allHitsIndex >= (*evt.allHits).size()) return;
+    if(slc.slHits[theHit].allHitsIndex >= (*tcx.evt.allHits).size()) return;
 
-    auto& hit = (*evt.allHits)[slc.slHits[theHit].allHitsIndex];
+    auto& hit = (*tcx.evt.allHits)[slc.slHits[theHit].allHitsIndex];
     // handle long-pulse hits
     if(useLongPulseHits && LongPulseHit(hit)) {
       // return everything in the multiplet as defined by the hit finder, but check for errors
@@ -1435,7 +1436,7 @@ namespace tca {
       if(lIndex < theHit) firstHit = theHit - lIndex;
       for(unsigned int ii = firstHit; ii < firstHit + hitMult; ++ii) {
         if(ii >= slc.slHits.size()) break;
-        auto& tmp = (*evt.allHits)[slc.slHits[ii].allHitsIndex];
+        auto& tmp = (*tcx.evt.allHits)[slc.slHits[ii].allHitsIndex];
         if(tmp.Multiplicity() == hitMult) hitsInMultiplet.push_back(ii);
       } // ii
       return;
@@ -1448,7 +1449,7 @@ namespace tca {
 
     float theTime = hit.PeakTime();
     float theRMS = hit.RMS();
-    float narrowHitCut = 1.5 * evt.aveHitRMS[ipl];
+    float narrowHitCut = 1.5 * tcx.evt.aveHitRMS[ipl];
     bool theHitIsNarrow = (theRMS < narrowHitCut);
     float maxPeak = hit.PeakAmplitude();
     unsigned int imTall = theHit;
@@ -1457,13 +1458,13 @@ namespace tca {
     // look for hits < theTime but within hitSep
     if(theHit > 0) {
       for(unsigned int iht = theHit - 1; iht != 0; --iht) {
-        auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+        auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
         if(hit.WireID().Wire != theWire) break;
         if(hit.WireID().Plane != ipl) break;
-        float hitSep = tcc.multHitSep * theRMS;
+        float hitSep = tcx.tcc.multHitSep * theRMS;
         float rms = hit.RMS();
         if(rms > theRMS) {
-          hitSep = tcc.multHitSep * rms;
+          hitSep = tcx.tcc.multHitSep * rms;
           theRMS = rms;
         }
         float dTick = std::abs(hit.PeakTime() - theTime);
@@ -1486,14 +1487,14 @@ namespace tca {
     theTime = hit.PeakTime();
     theRMS = hit.RMS();
     for(unsigned int iht = theHit + 1; iht < slc.slHits.size(); ++iht) {
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       if(hit.WireID().Wire != theWire) break;
       if(hit.WireID().Plane != ipl) break;
       if(slc.slHits[iht].InTraj == INT_MAX) continue;
-      float hitSep = tcc.multHitSep * theRMS;
+      float hitSep = tcx.tcc.multHitSep * theRMS;
       float rms = hit.RMS();
       if(rms > theRMS) {
-        hitSep = tcc.multHitSep * rms;
+        hitSep = tcx.tcc.multHitSep * rms;
         theRMS = rms;
       }
       float dTick = std::abs(hit.PeakTime() - theTime);
@@ -1523,7 +1524,7 @@ namespace tca {
     } else {
       // theHit is not narrow and it is not the tallest. Ignore a single hit if it is
       // the tallest and narrow
-      auto& hit = (*evt.allHits)[slc.slHits[imTall].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[imTall].allHitsIndex];
       if(hit.RMS() < narrowHitCut) {
         unsigned short killMe = 0;
         for(unsigned short ii = 0; ii < hitsInMultiplet.size(); ++ii) {
@@ -1539,31 +1540,31 @@ namespace tca {
   } // GetHitMultiplet
 
   //////////////////////////////////////////
-  float HitTimeErr(const TCSlice& slc, unsigned int iht)
+  float HitTimeErr(TCContext& tcx, const TCSlice& slc, unsigned int iht)
   {
     if(iht > slc.slHits.size() - 1) return 0;
-    auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
-    return hit.RMS() * tcc.unitsPerTick * tcc.hitErrFac * hit.Multiplicity();
+    auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
+    return hit.RMS() * tcx.tcc.unitsPerTick * tcx.tcc.hitErrFac * hit.Multiplicity();
   } // HitTimeErr
 
   //////////////////////////////////////////
-  float HitsTimeErr2(const TCSlice& slc, const std::vector<unsigned int>& hitVec)
+  float HitsTimeErr2(TCContext& tcx, const TCSlice& slc, const std::vector<unsigned int>& hitVec)
   {
     // Estimates the error^2 of the time using all hits in hitVec
     if(hitVec.empty()) return 0;
-    float err = tcc.hitErrFac * HitsRMSTime(slc, hitVec, kUnusedHits);
+    float err = tcx.tcc.hitErrFac * HitsRMSTime(tcx, slc, hitVec, kUnusedHits);
     return err * err;
   } // HitsTimeErr2
 
 
   ////////////////////////////////////////////////
-  void ChkStopEndPts(TCSlice& slc, Trajectory& tj, bool prt)
+  void ChkStopEndPts(TCContext& tcx, TCSlice& slc, Trajectory& tj, bool prt)
   {
     // Analyze the end of the Tj after crawling has stopped to see if any of the points
     // should be used
 
     if(tj.EndFlag[1][kAtKink]) return;
-    if(!tcc.useAlg[kChkStopEP]) return;
+    if(!tcx.tcc.useAlg[kChkStopEP]) return;
     if(tj.AlgMod[kJunkTj]) return;
     if(tj.Strategy[kStiffEl]) return;
 
@@ -1582,8 +1583,8 @@ namespace tca {
     for(lastPt = tj.Pts.size() - 1; lastPt >= tj.EndPt[1]; --lastPt) if(!tj.Pts[lastPt].Hits.empty()) break;
     auto& lastTP = tj.Pts[lastPt];
 
-    if(tcc.dbgStp) {
-      mf::LogVerbatim("TC")<<"CSEP: checking "<<tj.ID<<" endPt "<<endPt<<" Pts size "<<tj.Pts.size()<<" lastPt Pos "<<PrintPos(slc, lastTP.Pos);
+    if(tcx.tcc.dbgStp) {
+      mf::LogVerbatim("TC")<<"CSEP: checking "<<tj.ID<<" endPt "<<endPt<<" Pts size "<<tj.Pts.size()<<" lastPt Pos "<<PrintPos(tcx, slc, lastTP.Pos);
     }
     TrajPoint ltp;
     ltp.CTP = tj.CTP;
@@ -1602,7 +1603,7 @@ namespace tca {
       timeWindow[0] = ltp.Pos[1] - 5;
       timeWindow[1] = ltp.Pos[1] + 5;
       bool hitsNear;
-      auto tmp = FindCloseHits(slc, wireWindow, timeWindow, plane, kAllHits, true, hitsNear);
+      auto tmp = FindCloseHits(tcx, slc, wireWindow, timeWindow, plane, kAllHits, true, hitsNear);
       // add close hits that are not associated with this tj
       for(auto iht : tmp) if(slc.slHits[iht].InTraj != tj.ID) closeHits.push_back(iht);
       float nWiresPast = 0;
@@ -1614,7 +1615,7 @@ namespace tca {
         // stepping -
         nWiresPast = lastTP.Pos[0] - ltp.Pos[0];
       }
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<" Found "<<tmp.size()<<" hits near pos "<<PrintPos(slc, ltp.Pos)<<" nWiresPast "<<nWiresPast;
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" Found "<<tmp.size()<<" hits near pos "<<PrintPos(tcx, slc, ltp.Pos)<<" nWiresPast "<<nWiresPast;
       if(nWiresPast > 0.5) {
         if(!tmp.empty()) isClean = false;
         if(nWiresPast > 1.5) break;
@@ -1625,10 +1626,10 @@ namespace tca {
     unsigned short nAvailable = 0;
     for(auto iht : closeHits) if(slc.slHits[iht].InTraj == 0) ++nAvailable;
 
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim myprt("TC");
       myprt<<"closeHits";
-      for(auto iht : closeHits) myprt<<" "<<PrintHit(slc.slHits[iht]);
+      for(auto iht : closeHits) myprt<<" "<<PrintHit(tcx, slc.slHits[iht]);
       myprt<<" nAvailable "<<nAvailable;
       myprt<<" isClean "<<isClean;
     } // prt
@@ -1647,7 +1648,7 @@ namespace tca {
         slc.slHits[tp.Hits[ii]].InTraj = tj.ID;
         hitsAdded = true;
       } // ii
-      if(hitsAdded) DefineHitPos(slc, tp);
+      if(hitsAdded) DefineHitPos(tcx, slc, tp);
     } // ipt
     tj.AlgMod[kChkStopEP] = true;
     SetEndPoints(tj);
@@ -1655,19 +1656,19 @@ namespace tca {
     // values of Delta should have already been filled
 
     // require a Bragg peak
-    ChkStop(slc, tj);
+    ChkStop(tcx, slc, tj);
     if(!tj.EndFlag[1][kBragg]) {
       // restore the original
       for(unsigned short ipt = originalEndPt; ipt <= lastPt; ++ipt) UnsetUsedHits(slc, tj.Pts[ipt]);
       SetEndPoints(tj);
     } // no Bragg Peak
 
-    UpdateTjChgProperties("CSEP", slc, tj, prt);
+    UpdateTjChgProperties("CSEP", tcx, slc, tj, prt);
 
   } // ChkStopEndPts
 
   //////////////////////////////////////////
-  void DefineHitPos(TCSlice& slc, TrajPoint& tp)
+  void DefineHitPos(TCContext& tcx, TCSlice& slc, TrajPoint& tp)
   {
     // defines HitPos, HitPosErr2 and Chg for the used hits in the trajectory point
 
@@ -1681,17 +1682,17 @@ namespace tca {
       ++nused;
       iht = tp.Hits[ii];
       if(iht >= slc.slHits.size()) return;
-      if(slc.slHits[iht].allHitsIndex >= (*evt.allHits).size()) return;
+      if(slc.slHits[iht].allHitsIndex >= (*tcx.evt.allHits).size()) return;
     }
     if(nused == 0) return;
 
     // don't bother with rest of this if there is only one hit since it can
     // only reside on one wire
     if(nused == 1) {
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       tp.Chg = hit.Integral();
       tp.HitPos[0] = hit.WireID().Wire;
-      tp.HitPos[1] = hit.PeakTime() * tcc.unitsPerTick;
+      tp.HitPos[1] = hit.PeakTime() * tcx.tcc.unitsPerTick;
       if(LongPulseHit(hit)) {
         // give it a huge error^2 since the position is not well defined
         tp.HitPosErr2 = 100;
@@ -1701,10 +1702,10 @@ namespace tca {
         if(pathInv < 0.05) pathInv = 0.05;
         tp.Chg *= pathInv;
         float wireErr = tp.Dir[1] * 0.289;
-        float timeErr = tp.Dir[0] * HitTimeErr(slc, iht);
+        float timeErr = tp.Dir[0] * HitTimeErr(tcx, slc, iht);
         tp.HitPosErr2 = wireErr * wireErr + timeErr * timeErr;
       }
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"DefineHitPos: singlet "<<std::fixed<<std::setprecision(1)<<tp.HitPos[0]<<":"<<(int)(tp.HitPos[1]/tcc.unitsPerTick)<<" ticks. HitPosErr "<<sqrt(tp.HitPosErr2);
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"DefineHitPos: singlet "<<std::fixed<<std::setprecision(1)<<tp.HitPos[0]<<":"<<(int)(tp.HitPos[1]/tcx.tcc.unitsPerTick)<<" ticks. HitPosErr "<<sqrt(tp.HitPosErr2);
       return;
     } // nused == 1
 
@@ -1721,7 +1722,7 @@ namespace tca {
     for(unsigned short ii = 0; ii < tp.Hits.size(); ++ii) {
       if(!tp.UseHit[ii]) continue;
       unsigned int iht = tp.Hits[ii];
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       chg = hit.Integral();
       unsigned int wire = hit.WireID().Wire;
       if(wire < loWire) loWire = wire;
@@ -1735,7 +1736,7 @@ namespace tca {
     if(tp.Chg == 0) return;
 
     tp.HitPos[0] = newpos[0] / tp.Chg;
-    tp.HitPos[1] = newpos[1] * tcc.unitsPerTick / tp.Chg;
+    tp.HitPos[1] = newpos[1] * tcx.tcc.unitsPerTick / tp.Chg;
     // Normalize to 1 WSE path length
     float pathInv = std::abs(tp.Dir[0]);
     if(pathInv < 0.05) pathInv = 0.05;
@@ -1744,15 +1745,15 @@ namespace tca {
     // Scale it by the wire range
     float dWire = 1 + hiWire - loWire;
     float wireErr = tp.Dir[1] * dWire * 0.289;
-    float timeErr2 = tp.Dir[0] * tp.Dir[0] * HitsTimeErr2(slc, hitVec);
+    float timeErr2 = tp.Dir[0] * tp.Dir[0] * HitsTimeErr2(tcx, slc, hitVec);
     tp.HitPosErr2 = wireErr * wireErr + timeErr2;
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<"DefineHitPos: multiplet "<<std::fixed<<std::setprecision(1)<<tp.HitPos[0]<<":"<<(int)(tp.HitPos[1]/tcc.unitsPerTick)<<" ticks. HitPosErr "<<sqrt(tp.HitPosErr2);
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"DefineHitPos: multiplet "<<std::fixed<<std::setprecision(1)<<tp.HitPos[0]<<":"<<(int)(tp.HitPos[1]/tcx.tcc.unitsPerTick)<<" ticks. HitPosErr "<<sqrt(tp.HitPosErr2);
 
   } // DefineHitPos
 
 
   //////////////////////////////////////////
-  void FindUseHits(TCSlice& slc, Trajectory& tj, unsigned short ipt, float maxDelta, bool useChg)
+  void FindUseHits(TCContext& tcx, TCSlice& slc, Trajectory& tj, unsigned short ipt, float maxDelta, bool useChg)
   {
     // Hits have been associated with trajectory point ipt but none are used. Here we will
     // decide which hits to use.
@@ -1764,7 +1765,7 @@ namespace tca {
     // don't check charge when starting out
     if(ipt < 5) useChg = false;
     float chgPullCut = 1000;
-    if(useChg) chgPullCut = tcc.chargeCuts[0];
+    if(useChg) chgPullCut = tcx.tcc.chargeCuts[0];
     // open it up for RevProp, since we might be following a stopping track
     if(tj.AlgMod[kRvPrp]) chgPullCut *= 2;
     if(tj.MCSMom < 30) chgPullCut *= 2;
@@ -1772,9 +1773,9 @@ namespace tca {
     bool ignoreLongPulseHits = false;
     unsigned short npts = tj.EndPt[1] - tj.EndPt[0] + 1;
     if(npts < 10 || tj.AlgMod[kRvPrp]) ignoreLongPulseHits = true;
-    float expectedHitsRMS = ExpectedHitsRMS(slc, tp);
-    if(tcc.dbgStp) {
-      mf::LogVerbatim("TC")<<"FUH:  maxDelta "<<maxDelta<<" useChg requested "<<useChg<<" Norm AveChg "<<(int)tp.AveChg<<" tj.ChgRMS "<<std::setprecision(2)<<tj.ChgRMS<<" chgPullCut "<<chgPullCut<<" TPHitsRMS "<<(int)TPHitsRMSTick(slc, tp, kUnusedHits)<<" ExpectedHitsRMS "<<(int)expectedHitsRMS<<" AngCode "<<tp.AngleCode;
+    float expectedHitsRMS = ExpectedHitsRMS(tcx, slc, tp);
+    if(tcx.tcc.dbgStp) {
+      mf::LogVerbatim("TC")<<"FUH:  maxDelta "<<maxDelta<<" useChg requested "<<useChg<<" Norm AveChg "<<(int)tp.AveChg<<" tj.ChgRMS "<<std::setprecision(2)<<tj.ChgRMS<<" chgPullCut "<<chgPullCut<<" TPHitsRMS "<<(int)TPHitsRMSTick(tcx, slc, tp, kUnusedHits)<<" ExpectedHitsRMS "<<(int)expectedHitsRMS<<" AngCode "<<tp.AngleCode;
     }
 
     // inverse of the path length for normalizing hit charge to 1 WSE unit
@@ -1798,24 +1799,24 @@ namespace tca {
       tp.UseHit[ii] = false;
       unsigned int iht = tp.Hits[ii];
       if(iht >= slc.slHits.size()) continue;
-      if(slc.slHits[iht].allHitsIndex >= (*evt.allHits).size()) continue;
-      delta = PointTrajDOCA(slc, iht, tp);
+      if(slc.slHits[iht].allHitsIndex >= (*tcx.evt.allHits).size()) continue;
+      delta = PointTrajDOCA(tcx, slc, iht, tp);
       if(delta < bestDelta) bestDelta = delta;
       if(slc.slHits[iht].InTraj > 0) {
         if(firstUsed == USHRT_MAX) firstUsed = ii;
         continue;
       }
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       if(ignoreLongPulseHits && LongPulseHit(hit)) continue;
       if(hit.GoodnessOfFit() < 0 || hit.GoodnessOfFit() > 100) imBadRecoHit = ii;
       if(firstAvailable == USHRT_MAX) firstAvailable = ii;
       lastAvailable = ii;
       ++nAvailable;
-      if(tcc.dbgStp) {
+      if(tcx.tcc.dbgStp) {
         if(useChg) {
-          if(tcc.dbgStp) mf::LogVerbatim("TC")<<" "<<ii<<"  "<<PrintHit(slc.slHits[iht])<<" delta "<<delta<<" Norm Chg "<<(int)(hit.Integral() * pathInv);
+          if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" "<<ii<<"  "<<PrintHit(tcx, slc.slHits[iht])<<" delta "<<delta<<" Norm Chg "<<(int)(hit.Integral() * pathInv);
         } else {
-          if(tcc.dbgStp) mf::LogVerbatim("TC")<<" "<<ii<<"  "<<PrintHit(slc.slHits[iht])<<" delta "<<delta;
+          if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" "<<ii<<"  "<<PrintHit(tcx, slc.slHits[iht])<<" delta "<<delta;
         }
       } // tcc.dbgStp
       deltas[ii] = delta;
@@ -1828,7 +1829,7 @@ namespace tca {
 
     float chgWght = 0.5;
 
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<" firstAvailable "<<firstAvailable<<" lastAvailable "<<lastAvailable<<" firstUsed "<<firstUsed<<" imbest "<<imbest<<" single hit. tp.Delta "<<std::setprecision(2)<<tp.Delta<<" bestDelta "<<bestDelta<<" path length "<<1 / pathInv<<" imBadRecoHit "<<imBadRecoHit;
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" firstAvailable "<<firstAvailable<<" lastAvailable "<<lastAvailable<<" firstUsed "<<firstUsed<<" imbest "<<imbest<<" single hit. tp.Delta "<<std::setprecision(2)<<tp.Delta<<" bestDelta "<<bestDelta<<" path length "<<1 / pathInv<<" imBadRecoHit "<<imBadRecoHit;
     if(imbest == USHRT_MAX || nAvailable == 0) return;
     unsigned int bestDeltaHit = tp.Hits[imbest];
 
@@ -1841,7 +1842,7 @@ namespace tca {
 
     // Don't try to use a multiplet if a hit in the middle is in a different trajectory
     if(tp.Hits.size() > 2 && nAvailable > 1 && firstUsed != USHRT_MAX && firstAvailable < firstUsed && lastAvailable > firstUsed) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<" A hit in the middle of the multiplet is used. Use only the best hit";
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" A hit in the middle of the multiplet is used. Use only the best hit";
       tp.UseHit[imbest] = true;
       slc.slHits[bestDeltaHit].InTraj = tj.ID;
       return;
@@ -1850,20 +1851,20 @@ namespace tca {
     if(tp.AngleCode == 1) {
       // Get the hits that are in the same multiplet as bestDeltaHit
       std::vector<unsigned int> hitsInMultiplet;
-      GetHitMultiplet(slc, bestDeltaHit, hitsInMultiplet, false);
-      if(tcc.dbgStp) {
+      GetHitMultiplet(tcx, slc, bestDeltaHit, hitsInMultiplet, false);
+      if(tcx.tcc.dbgStp) {
         mf::LogVerbatim myprt("TC");
-        myprt<<" bestDeltaHit "<<PrintHit(slc.slHits[bestDeltaHit]);
+        myprt<<" bestDeltaHit "<<PrintHit(tcx, slc.slHits[bestDeltaHit]);
         myprt<<" in multiplet:";
-        for(auto& iht : hitsInMultiplet) myprt<<" "<<PrintHit(slc.slHits[iht]);
+        for(auto& iht : hitsInMultiplet) myprt<<" "<<PrintHit(tcx, slc.slHits[iht]);
       }
       // Consider the case where a bad reco hit might be better. It is probably wider and
       // has more charge
       if(imBadRecoHit != USHRT_MAX) {
         unsigned int iht = tp.Hits[imBadRecoHit];
-        auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
-        if(hit.RMS() > HitsRMSTick(slc, hitsInMultiplet, kUnusedHits)) {
-          if(tcc.dbgStp) mf::LogVerbatim("TC")<<" Using imBadRecoHit "<<PrintHit(slc.slHits[iht]);
+        auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
+        if(hit.RMS() > HitsRMSTick(tcx, slc, hitsInMultiplet, kUnusedHits)) {
+          if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" Using imBadRecoHit "<<PrintHit(tcx, slc.slHits[iht]);
           tp.UseHit[imBadRecoHit] = true;
           slc.slHits[iht].InTraj = tj.ID;
           return;
@@ -1886,7 +1887,7 @@ namespace tca {
 
     if(!useChg || (useChg && (tj.AveChg <= 0 || tj.ChgRMS <= 0))) {
       // necessary quantities aren't available for more careful checking
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<" tj.AveChg "<<tj.AveChg<<" or tj.ChgRMS "<<tj.ChgRMS<<". Use the best hit";
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" tj.AveChg "<<tj.AveChg<<" or tj.ChgRMS "<<tj.ChgRMS<<". Use the best hit";
       tp.UseHit[imbest] = true;
       slc.slHits[bestDeltaHit].InTraj = tj.ID;
       return;
@@ -1894,7 +1895,7 @@ namespace tca {
 
     // Don't try to get fancy if we are tracking a stiff tj
     if(tj.PDGCode == 13 && bestDelta < 0.5) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<" Tracking muon. Use the best hit";
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" Tracking muon. Use the best hit";
       tp.UseHit[imbest] = true;
       slc.slHits[bestDeltaHit].InTraj = tj.ID;
       return;
@@ -1902,14 +1903,14 @@ namespace tca {
 
     // The best hit is the only one available or this is a small angle trajectory
     if(nAvailable == 1 || tp.AngleCode == 0) {
-      auto& hit = (*evt.allHits)[slc.slHits[bestDeltaHit].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[bestDeltaHit].allHitsIndex];
       float aveChg = tp.AveChg;
       if(aveChg <= 0) aveChg = tj.AveChg;
       if(aveChg <= 0) aveChg = hit.Integral();
       float chgRMS = tj.ChgRMS;
       if(chgRMS < 0.2) chgRMS = 0.2;
       float bestDeltaHitChgPull = std::abs(hit.Integral() * pathInv / aveChg - 1) / chgRMS;
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<" bestDeltaHitChgPull "<<bestDeltaHitChgPull<<" chgPullCut "<<chgPullCut;
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" bestDeltaHitChgPull "<<bestDeltaHitChgPull<<" chgPullCut "<<chgPullCut;
       if(bestDeltaHitChgPull < chgPullCut || tp.Delta < 0.1) {
         tp.UseHit[imbest] = true;
         slc.slHits[bestDeltaHit].InTraj = tj.ID;
@@ -1918,13 +1919,13 @@ namespace tca {
     } // bestDeltaHitMultiplicity == 1
 
     // Find the expected width for the angle of this TP (ticks)
-    float expectedWidth = ExpectedHitsRMS(slc, tp);
+    float expectedWidth = ExpectedHitsRMS(tcx, slc, tp);
 
     // Handle two available hits
     if(nAvailable == 2) {
       // See if these two are in the same multiplet and both are available
       std::vector<unsigned int> tHits;
-      GetHitMultiplet(slc, bestDeltaHit, tHits, false);
+      GetHitMultiplet(tcx, slc, bestDeltaHit, tHits, false);
       // ombest is the index of the other hit in tp.Hits that is in the same multiplet as bestDeltaHit
       // if we find it
       unsigned short ombest = USHRT_MAX;
@@ -1942,52 +1943,52 @@ namespace tca {
           }
         } // ii
       } // tHits.size() == 2
-      if(tcc.dbgStp) {
+      if(tcx.tcc.dbgStp) {
         mf::LogVerbatim("TC")<<" Doublet: imbest "<<imbest<<" ombest "<<ombest;
       }
       // The other hit exists in the tp and it is available
       if(ombest < tp.Hits.size()) {
         // compare the best delta hit and the other hit separately and the doublet as a merged pair
-        float bestHitDeltaErr = std::abs(tp.Dir[1]) * 0.17 + std::abs(tp.Dir[0]) * HitTimeErr(slc, bestDeltaHit);
+        float bestHitDeltaErr = std::abs(tp.Dir[1]) * 0.17 + std::abs(tp.Dir[0]) * HitTimeErr(tcx, slc, bestDeltaHit);
         // Construct a FOM starting with the delta pull
         float bestDeltaHitFOM = deltas[imbest] /  bestHitDeltaErr;
         if(bestDeltaHitFOM < 0.5) bestDeltaHitFOM = 0.5;
         // multiply by the charge pull if it is significant
-        auto& hit = (*evt.allHits)[slc.slHits[bestDeltaHit].allHitsIndex];
+        auto& hit = (*tcx.evt.allHits)[slc.slHits[bestDeltaHit].allHitsIndex];
         float bestDeltaHitChgPull = std::abs(hit.Integral() * pathInv / tp.AveChg - 1) / tj.ChgRMS;
         if(bestDeltaHitChgPull > 1) bestDeltaHitFOM *= chgWght * bestDeltaHitChgPull;
         // scale by the ratio
         float rmsRat = hit.RMS() / expectedWidth;
         if(rmsRat < 1) rmsRat = 1 / rmsRat;
         bestDeltaHitFOM *= rmsRat;
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<" bestDeltaHit FOM "<<deltas[imbest]/bestHitDeltaErr<<" bestDeltaHitChgPull "<<bestDeltaHitChgPull<<" rmsRat "<<rmsRat<<" bestDeltaHitFOM "<<bestDeltaHitFOM;
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" bestDeltaHit FOM "<<deltas[imbest]/bestHitDeltaErr<<" bestDeltaHitChgPull "<<bestDeltaHitChgPull<<" rmsRat "<<rmsRat<<" bestDeltaHitFOM "<<bestDeltaHitFOM;
         // Now do the same for the other hit
-        float otherHitDeltaErr = std::abs(tp.Dir[1]) * 0.17 + std::abs(tp.Dir[0]) * HitTimeErr(slc, otherHit);
+        float otherHitDeltaErr = std::abs(tp.Dir[1]) * 0.17 + std::abs(tp.Dir[0]) * HitTimeErr(tcx, slc, otherHit);
         float otherHitFOM = deltas[ombest] /  otherHitDeltaErr;
         if(otherHitFOM < 0.5) otherHitFOM = 0.5;
-        auto& ohit = (*evt.allHits)[slc.slHits[otherHit].allHitsIndex];
+        auto& ohit = (*tcx.evt.allHits)[slc.slHits[otherHit].allHitsIndex];
         float otherHitChgPull = std::abs(ohit.Integral() * pathInv / tp.AveChg - 1) / tj.ChgRMS;
         if(otherHitChgPull > 1) otherHitFOM *= chgWght * otherHitChgPull;
         rmsRat = ohit.RMS() / expectedWidth;
         if(rmsRat < 1) rmsRat = 1 / rmsRat;
         otherHitFOM *= rmsRat;
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<" otherHit FOM "<<deltas[ombest]/otherHitDeltaErr<<" otherHitChgPull "<<otherHitChgPull<<" rmsRat "<<rmsRat<<" otherHitFOM "<<otherHitFOM;
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" otherHit FOM "<<deltas[ombest]/otherHitDeltaErr<<" otherHitChgPull "<<otherHitChgPull<<" rmsRat "<<rmsRat<<" otherHitFOM "<<otherHitFOM;
         // And for the doublet
         float doubletChg = hit.Integral() + ohit.Integral();
         float doubletTime = (hit.Integral() * hit.PeakTime() + ohit.Integral() * ohit.PeakTime()) / doubletChg;
         doubletChg *= pathInv;
-        doubletTime *= tcc.unitsPerTick;
-        float doubletWidthTick = TPHitsRMSTick(slc, tp, kUnusedHits);
-        float doubletRMSTimeErr = doubletWidthTick * tcc.unitsPerTick;
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<" doublet Chg "<<doubletChg<<" doubletTime "<<doubletTime<<" doubletRMSTimeErr "<<doubletRMSTimeErr;
-        float doubletFOM = PointTrajDOCA(slc, tp.Pos[0], doubletTime, tp) / doubletRMSTimeErr;
+        doubletTime *= tcx.tcc.unitsPerTick;
+        float doubletWidthTick = TPHitsRMSTick(tcx, slc, tp, kUnusedHits);
+        float doubletRMSTimeErr = doubletWidthTick * tcx.tcc.unitsPerTick;
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" doublet Chg "<<doubletChg<<" doubletTime "<<doubletTime<<" doubletRMSTimeErr "<<doubletRMSTimeErr;
+        float doubletFOM = PointTrajDOCA(tcx, slc, tp.Pos[0], doubletTime, tp) / doubletRMSTimeErr;
         if(doubletFOM < 0.5) doubletFOM = 0.5;
         float doubletChgPull = std::abs(doubletChg * pathInv / tp.AveChg - 1) / tj.ChgRMS;
         if(doubletChgPull > 1) doubletFOM *= chgWght * doubletChgPull;
         rmsRat = doubletWidthTick / expectedWidth;
         if(rmsRat < 1) rmsRat = 1 / rmsRat;
         doubletFOM *= rmsRat;
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<" doublet FOM "<<PointTrajDOCA(slc, tp.Pos[0], doubletTime, tp)/doubletRMSTimeErr<<" doubletChgPull "<<doubletChgPull<<" rmsRat "<<rmsRat<<" doubletFOM "<<doubletFOM;
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" doublet FOM "<<PointTrajDOCA(tcx, slc, tp.Pos[0], doubletTime, tp)/doubletRMSTimeErr<<" doubletChgPull "<<doubletChgPull<<" rmsRat "<<rmsRat<<" doubletFOM "<<doubletFOM;
         if(doubletFOM < bestDeltaHitFOM && doubletFOM < otherHitFOM) {
           tp.UseHit[imbest] = true;
           slc.slHits[bestDeltaHit].InTraj = tj.ID;
@@ -2010,15 +2011,15 @@ namespace tca {
       }
       return;
     } // nAvailable == 2
-    float hitsWidth = TPHitsRMSTick(slc, tp, kUnusedHits);
-    float maxTick = tp.Pos[1] / tcc.unitsPerTick + 0.6 * expectedWidth;
-    float minTick = tp.Pos[1] / tcc.unitsPerTick - 0.6 * expectedWidth;
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<" Multiplet: hitsWidth "<<hitsWidth<<" expectedWidth "<<expectedWidth<<" tick range "<<(int)minTick<<" "<<(int)maxTick;
+    float hitsWidth = TPHitsRMSTick(tcx, slc, tp, kUnusedHits);
+    float maxTick = tp.Pos[1] / tcx.tcc.unitsPerTick + 0.6 * expectedWidth;
+    float minTick = tp.Pos[1] / tcx.tcc.unitsPerTick - 0.6 * expectedWidth;
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" Multiplet: hitsWidth "<<hitsWidth<<" expectedWidth "<<expectedWidth<<" tick range "<<(int)minTick<<" "<<(int)maxTick;
     // use all of the hits in the tick window
     for(unsigned short ii = 0; ii < tp.Hits.size(); ++ii) {
       unsigned int iht = tp.Hits[ii];
       if(slc.slHits[iht].InTraj > 0) continue;
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       if(hit.PeakTime() < minTick) continue;
       if(hit.PeakTime() > maxTick) continue;
       tp.UseHit[ii] = true;
@@ -2028,15 +2029,15 @@ namespace tca {
   } // FindUseHits
 
   ////////////////////////////////////////////////
-  void FillGaps(TCSlice& slc, Trajectory& tj)
+  void FillGaps(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Fill in any gaps in the trajectory with close hits regardless of charge (well maybe not quite that)
 
-    if(!tcc.useAlg[kFillGaps]) return;
+    if(!tcx.tcc.useAlg[kFillGaps]) return;
     if(tj.AlgMod[kJunkTj]) return;
     if(tj.ChgRMS <= 0) return;
 
-    unsigned short npwc = NumPtsWithCharge(slc, tj, false);
+    unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
     if(npwc < 8) return;
 
     // don't consider the last few points since they would be trimmed
@@ -2051,7 +2052,7 @@ namespace tca {
         if(chg == 0) {
           for(unsigned short ii = 0; ii < tp.Hits.size(); ++ii) {
             unsigned int iht = tp.Hits[ii];
-            auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+            auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
             chg += hit.Integral();
           }
         } // chg == 0
@@ -2065,7 +2066,7 @@ namespace tca {
       } // ipt
     } // !tj.EndFlag[1][kBragg]
 
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<"FG: Check Tj "<<tj.ID<<" from "<<PrintPos(slc, tj.Pts[tj.EndPt[0]])<<" to "<<PrintPos(slc, tj.Pts[toPt]);
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"FG: Check Tj "<<tj.ID<<" from "<<PrintPos(tcx, slc, tj.Pts[tj.EndPt[0]])<<" to "<<PrintPos(tcx, slc, tj.Pts[toPt]);
 
     // start with the first point that has charge
     short firstPtWithChg = tj.EndPt[0];
@@ -2091,18 +2092,18 @@ namespace tca {
       }
       // Make a bare trajectory point at firstPtWithChg that points to nextPtWithChg
       TrajPoint tp;
-      if(!MakeBareTrajPoint(slc, tj.Pts[firstPtWithChg], tj.Pts[nextPtWithChg], tp)) {
+      if(!MakeBareTrajPoint(tcx, slc, tj.Pts[firstPtWithChg], tj.Pts[nextPtWithChg], tp)) {
         tj.IsGood = false;
         return;
       }
       // Find the maximum delta between hits and the trajectory Pos for all
       // hits on this trajectory
       if(first) {
-        maxDelta = 2.5 * MaxHitDelta(slc, tj);
+        maxDelta = 2.5 * MaxHitDelta(tcx, slc, tj);
         first = false;
       } // first
       // define a loose charge cut using the average charge at the first point with charge
-      float maxChg = tj.Pts[firstPtWithChg].AveChg * (1 + 2 * tcc.chargeCuts[0] * tj.ChgRMS);
+      float maxChg = tj.Pts[firstPtWithChg].AveChg * (1 + 2 * tcx.tcc.chargeCuts[0] * tj.ChgRMS);
       // Eliminate the charge cut altogether if we are close to an end
       if(tj.Pts.size() < 10) {
         maxChg = 1E6;
@@ -2131,45 +2132,45 @@ namespace tca {
         for(unsigned short ii = 0; ii < tj.Pts[mpt].Hits.size(); ++ii) {
           unsigned int iht = tj.Pts[mpt].Hits[ii];
           if(slc.slHits[iht].InTraj > 0) continue;
-          auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
-          float delta = PointTrajDOCA(slc, iht, tp);
-          if(tcc.dbgStp) mf::LogVerbatim("TC")<<" FG: "<<PrintPos(slc,tj.Pts[mpt])<<" hit "<<PrintHit(slc.slHits[iht])<<" delta "<<delta<<" maxDelta "<<maxDelta<<" Chg "<<hit.Integral()<<" maxChg "<<maxChg;
+          auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
+          float delta = PointTrajDOCA(tcx, slc, iht, tp);
+          if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" FG: "<<PrintPos(tcx, slc,tj.Pts[mpt])<<" hit "<<PrintHit(tcx, slc.slHits[iht])<<" delta "<<delta<<" maxDelta "<<maxDelta<<" Chg "<<hit.Integral()<<" maxChg "<<maxChg;
           if(delta > maxDelta) continue;
           tj.Pts[mpt].UseHit[ii] = true;
           slc.slHits[iht].InTraj = tj.ID;
           chg += hit.Integral();
           filled = true;
         } // ii
-        if(chg > maxChg || MCSMom(slc, tj) < minMCSMom) {
+        if(chg > maxChg || MCSMom(tcx, slc, tj) < minMCSMom) {
           // don't use these hits after all
           UnsetUsedHits(slc, tj.Pts[mpt]);
           filled = false;
         }
         if(filled) {
-          DefineHitPos(slc, tj.Pts[mpt]);
+          DefineHitPos(tcx, slc, tj.Pts[mpt]);
           tj.AlgMod[kFillGaps] = true;
-          if(tcc.dbgStp) {
-            PrintTP("FG", slc, mpt, tj.StepDir, tj.Pass, tj.Pts[mpt]);
-            mf::LogVerbatim("TC")<<"Check MCSMom "<<MCSMom(slc, tj);
+          if(tcx.tcc.dbgStp) {
+            PrintTP("FG", tcx, slc, mpt, tj.StepDir, tj.Pass, tj.Pts[mpt]);
+            mf::LogVerbatim("TC")<<"Check MCSMom "<<MCSMom(tcx, slc, tj);
           }
         } // filled
       } // mpt
       firstPtWithChg = nextPtWithChg;
     } // firstPtWithChg
 
-    if(tj.AlgMod[kFillGaps]) tj.MCSMom = MCSMom(slc, tj);
+    if(tj.AlgMod[kFillGaps]) tj.MCSMom = MCSMom(tcx, slc, tj);
 
   } // FillGaps
 
   ////////////////////////////////////////////////
-  void CheckHiMultUnusedHits(TCSlice& slc, Trajectory& tj)
+  void CheckHiMultUnusedHits(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Check for many unused hits in high multiplicity TPs in work and try to use them
 
-    if(!tcc.useAlg[kCHMUH]) return;
+    if(!tcx.tcc.useAlg[kCHMUH]) return;
 
     // This code might do bad things to short trajectories
-    if(NumPtsWithCharge(slc, tj, true) < 6) return;
+    if(NumPtsWithCharge(tcx, slc, tj, true) < 6) return;
     if(tj.EndPt[0] == tj.EndPt[1]) return;
     // Angle code 0 tjs shouldn't have any high multiplicity hits added to them
     if(tj.Pts[tj.EndPt[1]].AngleCode == 0) return;
@@ -2226,20 +2227,20 @@ namespace tca {
     // Use this to limit the number of points fit for trajectories that
     // are close the LA tracking cut
     ii = tj.EndPt[1];
-    bool sortaLargeAngle = (AngleRange(tj.Pts[ii]) == 1);
+    bool sortaLargeAngle = (AngleRange(tcx, tj.Pts[ii]) == 1);
 
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<"CHMUH: First InTraj stopPt "<<stopPt<<" fracHiMult "<<fracHiMult<<" fracHitsUsed "<<fracHitsUsed<<" lastMult1Pt "<<lastMult1Pt<<" sortaLargeAngle "<<sortaLargeAngle;
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"CHMUH: First InTraj stopPt "<<stopPt<<" fracHiMult "<<fracHiMult<<" fracHitsUsed "<<fracHitsUsed<<" lastMult1Pt "<<lastMult1Pt<<" sortaLargeAngle "<<sortaLargeAngle;
     if(fracHiMult < 0.3) return;
     if(fracHitsUsed > 0.98) return;
 
-    float maxDelta = 2.5 * MaxHitDelta(slc, tj);
+    float maxDelta = 2.5 * MaxHitDelta(tcx, slc, tj);
 
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim("TC")<<" Pts size "<<tj.Pts.size()<<" nHiMultPt "<<nHiMultPt<<" nHiMultPtHits "<<nHiMultPtHits<<" nHiMultPtUsedHits "<<nHiMultPtUsedHits<<" sortaLargeAngle "<<sortaLargeAngle<<" maxHitDelta "<<maxDelta;
     }
 
     // Use next pass cuts if available
-    if(sortaLargeAngle && tj.Pass < tcc.minPtsFit.size()-1) ++tj.Pass;
+    if(sortaLargeAngle && tj.Pass < tcx.tcc.minPtsFit.size()-1) ++tj.Pass;
 
     // Make a copy of tj in case something bad happens
     Trajectory TjCopy = tj;
@@ -2257,9 +2258,9 @@ namespace tca {
       added = false;
       for(ii = 0; ii < tj.Pts[ipt].Hits.size(); ++ii) {
         iht = tj.Pts[ipt].Hits[ii];
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<" ipt "<<ipt<<" hit "<<PrintHit(slc.slHits[iht])<<" inTraj "<<slc.slHits[iht].InTraj<<" delta "<<PointTrajDOCA(slc, iht, tj.Pts[ipt]);
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" ipt "<<ipt<<" hit "<<PrintHit(tcx, slc.slHits[iht])<<" inTraj "<<slc.slHits[iht].InTraj<<" delta "<<PointTrajDOCA(tcx, slc, iht, tj.Pts[ipt]);
         if(slc.slHits[iht].InTraj != 0) continue;
-        delta = PointTrajDOCA(slc, iht, tj.Pts[ipt]);
+        delta = PointTrajDOCA(tcx, slc, iht, tj.Pts[ipt]);
         if(delta > maxDelta) continue;
         if (!NumHitsInTP(TjCopy.Pts[ipt], kUsedHits)||TjCopy.Pts[ipt].UseHit[ii]){
           tj.Pts[ipt].UseHit[ii] = true;
@@ -2267,14 +2268,14 @@ namespace tca {
           added = true;
         }
       } // ii
-      if(added) DefineHitPos(slc, tj.Pts[ipt]);
+      if(added) DefineHitPos(tcx, slc, tj.Pts[ipt]);
       if(tj.Pts[ipt].Chg == 0) continue;
       tj.EndPt[1] = ipt;
       // This will be incremented by one in UpdateTraj
       if(sortaLargeAngle) tj.Pts[ipt].NTPsFit = 2;
-      UpdateTraj(slc, tj);
+      UpdateTraj(tcx, slc, tj);
       if(tj.NeedsUpdate) {
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<"UpdateTraj failed on point "<<ipt;
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"UpdateTraj failed on point "<<ipt;
         // Clobber the used hits from the corrupted points in tj
         for(unsigned short jpt = stopPt + 1; jpt <= ipt; ++jpt) {
           for(unsigned short jj = 0; jj < tj.Pts[jpt].Hits.size(); ++jj) {
@@ -2291,8 +2292,8 @@ namespace tca {
         } // jpt
         return;
       }
-      GottaKink(slc, tj, true);
-      if(tcc.dbgStp) PrintTrajectory("CHMUH", slc, tj, ipt);
+      GottaKink(tcx, slc, tj, true);
+      if(tcx.tcc.dbgStp) PrintTrajectory("CHMUH", tcx, slc, tj, ipt);
     } // ipt
     // if we made it here it must be OK
     SetEndPoints(tj);
@@ -2304,10 +2305,10 @@ namespace tca {
   } // CheckHiMultUnusedHits
 
   ////////////////////////////////////////////////
-  void CheckHiMultEndHits(TCSlice& slc, Trajectory& tj)
+  void CheckHiMultEndHits(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // mask off high multiplicity TPs at the end
-    if(!tcc.useAlg[kCHMEH]) return;
+    if(!tcx.tcc.useAlg[kCHMEH]) return;
     if(tj.EndFlag[1][kBragg]) return;
     if(tj.Pts.size() < 10) return;
     if(tj.Pts[tj.EndPt[1]].AngleCode == 0) return;
@@ -2336,7 +2337,7 @@ namespace tca {
       }
       break;
     } // ipt
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<"CHMEH multiplicity cut "<<aveMult<<" number of TPs masked off "<<cnt;
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"CHMEH multiplicity cut "<<aveMult<<" number of TPs masked off "<<cnt;
     if(cnt > 0) {
       tj.AlgMod[kCHMEH] = true;
       SetEndPoints(tj);
@@ -2344,7 +2345,7 @@ namespace tca {
   } // CheckHiMultEndHits
 
   //////////////////////////////////////////
-  void UpdateDeltaRMS(TCSlice& slc, Trajectory& tj)
+  void UpdateDeltaRMS(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Estimate the Delta RMS of the TPs on the end of tj.
 
@@ -2360,7 +2361,7 @@ namespace tca {
       ipt = lastPt - ii;
       if(ipt > tj.Pts.size() - 1) break;
       if(tj.Pts[ipt].Chg == 0) continue;
-      sum += PointTrajDOCA(slc, tj.Pts[ipt].Pos[0], tj.Pts[ipt].Pos[1], lastTP);
+      sum += PointTrajDOCA(tcx, slc, tj.Pts[ipt].Pos[0], tj.Pts[ipt].Pos[1], lastTP);
       ++cnt;
       if(cnt == lastTP.NTPsFit) break;
       if(ipt == 0) break;
@@ -2374,15 +2375,15 @@ namespace tca {
   } // UpdateDeltaRMS
 
   //////////////////////////////////////////
-  void MaskBadTPs(TCSlice& slc, Trajectory& tj, float const& maxChi)
+  void MaskBadTPs(TCContext& tcx, TCSlice& slc, Trajectory& tj, float const& maxChi)
   {
     // Remove TPs that have the worst values of delta until the fit chisq < maxChi
 
-    if(!tcc.useAlg[kMaskBadTPs]) return;
+    if(!tcx.tcc.useAlg[kMaskBadTPs]) return;
     //don't use this function for reverse propagation
-    if(!tcc.useAlg[kRvPrp]) return;
+    if(!tcx.tcc.useAlg[kRvPrp]) return;
 
-    bool prt = (tcc.dbgStp || tcc.dbgAlg[kMaskBadTPs]);
+    bool prt = (tcx.tcc.dbgStp || tcx.tcc.dbgAlg[kMaskBadTPs]);
 
     if(tj.Pts.size() < 3) {
       //      mf::LogError("TC")<<"MaskBadTPs: Trajectory ID "<<tj.ID<<" too short to mask hits ";
@@ -2410,7 +2411,7 @@ namespace tca {
       if(prt) mf::LogVerbatim("TC")<<"MaskBadTPs: lastTP.FitChi "<<lastTP.FitChi<<"  Mask point "<<imBad;
       // mask the point
       UnsetUsedHits(slc, tj.Pts[imBad]);
-      FitTraj(slc, tj);
+      FitTraj(tcx, slc, tj);
       if(prt) mf::LogVerbatim("TC")<<"  after FitTraj "<<lastTP.FitChi;
       tj.AlgMod[kMaskBadTPs] = true;
       ++nit;
@@ -2419,12 +2420,12 @@ namespace tca {
   } // MaskBadTPs
 
   ////////////////////////////////////////////////
-  bool MaskedHitsOK(TCSlice& slc, Trajectory& tj)
+  bool MaskedHitsOK(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // The hits in the TP at the end of the trajectory were masked off. Decide whether to continue stepping with the
     // current configuration (true) or whether to stop and possibly try with the next pass settings (false)
 
-    if(!tcc.useAlg[kMaskHits]) return true;
+    if(!tcx.tcc.useAlg[kMaskHits]) return true;
 
     unsigned short lastPt = tj.Pts.size() - 1;
     if(tj.Pts[lastPt].Chg > 0) return true;
@@ -2455,7 +2456,7 @@ namespace tca {
         unsigned int iht = tp.Hits[jj];
         if(slc.slHits[iht].InTraj != 0) continue;
         ++nUnusedHits;
-        auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+        auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
         chg += hit.Integral();
       } // jj
       if(chg < maxOKChg) ++nOKChg;
@@ -2476,7 +2477,7 @@ namespace tca {
     // Note that nDeltaIncreasing is always positive
     if(driftingAway && nDeltaIncreasing < nMasked - 1) driftingAway = false;
 
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim("TC")<<"MHOK:  nMasked "<<nMasked<<" nOneHit "<<nOneHit<<" nOKChg "<<nOKChg<<" nOKDelta "<<nOKDelta<<" nPosDelta "<<nPosDelta<<" nDeltaIncreasing "<<nDeltaIncreasing<<" driftingAway? "<<driftingAway;
     }
 
@@ -2488,17 +2489,17 @@ namespace tca {
 
     // we would like to reduce the number of fitted points to a minimum and include
     // the masked hits, but we can only do that if there are enough points
-    if(tj.Pts[endPt].NTPsFit <= tcc.minPtsFit[tj.Pass]) {
+    if(tj.Pts[endPt].NTPsFit <= tcx.tcc.minPtsFit[tj.Pass]) {
       // stop stepping if we have masked off more points than are in the fit
       if(nMasked > tj.Pts[endPt].NTPsFit) return false;
       return true;
     }
     // Reduce the number of points fit and try to include the points
     unsigned short newNTPSFit;
-    if(tj.Pts[endPt].NTPsFit > 2 * tcc.minPtsFit[tj.Pass]) {
+    if(tj.Pts[endPt].NTPsFit > 2 * tcx.tcc.minPtsFit[tj.Pass]) {
       newNTPSFit = tj.Pts[endPt].NTPsFit / 2;
     } else {
-      newNTPSFit = tcc.minPtsFit[tj.Pass];
+      newNTPSFit = tcx.tcc.minPtsFit[tj.Pass];
     }
     for(unsigned ipt = endPt + 1; ipt < tj.Pts.size(); ++ipt) {
       TrajPoint& tp = tj.Pts[ipt];
@@ -2510,21 +2511,21 @@ namespace tca {
           break;
         }
       } // ii
-      DefineHitPos(slc, tp);
+      DefineHitPos(tcx, slc, tp);
       SetEndPoints(tj);
       tp.NTPsFit = newNTPSFit;
-      FitTraj(slc, tj);
-      if(tcc.dbgStp) PrintTrajectory("MHOK", slc, tj, ipt);
+      FitTraj(tcx, slc, tj);
+      if(tcx.tcc.dbgStp) PrintTrajectory("MHOK", tcx, slc, tj, ipt);
     } // ipt
 
     tj.AlgMod[kMaskHits] = true;
-    UpdateTjChgProperties("MHOK", slc, tj, tcc.dbgStp);
+    UpdateTjChgProperties("MHOK", tcx, slc, tj, tcx.tcc.dbgStp);
     return true;
 
   } // MaskedHitsOK
 
   ////////////////////////////////////////////////
-  bool StopIfBadFits(TCSlice& slc, Trajectory& tj)
+  bool StopIfBadFits(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Returns true if there are a number of Tps that were not used in the trajectory because the fit was poor and the
     // charge pull is not really high. This
@@ -2544,14 +2545,14 @@ namespace tca {
       if(cnt == 5) break;
     } // ipt
 
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<"StopIfBadFits: nBadFit "<<nBadFit<<" nHiChg "<<nHiChg;
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"StopIfBadFits: nBadFit "<<nBadFit<<" nHiChg "<<nHiChg;
     if(nBadFit > 3 && nHiChg == 0) return true;
     return false;
 
   } // StopIfBadFits
 
 ////////////////////////////////////////////////
-  bool GottaKink(TCSlice& slc, Trajectory& tj, bool doTrim)
+  bool GottaKink(TCContext& tcx, TCSlice& slc, Trajectory& tj, bool doTrim)
   {
     // This function returns true if it detects a kink in the trajectory
     // This function trims the points after a kink if one is found if doTrim is true.
@@ -2567,13 +2568,13 @@ namespace tca {
     // stop-at-kink end flag
     if(tj.Strategy[kStiffEl]) return false;
     // Need at least 2 * kinkCuts[2] points with charge to find a kink
-    unsigned short npwc = NumPtsWithCharge(slc, tj, false);
-    unsigned short nPtsFit = tcc.kinkCuts[0];
+    unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
+    unsigned short nPtsFit = tcx.tcc.kinkCuts[0];
     // Set nPtsFit for slowing tjs to the last TP NTPsFit
     if(tj.Strategy[kSlowing]) nPtsFit = tj.Pts[tj.EndPt[1]].NTPsFit;
     if(npwc < 2 * nPtsFit) return false;
 
-    bool useCharge = (tcc.kinkCuts[2] > 0);
+    bool useCharge = (tcx.tcc.kinkCuts[2] > 0);
 
     // find the point where a kink is expected and fit the points after that point
     unsigned short fitPt = USHRT_MAX;
@@ -2593,20 +2594,20 @@ namespace tca {
       }
     } // ii
     if(fitPt == USHRT_MAX) {
-      if(tcc.dbgStp) {
+      if(tcx.tcc.dbgStp) {
         mf::LogVerbatim myprt("TC");
         myprt<<"GKv2 fitPt not valid. Counted "<<cnt<<" points. Need "<<nPtsFit;
       } // tcc.dbgStp
       return false;
     }
 
-    tj.Pts[fitPt].KinkSig = KinkSignificance(slc, tj, fitPt, nPtsFit, useCharge, tcc.dbgStp);
+    tj.Pts[fitPt].KinkSig = KinkSignificance(tcx, slc, tj, fitPt, nPtsFit, useCharge, tcx.tcc.dbgStp);
 
-    bool thisPtHasKink = (tj.Pts[fitPt].KinkSig > tcc.kinkCuts[1]);
-    bool prevPtHasKink = (tj.Pts[fitPt - 1].KinkSig > tcc.kinkCuts[1]);
-    if(tcc.dbgStp) {
+    bool thisPtHasKink = (tj.Pts[fitPt].KinkSig > tcx.tcc.kinkCuts[1]);
+    bool prevPtHasKink = (tj.Pts[fitPt - 1].KinkSig > tcx.tcc.kinkCuts[1]);
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim myprt("TC");
-      myprt<<"GKv2 fitPt "<<fitPt<<" "<<PrintPos(slc, tj.Pts[fitPt]);
+      myprt<<"GKv2 fitPt "<<fitPt<<" "<<PrintPos(tcx, slc, tj.Pts[fitPt]);
       myprt<<std::fixed<<std::setprecision(5);
       myprt<<" KinkSig "<<std::setprecision(5)<<tj.Pts[fitPt].KinkSig;
       myprt<<" prevPt significance "<<tj.Pts[fitPt - 1].KinkSig;
@@ -2624,7 +2625,7 @@ namespace tca {
 
     // We have left a kink region. Find the point with the max likelihood and call
     // that the kink point
-    float maxSig = tcc.kinkCuts[1];
+    float maxSig = tcx.tcc.kinkCuts[1];
     unsigned short kinkRegionLength = 0;
     unsigned short maxKinkPt = USHRT_MAX;
     for(unsigned short ipt = fitPt - 1; ipt > tj.EndPt[0]; --ipt) {
@@ -2636,7 +2637,7 @@ namespace tca {
         maxKinkPt = ipt;
       } // tp.KinkSig > maxSig
       // find the start of the kink region
-      if(tp.KinkSig < tcc.kinkCuts[1]) break;
+      if(tp.KinkSig < tcx.tcc.kinkCuts[1]) break;
       ++kinkRegionLength;
     } // ipt
     if(maxKinkPt == USHRT_MAX) return false;
@@ -2645,10 +2646,10 @@ namespace tca {
     unsigned short kinkRegionLengthMin = 1 + nPtsFit / 5;
     if(tj.Strategy[kStiffMu]) kinkRegionLengthMin = 1 + nPtsFit / 3;
     if(kinkRegionLength < kinkRegionLengthMin) {
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"GKv2: kink region too short "<<kinkRegionLength<<" Min "<<kinkRegionLengthMin;
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"GKv2: kink region too short "<<kinkRegionLength<<" Min "<<kinkRegionLengthMin;
       return false;
     }
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<"GKv2:   kink at "<<PrintPos(slc, tj.Pts[maxKinkPt])<<std::setprecision(3)<<" maxSig "<<maxSig<<" kinkRegionLength "<<kinkRegionLength<<" Min "<<kinkRegionLengthMin;
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"GKv2:   kink at "<<PrintPos(tcx, slc, tj.Pts[maxKinkPt])<<std::setprecision(3)<<" maxSig "<<maxSig<<" kinkRegionLength "<<kinkRegionLength<<" Min "<<kinkRegionLengthMin;
     // don't alter the tj unless doTrim is true
     if(!doTrim) return true;
     // trim the points
@@ -2658,7 +2659,7 @@ namespace tca {
     float lastChg = tj.Pts[tj.EndPt[1]].Chg;
     float prevChg = tj.Pts[tj.EndPt[1] - 1].Chg;
     float chgAsym = std::abs(lastChg - prevChg) / (lastChg + prevChg);
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<"GKv2: last point after trim "<<PrintPos(slc, tj.Pts[tj.EndPt[1]])<<" chgAsym "<<chgAsym;
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"GKv2: last point after trim "<<PrintPos(tcx, slc, tj.Pts[tj.EndPt[1]])<<" chgAsym "<<chgAsym;
     if(chgAsym > 0.1) {
       UnsetUsedHits(slc, tj.Pts[tj.EndPt[1]]);
       SetEndPoints(tj);
@@ -2669,13 +2670,13 @@ namespace tca {
   } // GottaKink
 
   ////////////////////////////////////////////////
-  void ChkBegin(TCSlice& slc, Trajectory& tj)
+  void ChkBegin(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Check the parameters at the start of the trajectory. The first
     // points may not belong to this trajectory since they were added when there was
     // little information. This information may be updated later if ReversePropagate is used
 
-    if(!tcc.useAlg[kFixBegin]) return;
+    if(!tcx.tcc.useAlg[kFixBegin]) return;
     if(tj.AlgMod[kJunkTj]) return;
 
     // don't do anything if this tj has been modified by ReversePropagate
@@ -2691,7 +2692,7 @@ namespace tca {
       auto& tp = tj.Pts[ipt];
       if(tp.Chg == 0) continue;
       if(tp.AveChg > 0 && firstGoodChgPullPt == USHRT_MAX) {
-        if(std::abs(tp.ChgPull) < tcc.chargeCuts[0]) firstGoodChgPullPt = ipt;
+        if(std::abs(tp.ChgPull) < tcx.tcc.chargeCuts[0]) firstGoodChgPullPt = ipt;
       } // find the first good charge pull point
       if(tp.NTPsFit > maxPtsFit) {
         maxPtsFit = tp.NTPsFit;
@@ -2715,17 +2716,17 @@ namespace tca {
     } // ii
 
     bool needsRevProp = firstPtFit > 3;
-    unsigned short nPtsLeft = NumPtsWithCharge(slc, tj, false) - firstPtFit;
+    unsigned short nPtsLeft = NumPtsWithCharge(tcx, slc, tj, false) - firstPtFit;
     if(needsRevProp) {
       needsRevProp = (nPtsLeft > 5);
     }
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim myprt("TC");
-      myprt<<"CB: firstPtFit "<<firstPtFit<<" at "<<PrintPos(slc, tj.Pts[firstPtFit].Pos);
-      myprt<<" atPt "<<PrintPos(slc, tj.Pts[atPt].Pos);
+      myprt<<"CB: firstPtFit "<<firstPtFit<<" at "<<PrintPos(tcx, slc, tj.Pts[firstPtFit].Pos);
+      myprt<<" atPt "<<PrintPos(tcx, slc, tj.Pts[atPt].Pos);
       myprt<<" nPts with charge "<<nPtsLeft;
       myprt<<" firstGoodChgPullPt "<<firstGoodChgPullPt;
-      if(firstGoodChgPullPt != USHRT_MAX) myprt<<" at "<<PrintPos(slc,tj.Pts[firstGoodChgPullPt]);
+      if(firstGoodChgPullPt != USHRT_MAX) myprt<<" at "<<PrintPos(tcx, slc,tj.Pts[firstGoodChgPullPt]);
       myprt<<" needsRevProp? "<<needsRevProp;
     }
 
@@ -2736,69 +2737,69 @@ namespace tca {
       tp.Hits.clear();
       tp.UseHit.reset();
       // Move the TP "backwards"
-      double stepSize = tcc.VLAStepSize;
+      double stepSize = tcx.tcc.VLAStepSize;
       if(tp.AngleCode < 2) stepSize = std::abs(1/tp.Dir[0]);
       tp.Pos[0] -= tp.Dir[0] * stepSize * tj.StepDir;
       tp.Pos[1] -= tp.Dir[1] * stepSize * tj.StepDir;
       // launch RevProp if this wire is dead
       unsigned int wire = std::nearbyint(tp.Pos[0]);
       unsigned short plane = DecodeCTP(tp.CTP).Plane;
-      needsRevProp = (wire < slc.nWires[plane] && !evt.goodWire[plane][wire]);
-      if(tcc.dbgStp && needsRevProp) mf::LogVerbatim("TC")<<"CB: Previous wire "<<wire<<" is dead. Call ReversePropagate";
+      needsRevProp = (wire < slc.nWires[plane] && !tcx.evt.goodWire[plane][wire]);
+      if(tcx.tcc.dbgStp && needsRevProp) mf::LogVerbatim("TC")<<"CB: Previous wire "<<wire<<" is dead. Call ReversePropagate";
       if(!needsRevProp && firstGoodChgPullPt != USHRT_MAX) {
         // check for hits on a not-dead wire
         // BB May 20, 2019 Do this more carefully
         float maxDelta = 2 * tp.DeltaRMS;
-        if(FindCloseHits(slc, tp, maxDelta, kAllHits) && !tp.Hits.empty()) {
+        if(FindCloseHits(tcx, slc, tp, maxDelta, kAllHits) && !tp.Hits.empty()) {
           // count used and unused hits
           unsigned short nused = 0;
           for(auto iht : tp.Hits) if(slc.slHits[iht].InTraj > 0) ++nused;
           if(nused == 0) {
             needsRevProp = true;
-            if(tcc.dbgStp) {
-              mf::LogVerbatim("TC")<<"CB: Found "<<tp.Hits.size()-nused<<" close unused hits found near EndPt[0] "<<PrintPos(slc, tp)<<". Call ReversePropagate";
+            if(tcx.tcc.dbgStp) {
+              mf::LogVerbatim("TC")<<"CB: Found "<<tp.Hits.size()-nused<<" close unused hits found near EndPt[0] "<<PrintPos(tcx, slc, tp)<<". Call ReversePropagate";
             } // tcc.dbgStp
           } // nused = 0
         } // Close hits exist
       } // !needsRevProp
     } // !needsRevProp
 
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim("TC")<<"CB: maxPtsFit "<<maxPtsFit<<" at point "<<atPt<<" firstPtFit "<<firstPtFit<<" Needs ReversePropagate? "<<needsRevProp;
     }
 
-    if(tcc.useAlg[kFTBRvProp] && needsRevProp) {
+    if(tcx.tcc.useAlg[kFTBRvProp] && needsRevProp) {
       // lop off the points before firstPtFit and reverse propagate
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<"  clobber TPs "<<PrintPos(slc, tj.Pts[0])<<" to "<<PrintPos(slc, tj.Pts[firstPtFit])<<". Call TrimEndPts then ReversePropagate ";
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"  clobber TPs "<<PrintPos(tcx, slc, tj.Pts[0])<<" to "<<PrintPos(tcx, slc, tj.Pts[firstPtFit])<<". Call TrimEndPts then ReversePropagate ";
       // first save the first TP on this trajectory. We will try to re-use it if
       // it isn't used during reverse propagation
-      seeds.push_back(tj.Pts[0]);
+      slc.seeds.push_back(tj.Pts[0]);
       for(unsigned short ipt = 0; ipt <= firstPtFit; ++ipt) UnsetUsedHits(slc, tj.Pts[ipt]);
       SetEndPoints(tj);
       tj.AlgMod[kFTBRvProp] = true;
       // Check for quality and trim if necessary before reverse propagation
-      TrimEndPts("RPi", slc, tj, tcc.qualityCuts, tcc.dbgStp);
+      TrimEndPts("RPi", tcx, slc, tj, tcx.tcc.qualityCuts, tcx.tcc.dbgStp);
       if(tj.AlgMod[kKilled]) {
         tj.IsGood = false;
         return;
       }
-      ReversePropagate(slc, tj);
-      ChkStopEndPts(slc, tj, tcc.dbgStp);
+      ReversePropagate(tcx, slc, tj);
+      ChkStopEndPts(tcx, slc, tj, tcx.tcc.dbgStp);
     }
     if(firstGoodChgPullPt != USHRT_MAX && firstGoodChgPullPt > atPt) atPt = firstGoodChgPullPt;
     // Update the fit parameters of the first points if no reverse propagation was done
-    if(!tj.AlgMod[kRvPrp]) FixBegin(slc, tj, atPt);
+    if(!tj.AlgMod[kRvPrp]) FixBegin(tcx, slc, tj, atPt);
 
   } // ChkBegin
 
   ////////////////////////////////////////////////
-  void FixBegin(TCSlice& slc, Trajectory& tj, unsigned short atPt)
+  void FixBegin(TCContext& tcx, TCSlice& slc, Trajectory& tj, unsigned short atPt)
   {
     // Update the parameters at the beginning of the trajectory starting at point atPt
 
-    if(!tcc.useAlg[kFixBegin]) return;
+    if(!tcx.tcc.useAlg[kFixBegin]) return;
     // ignore short trajectories
-    unsigned short npwc = NumPtsWithCharge(slc, tj, false);
+    unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
     if(npwc < 6) return;
     // ignore shower-like trajectories
     if(tj.PDGCode == 11) return;
@@ -2818,7 +2819,7 @@ namespace tca {
     } // ipt
     maxDelta = 3 * maxDeltaRMS;
 
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim("TC")<<"FB: atPt "<<atPt<<" firstPt "<<firstPt<<" Stops at end 0? "<<PrintEndFlag(tj, 0)<<" start vertex "<<tj.VtxID[0]<<" maxDelta "<<maxDelta;
     }
 
@@ -2836,21 +2837,21 @@ namespace tca {
       // Correct the projected time to the wire
       float dw = tp.Pos[0] - tj.Pts[atPt].Pos[0];
       if(tp.Dir[0] != 0) tp.Pos[1] = tj.Pts[atPt].Pos[1] + dw * tp.Dir[1] / tp.Dir[0];
-      tj.Pts[ipt].Delta = PointTrajDOCA(slc, tj.Pts[ipt].HitPos[0], tj.Pts[ipt].HitPos[1], tj.Pts[ipt]);
+      tj.Pts[ipt].Delta = PointTrajDOCA(tcx, slc, tj.Pts[ipt].HitPos[0], tj.Pts[ipt].HitPos[1], tj.Pts[ipt]);
       tj.Pts[ipt].DeltaRMS = tj.Pts[atPt].DeltaRMS;
       tj.Pts[ipt].NTPsFit = tj.Pts[atPt].NTPsFit;
       tj.Pts[ipt].FitChi = tj.Pts[atPt].FitChi;
       tj.Pts[ipt].AveChg = tj.Pts[atPt].AveChg;
       tj.Pts[ipt].ChgPull = (tj.Pts[ipt].Chg / tj.AveChg - 1) / tj.ChgRMS;
-      bool badChg = (std::abs(tj.Pts[ipt].ChgPull) > tcc.chargeCuts[0]);
+      bool badChg = (std::abs(tj.Pts[ipt].ChgPull) > tcx.tcc.chargeCuts[0]);
       bool maskThisPt = (tj.Pts[ipt].Delta > maxDelta || badChg);
       if(maskThisPt) {
         UnsetUsedHits(slc, tp);
         maskedPts = true;
       }
-      if(tcc.dbgStp) {
+      if(tcx.tcc.dbgStp) {
         mf::LogVerbatim myprt("TC");
-        myprt<<" Point "<<PrintPos(slc, tj.Pts[ipt].Pos)<<" Delta "<<tj.Pts[ipt].Delta<<" ChgPull "<<tj.Pts[ipt].ChgPull<<" maskThisPt? "<<maskThisPt;
+        myprt<<" Point "<<PrintPos(tcx, slc, tj.Pts[ipt].Pos)<<" Delta "<<tj.Pts[ipt].Delta<<" ChgPull "<<tj.Pts[ipt].ChgPull<<" maskThisPt? "<<maskThisPt;
       }
       if(ipt == 0) break;
     } // ii
@@ -2860,11 +2861,11 @@ namespace tca {
   } // FixBegin
 
   ////////////////////////////////////////////////
-  bool IsGhost(TCSlice& slc, Trajectory& tj)
+  bool IsGhost(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Sees if trajectory tj shares many hits with another trajectory and if so merges them.
 
-    if(!tcc.useAlg[kUseGhostHits]) return false;
+    if(!tcx.tcc.useAlg[kUseGhostHits]) return false;
     // ensure that tj is not a saved trajectory
     if(tj.ID > 0) return true;
     // or an already killed trajectory
@@ -2906,7 +2907,7 @@ namespace tca {
     hitCnt /= 3;
     int oldTjID = INT_MAX;
 
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim myprt("TC");
       myprt<<"IsGhost tj hits size cut "<<hitCnt<<" tID_tCnt";
       for(unsigned short ii = 0; ii < tCnt.size(); ++ii) myprt<<" "<<tID[ii]<<"_"<<tCnt[ii];
@@ -2981,7 +2982,7 @@ namespace tca {
       } // oTjHasChg[indx]
     } // ipt
 
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<" Number of missed wires in oTj gaps "<<nMissedWires<<" Number of ghost hits in these gaps "<<ngh<<" nghPlus "<<nghPlus<<" cut "<<0.2 * nMissedWires;
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" Number of missed wires in oTj gaps "<<nMissedWires<<" Number of ghost hits in these gaps "<<ngh<<" nghPlus "<<nghPlus<<" cut "<<0.2 * nMissedWires;
 
     if(ngh < 0.2 * nMissedWires) return false;
     if(firstPtInoTj > lastPtInoTj) return false;
@@ -2989,13 +2990,13 @@ namespace tca {
     // require all of the tj TPs to be on either the + or - side of the oTj trajectory
     if(!(nghPlus > 0.8 * ngh || nghPlus < 0.2 * ngh) ) return false;
 
-    if(tcc.dbgStp) mf::LogVerbatim("TC")<<" Trajectory is a ghost of "<<oldTjID<<" first point in oTj "<<firstPtInoTj<<" last point "<<lastPtInoTj;
+    if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" Trajectory is a ghost of "<<oldTjID<<" first point in oTj "<<firstPtInoTj<<" last point "<<lastPtInoTj;
 
     // unset all of the shared hits
     for(unsigned short ipt = firstPtInoTj; ipt <= lastPtInoTj; ++ipt) {
       if(tj.Pts[ipt].Chg == 0) continue;
       UnsetUsedHits(slc, tj.Pts[ipt]);
-      if(tcc.dbgStp) PrintTrajectory("IG", slc, tj, ipt);
+      if(tcx.tcc.dbgStp) PrintTrajectory("IG", tcx, slc, tj, ipt);
     }
     // see how many points are left at the end
     ngh = 0;
@@ -3003,7 +3004,7 @@ namespace tca {
       if(tj.Pts[ipt].Chg > 0) ++ngh;
     } // ipt
     // clobber those too?
-    if(ngh > 0 && ngh < tcc.minPts[tj.Pass]) {
+    if(ngh > 0 && ngh < tcx.tcc.minPts[tj.Pass]) {
       for(unsigned short ipt = lastPtInoTj; ipt <= tj.EndPt[1]; ++ipt) {
         if(tj.Pts[ipt].Chg > 0) UnsetUsedHits(slc, tj.Pts[ipt]);
       } // ipt
@@ -3011,34 +3012,34 @@ namespace tca {
     SetEndPoints(tj);
     tj.Pts.resize(tj.EndPt[1] + 1);
     slc.tjs[oldTjIndex].AlgMod[kUseGhostHits] = true;
-    TrimEndPts("IG", slc, tj, tcc.qualityCuts, tcc.dbgStp);
+    TrimEndPts("IG", tcx, slc, tj, tcx.tcc.qualityCuts, tcx.tcc.dbgStp);
     if(tj.AlgMod[kKilled]) {
       tj.IsGood = false;
-      if(tcc.dbgStp)  mf::LogVerbatim("TC")<<" Failed quality cuts";
+      if(tcx.tcc.dbgStp)  mf::LogVerbatim("TC")<<" Failed quality cuts";
       return true;
     }
-    tj.MCSMom = MCSMom(slc, tj);
-    if(tcc.dbgStp)  mf::LogVerbatim("TC")<<" New tj size "<<tj.Pts.size();
+    tj.MCSMom = MCSMom(tcx, slc, tj);
+    if(tcx.tcc.dbgStp)  mf::LogVerbatim("TC")<<" New tj size "<<tj.Pts.size();
     return true;
 
   } // IsGhost
 
   ////////////////////////////////////////////////
-  bool IsGhost(TCSlice& slc, std::vector<unsigned int>& tHits)
+  bool IsGhost(TCContext& tcx, TCSlice& slc, std::vector<unsigned int>& tHits)
   {
     // Called by FindJunkTraj to see if the passed hits are close to an existing
     // trajectory and if so, they will be used in that other trajectory
 
-    if(!tcc.useAlg[kUseGhostHits]) return false;
+    if(!tcx.tcc.useAlg[kUseGhostHits]) return false;
 
     if(tHits.size() < 2) return false;
 
-    bool prt = (tcc.dbgStp || tcc.dbgAlg[kUseGhostHits]);
+    bool prt = (tcx.tcc.dbgStp || tcx.tcc.dbgAlg[kUseGhostHits]);
 
     // find all nearby hits
     std::vector<unsigned int> hitsInMuliplet, nearbyHits;
     for(auto iht : tHits) {
-      GetHitMultiplet(slc, iht, hitsInMuliplet, false);
+      GetHitMultiplet(tcx, slc, iht, hitsInMuliplet, false);
       // prevent double counting
       for(auto mht : hitsInMuliplet) {
         if(std::find(nearbyHits.begin(), nearbyHits.end(), mht) == nearbyHits.end()) {
@@ -3103,14 +3104,14 @@ namespace tca {
   } // IsGhost
 
   ////////////////////////////////////////////////
-  void LastEndMerge(TCSlice& slc, CTP_t inCTP)
+  void LastEndMerge(TCContext& tcx, TCSlice& slc, CTP_t inCTP)
   {
     // last ditch attempt to merge long straight broken trajectories by averaging
     // all points in the trajectory and applying tight angle and separation cuts.
     if(slc.tjs.size() < 2) return;
-    if(!tcc.useAlg[kLastEndMerge]) return;
+    if(!tcx.tcc.useAlg[kLastEndMerge]) return;
 
-    bool prt = tcc.dbgAlg[kLastEndMerge];
+    bool prt = tcx.tcc.dbgAlg[kLastEndMerge];
 
     // create an averaged TP for each long Trajectory
     std::vector<TrajPoint> tjTP;
@@ -3127,7 +3128,7 @@ namespace tca {
 
     if(prt) {
       mf::LogVerbatim myprt("TC");
-      myprt<<"inside LastEndMerge slice "<<slices.size()-1<<" inCTP "<<inCTP<<" tjTPs";
+      myprt<<"inside LastEndMerge slice "<<slc.ID<<" inCTP "<<inCTP<<" tjTPs";
       for(auto& tjtp : tjTP) myprt<<" T"<<tjtp.Step;
     }
 
@@ -3145,16 +3146,16 @@ namespace tca {
         if(dang > 0.2) continue;
         // and an impact parameter cut
         unsigned short ipt1, ipt2;
-        float ip12 = PointTrajDOCA(slc, tp1.Pos[0], tp1.Pos[1], tp2);
-        float ip21 = PointTrajDOCA(slc, tp2.Pos[0], tp2.Pos[1], tp1);
+        float ip12 = PointTrajDOCA(tcx, slc, tp1.Pos[0], tp1.Pos[1], tp2);
+        float ip21 = PointTrajDOCA(tcx, slc, tp2.Pos[0], tp2.Pos[1], tp1);
         if(prt) mf::LogVerbatim("TC")<<" ip12 "<<ip12<<" ip21 "<<ip21;
         if(ip12 > 15 && ip21 > 15) continue;
         float minSep = 100;
         // find the separation considering dead wires
-        TrajTrajDOCA(slc, tj1, tj2, ipt1, ipt2, minSep, false);
+        TrajTrajDOCA(tcx, slc, tj1, tj2, ipt1, ipt2, minSep, false);
         if(minSep == 100) continue;
         if(ipt1 >= tj1.Pts.size() || ipt2 >= tj2.Pts.size()) continue;
-        float dwc = DeadWireCount(slc, tj1.Pts[ipt1], tj2.Pts[ipt2]);
+        float dwc = DeadWireCount(tcx, slc, tj1.Pts[ipt1], tj2.Pts[ipt2]);
         if(prt) mf::LogVerbatim("TC")<<" minSep "<<minSep<<" dwc "<<dwc;
         minSep -= dwc;
         if(minSep > 5) continue;
@@ -3173,9 +3174,9 @@ namespace tca {
         if(tj1.EndFlag[end1][kAtKink] || tj2.EndFlag[end2][kAtKink]) continue;
         if(prt) {
           mf::LogVerbatim myprt("TC");
-          myprt<<"LEM: T"<<tj1.ID<<"_"<<PrintPos(slc, tp1);
+          myprt<<"LEM: T"<<tj1.ID<<"_"<<PrintPos(tcx, slc, tp1);
           if(tj1.VtxID[end1] > 0) myprt<<"->2V"<<tj1.VtxID[end1];
-          myprt<<" T"<<tj2.ID<<"_"<<PrintPos(slc, tp2);
+          myprt<<" T"<<tj2.ID<<"_"<<PrintPos(tcx, slc, tp2);
           if(tj2.VtxID[end2] > 0) myprt<<"->2V"<<tj2.VtxID[end2];
           myprt<<" dang "<<std::setprecision(2)<<dang<<" ip12 "<<ip12;
           myprt<<" ip21 "<<ip21;
@@ -3185,18 +3186,18 @@ namespace tca {
         } // prt
         if(tj1.VtxID[end1] > 0) {
           auto& vx2 = slc.vtxs[tj1.VtxID[end1] - 1];
-          MakeVertexObsolete("LEM", slc, vx2, true);
+          MakeVertexObsolete("LEM", tcx, slc, vx2, true);
         }
         if(tj2.VtxID[end2] > 0 && tj2.VtxID[end2] != tj1.VtxID[end1]) {
           auto& vx2 = slc.vtxs[tj2.VtxID[end2] - 1];
-          MakeVertexObsolete("LEM", slc, vx2, true);
+          MakeVertexObsolete("LEM", tcx, slc, vx2, true);
         }
         // remove Bragg flags
         tj1.EndFlag[end1][kBragg] = false;
         tj2.EndFlag[end2][kBragg] = false;
         unsigned int it1 = tj1.ID - 1;
         unsigned int it2 = tj2.ID - 1;
-        if(!MergeAndStore(slc, it1, it2, tcc.dbgMrg)) continue;
+        if(!MergeAndStore(tcx, slc, it1, it2, tcx.tcc.dbgMrg)) continue;
         // set the AlgMod bit
         auto& ntj = slc.tjs[slc.tjs.size() - 1];
         ntj.AlgMod[kLastEndMerge] = true;
@@ -3248,31 +3249,31 @@ namespace tca {
   } // CreateTjTP
 
   ////////////////////////////////////////////////
-  void EndMerge(TCSlice& slc, CTP_t inCTP, bool lastPass)
+  void EndMerge(TCContext& tcx, TCSlice& slc, CTP_t inCTP, bool lastPass)
   {
     // Merges trajectories end-to-end or makes vertices. Does a more careful check on the last pass
 
     if(slc.tjs.size() < 2) return;
-    if(!tcc.useAlg[kMerge]) return;
+    if(!tcx.tcc.useAlg[kMerge]) return;
 
-    bool prt = (tcc.dbgMrg && tcc.dbgSlc && inCTP == debug.CTP);
-    if(prt) mf::LogVerbatim("TC")<<"inside EndMerge slice "<<slices.size()-1<<" inCTP "<<inCTP<<" nTjs "<<slc.tjs.size()<<" lastPass? "<<lastPass;
+    bool prt = (tcx.tcc.dbgMrg && tcx.tcc.dbgSlc && inCTP == debug.CTP);
+    if(prt) mf::LogVerbatim("TC")<<"inside EndMerge slice "<<slc.ID<<" inCTP "<<inCTP<<" nTjs "<<slc.tjs.size()<<" lastPass? "<<lastPass;
 
     // Ensure that all tjs are in the same order
     short tccStepDir = 1;
-    if(!tcc.modes[kStepDir]) tccStepDir = -1;
+    if(!tcx.tcc.modes[kStepDir]) tccStepDir = -1;
     for(auto& tj : slc.tjs) {
       if(tj.AlgMod[kKilled]) continue;
       if(tj.CTP != inCTP) continue;
       if(tj.StepDir != tccStepDir) ReverseTraj(slc, tj);
     } // tj
 
-    unsigned short maxShortTjLen = tcc.vtx2DCuts[0];
+    unsigned short maxShortTjLen = tcx.tcc.vtx2DCuts[0];
 
     // temp vector for checking the fraction of hits near a merge point
     std::vector<int> tjlist(2);
 
-    float minChgRMS = 0.5 * (tcc.chargeCuts[1] + tcc.chargeCuts[2]);
+    float minChgRMS = 0.5 * (tcx.tcc.chargeCuts[1] + tcx.tcc.chargeCuts[2]);
 
     // iterate whenever a merge occurs since tjs will change. This is not necessary
     // when a vertex is created however.
@@ -3297,7 +3298,7 @@ namespace tca {
             auto& lastTP = ttj.Pts[ttj.EndPt[end1]];
             // fit the last 3 points
             lastTP.NTPsFit = 3;
-            FitTraj(slc, ttj);
+            FitTraj(tcx, slc, ttj);
             tp1 = ttj.Pts[ttj.EndPt[end1]];
           } // last pass
           bool isVLA = (tp1.AngleCode == 2);
@@ -3330,7 +3331,7 @@ namespace tca {
               if(tp2.Pos[0] > tp1.Pos[0] + 2) continue;
             }
             // ensure that there is a signal on most of the wires between these points
-            if(!SignalBetween(slc, tp1, tp2, 0.8)) {
+            if(!SignalBetween(tcx, slc, tp1, tp2, 0.8)) {
               continue;
             }
             // Find the distance of closest approach for small angle merging
@@ -3340,11 +3341,11 @@ namespace tca {
             if(isVLA) {
               // compare the minimum separation between Large Angle trajectories using a generous cut
               unsigned short ipt1, ipt2;
-              TrajTrajDOCA(slc, tj1, tj2, ipt1, ipt2, doca);
+              TrajTrajDOCA(tcx, slc, tj1, tj2, ipt1, ipt2, doca);
               //              if(prt) mf::LogVerbatim("TC")<<" isVLA check ipt1 "<<ipt1<<" ipt2 "<<ipt2<<" doca "<<doca;
             } else {
               // small angle
-              doca = PointTrajDOCA(slc, tp1.Pos[0], tp1.Pos[1], tp2);
+              doca = PointTrajDOCA(tcx, slc, tp1.Pos[0], tp1.Pos[1], tp2);
             }
             float fom = dang * doca;
             if(fom < bestFOM) {
@@ -3379,7 +3380,7 @@ namespace tca {
               pt1 = pt2 - 1;
             }
             TrajPoint tpdir;
-            if(MakeBareTrajPoint(slc, tj1.Pts[pt1], tj1.Pts[pt2], tpdir)) tp1.Ang = tpdir.Ang;
+            if(MakeBareTrajPoint(tcx, slc, tj1.Pts[pt1], tj1.Pts[pt2], tpdir)) tp1.Ang = tpdir.Ang;
           } // low MCSMom
           // Now do the same for tj2
           TrajPoint tp2 = tj2.Pts[tj2.EndPt[end2]];
@@ -3400,10 +3401,10 @@ namespace tca {
               pt1 = pt2 - 1;
             }
             TrajPoint tpdir;
-            if(MakeBareTrajPoint(slc, tj2.Pts[pt1], tj2.Pts[pt2], tpdir)) tp2.Ang = tpdir.Ang;
+            if(MakeBareTrajPoint(tcx, slc, tj2.Pts[pt1], tj2.Pts[pt2], tpdir)) tp2.Ang = tpdir.Ang;
           } // low MCSMom
 
-          if(!isVLA && !SignalBetween(slc, tp1, tp2, 0.99)) continue;
+          if(!isVLA && !SignalBetween(tcx, slc, tp1, tp2, 0.99)) continue;
 
           // decide whether to merge or make a vertex
           // protect against angles > pi/2
@@ -3420,9 +3421,9 @@ namespace tca {
           float docaCut = 2;
           float kinkSig = -1;
           if(!loMCSMom) {
-            unsigned short nPtsFit = tcc.kinkCuts[0];
-            bool useChg = (tcc.kinkCuts[2] > 0);
-            kinkSig = KinkSignificance(slc, tj1, end1, tj2, end2, nPtsFit, useChg, prt);
+            unsigned short nPtsFit = tcx.tcc.kinkCuts[0];
+            bool useChg = (tcx.tcc.kinkCuts[2] > 0);
+            kinkSig = KinkSignificance(tcx, slc, tj1, end1, tj2, end2, nPtsFit, useChg, prt);
           }
           docaCut = 1.5;
           if(isVLA) docaCut = 15;
@@ -3433,8 +3434,8 @@ namespace tca {
             chgPull = (tp2.AveChg / tp1.AveChg - 1) / minChgRMS;
           }
           // open up the cuts on the last pass
-          float chgFracCut = tcc.vtx2DCuts[8];
-          float chgPullCut = tcc.chargeCuts[0];
+          float chgFracCut = tcx.tcc.vtx2DCuts[8];
+          float chgPullCut = tcx.tcc.chargeCuts[0];
           if(lastPass) {
             docaCut *= 2;
             chgFracCut *= 0.5;
@@ -3446,24 +3447,24 @@ namespace tca {
           bool showerTjs = tj1.PDGCode == 11 || tj2.PDGCode == 11;
           bool hiMCSMom = tj1.MCSMom > 200 || tj2.MCSMom > 200;
           // add a charge similarity requirement if not shower-like or low momentum or not LA
-          if(doMerge && !showerTjs && hiMCSMom && chgPull > tcc.chargeCuts[0] && !isVLA) doMerge = false;
+          if(doMerge && !showerTjs && hiMCSMom && chgPull > tcx.tcc.chargeCuts[0] && !isVLA) doMerge = false;
           // ignore the charge pull cut if both are high momentum and dang is really small
           if(!doMerge && tj1.MCSMom > 900 && tj2.MCSMom > 900 && dang < 0.1 && bestDOCA < docaCut) doMerge = true;
 
           // do not merge if chgPull is really high
           if(doMerge && chgPull > 2 * chgPullCut) doMerge = false;
-          float dwc = DeadWireCount(slc, tp1, tp2);
+          float dwc = DeadWireCount(tcx, slc, tp1, tp2);
 
           if(doMerge) {
             if(lastPass) {
               // last pass cuts are looser but ensure that the tj after merging meets the quality cut
-              float npwc = NumPtsWithCharge(slc, tj1, true) + NumPtsWithCharge(slc, tj2, true);
+              float npwc = NumPtsWithCharge(tcx, slc, tj1, true) + NumPtsWithCharge(tcx, slc, tj2, true);
               auto& tp1OtherEnd = tj1.Pts[tj1.EndPt[1 - end1]];
               auto& tp2OtherEnd = tj2.Pts[tj2.EndPt[1 - end2]];
               float nwires = std::abs(tp1OtherEnd.Pos[0] - tp2OtherEnd.Pos[0]);
               if(nwires == 0) nwires = 1;
               float hitFrac = npwc / nwires;
-              doMerge = (hitFrac > tcc.qualityCuts[0]);
+              doMerge = (hitFrac > tcx.tcc.qualityCuts[0]);
             } else {
               // don't merge if the gap between them is longer than the length of the shortest Tj
               if(len1 < len2) {
@@ -3478,12 +3479,12 @@ namespace tca {
           // Require a large charge fraction near a merge point
           tjlist[0] = slc.tjs[it1].ID;
           tjlist[1] = slc.tjs[it2].ID;
-          float chgFrac = ChgFracNearPos(slc, tp1.Pos, tjlist);
+          float chgFrac = ChgFracNearPos(tcx, slc, tp1.Pos, tjlist);
           if(doMerge && bestDOCA > 1 && chgFrac < chgFracCut) doMerge = false;
 
           // Check the MCSMom asymmetry and don't merge if it is higher than the user-specified cut
           float momAsym = std::abs(tj1.MCSMom - tj2.MCSMom) / (float)(tj1.MCSMom + tj2.MCSMom);
-          if(doMerge && momAsym > tcc.vtx2DCuts[9]) doMerge = false;
+          if(doMerge && momAsym > tcx.tcc.vtx2DCuts[9]) doMerge = false;
           if(doMerge && (tj1.EndFlag[end1][kAtKink] || tj2.EndFlag[end2][kAtKink])) {
             // don't merge if a kink exists and the tjs are not too long
             if(len1 < 40 && len2 < 40) doMerge = false;
@@ -3496,14 +3497,14 @@ namespace tca {
           bool doVtx = false;
           if(!doMerge) {
             // check for a significant kink
-            doVtx = (kinkSig > tcc.kinkCuts[1]);
+            doVtx = (kinkSig > tcx.tcc.kinkCuts[1]);
             // and a less significant kink but very close separation
-            doVtx = (kinkSig > 0.5 * tcc.kinkCuts[1] && sep < 2);
+            doVtx = (kinkSig > 0.5 * tcx.tcc.kinkCuts[1] && sep < 2);
           } // !doMerge
 
           if(prt) {
             mf::LogVerbatim myprt("TC");
-            myprt<<"  EM: T"<<slc.tjs[it1].ID<<"_"<<end1<<" - T"<<slc.tjs[it2].ID<<"_"<<end2<<" tp1-tp2 "<<PrintPos(slc, tp1)<<"-"<<PrintPos(slc, tp2);
+            myprt<<"  EM: T"<<slc.tjs[it1].ID<<"_"<<end1<<" - T"<<slc.tjs[it2].ID<<"_"<<end2<<" tp1-tp2 "<<PrintPos(tcx, slc, tp1)<<"-"<<PrintPos(tcx, slc, tp2);
             myprt<<" FOM "<<std::fixed<<std::setprecision(2)<<bestFOM;
             myprt<<" DOCA "<<std::setprecision(1)<<bestDOCA;
             myprt<<" cut "<<docaCut<<" isVLA? "<<isVLA;
@@ -3522,9 +3523,9 @@ namespace tca {
             if(prt) mf::LogVerbatim("TC")<<"  Merge ";
             bool didMerge = false;
             if(end1 == 1) {
-              didMerge = MergeAndStore(slc, it1, it2, tcc.dbgMrg);
+              didMerge = MergeAndStore(tcx, slc, it1, it2, tcx.tcc.dbgMrg);
             } else {
-              didMerge = MergeAndStore(slc, it2, it1, tcc.dbgMrg);
+              didMerge = MergeAndStore(tcx, slc, it2, it1, tcx.tcc.dbgMrg);
             }
             if(didMerge) {
               // Set the end merge flag for the killed trajectories to aid tracing merges
@@ -3553,10 +3554,10 @@ namespace tca {
               aVtx.PosErr[0] = std::abs(tp1.Pos[0] - tp2.Pos[0]);
               aVtx.PosErr[1] = std::abs(tp1.Pos[1] - tp2.Pos[1]);
             } else {
-              float sepCut = tcc.vtx2DCuts[1];
+              float sepCut = tcx.tcc.vtx2DCuts[1];
               bool tj1Short = (slc.tjs[it1].EndPt[1] - slc.tjs[it1].EndPt[0] < maxShortTjLen);
               bool tj2Short = (slc.tjs[it2].EndPt[1] - slc.tjs[it2].EndPt[0] < maxShortTjLen);
-              if(tj1Short || tj2Short) sepCut = tcc.vtx2DCuts[1];
+              if(tj1Short || tj2Short) sepCut = tcx.tcc.vtx2DCuts[1];
               TrajIntersection(tp1, tp2, aVtx.Pos);
               float dw = aVtx.Pos[0] - tp1.Pos[0];
               if(std::abs(dw) > sepCut) continue;
@@ -3589,7 +3590,7 @@ namespace tca {
             // We got this far. Try a vertex fit to ensure that the errors are reasonable
             slc.tjs[it1].VtxID[end1] = aVtx.ID;
             slc.tjs[it2].VtxID[end2] = aVtx.ID;
-            if(!aVtx.Stat[kFixed] && !FitVertex(slc, aVtx, prt)) {
+            if(!aVtx.Stat[kFixed] && !FitVertex(tcx, slc, aVtx, prt)) {
               // back out
               slc.tjs[it1].VtxID[end1] = 0;
               slc.tjs[it2].VtxID[end2] = 0;
@@ -3602,30 +3603,30 @@ namespace tca {
             tj1.AlgMod[kMerge] = true;
             tj2.AlgMod[kMerge] = true;
             if(!StoreVertex(slc, aVtx)) continue;
-            SetVx2Score(slc);
+            SetVx2Score(tcx, slc);
             if(prt) {
               auto& newVx = slc.vtxs[slc.vtxs.size() - 1];
-              mf::LogVerbatim("TC")<<"  New 2V"<<newVx.ID<<" at "<<(int)newVx.Pos[0]<<":"<<(int)(newVx.Pos[1]/tcc.unitsPerTick)<<" Score "<<newVx.Score;
+              mf::LogVerbatim("TC")<<"  New 2V"<<newVx.ID<<" at "<<(int)newVx.Pos[0]<<":"<<(int)(newVx.Pos[1]/tcx.tcc.unitsPerTick)<<" Score "<<newVx.Score;
             }
             // check the score and kill it if it is below the cut
             // BB Oct 1, 2019. Don't kill the vertex in this function since it is
             // called before short trajectories are reconstructed
             auto& newVx2 = slc.vtxs[slc.vtxs.size() - 1];
-            if(newVx2.Score < tcc.vtx2DCuts[7] && CompatibleMerge(slc, tj1, tj2, prt)) {
+            if(newVx2.Score < tcx.tcc.vtx2DCuts[7] && CompatibleMerge(tcx, slc, tj1, tj2, prt)) {
               if(prt) {
                 mf::LogVerbatim myprt("TC");
-                myprt<<"  Bad vertex: Bad score? "<<(newVx2.Score < tcc.vtx2DCuts[7]);
-                myprt<<" cut "<<tcc.vtx2DCuts[7];
-                myprt<<" CompatibleMerge? "<<CompatibleMerge(slc, tj1, tj2, prt);
+                myprt<<"  Bad vertex: Bad score? "<<(newVx2.Score < tcx.tcc.vtx2DCuts[7]);
+                myprt<<" cut "<<tcx.tcc.vtx2DCuts[7];
+                myprt<<" CompatibleMerge? "<<CompatibleMerge(tcx, slc, tj1, tj2, prt);
               }
               slc.tjs[it1].VtxID[end1] = 0;
               slc.tjs[it2].VtxID[end2] = 0;
-              MakeVertexObsolete("EM", slc, newVx2, true);
+              MakeVertexObsolete("EM", tcx, slc, newVx2, true);
               bool didMerge = false;
               if(end1 == 1) {
-                didMerge = MergeAndStore(slc, it1, it2, tcc.dbgMrg);
+                didMerge = MergeAndStore(tcx, slc, it1, it2, tcx.tcc.dbgMrg);
               } else {
-                didMerge = MergeAndStore(slc, it2, it1, tcc.dbgMrg);
+                didMerge = MergeAndStore(tcx, slc, it2, it1, tcx.tcc.dbgMrg);
               }
               if(didMerge) {
                 // Set the end merge flag for the killed trajectories to aid tracing merges
@@ -3646,7 +3647,7 @@ namespace tca {
   } // EndMerge
 
   //////////////////////////////////////////
-  void MaskTrajEndPoints(TCSlice& slc, Trajectory& tj, unsigned short nPts)
+  void MaskTrajEndPoints(TCContext& tcx, TCSlice& slc, Trajectory& tj, unsigned short nPts)
   {
 
     // Masks off (sets all hits not-Used) nPts trajectory points at the leading edge of the
@@ -3666,7 +3667,7 @@ namespace tca {
     // find the last good point (with charge)
     unsigned short lastGoodPt = USHRT_MAX ;
 
-    if(tcc.dbgStp) {
+    if(tcx.tcc.dbgStp) {
       mf::LogVerbatim("TC")<<"MTEP: lastGoodPt "<<lastGoodPt<<" Pts size "<<tj.Pts.size()<<" tj.IsGood "<<tj.IsGood;
     }
     if(lastGoodPt == USHRT_MAX) return;
@@ -3689,18 +3690,18 @@ namespace tca {
         float dw = tj.Pts[ipt].Pos[0] - tj.Pts[lastGoodPt].Pos[0];
         // Correct the projected time to the wire
         float newpos = tj.Pts[lastGoodPt].Pos[1] + dw * tj.Pts[ipt].Dir[1] / tj.Pts[ipt].Dir[0];
-        if(tcc.dbgStp) mf::LogVerbatim("TC")<<"MTEP: ipt "<<ipt<<" Pos[0] "<<tj.Pts[ipt].Pos[0]<<". Move Pos[1] from "<<tj.Pts[ipt].Pos[1]<<" to "<<newpos;
+        if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<"MTEP: ipt "<<ipt<<" Pos[0] "<<tj.Pts[ipt].Pos[0]<<". Move Pos[1] from "<<tj.Pts[ipt].Pos[1]<<" to "<<newpos;
         tj.Pts[ipt].Pos[1] = tj.Pts[lastGoodPt].Pos[1] + dw * tj.Pts[ipt].Dir[1] / tj.Pts[ipt].Dir[0];
       }
-      tj.Pts[ipt].Delta = PointTrajDOCA(slc, tj.Pts[ipt].HitPos[0], tj.Pts[ipt].HitPos[1], tj.Pts[ipt]);
-      if(tcc.dbgStp) mf::LogVerbatim("TC")<<" masked ipt "<<ipt<<" Pos "<<PrintPos(slc, tj.Pts[ipt])<<" Chg "<<tj.Pts[ipt].Chg;
+      tj.Pts[ipt].Delta = PointTrajDOCA(tcx, slc, tj.Pts[ipt].HitPos[0], tj.Pts[ipt].HitPos[1], tj.Pts[ipt]);
+      if(tcx.tcc.dbgStp) mf::LogVerbatim("TC")<<" masked ipt "<<ipt<<" Pos "<<PrintPos(tcx, slc, tj.Pts[ipt])<<" Chg "<<tj.Pts[ipt].Chg;
     } // ii
     SetEndPoints(tj);
 
   } // MaskTrajEndPoints
 
   ////////////////////////////////////////////////
-  void ChkStop(TCSlice& slc, Trajectory& tj)
+  void ChkStop(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Sets the EndFlag[kBragg] bits on the trajectory by identifying the Bragg peak
     // at each end. This function checks both ends, finding the point with the highest charge nearest the
@@ -3711,21 +3712,21 @@ namespace tca {
 
     tj.EndFlag[0][kBragg] = false;
     tj.EndFlag[1][kBragg] = false;
-    if(!tcc.useAlg[kChkStop]) return;
-    if(tcc.chkStopCuts[0] < 0) return;
+    if(!tcx.tcc.useAlg[kChkStop]) return;
+    if(tcx.tcc.chkStopCuts[0] < 0) return;
 
     if(tj.Strategy[kStiffEl]) return;
 
     // ignore trajectories that are very large angle at both ends
     if(tj.Pts[tj.EndPt[0]].AngleCode == 2 || tj.Pts[tj.EndPt[1]].AngleCode == 2) return;
 
-    unsigned short nPtsToCheck = tcc.chkStopCuts[1];
+    unsigned short nPtsToCheck = tcx.tcc.chkStopCuts[1];
     if(tj.Pts.size() < 6) return;
 
-    bool prt = (tcc.dbgStp || tcc.dbgAlg[kChkStop]);
+    bool prt = (tcx.tcc.dbgStp || tcx.tcc.dbgAlg[kChkStop]);
 
     if(prt) {
-      mf::LogVerbatim("TC")<<"ChkStop: T"<<tj.ID<<" requiring "<<nPtsToCheck<<" points with charge slope > "<<tcc.chkStopCuts[0]<<" Chg/WSEU";
+      mf::LogVerbatim("TC")<<"ChkStop: T"<<tj.ID<<" requiring "<<nPtsToCheck<<" points with charge slope > "<<tcx.tcc.chkStopCuts[0]<<" Chg/WSEU";
     }
 
     // find the highest charge hit in the first 3 points at each end
@@ -3763,7 +3764,8 @@ namespace tca {
       Vector2_t outVec, outVecErr;
       float chgErr, chiDOF;
       // Initialize
-      Fit2D(0, inPt, chgErr, outVec, outVecErr, chiDOF);
+      Fit2DSums fit;
+      Fit2D(fit, 0, inPt, chgErr, outVec, outVecErr, chiDOF);
       unsigned short cnt = 0;
       for(unsigned short ii = 0; ii < tj.Pts.size(); ++ii) {
         short ipt = hiPt + ii * dir;
@@ -3778,19 +3780,19 @@ namespace tca {
         inPt[1] = tp.Chg;
         // Assume 20% point-to-point charge fluctuations
         chgErr = 0.2 * tp.Chg;
-        if(!Fit2D(2, inPt, chgErr, outVec, outVecErr, chiDOF)) break;
+        if(!Fit2D(fit, 2, inPt, chgErr, outVec, outVecErr, chiDOF)) break;
         ++cnt;
         if(cnt == nPtsToCheck) break;
       } // ii
       if(cnt < nPtsToCheck) continue;
       // do the fit and get the results
-      if(!Fit2D(-1, inPt, chgErr, outVec, outVecErr, chiDOF)) continue;
+      if(!Fit2D(fit, -1, inPt, chgErr, outVec, outVecErr, chiDOF)) continue;
       // check for really bad chidof indicating a major failure
       if(chiDOF > 500) continue;
       // The charge slope is negative for a stopping track in the way that the fit was constructed.
       // Flip the sign so we can make a cut against tcc.chkStopCuts[0] which is positive.
       outVec[1] = -outVec[1];
-      bool itStops = (outVec[1] > tcc.chkStopCuts[0] && chiDOF < tcc.chkStopCuts[2] && outVec[1] > 2.5 * outVecErr[1]);
+      bool itStops = (outVec[1] > tcx.tcc.chkStopCuts[0] && chiDOF < tcx.tcc.chkStopCuts[2] && outVec[1] > 2.5 * outVecErr[1]);
       if(itStops) {
         tj.EndFlag[end][kBragg] = true;
         tj.AlgMod[kChkStop] = true;
@@ -3806,12 +3808,12 @@ namespace tca {
   } // ChkStop
 
   //////////////////////TY://////////////////////////
-  bool ChkMichel(TCSlice& slc, Trajectory& tj, unsigned short& lastGoodPt){
+  bool ChkMichel(TCContext& tcx, TCSlice& slc, Trajectory& tj, unsigned short& lastGoodPt){
 
-    if(!tcc.useAlg[kMichel]) return false;
+    if(!tcx.tcc.useAlg[kMichel]) return false;
     if(tj.PDGCode == 11 || tj.PDGCode == 111) return false;
 
-    bool prt = (tcc.dbgStp || tcc.dbgAlg[kMichel]);
+    bool prt = (tcx.tcc.dbgStp || tcx.tcc.dbgAlg[kMichel]);
 
     //find number of hits that are consistent with Michel electron
     unsigned short nmichelhits = 0;
@@ -3863,15 +3865,15 @@ namespace tca {
   }
 
   //////////////////////////////////////////
-  bool MakeJunkTraj(TCSlice& slc, std::vector<unsigned int> tHits)
+  bool MakeJunkTraj(TCContext& tcx, TCSlice& slc, std::vector<unsigned int> tHits)
   {
-    if(!tcc.useAlg[kJunkTj]) return false;
+    if(!tcx.tcc.useAlg[kJunkTj]) return false;
     // Make a crummy trajectory using the provided hits
 
     if(tHits.size() < 2) return false;
 
     bool prt = false;
-    if(tcc.dbgAlg[kJunkTj]) {
+    if(tcx.tcc.dbgAlg[kJunkTj]) {
       for(unsigned short ii = 0; ii < tHits.size(); ++ii) {
         if(slc.slHits[tHits[ii]].allHitsIndex == debug.Hit) {
           prt = true;
@@ -3884,15 +3886,15 @@ namespace tca {
     // Start the trajectory using the first and last hits to
     // define a starting direction. Use the last pass settings
     Trajectory work;
-    unsigned short pass = tcc.minPts.size() - 1;
-    if(!StartTraj(slc, work, tHits[0], tHits[tHits.size()-1], pass)) return false;
+    unsigned short pass = tcx.tcc.minPts.size() - 1;
+    if(!StartTraj(tcx, slc, work, tHits[0], tHits[tHits.size()-1], pass)) return false;
     // make a TP for every hit
     work.Pts.resize(tHits.size());
     // and put a hit into each one
     for(unsigned short ii = 0; ii < tHits.size(); ++ii) {
       auto& tp = work.Pts[ii];
       unsigned int iht = tHits[ii];
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       tp.CTP = EncodeCTP(hit.WireID());
       if(tp.CTP != work.CTP) return false;
       tp.Hits.push_back(iht);
@@ -3900,7 +3902,7 @@ namespace tca {
       // don't use DefineHitPos here because the angle isn't really known yet. Just
       // define enough information to do a fit
       tp.HitPos[0] = hit.WireID().Wire;
-      tp.HitPos[1] = hit.PeakTime() * tcc.unitsPerTick;
+      tp.HitPos[1] = hit.PeakTime() * tcx.tcc.unitsPerTick;
       tp.HitPosErr2 = 100;
       tp.Chg = hit.Integral();
       tp.Step = ii;
@@ -3911,7 +3913,7 @@ namespace tca {
     work.EndPt[0] = 0;
     work.EndPt[1] = tHits.size() - 1;
     // do an initial fit. The fit results are put in the last TP.
-    FitTraj(slc, work);
+    FitTraj(tcx, slc, work);
     auto& lastTP = work.Pts.back();
     // Prepare to sort along the general direction. First find the
     // along and transverse position (Delta) of each TP and calculate DeltaRMS
@@ -3963,15 +3965,15 @@ namespace tca {
     sum = work.TotChg / (double)ntps.size();
     if(work.NeedsUpdate) {
       work.EndPt[1] = work.Pts.size() - 1;
-      UpdateTraj(slc, work);
+      UpdateTraj(tcx, slc, work);
     } // needs update
     work.AlgMod[kJunkTj] = true;
     work.IsGood = true;
     if(prt) {
-      PrintTrajectory("MJT", slc, work, USHRT_MAX);
+      PrintTrajectory("MJT", tcx, slc, work, USHRT_MAX);
     }
     // Store it
-    return StoreTraj(slc, work);
+    return StoreTraj(tcx, slc, work);
   } // MakeJunkTraj
 
 } // namespace tca
@@ -27,6 +27,7 @@ namespace tca {
   ////////////////////////////////////////////////
   void
   SaveCRInfo(detinfo::DetectorClocksData const& clockData,
+             TCContext& tcx,
              TCSlice& slc,
              PFPStruct& pfp,
              bool prt,
@@ -34,10 +35,10 @@ namespace tca {
   {
 
     //Check the origin of pfp
-    if (tcc.modes[kSaveCRTree]) {
+    if (tcx.tcc.modes[kSaveCRTree]) {
       if (fIsRealData) { slc.crt.cr_origin.push_back(-1); }
       else {
-        slc.crt.cr_origin.push_back(GetOrigin(clockData, slc, pfp));
+        slc.crt.cr_origin.push_back(GetOrigin(clockData, tcx, slc, pfp));
       }
     }
 
@@ -48,7 +49,7 @@ namespace tca {
     slc.crt.cr_pfpxmax.push_back(std::max(startPos[0], endPos[0]));
 
     //find max
-    const geo::TPCGeo& tpc = tcc.geom->TPC(0);
+    const geo::TPCGeo& tpc = tcx.tcc.geom->TPC(0);
     float mindis0 = FLT_MAX;
     float mindis1 = FLT_MAX;
     if (std::abs(startPos[1] - tpc.MinY()) < mindis0) mindis0 = std::abs(startPos[1] - tpc.MinY());
@@ -72,7 +73,10 @@ namespace tca {
 
   ////////////////////////////////////////////////
   int
-  GetOrigin(detinfo::DetectorClocksData const& clockData, TCSlice& slc, PFPStruct& pfp)
+  GetOrigin(detinfo::DetectorClocksData const& clockData,
+            TCContext& tcx,
+            TCSlice& slc,
+            PFPStruct& pfp)
   {
 
     art::ServiceHandle<cheat::BackTrackerService const> bt_serv;
@@ -88,8 +92,8 @@ namespace tca {
           if (!tp.UseHit[ii]) continue;
           unsigned int iht = tp.Hits[ii];
           TCHit& slhit = slc.slHits[iht];
-          auto& hit = (*evt.allHits)[slhit.allHitsIndex];
-          raw::ChannelID_t channel = tcc.geom->PlaneWireToChannel((int)hit.WireID().Plane,
+          auto& hit = (*tcx.evt.allHits)[slhit.allHitsIndex];
+          raw::ChannelID_t channel = tcx.tcc.geom->PlaneWireToChannel((int)hit.WireID().Plane,
                                                                   (int)hit.WireID().Wire,
                                                                   (int)hit.WireID().TPC,
                                                                   (int)hit.WireID().Cryostat);
@@ -15,14 +15,19 @@ namespace detinfo {
 namespace tca {
 
   struct PFPStruct;
+  struct TCContext;
   struct TCSlice;
 
   void SaveCRInfo(detinfo::DetectorClocksData const& clockData,
+                  TCContext& tcx,
                   TCSlice& tcs,
                   PFPStruct& ms,
                   bool prt,
                   bool fIsRealData);
-  int GetOrigin(detinfo::DetectorClocksData const& clockData, TCSlice& tcs, PFPStruct& ms);
+  int GetOrigin(detinfo::DetectorClocksData const& clockData,
+                TCContext& tcx,
+                TCSlice& tcs,
+                PFPStruct& ms);
   void ClearCRInfo(TCSlice& tcs);
 }
 
@@ -11,11 +11,11 @@
 
 namespace tca {
 
-  void SaveTjInfo(TCSlice& slc, std::vector<std::vector<int>>& tjList,
+  void SaveTjInfo(TCContext& tcx, TCSlice& slc, std::vector<std::vector<int>>& tjList,
                   std::string stageName) {
-    if(!tcc.modes[kSaveShowerTree]) return;
+    if(!tcx.tcc.modes[kSaveShowerTree]) return;
     if(tjList.empty()) return;
-    int stageNum = GetStageNum(stv, stageName);
+    int stageNum = GetStageNum(tcx.stv, stageName);
 
     // get the CTP from the first tj
     CTP_t inCTP = slc.tjs[tjList[0][0] - 1].CTP;
@@ -24,7 +24,7 @@ namespace tca {
       if(tj1.CTP != inCTP) continue;
       if(tj1.AlgMod[kKilled]) continue;
 
-      SaveTjInfoStuff(slc, tj1,  stageNum, stageName);
+      SaveTjInfoStuff(tcx, slc, tj1,  stageNum, stageName);
 
       int trajID = tj1.ID;
       bool inShower = false;
@@ -34,7 +34,7 @@ namespace tca {
         for (size_t l2 = 0; l2 < tjList[l1].size(); ++l2) {
 
           if (trajID == tjList[l1][l2]) {
-            stv.ShowerID.back() = l1;
+            tcx.stv.ShowerID.back() = l1;
             inShower = true;
             break;
           }
@@ -45,17 +45,17 @@ namespace tca {
     // envelopes are defined once DefineShower is called
     // fill four times, one for each side of polygon
     for (int i = 0; i < 8; i++) {
-      stv.Envelope.push_back(-999);
-      stv.EnvStage.push_back(stageNum);
-      stv.EnvPlane.push_back(-1);
-      stv.EnvShowerID.push_back(-1);
+      tcx.stv.Envelope.push_back(-999);
+      tcx.stv.EnvStage.push_back(stageNum);
+      tcx.stv.EnvPlane.push_back(-1);
+      tcx.stv.EnvShowerID.push_back(-1);
     }
 
   } // SaveTjInfo (tjlist)
 
-  void SaveTjInfo(TCSlice& slc, const ShowerStruct& ss, std::string stageName) {
-    if(!tcc.modes[kSaveShowerTree]) return;
-    int stageNum = GetStageNum(stv, stageName);
+  void SaveTjInfo(TCContext& tcx, TCSlice& slc, const ShowerStruct& ss, std::string stageName) {
+    if(!tcx.tcc.modes[kSaveShowerTree]) return;
+    int stageNum = GetStageNum(tcx.stv, stageName);
 
     // killed shower?
     if(ss.ID == 0) return;
@@ -74,40 +74,40 @@ namespace tca {
       // for this particular stage and plane
       int tjIndex = -1;
       bool isShowerTj = false;
-      for (size_t i = 0; i < stv.TjID.size(); ++i) {
-        if (stv.StageNum.at(i) != (int)stageNum) continue;
-        if (stv.PlaneNum.at(i) != (short)DecodeCTP(ss.CTP).Plane) continue;
+      for (size_t i = 0; i < tcx.stv.TjID.size(); ++i) {
+        if (tcx.stv.StageNum.at(i) != (int)stageNum) continue;
+        if (tcx.stv.PlaneNum.at(i) != (short)DecodeCTP(ss.CTP).Plane) continue;
 
-        if (stv.TjID.at(i) == trajID) {
+        if (tcx.stv.TjID.at(i) == trajID) {
           tjIndex = i;
-          if (stv.IsShowerTj.at(tjIndex) == 1) isShowerTj = true;
+          if (tcx.stv.IsShowerTj.at(tjIndex) == 1) isShowerTj = true;
           //beenDoneBefore = true;
           break;
         }
       }
 
       if (isShowerTj) continue;
-      if (tjIndex == -1) SaveTjInfoStuff(slc, tj1, stageNum, stageName);
+      if (tjIndex == -1) SaveTjInfoStuff(tcx, slc, tj1, stageNum, stageName);
 
       for (size_t i = 0; i < ss.TjIDs.size(); ++i) {
         if (trajID == ss.TjIDs[i]) {
           noMatch = false;
-          if (tjIndex == -1) stv.ShowerID.back() = ss.ID;
-          else stv.ShowerID.at(tjIndex) = ss.ID;
+          if (tjIndex == -1) tcx.stv.ShowerID.back() = ss.ID;
+          else tcx.stv.ShowerID.at(tjIndex) = ss.ID;
         }
 
-        if (it1 == (ss.ShowerTjID - 1)) stv.IsShowerTj.back() = 1;
-        else if (tj1.AlgMod[kShowerTj]) stv.IsShowerTj.back() = 1; // this is a better check
+        if (it1 == (ss.ShowerTjID - 1)) tcx.stv.IsShowerTj.back() = 1;
+        else if (tj1.AlgMod[kShowerTj]) tcx.stv.IsShowerTj.back() = 1; // this is a better check
         // check if tj is shower parent. if so, add to ttree
         // and mark parent flag
         if (trajID == ss.ParentID) {
           if (tjIndex == -1) {
-            stv.ShowerID.back() = ss.ID;
-            stv.IsShowerParent.back() = 1;
+            tcx.stv.ShowerID.back() = ss.ID;
+            tcx.stv.IsShowerParent.back() = 1;
           }
           else {
-            stv.ShowerID.at(tjIndex) = ss.ID;
-            stv.IsShowerParent.at(tjIndex) = 1;
+            tcx.stv.ShowerID.at(tjIndex) = ss.ID;
+            tcx.stv.IsShowerParent.at(tjIndex) = 1;
           }
           break;
 
@@ -121,73 +121,77 @@ namespace tca {
     geo::PlaneID iPlnID = DecodeCTP(ss.CTP);
 
     for (int i = 0; i < 8; i++) {
-      stv.EnvStage.push_back(stageNum);
-      stv.EnvPlane.push_back(iPlnID.Plane);
-      stv.EnvShowerID.push_back(ss.ID);
+      tcx.stv.EnvStage.push_back(stageNum);
+      tcx.stv.EnvPlane.push_back(iPlnID.Plane);
+      tcx.stv.EnvShowerID.push_back(ss.ID);
     }
 
-    stv.Envelope.push_back(ss.Envelope[0][0]);
-    stv.Envelope.push_back(ss.Envelope[0][1]/tcc.unitsPerTick);
-    stv.Envelope.push_back(ss.Envelope[1][0]);
-    stv.Envelope.push_back(ss.Envelope[1][1]/tcc.unitsPerTick);
-    stv.Envelope.push_back(ss.Envelope[2][0]);
-    stv.Envelope.push_back(ss.Envelope[2][1]/tcc.unitsPerTick);
-    stv.Envelope.push_back(ss.Envelope[3][0]);
-    stv.Envelope.push_back(ss.Envelope[3][1]/tcc.unitsPerTick);
+    tcx.stv.Envelope.push_back(ss.Envelope[0][0]);
+    tcx.stv.Envelope.push_back(ss.Envelope[0][1]/tcx.tcc.unitsPerTick);
+    tcx.stv.Envelope.push_back(ss.Envelope[1][0]);
+    tcx.stv.Envelope.push_back(ss.Envelope[1][1]/tcx.tcc.unitsPerTick);
+    tcx.stv.Envelope.push_back(ss.Envelope[2][0]);
+    tcx.stv.Envelope.push_back(ss.Envelope[2][1]/tcx.tcc.unitsPerTick);
+    tcx.stv.Envelope.push_back(ss.Envelope[3][0]);
+    tcx.stv.Envelope.push_back(ss.Envelope[3][1]/tcx.tcc.unitsPerTick);
 
   } // SaveTjInfo (cots)
 
-  void SaveTjInfoStuff(TCSlice& slc, Trajectory& tj, int stageNum, std::string stageName) {
-    if(!tcc.modes[kSaveShowerTree]) return;
+  void SaveTjInfoStuff(TCContext& tcx,
+                       TCSlice& slc,
+                       Trajectory& tj,
+                       int stageNum,
+                       std::string stageName) {
+    if(!tcx.tcc.modes[kSaveShowerTree]) return;
 
     TrajPoint& beginPoint = tj.Pts[tj.EndPt[0]];
     TrajPoint& endPoint = tj.Pts[tj.EndPt[1]];
 
-    stv.BeginWir.push_back(std::nearbyint(beginPoint.Pos[0]));
-    stv.BeginTim.push_back(std::nearbyint(beginPoint.Pos[1]/tcc.unitsPerTick));
-    stv.BeginAng.push_back(beginPoint.Ang);
-    stv.BeginChg.push_back(beginPoint.Chg);
-    stv.BeginVtx.push_back(tj.VtxID[0]);
-
-    stv.EndWir.push_back(std::nearbyint(endPoint.Pos[0]));
-    stv.EndTim.push_back(std::nearbyint(endPoint.Pos[1]/tcc.unitsPerTick));
-    stv.EndAng.push_back(endPoint.Ang);
-    stv.EndChg.push_back(endPoint.Chg);
-    stv.EndVtx.push_back(tj.VtxID[1]);
-
-    stv.MCSMom.push_back(tj.MCSMom);
-    stv.TjID.push_back(tj.ID);
-    stv.IsShowerTj.push_back(-1);
-
-    stv.ShowerID.push_back(-1);
-    stv.IsShowerParent.push_back(-1);
-    stv.StageNum.push_back(stageNum);
-    stv.nStages = stageNum;
+    tcx.stv.BeginWir.push_back(std::nearbyint(beginPoint.Pos[0]));
+    tcx.stv.BeginTim.push_back(std::nearbyint(beginPoint.Pos[1]/tcx.tcc.unitsPerTick));
+    tcx.stv.BeginAng.push_back(beginPoint.Ang);
+    tcx.stv.BeginChg.push_back(beginPoint.Chg);
+    tcx.stv.BeginVtx.push_back(tj.VtxID[0]);
+
+    tcx.stv.EndWir.push_back(std::nearbyint(endPoint.Pos[0]));
+    tcx.stv.EndTim.push_back(std::nearbyint(endPoint.Pos[1]/tcx.tcc.unitsPerTick));
+    tcx.stv.EndAng.push_back(endPoint.Ang);
+    tcx.stv.EndChg.push_back(endPoint.Chg);
+    tcx.stv.EndVtx.push_back(tj.VtxID[1]);
+
+    tcx.stv.MCSMom.push_back(tj.MCSMom);
+    tcx.stv.TjID.push_back(tj.ID);
+    tcx.stv.IsShowerTj.push_back(-1);
+
+    tcx.stv.ShowerID.push_back(-1);
+    tcx.stv.IsShowerParent.push_back(-1);
+    tcx.stv.StageNum.push_back(stageNum);
+    tcx.stv.nStages = stageNum;
     geo::PlaneID iPlnID = DecodeCTP(tj.CTP);
-    stv.PlaneNum.push_back(iPlnID.Plane);
+    tcx.stv.PlaneNum.push_back(iPlnID.Plane);
 
-    stv.nPlanes = slc.nPlanes;
+    tcx.stv.nPlanes = slc.nPlanes;
 
   } // SaveTjInfoStuff
 
   ////////////////////////////////////////////////
-  void SaveAllCots(TCSlice& slc, const CTP_t& inCTP, std::string someText) {
-    if(!tcc.modes[kSaveShowerTree]) return;
+  void SaveAllCots(TCContext& tcx, TCSlice& slc, const CTP_t& inCTP, std::string someText) {
+    if(!tcx.tcc.modes[kSaveShowerTree]) return;
     for(unsigned short cotIndex = 0; cotIndex < slc.cots.size(); ++cotIndex) {
       auto& ss = slc.cots[cotIndex];
       if (ss.CTP != inCTP) continue;
       if(ss.ID == 0) continue;
-      SaveTjInfo(slc, ss, someText);
+      SaveTjInfo(tcx, slc, ss, someText);
     } // cotIndex
   } // SaveAllCots
 
 
-  void SaveAllCots(TCSlice& slc, std::string someText) {
-    if(!tcc.modes[kSaveShowerTree]) return;
+  void SaveAllCots(TCContext& tcx, TCSlice& slc, std::string someText) {
+    if(!tcx.tcc.modes[kSaveShowerTree]) return;
     for(unsigned short cotIndex = 0; cotIndex < slc.cots.size(); ++cotIndex) {
       auto& ss = slc.cots[cotIndex];
       if(ss.ID == 0) continue;
-      SaveTjInfo(slc, ss, someText);
+      SaveTjInfo(tcx, slc, ss, someText);
     } // cotIndex
   }
 
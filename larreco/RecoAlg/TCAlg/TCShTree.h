@@ -18,11 +18,18 @@
 
 namespace tca {
 
-  void SaveTjInfo(TCSlice& slc, std::vector<std::vector<int>>& tjList, std::string stageName);
-  void SaveTjInfo(TCSlice& slc, const ShowerStruct& ss, std::string stageName);
-  void SaveTjInfoStuff(TCSlice& slc, Trajectory& tj, int stageNum, std::string stageName);
-  void SaveAllCots(TCSlice& slc, const CTP_t& inCTP, std::string someText);
-  void SaveAllCots(TCSlice& slc, std::string someText);
+  void SaveTjInfo(TCContext& tcx,
+                  TCSlice& slc,
+                  std::vector<std::vector<int>>& tjList,
+                  std::string stageName);
+  void SaveTjInfo(TCContext& tcx, TCSlice& slc, const ShowerStruct& ss, std::string stageName);
+  void SaveTjInfoStuff(TCContext& tcx,
+                       TCSlice& slc,
+                       Trajectory& tj,
+                       int stageNum,
+                       std::string stageName);
+  void SaveAllCots(TCContext& tcx, TCSlice& slc, const CTP_t& inCTP, std::string someText);
+  void SaveAllCots(TCContext& tcx, TCSlice& slc, std::string someText);
   int GetStageNum(ShowerTreeVars& stv, std::string stageName);
   void ClearShowerTree(ShowerTreeVars& stv);
 
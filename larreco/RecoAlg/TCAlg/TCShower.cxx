@@ -58,6 +58,7 @@ namespace tca {
   ////////////////////////////////////////////////
   bool
   FindShowerStart(detinfo::DetectorPropertiesData const& detProp,
+                  TCContext& tcx,
                   TCSlice& slc,
                   ShowerStruct3D& ss3,
                   bool prt)
@@ -87,7 +88,7 @@ namespace tca {
       auto& ss = slc.cots[cid - 1];
       // Find the position, direction and projection in this plane
       auto& stj = slc.tjs[ss.ShowerTjID - 1];
-      auto chgCtrTP = MakeBareTP(detProp, slc, ss3.ChgPos, ss3.Dir, stj.CTP);
+      auto chgCtrTP = MakeBareTP(detProp, tcx, slc, ss3.ChgPos, ss3.Dir, stj.CTP);
       // projection too small in this view?
       if (chgCtrTP.Delta < 0.5) continue;
       auto& startTP = stj.Pts[0];
@@ -111,14 +112,14 @@ namespace tca {
     unsigned short useCID = useParentCID;
     if (useCID == 0) {
       useCID = usePtSepCID;
-      if (!dirOK) ReverseShower("FSS", slc, useCID, prt);
+      if (!dirOK) ReverseShower("FSS", tcx, slc, useCID, prt);
     }
 
     // now define the start and length
     auto& ss = slc.cots[useCID - 1];
     auto& stj = slc.tjs[ss.ShowerTjID - 1];
 
-    auto chgCtrTP = MakeBareTP(detProp, slc, ss3.ChgPos, ss3.Dir, stj.CTP);
+    auto chgCtrTP = MakeBareTP(detProp, tcx, slc, ss3.ChgPos, ss3.Dir, stj.CTP);
     if (ss3.Vx3ID > 0) {
       auto& vx3 = slc.vtx3s[ss3.Vx3ID - 1];
       ss3.Start[0] = vx3.X;
@@ -130,14 +131,14 @@ namespace tca {
       auto& startTP = stj.Pts[0];
       // The 2D separation btw the shower start and the shower center, converted
       // to the 3D separation
-      float sep = tcc.wirePitch * PosSep(startTP.Pos, stj.Pts[1].Pos) / chgCtrTP.Delta;
+      float sep = tcx.tcc.wirePitch * PosSep(startTP.Pos, stj.Pts[1].Pos) / chgCtrTP.Delta;
       // set the start position
       for (unsigned short xyz = 0; xyz < 3; ++xyz)
         ss3.Start[xyz] = ss3.ChgPos[xyz] - sep * ss3.Dir[xyz];
     }
     // now do the end position
     auto& endTP = stj.Pts[2];
-    float sep = tcc.wirePitch * PosSep(endTP.Pos, chgCtrTP.Pos) / chgCtrTP.Delta;
+    float sep = tcx.tcc.wirePitch * PosSep(endTP.Pos, chgCtrTP.Pos) / chgCtrTP.Delta;
     for (unsigned short xyz = 0; xyz < 3; ++xyz)
       ss3.End[xyz] = ss3.ChgPos[xyz] + sep * ss3.Dir[xyz];
     ss3.Len = PosSep(ss3.Start, ss3.End);
@@ -151,7 +152,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  Finish3DShowers(TCSlice& slc)
+  Finish3DShowers(TCContext& tcx, TCSlice& slc)
   {
     // Finish defining the showers, create a companion PFParticle for each one.
     // Note to the reader: This code doesn't use MakeVertexObsolete to kill vertices using the assumption
@@ -205,8 +206,8 @@ namespace tca {
         auto& dtrPFP = slc.pfps[ss3.ParentID - 1];
         if (dtrPFP.ParentUID > 0) {
           // Transfer the daughter <-> parent assn
-          auto slcIndx = GetSliceIndex("P", dtrPFP.ParentUID);
-          auto& parPFP = slices[slcIndx.first].pfps[slcIndx.second];
+          auto slcIndx = GetSliceIndex(tcx, "P", dtrPFP.ParentUID);
+          auto& parPFP = tcx.slices[slcIndx.first].pfps[slcIndx.second];
           showerPFP.ParentUID = parPFP.UID;
           std::replace(parPFP.DtrUIDs.begin(), parPFP.DtrUIDs.end(), dtrPFP.UID, showerPFP.UID);
           dtrPFP.ParentUID = 0;
@@ -284,20 +285,20 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  FindShowers3D(detinfo::DetectorPropertiesData const& detProp, TCSlice& slc)
+  FindShowers3D(detinfo::DetectorPropertiesData const& detProp, TCContext& tcx, TCSlice& slc)
   {
     // Find 2D showers using 3D-matched trajectories. This returns true if showers were found
     // which requires re-doing the 3D trajectory match
 
-    bool reconstruct = (tcc.showerTag[0] == 2) || (tcc.showerTag[0] == 4);
+    bool reconstruct = (tcx.tcc.showerTag[0] == 2) || (tcx.tcc.showerTag[0] == 4);
     if (!reconstruct) return false;
 
-    bool prt2S = (tcc.dbgSlc && tcc.dbg2S);
-    bool prt3S = (tcc.dbgSlc && tcc.dbg3S);
+    bool prt2S = (tcx.tcc.dbgSlc && tcx.tcc.dbg2S);
+    bool prt3S = (tcx.tcc.dbgSlc && tcx.tcc.dbg3S);
 
     std::string fcnLabel = "FS";
 
-    geo::TPCGeo const& TPC = tcc.geom->TPC(slc.TPCID);
+    geo::TPCGeo const& TPC = tcx.tcc.geom->TPC(slc.TPCID);
     // check for already-existing showers
     for (unsigned short plane = 0; plane < TPC.Nplanes(); ++plane) {
       CTP_t inCTP = EncodeCTP(slc.TPCID.Cryostat, slc.TPCID.TPC, plane);
@@ -306,8 +307,8 @@ namespace tca {
     }
 
     if (prt2S) {
-      PrintPFPs("FSi", slc);
-      PrintAllTraj(detProp, "FSi", slc, USHRT_MAX, 0);
+      PrintPFPs("FSi", tcx, slc);
+      PrintAllTraj(detProp, "FSi", tcx, slc, USHRT_MAX, 0);
     }
 
     // lists of Tj IDs in plane, (list1, list2, list3, ...)
@@ -316,7 +317,7 @@ namespace tca {
       std::vector<std::vector<int>> tjList;
       // Make lists of lists of ShowerLike tjs that will become showers
       //      FindCots(fcnLabel, slc, inCTP, tjList, prt2S);
-      SaveTjInfo(slc, tjList, "TJL");
+      SaveTjInfo(tcx, slc, tjList, "TJL");
       if (tjList.empty()) continue;
       bigList[plane] = tjList;
     } // plane
@@ -339,9 +340,9 @@ namespace tca {
         }
         auto ss = CreateSS(slc, tjl);
         if (ss.ID == 0) continue;
-        if (!UpdateShower(fcnLabel, slc, ss, prtCTP)) continue;
-        SaveTjInfo(slc, ss, "DS");
-        FindNearbyTjs(fcnLabel, slc, ss, prtCTP);
+        if (!UpdateShower(fcnLabel, tcx, slc, ss, prtCTP)) continue;
+        SaveTjInfo(tcx, slc, ss, "DS");
+        FindNearbyTjs(fcnLabel, tcx, slc, ss, prtCTP);
         // don't try to do anything else here until all of the showers are defined
         if (!StoreShower(fcnLabel, slc, ss)) MakeShowerObsolete(fcnLabel, slc, ss, prtCTP);
       } // tjl
@@ -349,54 +350,54 @@ namespace tca {
       // try to merge showers in this plane using the lists of nearby Tjs
       if (inCTP == UINT_MAX) continue;
       if (slc.cots.empty()) continue;
-      if (prtCTP) Print2DShowers("tjl", slc, inCTP, false);
-      MergeShowerChain(fcnLabel, slc, inCTP, prtCTP);
-      SaveAllCots(slc, inCTP, "MSC");
-      if (prtCTP) Print2DShowers("MSCo", slc, inCTP, false);
-      MergeOverlap(fcnLabel, slc, inCTP, prtCTP);
-      SaveAllCots(slc, inCTP, "MO");
-      if (prtCTP) Print2DShowers("MO", slc, inCTP, false);
-      MergeNearby2DShowers(fcnLabel, slc, inCTP, prtCTP);
-      SaveAllCots(slc, inCTP, "MSS");
+      if (prtCTP) Print2DShowers("tjl", tcx, slc, inCTP, false);
+      MergeShowerChain(fcnLabel, tcx, slc, inCTP, prtCTP);
+      SaveAllCots(tcx, slc, inCTP, "MSC");
+      if (prtCTP) Print2DShowers("MSCo", tcx, slc, inCTP, false);
+      MergeOverlap(fcnLabel, tcx, slc, inCTP, prtCTP);
+      SaveAllCots(tcx, slc, inCTP, "MO");
+      if (prtCTP) Print2DShowers("MO", tcx, slc, inCTP, false);
+      MergeNearby2DShowers(fcnLabel, tcx, slc, inCTP, prtCTP);
+      SaveAllCots(tcx, slc, inCTP, "MSS");
       // merge sub-showers with other showers
-      MergeSubShowers(fcnLabel, slc, inCTP, prtCTP);
+      MergeSubShowers(fcnLabel, tcx, slc, inCTP, prtCTP);
       // merge sub-showers with shower-like tjs
-      MergeSubShowersTj(fcnLabel, slc, inCTP, prtCTP);
-      SaveAllCots(slc, inCTP, "MNrby");
-      if (prtCTP) Print2DShowers("Nrby", slc, inCTP, false);
+      MergeSubShowersTj(fcnLabel, tcx, slc, inCTP, prtCTP);
+      SaveAllCots(tcx, slc, inCTP, "MNrby");
+      if (prtCTP) Print2DShowers("Nrby", tcx, slc, inCTP, false);
       bool tryMerge = false;
       for (unsigned short ii = 0; ii < slc.cots.size(); ++ii) {
         auto& ss = slc.cots[ii];
         if (ss.ID == 0) continue;
         if (ss.CTP != inCTP) continue;
-        if (AddTjsInsideEnvelope(fcnLabel, slc, ss, prtCTP)) tryMerge = true;
-        if (tcc.modes[kSaveShowerTree]) SaveAllCots(slc, inCTP, "Merge");
+        if (AddTjsInsideEnvelope(fcnLabel, tcx, slc, ss, prtCTP)) tryMerge = true;
+        if (tcx.tcc.modes[kSaveShowerTree]) SaveAllCots(tcx, slc, inCTP, "Merge");
       }
-      if (tryMerge) MergeNearby2DShowers(fcnLabel, slc, inCTP, prtCTP);
-      SaveAllCots(slc, inCTP, "ATj2");
-      if (prtCTP) Print2DShowers("ATIE", slc, inCTP, false);
+      if (tryMerge) MergeNearby2DShowers(fcnLabel, tcx, slc, inCTP, prtCTP);
+      SaveAllCots(tcx, slc, inCTP, "ATj2");
+      if (prtCTP) Print2DShowers("ATIE", tcx, slc, inCTP, false);
     } // plane
     if (slc.cots.empty()) return false;
-    if (prt3S) Print2DShowers("B4", slc, USHRT_MAX, false);
+    if (prt3S) Print2DShowers("B4", tcx, slc, USHRT_MAX, false);
     // Match in 3D, make 3D showers and define them
     //    Match2DShowers(fcnLabel, slc, prt3S);
-    SaveAllCots(slc, "M2DS");
+    SaveAllCots(tcx, slc, "M2DS");
     // Reconcile pfp and shower assns before the Parent search
-    Reconcile3D(fcnLabel, slc, false, prt3S);
-    SaveAllCots(slc, "R3D");
+    Reconcile3D(fcnLabel, tcx, slc, false, prt3S);
+    SaveAllCots(tcx, slc, "R3D");
     for (auto& ss3 : slc.showers) {
       if (ss3.ID == 0) continue;
-      FindParent(detProp, fcnLabel, slc, ss3, prt3S);
+      FindParent(detProp, fcnLabel, tcx, slc, ss3, prt3S);
     } // ss3
     // Reconcile pfp and shower assns again
-    Reconcile3D(fcnLabel, slc, true, prt3S);
-    if (prt3S) Print2DShowers("M2DS", slc, USHRT_MAX, false);
-    SaveAllCots(slc, "FP");
+    Reconcile3D(fcnLabel, tcx, slc, true, prt3S);
+    if (prt3S) Print2DShowers("M2DS", tcx, slc, USHRT_MAX, false);
+    SaveAllCots(tcx, slc, "FP");
 
     // kill low energy 3D showers
     for (auto& ss3 : slc.showers) {
       if (ss3.ID == 0) continue;
-      bool killMe = (ShowerEnergy(ss3) < tcc.showerTag[3]);
+      bool killMe = (ShowerEnergy(ss3) < tcx.tcc.showerTag[3]);
       if (killMe) MakeShowerObsolete(fcnLabel, slc, ss3, prt3S);
     } // ss3
 
@@ -404,9 +405,9 @@ namespace tca {
     for (auto& ss : slc.cots) {
       if (ss.ID == 0) continue;
       if (ss.SS3ID > 0) continue;
-      bool killMe = (ss.TjIDs.size() == 1 || ss.Energy < tcc.showerTag[3]);
+      bool killMe = (ss.TjIDs.size() == 1 || ss.Energy < tcx.tcc.showerTag[3]);
       // too small aspect ratio -> something track-like with some shower-like fuzz
-      if (ss.AspectRatio < tcc.showerTag[10]) killMe = true;
+      if (ss.AspectRatio < tcx.tcc.showerTag[10]) killMe = true;
       if (killMe) MakeShowerObsolete(fcnLabel, slc, ss, prt3S);
     } // ss
 
@@ -414,7 +415,7 @@ namespace tca {
     for (auto& ss : slc.cots) {
       if (ss.ID == 0) continue;
       if (ss.TjIDs.empty()) continue;
-      SaveTjInfo(slc, ss, "Done");
+      SaveTjInfo(tcx, slc, ss, "Done");
       ++nNewShowers;
     } // ss
 
@@ -424,13 +425,17 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  Reconcile3D(std::string inFcnLabel, TCSlice& slc, bool parentSearchDone, bool prt)
+  Reconcile3D(std::string inFcnLabel,
+              TCContext& tcx,
+              TCSlice& slc,
+              bool parentSearchDone,
+              bool prt)
   {
     // Reconcile pfp and shower assns
 
     std::string fcnLabel = inFcnLabel + ".R3D2";
 
-    if (prt) Print2DShowers("R3D2i", slc, USHRT_MAX, false);
+    if (prt) Print2DShowers("R3D2i", tcx, slc, USHRT_MAX, false);
 
     // consider them pair-wise
     if (slc.showers.size() > 1) {
@@ -459,21 +464,21 @@ namespace tca {
           // Compare the InShower likelihoods
           for (auto pid : shared) {
             auto& pfp = slc.pfps[pid - 1];
-            float iProb = InShowerProb(slc, iss3, pfp);
-            float jProb = InShowerProb(slc, jss3, pfp);
+            float iProb = InShowerProb(tcx, slc, iss3, pfp);
+            float jProb = InShowerProb(tcx, slc, jss3, pfp);
             if (prt)
               mf::LogVerbatim("TC")
                 << fcnLabel << " i3S" << iss3.ID << " prob " << std::setprecision(3) << iProb
                 << "  j3S" << jss3.ID << " prob " << jProb;
             if (iProb > jProb) {
               // remove the remnants of pfp from jss3
-              RemovePFP(fcnLabel, slc, pfp, jss3, true, prt);
+              RemovePFP(fcnLabel, tcx, slc, pfp, jss3, true, prt);
               // and add them to iss3
-              AddPFP(fcnLabel, slc, pfp.ID, iss3, true, prt);
+              AddPFP(fcnLabel, tcx, slc, pfp.ID, iss3, true, prt);
             }
             else {
-              RemovePFP(fcnLabel, slc, pfp, iss3, true, prt);
-              AddPFP(fcnLabel, slc, pfp.ID, jss3, true, prt);
+              RemovePFP(fcnLabel, tcx, slc, pfp, iss3, true, prt);
+              AddPFP(fcnLabel, tcx, slc, pfp.ID, jss3, true, prt);
             }
           } // pid
         }   // jj
@@ -500,8 +505,8 @@ namespace tca {
             // remove P -> P parent-daughter assn
             pfp.Vx3ID[end] = 0;
             if (pfp.ParentUID > 0) {
-              auto slcIndx = GetSliceIndex("P", pfp.ParentUID);
-              auto& parentPFP = slices[slcIndx.first].pfps[slcIndx.second];
+              auto slcIndx = GetSliceIndex(tcx, "P", pfp.ParentUID);
+              auto& parentPFP = tcx.slices[slcIndx.first].pfps[slcIndx.second];
               std::vector<int> newDtrUIDs;
               for (auto did : parentPFP.DtrUIDs)
                 if (did != pfp.UID) newDtrUIDs.push_back(did);
@@ -557,13 +562,13 @@ namespace tca {
         for (auto cid : ss3.CotIDs) {
           auto& oss = slc.cots[cid - 1];
           if (oss.CTP != ss.CTP) continue;
-          if (!UpdateShower(fcnLabel, slc, ss3, prt)) return false;
+          if (!UpdateShower(fcnLabel, tcx, slc, ss3, prt)) return false;
           break;
         } // cid
       }   // mergeWith3S > 0
     }     // ss
 
-    if (prt) Print2DShowers("R3D2o", slc, USHRT_MAX, false);
+    if (prt) Print2DShowers("R3D2o", tcx, slc, USHRT_MAX, false);
 
     ChkAssns(fcnLabel, slc);
 
@@ -572,7 +577,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  Reconcile3D(std::string inFcnLabel, TCSlice& slc, ShowerStruct3D& ss3, bool prt)
+  Reconcile3D(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, ShowerStruct3D& ss3, bool prt)
   {
     // checks consistency between pfparticles, showers and tjs associated with ss3
     if (ss3.ID == 0) return false;
@@ -580,7 +585,7 @@ namespace tca {
     if (ss3.CotIDs.size() < 3) return true;
     std::string fcnLabel = inFcnLabel + ".R3D";
 
-    if (prt) Print2DShowers("R3Di", slc, USHRT_MAX, false);
+    if (prt) Print2DShowers("R3Di", tcx, slc, USHRT_MAX, false);
 
     // make local copies so we can recover from a failure
     auto oldSS3 = ss3;
@@ -654,7 +659,7 @@ namespace tca {
               myprt << " 2S" << sid;
           } // prt
           // missed a tj in a 2D shower so "add the PFP to the shower" and update it
-          if (AddPFP(fcnLabel, slc, pfp.ID, ss3, true, prt)) {
+          if (AddPFP(fcnLabel, tcx, slc, pfp.ID, ss3, true, prt)) {
             // Update the local copies
             oldSS3 = ss3;
             if (ss3.CotIDs.size() != oldSS.size()) return false;
@@ -675,7 +680,7 @@ namespace tca {
         // only one occurrence. check proximity to ss3
         auto& pfp = slc.pfps[pc[0] - 1];
         unsigned short nearEnd = 1 - FarEnd(slc, pfp, ss3.ChgPos);
-        float prob = InShowerProb(slc, ss3, pfp);
+        float prob = InShowerProb(tcx, slc, ss3, pfp);
         auto pos = PosAtEnd(pfp, nearEnd);
         float sep = PosSep(pos, ss3.ChgPos);
         if (prt) {
@@ -687,18 +692,18 @@ namespace tca {
           myprt << " sep " << sep;
           myprt << " InShowerProb " << prob;
         } // prt
-        if (sep < 30 && prob > 0.3 && AddPFP(fcnLabel, slc, pfp.ID, ss3, true, prt)) {
+        if (sep < 30 && prob > 0.3 && AddPFP(fcnLabel, tcx, slc, pfp.ID, ss3, true, prt)) {
           if (prt) mf::LogVerbatim("TC") << " AddPFP success";
         }
-        else if (!RemovePFP(fcnLabel, slc, pfp, ss3, true, prt)) {
+        else if (!RemovePFP(fcnLabel, tcx, slc, pfp, ss3, true, prt)) {
           if (prt) mf::LogVerbatim("TC") << " RemovePFP failed";
         }
       } // only one occurrence.
     }   // pc
 
-    if (!UpdateShower(fcnLabel, slc, ss3, prt)) return false;
+    if (!UpdateShower(fcnLabel, tcx, slc, ss3, prt)) return false;
     ChkAssns(fcnLabel, slc);
-    if (prt) Print2DShowers("R3Do", slc, USHRT_MAX, false);
+    if (prt) Print2DShowers("R3Do", tcx, slc, USHRT_MAX, false);
 
     return true;
 
@@ -706,11 +711,15 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  KillVerticesInShower(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt)
+  KillVerticesInShower(std::string inFcnLabel,
+                       TCContext& tcx,
+                       TCSlice& slc,
+                       ShowerStruct& ss,
+                       bool prt)
   {
     // make the vertices inside the shower envelope obsolete and update dontCluster
     if (ss.ID == 0) return;
-    if (!tcc.useAlg[kKillInShowerVx]) return;
+    if (!tcx.tcc.useAlg[kKillInShowerVx]) return;
     std::string fcnLabel = inFcnLabel + ".KVIS";
 
     for (auto& vx2 : slc.vtxs) {
@@ -737,13 +746,13 @@ namespace tca {
         for (auto tid : TIn3V)
           slc.tjs[tid - 1].AlgMod[kKillInShowerVx] = true;
         auto& vx3 = slc.vtx3s[vx2.Vx3ID - 1];
-        MakeVertexObsolete(slc, vx3);
+        MakeVertexObsolete(tcx, slc, vx3);
       }
       else {
         auto TIn2V = GetAssns(slc, "2V", vx2.ID, "T");
         for (auto tid : TIn2V)
           slc.tjs[tid - 1].AlgMod[kKillInShowerVx] = true;
-        MakeVertexObsolete("KVIS", slc, vx2, true);
+        MakeVertexObsolete("KVIS", tcx, slc, vx2, true);
       }
     } // vx2
 
@@ -751,7 +760,11 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  CompleteIncompleteShower(std::string inFcnLabel, TCSlice& slc, ShowerStruct3D& ss3, bool prt)
+  CompleteIncompleteShower(std::string inFcnLabel,
+                           TCContext& tcx,
+                           TCSlice& slc,
+                           ShowerStruct3D& ss3,
+                           bool prt)
   {
     // Find low-energy two-plane showers and try to complete it by making a 2D shower in the third
     // plane using 3D matched tjs
@@ -759,7 +772,7 @@ namespace tca {
     if (slc.nPlanes != 3) return false;
     if (ss3.CotIDs.size() != 2) return false;
 
-    if (!tcc.useAlg[kCompleteShower]) return false;
+    if (!tcx.tcc.useAlg[kCompleteShower]) return false;
 
     std::string fcnLabel = inFcnLabel + ".CIS";
     if (prt) mf::LogVerbatim("TC") << fcnLabel << " 3S" << ss3.ID;
@@ -874,7 +887,7 @@ namespace tca {
       if (prt)
         mf::LogVerbatim("TC") << fcnLabel << " 3S" << ss3.ID << " create new 2S" << kss.ID
                               << " from ktlist";
-      if (!UpdateShower(fcnLabel, slc, kss, prt)) {
+      if (!UpdateShower(fcnLabel, tcx, slc, kss, prt)) {
         if (prt) mf::LogVerbatim("TC") << fcnLabel << " UpdateShower failed 2S" << kss.ID;
         MakeShowerObsolete(fcnLabel, slc, kss, prt);
         return false;
@@ -908,7 +921,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  UpdateShower(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt)
+  UpdateShower(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, ShowerStruct& ss, bool prt)
   {
     // This is intended to be a single function replacement for FCC, FA, USWP, etc. The calling
     // function should have set NeedsUpdate true. A complete re-build is done if the ShPts vector
@@ -962,14 +975,14 @@ namespace tca {
         for (unsigned short ii = 0; ii < tp.Hits.size(); ++ii) {
           if (!tp.UseHit[ii]) continue;
           unsigned int iht = tp.Hits[ii];
-          auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+          auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
           if (hit.Integral() <= 0) continue;
           ShowerPoint shpt;
           shpt.HitIndex = iht;
           shpt.TID = tj.ID;
           shpt.Chg = hit.Integral();
           shpt.Pos[0] = hit.WireID().Wire;
-          shpt.Pos[1] = hit.PeakTime() * tcc.unitsPerTick;
+          shpt.Pos[1] = hit.PeakTime() * tcx.tcc.unitsPerTick;
           ss.ShPts.push_back(shpt);
         } // ii
       }   // ipt
@@ -990,8 +1003,9 @@ namespace tca {
     stp1.Pos[1] /= stj.TotChg;
     ss.Energy = ChgToMeV(stj.TotChg);
     if (prt)
-      mf::LogVerbatim("TC") << fcnLabel << " 2S" << ss.ID << " Chg ctr " << PrintPos(slc, stp1.Pos)
-                            << " Energy " << (int)ss.Energy << " MeV";
+      mf::LogVerbatim("TC") << fcnLabel << " 2S" << ss.ID << " Chg ctr "
+                            << PrintPos(tcx, slc, stp1.Pos) << " Energy " << (int)ss.Energy
+                            << " MeV";
 
     // find the direction using the shower parent if one exists
     if (ss.ParentID > 0) {
@@ -1091,12 +1105,12 @@ namespace tca {
       auto& firstShPt = ss.ShPts[0];
       auto& lastShPt = ss.ShPts[ss.ShPts.size() - 1];
       if (PosSep2(ptp.Pos, lastShPt.Pos) < PosSep2(ptp.Pos, firstShPt.Pos))
-        ReverseShower(fcnLabel, slc, ss, prt);
+        ReverseShower(fcnLabel, tcx, slc, ss, prt);
       stj.Pts[0].Pos = ptp.Pos;
     }
     else {
       // no parent exists. Compare the DeltaRMS at the ends
-      if (stj.Pts[2].DeltaRMS < stj.Pts[0].DeltaRMS) ReverseShower(fcnLabel, slc, ss, prt);
+      if (stj.Pts[2].DeltaRMS < stj.Pts[0].DeltaRMS) ReverseShower(fcnLabel, tcx, slc, ss, prt);
       stj.Pts[0].Pos = ss.ShPts[0].Pos;
     } // no parent
 
@@ -1104,7 +1118,7 @@ namespace tca {
     // define the end point
     stj.Pts[2].Pos = ss.ShPts[ss.ShPts.size() - 1].Pos;
 
-    DefineEnvelope(fcnLabel, slc, ss, prt);
+    DefineEnvelope(fcnLabel, tcx, slc, ss, prt);
     ss.NeedsUpdate = false;
     if (prt) mf::LogVerbatim("TC") << fcnLabel << " 2S" << ss.ID << " updated";
     return true;
@@ -1113,7 +1127,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  UpdateShower(std::string inFcnLabel, TCSlice& slc, ShowerStruct3D& ss3, bool prt)
+  UpdateShower(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, ShowerStruct3D& ss3, bool prt)
   {
     // Updates the 3D shower presumably because the 2D showers were changed or need to be updated.
     // This function returns false if there was a failure.
@@ -1129,7 +1143,7 @@ namespace tca {
       if (ss.NeedsUpdate && prt)
         std::cout << fcnLabel << " ********* 3S" << ss3.ID << " 2S" << ss.ID
                   << " needs an update...\n";
-      UpdateShower(fcnLabel, slc, ss, prt);
+      UpdateShower(fcnLabel, tcx, slc, ss, prt);
     } // ci
 
     // check consistency
@@ -1208,6 +1222,7 @@ namespace tca {
   float
   Match3DFOM(detinfo::DetectorPropertiesData const& detProp,
              std::string inFcnLabel,
+             TCContext& tcx,
              TCSlice& slc,
              ShowerStruct3D& ss3,
              bool prt)
@@ -1218,7 +1233,7 @@ namespace tca {
       unsigned short icid = ss3.CotIDs[ii];
       for (unsigned short jj = ii + 1; jj < ss3.CotIDs.size(); ++jj) {
         unsigned short jcid = ss3.CotIDs[jj];
-        fom += Match3DFOM(detProp, inFcnLabel, slc, icid, jcid, prt);
+        fom += Match3DFOM(detProp, inFcnLabel, tcx, slc, icid, jcid, prt);
         ++cnt;
       } // cj
     }   // ci
@@ -1230,6 +1245,7 @@ namespace tca {
   float
   Match3DFOM(detinfo::DetectorPropertiesData const& detProp,
              std::string inFcnLabel,
+             TCContext& tcx,
              TCSlice& slc,
              int icid,
              int jcid,
@@ -1240,8 +1256,8 @@ namespace tca {
     if (jcid == 0 || jcid > (int)slc.cots.size()) return 100;
     if (kcid == 0 || kcid > (int)slc.cots.size()) return 100;
 
-    float ijfom = Match3DFOM(detProp, inFcnLabel, slc, icid, jcid, prt);
-    float jkfom = Match3DFOM(detProp, inFcnLabel, slc, jcid, kcid, prt);
+    float ijfom = Match3DFOM(detProp, inFcnLabel, tcx, slc, icid, jcid, prt);
+    float jkfom = Match3DFOM(detProp, inFcnLabel, tcx, slc, jcid, kcid, prt);
 
     return 0.5 * (ijfom + jkfom);
 
@@ -1251,6 +1267,7 @@ namespace tca {
   float
   Match3DFOM(detinfo::DetectorPropertiesData const& detProp,
              std::string inFcnLabel,
+             TCContext& tcx,
              TCSlice& slc,
              int icid,
              int jcid,
@@ -1278,8 +1295,8 @@ namespace tca {
     geo::PlaneID jPlnID = DecodeCTP(jss.CTP);
 
     // compare match at the charge center
-    float ix = detProp.ConvertTicksToX(istj.Pts[1].Pos[1] / tcc.unitsPerTick, iPlnID);
-    float jx = detProp.ConvertTicksToX(jstj.Pts[1].Pos[1] / tcc.unitsPerTick, jPlnID);
+    float ix = detProp.ConvertTicksToX(istj.Pts[1].Pos[1] / tcx.tcc.unitsPerTick, iPlnID);
+    float jx = detProp.ConvertTicksToX(jstj.Pts[1].Pos[1] / tcx.tcc.unitsPerTick, jPlnID);
     float pos1fom = std::abs(ix - jx) / 10;
 
     float mfom = energyAsym * pos1fom;
@@ -1353,6 +1370,7 @@ namespace tca {
   ////////////////////////////////////////////////
   bool
   RemovePFP(std::string inFcnLabel,
+            TCContext& tcx,
             TCSlice& slc,
             PFPStruct& pfp,
             ShowerStruct3D& ss3,
@@ -1369,12 +1387,12 @@ namespace tca {
       for (auto cid : ss3.CotIDs) {
         auto& ss = slc.cots[cid - 1];
         if (std::find(ss.TjIDs.begin(), ss.TjIDs.end(), tid) == ss.TjIDs.end()) continue;
-        if (!RemoveTj(fcnLabel, slc, tid, ss, doUpdate, prt)) return false;
+        if (!RemoveTj(fcnLabel, tcx, slc, tid, ss, doUpdate, prt)) return false;
         ss3.NeedsUpdate = true;
       } // cid
     }   // ptid
 
-    if (doUpdate && ss3.NeedsUpdate) UpdateShower(fcnLabel, slc, ss3, prt);
+    if (doUpdate && ss3.NeedsUpdate) UpdateShower(fcnLabel, tcx, slc, ss3, prt);
     return true;
 
   } // Remove PFP
@@ -1382,6 +1400,7 @@ namespace tca {
   ////////////////////////////////////////////////
   bool
   AddPFP(std::string inFcnLabel,
+         TCContext& tcx,
          TCSlice& slc,
          int pID,
          ShowerStruct3D& ss3,
@@ -1430,20 +1449,26 @@ namespace tca {
         auto& ss = slc.cots[cid - 1];
         if (ss.CTP != tj.CTP) continue;
         // Add it to the shower.
-        AddTj(fcnLabel, slc, tid, ss, doUpdate, prt);
+        AddTj(fcnLabel, tcx, slc, tid, ss, doUpdate, prt);
         ss3.NeedsUpdate = true;
         break;
       } // cid
     }   // tid
 
-    if (doUpdate && ss3.NeedsUpdate) UpdateShower(fcnLabel, slc, ss3, prt);
+    if (doUpdate && ss3.NeedsUpdate) UpdateShower(fcnLabel, tcx, slc, ss3, prt);
     return true;
 
   } // AddPFP
 
   ////////////////////////////////////////////////
   bool
-  AddTj(std::string inFcnLabel, TCSlice& slc, int tjID, ShowerStruct& ss, bool doUpdate, bool prt)
+  AddTj(std::string inFcnLabel,
+        TCContext& tcx,
+        TCSlice& slc,
+        int tjID,
+        ShowerStruct& ss,
+        bool doUpdate,
+        bool prt)
   {
     // Adds the Tj to the shower and optionally updates the shower variables
 
@@ -1498,10 +1523,10 @@ namespace tca {
           unsigned int iht = tp.Hits[ii];
           ss.ShPts[cnt].HitIndex = iht;
           ss.ShPts[cnt].TID = tj.ID;
-          auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+          auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
           ss.ShPts[cnt].Chg = hit.Integral();
           ss.ShPts[cnt].Pos[0] = hit.WireID().Wire;
-          ss.ShPts[cnt].Pos[1] = hit.PeakTime() * tcc.unitsPerTick;
+          ss.ShPts[cnt].Pos[1] = hit.PeakTime() * tcx.tcc.unitsPerTick;
           ++cnt;
         }
       }
@@ -1509,7 +1534,7 @@ namespace tca {
     if (prt) mf::LogVerbatim("TC") << fcnLabel << " Added T" << tj.ID << " to 2S" << ss.ID;
     ss.NeedsUpdate = true;
 
-    if (doUpdate) return UpdateShower(fcnLabel, slc, ss, prt);
+    if (doUpdate) return UpdateShower(fcnLabel, tcx, slc, ss, prt);
     return true;
 
   } // AddTj
@@ -1517,6 +1542,7 @@ namespace tca {
   ////////////////////////////////////////////////
   bool
   RemoveTj(std::string inFcnLabel,
+           TCContext& tcx,
            TCSlice& slc,
            int TjID,
            ShowerStruct& ss,
@@ -1565,7 +1591,7 @@ namespace tca {
     ss.ShPts.clear();
     if (doUpdate) {
       ss.NeedsUpdate = true;
-      return UpdateShower(fcnLabel, slc, ss, prt);
+      return UpdateShower(fcnLabel, tcx, slc, ss, prt);
     }
     return true;
   } // RemoveTj
@@ -1574,6 +1600,7 @@ namespace tca {
   bool
   FindParent(detinfo::DetectorPropertiesData const& detProp,
              std::string inFcnLabel,
+             TCContext& tcx,
              TCSlice& slc,
              ShowerStruct3D& ss3,
              bool prt)
@@ -1589,9 +1616,9 @@ namespace tca {
     if (ss3.ID == 0) return false;
     if (ss3.CotIDs.size() < 2) return false;
     // Use the MVA reader
-    if (!tcc.showerParentReader) return false;
-    if (tcc.showerParentVars.size() != 9) return false;
-    if (!tcc.useAlg[kShwrParent]) return false;
+    if (!tcx.tcc.showerParentReader) return false;
+    if (tcx.tcc.showerParentVars.size() != 9) return false;
+    if (!tcx.tcc.useAlg[kShwrParent]) return false;
 
     std::string fcnLabel = inFcnLabel + ".FPar";
     int truPFP = 0;
@@ -1719,37 +1746,37 @@ namespace tca {
           break;
         } // cid
         if (ssid == 0) continue;
-        auto tpFrom = MakeBareTP(detProp, slc, pos, pToS, inCTP);
+        auto tpFrom = MakeBareTP(detProp, tcx, slc, pos, pToS, inCTP);
         auto& ss = slc.cots[ssid - 1];
         auto& stp1 = slc.tjs[ss.ShowerTjID - 1].Pts[1];
         float sep = PosSep(tpFrom.Pos, stp1.Pos);
         float toPos = tpFrom.Pos[0] + 0.5 * tpFrom.Dir[0] * sep;
-        float cf = ChgFracBetween(slc, tpFrom, toPos);
+        float cf = ChgFracBetween(tcx, slc, tpFrom, toPos);
         // weight by the separation in the plane
         totSep += sep;
         chgFrac += sep * cf;
       } // plane
       if (totSep > 0) chgFrac /= totSep;
       // load the MVA variables
-      tcc.showerParentVars[0] = energy;
-      tcc.showerParentVars[1] = pfpEnergy;
-      tcc.showerParentVars[2] = MCSMom(slc, pfp.TjIDs);
+      tcx.tcc.showerParentVars[0] = energy;
+      tcx.tcc.showerParentVars[1] = pfpEnergy;
+      tcx.tcc.showerParentVars[2] = MCSMom(tcx, slc, pfp.TjIDs);
       auto startPos = PosAtEnd(pfp, 0);
       auto endPos = PosAtEnd(pfp, 1);
-      tcc.showerParentVars[3] = PosSep(startPos, endPos);
-      tcc.showerParentVars[4] = sqrt(distToChgPos2);
-      tcc.showerParentVars[5] = acos(costh1);
-      tcc.showerParentVars[6] = acos(costh2);
-      tcc.showerParentVars[7] = chgFrac;
-      tcc.showerParentVars[8] = prob;
-      float candParFOM = tcc.showerParentReader->EvaluateMVA("BDT");
+      tcx.tcc.showerParentVars[3] = PosSep(startPos, endPos);
+      tcx.tcc.showerParentVars[4] = sqrt(distToChgPos2);
+      tcx.tcc.showerParentVars[5] = acos(costh1);
+      tcx.tcc.showerParentVars[6] = acos(costh2);
+      tcx.tcc.showerParentVars[7] = chgFrac;
+      tcx.tcc.showerParentVars[8] = prob;
+      float candParFOM = tcx.tcc.showerParentReader->EvaluateMVA("BDT");
 
       if (prt) {
         mf::LogVerbatim myprt("TC");
         myprt << fcnLabel;
         myprt << " 3S" << ss3.ID << "_" << shEnd;
         myprt << " P" << pfp.ID << "_" << pEnd << " ParentVars";
-        for (auto var : tcc.showerParentVars)
+        for (auto var : tcx.tcc.showerParentVars)
           myprt << " " << std::fixed << std::setprecision(2) << var;
         myprt << " candParFOM " << candParFOM;
       } // prt
@@ -1810,7 +1837,8 @@ namespace tca {
     unsigned short pend = FarEnd(slc, pfp, ss3.ChgPos);
     ss3.Vx3ID = pfp.Vx3ID[pend];
 
-    if (SetParent(detProp, fcnLabel, slc, pfp, ss3, prt) && UpdateShower(fcnLabel, slc, ss3, prt)) {
+    if (SetParent(detProp, fcnLabel, tcx, slc, pfp, ss3, prt) &&
+        UpdateShower(fcnLabel, tcx, slc, ss3, prt)) {
       if (prt) mf::LogVerbatim("TC") << fcnLabel << " 3S" << ss3.ID << " successful update";
       return true;
     }
@@ -1829,6 +1857,7 @@ namespace tca {
   bool
   SetParent(detinfo::DetectorPropertiesData const& detProp,
             std::string inFcnLabel,
+            TCContext& tcx,
             TCSlice& slc,
             PFPStruct& pfp,
             ShowerStruct3D& ss3,
@@ -1856,12 +1885,12 @@ namespace tca {
         if (tj.CTP != ss.CTP) continue;
         if (std::find(ss.TjIDs.begin(), ss.TjIDs.end(), tjid) == ss.TjIDs.end()) {
           // Add the tj but don't update yet
-          if (!AddTj(fcnLabel, slc, tjid, ss, false, prt)) return false;
+          if (!AddTj(fcnLabel, tcx, slc, tjid, ss, false, prt)) return false;
         } // parent not in ss
         // Don't define it to be the parent if it is short and the pfp projection in this plane is low
         auto pos = PosAtEnd(pfp, 0);
         auto dir = DirAtEnd(pfp, 0);
-        auto tp = MakeBareTP(detProp, slc, pos, dir, tj.CTP);
+        auto tp = MakeBareTP(detProp, tcx, slc, pos, dir, tj.CTP);
         unsigned short npts = tj.EndPt[1] - tj.EndPt[0] + 1;
         if (tp.Delta > 0.5 || npts > 20) {
           if (prt)
@@ -1888,14 +1917,14 @@ namespace tca {
           } // end
         }   // ss3.Vx3ID > 0
         // and update
-        if (!UpdateShower(fcnLabel, slc, ss, prt)) return false;
+        if (!UpdateShower(fcnLabel, tcx, slc, ss, prt)) return false;
       } // tjid
     }   // cid
     ss3.ParentID = pfp.ID;
 
     unsigned short pEnd = FarEnd(slc, pfp, ss3.ChgPos);
     ss3.Vx3ID = pfp.Vx3ID[pEnd];
-    float fom3D = ParentFOM(fcnLabel, slc, pfp, pEnd, ss3, prt);
+    float fom3D = ParentFOM(fcnLabel, tcx, slc, pfp, pEnd, ss3, prt);
     for (auto cid : ss3.CotIDs)
       slc.cots[cid - 1].ParentFOM = fom3D;
 
@@ -2011,7 +2040,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   float
-  InShowerProb(TCSlice& slc, const ShowerStruct3D& ss3, const PFPStruct& pfp)
+  InShowerProb(TCContext& tcx, TCSlice& slc, const ShowerStruct3D& ss3, const PFPStruct& pfp)
   {
     // returns a likelihood (0 - 1) that the pfp particle belongs in shower ss3
 
@@ -2024,7 +2053,7 @@ namespace tca {
       for (auto tid : pfp.TjIDs) {
         auto& tj = slc.tjs[tid - 1];
         if (tj.CTP != ss.CTP) continue;
-        sum += InShowerProb(slc, ss, tj);
+        sum += InShowerProb(tcx, slc, ss, tj);
         ++cnt;
       } // tid
     }   //cid
@@ -2035,7 +2064,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   float
-  InShowerProb(TCSlice& slc, const ShowerStruct& ss, const Trajectory& tj)
+  InShowerProb(TCContext& tcx, TCSlice& slc, const ShowerStruct& ss, const Trajectory& tj)
   {
     // returns a likelihood (0 - 1) that the tj particle belongs in shower ss
     // Keep it simple: construct a FOM, take the inverse and limit it to the range 0 - 1
@@ -2046,7 +2075,7 @@ namespace tca {
     if (stj.Pts.size() != 3) return 0;
     unsigned short closePt1, closePt2;
     float doca = 1E6;
-    TrajTrajDOCA(slc, stj, tj, closePt1, closePt2, doca);
+    TrajTrajDOCA(tcx, slc, stj, tj, closePt1, closePt2, doca);
     if (doca == 1E6) return 0;
     float showerLen = PosSep(stj.Pts[0].Pos, stj.Pts[2].Pos);
     // make a rough separation cut. Return a small but non-zero value
@@ -2073,6 +2102,7 @@ namespace tca {
   ////////////////////////////////////////////////
   float
   ParentFOM(std::string inFcnLabel,
+            TCContext& tcx,
             TCSlice& slc,
             PFPStruct& pfp,
             unsigned short pend,
@@ -2105,7 +2135,7 @@ namespace tca {
       if (chgCtrSep2 < PosSep2(farTP.Pos, stj.Pts[0].Pos) &&
           chgCtrSep2 < PosSep2(farTP.Pos, stj.Pts[2].Pos))
         continue;
-      float fom = ParentFOM(fcnLabel, slc, ptj, ptjEnd, ss, dum1, dum2, prt);
+      float fom = ParentFOM(fcnLabel, tcx, slc, ptj, ptjEnd, ss, dum1, dum2, prt);
       // ignore failures
       if (fom > 50) continue;
       // weight by the 1/aspect ratio
@@ -2125,6 +2155,7 @@ namespace tca {
   ////////////////////////////////////////////////
   float
   ParentFOM(std::string inFcnLabel,
+            TCContext& tcx,
             TCSlice& slc,
             Trajectory& tj,
             unsigned short& tjEnd,
@@ -2176,7 +2207,7 @@ namespace tca {
     // Find the expected shower start relative to shower max (cm)
     double shMaxAlong, shE95Along;
     ShowerParams(ss.Energy, shMaxAlong, shE95Along);
-    double alongcm = tcc.wirePitch * tp1Sep;
+    double alongcm = tcx.tcc.wirePitch * tp1Sep;
     // InShowerProbLong expects the longitudinal distance relative to shower max so it
     // should be < 0
     float prob = InShowerProbLong(ss.Energy, -alongcm);
@@ -2197,7 +2228,7 @@ namespace tca {
     }
     // make a tp between the supposed parent TP and the shower center
     TrajPoint tp;
-    if (!MakeBareTrajPoint(slc, ptp, stp1, tp)) return 100;
+    if (!MakeBareTrajPoint(tcx, slc, ptp, stp1, tp)) return 100;
     // we have three angles to compare. The ptp angle, the shower angle and
     // the tp angle.
     float dang1 = DeltaAngle(ptp.Ang, stp1.Ang);
@@ -2225,12 +2256,12 @@ namespace tca {
     } // 2D vertex exists
     fom += vxFOM;
     ++cnt;
-    float chgFrac = ChgFracNearPos(slc, ptp.Pos, tjlist);
+    float chgFrac = ChgFracNearPos(tcx, slc, ptp.Pos, tjlist);
     float chgFracFOM = (1 - chgFrac) / 0.1;
     fom += chgFracFOM;
     ++cnt;
     // Fraction of wires that have a signal between the parent start and the shower center
-    float chgFracBtw = ChgFracBetween(slc, ptp, stp1.Pos[0]);
+    float chgFracBtw = ChgFracBetween(tcx, slc, ptp, stp1.Pos[0]);
     float chgFrcBtwFOM = (1 - chgFrac) / 0.05;
     fom += chgFrcBtwFOM;
     ++cnt;
@@ -2244,7 +2275,7 @@ namespace tca {
       mf::LogVerbatim myprt("TC");
       myprt << fcnLabel;
       myprt << " 2S" << ss.ID;
-      myprt << " T" << tj.ID << "_" << tjEnd << " Pos " << PrintPos(slc, ptp);
+      myprt << " T" << tj.ID << "_" << tjEnd << " Pos " << PrintPos(tcx, slc, ptp);
       myprt << std::fixed << std::setprecision(2);
       myprt << " along " << std::fixed << std::setprecision(1) << alongTrans[0] << " fom "
             << longFOM;
@@ -2305,9 +2336,13 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  MergeNearby2DShowers(std::string inFcnLabel, TCSlice& slc, const CTP_t& inCTP, bool prt)
+  MergeNearby2DShowers(std::string inFcnLabel,
+                       TCContext& tcx,
+                       TCSlice& slc,
+                       const CTP_t& inCTP,
+                       bool prt)
   {
-    if (!tcc.useAlg[kMergeNrShowers]) return;
+    if (!tcx.tcc.useAlg[kMergeNrShowers]) return;
     if (slc.cots.empty()) return;
 
     std::string fcnLabel = inFcnLabel + ".MNS";
@@ -2375,13 +2410,13 @@ namespace tca {
               auto TInP = GetAssns(slc, "T", tj.ID, "P");
               if (!TInP.empty()) {
                 auto& pfp = slc.pfps[TInP[0] - 1];
-                if (pfp.PDGCode == 13 && MCSMom(slc, pfp.TjIDs) > 500) continue;
+                if (pfp.PDGCode == 13 && MCSMom(tcx, slc, pfp.TjIDs) > 500) continue;
               } // TInP not empty
             }   // 3D matched
-            if (AddTj(fcnLabel, slc, tjID, ss1, false, prt)) doMerge = true;
+            if (AddTj(fcnLabel, tcx, slc, tjID, ss1, false, prt)) doMerge = true;
           } // tjID
           if (!doMerge) continue;
-          if (MergeShowersAndStore(fcnLabel, slc, ss1.ID, ss2.ID, prt)) {
+          if (MergeShowersAndStore(fcnLabel, tcx, slc, ss1.ID, ss2.ID, prt)) {
             Trajectory& stj = slc.tjs[ss1.ShowerTjID - 1];
             stj.AlgMod[kMergeNrShowers] = true;
             if (prt) mf::LogVerbatim("TC") << fcnLabel << " success";
@@ -2398,7 +2433,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  MergeOverlap(std::string inFcnLabel, TCSlice& slc, const CTP_t& inCTP, bool prt)
+  MergeOverlap(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, const CTP_t& inCTP, bool prt)
   {
     // Merge showers whose envelopes overlap each other
 
@@ -2417,17 +2452,18 @@ namespace tca {
      # 11 Debug in CTP (>10 debug cotID + 10)
      */
 
-    if (tcc.showerTag[2] <= 0) return;
-    if (!tcc.useAlg[kMergeOverlap]) return;
+    if (tcx.tcc.showerTag[2] <= 0) return;
+    if (!tcx.tcc.useAlg[kMergeOverlap]) return;
     if (slc.cots.empty()) return;
 
     std::string fcnLabel = inFcnLabel + ".MO";
 
     // Require that the maximum separation is about two radiation lengths
     if (prt)
-      mf::LogVerbatim("TC") << fcnLabel << " checking using separation cut " << tcc.showerTag[2];
+      mf::LogVerbatim("TC") << fcnLabel << " checking using separation cut "
+                            << tcx.tcc.showerTag[2];
 
-    float sepCut2 = tcc.showerTag[2] * tcc.showerTag[2];
+    float sepCut2 = tcx.tcc.showerTag[2] * tcx.tcc.showerTag[2];
 
     // Iterate if a merge is done
     bool didMerge = true;
@@ -2464,7 +2500,7 @@ namespace tca {
                   if (prt)
                     mf::LogVerbatim("TC")
                       << fcnLabel << " Envelopes 2S" << iss.ID << " 2S" << jss.ID << " are close "
-                      << PosSep(ivx, jvx) << " cut " << tcc.showerTag[2];
+                      << PosSep(ivx, jvx) << " cut " << tcx.tcc.showerTag[2];
                   doMerge = true;
                   break;
                 }
@@ -2500,7 +2536,7 @@ namespace tca {
             continue;
           }
           if (prt) mf::LogVerbatim("TC") << fcnLabel << " Merge " << iss.ID << " and " << jss.ID;
-          if (MergeShowersAndStore(fcnLabel, slc, iss.ID, jss.ID, prt)) {
+          if (MergeShowersAndStore(fcnLabel, tcx, slc, iss.ID, jss.ID, prt)) {
             Trajectory& stj = slc.tjs[iss.ShowerTjID - 1];
             stj.AlgMod[kMergeOverlap] = true;
             didMerge = true;
@@ -2519,11 +2555,15 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  MergeShowerChain(std::string inFcnLabel, TCSlice& slc, const CTP_t& inCTP, bool prt)
+  MergeShowerChain(std::string inFcnLabel,
+                   TCContext& tcx,
+                   TCSlice& slc,
+                   const CTP_t& inCTP,
+                   bool prt)
   {
     // Merge chains of 3 or more showers that lie on a line
 
-    if (!tcc.useAlg[kMergeShChain]) return;
+    if (!tcx.tcc.useAlg[kMergeShChain]) return;
 
     std::string fcnLabel = inFcnLabel + ".MSC";
 
@@ -2575,23 +2615,23 @@ namespace tca {
       bool skipit = DontCluster(slc, iss.TjIDs, jss.TjIDs);
       if (prt)
         mf::LogVerbatim("TC") << fcnLabel << " i2S" << iss.ID << " "
-                              << PrintPos(slc, tpList[ii].Pos) << " j2S" << jss.ID << " "
-                              << PrintPos(slc, tpList[jj].Pos) << " sepij " << sepij << " skipit? "
-                              << skipit;
+                              << PrintPos(tcx, slc, tpList[ii].Pos) << " j2S" << jss.ID << " "
+                              << PrintPos(tcx, slc, tpList[jj].Pos) << " sepij " << sepij
+                              << " skipit? " << skipit;
       if (skipit) continue;
       // draw a line between these points
       TrajPoint tp;
-      MakeBareTrajPoint(slc, tpList[ii], tpList[jj], tp);
+      MakeBareTrajPoint(tcx, slc, tpList[ii], tpList[jj], tp);
       for (unsigned short kk = jj + 1; kk < sids.size(); ++kk) {
         auto& kss = slc.cots[sids[kk] - 1];
         if (kss.ID == 0) continue;
         if (DontCluster(slc, iss.TjIDs, kss.TjIDs)) continue;
         if (DontCluster(slc, jss.TjIDs, kss.TjIDs)) continue;
         float sepjk = PosSep(tpList[jj].Pos, tpList[kk].Pos);
-        float delta = PointTrajDOCA(slc, tpList[kk].Pos[0], tpList[kk].Pos[1], tp);
+        float delta = PointTrajDOCA(tcx, slc, tpList[kk].Pos[0], tpList[kk].Pos[1], tp);
         if (prt) {
           mf::LogVerbatim myprt("TC");
-          myprt << fcnLabel << "   k2S" << kss.ID << " " << PrintPos(slc, tpList[kk].Pos)
+          myprt << fcnLabel << "   k2S" << kss.ID << " " << PrintPos(tcx, slc, tpList[kk].Pos)
                 << " sepjk " << sepjk << " delta " << delta;
           if (sepjk > minSep || delta > maxDelta) {
             myprt << " failed separation " << minSep << " or delta cut " << maxDelta;
@@ -2604,7 +2644,7 @@ namespace tca {
           // clear a short chain?
           if (chain.size() > 2) {
             // merge this chain
-            int newID = MergeShowers(fcnLabel, slc, chain, prt);
+            int newID = MergeShowers(fcnLabel, tcx, slc, chain, prt);
             if (prt) {
               mf::LogVerbatim myprt("TC");
               myprt << fcnLabel << " merged chain";
@@ -2628,12 +2668,12 @@ namespace tca {
             chain.push_back(sids[kk]);
           }
           // Refine the TP position and direction
-          MakeBareTrajPoint(slc, tpList[ii], tpList[kk], tp);
+          MakeBareTrajPoint(tcx, slc, tpList[ii], tpList[kk], tp);
         } // add to an existing chain
       }   // kk
       // push the last one
       if (chain.size() > 2) {
-        int newID = MergeShowers(fcnLabel, slc, chain, prt);
+        int newID = MergeShowers(fcnLabel, tcx, slc, chain, prt);
         if (prt) {
           mf::LogVerbatim myprt("TC");
           myprt << fcnLabel << " merged chain";
@@ -2650,12 +2690,16 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  MergeSubShowersTj(std::string inFcnLabel, TCSlice& slc, const CTP_t& inCTP, bool prt)
+  MergeSubShowersTj(std::string inFcnLabel,
+                    TCContext& tcx,
+                    TCSlice& slc,
+                    const CTP_t& inCTP,
+                    bool prt)
   {
     // merge small showers that are downstream of shower-like tjs. This algorithm is written
     // for low-energy showers with are likely to be sparse and poorly defined.
 
-    if (!tcc.useAlg[kMergeSubShowersTj]) return;
+    if (!tcx.tcc.useAlg[kMergeSubShowersTj]) return;
 
     std::string fcnLabel = inFcnLabel + ".MSSTj";
 
@@ -2685,9 +2729,9 @@ namespace tca {
         // require that it isn't in any shower
         if (tj.SSID > 0) continue;
         // require it to be not short
-        if (NumPtsWithCharge(slc, tj, false) < 10) continue;
+        if (NumPtsWithCharge(tcx, slc, tj, false) < 10) continue;
         // and satisfy the ShowerLike MCSMom cut. It is unlikely to be tagged shower-like
-        if (tj.MCSMom > tcc.showerTag[1]) continue;
+        if (tj.MCSMom > tcx.tcc.showerTag[1]) continue;
         // check consistency
         tjid[0] = tj.ID;
         if (DontCluster(slc, tjid, ss.TjIDs)) continue;
@@ -2696,12 +2740,12 @@ namespace tca {
         unsigned short farEnd = FarEnd(slc, tj, stj.Pts[1].Pos);
         // compare MCSMom at the far end and the near end
         unsigned short midpt = 0.5 * (tj.EndPt[0] + tj.EndPt[1]);
-        float mom1 = MCSMom(slc, tj, tj.EndPt[farEnd], midpt);
-        float mom2 = MCSMom(slc, tj, tj.EndPt[1 - farEnd], midpt);
+        float mom1 = MCSMom(tcx, slc, tj, tj.EndPt[farEnd], midpt);
+        float mom2 = MCSMom(tcx, slc, tj, tj.EndPt[1 - farEnd], midpt);
         float asym = (mom1 - mom2) / (mom1 + mom2);
         auto& farTP = tj.Pts[tj.EndPt[farEnd]];
         // IP btw the far end TP and the shower center
-        float doca = PointTrajDOCA(slc, stp0.Pos[0], stp0.Pos[1], farTP);
+        float doca = PointTrajDOCA(tcx, slc, stp0.Pos[0], stp0.Pos[1], farTP);
         float sep = PosSep(farTP.Pos, stp0.Pos);
         float dang = doca / sep;
         if (prt) {
@@ -2744,7 +2788,7 @@ namespace tca {
       if (bestMatch > 0) {
         auto& match = tjss[bestMatch];
         auto& ss = slc.cots[match.ssID - 1];
-        if (!AddTj(fcnLabel, slc, match.tjID, ss, true, prt)) {
+        if (!AddTj(fcnLabel, tcx, slc, match.tjID, ss, true, prt)) {
           if (prt) mf::LogVerbatim("TC") << " Failed";
           continue;
         }
@@ -2762,14 +2806,18 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  MergeSubShowers(std::string inFcnLabel, TCSlice& slc, const CTP_t& inCTP, bool prt)
+  MergeSubShowers(std::string inFcnLabel,
+                  TCContext& tcx,
+                  TCSlice& slc,
+                  const CTP_t& inCTP,
+                  bool prt)
   {
     // Merge small showers that are downstream of larger showers
 
-    if (!tcc.useAlg[kMergeSubShowers]) return;
+    if (!tcx.tcc.useAlg[kMergeSubShowers]) return;
 
     std::string fcnLabel = inFcnLabel + ".MSS";
-    bool newCuts = (tcc.showerTag[0] == 4);
+    bool newCuts = (tcx.tcc.showerTag[0] == 4);
     constexpr float radLen = 14 / 0.3;
 
     if (prt) {
@@ -2808,7 +2856,7 @@ namespace tca {
         // convert along95 to a separation btw shower max and along95
         along95 -= shMaxAlong;
         // convert to WSE
-        along95 /= tcc.wirePitch;
+        along95 /= tcx.tcc.wirePitch;
         for (unsigned short jj = ii + 1; jj < sortVec.size(); ++jj) {
           ShowerStruct& jss = slc.cots[sortVec[jj].index];
           if (jss.ID == 0) continue;
@@ -2845,10 +2893,10 @@ namespace tca {
             // Find the IP between them using the projection of the one with the lowest aspect ratio
             float delta = 9999;
             if (iss.AspectRatio < jss.AspectRatio) {
-              delta = PointTrajDOCA(slc, jstp1.Pos[0], jstp1.Pos[1], istp1);
+              delta = PointTrajDOCA(tcx, slc, jstp1.Pos[0], jstp1.Pos[1], istp1);
             }
             else {
-              delta = PointTrajDOCA(slc, istp1.Pos[0], istp1.Pos[1], jstp1);
+              delta = PointTrajDOCA(tcx, slc, istp1.Pos[0], istp1.Pos[1], jstp1);
             }
             // See if delta is consistent with the cone angle of the i shower
             float dang = delta / sep;
@@ -2862,7 +2910,7 @@ namespace tca {
           } // old cuts
 
           if (prt) mf::LogVerbatim("TC") << fcnLabel << " Merge them. Re-find shower center, etc";
-          if (MergeShowersAndStore(fcnLabel, slc, iss.ID, jss.ID, prt)) {
+          if (MergeShowersAndStore(fcnLabel, tcx, slc, iss.ID, jss.ID, prt)) {
             Trajectory& stj = slc.tjs[iss.ShowerTjID - 1];
             stj.AlgMod[kMergeSubShowers] = true;
             keepMerging = true;
@@ -2879,7 +2927,11 @@ namespace tca {
 
   ////////////////////////////////////////////////
   int
-  MergeShowers(std::string inFcnLabel, TCSlice& slc, std::vector<int> ssIDs, bool prt)
+  MergeShowers(std::string inFcnLabel,
+               TCContext& tcx,
+               TCSlice& slc,
+               std::vector<int> ssIDs,
+               bool prt)
   {
     // merge a list of showers and return the ID of the merged shower.
     // Returns 0 if there was a failure.
@@ -2926,7 +2978,7 @@ namespace tca {
     newss.SS3ID = ss3Assn;
 
     // define the new shower
-    if (!UpdateShower(fcnLabel, slc, newss, prt)) {
+    if (!UpdateShower(fcnLabel, tcx, slc, newss, prt)) {
       MakeShowerObsolete(fcnLabel, slc, newss, prt);
       return 0;
     }
@@ -2941,7 +2993,12 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  MergeShowersAndStore(std::string inFcnLabel, TCSlice& slc, int icotID, int jcotID, bool prt)
+  MergeShowersAndStore(std::string inFcnLabel,
+                       TCContext& tcx,
+                       TCSlice& slc,
+                       int icotID,
+                       int jcotID,
+                       bool prt)
   {
     // Merge showers using shower indices. The icotID shower is modified in-place.
     // The jcotID shower is declared obsolete. This function also re-defines the shower and
@@ -3003,8 +3060,8 @@ namespace tca {
     // force a full update
     iss.ShPts.clear();
     jss.ID = 0;
-    bool success = UpdateShower(fcnLabel, slc, iss, prt);
-    KillVerticesInShower(fcnLabel, slc, iss, prt);
+    bool success = UpdateShower(fcnLabel, tcx, slc, iss, prt);
+    KillVerticesInShower(fcnLabel, tcx, slc, iss, prt);
 
     return success;
 
@@ -3012,7 +3069,11 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  MergeShowerTjsAndStore(TCSlice& slc, unsigned short istj, unsigned short jstj, bool prt)
+  MergeShowerTjsAndStore(TCContext& tcx,
+                         TCSlice& slc,
+                         unsigned short istj,
+                         unsigned short jstj,
+                         bool prt)
   {
     // Merge showers using showerTj indices
     // This function is called from MergeAndStore whose function is to merge two line-like
@@ -3051,7 +3112,7 @@ namespace tca {
     if (jss.ID == 0) return false;
     if (jss.TjIDs.empty()) return false;
 
-    return MergeShowersAndStore(fcnLabel, slc, icotID, jcotID, prt);
+    return MergeShowersAndStore(fcnLabel, tcx, slc, icotID, jcotID, prt);
 
   } // MergeShowerTjsAndStore
 
@@ -3148,7 +3209,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  ReverseShower(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt)
+  ReverseShower(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, ShowerStruct& ss, bool prt)
   {
     // Reverses the shower and the shower tj
 
@@ -3171,20 +3232,20 @@ namespace tca {
     if (ss.DirectionFOM != 0) ss.DirectionFOM = 1 / ss.DirectionFOM;
     auto& stj = slc.tjs[ss.ShowerTjID - 1];
     ReverseTraj(slc, stj);
-    DefineEnvelope(fcnLabel, slc, ss, prt);
+    DefineEnvelope(fcnLabel, tcx, slc, ss, prt);
     if (prt) mf::LogVerbatim("TC") << fcnLabel << " Reversed shower. Shower angle = " << ss.Angle;
   } // ReverseShower
 
   ////////////////////////////////////////////////
   void
-  ReverseShower(std::string inFcnLabel, TCSlice& slc, int cotID, bool prt)
+  ReverseShower(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, int cotID, bool prt)
   {
     // Reverses the shower and the shower tj
 
     if (cotID > (int)slc.cots.size()) return;
     ShowerStruct& ss = slc.cots[cotID - 1];
     if (ss.ID == 0) return;
-    ReverseShower(inFcnLabel, slc, ss, prt);
+    ReverseShower(inFcnLabel, tcx, slc, ss, prt);
   }
 
   ////////////////////////////////////////////////
@@ -3271,16 +3332,16 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  TagShowerLike(std::string inFcnLabel, TCSlice& slc, const CTP_t& inCTP)
+  TagShowerLike(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, const CTP_t& inCTP)
   {
     // Tag Tjs as InShower if they have MCSMom < ShowerTag[1] and there are more than
     // ShowerTag[6] other Tjs with a separation < ShowerTag[2].
 
-    if (tcc.showerTag[0] <= 0) return;
+    if (tcx.tcc.showerTag[0] <= 0) return;
     if (slc.tjs.size() > 20000) return;
-    float typicalChgRMS = 0.5 * (tcc.chargeCuts[1] + tcc.chargeCuts[2]);
+    float typicalChgRMS = 0.5 * (tcx.tcc.chargeCuts[1] + tcx.tcc.chargeCuts[2]);
 
-    bool prt = (tcc.dbgSlc && tcc.dbg2S && inCTP == debug.CTP);
+    bool prt = (tcx.tcc.dbgSlc && tcx.tcc.dbg2S && inCTP == debug.CTP);
 
     // clear out old tags and make a list of Tjs to consider
     std::vector<std::vector<int>> tjLists;
@@ -3296,7 +3357,7 @@ namespace tca {
       for (unsigned short end = 0; end < 2; ++end)
         if (tj.EndFlag[end][kBragg]) skipit = true;
       if (skipit) continue;
-      short npwc = NumPtsWithCharge(slc, tj, false);
+      short npwc = NumPtsWithCharge(tcx, slc, tj, false);
       // Don't expect any (primary) electron to be reconstructed as a single trajectory for
       // more than ~2 radiation lengths ~ 30 cm for uB ~ 100 wires
       if (npwc > 100) continue;
@@ -3305,7 +3366,7 @@ namespace tca {
         // Increase the MCSMom cut if the Tj is long and the charge RMS is high to reduce sensitivity
         // to the fcl configuration. A primary electron may be reconstructed as one long Tj with large
         // charge rms and possibly high MCSMom or as several nearby shorter Tjs with lower charge rms
-        float momCut = tcc.showerTag[1];
+        float momCut = tcx.tcc.showerTag[1];
         if (tj.ChgRMS > typicalChgRMS) momCut *= tj.ChgRMS / typicalChgRMS;
         if (tj.MCSMom > momCut) continue;
       }
@@ -3319,10 +3380,10 @@ namespace tca {
       for (unsigned short it2 = it1 + 1; it2 < tjids.size(); ++it2) {
         Trajectory& tj2 = slc.tjs[tjids[it2] - 1];
         unsigned short ipt1, ipt2;
-        float doca = tcc.showerTag[2];
+        float doca = tcx.tcc.showerTag[2];
         // Find the separation between Tjs without considering dead wires
-        TrajTrajDOCA(slc, tj1, tj2, ipt1, ipt2, doca, false);
-        if (doca == tcc.showerTag[2]) continue;
+        TrajTrajDOCA(tcx, slc, tj1, tj2, ipt1, ipt2, doca, false);
+        if (doca == tcx.tcc.showerTag[2]) continue;
         // make tighter cuts for user-defined short Tjs
         // found a close pair. See if one of these is in an existing cluster of Tjs
         bool inlist = false;
@@ -3375,7 +3436,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  FindNearbyTjs(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt)
+  FindNearbyTjs(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, ShowerStruct& ss, bool prt)
   {
     // Find Tjs that are near the shower but are not included in it
     ss.NearTjIDs.clear();
@@ -3418,12 +3479,13 @@ namespace tca {
       if (std::find(ntj.begin(), ntj.end(), tj.ID) != ntj.end()) continue;
       // check proximity of long high MCSMom Tjs to the shower center
       if (tj.Pts.size() > 40 && tj.MCSMom > 200) {
-        float delta = PointTrajDOCA(slc, stj.Pts[1].Pos[0], stj.Pts[1].Pos[1], tj.Pts[tj.EndPt[0]]);
+        float delta =
+          PointTrajDOCA(tcx, slc, stj.Pts[1].Pos[0], stj.Pts[1].Pos[1], tj.Pts[tj.EndPt[0]]);
         // TODO: This could be done much better
         if (delta < 20) {
           float doca = fiveRadLen;
           unsigned short spt = 0, ipt = 0;
-          TrajTrajDOCA(slc, stj, tj, spt, ipt, doca);
+          TrajTrajDOCA(tcx, slc, stj, tj, spt, ipt, doca);
           if (doca < fiveRadLen) {
             ntj.push_back(tj.ID);
             continue;
@@ -3454,14 +3516,14 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  AddCloseTjsToList(TCSlice& slc, unsigned short itj, std::vector<int> list)
+  AddCloseTjsToList(TCContext& tcx, TCSlice& slc, unsigned short itj, std::vector<int> list)
   {
     // Searches the trajectory points for hits that are used in a different trajectory and add
     // them to the list if any are found, and the MCSMomentum is not too large
     if (itj > slc.tjs.size() - 1) return;
 
     //short maxMom = (short)(2 * tcc.showerTag[1]);
-    short maxMom = tcc.showerTag[1];
+    short maxMom = tcx.tcc.showerTag[1];
     //XL: why is maxMom is twice of the shower tag [1]?
     for (auto& tp : slc.tjs[itj].Pts) {
       for (unsigned short ii = 0; ii < tp.Hits.size(); ++ii) {
@@ -3484,7 +3546,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  DefineEnvelope(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt)
+  DefineEnvelope(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, ShowerStruct& ss, bool prt)
   {
 
     if (ss.ID == 0) return;
@@ -3505,10 +3567,10 @@ namespace tca {
     // the Pos[0] direction and then rotated into the ShowerTj direction. Use sTp1 as the origin.
     // First vertex
     ss.Envelope[0][0] = -PosSep(stp0.Pos, stp1.Pos);
-    ss.Envelope[0][1] = tcc.showerTag[5] + tcc.showerTag[4] * stp0.DeltaRMS;
+    ss.Envelope[0][1] = tcx.tcc.showerTag[5] + tcx.tcc.showerTag[4] * stp0.DeltaRMS;
     // second vertex
     ss.Envelope[1][0] = PosSep(stp1.Pos, stp2.Pos);
-    ss.Envelope[1][1] = tcc.showerTag[5] + tcc.showerTag[4] * stp2.DeltaRMS;
+    ss.Envelope[1][1] = tcx.tcc.showerTag[5] + tcx.tcc.showerTag[4] * stp2.DeltaRMS;
     // third and fourth are reflections of the first and second
     ss.Envelope[2][0] = ss.Envelope[1][0];
     ss.Envelope[2][1] = -ss.Envelope[1][1];
@@ -3536,7 +3598,7 @@ namespace tca {
       mf::LogVerbatim myprt("TC");
       myprt << fcnLabel << " 2S" << ss.ID << " Envelope";
       for (auto& vtx : ss.Envelope)
-        myprt << " " << (int)vtx[0] << ":" << (int)(vtx[1] / tcc.unitsPerTick);
+        myprt << " " << (int)vtx[0] << ":" << (int)(vtx[1] / tcx.tcc.unitsPerTick);
       myprt << " Area " << (int)ss.EnvelopeArea;
       myprt << " ChgDensity " << ss.ChgDensity;
     }
@@ -3546,7 +3608,11 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  AddTjsInsideEnvelope(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt)
+  AddTjsInsideEnvelope(std::string inFcnLabel,
+                       TCContext& tcx,
+                       TCSlice& slc,
+                       ShowerStruct& ss,
+                       bool prt)
   {
     // This function adds Tjs to the shower. It updates the shower parameters.
 
@@ -3585,7 +3651,7 @@ namespace tca {
       if (!end0Inside && !end1Inside) continue;
       if (end0Inside && end1Inside) {
         // TODO: See if the Tj direction is compatible with the shower?
-        if (AddTj(fcnLabel, slc, tj.ID, ss, false, prt)) ++nadd;
+        if (AddTj(fcnLabel, tcx, slc, tj.ID, ss, false, prt)) ++nadd;
         ++nadd;
         continue;
       } // both ends inside
@@ -3600,7 +3666,7 @@ namespace tca {
                                 << dangPull;
         if (dangPull > 2) continue;
       } // high momentum
-      if (AddTj(fcnLabel, slc, tj.ID, ss, false, prt)) { ++nadd; }
+      if (AddTj(fcnLabel, tcx, slc, tj.ID, ss, false, prt)) { ++nadd; }
       else {
         if (prt) mf::LogVerbatim("TC") << fcnLabel << " AddTj failed to add T" << tj.ID;
       }
@@ -3609,7 +3675,7 @@ namespace tca {
     if (nadd > 0) {
       if (prt) mf::LogVerbatim("TC") << fcnLabel << " Added " << nadd << " trajectories ";
       ss.NeedsUpdate = true;
-      UpdateShower(fcnLabel, slc, ss, prt);
+      UpdateShower(fcnLabel, tcx, slc, ss, prt);
       return true;
     }
     else {
@@ -3622,7 +3688,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  AddLooseHits(TCSlice& slc, int cotID, bool prt)
+  AddLooseHits(TCContext& tcx, TCSlice& slc, int cotID, bool prt)
   {
     // Add hits that are inside the envelope to the shower if they are loose, i.e. not
     // used by any trajectory. This function returns true if the set of hits is different than
@@ -3653,8 +3719,8 @@ namespace tca {
       if (vtx[1] < loTick) loTick = vtx[1];
       if (vtx[1] > hiTick) hiTick = vtx[1];
     } // vtx
-    loTick /= tcc.unitsPerTick;
-    hiTick /= tcc.unitsPerTick;
+    loTick /= tcx.tcc.unitsPerTick;
+    hiTick /= tcx.tcc.unitsPerTick;
     unsigned int loWire = std::nearbyint(fLoWire);
     unsigned int hiWire = std::nearbyint(fHiWire) + 1;
     if (hiWire > slc.lastWire[ipl] - 1) hiWire = slc.lastWire[ipl] - 1;
@@ -3667,14 +3733,14 @@ namespace tca {
       for (unsigned int iht = firstHit; iht < lastHit; ++iht) {
         // used in a trajectory?
         if (slc.slHits[iht].InTraj != 0) continue;
-        auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+        auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
         // inside the tick range?
         if (hit.PeakTime() < loTick) continue;
         // Note that hits are sorted by increasing time so we can break here
         if (hit.PeakTime() > hiTick) break;
         // see if this hit is inside the envelope
         point[0] = hit.WireID().Wire;
-        point[1] = hit.PeakTime() * tcc.unitsPerTick;
+        point[1] = hit.PeakTime() * tcx.tcc.unitsPerTick;
         if (!PointInsideEnvelope(point, ss.Envelope)) continue;
         newHits.push_back(iht);
       } // iht
@@ -3699,7 +3765,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  FindStartChg(std::string inFcnLabel, TCSlice& slc, int cotID, bool prt)
+  FindStartChg(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, int cotID, bool prt)
   {
     // Finds the charge at the start of a shower and puts it in AveChg of the first
     // point of the shower Tj. This is only done when there is no parent.
@@ -3716,7 +3782,7 @@ namespace tca {
 
     stp0.AveChg = 0;
 
-    if (ss.AspectRatio > tcc.showerTag[10] || ss.DirectionFOM > tcc.showerTag[9]) {
+    if (ss.AspectRatio > tcx.tcc.showerTag[10] || ss.DirectionFOM > tcx.tcc.showerTag[9]) {
       if (prt)
         mf::LogVerbatim("TC") << fcnLabel << " Not possible due to poor AspectRatio "
                               << ss.AspectRatio << " or ss.DirectionFOM " << ss.DirectionFOM;
@@ -3724,7 +3790,7 @@ namespace tca {
     }
 
     // Create and fill a vector of the charge at the beginning of the shower in 1 WSE bins
-    auto schg = StartChgVec(slc, cotID, prt);
+    auto schg = StartChgVec(tcx, slc, cotID, prt);
     if (schg.empty()) return;
 
     // Look for two consecutive charge entries. Use the second one
@@ -3820,7 +3886,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   std::vector<float>
-  StartChgVec(TCSlice& slc, int cotID, bool prt)
+  StartChgVec(TCContext& tcx, TCSlice& slc, int cotID, bool prt)
   {
     // Returns a histogram vector of the charge in bins of 1 WSE unit at the start of the shower
 
@@ -3849,13 +3915,13 @@ namespace tca {
       // Count the charge if it is within a few WSE transverse from the shower axis
       if (std::abs(sspt.RotPos[1]) > maxTrans) continue;
       unsigned int iht = sspt.HitIndex;
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       float peakTime = hit.PeakTime();
       float amp = hit.PeakAmplitude();
       float rms = hit.RMS();
       chgPos[0] = hit.WireID().Wire - stp1.Pos[0];
       for (float time = peakTime - 2.5 * rms; time < peakTime + 2.5 * rms; ++time) {
-        chgPos[1] = time * tcc.unitsPerTick - stp1.Pos[1];
+        chgPos[1] = time * tcx.tcc.unitsPerTick - stp1.Pos[1];
         along = cs * chgPos[0] - sn * chgPos[1];
         if (along < minAlong) continue;
         indx = (unsigned short)(along - minAlong);
@@ -4027,8 +4093,8 @@ namespace tca {
     for (auto cid : ss3.CotIDs)
       slc.cots[cid - 1].SS3ID = ss3.ID;
 
-    ++evt.global3S_UID;
-    ss3.UID = evt.global3S_UID;
+    ++slc.ids.global3S_UID;
+    ss3.UID = slc.ids.global3S_UID;
 
     slc.showers.push_back(ss3);
     return true;
@@ -4075,8 +4141,8 @@ namespace tca {
       if (tj.ID == ss.ParentID) tj.AlgMod[kShwrParent] = true;
     } // tjID
 
-    ++evt.global2S_UID;
-    ss.UID = evt.global2S_UID;
+    ++slc.ids.global2S_UID;
+    ss.UID = slc.ids.global2S_UID;
 
     slc.cots.push_back(ss);
     return true;
@@ -4208,7 +4274,10 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  PrintShowers(detinfo::DetectorPropertiesData const& detProp, std::string fcnLabel, TCSlice& slc)
+  PrintShowers(detinfo::DetectorPropertiesData const& detProp,
+               std::string fcnLabel,
+               TCContext& tcx,
+               TCSlice& slc)
   {
     if (slc.showers.empty()) return;
     mf::LogVerbatim myprt("TC");
@@ -4226,8 +4295,8 @@ namespace tca {
       std::vector<float> projInPlane(slc.nPlanes);
       for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
         CTP_t inCTP = EncodeCTP(ss3.TPCID.Cryostat, ss3.TPCID.TPC, plane);
-        auto tp = MakeBareTP(detProp, slc, ss3.ChgPos, ss3.Dir, inCTP);
-        myprt << " " << PrintPos(slc, tp.Pos);
+        auto tp = MakeBareTP(detProp, tcx, slc, ss3.ChgPos, ss3.Dir, inCTP);
+        myprt << " " << PrintPos(tcx, slc, tp.Pos);
         projInPlane[plane] = tp.Delta;
       } // plane
       myprt << " projInPlane";
@@ -4239,8 +4308,8 @@ namespace tca {
         myprt << "\n  2S" << ss.ID;
         auto& stj = slc.tjs[ss.ShowerTjID - 1];
         myprt << " ST" << stj.ID;
-        myprt << " " << PrintPos(slc, stj.Pts[stj.EndPt[0]].Pos) << " - "
-              << PrintPos(slc, stj.Pts[stj.EndPt[1]].Pos);
+        myprt << " " << PrintPos(tcx, slc, stj.Pts[stj.EndPt[0]].Pos) << " - "
+              << PrintPos(tcx, slc, stj.Pts[stj.EndPt[1]].Pos);
       } // ci
       if (ss3.NeedsUpdate) myprt << " *** Needs update";
       myprt << "\n";
@@ -4249,7 +4318,11 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  Print2DShowers(std::string someText, TCSlice& slc, CTP_t inCTP, bool printKilledShowers)
+  Print2DShowers(std::string someText,
+                 TCContext& tcx,
+                 TCSlice& slc,
+                 CTP_t inCTP,
+                 bool printKilledShowers)
   {
     // Prints a one-line summary of 2D showers
     if (slc.cots.empty()) return;
@@ -4277,7 +4350,7 @@ namespace tca {
       const auto& ss = slc.cots[ict];
       if (!printAllCTP && ss.CTP != inCTP) continue;
       if (!printKilledShowers && ss.ID == 0) continue;
-      PrintShower(someText, slc, ss, printHeader, printExtras);
+      PrintShower(someText, tcx, slc, ss, printHeader, printExtras);
       printHeader = false;
     } // ss
     // List of Tjs
@@ -4303,7 +4376,7 @@ namespace tca {
       myprt << std::setw(5) << sid;
       myprt << " Envelope";
       for (auto& vtx : ss.Envelope)
-        myprt << " " << (int)vtx[0] << ":" << (int)(vtx[1] / tcc.unitsPerTick);
+        myprt << " " << (int)vtx[0] << ":" << (int)(vtx[1] / tcx.tcc.unitsPerTick);
       myprt << "\n";
     } // ict
     // List of nearby Tjs
@@ -4339,6 +4412,7 @@ namespace tca {
   ////////////////////////////////////////////////
   void
   PrintShower(std::string someText,
+              TCContext& tcx,
               TCSlice& slc,
               const ShowerStruct& ss,
               bool printHeader,
@@ -4373,7 +4447,7 @@ namespace tca {
     if (stj.VtxID[0] > 0) vid = "2V" + std::to_string(stj.VtxID[0]);
     myprt << std::setw(5) << vid;
     for (auto& spt : stj.Pts) {
-      myprt << std::setw(10) << PrintPos(slc, spt.Pos);
+      myprt << std::setw(10) << PrintPos(tcx, slc, spt.Pos);
       myprt << std::setw(7) << std::fixed << std::setprecision(1) << spt.Chg / 1000;
       //        myprt<<std::setw(5)<<spt.NTPsFit;
       myprt << std::setw(5) << std::setprecision(1) << spt.DeltaRMS;
@@ -4412,7 +4486,7 @@ namespace tca {
     myprt << std::setw(5) << sid;
     myprt << " Envelope";
     for (auto& vtx : ss.Envelope)
-      myprt << " " << (int)vtx[0] << ":" << (int)(vtx[1] / tcc.unitsPerTick);
+      myprt << " " << (int)vtx[0] << ":" << (int)(vtx[1] / tcx.tcc.unitsPerTick);
     myprt << "\n";
     myprt << someText << std::fixed;
     sid = "2S" + std::to_string(ss.ID);
@@ -24,33 +24,63 @@ namespace tca {
 
   void ConfigureMVA(TCConfig& tcc, std::string fMVAShowerParentWeights);
   bool FindShowerStart(detinfo::DetectorPropertiesData const& detProp,
+                       TCContext& tcx,
                        TCSlice& slc,
                        ShowerStruct3D& ss3,
                        bool prt);
-  void KillVerticesInShower(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt);
-  void Finish3DShowers(TCSlice& slc);
-  bool FindShowers3D(detinfo::DetectorPropertiesData const& detProp, TCSlice& slc);
-  bool Reconcile3D(std::string inFcnLabel, TCSlice& slc, bool parentSearchDone, bool prt);
-  bool Reconcile3D(std::string inFcnLabel, TCSlice& slc, ShowerStruct3D& ss3, bool prt);
-  bool MergeShowerTjsAndStore(TCSlice& slc, unsigned short istj, unsigned short jstj, bool prt);
+  void KillVerticesInShower(std::string inFcnLabel,
+                            TCContext& tcx,
+                            TCSlice& slc,
+                            ShowerStruct& ss,
+                            bool prt);
+  void Finish3DShowers(TCContext& tcx, TCSlice& slc);
+  bool FindShowers3D(detinfo::DetectorPropertiesData const& detProp,
+                     TCContext& tcx,
+                     TCSlice& slc);
+  bool Reconcile3D(std::string inFcnLabel,
+                   TCContext& tcx,
+                   TCSlice& slc,
+                   bool parentSearchDone,
+                   bool prt);
+  bool Reconcile3D(std::string inFcnLabel,
+                   TCContext& tcx,
+                   TCSlice& slc,
+                   ShowerStruct3D& ss3,
+                   bool prt);
+  bool MergeShowerTjsAndStore(TCContext& tcx,
+                              TCSlice& slc,
+                              unsigned short istj,
+                              unsigned short jstj,
+                              bool prt);
   bool TransferTjHits(TCSlice& slc, bool prt);
   int GetCotID(TCSlice& slc, int ShowerTjID);
 
   bool CompleteIncompleteShower(std::string inFcnLabel,
+                                TCContext& tcx,
                                 TCSlice& slc,
                                 ShowerStruct3D& ss3,
                                 bool prt);
   void Match2DShowers(std::string inFcnLabel, TCSlice& slc, bool prt);
-  bool UpdateShower(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt);
-  bool UpdateShower(std::string inFcnLabel, TCSlice& slc, ShowerStruct3D& ss3, bool prt);
+  bool UpdateShower(std::string inFcnLabel,
+                    TCContext& tcx,
+                    TCSlice& slc,
+                    ShowerStruct& ss,
+                    bool prt);
+  bool UpdateShower(std::string inFcnLabel,
+                    TCContext& tcx,
+                    TCSlice& slc,
+                    ShowerStruct3D& ss3,
+                    bool prt);
   float Match3DFOM(detinfo::DetectorPropertiesData const& detProp,
                    std::string inFcnLabel,
+                   TCContext& tcx,
                    TCSlice& slc,
                    int icotID,
                    int jcotID,
                    bool prt);
   float Match3DFOM(detinfo::DetectorPropertiesData const& detProp,
                    std::string inFcnLabel,
+                   TCContext& tcx,
                    TCSlice& slc,
                    int icotID,
                    int jcotID,
@@ -58,6 +88,7 @@ namespace tca {
                    bool prt);
   float Match3DFOM(detinfo::DetectorPropertiesData const& detProp,
                    std::string inFcnLabel,
+                   TCContext& tcx,
                    TCSlice& slc,
                    ShowerStruct3D& ss3,
                    bool prt);
@@ -66,45 +97,56 @@ namespace tca {
   bool DontCluster(TCSlice& slc, const std::vector<int>& tjlist1, const std::vector<int>& tjlist2);
   void DefineDontCluster(TCSlice& slc, bool prt);
   bool RemovePFP(std::string inFcnLabel,
+                 TCContext& tcx,
                  TCSlice& slc,
                  PFPStruct& pfp,
                  ShowerStruct3D& ss3,
                  bool doUpdate,
                  bool prt);
   bool AddPFP(std::string inFcnLabel,
+              TCContext& tcx,
               TCSlice& slc,
               int pID,
               ShowerStruct3D& ss3,
               bool doUpdate,
               bool prt);
   bool RemovePFP(std::string inFcnLabel,
+                 TCContext& tcx,
                  TCSlice& slc,
                  int pID,
                  ShowerStruct3D& ss3,
                  bool doUpdate,
                  bool prt);
   bool AddTj(std::string inFcnLabel,
+             TCContext& tcx,
              TCSlice& slc,
              int TjID,
              ShowerStruct& ss,
              bool doUpdate,
              bool prt);
   bool RemoveTj(std::string inFcnLabel,
+                TCContext& tcx,
                 TCSlice& slc,
                 int TjID,
                 ShowerStruct& ss,
                 bool doUpdate,
                 bool prt);
   bool AnalyzeRotPos(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt);
-  void ReverseShower(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt);
-  void ReverseShower(std::string inFcnLabel, TCSlice& slc, int cotID, bool prt);
+  void ReverseShower(std::string inFcnLabel,
+                     TCContext& tcx,
+                     TCSlice& slc,
+                     ShowerStruct& ss,
+                     bool prt);
+  void ReverseShower(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, int cotID, bool prt);
   bool FindParent(detinfo::DetectorPropertiesData const& detProp,
                   std::string inFcnLabel,
+                  TCContext& tcx,
                   TCSlice& slc,
                   ShowerStruct3D& ss3,
                   bool prt);
   bool SetParent(detinfo::DetectorPropertiesData const& detProp,
                  std::string inFcnLabel,
+                 TCContext& tcx,
                  TCSlice& slc,
                  PFPStruct& pfp,
                  ShowerStruct3D& ss3,
@@ -116,20 +158,22 @@ namespace tca {
                     ShowerStruct& ss,
                     bool prt);
   bool IsShowerLike(TCSlice& slc, const std::vector<int> TjIDs);
-  float InShowerProb(TCSlice& slc, const ShowerStruct3D& ss3, const PFPStruct& pfp);
-  float InShowerProb(TCSlice& slc, const ShowerStruct& ss, const Trajectory& tj);
+  float InShowerProb(TCContext& tcx, TCSlice& slc, const ShowerStruct3D& ss3, const PFPStruct& pfp);
+  float InShowerProb(TCContext& tcx, TCSlice& slc, const ShowerStruct& ss, const Trajectory& tj);
   void ShowerParams(double showerEnergy, double& shMaxAlong, double& shE95Along);
   double ShowerParamTransRMS(double showerEnergy, double along);
   double InShowerProbLong(double showerEnergy, double along);
   double InShowerProbTrans(double showerEnergy, double along, double trans);
-  double InShowerProb(double showerEnergy, double along, double trans);
+  double InShowerProb(TCContext& tcx, double showerEnergy, double along, double trans);
   float ParentFOM(std::string inFcnLabel,
+                  TCContext& tcx,
                   TCSlice& slc,
                   PFPStruct& pfp,
                   unsigned short pend,
                   ShowerStruct3D& ss3,
                   bool prt);
   float ParentFOM(std::string inFcnLabel,
+                  TCContext& tcx,
                   TCSlice& slc,
                   Trajectory& tj,
                   unsigned short& tjEnd,
@@ -137,11 +181,19 @@ namespace tca {
                   float& tp1Sep,
                   float& vx3Score,
                   bool prt);
-  void DefineEnvelope(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt);
-  bool AddTjsInsideEnvelope(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt);
-  bool AddLooseHits(std::string inFcnLabel, TCSlice& slc, int cotID, bool prt);
-  void FindStartChg(std::string inFcnLabel, TCSlice& slc, int cotID, bool prt);
-  std::vector<float> StartChgVec(TCSlice& slc, int cotID, bool prt);
+  void DefineEnvelope(std::string inFcnLabel,
+                      TCContext& tcx,
+                      TCSlice& slc,
+                      ShowerStruct& ss,
+                      bool prt);
+  bool AddTjsInsideEnvelope(std::string inFcnLabel,
+                            TCContext& tcx,
+                            TCSlice& slc,
+                            ShowerStruct& ss,
+                            bool prt);
+  bool AddLooseHits(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, int cotID, bool prt);
+  void FindStartChg(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, int cotID, bool prt);
+  std::vector<float> StartChgVec(TCContext& tcx, TCSlice& slc, int cotID, bool prt);
   void DumpShowerPts(std::string inFcnLabel, TCSlice& slc, int cotID);
 
   void FindCots(std::string inFcnLabel,
@@ -149,9 +201,14 @@ namespace tca {
                 const CTP_t& inCTP,
                 std::vector<std::vector<int>>& tjLists,
                 bool prt);
-  void TagShowerLike(std::string inFcnLabel, TCSlice& slc, const CTP_t& inCTP);
-  void FindNearbyTjs(std::string inFcnLabel, TCSlice& slc, ShowerStruct& ss, bool prt);
+  void TagShowerLike(std::string inFcnLabel, TCContext& tcx, TCSlice& slc, const CTP_t& inCTP);
+  void FindNearbyTjs(std::string inFcnLabel,
+                     TCContext& tcx,
+                     TCSlice& slc,
+                     ShowerStruct& ss,
+                     bool prt);
   void AddCloseTjsToList(std::string inFcnLabel,
+                         TCContext& tcx,
                          TCSlice& slc,
                          unsigned short itj,
                          std::vector<int> list);
@@ -160,13 +217,42 @@ namespace tca {
                     TCSlice& slc,
                     std::vector<std::vector<int>>& tjList,
                     bool prt);
-  void MergeNearby2DShowers(std::string inFcnLabel, TCSlice& slc, const CTP_t& inCTP, bool prt);
-  void MergeOverlap(std::string inFcnLabel, TCSlice& slc, const CTP_t& inCTP, bool prt);
-  void MergeShowerChain(std::string inFcnLabel, TCSlice& slc, const CTP_t& inCTP, bool prt);
-  void MergeSubShowersTj(std::string inFcnLabel, TCSlice& slc, const CTP_t& inCTP, bool prt);
-  void MergeSubShowers(std::string inFcnLabel, TCSlice& slc, const CTP_t& inCTP, bool prt);
-  int MergeShowers(std::string inFcnLabel, TCSlice& slc, std::vector<int> showerIDs, bool prt);
-  bool MergeShowersAndStore(std::string inFcnLabel, TCSlice& slc, int icotID, int jcotID, bool prt);
+  void MergeNearby2DShowers(std::string inFcnLabel,
+                            TCContext& tcx,
+                            TCSlice& slc,
+                            const CTP_t& inCTP,
+                            bool prt);
+  void MergeOverlap(std::string inFcnLabel,
+                    TCContext& tcx,
+                    TCSlice& slc,
+                    const CTP_t& inCTP,
+                    bool prt);
+  void MergeShowerChain(std::string inFcnLabel,
+                        TCContext& tcx,
+                        TCSlice& slc,
+                        const CTP_t& inCTP,
+                        bool prt);
+  void MergeSubShowersTj(std::string inFcnLabel,
+                         TCContext& tcx,
+                         TCSlice& slc,
+                         const CTP_t& inCTP,
+                         bool prt);
+  void MergeSubShowers(std::string inFcnLabel,
+                       TCContext& tcx,
+                       TCSlice& slc,
+                       const CTP_t& inCTP,
+                       bool prt);
+  int MergeShowers(std::string inFcnLabel,
+                   TCContext& tcx,
+                   TCSlice& slc,
+                   std::vector<int> showerIDs,
+                   bool prt);
+  bool MergeShowersAndStore(std::string inFcnLabel,
+                            TCContext& tcx,
+                            TCSlice& slc,
+                            int icotID,
+                            int jcotID,
+                            bool prt);
   double ShowerEnergy(const ShowerStruct3D& ss3);
   float ShowerEnergy(TCSlice& slc, const std::vector<int> tjIDs);
   float ChgToMeV(float chg);
@@ -178,9 +264,15 @@ namespace tca {
   bool ChkAssns(std::string inFcnLabel, TCSlice& slc);
   void PrintShowers(detinfo::DetectorPropertiesData const& detProp,
                     std::string someText,
+                    TCContext& tcx,
                     TCSlice& slc);
-  void Print2DShowers(std::string someText, TCSlice& slc, CTP_t inCTP, bool printKilledShowers);
+  void Print2DShowers(std::string someText,
+                      TCContext& tcx,
+                      TCSlice& slc,
+                      CTP_t inCTP,
+                      bool printKilledShowers);
   void PrintShower(std::string someText,
+                   TCContext& tcx,
                    TCSlice& slc,
                    const ShowerStruct& ss,
                    bool printHeader,
@@ -42,21 +42,21 @@ namespace tca {
 
   //////////////////////////////////////////
   void
-  MakeJunkVertices(TCSlice& slc, const CTP_t& inCTP)
+  MakeJunkVertices(TCContext& tcx, TCSlice& slc, const CTP_t& inCTP)
   {
     // Vertices between poorly reconstructed tjs (especially junk slc) and normal
     // tjs can fail because the junk tj trajectory parameters are inaccurate. This function
     // uses proximity and not pointing to make junk vertices
     // Don't use this if standard vertex reconstruction is disabled
-    if (tcc.vtx2DCuts[0] <= 0) return;
-    if (!tcc.useAlg[kJunkVx]) return;
+    if (tcx.tcc.vtx2DCuts[0] <= 0) return;
+    if (!tcx.tcc.useAlg[kJunkVx]) return;
     if (slc.tjs.size() < 2) return;
 
     // Look for tjs that are within maxSep of the end of a Tj
     constexpr float maxSep = 4;
 
     geo::PlaneID planeID = DecodeCTP(inCTP);
-    bool prt = (tcc.dbgVxJunk && tcc.dbgSlc);
+    bool prt = (tcx.tcc.dbgVxJunk && tcx.tcc.dbgSlc);
     if (prt) {
       mf::LogVerbatim("TC") << "MakeJunkVertices: prt set for plane " << planeID.Plane
                             << " maxSep btw tjs " << maxSep;
@@ -73,7 +73,7 @@ namespace tca {
     // put in generous errors
     junkVx.PosErr = {{2.0, 2.0}};
     // define a minimal score so it won't get clobbered
-    junkVx.Score = tcc.vtx2DCuts[7] + 0.1;
+    junkVx.Score = tcx.tcc.vtx2DCuts[7] + 0.1;
 
     // look at both ends of long tjs
     for (unsigned short it1 = 0; it1 < slc.tjs.size() - 1; ++it1) {
@@ -89,7 +89,7 @@ namespace tca {
         if (tj1.VtxID[end1] > 0) continue;
         auto& tp1 = tj1.Pts[tj1.EndPt[end1]];
         // get a list of tjs in this vicinity
-        auto tjlist = FindCloseTjs(slc, tp1, tp1, maxSep);
+        auto tjlist = FindCloseTjs(tcx, slc, tp1, tp1, maxSep);
         if (tjlist.empty()) continue;
         // set to an invalid ID
         junkVx.ID = USHRT_MAX;
@@ -110,7 +110,7 @@ namespace tca {
           }   // end2
           if (closeEnd > 1) continue;
           auto& tp2 = tj2.Pts[tj2.EndPt[closeEnd]];
-          bool signalBetween = SignalBetween(slc, tp1, tp2, 0.8);
+          bool signalBetween = SignalBetween(tcx, slc, tp1, tp2, 0.8);
           if (!signalBetween) continue;
           if (junkVx.ID == USHRT_MAX) {
             // define the new vertex
@@ -133,7 +133,7 @@ namespace tca {
         if (prt) {
           mf::LogVerbatim("TC") << " New junk 2V" << junkVx.ID << " at " << std::fixed
                                 << std::setprecision(1) << junkVx.Pos[0] << ":"
-                                << junkVx.Pos[1] / tcc.unitsPerTick;
+                                << junkVx.Pos[1] / tcx.tcc.unitsPerTick;
         } // prt
         junkVx.ID = USHRT_MAX;
       } // end1
@@ -144,6 +144,7 @@ namespace tca {
   //////////////////////////////////////////
   void
   Find2DVertices(detinfo::DetectorPropertiesData const& detProp,
+                 TCContext& tcx,
                  TCSlice& slc,
                  const CTP_t& inCTP,
                  unsigned short pass)
@@ -166,7 +167,7 @@ namespace tca {
     // 9 max MCSmom asymmetry for a merge
     // 10 Require charge on wires between a vtx and the start of the tjs in induction planes? (1 = yes)
 
-    if (tcc.vtx2DCuts[0] <= 0) return;
+    if (tcx.tcc.vtx2DCuts[0] <= 0) return;
     if (slc.tjs.size() < 2) return;
 
     bool firstPassCuts = (pass == 0);
@@ -175,16 +176,16 @@ namespace tca {
 
     // require charge between the vertex and the tj start points?
     bool requireVtxTjChg = true;
-    if (tcc.vtx2DCuts[10] == 0 && int(planeID.Plane) < slc.nPlanes - 1) requireVtxTjChg = false;
+    if (tcx.tcc.vtx2DCuts[10] == 0 && int(planeID.Plane) < slc.nPlanes - 1) requireVtxTjChg = false;
 
-    bool prt = (tcc.dbg2V && tcc.dbgSlc && debug.Plane == (int)planeID.Plane);
+    bool prt = (tcx.tcc.dbg2V && tcx.tcc.dbgSlc && debug.Plane == (int)planeID.Plane);
     if (prt) {
       mf::LogVerbatim("TC") << "prt set for CTP " << inCTP << " in Find2DVertices. firstPassCuts? "
                             << firstPassCuts << " requireVtxTjChg " << requireVtxTjChg;
-      PrintAllTraj(detProp, "F2DVi", slc, USHRT_MAX, slc.tjs.size());
+      PrintAllTraj(detProp, "F2DVi", tcx, slc, USHRT_MAX, slc.tjs.size());
     }
 
-    unsigned short maxShortTjLen = tcc.vtx2DCuts[0];
+    unsigned short maxShortTjLen = tcx.tcc.vtx2DCuts[0];
     for (unsigned short it1 = 0; it1 < slc.tjs.size() - 1; ++it1) {
       auto& tj1 = slc.tjs[it1];
       if (tj1.AlgMod[kKilled] || tj1.AlgMod[kHaloTj]) continue;
@@ -224,7 +225,7 @@ namespace tca {
           if (tj2.SSID > 0 || tj2.AlgMod[kShowerLike]) continue;
           if (tj2.CTP != inCTP) continue;
           if (tj1.VtxID[end1] > 0) continue;
-          if (tj1.MCSMom < tcc.vtx2DCuts[5] && tj2.MCSMom < tcc.vtx2DCuts[5]) continue;
+          if (tj1.MCSMom < tcx.tcc.vtx2DCuts[5] && tj2.MCSMom < tcx.tcc.vtx2DCuts[5]) continue;
           bool tj2Short = (TrajLength(tj2) < maxShortTjLen);
           // find the end that is closer to tp1
           unsigned short end2 = 0;
@@ -262,28 +263,28 @@ namespace tca {
           float wint, tint;
           TrajIntersection(tp1, tp2, wint, tint);
           // make sure this is inside the TPC.
-          if (wint < 0 || wint > tcc.maxPos0[planeID.Plane] - 3) continue;
-          if (tint < 0 || tint > tcc.maxPos1[planeID.Plane]) continue;
+          if (wint < 0 || wint > tcx.tcc.maxPos0[planeID.Plane] - 3) continue;
+          if (tint < 0 || tint > tcx.tcc.maxPos1[planeID.Plane]) continue;
           // Next cut on separation between the TPs and the intersection point
-          if (tj1Short || tj2Short) { sepCut = tcc.vtx2DCuts[1]; }
+          if (tj1Short || tj2Short) { sepCut = tcx.tcc.vtx2DCuts[1]; }
           else {
-            sepCut = tcc.vtx2DCuts[2];
+            sepCut = tcx.tcc.vtx2DCuts[2];
           }
           // NewVtxCuts: require close separation on the first pass
-          if (firstPassCuts) sepCut = tcc.vtx2DCuts[1];
+          if (firstPassCuts) sepCut = tcx.tcc.vtx2DCuts[1];
           Point2_t vPos{{wint, tint}};
           float vt1Sep = PosSep(vPos, tp1.Pos);
           float vt2Sep = PosSep(vPos, tp2.Pos);
-          float dwc1 = DeadWireCount(slc, wint, tp1.Pos[0], tp1.CTP);
-          float dwc2 = DeadWireCount(slc, wint, tp2.Pos[0], tp1.CTP);
+          float dwc1 = DeadWireCount(tcx, slc, wint, tp1.Pos[0], tp1.CTP);
+          float dwc2 = DeadWireCount(tcx, slc, wint, tp2.Pos[0], tp1.CTP);
           vt1Sep -= dwc1;
           vt2Sep -= dwc2;
-          bool vtxOnDeadWire = (DeadWireCount(slc, wint, wint, tp1.CTP) == 1);
+          bool vtxOnDeadWire = (DeadWireCount(tcx, slc, wint, wint, tp1.CTP) == 1);
           if (prt && vt1Sep < 200 && vt2Sep < 200) {
             mf::LogVerbatim myprt("TC");
             myprt << "F2DV candidate T" << tj1.ID << "_" << end1 << "-T" << tj2.ID << "_" << end2;
-            myprt << " vtx pos " << (int)wint << ":" << (int)(tint / tcc.unitsPerTick) << " tp1 "
-                  << PrintPos(slc, tp1) << " tp2 " << PrintPos(slc, tp2);
+            myprt << " vtx pos " << (int)wint << ":" << (int)(tint / tcx.tcc.unitsPerTick)
+                  << " tp1 " << PrintPos(tcx, slc, tp1) << " tp2 " << PrintPos(tcx, slc, tp2);
             myprt << " dwc1 " << dwc1 << " dwc2 " << dwc2 << " on dead wire? " << vtxOnDeadWire;
             myprt << " vt1Sep " << vt1Sep << " vt2Sep " << vt2Sep << " sepCut " << sepCut;
           }
@@ -291,13 +292,13 @@ namespace tca {
           // make sure that the other end isn't closer
           if (PosSep(vPos, slc.tjs[it1].Pts[oendPt1].Pos) < vt1Sep) {
             if (prt)
-              mf::LogVerbatim("TC") << " tj1 other end " << PrintPos(slc, tj1.Pts[oendPt1])
+              mf::LogVerbatim("TC") << " tj1 other end " << PrintPos(tcx, slc, tj1.Pts[oendPt1])
                                     << " is closer to the vertex";
             continue;
           }
           if (PosSep(vPos, slc.tjs[it2].Pts[oendPt2].Pos) < vt2Sep) {
             if (prt)
-              mf::LogVerbatim("TC") << " tj2 other end " << PrintPos(slc, tj2.Pts[oendPt2])
+              mf::LogVerbatim("TC") << " tj2 other end " << PrintPos(tcx, slc, tj2.Pts[oendPt2])
                                     << " is closer to the vertex";
             continue;
           }
@@ -307,7 +308,7 @@ namespace tca {
           if (!TrajClosestApproach(tj1, wint, tint, closePt1, doca1)) continue;
           // dpt1 (and dpt2) will be 0 if the vertex is at the end
           short stepDir = -1;
-          if (tcc.modes[kStepDir]) stepDir = 1;
+          if (tcx.tcc.modes[kStepDir]) stepDir = 1;
           short dpt1 = stepDir * (closePt1 - endPt1);
           if (prt)
             mf::LogVerbatim("TC") << " endPt1 " << endPt1 << " closePt1 " << closePt1 << " dpt1 "
@@ -340,17 +341,18 @@ namespace tca {
           if (tj1.EndFlag[end1][kAtKink]) fixVxPos = true;
           if (prt)
             mf::LogVerbatim("TC") << " wint:tint " << (int)wint << ":"
-                                  << (int)(tint / tcc.unitsPerTick) << " fixVxPos? " << fixVxPos;
+                                  << (int)(tint / tcx.tcc.unitsPerTick) << " fixVxPos? "
+                                  << fixVxPos;
           if (requireVtxTjChg) {
             // ensure that there is a signal between these TPs and the vertex on most of the wires
             bool signalBetween = true;
             short dpt = abs(wint - tp1.Pos[0]);
-            if (dpt > 2 && !SignalBetween(slc, tp1, wint, tcc.vtx2DCuts[6])) {
+            if (dpt > 2 && !SignalBetween(tcx, slc, tp1, wint, tcx.tcc.vtx2DCuts[6])) {
               if (prt) mf::LogVerbatim("TC") << " Fails SignalBetween for tp1 " << dpt;
               signalBetween = false;
             }
             dpt = abs(wint - tp2.Pos[0]);
-            if (dpt > 2 && !SignalBetween(slc, tp2, wint, tcc.vtx2DCuts[6])) {
+            if (dpt > 2 && !SignalBetween(tcx, slc, tp2, wint, tcx.tcc.vtx2DCuts[6])) {
               if (prt) mf::LogVerbatim("TC") << " Fails SignalBetween for tp2 " << dpt;
               signalBetween = false;
             }
@@ -359,14 +361,15 @@ namespace tca {
             if (!signalBetween) {
               unsigned short ipt1, ipt2;
               float maxSep = 3;
-              bool isClose = TrajTrajDOCA(slc, tj1, tj2, ipt1, ipt2, maxSep, false);
+              bool isClose = TrajTrajDOCA(tcx, slc, tj1, tj2, ipt1, ipt2, maxSep, false);
               // require that they are close at the correct end
               if (isClose) isClose = (abs(ipt1 - endPt1) < 4 && abs(ipt2 - endPt2) < 4);
               if (isClose) {
                 if (prt)
                   mf::LogVerbatim("TC")
                     << " TrajTrajDOCA are close with minSep " << maxSep << " near "
-                    << PrintPos(slc, tj1.Pts[ipt1].Pos) << " " << PrintPos(slc, tj2.Pts[ipt2].Pos);
+                    << PrintPos(tcx, slc, tj1.Pts[ipt1].Pos) << " "
+                    << PrintPos(tcx, slc, tj2.Pts[ipt2].Pos);
                 // put the vertex at the TP that is closest to the intersection point
                 Point2_t vpos = {{wint, tint}};
                 if (PosSep2(tp1.Pos, vpos) < PosSep2(tp2.Pos, vpos)) {
@@ -380,7 +383,7 @@ namespace tca {
                 fixVxPos = true;
                 if (prt)
                   mf::LogVerbatim("TC")
-                    << " new wint:tint " << (int)wint << ":" << (int)(tint / tcc.unitsPerTick);
+                    << " new wint:tint " << (int)wint << ":" << (int)(tint / tcx.tcc.unitsPerTick);
               }
               else {
                 // closest approach > 3
@@ -408,14 +411,14 @@ namespace tca {
           aVtx.ID = newVtxID;
           tj1.VtxID[end1] = newVtxID;
           tj2.VtxID[end2] = newVtxID;
-          if (!FitVertex(slc, aVtx, prt)) {
+          if (!FitVertex(tcx, slc, aVtx, prt)) {
             tj1.VtxID[end1] = 0;
             tj2.VtxID[end2] = 0;
             continue;
           }
           // check proximity to nearby vertices
-          unsigned short mergeMeWithVx = IsCloseToVertex(slc, aVtx);
-          if (mergeMeWithVx > 0 && MergeWithVertex(slc, aVtx, mergeMeWithVx)) {
+          unsigned short mergeMeWithVx = IsCloseToVertex(tcx, slc, aVtx);
+          if (mergeMeWithVx > 0 && MergeWithVertex(tcx, slc, aVtx, mergeMeWithVx)) {
             if (prt) mf::LogVerbatim("TC") << " Merged with close vertex " << mergeMeWithVx;
             continue;
           }
@@ -426,27 +429,27 @@ namespace tca {
             myprt << " New vtx 2V" << aVtx.ID;
             myprt << " Tjs " << tj1.ID << "_" << end1 << "-" << tj2.ID << "_" << end2;
             myprt << " at " << std::fixed << std::setprecision(1) << aVtx.Pos[0] << ":"
-                  << aVtx.Pos[1] / tcc.unitsPerTick;
+                  << aVtx.Pos[1] / tcx.tcc.unitsPerTick;
           }
-          AttachAnyTrajToVertex(slc, slc.vtxs.size() - 1, prt);
-          SetVx2Score(slc);
+          AttachAnyTrajToVertex(tcx, slc, slc.vtxs.size() - 1, prt);
+          SetVx2Score(tcx, slc);
         } // it2
       }   // end1
     }     // it1
 
     // only call these on the last pass
     if (pass == USHRT_MAX) {
-      FindHammerVertices(slc, inCTP);
-      FindHammerVertices2(slc, inCTP);
+      FindHammerVertices(tcx, slc, inCTP);
+      FindHammerVertices2(tcx, slc, inCTP);
     }
 
-    if (prt) PrintAllTraj(detProp, "F2DVo", slc, USHRT_MAX, USHRT_MAX);
+    if (prt) PrintAllTraj(detProp, "F2DVo", tcx, slc, USHRT_MAX, USHRT_MAX);
 
   } // Find2DVertices
 
   //////////////////////////////////////////
   bool
-  MergeWithVertex(TCSlice& slc, VtxStore& vx, unsigned short oVxID)
+  MergeWithVertex(TCContext& tcx, TCSlice& slc, VtxStore& vx, unsigned short oVxID)
   {
     // Attempts to merge the trajectories attached to vx with an existing 2D vertex
     // referenced by existingVxID. This function doesn't use the existing end0/end1 vertex association.
@@ -454,9 +457,9 @@ namespace tca {
     // not store vx. The calling function needs to have set VtxID to vx.ID for tjs that are currently attached
     // to vx. It assumed that vx hasn't yet been pushed onto slc.vtxs
 
-    if (!tcc.useAlg[kVxMerge]) return false;
+    if (!tcx.tcc.useAlg[kVxMerge]) return false;
 
-    bool prt = tcc.dbgVxMerge && tcc.dbgSlc;
+    bool prt = tcx.tcc.dbgVxMerge && tcx.tcc.dbgSlc;
 
     if (oVxID > slc.vtxs.size()) return false;
     auto& oVx = slc.vtxs[oVxID - 1];
@@ -483,7 +486,7 @@ namespace tca {
           if (tj.VtxID[end] == vx.ID) tj.VtxID[end] = oVx.ID;
         } // end
       }   // tjid
-      if (!FitVertex(slc, oVx, prt)) {
+      if (!FitVertex(tcx, slc, oVx, prt)) {
         if (prt)
           mf::LogVerbatim("TC") << "MWV: merge failed " << vx.ID << " and existing " << oVx.ID;
         return false;
@@ -516,7 +519,7 @@ namespace tca {
     vpos[1] = 0.5 * (vx.Pos[1] + oVx.Pos[1]);
     for (unsigned short ii = 0; ii < tjpts.size(); ++ii) {
       auto& tj = slc.tjs[tjlist[ii] - 1];
-      unsigned short npwc = NumPtsWithCharge(slc, tj, false);
+      unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
       unsigned short end = CloseEnd(slc, tj, vpos);
       // assume that we will use the end point of the tj
       unsigned short endPt = tj.EndPt[end];
@@ -548,13 +551,13 @@ namespace tca {
       myprt << " Fit TPs";
       for (unsigned short ii = 0; ii < tjpts.size(); ++ii) {
         auto& tjpt = tjpts[ii];
-        myprt << " " << tjlist[ii] << "_" << tjpt.Step << "_" << PrintPos(slc, tjpt.Pos);
+        myprt << " " << tjlist[ii] << "_" << tjpt.Step << "_" << PrintPos(tcx, slc, tjpt.Pos);
       }
     } // prt
     // create a subset of the first two for the first fit
     auto fitpts = tjpts;
     fitpts.resize(2);
-    if (!FitVertex(slc, aVx, fitpts, prt)) {
+    if (!FitVertex(tcx, slc, aVx, fitpts, prt)) {
       if (prt) mf::LogVerbatim("TC") << "MWV: first fit failed ";
       return false;
     }
@@ -562,7 +565,7 @@ namespace tca {
     bool needsUpdate = false;
     for (unsigned short ii = 2; ii < tjlist.size(); ++ii) {
       fitpts.push_back(tjpts[ii]);
-      if (FitVertex(slc, aVx, fitpts, prt)) { needsUpdate = false; }
+      if (FitVertex(tcx, slc, aVx, fitpts, prt)) { needsUpdate = false; }
       else {
         // remove the last Tj point and keep going
         fitpts.pop_back();
@@ -570,7 +573,7 @@ namespace tca {
       }
     } // ii
 
-    if (needsUpdate) FitVertex(slc, aVx, fitpts, prt);
+    if (needsUpdate) FitVertex(tcx, slc, aVx, fitpts, prt);
     if (prt) mf::LogVerbatim("TC") << "MWV: done " << vx.ID << " and existing " << oVx.ID;
 
     // update. Remove old associations
@@ -597,7 +600,7 @@ namespace tca {
     oVx.ChiDOF = aVx.ChiDOF;
     oVx.NTraj = fitpts.size();
     // Update the score and the charge fraction
-    SetVx2Score(slc, oVx);
+    SetVx2Score(tcx, slc, oVx);
     oVx.Stat[kVxMerged] = true;
     oVx.Stat[kFixed] = false;
     if (prt) {
@@ -606,7 +609,8 @@ namespace tca {
       myprt << " Done TPs";
       for (unsigned short ii = 0; ii < fitpts.size(); ++ii) {
         auto& tjpt = fitpts[ii];
-        myprt << " " << tjpt.Hits[0] << "_" << tjpt.AngleCode << "_" << PrintPos(slc, tjpt.Pos);
+        myprt << " " << tjpt.Hits[0] << "_" << tjpt.AngleCode << "_"
+              << PrintPos(tcx, slc, tjpt.Pos);
       }
     } // prt
 
@@ -615,7 +619,7 @@ namespace tca {
 
   //////////////////////////////////////////
   void
-  FindHammerVertices2(TCSlice& slc, const CTP_t& inCTP)
+  FindHammerVertices2(TCContext& tcx, TCSlice& slc, const CTP_t& inCTP)
   {
     // Variant of FindHammerVertices with slightly different requirements:
     // 1) tj1 is a straight trajectory with most of the points fit
@@ -627,11 +631,11 @@ namespace tca {
     // tj1       /
     // minimum^2 DOCA of tj1 endpoint with tj2
 
-    if (!tcc.useAlg[kHamVx2]) return;
+    if (!tcx.tcc.useAlg[kHamVx2]) return;
     // This wasn't written for test beam events
-    if (tcc.modes[kTestBeam]) return;
+    if (tcx.tcc.modes[kTestBeam]) return;
 
-    bool prt = (tcc.modes[kDebug] && tcc.dbgSlc && tcc.dbgAlg[kHamVx2]);
+    bool prt = (tcx.tcc.modes[kDebug] && tcx.tcc.dbgSlc && tcx.tcc.dbgAlg[kHamVx2]);
     if (prt) mf::LogVerbatim("TC") << "Inside HamVx2";
 
     for (unsigned short it1 = 0; it1 < slc.tjs.size(); ++it1) {
@@ -641,7 +645,7 @@ namespace tca {
       if (slc.tjs[it1].AlgMod[kHamVx2]) continue;
       if (slc.tjs[it1].AlgMod[kJunkTj]) continue;
       if (slc.tjs[it1].PDGCode == 111) continue;
-      unsigned short numPtsWithCharge1 = NumPtsWithCharge(slc, slc.tjs[it1], false);
+      unsigned short numPtsWithCharge1 = NumPtsWithCharge(tcx, slc, slc.tjs[it1], false);
       if (numPtsWithCharge1 < 6) continue;
       // require high MCSMom
       if (slc.tjs[it1].MCSMom < 200) continue;
@@ -661,7 +665,7 @@ namespace tca {
           if (slc.tjs[it2].AlgMod[kShowerLike]) continue;
           if (slc.tjs[it2].AlgMod[kJunkTj]) continue;
           if (slc.tjs[it2].PDGCode == 111) continue;
-          unsigned short numPtsWithCharge2 = NumPtsWithCharge(slc, slc.tjs[it2], true);
+          unsigned short numPtsWithCharge2 = NumPtsWithCharge(tcx, slc, slc.tjs[it2], true);
           if (numPtsWithCharge2 < 6) continue;
           // ignore muon-like tjs
           if (numPtsWithCharge2 > 100 && slc.tjs[it2].MCSMom > 500) continue;
@@ -699,7 +703,7 @@ namespace tca {
           if (closePt1 != endPt1) continue;
           if (prt)
             mf::LogVerbatim("TC") << " intersection W:T " << (int)wint << ":"
-                                  << (int)(tint / tcc.unitsPerTick) << " dang " << dang;
+                                  << (int)(tint / tcx.tcc.unitsPerTick) << " dang " << dang;
           // Find the point on tj2 that is closest to this point, overwriting closePt
           doca = minDOCA;
           // the point on tj2 that is closest to the intersection point
@@ -707,12 +711,13 @@ namespace tca {
           TrajClosestApproach(slc.tjs[it2], wint, tint, intPt2, doca);
           if (prt)
             mf::LogVerbatim("TC") << " intPt2 on tj2 " << intPt2 << " at Pos "
-                                  << PrintPos(slc, slc.tjs[it2].Pts[intPt2]) << " doca " << doca;
+                                  << PrintPos(tcx, slc, slc.tjs[it2].Pts[intPt2]) << " doca "
+                                  << doca;
           if (doca == minDOCA) continue;
           // find the MCSMom for both sections of tj2
           float mcsmom = slc.tjs[it2].MCSMom;
-          float mcsmom1 = MCSMom(slc, slc.tjs[it2], slc.tjs[it2].EndPt[0], intPt2);
-          float mcsmom2 = MCSMom(slc, slc.tjs[it2], intPt2, slc.tjs[it2].EndPt[1]);
+          float mcsmom1 = MCSMom(tcx, slc, slc.tjs[it2], slc.tjs[it2].EndPt[0], intPt2);
+          float mcsmom2 = MCSMom(tcx, slc, slc.tjs[it2], intPt2, slc.tjs[it2].EndPt[1]);
           // require that the both MCSMoms be greater than
           if (prt)
             mf::LogVerbatim("TC") << " Check MCSMom after split: mcsmom1 " << mcsmom1 << " mcsmom2 "
@@ -727,11 +732,12 @@ namespace tca {
           float mostChg = slc.tjs[it2].Pts[ipt].Chg;
           if (prt)
             mf::LogVerbatim("TC") << " ipt " << ipt << " at Pos "
-                                  << PrintPos(slc, slc.tjs[it2].Pts[ipt]) << " chg " << mostChg;
+                                  << PrintPos(tcx, slc, slc.tjs[it2].Pts[ipt]) << " chg "
+                                  << mostChg;
           while (nit < 20) {
             ipt += dir;
             if (ipt < 3 || ipt > slc.tjs[it2].Pts.size() - 4) break;
-            float delta = PointTrajDOCA(slc,
+            float delta = PointTrajDOCA(tcx, slc,
                                         slc.tjs[it2].Pts[ipt].Pos[0],
                                         slc.tjs[it2].Pts[ipt].Pos[1],
                                         slc.tjs[it1].Pts[endPt1]);
@@ -761,7 +767,7 @@ namespace tca {
           bool skipIt = false;
           for (unsigned int wire = fromWire + 1; wire < toWire; ++wire) {
             MoveTPToWire(ltp, (float)wire);
-            if (!SignalAtTp(ltp)) {
+            if (!SignalAtTp(tcx, slc, ltp)) {
               skipIt = true;
               break;
             }
@@ -779,9 +785,9 @@ namespace tca {
           aVtx.ID = slc.vtxs.size() + 1;
           unsigned short ivx = slc.vtxs.size();
           if (!StoreVertex(slc, aVtx)) continue;
-          if (!SplitTraj(slc, it2, intPt2, ivx, prt)) {
+          if (!SplitTraj(tcx, slc, it2, intPt2, ivx, prt)) {
             if (prt) mf::LogVerbatim("TC") << "FHV2: Failed to split trajectory";
-            MakeVertexObsolete("HamVx2", slc, slc.vtxs[ivx], true);
+            MakeVertexObsolete("HamVx2", tcx, slc, slc.vtxs[ivx], true);
             continue;
           }
           slc.tjs[it1].VtxID[end1] = slc.vtxs[ivx].ID;
@@ -789,12 +795,12 @@ namespace tca {
           slc.tjs[it2].AlgMod[kHamVx2] = true;
           unsigned short newTjIndex = slc.tjs.size() - 1;
           slc.tjs[newTjIndex].AlgMod[kHamVx2] = true;
-          AttachAnyTrajToVertex(slc, ivx, prt);
-          SetVx2Score(slc);
+          AttachAnyTrajToVertex(tcx, slc, ivx, prt);
+          SetVx2Score(tcx, slc);
           // Update the PDGCode for the chopped trajectory
-          SetPDGCode(slc, it2);
+          SetPDGCode(tcx, slc, it2);
           // and for the new trajectory
-          SetPDGCode(slc, newTjIndex);
+          SetPDGCode(tcx, slc, newTjIndex);
           if (prt)
             mf::LogVerbatim("TC") << " FHV2: New vtx 2V" << slc.vtxs[ivx].ID << " Score "
                                   << slc.vtxs[ivx].Score;
@@ -808,7 +814,7 @@ namespace tca {
 
   //////////////////////////////////////////
   void
-  FindHammerVertices(TCSlice& slc, const CTP_t& inCTP)
+  FindHammerVertices(TCContext& tcx, TCSlice& slc, const CTP_t& inCTP)
   {
     // Look for a trajectory that intersects another. Split
     // the trajectory and make a vertex. The convention used
@@ -819,9 +825,9 @@ namespace tca {
     // tj1        /
     // tj1       /
 
-    if (!tcc.useAlg[kHamVx]) return;
+    if (!tcx.tcc.useAlg[kHamVx]) return;
 
-    bool prt = (tcc.modes[kDebug] && tcc.dbgSlc && tcc.dbgAlg[kHamVx]);
+    bool prt = (tcx.tcc.modes[kDebug] && tcx.tcc.dbgSlc && tcx.tcc.dbgAlg[kHamVx]);
     if (prt) { mf::LogVerbatim("TC") << "Inside HamVx inCTP " << inCTP; }
 
     for (unsigned short it1 = 0; it1 < slc.tjs.size(); ++it1) {
@@ -876,7 +882,7 @@ namespace tca {
           std::vector<int> tjids(2);
           tjids[0] = slc.tjs[it1].ID;
           tjids[1] = slc.tjs[it2].ID;
-          float chgFrac = ChgFracNearPos(slc, slc.tjs[it2].Pts[closePt2].Pos, tjids);
+          float chgFrac = ChgFracNearPos(tcx, slc, slc.tjs[it2].Pts[closePt2].Pos, tjids);
           if (prt) mf::LogVerbatim("TC") << " chgFrac " << chgFrac;
           if (chgFrac < 0.9) continue;
           Point2_t vxpos = slc.tjs[it2].Pts[closePt2].Pos;
@@ -887,7 +893,7 @@ namespace tca {
           doca = minDOCA;
           TrajClosestApproach(slc.tjs[it2], vxpos[0], vxpos[1], closePt2, doca);
           if (prt)
-            mf::LogVerbatim("TC") << " better pos " << PrintPos(slc, vxpos) << " new closePt2 "
+            mf::LogVerbatim("TC") << " better pos " << PrintPos(tcx, slc, vxpos) << " new closePt2 "
                                   << closePt2;
           // create a new vertex
           VtxStore aVtx;
@@ -900,9 +906,9 @@ namespace tca {
           aVtx.ID = slc.vtxs.size() + 1;
           if (!StoreVertex(slc, aVtx)) continue;
           unsigned short ivx = slc.vtxs.size() - 1;
-          if (!SplitTraj(slc, it2, closePt2, ivx, prt)) {
+          if (!SplitTraj(tcx, slc, it2, closePt2, ivx, prt)) {
             if (prt) mf::LogVerbatim("TC") << "FHV: Failed to split trajectory";
-            MakeVertexObsolete("HamVx", slc, slc.vtxs[slc.vtxs.size() - 1], true);
+            MakeVertexObsolete("HamVx", tcx, slc, slc.vtxs[slc.vtxs.size() - 1], true);
             continue;
           }
           slc.tjs[it1].VtxID[end1] = slc.vtxs[ivx].ID;
@@ -910,11 +916,11 @@ namespace tca {
           slc.tjs[it2].AlgMod[kHamVx] = true;
           unsigned short newTjIndex = slc.tjs.size() - 1;
           slc.tjs[newTjIndex].AlgMod[kHamVx] = true;
-          SetVx2Score(slc);
+          SetVx2Score(tcx, slc);
           // Update the PDGCode for the chopped trajectory
-          SetPDGCode(slc, it2);
+          SetPDGCode(tcx, slc, it2);
           // and for the new trajectory
-          SetPDGCode(slc, newTjIndex);
+          SetPDGCode(tcx, slc, newTjIndex);
           if (prt) {
             auto& vx2 = slc.vtxs[ivx];
             mf::LogVerbatim myprt("TC");
@@ -934,18 +940,18 @@ namespace tca {
 
   //////////////////////////////////////////
   void
-  SplitTrajCrossingVertices(TCSlice& slc, CTP_t inCTP)
+  SplitTrajCrossingVertices(TCContext& tcx, TCSlice& slc, CTP_t inCTP)
   {
     // This is kind of self-explanatory...
 
-    if (!tcc.useAlg[kSplitTjCVx]) return;
+    if (!tcx.tcc.useAlg[kSplitTjCVx]) return;
 
     if (slc.vtxs.empty()) return;
     if (slc.tjs.empty()) return;
 
     constexpr float docaCut = 4;
 
-    bool prt = (tcc.modes[kDebug] && tcc.dbgSlc && tcc.dbgAlg[kSplitTjCVx]);
+    bool prt = (tcx.tcc.modes[kDebug] && tcx.tcc.dbgSlc && tcx.tcc.dbgAlg[kSplitTjCVx]);
     if (prt) mf::LogVerbatim("TC") << "Inside SplitTrajCrossingVertices inCTP " << inCTP;
 
     geo::PlaneID planeID = DecodeCTP(inCTP);
@@ -969,7 +975,7 @@ namespace tca {
         // not in the cryostat/tpc/plane
         if (slc.tjs[itj].CTP != vx2.CTP) continue;
         // poor quality
-        if (vx2.Score < tcc.vtx2DCuts[7]) continue;
+        if (vx2.Score < tcx.tcc.vtx2DCuts[7]) continue;
         float doca = docaCut;
         // make the cut significantly larger if the vertex is in a dead
         // wire gap to get the first TP that is just outside the gap.
@@ -979,7 +985,7 @@ namespace tca {
         if (vx2.Stat[kOnDeadWire]) {
           // special handling for vertices in dead wire regions. Find the IP between
           // the closest point on the Tj and the vertex
-          doca = PointTrajDOCA(slc, vx2.Pos[0], vx2.Pos[1], slc.tjs[itj].Pts[closePt]);
+          doca = PointTrajDOCA(tcx, slc, vx2.Pos[0], vx2.Pos[1], slc.tjs[itj].Pts[closePt]);
         }
         if (doca > docaCut) continue;
         if (prt)
@@ -999,7 +1005,7 @@ namespace tca {
         for (auto tjid : vxtjs) {
           auto& vtj = slc.tjs[tjid - 1];
           if (vtj.AlgMod[kDeltaRay]) continue;
-          unsigned short npwc = NumPtsWithCharge(slc, vtj, false);
+          unsigned short npwc = NumPtsWithCharge(tcx, slc, vtj, false);
           if (npwc > maxPts) maxPts = npwc;
           unsigned short end = 0;
           if (vtj.VtxID[1] == slc.vtxs[iv].ID) end = 1;
@@ -1010,14 +1016,14 @@ namespace tca {
         // skip this operation if any of the Tjs in the split list are > 3 * maxPts
         maxPts *= 3;
         bool skipit = false;
-        if (NumPtsWithCharge(slc, slc.tjs[itj], false) > maxPts && maxPts < 100) skipit = true;
+        if (NumPtsWithCharge(tcx, slc, slc.tjs[itj], false) > maxPts && maxPts < 100) skipit = true;
         if (!skipit && maxdang < 0.3) skipit = true;
         if (prt)
           mf::LogVerbatim("TC") << "  maxPts " << maxPts << " vxtjs[0] " << vxtjs[0] << " maxdang "
                                 << maxdang << " skipit? " << skipit;
         if (skipit) {
           // kill the vertex?
-          if (doca < 1) MakeVertexObsolete("STCV", slc, vx2, true);
+          if (doca < 1) MakeVertexObsolete("STCV", tcx, slc, vx2, true);
           continue;
         }
 
@@ -1057,12 +1063,12 @@ namespace tca {
           mf::LogVerbatim("TC") << "Good doca " << doca << " btw T" << slc.tjs[itj].ID << " and 2V"
                                 << vx2.ID << " closePt " << closePt << " in plane " << planeID.Plane
                                 << " CTP " << slc.vtxs[iv].CTP;
-          PrintTP("STCV", slc, closePt, 1, slc.tjs[itj].Pass, slc.tjs[itj].Pts[closePt]);
+          PrintTP("STCV", tcx, slc, closePt, 1, slc.tjs[itj].Pass, slc.tjs[itj].Pts[closePt]);
         }
         // ensure that the closest point is not near an end
         if (closePt < slc.tjs[itj].EndPt[0] + 3) continue;
         if (closePt > slc.tjs[itj].EndPt[1] - 3) continue;
-        if (!SplitTraj(slc, itj, closePt, iv, prt)) {
+        if (!SplitTraj(tcx, slc, itj, closePt, iv, prt)) {
           if (prt) mf::LogVerbatim("TC") << "SplitTrajCrossingVertices: Failed to split trajectory";
           continue;
         }
@@ -1070,7 +1076,7 @@ namespace tca {
         unsigned short newTjIndex = slc.tjs.size() - 1;
         slc.tjs[newTjIndex].AlgMod[kSplitTjCVx] = true;
         // re-fit the vertex position
-        FitVertex(slc, vx2, prt);
+        FitVertex(tcx, slc, vx2, prt);
       } // iv
     }   // itj
 
@@ -1078,14 +1084,14 @@ namespace tca {
 
   //////////////////////////////////////
   void
-  Reconcile2Vs(TCSlice& slc)
+  Reconcile2Vs(TCContext& tcx, TCSlice& slc)
   {
     // This function is called before Find3DVertices to identify (and possibly reconcile)
     // Tj and 2V inconsistencies using 2D and 3D(?) information
-    if (!tcc.useAlg[kReconcile2Vs]) return;
+    if (!tcx.tcc.useAlg[kReconcile2Vs]) return;
     if (slc.vtxs.empty()) return;
 
-    bool prt = (tcc.dbg2V && tcc.dbgSlc);
+    bool prt = (tcx.tcc.dbg2V && tcx.tcc.dbgSlc);
 
     // clusters of 2Vs
     std::vector<std::vector<int>> vx2Cls;
@@ -1156,7 +1162,7 @@ namespace tca {
         } // vx2cls
       }   // prt
       for (auto& vx2cls : vx2Cls) {
-        Reconcile2VTs(slc, vx2cls, prt);
+        Reconcile2VTs(tcx, slc, vx2cls, prt);
       } // vx2cls
     }   // plane
 
@@ -1168,13 +1174,13 @@ namespace tca {
       if (!vx.Stat[kVxEnvOK]) VxEnvironmentNeedsUpdate = true;
     } // vx
 
-    if (VxEnvironmentNeedsUpdate) UpdateVxEnvironment(slc);
+    if (VxEnvironmentNeedsUpdate) UpdateVxEnvironment(tcx, slc);
 
   } // Reconcile2Vs
 
   //////////////////////////////////////
   bool
-  Reconcile2VTs(TCSlice& slc, std::vector<int>& vx2cls, bool prt)
+  Reconcile2VTs(TCContext& tcx, TCSlice& slc, std::vector<int>& vx2cls, bool prt)
   {
     // The 2D vertices IDs in vx2cls were clustered by the calling function. This function
     // checks the T -> 2V assns and possibly changes it. It returns true if an assn is changed
@@ -1210,7 +1216,7 @@ namespace tca {
         unsigned short fitPt = NearbyCleanPt(slc, tj, nearEnd);
         if (fitPt == USHRT_MAX) return false;
         auto& tp = tj.Pts[fitPt];
-        sumPulls += TrajPointVertexPull(slc, tp, vx);
+        sumPulls += TrajPointVertexPull(tcx, slc, tp, vx);
         ++cnt;
       } // end
     }   // tid
@@ -1249,7 +1255,7 @@ namespace tca {
       if (oneVxTPs[itj].Environment[kEnvOverlap]) oneVxTPs[itj].AngErr *= 4;
       oneVxTPs[itj].Step = tj.ID;
     } // ii
-    if (!FitVertex(slc, oneVx, oneVxTPs, prt)) return false;
+    if (!FitVertex(tcx, slc, oneVx, oneVxTPs, prt)) return false;
 
     if (oneVx.ChiDOF < 3) {
       // Update the position of the first 2V in the list
@@ -1264,7 +1270,7 @@ namespace tca {
       vx.Stat[kVxEnvOK] = false;
       for (unsigned short ivx = 1; ivx < vx2cls.size(); ++ivx) {
         auto& vx = slc.vtxs[vx2cls[ivx] - 1];
-        MakeVertexObsolete("R2VTPs", slc, vx, true);
+        MakeVertexObsolete("R2VTPs", tcx, slc, vx, true);
       } // ivx
       // now attach the trajectories
       for (auto tid : t2vList) {
@@ -1279,13 +1285,13 @@ namespace tca {
 
   //////////////////////////////////////
   void
-  Find3DVertices(detinfo::DetectorPropertiesData const& detProp, TCSlice& slc)
+  Find3DVertices(detinfo::DetectorPropertiesData const& detProp, TCContext& tcx, TCSlice& slc)
   {
     // Create 3D vertices from 2D vertices. 3D vertices that are matched
     // in all three planes have Vtx2ID > 0 for all planes. This function re-scores all
     // 2D and 3D vertices and flags Tjs that have high-score 3D vertices
 
-    if (tcc.vtx3DCuts[0] < 0) return;
+    if (tcx.tcc.vtx3DCuts[0] < 0) return;
     if (slc.vtxs.size() < 2) return;
 
     // create a array/vector of 2D vertex indices in each plane
@@ -1305,10 +1311,10 @@ namespace tca {
       if (vIndex[plane].size() > 0) ++vtxInPln;
     if (vtxInPln < 2) return;
 
-    float thirdPlanedXCut = 2 * tcc.vtx3DCuts[0];
-    bool prt = (tcc.dbg3V && tcc.dbgSlc);
+    float thirdPlanedXCut = 2 * tcx.tcc.vtx3DCuts[0];
+    bool prt = (tcx.tcc.dbg3V && tcx.tcc.dbgSlc);
     if (prt) {
-      mf::LogVerbatim("TC") << "Inside Find3DVertices. dX cut " << tcc.vtx3DCuts[0]
+      mf::LogVerbatim("TC") << "Inside Find3DVertices. dX cut " << tcx.tcc.vtx3DCuts[0]
                             << " thirdPlanedXCut " << thirdPlanedXCut;
     }
 
@@ -1320,11 +1326,11 @@ namespace tca {
 
     for (unsigned short ivx = 0; ivx < vsize; ++ivx) {
       if (slc.vtxs[ivx].ID <= 0) continue;
-      if (slc.vtxs[ivx].Score < tcc.vtx2DCuts[7]) continue;
+      if (slc.vtxs[ivx].Score < tcx.tcc.vtx2DCuts[7]) continue;
       if (slc.vtxs[ivx].Pos[0] < -0.4) continue;
       geo::PlaneID planeID = DecodeCTP(slc.vtxs[ivx].CTP);
       // Convert 2D vertex time error to X error
-      double ticks = slc.vtxs[ivx].Pos[1] / tcc.unitsPerTick;
+      double ticks = slc.vtxs[ivx].Pos[1] / tcx.tcc.unitsPerTick;
       vX[ivx] = detProp.ConvertTicksToX(ticks, planeID);
     } // ivx
 
@@ -1354,7 +1360,7 @@ namespace tca {
             if (jvx2.Pos[0] < -0.4) continue;
             unsigned int jWire = std::nearbyint(jvx2.Pos[0]);
             float dX = std::abs(vX[ivx] - vX[jvx]);
-            if (dX > tcc.vtx3DCuts[0]) continue;
+            if (dX > tcx.tcc.vtx3DCuts[0]) continue;
             if (prt) {
               mf::LogVerbatim("TC")
                 << "F3DV: ipl " << ipl << " i2V" << ivx2.ID << " iX " << vX[ivx] << " jpl " << jpl
@@ -1362,30 +1368,30 @@ namespace tca {
                 << (int)jvx2.Pos[1] << " dX " << dX;
             }
             double y = -1000, z = -1000;
-            tcc.geom->IntersectionPoint(iWire, jWire, ipl, jpl, cstat, tpc, y, z);
+            tcx.tcc.geom->IntersectionPoint(iWire, jWire, ipl, jpl, cstat, tpc, y, z);
             if (y < slc.yLo || y > slc.yHi || z < slc.zLo || z > slc.zHi) continue;
             unsigned short kpl = 3 - ipl - jpl;
             float kX = 0.5 * (vX[ivx] + vX[jvx]);
             int kWire = -1;
             if (slc.nPlanes > 2) {
-              kWire = tcc.geom->WireCoordinate(y, z, kpl, tpc, cstat);
+              kWire = tcx.tcc.geom->WireCoordinate(y, z, kpl, tpc, cstat);
               std::array<int, 2> wireWindow;
               std::array<float, 2> timeWindow;
               wireWindow[0] = kWire - maxSep;
               wireWindow[1] = kWire + maxSep;
               float time =
-                detProp.ConvertXToTicks(kX, kpl, (int)tpc, (int)cstat) * tcc.unitsPerTick;
+                detProp.ConvertXToTicks(kX, kpl, (int)tpc, (int)cstat) * tcx.tcc.unitsPerTick;
               timeWindow[0] = time - maxSep;
               timeWindow[1] = time + maxSep;
               bool hitsNear;
               std::vector<unsigned int> closeHits =
-                FindCloseHits(slc, wireWindow, timeWindow, kpl, kAllHits, true, hitsNear);
+                FindCloseHits(tcx, slc, wireWindow, timeWindow, kpl, kAllHits, true, hitsNear);
               if (prt) {
                 mf::LogVerbatim myprt("TC");
                 myprt << " Hits near " << kpl << ":" << kWire << ":"
-                      << (int)(time / tcc.unitsPerTick) << " = ";
+                      << (int)(time / tcx.tcc.unitsPerTick) << " = ";
                 for (auto iht : closeHits)
-                  myprt << " " << PrintHit(slc.slHits[iht]);
+                  myprt << " " << PrintHit(tcx, slc.slHits[iht]);
               }
               if (!hitsNear) continue;
             } // 3-plane TPC
@@ -1403,10 +1409,10 @@ namespace tca {
             v3d.Y = y;
             v3d.Z = z;
             v3d.Wire = kWire;
-            float posError = dX / tcc.vtx3DCuts[0];
+            float posError = dX / tcx.tcc.vtx3DCuts[0];
             float vxScoreWght = 0;
-            SetVx3Score(slc, v3d);
-            vxScoreWght = tcc.vtx3DCuts[2] / v3d.Score;
+            SetVx3Score(tcx, slc, v3d);
+            vxScoreWght = tcx.tcc.vtx3DCuts[2] / v3d.Score;
             if (posError < 0.5) posError = 0;
             v3d.Score = posError + vxScoreWght;
             v3d.TPCID = slc.TPCID;
@@ -1432,25 +1438,25 @@ namespace tca {
               unsigned short kvx = vIndex[kpl][kk];
               float dX = std::abs(vX[kvx] - v3d.X);
               // Wire difference error
-              float dW = tcc.wirePitch * std::abs(slc.vtxs[kvx].Pos[0] - kWire);
+              float dW = tcx.tcc.wirePitch * std::abs(slc.vtxs[kvx].Pos[0] - kWire);
               if (dX > thirdPlanedXCut) continue;
-              if (dW > tcc.vtx3DCuts[1]) continue;
+              if (dW > tcx.tcc.vtx3DCuts[1]) continue;
               // put the Y,Z difference in YErr and ZErr
               double y = -1000, z = -1000;
-              tcc.geom->IntersectionPoint(iWire, kWire, ipl, kpl, cstat, tpc, y, z);
+              tcx.tcc.geom->IntersectionPoint(iWire, kWire, ipl, kpl, cstat, tpc, y, z);
               v3d.YErr = y - v3d.Y;
               v3d.ZErr = z - v3d.Z;
               v3d.Vx2ID[kpl] = slc.vtxs[kvx].ID;
               v3d.Wire = -1;
               // hijack the Score variable to hold the separation^2, weighted by the
               // vertex3DCuts
-              dX = (vX[kvx] - v3d.X) / tcc.vtx3DCuts[0];
-              float dY = v3d.YErr / tcc.vtx3DCuts[1];
-              float dZ = v3d.ZErr / tcc.vtx3DCuts[1];
+              dX = (vX[kvx] - v3d.X) / tcx.tcc.vtx3DCuts[0];
+              float dY = v3d.YErr / tcx.tcc.vtx3DCuts[1];
+              float dZ = v3d.ZErr / tcx.tcc.vtx3DCuts[1];
               posError = dX * dX + dY * dY + dZ * dZ;
               vxScoreWght = 0;
-              SetVx3Score(slc, v3d);
-              vxScoreWght = tcc.vtx3DCuts[2] / v3d.Score;
+              SetVx3Score(tcx, slc, v3d);
+              vxScoreWght = tcx.tcc.vtx3DCuts[2] / v3d.Score;
               if (posError < 0.5) posError = 0;
               v3d.Score = posError + vxScoreWght;
               if (v3d.Score > maxScore) maxScore = v3d.Score;
@@ -1530,8 +1536,8 @@ namespace tca {
     for (auto& vx3 : v3sel) {
       if (slc.nPlanes == 3 && vx3.Wire >= 0) ++ninc;
       vx3.ID = slc.vtx3s.size() + 1;
-      ++evt.global3V_UID;
-      vx3.UID = evt.global3V_UID;
+      ++slc.ids.global3V_UID;
+      vx3.UID = slc.ids.global3V_UID;
       if (prt) {
         mf::LogVerbatim myprt("TC");
         myprt << " 3V" << vx3.ID;
@@ -1550,8 +1556,8 @@ namespace tca {
 
     // Try to complete incomplete vertices
     if (ninc > 0) {
-      CompleteIncomplete3DVerticesInGaps(detProp, slc);
-      CompleteIncomplete3DVertices(detProp, slc);
+      CompleteIncomplete3DVerticesInGaps(detProp, tcx, slc);
+      CompleteIncomplete3DVertices(detProp, tcx, slc);
     }
 
     // Score and flag Tjs that are attached to high-score vertices
@@ -1567,12 +1573,12 @@ namespace tca {
       if (vx2.ID == 0) continue;
       geo::PlaneID planeID = DecodeCTP(vx2.CTP);
       if (planeID.TPC != tpc || planeID.Cryostat != cstat) continue;
-      SetVx2Score(slc, vx2);
+      SetVx2Score(tcx, slc, vx2);
     } // vx2
     // and the 3D vertices
     for (auto& vx3 : slc.vtx3s) {
       if (vx3.ID == 0) continue;
-      SetVx3Score(slc, vx3);
+      SetVx3Score(tcx, slc, vx3);
     } // vx3
 
   } // Find3DVertices
@@ -1652,19 +1658,19 @@ namespace tca {
 
   //////////////////////////////////////////
   bool
-  AttachAnyVertexToTraj(TCSlice& slc, int tjID, bool prt)
+  AttachAnyVertexToTraj(TCContext& tcx, TCSlice& slc, int tjID, bool prt)
   {
     // Try to attach a tj that is stored in slc.tjs with any vertex
     if (tjID <= 0 || tjID > (int)slc.tjs.size()) return false;
     if (slc.vtxs.empty()) return false;
     auto& tj = slc.tjs[tjID - 1];
     if (tj.AlgMod[kKilled]) return false;
-    if (tcc.vtx2DCuts[0] <= 0) return false;
+    if (tcx.tcc.vtx2DCuts[0] <= 0) return false;
 
     unsigned short bestVx = USHRT_MAX;
     // Construct a FOM = (TP-Vtx pull) * (TP-Vtx sep + 1) * (Vtx Score).
     // The +1 keeps FOM from being 0
-    float bestFOM = 2 * tcc.vtx2DCuts[3] * (tcc.vtx2DCuts[0] + 1) * tcc.vtx2DCuts[7];
+    float bestFOM = 2 * tcx.tcc.vtx2DCuts[3] * (tcx.tcc.vtx2DCuts[0] + 1) * tcx.tcc.vtx2DCuts[7];
     for (unsigned short ivx = 0; ivx < slc.vtxs.size(); ++ivx) {
       auto& vx = slc.vtxs[ivx];
       if (vx.ID == 0) continue;
@@ -1679,7 +1685,7 @@ namespace tca {
       if (tj.VtxID[end] > 0) continue;
       auto& tp = tj.Pts[tj.EndPt[end]];
       // Pad the separation a bit so we don't get zero
-      float fom = TrajPointVertexPull(slc, tp, vx) * (sep[end] + 1) * vx.Score;
+      float fom = TrajPointVertexPull(tcx, slc, tp, vx) * (sep[end] + 1) * vx.Score;
       if (fom > bestFOM) continue;
       if (prt)
         mf::LogVerbatim("TC") << "AAVTT: T" << tjID << " 2V" << vx.ID << " FOM " << fom << " cut "
@@ -1689,17 +1695,17 @@ namespace tca {
     } // vx
     if (bestVx > slc.vtxs.size() - 1) return false;
     auto& vx = slc.vtxs[bestVx];
-    return AttachTrajToVertex(slc, tj, vx, prt);
+    return AttachTrajToVertex(tcx, slc, tj, vx, prt);
   } // AttachAnyVertexToTraj
 
   //////////////////////////////////////////
   bool
-  AttachAnyTrajToVertex(TCSlice& slc, unsigned short ivx, bool prt)
+  AttachAnyTrajToVertex(TCContext& tcx, TCSlice& slc, unsigned short ivx, bool prt)
   {
 
     if (ivx > slc.vtxs.size() - 1) return false;
     if (slc.vtxs[ivx].ID == 0) return false;
-    if (tcc.vtx2DCuts[0] < 0) return false;
+    if (tcx.tcc.vtx2DCuts[0] < 0) return false;
 
     VtxStore& vx = slc.vtxs[ivx];
     // Hammer vertices should be isolated and clean
@@ -1708,7 +1714,7 @@ namespace tca {
     unsigned short bestTj = USHRT_MAX;
     // Construct a FOM = (TP-Vtx pull) * (TP-Vtx sep + 1).
     // The +1 keeps FOM from being 0
-    float bestFOM = 2 * tcc.vtx2DCuts[3] * (tcc.vtx2DCuts[0] + 1);
+    float bestFOM = 2 * tcx.tcc.vtx2DCuts[3] * (tcx.tcc.vtx2DCuts[0] + 1);
     for (unsigned int itj = 0; itj < slc.tjs.size(); ++itj) {
       auto& tj = slc.tjs[itj];
       if (tj.AlgMod[kKilled] || tj.AlgMod[kHaloTj]) continue;
@@ -1723,7 +1729,7 @@ namespace tca {
       if (tj.VtxID[end] > 0) continue;
       auto& tp = tj.Pts[tj.EndPt[end]];
       // Pad the separation a bit so we don't get zero
-      float fom = TrajPointVertexPull(slc, tp, vx) * (sep[end] + 1);
+      float fom = TrajPointVertexPull(tcx, slc, tp, vx) * (sep[end] + 1);
       if (fom > bestFOM) continue;
       if (prt) {
         mf::LogVerbatim("TC") << "AATTV: T" << tj.ID << " 2V" << vx.ID << " Topo " << vx.Topo
@@ -1734,12 +1740,12 @@ namespace tca {
     } // tj
     if (bestTj > slc.tjs.size() - 1) return false;
     auto& tj = slc.tjs[bestTj];
-    return AttachTrajToVertex(slc, tj, vx, prt);
+    return AttachTrajToVertex(tcx, slc, tj, vx, prt);
   } // AttachAnyTrajToVertex
 
   //////////////////////////////////////////
   bool
-  AttachTrajToVertex(TCSlice& slc, Trajectory& tj, VtxStore& vx, bool prt)
+  AttachTrajToVertex(TCContext& tcx, TCSlice& slc, Trajectory& tj, VtxStore& vx, bool prt)
   {
     // Note that this function does not require a signal between the end of the Tj and the vertex
 
@@ -1757,10 +1763,10 @@ namespace tca {
     // already attached?
     if (tj.VtxID[0] == vx.ID || tj.VtxID[1] == vx.ID) return false;
 
-    unsigned short maxShortTjLen = tcc.vtx2DCuts[0];
+    unsigned short maxShortTjLen = tcx.tcc.vtx2DCuts[0];
     // square the separation cut to simplify testing in the loop
-    float maxSepCutShort2 = tcc.vtx2DCuts[1] * tcc.vtx2DCuts[1];
-    float maxSepCutLong2 = tcc.vtx2DCuts[2] * tcc.vtx2DCuts[2];
+    float maxSepCutShort2 = tcx.tcc.vtx2DCuts[1] * tcx.tcc.vtx2DCuts[1];
+    float maxSepCutLong2 = tcx.tcc.vtx2DCuts[2] * tcx.tcc.vtx2DCuts[2];
 
     // assume that end 0 is closest to the vertex
     unsigned short end = 0;
@@ -1782,17 +1788,17 @@ namespace tca {
     // ignore bad separation between the closest tj end and the vertex
     if (tjShort) {
       if (vtxTjSep2 > maxSepCutShort2) return false;
-      closestApproach = tcc.vtx2DCuts[1];
+      closestApproach = tcx.tcc.vtx2DCuts[1];
     }
     else {
-      closestApproach = tcc.vtx2DCuts[2];
+      closestApproach = tcx.tcc.vtx2DCuts[2];
       if (vtxTjSep2 > maxSepCutLong2) return false;
     }
 
     // Calculate the pull on the vertex
     TrajPoint& tp = tj.Pts[tj.EndPt[end]];
-    float tpVxPull = TrajPointVertexPull(slc, tp, vx);
-    bool signalBetween = SignalBetween(slc, tp, vx.Pos[0], 0.8);
+    float tpVxPull = TrajPointVertexPull(tcx, slc, tp, vx);
+    bool signalBetween = SignalBetween(tcx, slc, tp, vx.Pos[0], 0.8);
 
     // See if the vertex position is close to an end
     unsigned short closePt;
@@ -1810,7 +1816,7 @@ namespace tca {
     // don't attach it if the tj length is shorter than the separation distance
     if (length > 4 && length < closestApproach) return false;
 
-    float pullCut = tcc.vtx2DCuts[3];
+    float pullCut = tcx.tcc.vtx2DCuts[3];
     // Dec 21, 2017 Loosen up the pull cut for short close slc. These are likely to
     // be poorly reconstructed. It is better to have them associated with the vertex
     // than not.
@@ -1844,8 +1850,8 @@ namespace tca {
     tj.AlgMod[kPhoton] = !signalBetween;
     // make a copy of the vertex and fit it
     auto vxTmp = vx;
-    if (FitVertex(slc, vxTmp, prt)) {
-      SetVx2Score(slc, vxTmp);
+    if (FitVertex(tcx, slc, vxTmp, prt)) {
+      SetVx2Score(tcx, slc, vxTmp);
       if (prt) mf::LogVerbatim("TC") << " Success";
       vx = vxTmp;
       return true;
@@ -1862,12 +1868,12 @@ namespace tca {
 
   /////////////////////////////////////////
   float
-  TrajPointVertexPull(const TCSlice& slc, const TrajPoint& tp, const VtxStore& vx)
+  TrajPointVertexPull(TCContext& tcx, const TCSlice& slc, const TrajPoint& tp, const VtxStore& vx)
   {
     // Calculates the position pull between a trajectory point and a vertex
 
     // impact parameter between them
-    double ip = PointTrajDOCA(slc, vx.Pos[0], vx.Pos[1], tp);
+    double ip = PointTrajDOCA(tcx, slc, vx.Pos[0], vx.Pos[1], tp);
     // separation^2
     double sep2 = PosSep2(vx.Pos, tp.Pos);
 
@@ -1936,8 +1942,8 @@ namespace tca {
 
     if (vx.ID != int(slc.vtxs.size() + 1)) return false;
 
-    ++evt.global2V_UID;
-    vx.UID = evt.global2V_UID;
+    ++slc.ids.global2V_UID;
+    vx.UID = slc.ids.global2V_UID;
 
     unsigned short nvxtj = 0;
     unsigned short nok = 0;
@@ -1965,7 +1971,7 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  FitVertex(TCSlice& slc, VtxStore& vx, bool prt)
+  FitVertex(TCContext& tcx, TCSlice& slc, VtxStore& vx, bool prt)
   {
     // Fit the vertex using T -> 2V assns
 
@@ -2007,7 +2013,7 @@ namespace tca {
       }
     } // tj
 
-    bool success = FitVertex(slc, vx, vxTp, prt);
+    bool success = FitVertex(tcx, slc, vx, vxTp, prt);
 
     if (!success) return false;
     return true;
@@ -2015,7 +2021,7 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  FitVertex(TCSlice& slc, VtxStore& vx, std::vector<TrajPoint>& vxTPs, bool prt)
+  FitVertex(TCContext& tcx, TCSlice& slc, VtxStore& vx, std::vector<TrajPoint>& vxTPs, bool prt)
   {
     // Version with LSQ fit. Each TP position (P0,P1) and slope S are fit to a vertex
     // at position (V0, V1), using the equation P1 = V1 + (P0 - V0) * S. This is put
@@ -2064,7 +2070,7 @@ namespace tca {
     if (vxTPs.size() > 2) {
       for (auto& tp : vxTPs) {
         // highjack TP Delta for the vertex pull
-        tp.Delta = TrajPointVertexPull(slc, tp, vx);
+        tp.Delta = TrajPointVertexPull(tcx, slc, tp, vx);
         vx.ChiDOF += tp.Delta;
       } // itj
       vx.ChiDOF /= (float)(vxTPs.size() - 2);
@@ -2074,7 +2080,7 @@ namespace tca {
       mf::LogVerbatim("TC") << "Note: TP - 2V pull is stored in TP.Delta";
       PrintTPHeader("FV");
       for (auto& tp : vxTPs)
-        PrintTP("FV", slc, 0, 1, 1, tp);
+        PrintTP("FV", tcx, slc, 0, 1, 1, tp);
     }
 
     return true;
@@ -2157,7 +2163,7 @@ namespace tca {
 
   //////////////////////////////////////////
   void
-  ScoreVertices(TCSlice& slc)
+  ScoreVertices(TCContext& tcx, TCSlice& slc)
   {
     // reset all 3D vertex, 2D vertex and Tj high-score vertex bits in tpcid
 
@@ -2174,30 +2180,30 @@ namespace tca {
     // Score the 2D vertices
     for (auto& vx : slc.vtxs) {
       if (vx.ID == 0) continue;
-      SetVx2Score(slc, vx);
+      SetVx2Score(tcx, slc, vx);
     } // vx
     // Score the 3D vertices
     for (auto& vx3 : slc.vtx3s) {
       if (vx3.ID == 0) continue;
-      SetVx3Score(slc, vx3);
+      SetVx3Score(tcx, slc, vx3);
     } // vx3
   }   // ScoreVertices
 
   //////////////////////////////////////////
   void
-  KillPoorVertices(TCSlice& slc)
+  KillPoorVertices(TCContext& tcx, TCSlice& slc)
   {
     // kill 2D vertices that have low score and are not attached to a high-score 3D vertex
     if (slc.vtxs.empty()) return;
     for (auto& vx : slc.vtxs) {
       if (vx.ID == 0) continue;
-      if (vx.Score > tcc.vtx2DCuts[7]) continue;
+      if (vx.Score > tcx.tcc.vtx2DCuts[7]) continue;
       if (vx.Vx3ID > 0) {
         auto& vx3 = slc.vtx3s[vx.Vx3ID - 1];
         if (vx3.Primary) continue;
-        if (slc.vtx3s[vx.Vx3ID - 1].Score >= tcc.vtx2DCuts[7]) continue;
+        if (slc.vtx3s[vx.Vx3ID - 1].Score >= tcx.tcc.vtx2DCuts[7]) continue;
       }
-      MakeVertexObsolete("KPV", slc, vx, false);
+      MakeVertexObsolete("KPV", tcx, slc, vx, false);
     } // vx
 
   } // KillPoorVertices
@@ -2253,7 +2259,7 @@ namespace tca {
 
   //////////////////////////////////////////
   void
-  SetVx3Score(TCSlice& slc, Vtx3Store& vx3)
+  SetVx3Score(TCContext& tcx, TCSlice& slc, Vtx3Store& vx3)
   {
     // Calculate the 3D vertex score and flag Tjs that are attached to high score vertices as defined
     // by vtx2DCuts
@@ -2269,32 +2275,32 @@ namespace tca {
     vx3.Score /= (float)slc.nPlanes;
     // don't allow it to get too small or negative
     if (vx3.Score < 0.001) vx3.Score = 0.001;
-    if (vx3.Score > tcc.vtx2DCuts[7]) SetHighScoreBits(slc, vx3);
+    if (vx3.Score > tcx.tcc.vtx2DCuts[7]) SetHighScoreBits(slc, vx3);
 
   } // SetVx3Score
 
   //////////////////////////////////////////
   void
-  SetVx2Score(TCSlice& slc)
+  SetVx2Score(TCContext& tcx, TCSlice& slc)
   {
     // A version that sets the score of the last added vertex
     if (slc.vtxs.empty()) return;
     auto& vx2 = slc.vtxs[slc.vtxs.size() - 1];
-    SetVx2Score(slc, vx2);
+    SetVx2Score(tcx, slc, vx2);
   } // SetVx2Score
 
   //////////////////////////////////////////
   void
-  SetVx2Score(TCSlice& slc, VtxStore& vx2)
+  SetVx2Score(TCContext& tcx, TCSlice& slc, VtxStore& vx2)
   {
     // Calculate the 2D vertex score
     if (vx2.ID == 0) return;
 
     // Don't score vertices from CheckTrajBeginChg, MakeJunkVertices or Neutral vertices. Set to the minimum
     if (vx2.Topo == 8 || vx2.Topo == 9 || vx2.Topo == 11 || vx2.Topo == 12) {
-      vx2.Score = tcc.vtx2DCuts[7] + 0.1;
+      vx2.Score = tcx.tcc.vtx2DCuts[7] + 0.1;
       auto vtxTjID = GetVtxTjIDs(slc, vx2);
-      vx2.TjChgFrac = ChgFracNearPos(slc, vx2.Pos, vtxTjID);
+      vx2.TjChgFrac = ChgFracNearPos(tcx, slc, vx2.Pos, vtxTjID);
       return;
     }
 
@@ -2305,13 +2311,13 @@ namespace tca {
     vx2.Score = -1000;
     vx2.TjChgFrac = 0;
     if (vx2.ID == 0) return;
-    if (tcc.vtxScoreWeights.size() < 4) return;
+    if (tcx.tcc.vtxScoreWeights.size() < 4) return;
 
     auto vtxTjIDs = GetVtxTjIDs(slc, vx2);
     if (vtxTjIDs.empty()) return;
 
     // Vertex position error
-    float vpeScore = -tcc.vtxScoreWeights[0] * (vx2.PosErr[0] + vx2.PosErr[1]);
+    float vpeScore = -tcx.tcc.vtxScoreWeights[0] * (vx2.PosErr[0] + vx2.PosErr[1]);
 
     unsigned short m3Dcnt = 0;
     if (vx2.Vx3ID > 0) {
@@ -2320,10 +2326,10 @@ namespace tca {
       unsigned short ivx3 = vx2.Vx3ID - 1;
       if (slc.vtx3s[ivx3].Wire < 0) m3Dcnt = 2;
     }
-    float m3DScore = tcc.vtxScoreWeights[1] * m3Dcnt;
+    float m3DScore = tcx.tcc.vtxScoreWeights[1] * m3Dcnt;
 
-    vx2.TjChgFrac = ChgFracNearPos(slc, vx2.Pos, vtxTjIDs);
-    float cfScore = tcc.vtxScoreWeights[2] * vx2.TjChgFrac;
+    vx2.TjChgFrac = ChgFracNearPos(tcx, slc, vx2.Pos, vtxTjIDs);
+    float cfScore = tcx.tcc.vtxScoreWeights[2] * vx2.TjChgFrac;
 
     // Define a weight for each Tj
     std::vector<int> tjids;
@@ -2389,15 +2395,15 @@ namespace tca {
     }   // it1
     if (cnt > 0) {
       sum /= cnt;
-      tjScore = tcc.vtxScoreWeights[3] * sum;
+      tjScore = tcx.tcc.vtxScoreWeights[3] * sum;
     }
     vx2.Score = vpeScore + m3DScore + cfScore + tjScore;
-    if (tcc.dbg2V && tcc.dbgSlc && vx2.CTP == debug.CTP) {
+    if (tcx.tcc.dbg2V && tcx.tcc.dbgSlc && vx2.CTP == debug.CTP) {
       // last call after vertices have been matched to the truth. Use to optimize vtxScoreWeights using
       // an ntuple
       mf::LogVerbatim myprt("TC");
       bool printHeader = true;
-      Print2V("SVx2S", myprt, vx2, printHeader);
+      Print2V("SVx2S", myprt, tcx, slc, vx2, printHeader);
       myprt << std::fixed << std::setprecision(1);
       myprt << " vpeScore " << vpeScore << " m3DScore " << m3DScore;
       myprt << " cfScore " << cfScore << " tjScore " << tjScore;
@@ -2407,13 +2413,15 @@ namespace tca {
 
   //////////////////////////////////////////
   void
-  CompleteIncomplete3DVerticesInGaps(detinfo::DetectorPropertiesData const& detProp, TCSlice& slc)
+  CompleteIncomplete3DVerticesInGaps(detinfo::DetectorPropertiesData const& detProp,
+                                     TCContext& tcx,
+                                     TCSlice& slc)
   {
 
-    if (!tcc.useAlg[kComp3DVxIG]) return;
+    if (!tcx.tcc.useAlg[kComp3DVxIG]) return;
     if (slc.nPlanes != 3) return;
 
-    bool prt = (tcc.modes[kDebug] && tcc.dbgSlc && tcc.dbgAlg[kComp3DVxIG]);
+    bool prt = (tcx.tcc.modes[kDebug] && tcx.tcc.dbgSlc && tcx.tcc.dbgAlg[kComp3DVxIG]);
     if (prt) mf::LogVerbatim("TC") << "Inside CI3DVIG:";
 
     for (unsigned short iv3 = 0; iv3 < slc.vtx3s.size(); ++iv3) {
@@ -2431,14 +2439,14 @@ namespace tca {
       if (mPlane == USHRT_MAX) continue;
       CTP_t mCTP = EncodeCTP(vx3.TPCID.Cryostat, vx3.TPCID.TPC, mPlane);
       // require that the missing vertex be in a large block of dead wires
-      float dwc = DeadWireCount(slc, vx3.Wire - 4, vx3.Wire + 4, mCTP);
+      float dwc = DeadWireCount(tcx, slc, vx3.Wire - 4, vx3.Wire + 4, mCTP);
       if (dwc < 5) continue;
       // X position of the purported missing vertex
       VtxStore aVtx;
       aVtx.ID = slc.vtxs.size() + 1;
       aVtx.Pos[0] = vx3.Wire;
       aVtx.Pos[1] = detProp.ConvertXToTicks(vx3.X, mPlane, vx3.TPCID.TPC, vx3.TPCID.Cryostat) *
-                    tcc.unitsPerTick;
+                    tcx.tcc.unitsPerTick;
       aVtx.CTP = mCTP;
       aVtx.Topo = 4;
       aVtx.NTraj = 0;
@@ -2459,9 +2467,9 @@ namespace tca {
           TrajPoint& otp = slc.tjs[itj].Pts[oept];
           // ensure that this is the end closest to the vertex
           if (std::abs(tp.Pos[0] - aVtx.Pos[0]) > std::abs(otp.Pos[0] - aVtx.Pos[0])) continue;
-          float doca = PointTrajDOCA(slc, aVtx.Pos[0], aVtx.Pos[1], tp);
+          float doca = PointTrajDOCA(tcx, slc, aVtx.Pos[0], aVtx.Pos[1], tp);
           if (doca > 2) continue;
-          float dwc = DeadWireCount(slc, aVtx.Pos[0], tp.Pos[0], tp.CTP);
+          float dwc = DeadWireCount(tcx, slc, aVtx.Pos[0], tp.Pos[0], tp.CTP);
           float ptSep;
           if (aVtx.Pos[0] > tp.Pos[0]) { ptSep = aVtx.Pos[0] - tp.Pos[0] - dwc; }
           else {
@@ -2479,7 +2487,7 @@ namespace tca {
       }   // itj
       if (!tjIDs.empty()) {
         // Determine how messy this region is
-        aVtx.TjChgFrac = ChgFracNearPos(slc, aVtx.Pos, tjIDs);
+        aVtx.TjChgFrac = ChgFracNearPos(tcx, slc, aVtx.Pos, tjIDs);
         if (aVtx.TjChgFrac < 0.7) continue;
         aVtx.Vx3ID = vx3.ID;
         // Save the 2D vertex
@@ -2489,7 +2497,7 @@ namespace tca {
           slc.tjs[itj].VtxID[tjEnds[ii]] = aVtx.ID;
           slc.tjs[itj].AlgMod[kComp3DVxIG] = true;
         } // ii
-        SetVx2Score(slc);
+        SetVx2Score(tcx, slc);
         vx3.Vx2ID[mPlane] = aVtx.ID;
         vx3.Wire = -1;
         if (prt)
@@ -2501,16 +2509,18 @@ namespace tca {
 
   //////////////////////////////////////////
   void
-  CompleteIncomplete3DVertices(detinfo::DetectorPropertiesData const& detProp, TCSlice& slc)
+  CompleteIncomplete3DVertices(detinfo::DetectorPropertiesData const& detProp,
+                               TCContext& tcx,
+                               TCSlice& slc)
   {
     // Look for trajectories in a plane that lack a 2D vertex as listed in
     // 2DVtxID that are near the projected wire. This may trigger splitting trajectories,
     // assigning them to a new 2D vertex and completing 3D vertices
 
-    if (!tcc.useAlg[kComp3DVx]) return;
+    if (!tcx.tcc.useAlg[kComp3DVx]) return;
     if (slc.nPlanes != 3) return;
 
-    bool prt = (tcc.modes[kDebug] && tcc.dbgSlc && tcc.dbgAlg[kComp3DVx]);
+    bool prt = (tcx.tcc.modes[kDebug] && tcx.tcc.dbgSlc && tcx.tcc.dbgAlg[kComp3DVx]);
 
     float maxdoca = 3;
     if (prt) mf::LogVerbatim("TC") << "Inside CI3DV with maxdoca set to " << maxdoca;
@@ -2539,10 +2549,10 @@ namespace tca {
       TrajPoint vtp;
       vtp.Pos[0] = vx3.Wire;
       vtp.Pos[1] = detProp.ConvertXToTicks(vx3.X, mPlane, vx3.TPCID.TPC, vx3.TPCID.Cryostat) *
-                   tcc.unitsPerTick;
+                   tcx.tcc.unitsPerTick;
       if (prt)
         mf::LogVerbatim("TC") << "CI3DV 3V" << vx3.ID << " Pos " << mPlane << ":"
-                              << PrintPos(slc, vtp.Pos);
+                              << PrintPos(tcx, slc, vtp.Pos);
       std::vector<int> tjIDs;
       std::vector<unsigned short> tjPts;
       for (auto& tj : slc.tjs) {
@@ -2557,10 +2567,10 @@ namespace tca {
         if (closePt > tj.EndPt[1]) continue;
         // try to improve the location of the vertex by looking for a distinctive feature on the
         // trajectory, e.g. high multiplicity hits or larger than normal charge
-        if (RefineVtxPosition(slc, tj, closePt, 3, false)) vtp.Pos = tj.Pts[closePt].Pos;
+        if (RefineVtxPosition(tcx, slc, tj, closePt, 3, false)) vtp.Pos = tj.Pts[closePt].Pos;
         if (prt)
           mf::LogVerbatim("TC") << "CI3DV 3V" << vx3.ID << " candidate  T" << tj.ID << " vtx pos "
-                                << PrintPos(slc, vtp.Pos) << " doca " << doca << " closePt "
+                                << PrintPos(tcx, slc, vtp.Pos) << " doca " << doca << " closePt "
                                 << closePt;
         tjIDs.push_back(tj.ID);
         tjPts.push_back(closePt);
@@ -2574,7 +2584,7 @@ namespace tca {
       unsigned short minPts = USHRT_MAX;
       for (auto tjid : vxtjs) {
         auto& tj = slc.tjs[tjid - 1];
-        unsigned short npwc = NumPtsWithCharge(slc, tj, false);
+        unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
         if (npwc > maxPts) maxPts = npwc;
         if (npwc < minPts) minPts = npwc;
       } // tjid
@@ -2583,7 +2593,7 @@ namespace tca {
       bool skipit = false;
       for (auto tjid : tjIDs) {
         auto& tj = slc.tjs[tjid - 1];
-        if (NumPtsWithCharge(slc, tj, false) > maxPts) skipit = true;
+        if (NumPtsWithCharge(tcx, slc, tj, false) > maxPts) skipit = true;
       } // tjid
       if (prt)
         mf::LogVerbatim("TC") << "  maxPts " << maxPts << " skipit? " << skipit << "  minPts "
@@ -2600,7 +2610,7 @@ namespace tca {
       aVtx.Pass = 9;
       aVtx.Pos = vtp.Pos;
       // ensure this isn't in a messy region
-      aVtx.TjChgFrac = ChgFracNearPos(slc, aVtx.Pos, tjIDs);
+      aVtx.TjChgFrac = ChgFracNearPos(tcx, slc, aVtx.Pos, tjIDs);
       if (prt)
         mf::LogVerbatim("TC") << " charge fraction near position " << aVtx.TjChgFrac
                               << " cut if < 0.6";
@@ -2631,7 +2641,7 @@ namespace tca {
               mf::LogVerbatim("TC")
                 << " T" << slc.tjs[itj].ID << " has vertex 2V" << slc.tjs[itj].VtxID[end]
                 << " at end " << end << ". oldSep " << oldSep;
-            if (dpt < oldSep) { MakeVertexObsolete("CI3DV", slc, oldVx, true); }
+            if (dpt < oldSep) { MakeVertexObsolete("CI3DV", tcx, slc, oldVx, true); }
             else {
               continue;
             }
@@ -2645,7 +2655,7 @@ namespace tca {
         }
         else {
           // closePt is not near an end, so split the trajectory
-          if (SplitTraj(slc, itj, closePt, newVtxIndx, prt)) {
+          if (SplitTraj(tcx, slc, itj, closePt, newVtxIndx, prt)) {
             if (prt)
               mf::LogVerbatim("TC")
                 << " SplitTraj success 2V" << slc.vtxs[newVtxIndx].ID << " at closePt " << closePt;
@@ -2659,9 +2669,9 @@ namespace tca {
             break;
           }
           // Update the PDGCode for the chopped trajectory
-          SetPDGCode(slc, itj);
+          SetPDGCode(tcx, slc, itj);
           // and for the new trajectory
-          SetPDGCode(slc, slc.tjs.size() - 1);
+          SetPDGCode(tcx, slc, slc.tjs.size() - 1);
         } // closePt is not near an end, so split the trajectory
         slc.tjs[itj].AlgMod[kComp3DVx] = true;
         unsigned short newtj = slc.tjs.size() - 1;
@@ -2670,7 +2680,7 @@ namespace tca {
       if (newVtx.NTraj == 0) {
         // A failure occurred. Recover
         if (prt) mf::LogVerbatim("TC") << "  Failed. Recover and delete vertex " << newVtx.ID;
-        MakeVertexObsolete("CI3DV", slc, newVtx, true);
+        MakeVertexObsolete("CI3DV", tcx, slc, newVtx, true);
       }
       else {
         // success
@@ -2682,12 +2692,12 @@ namespace tca {
           newVtx.Pos = vpos;
           newVtx.Stat[kFixed] = true;
         }
-        AttachAnyTrajToVertex(slc, newVtx.ID - 1, prt);
-        SetVx2Score(slc);
+        AttachAnyTrajToVertex(tcx, slc, newVtx.ID - 1, prt);
+        SetVx2Score(tcx, slc);
         if (prt) {
           mf::LogVerbatim myprt("TC");
           myprt << " Success: new 2V" << newVtx.ID << " at " << (int)newVtx.Pos[0] << ":"
-                << (int)newVtx.Pos[1] / tcc.unitsPerTick;
+                << (int)newVtx.Pos[1] / tcx.tcc.unitsPerTick;
           myprt << " points to 3V" << vx3.ID;
           myprt << " TjIDs:";
           for (auto& tjID : tjIDs)
@@ -2701,7 +2711,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  RefineVtxPosition(TCSlice& slc,
+  RefineVtxPosition(TCContext& tcx, TCSlice& slc,
                     const Trajectory& tj,
                     unsigned short& nearPt,
                     short nPtsToChk,
@@ -2727,7 +2737,7 @@ namespace tca {
       }
       if (prt)
         mf::LogVerbatim("TC") << "RVP: ipt " << ipt << " Pos " << tp.CTP << ":"
-                              << PrintPos(slc, tp.Pos) << " chg " << (int)tp.Chg << " nhits "
+                              << PrintPos(tcx, slc, tp.Pos) << " chg " << (int)tp.Chg << " nhits "
                               << tp.Hits.size();
     } // ipt
     if (nearPt == maxChgPt) return false;
@@ -2737,16 +2747,20 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  MakeVertexObsolete(std::string fcnLabel, TCSlice& slc, VtxStore& vx2, bool forceKill)
+  MakeVertexObsolete(std::string fcnLabel,
+                     TCContext& tcx,
+                     TCSlice& slc,
+                     VtxStore& vx2,
+                     bool forceKill)
   {
     // Makes a 2D vertex obsolete
 
     // check for a high-score 3D vertex
     bool hasHighScoreVx3 = (vx2.Vx3ID > 0);
-    if (hasHighScoreVx3 && !forceKill && slc.vtx3s[vx2.Vx3ID - 1].Score >= tcc.vtx2DCuts[7])
+    if (hasHighScoreVx3 && !forceKill && slc.vtx3s[vx2.Vx3ID - 1].Score >= tcx.tcc.vtx2DCuts[7])
       return false;
 
-    if (tcc.dbg2V || tcc.dbg3V) {
+    if (tcx.tcc.dbg2V || tcx.tcc.dbg3V) {
       mf::LogVerbatim("TC") << fcnLabel << " MVO: killing 2V" << vx2.ID;
     }
 
@@ -2808,7 +2822,7 @@ namespace tca {
     if (n2D > 1) {
       // 3D vertex is incomplete
       // correct the score
-      SetVx3Score(slc, vx3);
+      SetVx3Score(tcx, slc, vx3);
       return true;
     }
 
@@ -2829,7 +2843,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  MakeVertexObsolete(TCSlice& slc, Vtx3Store& vx3)
+  MakeVertexObsolete(TCContext& tcx, TCSlice& slc, Vtx3Store& vx3)
   {
     // Deletes a 3D vertex and 2D vertices in all planes
     // The 2D and 3D vertices are NOT killed if forceKill is false and the 3D vertex
@@ -2840,7 +2854,7 @@ namespace tca {
     for (auto vx2id : vx3.Vx2ID) {
       if (vx2id == 0 || vx2id > (int)slc.vtxs.size()) continue;
       auto& vx2 = slc.vtxs[vx2id - 1];
-      MakeVertexObsolete("MVO3", slc, vx2, true);
+      MakeVertexObsolete("MVO3", tcx, slc, vx2, true);
     }
     vx3.ID = 0;
     return true;
@@ -2891,25 +2905,26 @@ namespace tca {
   //////////////////////////////////////////
   void
   PosInPlane(detinfo::DetectorPropertiesData const& detProp,
+             TCContext& tcx,
              const TCSlice& slc,
              const Vtx3Store& vx3,
              unsigned short plane,
              Point2_t& pos)
   {
     // returns the 2D position of the vertex in the plane
-    pos[0] = tcc.geom->WireCoordinate(vx3.Y, vx3.Z, plane, vx3.TPCID.TPC, vx3.TPCID.Cryostat);
-    pos[1] =
-      detProp.ConvertXToTicks(vx3.X, plane, vx3.TPCID.TPC, vx3.TPCID.Cryostat) * tcc.unitsPerTick;
+    pos[0] = tcx.tcc.geom->WireCoordinate(vx3.Y, vx3.Z, plane, vx3.TPCID.TPC, vx3.TPCID.Cryostat);
+    pos[1] = detProp.ConvertXToTicks(vx3.X, plane, vx3.TPCID.TPC, vx3.TPCID.Cryostat) *
+             tcx.tcc.unitsPerTick;
 
   } // PosInPlane
 
   /////////////////////////////////////////
   unsigned short
-  IsCloseToVertex(const TCSlice& slc, const VtxStore& inVx2)
+  IsCloseToVertex(TCContext& tcx, const TCSlice& slc, const VtxStore& inVx2)
   {
     // Returns the ID of a 2D vertex having the minimum pull < user-specified cut
 
-    float minPull = tcc.vtx2DCuts[3];
+    float minPull = tcx.tcc.vtx2DCuts[3];
     unsigned short imBest = 0;
     for (auto& vx2 : slc.vtxs) {
       if (vx2.CTP != inVx2.CTP) continue;
@@ -2925,15 +2940,15 @@ namespace tca {
 
   /////////////////////////////////////////
   unsigned short
-  IsCloseToVertex(const TCSlice& slc, const Vtx3Store& vx3)
+  IsCloseToVertex(TCContext& tcx, const TCSlice& slc, const Vtx3Store& vx3)
   {
     // Returns the ID of a 3D vertex having the minimum pull < user-specified cut
 
-    float minPull = tcc.vtx3DCuts[1];
+    float minPull = tcx.tcc.vtx3DCuts[1];
     unsigned short imBest = 0;
     for (auto& oldvx3 : slc.vtx3s) {
       if (oldvx3.ID == 0) continue;
-      if (std::abs(oldvx3.X - vx3.X) > tcc.vtx3DCuts[0]) continue;
+      if (std::abs(oldvx3.X - vx3.X) > tcx.tcc.vtx3DCuts[0]) continue;
       float pull = VertexVertexPull(slc, vx3, oldvx3);
       if (pull < minPull) {
         minPull = pull;
@@ -42,15 +42,15 @@ namespace tca {
 
   // dressed muons
   void
-  MakeHaloTj(TCSlice& slc, Trajectory& muTj, bool prt)
+  MakeHaloTj(TCContext& tcx, TCSlice& slc, Trajectory& muTj, bool prt)
   {
     // Creates a "halo trajectory" around a muon tj consisting of hits and trajectories
     // that are within MuonTag[4] distance. The halo tj is a virtual clone of muTj in the
     // sense that it has the same number of points and the same start and end points.
 
-    if (tcc.muonTag.size() < 5) return;
-    if (tcc.muonTag[4] <= 0) return;
-    if (!tcc.useAlg[kHaloTj]) return;
+    if (tcx.tcc.muonTag.size() < 5) return;
+    if (tcx.tcc.muonTag[4] <= 0) return;
+    if (!tcx.tcc.useAlg[kHaloTj]) return;
 
     if (muTj.PDGCode != 13) return;
 
@@ -73,15 +73,16 @@ namespace tca {
           if (prt) mf::LogVerbatim("TC") << " Killing delta-ray PFParticle P" << pfp.UID;
           pfp.ID = 0;
           // correct the parent -> daughter assn
+          // the parent is in this slice, since the PFParticles are not stitched yet
           if (pfp.ParentUID > 0) {
-            auto parentIndx = GetSliceIndex("P", pfp.ParentUID);
-            if (parentIndx.first != USHRT_MAX) {
-              auto& parent = slices[parentIndx.first].pfps[parentIndx.second];
+            for (auto& parent : slc.pfps) {
+              if (parent.UID != (int)pfp.ParentUID) continue;
               std::vector<int> newDtrUIDs;
               for (auto uid : parent.DtrUIDs)
                 if (uid != dtj.UID) newDtrUIDs.push_back(uid);
               parent.DtrUIDs = newDtrUIDs;
-            } // parent found
+              break;
+            } // parent
           }   // correct the parent
         }     // kill PFParticle
       }       // kill
@@ -95,8 +96,8 @@ namespace tca {
     tj.ID = slc.tjs.size() + 1;
     tj.WorkID = muTj.WorkID;
     // increment the global ID
-    ++evt.globalT_UID;
-    tj.UID = evt.globalT_UID;
+    ++slc.ids.globalT_UID;
+    tj.UID = slc.ids.globalT_UID;
     tj.PDGCode = 11;
     tj.Pass = muTj.Pass;
     tj.StepDir = muTj.StepDir;
@@ -120,9 +121,9 @@ namespace tca {
       tp.DeltaRMS = 0;
       tp.FitChi = 0;
       tp.NTPsFit = 0;
-      float window = tcc.muonTag[4];
+      float window = tcx.tcc.muonTag[4];
       if (tp.Dir[0] != 0) window *= std::abs(1 / tp.Dir[0]);
-      if (!FindCloseHits(slc, tp, window, kAllHits)) continue;
+      if (!FindCloseHits(tcx, slc, tp, window, kAllHits)) continue;
       // add unused hits to the point and look for close tjs
       bool hitsAdded = false;
       for (unsigned short ii = 0; ii < tp.Hits.size(); ++ii) {
@@ -142,8 +143,8 @@ namespace tca {
         }
       } // ii
       if (hitsAdded) {
-        DefineHitPos(slc, tp);
-        tp.Delta = PointTrajDOCA(slc, tp.HitPos[0], tp.HitPos[1], tp);
+        DefineHitPos(tcx, slc, tp);
+        tp.Delta = PointTrajDOCA(tcx, slc, tp.HitPos[0], tp.HitPos[1], tp);
         tj.TotChg += tp.Chg;
         tj.Pts.push_back(tp);
       } // hitsAdded
@@ -156,14 +157,14 @@ namespace tca {
       for (auto tid : closeTjs)
         myprt << " T" << tid;
       myprt << "\n";
-      PrintTrajectory("DM", slc, tj, USHRT_MAX);
+      PrintTrajectory("DM", tcx, slc, tj, USHRT_MAX);
     }
     slc.tjs.push_back(tj);
   } // MakeHaloTj
 
   /////////////////////////////////////////
   void
-  DefineTjParents(TCSlice& slc, bool prt)
+  DefineTjParents(TCContext& tcx, TCSlice& slc, bool prt)
   {
     /*
     This function sets the ParentUID of Tjs in this tpcid to create a hierarchy. The highest Score
@@ -193,7 +194,7 @@ namespace tca {
 */
 
     // don't do anything if this is test beam data
-    if (tcc.modes[kTestBeam]) return;
+    if (tcx.tcc.modes[kTestBeam]) return;
 
     // clear old information
     for (auto& tj : slc.tjs) {
@@ -247,9 +248,9 @@ namespace tca {
       vlist[indx] = temp[sortVec[indx].index];
 
     // make a neutrino PFParticle to associate with the highest score vertex if it is high enough
-    if (tcc.match3DCuts[0] > 0) {
+    if (tcx.tcc.match3DCuts[0] > 0) {
       auto& vx3 = slc.vtx3s[vlist[0] - 1];
-      if (vx3.Score > tcc.vtx2DCuts[7]) {
+      if (vx3.Score > tcx.tcc.vtx2DCuts[7]) {
         auto neutrinoPFP = CreatePFP(slc);
         // call it the neutrino vertex
         vx3.Neutrino = true;
@@ -333,7 +334,7 @@ namespace tca {
         unsigned short dpt = 0, ppt = 0;
         auto& ptj = slc.tjs[lastPair.first - 1];
         // find the point on the daughter tj that is closest to the parent
-        TrajTrajDOCA(slc, dtj, ptj, dpt, ppt, doca);
+        TrajTrajDOCA(tcx, slc, dtj, ptj, dpt, ppt, doca);
         // reverse the daughter if the closest point is near end 1 of the daughter
         if (prt) mf::LogVerbatim("TC") << "Set parent " << ptj.ID << " dtr " << dtj.ID;
         // remove that entry
@@ -369,7 +370,7 @@ namespace tca {
 
   /////////////////////////////////////////
   float
-  MaxChargeAsymmetry(TCSlice& slc, std::vector<int>& tjIDs)
+  MaxChargeAsymmetry(TCContext& tcx, TCSlice& slc, std::vector<int>& tjIDs)
   {
     // calculates the maximum charge asymmetry in all planes using the supplied list of Tjs
     if (tjIDs.size() < 2) return 1;
@@ -377,7 +378,7 @@ namespace tca {
     for (auto tjid : tjIDs) {
       if (tjid <= 0 || tjid > (int)slc.tjs.size()) return 1;
       auto& tj = slc.tjs[tjid - 1];
-      if (tj.TotChg == 0) UpdateTjChgProperties("MCA", slc, tj, false);
+      if (tj.TotChg == 0) UpdateTjChgProperties("MCA", tcx, slc, tj, false);
       unsigned short plane = DecodeCTP(tj.CTP).Plane;
       plnchg[plane] += tj.TotChg;
     } // tjid
@@ -402,7 +403,7 @@ namespace tca {
 
   /////////////////////////////////////////
   int
-  PDGCodeVote(const TCSlice& slc, const std::vector<int>& tjIDs)
+  PDGCodeVote(TCContext& tcx, const TCSlice& slc, const std::vector<int>& tjIDs)
   {
     // Returns the most likely PDGCode for the set of Tjs provided
     // The PDG codes are:
@@ -482,7 +483,7 @@ namespace tca {
 
   /////////////////////////////////////////
   int
-  PrimaryUID(const TCSlice& slc, const PFPStruct& pfp)
+  PrimaryUID(const TCContext& tcx, const PFPStruct& pfp)
   {
     // returns the UID of the most upstream PFParticle (that is not a neutrino)
 
@@ -491,8 +492,8 @@ namespace tca {
     int dtruid = pfp.UID;
     unsigned short nit = 0;
     while (true) {
-      auto slcIndx = GetSliceIndex("P", paruid);
-      auto& parent = slices[slcIndx.first].pfps[slcIndx.second];
+      auto slcIndx = GetSliceIndex(tcx, "P", paruid);
+      auto& parent = tcx.slices[slcIndx.first].pfps[slcIndx.second];
       // found a neutrino
       if (parent.PDGCode == 14 || parent.PDGCode == 12) return dtruid;
       // found a primary PFParticle?
@@ -508,7 +509,7 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  MergeTjIntoPFP(TCSlice& slc, int mtjid, PFPStruct& pfp, bool prt)
+  MergeTjIntoPFP(TCContext& tcx, TCSlice& slc, int mtjid, PFPStruct& pfp, bool prt)
   {
     // Tries to merge Tj with ID tjid into PFParticle pfp
     if (mtjid > (int)slc.tjs.size()) return false;
@@ -523,7 +524,7 @@ namespace tca {
       }
     } // tjid
     if (otjid == 0) return false;
-    if (MergeAndStore(slc, otjid - 1, mtjid - 1, prt)) {
+    if (MergeAndStore(tcx, slc, otjid - 1, mtjid - 1, prt)) {
       int newtjid = slc.tjs.size();
       if (prt)
         mf::LogVerbatim("TC") << "MergeTjIntoPFP: merged T" << otjid << " with T" << mtjid
@@ -541,7 +542,7 @@ namespace tca {
 
   /////////////////////////////////////////
   float
-  PointPull(TCSlice& slc, Point2_t pos, float chg, const Trajectory& tj)
+  PointPull(TCContext& tcx, TCSlice& slc, Point2_t pos, float chg, const Trajectory& tj)
   {
     // returns the combined position and charge pull for the charge at pos
     // relative to the Tj closest to that point using a loose requirement on position separation.
@@ -560,7 +561,7 @@ namespace tca {
     if (closePt == USHRT_MAX) return 100;
     // find the delta between the projection of the Tj close TP to inTP
     auto& tp = tj.Pts[closePt];
-    float delta = PointTrajDOCA(slc, pos[0], pos[1], tp);
+    float delta = PointTrajDOCA(tcx, slc, pos[0], pos[1], tp);
     // estimate the proejcted position error (roughly)
     float posErr = tp.DeltaRMS;
     if (tp.AngErr > 0 && close > 10) posErr += sqrt(tp.AngErr * sqrt(close));
@@ -575,7 +576,7 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  CompatibleMerge(const TCSlice& slc, std::vector<int>& tjIDs, bool prt)
+  CompatibleMerge(TCContext& tcx, const TCSlice& slc, std::vector<int>& tjIDs, bool prt)
   {
     // Returns true if the last Tj in tjIDs has a topology consistent with it being
     // merged with other Tjs in the same plane in the list. This is done by requiring that
@@ -647,7 +648,11 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  CompatibleMerge(const TCSlice& slc, const Trajectory& tj1, const Trajectory& tj2, bool prt)
+  CompatibleMerge(TCContext& tcx,
+                  const TCSlice& slc,
+                  const Trajectory& tj1,
+                  const Trajectory& tj2,
+                  bool prt)
   {
     // returns true if the two Tjs are compatible with and end0-end1 merge. This function has many aspects of the
     // compatibility checks done in EndMerge but with looser cuts.
@@ -686,8 +691,8 @@ namespace tca {
 
     auto& tp1 = tj1.Pts[tj1.EndPt[end1]];
     auto& tp2 = tj2.Pts[tj2.EndPt[end2]];
-    float doca1 = PointTrajDOCA(slc, tp1.Pos[0], tp1.Pos[1], tp2);
-    float doca2 = PointTrajDOCA(slc, tp2.Pos[0], tp2.Pos[1], tp1);
+    float doca1 = PointTrajDOCA(tcx, slc, tp1.Pos[0], tp1.Pos[1], tp2);
+    float doca2 = PointTrajDOCA(tcx, slc, tp2.Pos[0], tp2.Pos[1], tp1);
     if (doca1 > 2 && doca2 > 2) {
       if (prt)
         mf::LogVerbatim("TC") << "CM: " << tj1.ID << " " << tj2.ID << " Both docas > 2 " << doca1
@@ -696,10 +701,10 @@ namespace tca {
     }
 
     float dang = DeltaAngle(tp1.Ang, tp2.Ang);
-    if (dang > 2 * tcc.kinkCuts[0]) {
+    if (dang > 2 * tcx.tcc.kinkCuts[0]) {
       if (prt)
         mf::LogVerbatim("TC") << "CM: " << tj1.ID << " " << tj2.ID << " dang " << dang << " > "
-                              << 2 * tcc.kinkCuts[0];
+                              << 2 * tcx.tcc.kinkCuts[0];
       return false;
     }
 
@@ -761,21 +766,21 @@ namespace tca {
 
   /////////////////////////////////////////
   unsigned short
-  AngleRange(TrajPoint const& tp)
+  AngleRange(TCContext& tcx, TrajPoint const& tp)
   {
-    return AngleRange(tp.Ang);
+    return AngleRange(tcx, tp.Ang);
   }
 
   /////////////////////////////////////////
   void
-  SetAngleCode(TrajPoint& tp)
+  SetAngleCode(TCContext& tcx, TrajPoint& tp)
   {
-    unsigned short ar = AngleRange(tp.Ang);
-    if (ar == tcc.angleRanges.size() - 1) {
+    unsigned short ar = AngleRange(tcx, tp.Ang);
+    if (ar == tcx.tcc.angleRanges.size() - 1) {
       // Very large angle
       tp.AngleCode = 2;
     }
-    else if (tcc.angleRanges.size() > 2 && ar == tcc.angleRanges.size() - 2) {
+    else if (tcx.tcc.angleRanges.size() > 2 && ar == tcx.tcc.angleRanges.size() - 2) {
       // Large angle
       tp.AngleCode = 1;
     }
@@ -788,36 +793,36 @@ namespace tca {
 
   /////////////////////////////////////////
   unsigned short
-  AngleRange(float angle)
+  AngleRange(TCContext& tcx, float angle)
   {
     // returns the index of the angle range
     if (angle > M_PI) angle = M_PI;
     if (angle < -M_PI) angle = M_PI;
     if (angle < 0) angle = -angle;
     if (angle > M_PI / 2) angle = M_PI - angle;
-    for (unsigned short ir = 0; ir < tcc.angleRanges.size(); ++ir) {
-      if (angle < tcc.angleRanges[ir]) return ir;
+    for (unsigned short ir = 0; ir < tcx.tcc.angleRanges.size(); ++ir) {
+      if (angle < tcx.tcc.angleRanges[ir]) return ir;
     }
-    return tcc.angleRanges.size() - 1;
+    return tcx.tcc.angleRanges.size() - 1;
   } // AngleRange
 
   //////////////////////////////////////////
   void
-  FitTraj(TCSlice& slc, Trajectory& tj)
+  FitTraj(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Jacket around FitTraj to fit the leading edge of the supplied trajectory
     unsigned short originPt = tj.EndPt[1];
     unsigned short npts = tj.Pts[originPt].NTPsFit;
     TrajPoint tpFit;
     unsigned short fitDir = -1;
-    FitTraj(slc, tj, originPt, npts, fitDir, tpFit);
+    FitTraj(tcx, slc, tj, originPt, npts, fitDir, tpFit);
     tj.Pts[originPt] = tpFit;
 
   } // FitTraj
 
   //////////////////////////////////////////
   void
-  FitTraj(TCSlice& slc,
+  FitTraj(TCContext& tcx, TCSlice& slc,
           Trajectory& tj,
           unsigned short originPt,
           unsigned short npts,
@@ -856,7 +861,7 @@ namespace tca {
     if (tj.Pts[originPt].Chg == 0) origin = tj.Pts[originPt].Pos;
 
     // simple two point case
-    if (NumPtsWithCharge(slc, tj, false) == 2) {
+    if (NumPtsWithCharge(tcx, slc, tj, false) == 2) {
       for (unsigned short ipt = tj.EndPt[0]; ipt < tj.EndPt[1]; ++ipt) {
         if (tj.Pts[ipt].Chg <= 0) continue;
         double xx = tj.Pts[ipt].HitPos[0] - origin[0];
@@ -881,7 +886,7 @@ namespace tca {
       tpFit.Pos[1] += origin[1];
       tpFit.AngErr = 0.01;
       tpFit.FitChi = 0.01;
-      SetAngleCode(tpFit);
+      SetAngleCode(tcx, tpFit);
       return;
     } // two points
 
@@ -999,7 +1004,7 @@ namespace tca {
     tpFit.Dir[1] = sn * dir[0] + cs * dir[1];
     // ensure that the direction is consistent with the originPt direction
     bool flipDir = false;
-    if (AngleRange(tj.Pts[originPt]) > 0) {
+    if (AngleRange(tcx, tj.Pts[originPt]) > 0) {
       flipDir = std::signbit(tpFit.Dir[1]) != std::signbit(tj.Pts[originPt].Dir[1]);
     }
     else {
@@ -1010,7 +1015,7 @@ namespace tca {
       tpFit.Dir[1] = -tpFit.Dir[1];
     }
     tpFit.Ang = atan2(tpFit.Dir[1], tpFit.Dir[0]);
-    SetAngleCode(tpFit);
+    SetAngleCode(tcx, tpFit);
 
     // rotate (0, intcpt) into (W,T) coordinates
     tpFit.Pos[0] = -sn * A + origin[0];
@@ -1084,7 +1089,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  StoreTraj(TCSlice& slc, Trajectory& tj)
+  StoreTraj(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
 
     // check for errors
@@ -1092,7 +1097,7 @@ namespace tca {
       if (tp.Hits.size() > 16) return false;
     } // tp
 
-    if (tj.NeedsUpdate) UpdateTjChgProperties("ST", slc, tj, false);
+    if (tj.NeedsUpdate) UpdateTjChgProperties("ST", tcx, slc, tj, false);
 
     // This shouldn't be necessary but do it anyway
     SetEndPoints(tj);
@@ -1147,17 +1152,18 @@ namespace tca {
 
     // update the kink significance
     if (!tj.AlgMod[kJunkTj]) {
-      unsigned short nPtsFit = tcc.kinkCuts[0];
-      bool useChg = (tcc.kinkCuts[2] > 0);
+      unsigned short nPtsFit = tcx.tcc.kinkCuts[0];
+      bool useChg = (tcx.tcc.kinkCuts[2] > 0);
       if (npts > 2 * nPtsFit) {
         for (unsigned short ipt = tj.EndPt[0] + nPtsFit; ipt < tj.EndPt[1] - nPtsFit; ++ipt) {
           auto& tp = tj.Pts[ipt];
-          if (tp.KinkSig < 0) tp.KinkSig = KinkSignificance(slc, tj, ipt, nPtsFit, useChg, false);
+          if (tp.KinkSig < 0)
+            tp.KinkSig = KinkSignificance(tcx, slc, tj, ipt, nPtsFit, useChg, false);
         }
       } // long trajectory
     }   // not JunkTj
 
-    UpdateTjChgProperties("ST", slc, tj, false);
+    UpdateTjChgProperties("ST", tcx, slc, tj, false);
 
     int trID = slc.tjs.size() + 1;
 
@@ -1181,7 +1187,7 @@ namespace tca {
     // ensure that inTraj is clean for the ID
     for (unsigned int iht = 0; iht < slc.slHits.size(); ++iht) {
       if (slc.slHits[iht].InTraj == tj.ID) {
-        mf::LogWarning("TC") << "StoreTraj: Hit " << PrintHit(slc.slHits[iht])
+        mf::LogWarning("TC") << "StoreTraj: Hit " << PrintHit(tcx, slc.slHits[iht])
                              << " thinks it belongs to T" << tj.ID << " but it isn't in the Tj\n";
         return false;
       }
@@ -1190,12 +1196,12 @@ namespace tca {
     tj.WorkID = tj.ID;
     tj.ID = trID;
     // increment the global ID
-    ++evt.globalT_UID;
-    tj.UID = evt.globalT_UID;
+    ++slc.ids.globalT_UID;
+    tj.UID = slc.ids.globalT_UID;
     // Don't clobber the ParentID if it was defined by the calling function
     if (tj.ParentID == 0) tj.ParentID = trID;
     slc.tjs.push_back(tj);
-    if (tcc.modes[kDebug] && tcc.dbgSlc && debug.Hit != UINT_MAX) {
+    if (tcx.tcc.modes[kDebug] && tcx.tcc.dbgSlc && debug.Hit != UINT_MAX) {
       // print some debug info
       for (unsigned short ipt = 0; ipt < tj.Pts.size(); ++ipt) {
         for (unsigned short ii = 0; ii < tj.Pts[ipt].Hits.size(); ++ii) {
@@ -1232,7 +1238,8 @@ namespace tca {
     Point2_t inPt;
     Vector2_t outVec, outVecErr;
     float pErr, chiDOF;
-    Fit2D(0, inPt, pErr, outVec, outVecErr, chiDOF);
+    Fit2DSums fit;
+    Fit2D(fit, 0, inPt, pErr, outVec, outVecErr, chiDOF);
     unsigned short cnt = 0;
     for (unsigned short ii = 0; ii < tj.Pts.size(); ++ii) {
       unsigned short ipt = originPt + ii * fitDir;
@@ -1251,13 +1258,13 @@ namespace tca {
       }
       inPt[1] = parVal;
       pFit.AvePar += parVal;
-      if (!Fit2D(2, inPt, pErr, outVec, outVecErr, chiDOF)) break;
+      if (!Fit2D(fit, 2, inPt, pErr, outVec, outVecErr, chiDOF)) break;
       ++cnt;
       if (cnt == npts) break;
     } // ii
     if (cnt < npts) return;
     // do the fit and get the results
-    if (!Fit2D(-1, inPt, pErr, outVec, outVecErr, chiDOF)) return;
+    if (!Fit2D(fit, -1, inPt, pErr, outVec, outVecErr, chiDOF)) return;
     pFit.Pos = tj.Pts[originPt].Pos;
     pFit.Par0 = outVec[0];
     pFit.AvePar /= (float)cnt;
@@ -1271,7 +1278,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  InTrajOK(TCSlice& slc, std::string someText)
+  InTrajOK(TCContext& tcx, TCSlice& slc, std::string someText)
   {
     // Check slc.tjs -> InTraj associations
 
@@ -1303,16 +1310,16 @@ namespace tca {
         myprt << "\n";
         myprt << "index     inTraj     UseHit \n";
         for (iht = 0; iht < atHits.size(); ++iht) {
-          myprt << "iht " << iht << " " << PrintHit(slc.slHits[atHits[iht]]);
-          if (iht < tHits.size()) myprt << " " << PrintHit(slc.slHits[tHits[iht]]);
+          myprt << "iht " << iht << " " << PrintHit(tcx, slc.slHits[atHits[iht]]);
+          if (iht < tHits.size()) myprt << " " << PrintHit(tcx, slc.slHits[tHits[iht]]);
           if (atHits[iht] != tHits[iht]) myprt << " <<< " << atHits[iht] << " != " << tHits[iht];
           myprt << "\n";
         } // iht
         if (tHits.size() > atHits.size()) {
           for (iht = atHits.size(); iht < atHits.size(); ++iht) {
-            myprt << "atHits " << iht << " " << PrintHit(slc.slHits[atHits[iht]]) << "\n";
+            myprt << "atHits " << iht << " " << PrintHit(tcx, slc.slHits[atHits[iht]]) << "\n";
           } // iht
-          PrintTrajectory("CIT", slc, tj, USHRT_MAX);
+          PrintTrajectory("CIT", tcx, slc, tj, USHRT_MAX);
         } // tHit.size > atHits.size()
         return false;
       }
@@ -1332,7 +1339,7 @@ namespace tca {
 
   //////////////////////////////////////////
   void
-  CheckTrajBeginChg(TCSlice& slc, unsigned short itj)
+  CheckTrajBeginChg(TCContext& tcx, TCSlice& slc, unsigned short itj)
   {
     // This function is called after the beginning of the tj has been inspected to see if
     // reverse propagation was warranted. Trajectory points at the beginning were removed by
@@ -1347,13 +1354,13 @@ namespace tca {
     if (itj > slc.tjs.size() - 1) return;
     auto& tj = slc.tjs[itj];
 
-    if (!tcc.useAlg[kBeginChg]) return;
+    if (!tcx.tcc.useAlg[kBeginChg]) return;
     if (tj.EndFlag[0][kBragg]) return;
     if (tj.AlgMod[kFTBRvProp]) return;
     if (tj.AlgMod[kKilled] || tj.AlgMod[kHaloTj]) return;
     if (tj.Pts.size() < 20) return;
 
-    bool prt = (tcc.dbgSlc && (tcc.dbgStp || tcc.dbgAlg[kBeginChg]));
+    bool prt = (tcx.tcc.dbgSlc && (tcx.tcc.dbgStp || tcx.tcc.dbgAlg[kBeginChg]));
 
     // look for a large drop between the average charge near the beginning
     float chg2 = tj.Pts[tj.EndPt[0] + 2].AveChg;
@@ -1423,32 +1430,32 @@ namespace tca {
     aVtx.Stat[kFixed] = true;
     unsigned short ivx = slc.vtxs.size();
     if (!StoreVertex(slc, aVtx)) return;
-    if (!SplitTraj(slc, itj, breakPt, ivx, prt)) {
+    if (!SplitTraj(tcx, slc, itj, breakPt, ivx, prt)) {
       if (prt) mf::LogVerbatim("TC") << "CTBC: Failed to split trajectory";
-      MakeVertexObsolete("CTBC", slc, slc.vtxs[ivx], false);
+      MakeVertexObsolete("CTBC", tcx, slc, slc.vtxs[ivx], false);
       return;
     }
-    SetVx2Score(slc);
+    SetVx2Score(tcx, slc);
     slc.tjs[itj].AlgMod[kBeginChg] = true;
 
     if (prt)
       mf::LogVerbatim("TC") << "CTBC: Split T" << tj.ID << " at "
-                            << PrintPos(slc, tj.Pts[breakPt].Pos) << "\n";
+                            << PrintPos(tcx, slc, tj.Pts[breakPt].Pos) << "\n";
 
   } // CheckTrajBeginChg
 
   //////////////////////////////////////////
   bool
-  BraggSplit(TCSlice& slc, unsigned short itj)
+  BraggSplit(TCContext& tcx, TCSlice& slc, unsigned short itj)
   {
     // Searches the stored trajectory for a Bragg Peak and kink and splits it
-    if (!tcc.useAlg[kBraggSplit]) return false;
+    if (!tcx.tcc.useAlg[kBraggSplit]) return false;
     if (itj > slc.tjs.size() - 1) return false;
-    if (tcc.chkStopCuts.size() < 4) return false;
-    if (tcc.chkStopCuts[3] <= 0) return false;
-    unsigned short nPtsToCheck = tcc.chkStopCuts[1];
+    if (tcx.tcc.chkStopCuts.size() < 4) return false;
+    if (tcx.tcc.chkStopCuts[3] <= 0) return false;
+    unsigned short nPtsToCheck = tcx.tcc.chkStopCuts[1];
     auto& tj = slc.tjs[itj];
-    unsigned short npwc = NumPtsWithCharge(slc, tj, false);
+    unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
     if (npwc < 4) return false;
     if (npwc < nPtsToCheck) nPtsToCheck = npwc;
     // do a rough ChgPull check first
@@ -1467,20 +1474,20 @@ namespace tca {
       dpt = tj.EndPt[1] - maxPullPt;
     }
     if (dpt < 3) return false;
-    bool prt = (tcc.dbgSlc && (tcc.dbgStp || tcc.dbgAlg[kBraggSplit]));
+    bool prt = (tcx.tcc.dbgSlc && (tcx.tcc.dbgStp || tcx.tcc.dbgAlg[kBraggSplit]));
     if (prt)
       mf::LogVerbatim("TC") << "BS: T" << tj.ID << " maxPull " << maxPull << " at "
-                            << PrintPos(slc, tj.Pts[maxPullPt]) << " dpt " << dpt;
+                            << PrintPos(tcx, slc, tj.Pts[maxPullPt]) << " dpt " << dpt;
     unsigned short breakPt = USHRT_MAX;
-    float bestFOM = tcc.chkStopCuts[3];
+    float bestFOM = tcx.tcc.chkStopCuts[3];
     unsigned short bestBragg = 0;
-    unsigned short nPtsFit = tcc.kinkCuts[0];
+    unsigned short nPtsFit = tcx.tcc.kinkCuts[0];
     TrajPoint tp1, tp2;
     ParFit chgFit1, chgFit2;
     for (unsigned short ipt = maxPullPt - 2; ipt <= maxPullPt + 2; ++ipt) {
-      FitTraj(slc, tj, ipt - 1, nPtsFit, -1, tp1);
+      FitTraj(tcx, slc, tj, ipt - 1, nPtsFit, -1, tp1);
       if (tp1.FitChi > 10) continue;
-      FitTraj(slc, tj, ipt + 1, nPtsFit, 1, tp2);
+      FitTraj(tcx, slc, tj, ipt + 1, nPtsFit, 1, tp2);
       if (tp2.FitChi > 10) continue;
       float dang = std::abs(tp1.Ang - tp2.Ang);
       FitPar(slc, tj, ipt - 1, nPtsToCheck, -1, chgFit1, 1);
@@ -1490,7 +1497,8 @@ namespace tca {
       if (chgFit2.ChiDOF > 100) continue;
       chgFit2.ParSlp = -chgFit2.ParSlp;
       // require a large positive slope on at least one side
-      if (chgFit1.ParSlp < tcc.chkStopCuts[0] && chgFit2.ParSlp < tcc.chkStopCuts[0]) continue;
+      if (chgFit1.ParSlp < tcx.tcc.chkStopCuts[0] && chgFit2.ParSlp < tcx.tcc.chkStopCuts[0])
+        continue;
       // assume it is on side 1
       unsigned short bragg = 1;
       float bchi = chgFit1.ChiDOF;
@@ -1504,7 +1512,7 @@ namespace tca {
       float fom = 10 * dang * chgAsym * slpAsym / bchi;
       if (prt) {
         mf::LogVerbatim myprt("TC");
-        myprt << "pt " << PrintPos(slc, tj.Pts[ipt]) << " " << std::setprecision(2) << dang;
+        myprt << "pt " << PrintPos(tcx, slc, tj.Pts[ipt]) << " " << std::setprecision(2) << dang;
         myprt << " chg1 " << (int)chgFit1.Par0 << " slp " << chgFit1.ParSlp << " chi "
               << chgFit1.ChiDOF;
         myprt << " chg2 " << (int)chgFit2.Par0 << " slp " << chgFit2.ParSlp << " chi "
@@ -1521,7 +1529,7 @@ namespace tca {
     } // ipt
     if (breakPt == USHRT_MAX) return false;
     if (prt)
-      mf::LogVerbatim("TC") << " breakPt " << PrintPos(slc, tj.Pts[breakPt]) << " bragg "
+      mf::LogVerbatim("TC") << " breakPt " << PrintPos(tcx, slc, tj.Pts[breakPt]) << " bragg "
                             << bestBragg;
     // Create a vertex at the break point
     VtxStore aVtx;
@@ -1535,12 +1543,12 @@ namespace tca {
     aVtx.Stat[kFixed] = true;
     unsigned short ivx = slc.vtxs.size();
     if (!StoreVertex(slc, aVtx)) return false;
-    if (!SplitTraj(slc, itj, breakPt, ivx, prt)) {
+    if (!SplitTraj(tcx, slc, itj, breakPt, ivx, prt)) {
       if (prt) mf::LogVerbatim("TC") << "BS: Failed to split trajectory";
-      MakeVertexObsolete("BS", slc, slc.vtxs[ivx], false);
+      MakeVertexObsolete("BS", tcx, slc, slc.vtxs[ivx], false);
       return false;
     }
-    SetVx2Score(slc);
+    SetVx2Score(tcx, slc);
     slc.tjs[itj].AlgMod[kBraggSplit] = true;
     unsigned short otj = slc.tjs.size() - 1;
     if (bestBragg == 2) std::swap(itj, otj);
@@ -1552,20 +1560,20 @@ namespace tca {
 
   //////////////////////////////////////////
   void
-  TrimHiChgEndPts(TCSlice& slc, Trajectory& tj, bool prt)
+  TrimHiChgEndPts(TCContext& tcx, TCSlice& slc, Trajectory& tj, bool prt)
   {
     // Trim points at the end if the charge pull is too high
-    if (!tcc.useAlg[kTHCEP]) return;
+    if (!tcx.tcc.useAlg[kTHCEP]) return;
     // don't consider long electrons
     if (tj.PDGCode == 111) return;
-    unsigned short npwc = NumPtsWithCharge(slc, tj, false);
+    unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
     // only consider long tjs
     if (npwc < 50) return;
     // that don't have a Bragg peak
     if (tj.EndFlag[1][kBragg]) return;
 
     // only look at the last points that would have not been considered by GottaKink
-    unsigned short nPtsMax = tcc.kinkCuts[0];
+    unsigned short nPtsMax = tcx.tcc.kinkCuts[0];
     if (nPtsMax > 8) nPtsMax = 8;
 
     // find the first point with a high charge pull starting at nPtsMax points before the end
@@ -1587,7 +1595,8 @@ namespace tca {
     float fracBad = cntBad / cntTot;
     if (fracBad < 0.5) return;
     if (prt)
-      mf::LogVerbatim("TC") << "THCEP: Trim points starting at " << PrintPos(slc, tj.Pts[firstBad]);
+      mf::LogVerbatim("TC") << "THCEP: Trim points starting at "
+                            << PrintPos(tcx, slc, tj.Pts[firstBad]);
     for (unsigned short ipt = firstBad; ipt <= tj.EndPt[1]; ++ipt)
       UnsetUsedHits(slc, tj.Pts[ipt]);
     tj.AlgMod[kTHCEP] = true;
@@ -1596,6 +1605,7 @@ namespace tca {
   //////////////////////////////////////////
   void
   TrimEndPts(std::string fcnLabel,
+             TCContext& tcx,
              TCSlice& slc,
              Trajectory& tj,
              const std::vector<float>& fQualityCuts,
@@ -1610,11 +1620,11 @@ namespace tca {
     //  ----DDD-D-- is OK
     //  ----DDDDD-- is not OK
 
-    if (!tcc.useAlg[kTEP]) return;
+    if (!tcx.tcc.useAlg[kTEP]) return;
     if (tj.PDGCode == 111) return;
     if (tj.EndFlag[1][kAtKink]) return;
 
-    unsigned short npwc = NumPtsWithCharge(slc, tj, false);
+    unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
     short minPts = fQualityCuts[1];
     if (minPts < 1) return;
     if (npwc < minPts) return;
@@ -1657,7 +1667,7 @@ namespace tca {
           if (std::abs(tp.Pos[0] - ptp.Pos[0]) < 1.5) ++nadj;
         }
       } // ipt
-      float ntpwc = NumPtsWithCharge(slc, tj, true, tj.EndPt[0], lastPt);
+      float ntpwc = NumPtsWithCharge(tcx, slc, tj, true, tj.EndPt[0], lastPt);
       float nwires = std::abs(tj.Pts[tj.EndPt[0]].Pos[0] - tj.Pts[lastPt].Pos[0]) + 1;
       float hitFrac = ntpwc / nwires;
       if (prt)
@@ -1679,7 +1689,7 @@ namespace tca {
         mf::LogVerbatim("TC") << fcnLabel << "-TEP: is prevWire " << prevWire << " dead? ";
       }
       unsigned short plane = DecodeCTP(tj.CTP).Plane;
-      if (prevWire < slc.nWires[plane] && !evt.goodWire[plane][prevWire]) --lastPt;
+      if (prevWire < slc.nWires[plane] && !tcx.evt.goodWire[plane][prevWire]) --lastPt;
     } // valid Pos[0]
 
     // Nothing needs to be done
@@ -1695,29 +1705,29 @@ namespace tca {
     tj.AlgMod[kTEP] = true;
     if (prt) {
       fcnLabel += "-TEPo";
-      PrintTrajectory(fcnLabel, slc, tj, USHRT_MAX);
+      PrintTrajectory(fcnLabel, tcx, slc, tj, USHRT_MAX);
     }
 
   } // TrimEndPts
 
   /////////////////////////////////////////
   void
-  ChkEndKink(TCSlice& slc, Trajectory& tj, bool prt)
+  ChkEndKink(TCContext& tcx, TCSlice& slc, Trajectory& tj, bool prt)
   {
     // look for large-angle kink near the end
-    if (!tcc.useAlg[kEndKink]) return;
+    if (!tcx.tcc.useAlg[kEndKink]) return;
     if (tj.PDGCode == 111) return;
     if (tj.EndPt[1] - tj.EndPt[0] < 6) return;
 
     if (prt) mf::LogVerbatim("TC") << "CEK: Inside ChkEndKinks T" << tj.ID << " ";
 
-    float maxSig = tcc.kinkCuts[1];
+    float maxSig = tcx.tcc.kinkCuts[1];
     unsigned short withNptsFit = 0;
-    unsigned short nPtsFit = tcc.kinkCuts[0];
-    bool useChg = (tcc.kinkCuts[2] > 0);
+    unsigned short nPtsFit = tcx.tcc.kinkCuts[0];
+    bool useChg = (tcx.tcc.kinkCuts[2] > 0);
     for (unsigned short nptsf = 3; nptsf < nPtsFit; ++nptsf) {
       unsigned short ipt = tj.EndPt[1] - nptsf;
-      float ks = KinkSignificance(slc, tj, ipt, nptsf, useChg, prt);
+      float ks = KinkSignificance(tcx, slc, tj, ipt, nptsf, useChg, prt);
       if (ks > maxSig) {
         maxSig = ks;
         withNptsFit = nptsf;
@@ -1726,9 +1736,9 @@ namespace tca {
     if (withNptsFit > 0) {
       unsigned short ipt = tj.EndPt[1] - withNptsFit;
       std::cout << "CEK: T" << tj.ID << " ipt " << ipt;
-      float ks = KinkSignificance(slc, tj, ipt, withNptsFit, false, prt);
+      float ks = KinkSignificance(tcx, slc, tj, ipt, withNptsFit, false, prt);
       auto& tp = tj.Pts[ipt];
-      std::cout << " " << PrintPos(slc, tp) << " withNptsFit " << withNptsFit << " ks " << ks
+      std::cout << " " << PrintPos(tcx, slc, tp) << " withNptsFit " << withNptsFit << " ks " << ks
                 << "\n";
     }
 
@@ -1736,13 +1746,13 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  ChkChgAsymmetry(TCSlice& slc, Trajectory& tj, bool prt)
+  ChkChgAsymmetry(TCContext& tcx, TCSlice& slc, Trajectory& tj, bool prt)
   {
     // looks for a high-charge point in the trajectory which may be due to the
     // trajectory crossing an interaction vertex. The properties of points on the opposite
     // sides of the high-charge point are analyzed. If significant differences are found, all points
     // near the high-charge point are removed as well as those from that point to the end
-    if (!tcc.useAlg[kChkChgAsym]) return;
+    if (!tcx.tcc.useAlg[kChkChgAsym]) return;
     if (tj.PDGCode == 111) return;
     unsigned short npts = tj.EndPt[1] - tj.EndPt[0];
     if (prt) mf::LogVerbatim("TC") << " Inside ChkChgAsymmetry T" << tj.ID;
@@ -1797,12 +1807,12 @@ namespace tca {
       UnsetUsedHits(slc, tj.Pts[ipt]);
     SetEndPoints(tj);
     tj.AlgMod[kChkChgAsym] = true;
-    if (prt) PrintTrajectory("CCA", slc, tj, USHRT_MAX);
+    if (prt) PrintTrajectory("CCA", tcx, slc, tj, USHRT_MAX);
   } // ChkChgAsymmetry
 
   /////////////////////////////////////////
   bool
-  SignalBetween(const TCSlice& slc,
+  SignalBetween(TCContext& tcx, const TCSlice& slc,
                 const TrajPoint& tp1,
                 const TrajPoint& tp2,
                 const float& MinWireSignalFraction)
@@ -1818,25 +1828,29 @@ namespace tca {
       TrajPoint tp = tp1;
       // check for a signal midway between
       tp.Pos[1] = 0.5 * (tp1.Pos[1] + tp2.Pos[1]);
-      return SignalAtTp(tp);
+      return SignalAtTp(tcx, slc, tp);
     }
     // define a trajectory point located at tp1 that has a direction towards tp2
     TrajPoint tp;
-    if (!MakeBareTrajPoint(slc, tp1, tp2, tp)) return true;
-    return SignalBetween(slc, tp, toWire, MinWireSignalFraction);
+    if (!MakeBareTrajPoint(tcx, slc, tp1, tp2, tp)) return true;
+    return SignalBetween(tcx, slc, tp, toWire, MinWireSignalFraction);
   } // SignalBetween
 
   /////////////////////////////////////////
   bool
-  SignalBetween(const TCSlice& slc, TrajPoint tp, float toPos0, const float& MinWireSignalFraction)
+  SignalBetween(TCContext& tcx,
+                const TCSlice& slc,
+                TrajPoint tp,
+                float toPos0,
+                const float& MinWireSignalFraction)
   {
     // Returns true if there is a signal on > MinWireSignalFraction of the wires between tp and toPos0.
-    return ChgFracBetween(slc, tp, toPos0) >= MinWireSignalFraction;
+    return ChgFracBetween(tcx, slc, tp, toPos0) >= MinWireSignalFraction;
   } // SignalBetween
 
   /////////////////////////////////////////
   float
-  ChgFracBetween(const TCSlice& slc, TrajPoint tp, float toPos0)
+  ChgFracBetween(TCContext& tcx, const TCSlice& slc, TrajPoint tp, float toPos0)
   {
     // Returns the fraction of wires between tp.Pos[0] and toPos0 that have a hit
     // on the line defined by tp.Pos and tp.Dir
@@ -1845,7 +1859,7 @@ namespace tca {
     int fromWire = std::nearbyint(tp.Pos[0]);
     int toWire = std::nearbyint(toPos0);
 
-    if (fromWire == toWire) return SignalAtTp(tp);
+    if (fromWire == toWire) return SignalAtTp(tcx, slc, tp);
 
     int nWires = abs(toWire - fromWire) + 1;
 
@@ -1858,7 +1872,7 @@ namespace tca {
     float num = 0;
     for (unsigned short cnt = 0; cnt < nWires; ++cnt) {
       ++num;
-      if (SignalAtTp(tp)) ++nsig;
+      if (SignalAtTp(tcx, slc, tp)) ++nsig;
       tp.Pos[0] += tp.Dir[0] * stepSize;
       tp.Pos[1] += tp.Dir[1] * stepSize;
     } // cnt
@@ -1868,7 +1882,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  TrajHitsOK(TCSlice& slc,
+  TrajHitsOK(TCContext& tcx, TCSlice& slc,
              const std::vector<unsigned int>& iHitsInMultiplet,
              const std::vector<unsigned int>& jHitsInMultiplet)
   {
@@ -1877,12 +1891,12 @@ namespace tca {
     if (iHitsInMultiplet.empty() || jHitsInMultiplet.empty()) return false;
 
     float sum;
-    float cvI = HitsPosTick(slc, iHitsInMultiplet, sum, kAllHits);
+    float cvI = HitsPosTick(tcx, slc, iHitsInMultiplet, sum, kAllHits);
     if (cvI < 0) return false;
     float minI = 1E6;
     float maxI = 0;
     for (auto& iht : iHitsInMultiplet) {
-      auto const& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto const& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       float cv = hit.PeakTime();
       float rms = hit.RMS();
       float arg = cv - 3.1 * rms;
@@ -1891,12 +1905,12 @@ namespace tca {
       if (arg > maxI) maxI = arg;
     }
 
-    float cvJ = HitsPosTick(slc, jHitsInMultiplet, sum, kAllHits);
+    float cvJ = HitsPosTick(tcx, slc, jHitsInMultiplet, sum, kAllHits);
     if (cvJ < 0) return false;
     float minJ = 1E6;
     float maxJ = 0;
     for (auto& jht : jHitsInMultiplet) {
-      auto& hit = (*evt.allHits)[slc.slHits[jht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[jht].allHitsIndex];
       float cv = hit.PeakTime();
       float rms = hit.RMS();
       float arg = cv - 3.1 * rms;
@@ -1916,14 +1930,14 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  TrajHitsOK(TCSlice& slc, const unsigned int iht, const unsigned int jht)
+  TrajHitsOK(TCContext& tcx, TCSlice& slc, const unsigned int iht, const unsigned int jht)
   {
     // ensure that two adjacent hits have an acceptable overlap
     if (iht > slc.slHits.size() - 1) return false;
     if (jht > slc.slHits.size() - 1) return false;
     // require that they be on adjacent wires
-    auto& ihit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
-    auto& jhit = (*evt.allHits)[slc.slHits[jht].allHitsIndex];
+    auto& ihit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
+    auto& jhit = (*tcx.evt.allHits)[slc.slHits[jht].allHitsIndex];
     int iwire = ihit.WireID().Wire;
     int jwire = jhit.WireID().Wire;
     if (std::abs(iwire - jwire) > 1) return false;
@@ -1942,13 +1956,13 @@ namespace tca {
 
   ////////////////////////////////////////////////
   float
-  ExpectedHitsRMS(TCSlice& slc, const TrajPoint& tp)
+  ExpectedHitsRMS(TCContext& tcx, TCSlice& slc, const TrajPoint& tp)
   {
     // returns the expected RMS of hits for the trajectory point in ticks
     if (std::abs(tp.Dir[0]) > 0.001) {
       geo::PlaneID planeID = DecodeCTP(tp.CTP);
-      return 1.5 * evt.aveHitRMS[planeID.Plane] +
-             2 * std::abs(tp.Dir[1] / tp.Dir[0]) / tcc.unitsPerTick;
+      return 1.5 * tcx.evt.aveHitRMS[planeID.Plane] +
+             2 * std::abs(tp.Dir[1] / tp.Dir[0]) / tcx.tcc.unitsPerTick;
     }
     else {
       return 500;
@@ -1957,7 +1971,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  SignalAtTpInSlc(const TCSlice& slc, const TrajPoint& tp)
+  SignalAtTpInSlc(TCContext& tcx, const TCSlice& slc, const TrajPoint& tp)
   {
     // Version of SignalAtTP that only checks the hit collection in the current slice
 
@@ -1965,16 +1979,16 @@ namespace tca {
     geo::PlaneID planeID = DecodeCTP(tp.CTP);
     unsigned short pln = planeID.Plane;
     unsigned int wire = std::nearbyint(tp.Pos[0]);
-    if (wire > evt.goodWire[pln].size() - 1) return false;
+    if (wire > tcx.evt.goodWire[pln].size() - 1) return false;
     // assume there is a signal on a dead wire
-    if (!evt.goodWire[pln][wire]) return true;
+    if (!tcx.evt.goodWire[pln][wire]) return true;
     // no signal here if there are no hits on this wire
     if (slc.wireHitRange[pln][wire].first == UINT_MAX) return false;
     // check the proximity of all of the hits in the range
-    float projTick = (float)(tp.Pos[1] / tcc.unitsPerTick);
+    float projTick = (float)(tp.Pos[1] / tcx.tcc.unitsPerTick);
     float tickRange = 0;
     if (std::abs(tp.Dir[1]) != 0) {
-      tickRange = std::abs(0.5 / tp.Dir[1]) / tcc.unitsPerTick;
+      tickRange = std::abs(0.5 / tp.Dir[1]) / tcx.tcc.unitsPerTick;
       // don't let it get too large
       if (tickRange > 40) tickRange = 40;
     }
@@ -1984,7 +1998,7 @@ namespace tca {
          iht <= slc.wireHitRange[pln][wire].second;
          ++iht) {
       unsigned int ahi = slc.slHits[iht].allHitsIndex;
-      auto& hit = (*evt.allHits)[ahi];
+      auto& hit = (*tcx.evt.allHits)[ahi];
       if (projTick < hit.PeakTime()) {
         float loHitTick = hit.PeakTime() - 3 * hit.RMS();
         if (hiTpTick > loHitTick) return true;
@@ -1999,32 +2013,29 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  SignalAtTp(TrajPoint& tp)
+  SignalAtTp(TCContext& tcx, const TCSlice& slc, TrajPoint& tp)
   {
     // returns true if there is a hit near tp.Pos by searching through the full hit collection (if there
-    // are multiple slices) or through the last slice (if there is only one slice)
+    // are multiple slices) or through slc (if there is only one slice)
 
     tp.Environment[kEnvNearSrcHit] = false;
 
-    // just check the hits in the last slice
-    if (evt.wireHitRange.empty()) {
-      const auto& slc = slices[slices.size() - 1];
-      return SignalAtTpInSlc(slc, tp);
-    }
+    // just check the hits in this slice
+    if (tcx.evt.wireHitRange.empty()) return SignalAtTpInSlc(tcx, slc, tp);
 
     if (tp.Pos[0] < -0.4) return false;
     geo::PlaneID planeID = DecodeCTP(tp.CTP);
     unsigned short pln = planeID.Plane;
     unsigned int wire = std::nearbyint(tp.Pos[0]);
-    if (wire > evt.goodWire[pln].size() - 1) return false;
+    if (wire > tcx.evt.goodWire[pln].size() - 1) return false;
     // assume there is a signal on a dead wire
-    if (!evt.goodWire[pln][wire]) return true;
+    if (!tcx.evt.goodWire[pln][wire]) return true;
 
     // check the proximity of all of the hits in the range
-    float projTick = (float)(tp.Pos[1] / tcc.unitsPerTick);
+    float projTick = (float)(tp.Pos[1] / tcx.tcc.unitsPerTick);
     float tickRange = 0;
     if (std::abs(tp.Dir[1]) != 0) {
-      tickRange = std::abs(0.5 / tp.Dir[1]) / tcc.unitsPerTick;
+      tickRange = std::abs(0.5 / tp.Dir[1]) / tcx.tcc.unitsPerTick;
       // don't let it get too large
       if (tickRange > 40) tickRange = 40;
     }
@@ -2032,12 +2043,12 @@ namespace tca {
     float hiTpTick = projTick + tickRange;
 
     // no signal here if there are no hits on this wire
-    if (evt.wireHitRange[pln][wire].first == UINT_MAX) return false;
+    if (tcx.evt.wireHitRange[pln][wire].first == UINT_MAX) return false;
 
-    for (unsigned int iht = evt.wireHitRange[pln][wire].first;
-         iht <= evt.wireHitRange[pln][wire].second;
+    for (unsigned int iht = tcx.evt.wireHitRange[pln][wire].first;
+         iht <= tcx.evt.wireHitRange[pln][wire].second;
          ++iht) {
-      auto& hit = (*evt.allHits)[iht];
+      auto& hit = (*tcx.evt.allHits)[iht];
       // We wouldn't need to make this check if hits were sorted
       const auto& wid = hit.WireID();
       if (wid.Cryostat != planeID.Cryostat) continue;
@@ -2055,8 +2066,8 @@ namespace tca {
     // No hit was found near projTick. Search through the source hits collection
     // (if it is defined) for a hit that may have been removed by disambiguation
     // Use the srcHit collection if it is available
-    if (evt.srcHits != NULL) {
-      if (NearbySrcHit(planeID, wire, loTpTick, hiTpTick)) {
+    if (tcx.evt.srcHits != NULL) {
+      if (NearbySrcHit(tcx, planeID, wire, loTpTick, hiTpTick)) {
         tp.Environment[kEnvNearSrcHit] = true;
         return true;
       } // NearbySrcHit
@@ -2066,24 +2077,26 @@ namespace tca {
 
   //////////////////////////////////////////
   bool
-  NearbySrcHit(geo::PlaneID plnID, unsigned int wire, float loTick, float hiTick)
+  NearbySrcHit(TCContext& tcx, geo::PlaneID plnID, unsigned int wire, float loTick, float hiTick)
   {
     // Look for a hit on wid in the srcHits collection that has a tick in the range. This
     // is a DUNE-specific function in which hit disambiguation is done in the U and V planes
-    if (evt.srcHits == NULL) return false;
+    if (tcx.evt.srcHits == NULL) return false;
     unsigned int pln = plnID.Plane;
     if (pln == 2) return false;
 
     unsigned int cstat = plnID.Cryostat;
     unsigned int tpc = plnID.TPC;
     // get a valid range of hits to search
-    if (evt.tpcSrcHitRange[tpc].first >= (*evt.srcHits).size()) return false;
-    if (evt.tpcSrcHitRange[tpc].second >= (*evt.srcHits).size()) return false;
-    raw::ChannelID_t chan = tcc.geom->PlaneWireToChannel((int)pln, (int)wire, (int)tpc, (int)cstat);
+    if (tcx.evt.tpcSrcHitRange[tpc].first >= (*tcx.evt.srcHits).size()) return false;
+    if (tcx.evt.tpcSrcHitRange[tpc].second >= (*tcx.evt.srcHits).size()) return false;
+    raw::ChannelID_t chan =
+      tcx.tcc.geom->PlaneWireToChannel((int)pln, (int)wire, (int)tpc, (int)cstat);
     float atTick = 0.5 * (loTick + hiTick);
-    for (unsigned int iht = evt.tpcSrcHitRange[tpc].first; iht <= evt.tpcSrcHitRange[tpc].second;
+    for (unsigned int iht = tcx.evt.tpcSrcHitRange[tpc].first;
+         iht <= tcx.evt.tpcSrcHitRange[tpc].second;
          ++iht) {
-      auto& hit = (*evt.srcHits)[iht];
+      auto& hit = (*tcx.evt.srcHits)[iht];
       if (hit.Channel() != chan) continue;
       if (atTick < hit.PeakTime()) {
         float loHitTick = hit.PeakTime() - 3 * hit.RMS();
@@ -2099,28 +2112,28 @@ namespace tca {
 
   //////////////////////////////////////////
   float
-  TpSumHitChg(const TCSlice& slc, TrajPoint const& tp)
+  TpSumHitChg(TCContext& tcx, const TCSlice& slc, TrajPoint const& tp)
   {
     float totchg = 0;
     for (size_t i = 0; i < tp.Hits.size(); ++i) {
       if (!tp.UseHit[i]) continue;
-      totchg += (*evt.allHits)[slc.slHits[tp.Hits[i]].allHitsIndex].Integral();
+      totchg += (*tcx.evt.allHits)[slc.slHits[tp.Hits[i]].allHitsIndex].Integral();
     }
     return totchg;
   } // TpSumHitChg
 
   //////////////////////////////////////////
   unsigned short
-  NumPtsWithCharge(const TCSlice& slc, const Trajectory& tj, bool includeDeadWires)
+  NumPtsWithCharge(TCContext& tcx, const TCSlice& slc, const Trajectory& tj, bool includeDeadWires)
   {
     unsigned short firstPt = tj.EndPt[0];
     unsigned short lastPt = tj.EndPt[1];
-    return NumPtsWithCharge(slc, tj, includeDeadWires, firstPt, lastPt);
+    return NumPtsWithCharge(tcx, slc, tj, includeDeadWires, firstPt, lastPt);
   }
 
   //////////////////////////////////////////
   unsigned short
-  NumPtsWithCharge(const TCSlice& slc,
+  NumPtsWithCharge(TCContext& tcx, const TCSlice& slc,
                    const Trajectory& tj,
                    bool includeDeadWires,
                    unsigned short firstPt,
@@ -2130,20 +2143,24 @@ namespace tca {
     for (unsigned short ipt = firstPt; ipt <= lastPt; ++ipt)
       if (tj.Pts[ipt].Chg > 0) ++ntp;
     // Add the count of deadwires
-    if (includeDeadWires) ntp += DeadWireCount(slc, tj.Pts[firstPt], tj.Pts[lastPt]);
+    if (includeDeadWires) ntp += DeadWireCount(tcx, slc, tj.Pts[firstPt], tj.Pts[lastPt]);
     return ntp;
   } // NumPtsWithCharge
 
   //////////////////////////////////////////
   float
-  DeadWireCount(const TCSlice& slc, const TrajPoint& tp1, const TrajPoint& tp2)
+  DeadWireCount(TCContext& tcx, const TCSlice& slc, const TrajPoint& tp1, const TrajPoint& tp2)
   {
-    return DeadWireCount(slc, tp1.Pos[0], tp2.Pos[0], tp1.CTP);
+    return DeadWireCount(tcx, slc, tp1.Pos[0], tp2.Pos[0], tp1.CTP);
   } // DeadWireCount
 
   //////////////////////////////////////////
   float
-  DeadWireCount(const TCSlice& slc, const float& inWirePos1, const float& inWirePos2, CTP_t tCTP)
+  DeadWireCount(TCContext& tcx,
+                const TCSlice& slc,
+                const float& inWirePos1,
+                const float& inWirePos2,
+                CTP_t tCTP)
   {
     if (inWirePos1 < -0.4 || inWirePos2 < -0.4) return 0;
     unsigned int inWire1 = std::nearbyint(inWirePos1);
@@ -2160,7 +2177,7 @@ namespace tca {
     ++inWire2;
     unsigned int wire, ndead = 0;
     for (wire = inWire1; wire < inWire2; ++wire)
-      if (!evt.goodWire[plane][wire]) ++ndead;
+      if (!tcx.evt.goodWire[plane][wire]) ++ndead;
     return ndead;
   } // DeadWireCount
 
@@ -2215,10 +2232,10 @@ namespace tca {
 
   //////////////////////////////////////////
   void
-  MergeGhostTjs(TCSlice& slc, CTP_t inCTP)
+  MergeGhostTjs(TCContext& tcx, TCSlice& slc, CTP_t inCTP)
   {
     // Merges short Tjs that share many hits with a longer Tj
-    if (!tcc.useAlg[kMrgGhost]) return;
+    if (!tcx.tcc.useAlg[kMrgGhost]) return;
 
     for (auto& shortTj : slc.tjs) {
       if (shortTj.AlgMod[kKilled] || shortTj.AlgMod[kHaloTj]) continue;
@@ -2268,6 +2285,7 @@ namespace tca {
   //////////////////////////////////////////
   bool
   SplitTraj(detinfo::DetectorPropertiesData const& detProp,
+            TCContext& tcx,
             TCSlice& slc,
             unsigned short itj,
             float XPos,
@@ -2280,7 +2298,7 @@ namespace tca {
 
     auto& tj = slc.tjs[itj];
     geo::PlaneID planeID = DecodeCTP(tj.CTP);
-    float atPos1 = detProp.ConvertXToTicks(XPos, planeID) * tcc.unitsPerTick;
+    float atPos1 = detProp.ConvertXToTicks(XPos, planeID) * tcx.tcc.unitsPerTick;
     unsigned short atPt = USHRT_MAX;
     for (unsigned short ipt = tj.EndPt[0] + 1; ipt <= tj.EndPt[1]; ++ipt) {
       if (tj.Pts[ipt].Pos[1] > tj.Pts[ipt - 1].Pos[1]) {
@@ -2309,12 +2327,17 @@ namespace tca {
       newVx2.NTraj = 2;
       if (StoreVertex(slc, newVx2)) vx2Index = slc.vtxs.size() - 1;
     } // makeVx2
-    return SplitTraj(slc, itj, atPt, vx2Index, prt);
+    return SplitTraj(tcx, slc, itj, atPt, vx2Index, prt);
   } // SplitTraj
 
   //////////////////////////////////////////
   bool
-  SplitTraj(TCSlice& slc, unsigned short itj, unsigned short pos, unsigned short ivx, bool prt)
+  SplitTraj(TCContext& tcx,
+            TCSlice& slc,
+            unsigned short itj,
+            unsigned short pos,
+            unsigned short ivx,
+            bool prt)
   {
     // Splits the trajectory itj in the slc.tjs vector into two trajectories at position pos. Splits
     // the trajectory and associates the ends to the supplied vertex.
@@ -2333,7 +2356,7 @@ namespace tca {
 
     if (prt) {
       mf::LogVerbatim myprt("TC");
-      myprt << "SplitTraj: Split T" << tj.ID << " at point " << PrintPos(slc, tj.Pts[pos]);
+      myprt << "SplitTraj: Split T" << tj.ID << " at point " << PrintPos(tcx, slc, tj.Pts[pos]);
       if (ivx < slc.vtxs.size()) myprt << " with Vtx 2V" << slc.vtxs[ivx].ID;
     }
 
@@ -2362,8 +2385,8 @@ namespace tca {
     // make a copy that will become the Tj after the split point
     Trajectory newTj = tj;
     newTj.ID = slc.tjs.size() + 1;
-    ++evt.globalT_UID;
-    newTj.UID = evt.globalT_UID;
+    ++slc.ids.globalT_UID;
+    newTj.UID = slc.ids.globalT_UID;
     // make another copy in case something goes wrong
     Trajectory oldTj = tj;
 
@@ -2383,9 +2406,9 @@ namespace tca {
     }   // ipt
     SetEndPoints(tj);
     // Update MCSMom and charge properties
-    tj.MCSMom = MCSMom(slc, tj);
-    UpdateTjChgProperties("ST", slc, tj, prt);
-    if (splittingMuon) SetPDGCode(slc, tj);
+    tj.MCSMom = MCSMom(tcx, slc, tj);
+    UpdateTjChgProperties("ST", tcx, slc, tj, prt);
+    if (splittingMuon) SetPDGCode(tcx, slc, tj);
 
     // Append 3 points from the end of tj onto the
     // beginning of newTj so that hits can be swapped between
@@ -2412,9 +2435,9 @@ namespace tca {
       newTj.Pts[ipt].Chg = 0;
     } // ipt
     SetEndPoints(newTj);
-    newTj.MCSMom = MCSMom(slc, newTj);
-    UpdateTjChgProperties("ST", slc, newTj, prt);
-    if (splittingMuon) SetPDGCode(slc, newTj);
+    newTj.MCSMom = MCSMom(tcx, slc, newTj);
+    UpdateTjChgProperties("ST", tcx, slc, newTj, prt);
+    if (splittingMuon) SetPDGCode(tcx, slc, newTj);
     if (ivx < slc.vtxs.size()) newTj.VtxID[0] = slc.vtxs[ivx].ID;
     newTj.AlgMod[kSplit] = true;
     newTj.ParentID = 0;
@@ -2455,19 +2478,19 @@ namespace tca {
 
   //////////////////////////////////////////
   bool
-  TrajTrajDOCA(const TCSlice& slc,
+  TrajTrajDOCA(TCContext& tcx, const TCSlice& slc,
                const Trajectory& tj1,
                const Trajectory& tj2,
                unsigned short& ipt1,
                unsigned short& ipt2,
                float& minSep)
   {
-    return TrajTrajDOCA(slc, tj1, tj2, ipt1, ipt2, minSep, false);
+    return TrajTrajDOCA(tcx, slc, tj1, tj2, ipt1, ipt2, minSep, false);
   } // TrajTrajDOCA
 
   //////////////////////////////////////////
   bool
-  TrajTrajDOCA(const TCSlice& slc,
+  TrajTrajDOCA(TCContext& tcx, const TCSlice& slc,
                const Trajectory& tj1,
                const Trajectory& tj2,
                unsigned short& ipt1,
@@ -2513,7 +2536,7 @@ namespace tca {
     bool isClose = false;
     for (unsigned short i1 = tj1.EndPt[0]; i1 < tj1.EndPt[1] + 1; ++i1) {
       for (unsigned short i2 = tj2.EndPt[0]; i2 < tj2.EndPt[1] + 1; ++i2) {
-        if (considerDeadWires) dwc = DeadWireCount(slc, tj1.Pts[i1], tj2.Pts[i2]);
+        if (considerDeadWires) dwc = DeadWireCount(tcx, slc, tj1.Pts[i1], tj2.Pts[i2]);
         float dw = tj1.Pts[i1].Pos[0] - tj2.Pts[i2].Pos[0] - dwc;
         if (std::abs(dw) > minSep) continue;
         float dt = tj1.Pts[i1].Pos[1] - tj2.Pts[i2].Pos[1];
@@ -2533,14 +2556,14 @@ namespace tca {
 
   //////////////////////////////////////////
   float
-  HitSep2(const TCSlice& slc, unsigned int iht, unsigned int jht)
+  HitSep2(TCContext& tcx, const TCSlice& slc, unsigned int iht, unsigned int jht)
   {
     // returns the separation^2 between two hits in WSE units
     if (iht > slc.slHits.size() - 1 || jht > slc.slHits.size() - 1) return 1E6;
-    auto& ihit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
-    auto& jhit = (*evt.allHits)[slc.slHits[jht].allHitsIndex];
+    auto& ihit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
+    auto& jhit = (*tcx.evt.allHits)[slc.slHits[jht].allHitsIndex];
     float dw = (float)ihit.WireID().Wire - (float)jhit.WireID().Wire;
-    float dt = (ihit.PeakTime() - jhit.PeakTime()) * tcc.unitsPerTick;
+    float dt = (ihit.PeakTime() - jhit.PeakTime()) * tcx.tcc.unitsPerTick;
     return dw * dw + dt * dt;
   } // HitSep2
 
@@ -2567,18 +2590,18 @@ namespace tca {
 
   //////////////////////////////////////////
   float
-  PointTrajDOCA(const TCSlice& slc, unsigned int iht, TrajPoint const& tp)
+  PointTrajDOCA(TCContext& tcx, const TCSlice& slc, unsigned int iht, TrajPoint const& tp)
   {
     if (iht > slc.slHits.size() - 1) return 1E6;
-    auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+    auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
     float wire = hit.WireID().Wire;
-    float time = hit.PeakTime() * tcc.unitsPerTick;
+    float time = hit.PeakTime() * tcx.tcc.unitsPerTick;
     return sqrt(PointTrajDOCA2(slc, wire, time, tp));
   } // PointTrajDOCA
 
   //////////////////////////////////////////
   float
-  PointTrajDOCA(const TCSlice& slc, float wire, float time, TrajPoint const& tp)
+  PointTrajDOCA(TCContext& tcx, const TCSlice& slc, float wire, float time, TrajPoint const& tp)
   {
     return sqrt(PointTrajDOCA2(slc, wire, time, tp));
   } // PointTrajDOCA
@@ -2807,7 +2830,7 @@ namespace tca {
 
   //////////////////////////////////////////
   bool
-  HasDuplicateHits(const TCSlice& slc, Trajectory const& tj, bool prt)
+  HasDuplicateHits(TCContext& tcx, const TCSlice& slc, Trajectory const& tj, bool prt)
   {
     // returns true if a hit is associated with more than one TP
     auto tjHits = PutTrajHitsInVector(tj, kAllHits);
@@ -2815,8 +2838,8 @@ namespace tca {
       for (unsigned short jj = ii + 1; jj < tjHits.size(); ++jj) {
         if (tjHits[ii] == tjHits[jj]) {
           if (prt)
-            mf::LogVerbatim("TC") << "HDH: Hit " << PrintHit(slc.slHits[ii]) << " is a duplicate "
-                                  << ii << " " << jj;
+            mf::LogVerbatim("TC") << "HDH: Hit " << PrintHit(tcx, slc.slHits[ii])
+                                  << " is a duplicate " << ii << " " << jj;
           return true;
         }
       } // jj
@@ -2838,7 +2861,7 @@ namespace tca {
 
   //////////////////////////////////////////
   std::vector<unsigned int>
-  FindCloseHits(const TCSlice& slc,
+  FindCloseHits(TCContext& tcx, const TCSlice& slc,
                 std::array<int, 2> const& wireWindow,
                 Point2_t const& timeWindow,
                 const unsigned short plane,
@@ -2868,16 +2891,16 @@ namespace tca {
     int hiWire = wireWindow[1];
     if (hiWire > (int)slc.lastWire[plane] - 1) hiWire = slc.lastWire[plane] - 1;
     // window in the time coordinate
-    float minTick = timeWindow[0] / tcc.unitsPerTick;
-    float maxTick = timeWindow[1] / tcc.unitsPerTick;
+    float minTick = timeWindow[0] / tcx.tcc.unitsPerTick;
+    float maxTick = timeWindow[1] / tcx.tcc.unitsPerTick;
     for (int wire = loWire; wire <= hiWire; ++wire) {
       // Set hitsNear if the wire is dead
-      if (!evt.goodWire[plane][wire]) hitsNear = true;
+      if (!tcx.evt.goodWire[plane][wire]) hitsNear = true;
       if (slc.wireHitRange[plane][wire].first == UINT_MAX) continue;
       unsigned int firstHit = slc.wireHitRange[plane][wire].first;
       unsigned int lastHit = slc.wireHitRange[plane][wire].second;
       for (unsigned int iht = firstHit; iht <= lastHit; ++iht) {
-        auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+        auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
         if (usePeakTime) {
           if (hit.PeakTime() < minTick) continue;
           if (hit.PeakTime() > maxTick) break;
@@ -2902,7 +2925,11 @@ namespace tca {
 
   //////////////////////////////////////////
   bool
-  FindCloseHits(TCSlice& slc, TrajPoint& tp, float const& maxDelta, HitStatus_t hitRequest)
+  FindCloseHits(TCContext& tcx,
+                TCSlice& slc,
+                TrajPoint& tp,
+                float const& maxDelta,
+                HitStatus_t hitRequest)
   {
     // Fills tp.Hits sets tp.UseHit true for hits that are close to tp.Pos. Returns true if there are
     // close hits OR if the wire at this position is dead
@@ -2919,7 +2946,7 @@ namespace tca {
     if (wire > slc.lastWire[plane] - 1) return false;
 
     // dead wire
-    if (!evt.goodWire[plane][wire]) {
+    if (!tcx.evt.goodWire[plane][wire]) {
       tp.Environment[kEnvNotGoodWire] = true;
       return true;
     }
@@ -2937,9 +2964,9 @@ namespace tca {
       if (hitRequest == kUsedHits && slc.slHits[iht].InTraj > 0) useit = true;
       if (hitRequest == kUnusedHits && slc.slHits[iht].InTraj == 0) useit = true;
       if (!useit) continue;
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
-      float ftime = tcc.unitsPerTick * hit.PeakTime();
-      float delta = PointTrajDOCA(slc, fwire, ftime, tp);
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
+      float ftime = tcx.tcc.unitsPerTick * hit.PeakTime();
+      float delta = PointTrajDOCA(tcx, slc, fwire, ftime, tp);
       if (delta < maxDelta) tp.Hits.push_back(iht);
     } // iht
     if (tp.Hits.size() > 16) { tp.Hits.resize(16); }
@@ -2972,7 +2999,7 @@ namespace tca {
 
   //////////////////////////////////////////
   std::vector<int>
-  FindCloseTjs(const TCSlice& slc,
+  FindCloseTjs(TCContext& tcx, const TCSlice& slc,
                const TrajPoint& fromTp,
                const TrajPoint& toTp,
                const float& maxDelta)
@@ -3000,12 +3027,12 @@ namespace tca {
     // Make the tp so that stepping is positive
     unsigned int firstWire, lastWire;
     if (toTp.Pos[0] > fromTp.Pos[0]) {
-      if (!MakeBareTrajPoint(slc, fromTp, toTp, tp)) return tmp;
+      if (!MakeBareTrajPoint(tcx, slc, fromTp, toTp, tp)) return tmp;
       firstWire = std::nearbyint(fromTp.Pos[0]);
       lastWire = std::nearbyint(toTp.Pos[0]);
     }
     else if (toTp.Pos[0] < fromTp.Pos[0]) {
-      if (!MakeBareTrajPoint(slc, toTp, fromTp, tp)) return tmp;
+      if (!MakeBareTrajPoint(tcx, slc, toTp, fromTp, tp)) return tmp;
       firstWire = std::nearbyint(toTp.Pos[0]);
       lastWire = std::nearbyint(fromTp.Pos[0]);
     }
@@ -3029,14 +3056,14 @@ namespace tca {
       if (slc.wireHitRange[plane][wire].first == UINT_MAX) continue;
       MoveTPToWire(tp, (float)wire);
       // Find the tick range at this position
-      float minTick = (tp.Pos[1] - maxDelta) / tcc.unitsPerTick;
-      float maxTick = (tp.Pos[1] + maxDelta) / tcc.unitsPerTick;
+      float minTick = (tp.Pos[1] - maxDelta) / tcx.tcc.unitsPerTick;
+      float maxTick = (tp.Pos[1] + maxDelta) / tcx.tcc.unitsPerTick;
       unsigned int firstHit = slc.wireHitRange[plane][wire].first;
       unsigned int lastHit = slc.wireHitRange[plane][wire].second;
       for (unsigned int iht = firstHit; iht <= lastHit; ++iht) {
         if (slc.slHits[iht].InTraj <= 0) continue;
         if ((unsigned int)slc.slHits[iht].InTraj > slc.tjs.size()) continue;
-        auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+        auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
         if (hit.PeakTime() < minTick) continue;
         // Hits are sorted by increasing time so we can break when maxTick is reached
         if (hit.PeakTime() > maxTick) break;
@@ -3051,7 +3078,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   float
-  KinkSignificance(TCSlice& slc,
+  KinkSignificance(TCContext& tcx, TCSlice& slc,
                    Trajectory& tj1,
                    unsigned short end1,
                    Trajectory& tj2,
@@ -3102,12 +3129,12 @@ namespace tca {
     } // ipt
     tj.EndPt[0] = 0;
     tj.EndPt[1] = tj.Pts.size() - 1;
-    return KinkSignificance(slc, tj, nPtsFit, nPtsFit, useChg, prt);
+    return KinkSignificance(tcx, slc, tj, nPtsFit, nPtsFit, useChg, prt);
   } // KinkSignificance
 
   ////////////////////////////////////////////////
   float
-  KinkSignificance(TCSlice& slc,
+  KinkSignificance(TCContext& tcx, TCSlice& slc,
                    Trajectory& tj,
                    unsigned short kinkPt,
                    unsigned short nPtsFit,
@@ -3124,7 +3151,7 @@ namespace tca {
 
     // This function requires knowledge of the DOF of the line fit
     if (nPtsFit < 3) return -1;
-    unsigned short npwc = NumPtsWithCharge(slc, tj, false);
+    unsigned short npwc = NumPtsWithCharge(tcx, slc, tj, false);
     // need enough points to do a fit on each sideof the presumed kink point
     if (npwc < 2 * nPtsFit + 1) return -1;
 
@@ -3141,12 +3168,12 @@ namespace tca {
     // Fit the trajectory direction on the + side
     short fitDir = 1;
     TrajPoint tpPos;
-    FitTraj(slc, tj, kinkPt, nPtsFit, fitDir, tpPos);
+    FitTraj(tcx, slc, tj, kinkPt, nPtsFit, fitDir, tpPos);
     if (tpPos.FitChi > 900) return -1;
     // repeat the trajectory fit on the - side
     fitDir = -1;
     TrajPoint tpNeg;
-    FitTraj(slc, tj, kinkPt, nPtsFit, fitDir, tpNeg);
+    FitTraj(tcx, slc, tj, kinkPt, nPtsFit, fitDir, tpNeg);
     if (tpNeg.FitChi > 900) return -1;
     double angErr = tpNeg.AngErr;
     if (tpPos.AngErr > angErr) angErr = tpPos.AngErr;
@@ -3197,7 +3224,7 @@ namespace tca {
 
     if (prt) {
       mf::LogVerbatim myprt("TC");
-      myprt << "KL: T" << tj.ID << " kinkPt " << PrintPos(slc, tj.Pts[kinkPt]);
+      myprt << "KL: T" << tj.ID << " kinkPt " << PrintPos(tcx, slc, tj.Pts[kinkPt]);
       myprt << " nPtsFit " << nPtsFit;
       myprt << " dang " << std::fixed << std::setprecision(3) << dang;
       myprt << std::fixed << std::setprecision(3) << " angErr " << angErr;
@@ -3211,17 +3238,17 @@ namespace tca {
 
   ////////////////////////////////////////////////
   float
-  ElectronLikelihood(const TCSlice& slc, const Trajectory& tj)
+  ElectronLikelihood(TCContext& tcx, const TCSlice& slc, const Trajectory& tj)
   {
     // returns a number between 0 (not electron-like) and 1 (electron-like)
-    if (NumPtsWithCharge(slc, tj, false) < 8) return -1;
+    if (NumPtsWithCharge(tcx, slc, tj, false) < 8) return -1;
     if (tj.EndFlag[0][kBragg] || tj.EndFlag[1][kBragg]) return 0;
 
     unsigned short midPt = 0.5 * (tj.EndPt[0] + tj.EndPt[1]);
     double rms0 = 0, rms1 = 0;
     unsigned short cnt;
-    TjDeltaRMS(slc, tj, tj.EndPt[0], midPt, rms0, cnt);
-    TjDeltaRMS(slc, tj, midPt, tj.EndPt[1], rms1, cnt);
+    TjDeltaRMS(tcx, slc, tj, tj.EndPt[0], midPt, rms0, cnt);
+    TjDeltaRMS(tcx, slc, tj, midPt, tj.EndPt[1], rms1, cnt);
     float asym = std::abs(rms0 - rms1) / (rms0 + rms1);
     float chgFact = (tj.ChgRMS - 0.1) * 5;
     float elh = 5 * asym * chgFact;
@@ -3231,7 +3258,10 @@ namespace tca {
 
   ////////////////////////////////////////////////
   float
-  ChgFracNearPos(const TCSlice& slc, const Point2_t& pos, const std::vector<int>& tjIDs)
+  ChgFracNearPos(TCContext& tcx,
+                 const TCSlice& slc,
+                 const Point2_t& pos,
+                 const std::vector<int>& tjIDs)
   {
     // returns the fraction of the charge in the region around pos that is associated with
     // the list of Tj IDs
@@ -3252,14 +3282,14 @@ namespace tca {
     // get a list of all hits in this region
     bool hitsNear;
     std::vector<unsigned int> closeHits =
-      FindCloseHits(slc, wireWindow, timeWindow, planeID.Plane, kAllHits, true, hitsNear);
+      FindCloseHits(tcx, slc, wireWindow, timeWindow, planeID.Plane, kAllHits, true, hitsNear);
     if (closeHits.empty()) return 0;
     float chg = 0;
     float tchg = 0;
     // Add the hit charge in the box
     // All hits in the box, and all hits associated with the Tjs
     for (auto& iht : closeHits) {
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       chg += hit.Integral();
       if (slc.slHits[iht].InTraj == 0) continue;
       if (std::find(tjIDs.begin(), tjIDs.end(), slc.slHits[iht].InTraj) != tjIDs.end())
@@ -3271,7 +3301,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   float
-  MaxHitDelta(TCSlice& slc, Trajectory& tj)
+  MaxHitDelta(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     float delta, md = 0;
     unsigned short ii;
@@ -3280,7 +3310,7 @@ namespace tca {
       for (ii = 0; ii < tp.Hits.size(); ++ii) {
         if (!tp.UseHit[ii]) continue;
         iht = tp.Hits[ii];
-        delta = PointTrajDOCA(slc, iht, tp);
+        delta = PointTrajDOCA(tcx, slc, iht, tp);
         if (delta > md) md = delta;
       } // ii
     }   // pts
@@ -3463,7 +3493,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   short
-  MCSMom(const TCSlice& slc, const std::vector<int>& tjIDs)
+  MCSMom(TCContext& tcx, const TCSlice& slc, const std::vector<int>& tjIDs)
   {
     // Find the average MCSMom of the trajectories
     if (tjIDs.empty()) return 0;
@@ -3480,14 +3510,18 @@ namespace tca {
 
   ////////////////////////////////////////////////
   short
-  MCSMom(const TCSlice& slc, const Trajectory& tj)
+  MCSMom(TCContext& tcx, const TCSlice& slc, const Trajectory& tj)
   {
-    return MCSMom(slc, tj, tj.EndPt[0], tj.EndPt[1]);
+    return MCSMom(tcx, slc, tj, tj.EndPt[0], tj.EndPt[1]);
   } // MCSMom
 
   ////////////////////////////////////////////////
   short
-  MCSMom(const TCSlice& slc, const Trajectory& tj, unsigned short firstPt, unsigned short lastPt)
+  MCSMom(TCContext& tcx,
+         const TCSlice& slc,
+         const Trajectory& tj,
+         unsigned short firstPt,
+         unsigned short lastPt)
   {
     // Estimate the trajectory momentum using Multiple Coulomb Scattering ala PDG RPP
 
@@ -3501,14 +3535,14 @@ namespace tca {
     if (firstPt < tj.EndPt[0]) return 0;
     if (lastPt > tj.EndPt[1]) return 0;
     // Can't do this with only 2 points
-    if (NumPtsWithCharge(slc, tj, false, firstPt, lastPt) < 3) return 0;
+    if (NumPtsWithCharge(tcx, slc, tj, false, firstPt, lastPt) < 3) return 0;
     // Ignore junk Tjs
     if (tj.AlgMod[kJunkTj]) return 0;
 
     double tjLen = TrajPointSeparation(tj.Pts[firstPt], tj.Pts[lastPt]);
     if (tjLen < 1) return 0;
     // mom calculated in MeV
-    double thetaRMS = MCSThetaRMS(slc, tj, firstPt, lastPt);
+    double thetaRMS = MCSThetaRMS(tcx, slc, tj, firstPt, lastPt);
     if (thetaRMS < 0.001) return 999;
     double mom = 13.8 * sqrt(tjLen / 14) / thetaRMS;
     if (mom > 999) mom = 999;
@@ -3536,7 +3570,7 @@ namespace tca {
 
   /////////////////////////////////////////
   float
-  MCSThetaRMS(const TCSlice& slc, const Trajectory& tj)
+  MCSThetaRMS(TCContext& tcx, const TCSlice& slc, const Trajectory& tj)
   {
     // This returns the MCS scattering angle expected for one WSE unit of travel along the trajectory.
     // It is used to define kink and vertex cuts. This should probably be named something different to
@@ -3545,13 +3579,13 @@ namespace tca {
     float tps = TrajPointSeparation(tj.Pts[tj.EndPt[0]], tj.Pts[tj.EndPt[1]]);
     if (tps < 1) return 1;
 
-    return MCSThetaRMS(slc, tj, tj.EndPt[0], tj.EndPt[1]) / sqrt(tps);
+    return MCSThetaRMS(tcx, slc, tj, tj.EndPt[0], tj.EndPt[1]) / sqrt(tps);
 
   } // MCSThetaRMS
 
   /////////////////////////////////////////
   double
-  MCSThetaRMS(const TCSlice& slc,
+  MCSThetaRMS(TCContext& tcx, const TCSlice& slc,
               const Trajectory& tj,
               unsigned short firstPt,
               unsigned short lastPt)
@@ -3568,7 +3602,7 @@ namespace tca {
 
     double sigmaS;
     unsigned short cnt;
-    TjDeltaRMS(slc, tj, firstPt, lastPt, sigmaS, cnt);
+    TjDeltaRMS(tcx, slc, tj, firstPt, lastPt, sigmaS, cnt);
     if (sigmaS < 0) return 1;
     double tjLen = TrajPointSeparation(tj.Pts[firstPt], tj.Pts[lastPt]);
     if (tjLen < 1) return 1;
@@ -3579,7 +3613,7 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  TjDeltaRMS(const TCSlice& slc,
+  TjDeltaRMS(TCContext& tcx, const TCSlice& slc,
              const Trajectory& tj,
              unsigned short firstPt,
              unsigned short lastPt,
@@ -3603,7 +3637,7 @@ namespace tca {
     firstTP.Pos = firstTP.HitPos;
     TrajPoint lastTP = tj.Pts[lastPt];
     lastTP.Pos = lastTP.HitPos;
-    if (!MakeBareTrajPoint(slc, firstTP, lastTP, tmp)) return;
+    if (!MakeBareTrajPoint(tcx, slc, firstTP, lastTP, tmp)) return;
     // sum up the deviations^2
     double dsum = 0;
     cnt = 0;
@@ -3621,7 +3655,7 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  SetTPEnvironment(TCSlice& slc, CTP_t inCTP)
+  SetTPEnvironment(TCContext& tcx, TCSlice& slc, CTP_t inCTP)
   {
     // This function is called after tj reconstruction is completed to set TP Environment
     // bits that are dependent on reconstruction, just kEnvNearMuon for now. This bit is
@@ -3647,7 +3681,7 @@ namespace tca {
         // get a list of all hits in this region
         bool hitsNear;
         auto closeHits =
-          FindCloseHits(slc, wireWindow, timeWindow, plane, kAllHits, true, hitsNear);
+          FindCloseHits(tcx, slc, wireWindow, timeWindow, plane, kAllHits, true, hitsNear);
         if (closeHits.empty()) continue;
         for (auto iht : closeHits) {
           auto inTraj = slc.slHits[iht].InTraj;
@@ -3668,7 +3702,11 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  UpdateTjChgProperties(std::string inFcnLabel, TCSlice& slc, Trajectory& tj, bool prt)
+  UpdateTjChgProperties(std::string inFcnLabel,
+                        TCContext& tcx,
+                        TCSlice& slc,
+                        Trajectory& tj,
+                        bool prt)
   {
     // Updates properties of the tj that are affected when the TP environment
     // is changed. The most likely reason for a change is when the tj is attached to a
@@ -3736,7 +3774,7 @@ namespace tca {
       for (unsigned short ii = 0; ii < tj.Pts[ipt].Hits.size(); ++ii) {
         if (!tp.UseHit[ii]) continue;
         unsigned int iht = tp.Hits[ii];
-        tpchg += (*evt.allHits)[slc.slHits[iht].allHitsIndex].Integral();
+        tpchg += (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex].Integral();
       } // ii
       vsum += tpchg;
       vsum2 += tpchg * tpchg;
@@ -3809,7 +3847,7 @@ namespace tca {
 
     // update the local charge average using NPtsAve of the preceding points.
     // Handle short Tjs first.
-    if (vcnt < tcc.nPtsAve) {
+    if (vcnt < tcx.tcc.nPtsAve) {
       for (auto& tp : tj.Pts)
         tp.AveChg = tj.AveChg;
       return;
@@ -3819,7 +3857,7 @@ namespace tca {
     for (auto& tp : tj.Pts)
       tp.AveChg = 0;
     // Enter the local average on the points where an average can be calculated
-    unsigned short nptsave = tcc.nPtsAve;
+    unsigned short nptsave = tcx.tcc.nPtsAve;
     unsigned short minPt = tj.EndPt[0] + nptsave;
     float lastAve = 0;
     for (unsigned short ii = 0; ii < tj.Pts.size(); ++ii) {
@@ -3857,7 +3895,7 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  UpdateVxEnvironment(TCSlice& slc)
+  UpdateVxEnvironment(TCContext& tcx, TCSlice& slc)
   {
     // Set the kEnvOverlap bit true for all TPs that are close to other
     // trajectories that are close to vertices. The positions of TPs that
@@ -3873,14 +3911,14 @@ namespace tca {
 
     for (auto& vx : slc.vtxs) {
       if (vx.ID <= 0) continue;
-      UpdateVxEnvironment(slc, vx, false);
+      UpdateVxEnvironment(tcx, slc, vx, false);
     } // vx
 
   } // UpdateVxEnvironment
 
   /////////////////////////////////////////
   void
-  UpdateVxEnvironment(TCSlice& slc, VtxStore& vx2, bool prt)
+  UpdateVxEnvironment(TCContext& tcx, TCSlice& slc, VtxStore& vx2, bool prt)
   {
     // Update the Environment each TP on trajectories near the vertex
 
@@ -3951,7 +3989,7 @@ namespace tca {
       // next make TPs on the wires that don't have real TPs
       TrajPoint ltp;
       // put ltp at the vertex position with direction towards the end point
-      MakeBareTrajPoint(vx2.Pos, tj.Pts[tj.EndPt[end]].Pos, ltp);
+      MakeBareTrajPoint(tcx, vx2.Pos, tj.Pts[tj.EndPt[end]].Pos, ltp);
       if (ltp.Dir[0] == 0) continue;
       if (ltp.Pos[0] < -0.4) continue;
       unsigned int wire = std::nearbyint(ltp.Pos[0]);
@@ -3975,7 +4013,7 @@ namespace tca {
         mf::LogVerbatim myprt("TC");
         myprt << " T" << tj.ID;
         for (auto& tp : tjpt)
-          myprt << " " << PrintPos(slc, tp.Pos) << "_" << tp.Step << "_" << (int)tp.Chg;
+          myprt << " " << PrintPos(tcx, slc, tp.Pos) << "_" << tp.Step << "_" << (int)tp.Chg;
       }
       wire_tjpt.push_back(tjpt);
       tjids.push_back(tj.ID);
@@ -4015,7 +4053,7 @@ namespace tca {
       auto& tj = slc.tjs[tjid - 1];
       if (!tj.NeedsUpdate) continue;
       if (tj.CTP != vx2.CTP) continue;
-      UpdateTjChgProperties("UVxE", slc, tj, prt);
+      UpdateTjChgProperties("UVxE", tcx, slc, tj, prt);
     } // tjid
 
   } // UpdateVxEnvironment
@@ -4023,6 +4061,7 @@ namespace tca {
   /////////////////////////////////////////
   TrajPoint
   MakeBareTP(detinfo::DetectorPropertiesData const& detProp,
+             TCContext& tcx,
              const TCSlice& slc,
              const Point3_t& pos,
              CTP_t inCTP)
@@ -4034,14 +4073,15 @@ namespace tca {
     tp.CTP = inCTP;
     geo::PlaneID planeID = DecodeCTP(inCTP);
 
-    tp.Pos[0] = tcc.geom->WireCoordinate(pos[1], pos[2], planeID);
-    tp.Pos[1] = detProp.ConvertXToTicks(pos[0], planeID) * tcc.unitsPerTick;
+    tp.Pos[0] = tcx.tcc.geom->WireCoordinate(pos[1], pos[2], planeID);
+    tp.Pos[1] = detProp.ConvertXToTicks(pos[0], planeID) * tcx.tcc.unitsPerTick;
     return tp;
   } // MakeBareTP
 
   /////////////////////////////////////////
   TrajPoint
   MakeBareTP(detinfo::DetectorPropertiesData const& detProp,
+             TCContext& tcx,
              const TCSlice& slc,
              const Point3_t& pos,
              const Vector3_t& dir,
@@ -4058,8 +4098,8 @@ namespace tca {
     tp.CTP = inCTP;
     geo::PlaneID planeID = DecodeCTP(inCTP);
 
-    tp.Pos[0] = tcc.geom->WireCoordinate(pos[1], pos[2], planeID);
-    tp.Pos[1] = detProp.ConvertXToTicks(pos[0], planeID) * tcc.unitsPerTick;
+    tp.Pos[0] = tcx.tcc.geom->WireCoordinate(pos[1], pos[2], planeID);
+    tp.Pos[1] = detProp.ConvertXToTicks(pos[0], planeID) * tcx.tcc.unitsPerTick;
 
     // now find the direction if dir is defined
     if (dir[0] == 0 && dir[1] == 0 && dir[2] == 0) return tp;
@@ -4072,11 +4112,11 @@ namespace tca {
     std::array<double, 2> pos2;
     std::array<double, 2> dir2;
     // the wire coordinates
-    ori2[0] = tcc.geom->WireCoordinate(ori3[1], ori3[2], planeID);
-    pos2[0] = tcc.geom->WireCoordinate(pos3[1], pos3[2], planeID);
+    ori2[0] = tcx.tcc.geom->WireCoordinate(ori3[1], ori3[2], planeID);
+    pos2[0] = tcx.tcc.geom->WireCoordinate(pos3[1], pos3[2], planeID);
     // the time coordinates
-    ori2[1] = detProp.ConvertXToTicks(ori3[0], planeID) * tcc.unitsPerTick;
-    pos2[1] = detProp.ConvertXToTicks(pos3[0], planeID) * tcc.unitsPerTick;
+    ori2[1] = detProp.ConvertXToTicks(ori3[0], planeID) * tcx.tcc.unitsPerTick;
+    pos2[1] = detProp.ConvertXToTicks(pos3[0], planeID) * tcx.tcc.unitsPerTick;
 
     dir2[0] = pos2[0] - ori2[0];
     dir2[1] = pos2[1] - ori2[1];
@@ -4088,11 +4128,11 @@ namespace tca {
     tp.Delta = norm / 100;
 
     // The Orth vectors are not unit normalized so we need to correct for this
-    double w0 = tcc.geom->WireCoordinate(0, 0, planeID);
+    double w0 = tcx.tcc.geom->WireCoordinate(0, 0, planeID);
     // cosine-like component
-    double cs = tcc.geom->WireCoordinate(1, 0, planeID) - w0;
+    double cs = tcx.tcc.geom->WireCoordinate(1, 0, planeID) - w0;
     // sine-like component
-    double sn = tcc.geom->WireCoordinate(0, 1, planeID) - w0;
+    double sn = tcx.tcc.geom->WireCoordinate(0, 1, planeID) - w0;
     norm = sqrt(cs * cs + sn * sn);
     tp.Delta /= norm;
 
@@ -4105,14 +4145,18 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  MakeBareTrajPoint(const TCSlice& slc, unsigned int fromHit, unsigned int toHit, TrajPoint& tp)
+  MakeBareTrajPoint(TCContext& tcx,
+                    const TCSlice& slc,
+                    unsigned int fromHit,
+                    unsigned int toHit,
+                    TrajPoint& tp)
   {
     if (fromHit > slc.slHits.size() - 1) return false;
     if (toHit > slc.slHits.size() - 1) return false;
-    auto& fhit = (*evt.allHits)[slc.slHits[fromHit].allHitsIndex];
-    auto& thit = (*evt.allHits)[slc.slHits[toHit].allHitsIndex];
+    auto& fhit = (*tcx.evt.allHits)[slc.slHits[fromHit].allHitsIndex];
+    auto& thit = (*tcx.evt.allHits)[slc.slHits[toHit].allHitsIndex];
     CTP_t tCTP = EncodeCTP(fhit.WireID());
-    return MakeBareTrajPoint(slc,
+    return MakeBareTrajPoint(tcx, slc,
                              (float)fhit.WireID().Wire,
                              fhit.PeakTime(),
                              (float)thit.WireID().Wire,
@@ -4124,7 +4168,7 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  MakeBareTrajPoint(const TCSlice& slc,
+  MakeBareTrajPoint(TCContext& tcx, const TCSlice& slc,
                     float fromWire,
                     float fromTick,
                     float toWire,
@@ -4134,9 +4178,9 @@ namespace tca {
   {
     tp.CTP = tCTP;
     tp.Pos[0] = fromWire;
-    tp.Pos[1] = tcc.unitsPerTick * fromTick;
+    tp.Pos[1] = tcx.tcc.unitsPerTick * fromTick;
     tp.Dir[0] = toWire - fromWire;
-    tp.Dir[1] = tcc.unitsPerTick * (toTick - fromTick);
+    tp.Dir[1] = tcx.tcc.unitsPerTick * (toTick - fromTick);
     double norm = sqrt(tp.Dir[0] * tp.Dir[0] + tp.Dir[1] * tp.Dir[1]);
     if (norm == 0) return false;
     tp.Dir[0] /= norm;
@@ -4147,7 +4191,10 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  MakeBareTrajPoint(const Point2_t& fromPos, const Point2_t& toPos, TrajPoint& tpOut)
+  MakeBareTrajPoint(TCContext& tcx,
+                    const Point2_t& fromPos,
+                    const Point2_t& toPos,
+                    TrajPoint& tpOut)
   {
     tpOut.Pos = fromPos;
     tpOut.Dir = PointDirection(fromPos, toPos);
@@ -4158,7 +4205,7 @@ namespace tca {
 
   /////////////////////////////////////////
   bool
-  MakeBareTrajPoint(const TCSlice& slc,
+  MakeBareTrajPoint(TCContext& tcx, const TCSlice& slc,
                     const TrajPoint& tpIn1,
                     const TrajPoint& tpIn2,
                     TrajPoint& tpOut)
@@ -4197,14 +4244,14 @@ namespace tca {
 
   ////////////////////////////////////////////////
   float
-  TPHitsRMSTime(const TCSlice& slc, const TrajPoint& tp, HitStatus_t hitRequest)
+  TPHitsRMSTime(TCContext& tcx, const TCSlice& slc, const TrajPoint& tp, HitStatus_t hitRequest)
   {
-    return tcc.unitsPerTick * TPHitsRMSTick(slc, tp, hitRequest);
+    return tcx.tcc.unitsPerTick * TPHitsRMSTick(tcx, slc, tp, hitRequest);
   } // TPHitsRMSTime
 
   ////////////////////////////////////////////////
   float
-  TPHitsRMSTick(const TCSlice& slc, const TrajPoint& tp, HitStatus_t hitRequest)
+  TPHitsRMSTick(TCContext& tcx, const TCSlice& slc, const TrajPoint& tp, HitStatus_t hitRequest)
   {
     // Estimate the RMS of all hits associated with a trajectory point
     // without a lot of calculation. Note that this returns a value that is
@@ -4218,7 +4265,7 @@ namespace tca {
       if (hitRequest == kUnusedHits && !tp.UseHit[ii]) useit = true;
       if (!useit) continue;
       unsigned int iht = tp.Hits[ii];
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       float cv = hit.PeakTime();
       float rms = hit.RMS();
       float arg = cv - rms;
@@ -4232,23 +4279,23 @@ namespace tca {
 
   ////////////////////////////////////////////////
   float
-  HitsRMSTime(const TCSlice& slc,
+  HitsRMSTime(TCContext& tcx, const TCSlice& slc,
               const std::vector<unsigned int>& hitsInMultiplet,
               HitStatus_t hitRequest)
   {
-    return tcc.unitsPerTick * HitsRMSTick(slc, hitsInMultiplet, hitRequest);
+    return tcx.tcc.unitsPerTick * HitsRMSTick(tcx, slc, hitsInMultiplet, hitRequest);
   } // HitsRMSTick
 
   ////////////////////////////////////////////////
   float
-  HitsRMSTick(const TCSlice& slc,
+  HitsRMSTick(TCContext& tcx, const TCSlice& slc,
               const std::vector<unsigned int>& hitsInMultiplet,
               HitStatus_t hitRequest)
   {
     if (hitsInMultiplet.empty()) return 0;
 
     if (hitsInMultiplet.size() == 1) {
-      auto& hit = (*evt.allHits)[slc.slHits[hitsInMultiplet[0]].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[hitsInMultiplet[0]].allHitsIndex];
       return hit.RMS();
     }
 
@@ -4260,7 +4307,7 @@ namespace tca {
       if (hitRequest == kUsedHits && slc.slHits[iht].InTraj > 0) useit = true;
       if (hitRequest == kUnusedHits && slc.slHits[iht].InTraj == 0) useit = true;
       if (!useit) continue;
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       float cv = hit.PeakTime();
       float rms = hit.RMS();
       float arg = cv - rms;
@@ -4274,17 +4321,17 @@ namespace tca {
 
   ////////////////////////////////////////////////
   float
-  HitsPosTime(const TCSlice& slc,
+  HitsPosTime(TCContext& tcx, const TCSlice& slc,
               const std::vector<unsigned int>& hitsInMultiplet,
               float& sum,
               HitStatus_t hitRequest)
   {
-    return tcc.unitsPerTick * HitsPosTick(slc, hitsInMultiplet, sum, hitRequest);
+    return tcx.tcc.unitsPerTick * HitsPosTick(tcx, slc, hitsInMultiplet, sum, hitRequest);
   } // HitsPosTime
 
   ////////////////////////////////////////////////
   float
-  HitsPosTick(const TCSlice& slc,
+  HitsPosTick(TCContext& tcx, const TCSlice& slc,
               const std::vector<unsigned int>& hitsInMultiplet,
               float& sum,
               HitStatus_t hitRequest)
@@ -4298,7 +4345,7 @@ namespace tca {
       if (hitRequest == kUsedHits && slc.slHits[iht].InTraj > 0) useit = true;
       if (hitRequest == kUnusedHits && slc.slHits[iht].InTraj == 0) useit = true;
       if (!useit) continue;
-      auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
       float chg = hit.Integral();
       pos += chg * hit.PeakTime();
       sum += chg;
@@ -4345,26 +4392,26 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  SetPDGCode(TCSlice& slc, unsigned short itj)
+  SetPDGCode(TCContext& tcx, TCSlice& slc, unsigned short itj)
   {
     if (itj > slc.tjs.size() - 1) return;
-    SetPDGCode(slc, slc.tjs[itj]);
+    SetPDGCode(tcx, slc, slc.tjs[itj]);
   }
 
   ////////////////////////////////////////////////
   void
-  SetPDGCode(TCSlice& slc, Trajectory& tj)
+  SetPDGCode(TCContext& tcx, TCSlice& slc, Trajectory& tj)
   {
     // Sets the PDG code for the supplied trajectory. Note that the existing
     // PDG code is left unchanged if these cuts are not met
 
-    short npwc = NumPtsWithCharge(slc, tj, false);
+    short npwc = NumPtsWithCharge(tcx, slc, tj, false);
     if (npwc < 6) {
       tj.PDGCode = 0;
       return;
     }
 
-    if (tj.Strategy[kStiffEl] && ElectronLikelihood(slc, tj) > tcc.showerTag[6]) {
+    if (tj.Strategy[kStiffEl] && ElectronLikelihood(tcx, slc, tj) > tcx.tcc.showerTag[6]) {
       tj.PDGCode = 111;
       return;
     }
@@ -4373,14 +4420,14 @@ namespace tca {
       return;
     }
 
-    if (tcc.showerTag[6] > 0 && ElectronLikelihood(slc, tj) > tcc.showerTag[6]) {
+    if (tcx.tcc.showerTag[6] > 0 && ElectronLikelihood(tcx, slc, tj) > tcx.tcc.showerTag[6]) {
       tj.PDGCode = 11;
       return;
     }
 
-    if (tcc.muonTag[0] <= 0) return;
+    if (tcx.tcc.muonTag[0] <= 0) return;
     // Special handling of very long straight trajectories, e.g. uB cosmic rays
-    bool isAMuon = (npwc > (unsigned short)tcc.muonTag[0] && tj.MCSMom > tcc.muonTag[1]);
+    bool isAMuon = (npwc > (unsigned short)tcx.tcc.muonTag[0] && tj.MCSMom > tcx.tcc.muonTag[1]);
     // anything really really long must be a muon
     if (npwc > 500) isAMuon = true;
     if (isAMuon) tj.PDGCode = 13;
@@ -4389,23 +4436,23 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  AnalyzeHits()
+  AnalyzeHits(TCContext& tcx)
   {
     // Find the average hit rms by analyzing the full hit collection. This
     // only needs to be done once per job.
 
-    if ((*evt.allHits).empty()) return true;
+    if ((*tcx.evt.allHits).empty()) return true;
     // no sense re-calculating it if it's been done
-    if (evt.aveHitRMSValid) return true;
+    if (tcx.evt.aveHitRMSValid) return true;
 
-    unsigned short cstat = (*evt.allHits)[0].WireID().Cryostat;
-    unsigned short tpc = (*evt.allHits)[0].WireID().TPC;
+    unsigned short cstat = (*tcx.evt.allHits)[0].WireID().Cryostat;
+    unsigned short tpc = (*tcx.evt.allHits)[0].WireID().TPC;
 
-    unsigned short nplanes = tcc.geom->Nplanes(tpc, cstat);
-    evt.aveHitRMS.resize(nplanes);
+    unsigned short nplanes = tcx.tcc.geom->Nplanes(tpc, cstat);
+    tcx.evt.aveHitRMS.resize(nplanes);
     std::vector<float> cnt(nplanes, 0);
-    for (unsigned short iht = 0; iht < (*evt.allHits).size(); ++iht) {
-      auto& hit = (*evt.allHits)[iht];
+    for (unsigned short iht = 0; iht < (*tcx.evt.allHits).size(); ++iht) {
+      auto& hit = (*tcx.evt.allHits)[iht];
       unsigned short plane = hit.WireID().Plane;
       if (plane > nplanes - 1) return false;
       if (cnt[plane] > 200) continue;
@@ -4415,7 +4462,7 @@ namespace tca {
       if (hit.GoodnessOfFit() < 0 || hit.GoodnessOfFit() > 500) continue;
       // don't let a lot of runt hits screw up the calculation
       if (hit.PeakAmplitude() < 1) continue;
-      evt.aveHitRMS[plane] += hit.RMS();
+      tcx.evt.aveHitRMS[plane] += hit.RMS();
       ++cnt[plane];
       // quit if enough hits are found
       bool allDone = true;
@@ -4425,21 +4472,21 @@ namespace tca {
     } // iht
 
     // assume there are enough hits in each plane
-    evt.aveHitRMSValid = true;
+    tcx.evt.aveHitRMSValid = true;
     for (unsigned short plane = 0; plane < nplanes; ++plane) {
-      if (cnt[plane] > 4) { evt.aveHitRMS[plane] /= cnt[plane]; }
+      if (cnt[plane] > 4) { tcx.evt.aveHitRMS[plane] /= cnt[plane]; }
       else {
-        evt.aveHitRMS[plane] = 10;
-        evt.aveHitRMSValid = false;
+        tcx.evt.aveHitRMS[plane] = 10;
+        tcx.evt.aveHitRMSValid = false;
       } // cnt too low
     }   // plane
 
-    if (tcc.modes[kDebug]) {
+    if (tcx.tcc.modes[kDebug]) {
       std::cout << "Analyze hits aveHitRMS";
       std::cout << std::fixed << std::setprecision(1);
-      for (auto rms : evt.aveHitRMS)
+      for (auto rms : tcx.evt.aveHitRMS)
         std::cout << " " << rms;
-      std::cout << " aveHitRMSValid? " << evt.aveHitRMSValid << "\n";
+      std::cout << " aveHitRMSValid? " << tcx.evt.aveHitRMSValid << "\n";
     }
 
     return true;
@@ -4456,7 +4503,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  FillWireHitRange(geo::TPCID inTPCID)
+  FillWireHitRange(TCContext& tcx, geo::TPCID inTPCID)
   {
     // Defines the local vector of dead wires and the low-high range of hits in each wire in
     // the TPCID in TCEvent. Note that there is no requirement that the allHits collection is sorted. Care should
@@ -4464,67 +4511,68 @@ namespace tca {
 
     // see if this function was called in the current TPCID. There is nothing that needs to
     // be done if that is the case
-    if (inTPCID == evt.TPCID) return;
+    if (inTPCID == tcx.evt.TPCID) return;
 
-    evt.TPCID = inTPCID;
-    unsigned short nplanes = tcc.geom->Nplanes(inTPCID);
+    tcx.evt.TPCID = inTPCID;
+    unsigned short nplanes = tcx.tcc.geom->Nplanes(inTPCID);
     unsigned int cstat = inTPCID.Cryostat;
     unsigned int tpc = inTPCID.TPC;
-    if (tcc.useChannelStatus) {
+    if (tcx.tcc.useChannelStatus) {
       lariov::ChannelStatusProvider const& channelStatus =
         art::ServiceHandle<lariov::ChannelStatusService>()->GetProvider();
-      evt.goodWire.resize(nplanes);
+      tcx.evt.goodWire.resize(nplanes);
       for (unsigned short pln = 0; pln < nplanes; ++pln) {
-        unsigned int nwires = tcc.geom->Nwires(pln, tpc, cstat);
+        unsigned int nwires = tcx.tcc.geom->Nwires(pln, tpc, cstat);
         // set all wires dead
-        evt.goodWire[pln].resize(nwires, false);
+        tcx.evt.goodWire[pln].resize(nwires, false);
         for (unsigned int wire = 0; wire < nwires; ++wire) {
           raw::ChannelID_t chan =
-            tcc.geom->PlaneWireToChannel((int)pln, (int)wire, (int)tpc, (int)cstat);
-          evt.goodWire[pln][wire] = channelStatus.IsGood(chan);
+            tcx.tcc.geom->PlaneWireToChannel((int)pln, (int)wire, (int)tpc, (int)cstat);
+          tcx.evt.goodWire[pln][wire] = channelStatus.IsGood(chan);
         } // wire
       }   // pln
     }
     else {
       // resize and set every channel good
-      evt.goodWire.resize(nplanes);
+      tcx.evt.goodWire.resize(nplanes);
       for (unsigned short pln = 0; pln < nplanes; ++pln) {
-        unsigned int nwires = tcc.geom->Nwires(pln, tpc, cstat);
-        evt.goodWire[pln].resize(nwires, true);
+        unsigned int nwires = tcx.tcc.geom->Nwires(pln, tpc, cstat);
+        tcx.evt.goodWire[pln].resize(nwires, true);
       } // pln
     }   // don't use channelStatus
 
     // there is no need to define evt.wireHitRange if the hit collection is not sliced. The function
     // SignalAtTP will then use the (smaller) slc.WireHitRange instead of evt.wireHitRange
-    if (!evt.expectSlicedHits) return;
+    if (!tcx.evt.expectSlicedHits) return;
 
     // define the size of evt.wireHitRange
-    evt.wireHitRange.resize(nplanes);
+    tcx.evt.wireHitRange.resize(nplanes);
     for (unsigned short pln = 0; pln < nplanes; ++pln) {
-      unsigned int nwires = tcc.geom->Nwires(pln, tpc, cstat);
-      evt.wireHitRange[pln].resize(nwires);
+      unsigned int nwires = tcx.tcc.geom->Nwires(pln, tpc, cstat);
+      tcx.evt.wireHitRange[pln].resize(nwires);
       for (unsigned int wire = 0; wire < nwires; ++wire)
-        evt.wireHitRange[pln][wire] = {UINT_MAX, UINT_MAX};
+        tcx.evt.wireHitRange[pln][wire] = {UINT_MAX, UINT_MAX};
     } // pln
 
     // next define the wireHitRange values. Make one loop through the allHits collection
     unsigned int nBadWireFix = 0;
-    for (unsigned int iht = 0; iht < (*evt.allHits).size(); ++iht) {
-      auto& hit = (*evt.allHits)[iht];
+    for (unsigned int iht = 0; iht < (*tcx.evt.allHits).size(); ++iht) {
+      auto& hit = (*tcx.evt.allHits)[iht];
       auto wid = hit.WireID();
       if (wid.Cryostat != cstat) continue;
       if (wid.TPC != tpc) continue;
       unsigned short pln = wid.Plane;
       unsigned int wire = wid.Wire;
       // Check the goodWire status and correct it if it's wrong
-      if (!evt.goodWire[pln][wire]) {
-        evt.goodWire[pln][wire] = true;
+      if (!tcx.evt.goodWire[pln][wire]) {
+        tcx.evt.goodWire[pln][wire] = true;
         ++nBadWireFix;
       } // not goodWire
-      if (evt.wireHitRange[pln][wire].first == UINT_MAX) evt.wireHitRange[pln][wire].first = iht;
-      evt.wireHitRange[pln][wire].second = iht;
+      if (tcx.evt.wireHitRange[pln][wire].first == UINT_MAX)
+        tcx.evt.wireHitRange[pln][wire].first = iht;
+      tcx.evt.wireHitRange[pln][wire].second = iht;
     } // iht
-    if (nBadWireFix > 0 && tcc.modes[kDebug]) {
+    if (nBadWireFix > 0 && tcx.tcc.modes[kDebug]) {
       std::cout << "FillWireHitRange found hits on " << nBadWireFix
                 << " wires that were declared not-good by the ChannelStatus service. Fixed it...\n";
     }
@@ -4534,6 +4582,7 @@ namespace tca {
   bool
   FillWireHitRange(detinfo::DetectorClocksData const& clockData,
                    detinfo::DetectorPropertiesData const& detProp,
+                   TCContext& tcx,
                    TCSlice& slc)
   {
     // fills the WireHitRange vector. Slightly modified version of the one in ClusterCrawlerAlg.
@@ -4542,31 +4591,31 @@ namespace tca {
     // determine the number of planes
     unsigned int cstat = slc.TPCID.Cryostat;
     unsigned int tpc = slc.TPCID.TPC;
-    unsigned short nplanes = tcc.geom->Nplanes(tpc, cstat);
+    unsigned short nplanes = tcx.tcc.geom->Nplanes(tpc, cstat);
     slc.nPlanes = nplanes;
     if (nplanes > 3) return false;
 
     // Y,Z limits of the detector
     double local[3] = {0., 0., 0.};
     double world[3] = {0., 0., 0.};
-    const geo::TPCGeo& thetpc = tcc.geom->TPC(tpc, cstat);
+    const geo::TPCGeo& thetpc = tcx.tcc.geom->TPC(tpc, cstat);
     thetpc.LocalToWorld(local, world);
     // reduce the active area of the TPC by 1 cm to prevent wire boundary issues
-    slc.xLo = world[0] - tcc.geom->DetHalfWidth(tpc, cstat) + 1;
-    slc.xHi = world[0] + tcc.geom->DetHalfWidth(tpc, cstat) - 1;
-    slc.yLo = world[1] - tcc.geom->DetHalfHeight(tpc, cstat) + 1;
-    slc.yHi = world[1] + tcc.geom->DetHalfHeight(tpc, cstat) - 1;
-    slc.zLo = world[2] - tcc.geom->DetLength(tpc, cstat) / 2 + 1;
-    slc.zHi = world[2] + tcc.geom->DetLength(tpc, cstat) / 2 - 1;
+    slc.xLo = world[0] - tcx.tcc.geom->DetHalfWidth(tpc, cstat) + 1;
+    slc.xHi = world[0] + tcx.tcc.geom->DetHalfWidth(tpc, cstat) - 1;
+    slc.yLo = world[1] - tcx.tcc.geom->DetHalfHeight(tpc, cstat) + 1;
+    slc.yHi = world[1] + tcx.tcc.geom->DetHalfHeight(tpc, cstat) - 1;
+    slc.zLo = world[2] - tcx.tcc.geom->DetLength(tpc, cstat) / 2 + 1;
+    slc.zHi = world[2] + tcx.tcc.geom->DetLength(tpc, cstat) / 2 - 1;
 
     // initialize everything
     slc.wireHitRange.resize(nplanes);
     slc.firstWire.resize(nplanes);
     slc.lastWire.resize(nplanes);
     slc.nWires.resize(nplanes);
-    tcc.maxPos0.resize(nplanes);
-    tcc.maxPos1.resize(nplanes);
-    evt.aveHitRMS.resize(nplanes, nplanes);
+    tcx.tcc.maxPos0.resize(nplanes);
+    tcx.tcc.maxPos1.resize(nplanes);
+    tcx.evt.aveHitRMS.resize(nplanes, nplanes);
 
     std::pair<unsigned int, unsigned int> flag;
     flag.first = UINT_MAX;
@@ -4578,25 +4627,25 @@ namespace tca {
     // case where the wire spacing is different in each plane. Deal with this later if
     // the approximation used here fails.
 
-    raw::ChannelID_t channel = tcc.geom->PlaneWireToChannel(0, 0, (int)tpc, (int)cstat);
-    tcc.wirePitch = tcc.geom->WirePitch(tcc.geom->View(channel));
+    raw::ChannelID_t channel = tcx.tcc.geom->PlaneWireToChannel(0, 0, (int)tpc, (int)cstat);
+    tcx.tcc.wirePitch = tcx.tcc.geom->WirePitch(tcx.tcc.geom->View(channel));
     float tickToDist = detProp.DriftVelocity(detProp.Efield(), detProp.Temperature());
     tickToDist *= 1.e-3 * sampling_rate(clockData); // 1e-3 is conversion of 1/us to 1/ns
-    tcc.unitsPerTick = tickToDist / tcc.wirePitch;
+    tcx.tcc.unitsPerTick = tickToDist / tcx.tcc.wirePitch;
     for (unsigned short plane = 0; plane < nplanes; ++plane) {
       slc.firstWire[plane] = UINT_MAX;
       slc.lastWire[plane] = 0;
-      slc.nWires[plane] = tcc.geom->Nwires(plane, tpc, cstat);
+      slc.nWires[plane] = tcx.tcc.geom->Nwires(plane, tpc, cstat);
       slc.wireHitRange[plane].resize(slc.nWires[plane], flag);
-      tcc.maxPos0[plane] = (float)slc.nWires[plane] - 0.5;
-      tcc.maxPos1[plane] = (float)detProp.NumberTimeSamples() * tcc.unitsPerTick;
+      tcx.tcc.maxPos0[plane] = (float)slc.nWires[plane] - 0.5;
+      tcx.tcc.maxPos1[plane] = (float)detProp.NumberTimeSamples() * tcx.tcc.unitsPerTick;
     }
 
     unsigned int lastWire = 0, lastPlane = 0;
     for (unsigned int iht = 0; iht < slc.slHits.size(); ++iht) {
       unsigned int ahi = slc.slHits[iht].allHitsIndex;
-      if (ahi > (*evt.allHits).size() - 1) return false;
-      auto& hit = (*evt.allHits)[ahi];
+      if (ahi > (*tcx.evt.allHits).size() - 1) return false;
+      auto& hit = (*tcx.evt.allHits)[ahi];
       if (hit.WireID().Cryostat != cstat) continue;
       if (hit.WireID().TPC != tpc) continue;
       unsigned short plane = hit.WireID().Plane;
@@ -4631,11 +4680,9 @@ namespace tca {
     }   // plane
 
     // Find the average multiplicity 1 hit RMS and calculate the expected max RMS for each range
-    if (tcc.modes[kDebug] && (int)tpc == debug.TPC) {
-      // Note that this function is called before the slice is pushed into slices so the index
-      // isn't decremented by 1
-      std::cout << "Slice ID/Index " << slc.ID << "/" << slices.size() << " tpc " << tpc
-                << " tcc.unitsPerTick " << std::setprecision(3) << tcc.unitsPerTick;
+    if (tcx.tcc.modes[kDebug] && (int)tpc == debug.TPC) {
+      std::cout << "Slice ID " << slc.ID << " tpc " << tpc
+                << " tcc.unitsPerTick " << std::setprecision(3) << tcx.tcc.unitsPerTick;
       std::cout << " Active volume (";
       std::cout << std::fixed << std::setprecision(1) << slc.xLo << " < X < " << slc.xHi << ") (";
       std::cout << std::fixed << std::setprecision(1) << slc.yLo << " < Y < " << slc.yHi << ") (";
@@ -4659,7 +4706,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  MergeAndStore(TCSlice& slc, unsigned int itj1, unsigned int itj2, bool doPrt)
+  MergeAndStore(TCContext& tcx, TCSlice& slc, unsigned int itj1, unsigned int itj2, bool doPrt)
   {
     // Merge the two trajectories in allTraj and store them. Returns true if it was successfull.
     // Merging is done between the end (end = 1) of tj1 and the beginning (end = 0) of tj2. This function preserves the
@@ -4673,7 +4720,7 @@ namespace tca {
 
     // Merging shower Tjs requires merging the showers as well.
     if (slc.tjs[itj1].AlgMod[kShowerTj] || slc.tjs[itj2].AlgMod[kShowerTj])
-      return MergeShowerTjsAndStore(slc, itj1, itj2, doPrt);
+      return MergeShowerTjsAndStore(tcx, slc, itj1, itj2, doPrt);
 
     // Ensure that the order of 3D-matched Tjs is consistent with the convention that
     unsigned short pfp1 = GetPFPIndex(slc, slc.tjs[itj1].ID);
@@ -4698,8 +4745,8 @@ namespace tca {
 
     if (doPrt) {
       mf::LogVerbatim("TC") << "MergeAndStore: T" << tj1.ID << " and T" << tj2.ID
-                            << " at merge points " << PrintPos(slc, tp1e1) << " "
-                            << PrintPos(slc, tp2e0);
+                            << " at merge points " << PrintPos(tcx, slc, tp1e1) << " "
+                            << PrintPos(tcx, slc, tp2e0);
     }
 
     // swap the order so that abs(tj1end1 - tj2end0) is less than abs(tj2end1 - tj1end0)
@@ -4708,8 +4755,8 @@ namespace tca {
       std::swap(tp1e0, tp2e0);
       std::swap(tp1e1, tp2e1);
       if (doPrt)
-        mf::LogVerbatim("TC") << " swapped the order. Merge points " << PrintPos(slc, tp1e1) << " "
-                              << PrintPos(slc, tp2e0);
+        mf::LogVerbatim("TC") << " swapped the order. Merge points "
+                              << PrintPos(tcx, slc, tp1e1) << " " << PrintPos(tcx, slc, tp2e0);
     }
 
     // Here is what we are looking for, where - indicates a TP with charge.
@@ -4738,7 +4785,7 @@ namespace tca {
 
     if (tj1.VtxID[1] > 0 && tj2.VtxID[0] == tj1.VtxID[1]) {
       auto& vx = slc.vtxs[tj1.VtxID[1] - 1];
-      if (!MakeVertexObsolete("MAS", slc, vx, false)) {
+      if (!MakeVertexObsolete("MAS", tcx, slc, vx, false)) {
         if (doPrt)
           mf::LogVerbatim("TC") << "MergeAndStore: Found a good vertex between Tjs " << tj1.VtxID[1]
                                 << " No merging";
@@ -4765,8 +4812,8 @@ namespace tca {
     // Note that TrajPointTrajDOCA only considers TPs that have charge
     TrajPointTrajDOCA(slc, endtj1TP, tj2, tj2ClosePt, minSep);
     if (doPrt)
-      mf::LogVerbatim("TC") << " Merge point tj1 " << PrintPos(slc, endtj1TP) << " tj2ClosePt "
-                            << tj2ClosePt << " Pos " << PrintPos(slc, tj2.Pts[tj2ClosePt]);
+      mf::LogVerbatim("TC") << " Merge point tj1 " << PrintPos(tcx, slc, endtj1TP) << " tj2ClosePt "
+                            << tj2ClosePt << " Pos " << PrintPos(tcx, slc, tj2.Pts[tj2ClosePt]);
     // check for full overlap
     if (tj2ClosePt > tj2.EndPt[1]) return false;
 
@@ -4807,7 +4854,7 @@ namespace tca {
     tj1.EndFlag[1] = tj2.EndFlag[1];
 
     // A more exhaustive check that hits only appear once
-    if (HasDuplicateHits(slc, tj1, doPrt)) return false;
+    if (HasDuplicateHits(tcx, slc, tj1, doPrt)) return false;
     if (tj2.VtxID[1] > 0) {
       // move the end vertex of tj2 to the end of tj1
       tj1.VtxID[1] = tj2.VtxID[1];
@@ -4826,9 +4873,9 @@ namespace tca {
     MakeTrajectoryObsolete(slc, itj2);
     // Do this so that StoreTraj keeps the correct WorkID (of itj1)
     tj1.ID = tj1.WorkID;
-    SetPDGCode(slc, tj1);
+    SetPDGCode(tcx, slc, tj1);
     tj1.NeedsUpdate = true;
-    if (!StoreTraj(slc, tj1)) return false;
+    if (!StoreTraj(tcx, slc, tj1)) return false;
     int newTjID = slc.tjs.size();
     // Use the ParentID to trace which new Tj is superseding the merged ones
     tj1.ParentID = newTjID;
@@ -4838,7 +4885,7 @@ namespace tca {
     for (auto& tj : slc.tjs)
       if (tj.ParentID == tj1ID || tj.ParentID == tj2ID) tj.ParentID = newTjID;
     // try to attach it to a vertex
-    AttachAnyVertexToTraj(slc, newTjID, doPrt);
+    AttachAnyVertexToTraj(tcx, slc, newTjID, doPrt);
     return true;
   } // MergeAndStore
 
@@ -4996,7 +5043,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  StartTraj(TCSlice& slc,
+  StartTraj(TCContext& tcx, TCSlice& slc,
             Trajectory& tj,
             unsigned int fromhit,
             unsigned int tohit,
@@ -5004,32 +5051,33 @@ namespace tca {
   {
     // Start a trajectory located at fromHit with direction pointing to toHit
 
-    auto& fromHit = (*evt.allHits)[slc.slHits[fromhit].allHitsIndex];
-    auto& toHit = (*evt.allHits)[slc.slHits[tohit].allHitsIndex];
+    auto& fromHit = (*tcx.evt.allHits)[slc.slHits[fromhit].allHitsIndex];
+    auto& toHit = (*tcx.evt.allHits)[slc.slHits[tohit].allHitsIndex];
     float fromWire = fromHit.WireID().Wire;
     float fromTick = fromHit.PeakTime();
     float toWire = toHit.WireID().Wire;
     float toTick = toHit.PeakTime();
     CTP_t tCTP = EncodeCTP(fromHit.WireID());
-    bool success = StartTraj(slc, tj, fromWire, fromTick, toWire, toTick, tCTP, pass);
+    bool success = StartTraj(tcx, slc, tj, fromWire, fromTick, toWire, toTick, tCTP, pass);
     if (!success) return false;
     // turn on debugging using the WorkID?
-    if (tcc.modes[kDebug] && !tcc.dbgStp && !tcc.dbgDump && tcc.dbgSlc && tj.ID == debug.WorkID)
-      tcc.dbgStp = true;
-    if (tcc.dbgStp) {
+    if (tcx.tcc.modes[kDebug] && !tcx.tcc.dbgStp && !tcx.tcc.dbgDump && tcx.tcc.dbgSlc &&
+        tj.ID == debug.WorkID)
+      tcx.tcc.dbgStp = true;
+    if (tcx.tcc.dbgStp) {
       auto& tp = tj.Pts[0];
       mf::LogVerbatim("TC") << "StartTraj T" << tj.ID << " from " << (int)fromWire << ":"
                             << (int)fromTick << " -> " << (int)toWire << ":" << (int)toTick
                             << " StepDir " << tj.StepDir << " dir " << tp.Dir[0] << " " << tp.Dir[1]
                             << " ang " << tp.Ang << " AngleCode " << tp.AngleCode << " angErr "
-                            << tp.AngErr << " ExpectedHitsRMS " << ExpectedHitsRMS(slc, tp);
+                            << tp.AngErr << " ExpectedHitsRMS " << ExpectedHitsRMS(tcx, slc, tp);
     } // tcc.dbgStp
     return true;
   } // StartTraj
 
   ////////////////////////////////////////////////
   bool
-  StartTraj(TCSlice& slc,
+  StartTraj(TCContext& tcx, TCSlice& slc,
             Trajectory& tj,
             float fromWire,
             float fromTick,
@@ -5041,9 +5089,9 @@ namespace tca {
     // Start a simple (seed) trajectory going from (fromWire, toTick) to (toWire, toTick).
 
     // decrement the work ID so we can use it for debugging problems
-    --evt.WorkID;
-    if (evt.WorkID == INT_MIN) evt.WorkID = -1;
-    tj.ID = evt.WorkID;
+    --slc.ids.WorkID;
+    if (slc.ids.WorkID == INT_MIN) slc.ids.WorkID = -1;
+    tj.ID = slc.ids.WorkID;
     tj.Pass = pass;
     // Assume we are stepping in the positive WSE units direction
     short stepdir = 1;
@@ -5062,20 +5110,21 @@ namespace tca {
 
     // create a trajectory point
     TrajPoint tp;
-    if (!MakeBareTrajPoint(slc, fromWire, fromTick, toWire, toTick, tCTP, tp)) return false;
-    SetAngleCode(tp);
+    if (!MakeBareTrajPoint(tcx, slc, fromWire, fromTick, toWire, toTick, tCTP, tp)) return false;
+    SetAngleCode(tcx, tp);
     tp.AngErr = 0.1;
     tj.Pts.push_back(tp);
     // turn on debugging using the WorkID?
-    if (tcc.modes[kDebug] && !tcc.dbgStp && !tcc.dbgDump && tcc.dbgSlc && tj.ID == debug.WorkID)
-      tcc.dbgStp = true;
-    if (tcc.dbgStp) {
+    if (tcx.tcc.modes[kDebug] && !tcx.tcc.dbgStp && !tcx.tcc.dbgDump && tcx.tcc.dbgSlc &&
+        tj.ID == debug.WorkID)
+      tcx.tcc.dbgStp = true;
+    if (tcx.tcc.dbgStp) {
       auto& tp = tj.Pts[0];
       mf::LogVerbatim("TC") << "StartTraj T" << tj.ID << " from " << (int)fromWire << ":"
                             << (int)fromTick << " -> " << (int)toWire << ":" << (int)toTick
                             << " StepDir " << tj.StepDir << " dir " << tp.Dir[0] << " " << tp.Dir[1]
                             << " ang " << tp.Ang << " AngleCode " << tp.AngleCode << " angErr "
-                            << tp.AngErr << " ExpectedHitsRMS " << ExpectedHitsRMS(slc, tp);
+                            << tp.AngErr << " ExpectedHitsRMS " << ExpectedHitsRMS(tcx, slc, tp);
     } // tcc.dbgStp
     return true;
 
@@ -5083,11 +5132,11 @@ namespace tca {
 
   ////////////////////////////////////////////////
   std::pair<unsigned short, unsigned short>
-  GetSliceIndex(std::string typeName, int uID)
+  GetSliceIndex(const TCContext& tcx, std::string typeName, int uID)
   {
     // returns the slice index and product index of a data product having typeName and unique ID uID
-    for (unsigned short isl = 0; isl < slices.size(); ++isl) {
-      auto& slc = slices[isl];
+    for (unsigned short isl = 0; isl < tcx.slices.size(); ++isl) {
+      auto& slc = tcx.slices[isl];
       if (typeName == "T") {
         for (unsigned short indx = 0; indx < slc.tjs.size(); ++indx) {
           if (slc.tjs[indx].UID == uID) { return std::make_pair(isl, indx); }
@@ -5124,7 +5173,8 @@ namespace tca {
 
   ////////////////////////////////////////////////
   bool
-  Fit2D(short mode,
+  Fit2D(Fit2DSums& fit,
+        short mode,
         Point2_t inPt,
         float& inPtErr,
         Vector2_t& outVec,
@@ -5136,82 +5186,79 @@ namespace tca {
     // Mode = 1: Accumulate
     // Mode = 2: Accumulate and store to calculate chiDOF
     // Mode = -1: Fit and put results in outVec and chiDOF
-
-    static double sum, sumx, sumy, sumx2, sumy2, sumxy;
-    static unsigned short cnt;
-    static std::vector<Point2_t> fitPts;
-    static std::vector<double> fitWghts;
+    // The sums are accumulated in fit, which is owned by the caller
 
     if (mode == 0) {
       // initialize
-      cnt = 0;
-      sum = 0.;
-      sumx = 0.;
-      sumy = 0.;
-      sumx2 = 0.;
-      sumy2 = 0.;
-      sumxy = 0;
-      fitPts.resize(0);
-      fitWghts.resize(0);
+      fit.cnt = 0;
+      fit.sum = 0.;
+      fit.sumx = 0.;
+      fit.sumy = 0.;
+      fit.sumx2 = 0.;
+      fit.sumy2 = 0.;
+      fit.sumxy = 0;
+      fit.fitPts.resize(0);
+      fit.fitWghts.resize(0);
       return true;
     } // mode == 0
 
     if (mode > 0) {
       if (inPtErr <= 0.) return false;
-      ++cnt;
+      ++fit.cnt;
       double wght = 1 / (inPtErr * inPtErr);
-      sum += wght;
-      sumx += wght * inPt[0];
-      sumx2 += wght * inPt[0] * inPt[0];
-      sumy += wght * inPt[1];
-      sumy2 += wght * inPt[1] * inPt[1];
-      sumxy += wght * inPt[0] * inPt[1];
+      fit.sum += wght;
+      fit.sumx += wght * inPt[0];
+      fit.sumx2 += wght * inPt[0] * inPt[0];
+      fit.sumy += wght * inPt[1];
+      fit.sumy2 += wght * inPt[1] * inPt[1];
+      fit.sumxy += wght * inPt[0] * inPt[1];
       if (mode == 1) return true;
-      fitPts.push_back(inPt);
-      fitWghts.push_back(wght);
+      fit.fitPts.push_back(inPt);
+      fit.fitWghts.push_back(wght);
       return true;
     } // Accumulate
 
-    if (cnt < 2) return false;
+    if (fit.cnt < 2) return false;
     // do the fit
-    double delta = sum * sumx2 - sumx * sumx;
+    double delta = fit.sum * fit.sumx2 - fit.sumx * fit.sumx;
     if (delta == 0.) return false;
-    double A = (sumx2 * sumy - sumx * sumxy) / delta;
-    double B = (sumxy * sum - sumx * sumy) / delta;
+    double A = (fit.sumx2 * fit.sumy - fit.sumx * fit.sumxy) / delta;
+    double B = (fit.sumxy * fit.sum - fit.sumx * fit.sumy) / delta;
     outVec[0] = A;
     outVec[1] = B;
     chiDOF = 0;
-    if (cnt == 2 || fitPts.empty()) return true;
+    if (fit.cnt == 2 || fit.fitPts.empty()) return true;
 
     // calculate errors and chiDOF
-    if (fitPts.size() != cnt) return false;
-    double ndof = cnt - 2;
-    double varnce =
-      (sumy2 + A * A * sum + B * B * sumx2 - 2 * (A * sumy + B * sumxy - A * B * sumx)) / ndof;
+    if (fit.fitPts.size() != fit.cnt) return false;
+    double ndof = fit.cnt - 2;
+    double varnce = (fit.sumy2 + A * A * fit.sum + B * B * fit.sumx2 -
+                     2 * (A * fit.sumy + B * fit.sumxy - A * B * fit.sumx)) /
+                    ndof;
     if (varnce > 0.) {
-      outVecErr[0] = sqrt(varnce * sumx2 / delta);
-      outVecErr[1] = sqrt(varnce * sum / delta);
+      outVecErr[0] = sqrt(varnce * fit.sumx2 / delta);
+      outVecErr[1] = sqrt(varnce * fit.sum / delta);
     }
     else {
       outVecErr[0] = 0.;
       outVecErr[1] = 0.;
     }
-    sum = 0.;
+    fit.sum = 0.;
     // calculate chisq
-    for (unsigned short ii = 0; ii < fitPts.size(); ++ii) {
-      double arg = fitPts[ii][1] - A - B * fitPts[ii][0];
-      sum += fitWghts[ii] * arg * arg;
+    for (unsigned short ii = 0; ii < fit.fitPts.size(); ++ii) {
+      double arg = fit.fitPts[ii][1] - A - B * fit.fitPts[ii][0];
+      fit.sum += fit.fitWghts[ii] * arg * arg;
     }
-    chiDOF = sum / ndof;
-    fitPts.resize(0);
-    fitWghts.resize(0);
+    chiDOF = fit.sum / ndof;
+    fit.fitPts.resize(0);
+    fit.fitWghts.resize(0);
     return true;
 
   } // Fit2D
 
   ////////////////////////////////////////////////
   bool
-  DecodeDebugString(std::string strng)
+  DecodeDebugString(TCConfig& tcc, std::string strng)
   {
     // try to unpack the string as Cryostat:TPC:Plane:Wire:Tick or something
     // like Slice:<slice index>
@@ -5395,13 +5442,13 @@ namespace tca {
   // ****************************** Printing  ******************************
 
   void
-  DumpTj()
+  DumpTj(const TCContext& tcx)
   {
     // Dump all of the points in a trajectory to the output in a form that can
     // be imported by another application, e.g. Excel
     // Search for the trajectory with the specified WorkID or Unique ID
 
-    for (auto& slc : slices) {
+    for (auto& slc : tcx.slices) {
       for (auto& tj : slc.tjs) {
         if (tj.WorkID != debug.WorkID && tj.UID != debug.WorkID) continue;
         // print a header
@@ -5421,11 +5468,12 @@ namespace tca {
           // total charge near the TP
           float totChg = 0;
           for (auto iht : tp.Hits) {
-            auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+            auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
             totChg += hit.Integral();
           }
           outfile << "," << (int)totChg;
-          outfile << "," << std::setprecision(0) << std::nearbyint(tp.Pos[1] / tcc.unitsPerTick);
+          outfile << "," << std::setprecision(0)
+                  << std::nearbyint(tp.Pos[1] / tcx.tcc.unitsPerTick);
           outfile << "," << std::setprecision(2) << tp.Delta;
           outfile << "," << tp.NTPsFit;
           outfile << "," << std::setprecision(3) << tp.Ang;
@@ -5436,7 +5484,7 @@ namespace tca {
         } // ipt
         outfile.close();
         std::cout << "Points on T" << tj.UID << " dumped to " << fname << "\n";
-        tcc.dbgDump = false;
+        tcx.tcc.dbgDump = false;
         return;
       } // tj
     }   // slc
@@ -5445,7 +5493,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  PrintDebugMode()
+  PrintDebugMode(TCConfig const& tcc)
   {
     // print the debug mode configuration to the screen
     std::cout << "*** TrajCluster debug mode configuration in";
@@ -5516,7 +5564,7 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  PrintAll(detinfo::DetectorPropertiesData const& detProp, std::string someText)
+  PrintAll(detinfo::DetectorPropertiesData const& detProp, TCContext& tcx, std::string someText)
   {
     // print everything in all slices
     bool prt3V = false;
@@ -5524,9 +5572,9 @@ namespace tca {
     bool prtT = false;
     bool prtP = false;
     bool prtS3 = false;
-    for (size_t isl = 0; isl < slices.size(); ++isl) {
+    for (size_t isl = 0; isl < tcx.slices.size(); ++isl) {
       if (debug.Slice >= 0 && int(isl) != debug.Slice) continue;
-      auto& slc = slices[isl];
+      auto& slc = tcx.slices[isl];
       if (!slc.vtx3s.empty()) prt3V = true;
       if (!slc.vtxs.empty()) prt2V = true;
       if (!slc.tjs.empty()) prtT = true;
@@ -5540,22 +5588,22 @@ namespace tca {
       myprt << "************ Showers ************\n";
       myprt << "     prodID      Vtx  parUID  ___ChgPos____ ______Dir_____ ____posInPln____ "
                "___projInPln____ 2D shower UIDs\n";
-      for (size_t isl = 0; isl < slices.size(); ++isl) {
+      for (size_t isl = 0; isl < tcx.slices.size(); ++isl) {
         if (debug.Slice >= 0 && int(isl) != debug.Slice) continue;
-        auto& slc = slices[isl];
+        auto& slc = tcx.slices[isl];
         if (slc.showers.empty()) continue;
         for (auto& ss3 : slc.showers)
-          Print3S(detProp, someText, myprt, ss3);
+          Print3S(detProp, someText, myprt, tcx, slc, isl, ss3);
       } // slc
     }   // prtS3
     if (prtP) {
       bool printHeader = true;
-      for (size_t isl = 0; isl < slices.size(); ++isl) {
+      for (size_t isl = 0; isl < tcx.slices.size(); ++isl) {
         if (debug.Slice >= 0 && int(isl) != debug.Slice) continue;
-        auto& slc = slices[isl];
+        auto& slc = tcx.slices[isl];
         if (slc.pfps.empty()) continue;
         for (auto& pfp : slc.pfps)
-          PrintP(someText, myprt, pfp, printHeader);
+          PrintP(someText, myprt, tcx, slc, isl, pfp, printHeader);
       } // slc
     }   // prtS3
     if (prt3V) {
@@ -5565,12 +5613,12 @@ namespace tca {
       myprt << "     prodID    Cstat TPC     X       Y       Z    XEr  YEr  "
                "ZEr pln0 pln1 pln2 Wire score Prim? Nu? nTru";
       myprt << " ___________2D_Pos____________ _____Tj UIDs________\n";
-      for (size_t isl = 0; isl < slices.size(); ++isl) {
+      for (size_t isl = 0; isl < tcx.slices.size(); ++isl) {
         if (debug.Slice >= 0 && int(isl) != debug.Slice) continue;
-        auto& slc = slices[isl];
+        auto& slc = tcx.slices[isl];
         if (slc.vtx3s.empty()) continue;
         for (auto& vx3 : slc.vtx3s)
-          Print3V(detProp, someText, myprt, vx3, printHeader);
+          Print3V(detProp, someText, myprt, tcx, slc, vx3, printHeader);
       } // slc
     }   // prt3V
     if (prt2V) {
@@ -5578,29 +5626,35 @@ namespace tca {
       myprt << "************ 2D vertices ************\n";
       myprt << "     prodID      CTP  wire  err   tick   err  ChiDOF  NTj Pass "
                " Topo ChgFrac Score  v3D Tj UIDs\n";
-      for (size_t isl = 0; isl < slices.size(); ++isl) {
+      for (size_t isl = 0; isl < tcx.slices.size(); ++isl) {
         if (debug.Slice >= 0 && int(isl) != debug.Slice) continue;
-        auto& slc = slices[isl];
+        auto& slc = tcx.slices[isl];
         if (slc.vtxs.empty()) continue;
         for (auto& vx2 : slc.vtxs)
-          Print2V(someText, myprt, vx2, printHeader);
+          Print2V(someText, myprt, tcx, slc, vx2, printHeader);
       } // slc
     }   // prt2V
     if (prtT) {
       bool printHeader = true;
-      for (size_t isl = 0; isl < slices.size(); ++isl) {
+      for (size_t isl = 0; isl < tcx.slices.size(); ++isl) {
         if (debug.Slice >= 0 && int(isl) != debug.Slice) continue;
-        auto& slc = slices[isl];
+        auto& slc = tcx.slices[isl];
         if (slc.tjs.empty()) continue;
         for (auto& tj : slc.tjs)
-          PrintT(someText, myprt, tj, printHeader);
+          PrintT(someText, myprt, tcx, slc, tj, printHeader);
       } // slc
     }   // prtT
   }     // PrintAll
 
   ////////////////////////////////////////////////
   void
-  PrintP(std::string someText, mf::LogVerbatim& myprt, PFPStruct& pfp, bool& printHeader)
+  PrintP(std::string someText,
+         mf::LogVerbatim& myprt,
+         TCContext& tcx,
+         TCSlice& slc,
+         unsigned short sliceIndex,
+         PFPStruct& pfp,
+         bool& printHeader)
   {
     if (pfp.ID <= 0) return;
     if (printHeader) {
@@ -5609,11 +5663,8 @@ namespace tca {
                "_____ePos____ CS ____edEdx_____  MVI MCSMom  Len nTP3 nSec SLk? PDG  Par \n";
       printHeader = false;
     } // printHeader
-    auto sIndx = GetSliceIndex("P", pfp.UID);
-    if (sIndx.first == USHRT_MAX) return;
-    auto& slc = slices[sIndx.first];
     std::string str =
-      std::to_string(slc.ID) + ":" + std::to_string(sIndx.first) + ":" + std::to_string(pfp.ID);
+      std::to_string(slc.ID) + ":" + std::to_string(sliceIndex) + ":" + std::to_string(pfp.ID);
     str += "/" + std::to_string(pfp.UID);
     myprt << std::setw(12) << str;
     // start and end stuff
@@ -5653,7 +5704,7 @@ namespace tca {
     } // startend
     myprt << std::setw(6) << pfp.MVI;
     // global stuff
-    myprt << std::setw(7) << MCSMom(slc, pfp.TjIDs);
+    myprt << std::setw(7) << MCSMom(tcx, slc, pfp.TjIDs);
     float length = Length(pfp);
     if (length < 100) { myprt << std::setw(5) << std::setprecision(1) << length; }
     else {
@@ -5689,14 +5740,13 @@ namespace tca {
   Print3V(detinfo::DetectorPropertiesData const& detProp,
           std::string someText,
           mf::LogVerbatim& myprt,
+          TCContext& tcx,
+          TCSlice& slc,
           Vtx3Store& vx3,
           bool& printHeader)
   {
     // print a 3D vertex on one line
     if (vx3.ID <= 0) return;
-    auto sIndx = GetSliceIndex("3V", vx3.UID);
-    if (sIndx.first == USHRT_MAX) return;
-    auto& slc = slices[sIndx.first];
     if (printHeader) {
       myprt
         << "****** 3D vertices ******************************************__2DVtx_UID__*******\n";
@@ -5735,8 +5785,8 @@ namespace tca {
     myprt << std::right << std::setw(5) << nTruMatch;
     Point2_t pos;
     for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
-      PosInPlane(detProp, slc, vx3, plane, pos);
-      myprt << " " << PrintPos(slc, pos);
+      PosInPlane(detProp, tcx, slc, vx3, plane, pos);
+      myprt << " " << PrintPos(tcx, slc, pos);
     } // plane
     if (vx3.Wire == -2) {
       // find the Tjs that are attached to it
@@ -5763,14 +5813,16 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  Print2V(std::string someText, mf::LogVerbatim& myprt, VtxStore& vx2, bool& printHeader)
+  Print2V(std::string someText,
+          mf::LogVerbatim& myprt,
+          TCContext& tcx,
+          const TCSlice& slc,
+          VtxStore& vx2,
+          bool& printHeader)
   {
     // print a 2D vertex on one line
     if (vx2.ID <= 0) return;
     if (debug.CTP != UINT_MAX && vx2.CTP != debug.CTP) return;
-    auto sIndx = GetSliceIndex("2V", vx2.UID);
-    if (sIndx.first == USHRT_MAX) return;
-    auto& slc = slices[sIndx.first];
     if (printHeader) {
       myprt << "************ 2D vertices ************\n";
       myprt << "     prodID    CTP    wire  err   tick   err  ChiDOF  NTj Pass  Topo ChgFrac Score "
@@ -5783,8 +5835,9 @@ namespace tca {
     myprt << std::right << std::setw(8) << std::setprecision(0) << std::nearbyint(vx2.Pos[0]);
     myprt << std::right << std::setw(5) << std::setprecision(1) << vx2.PosErr[0];
     myprt << std::right << std::setw(8) << std::setprecision(0)
-          << std::nearbyint(vx2.Pos[1] / tcc.unitsPerTick);
-    myprt << std::right << std::setw(5) << std::setprecision(1) << vx2.PosErr[1] / tcc.unitsPerTick;
+          << std::nearbyint(vx2.Pos[1] / tcx.tcc.unitsPerTick);
+    myprt << std::right << std::setw(5) << std::setprecision(1)
+          << vx2.PosErr[1] / tcx.tcc.unitsPerTick;
     myprt << std::right << std::setw(7) << vx2.ChiDOF;
     myprt << std::right << std::setw(5) << vx2.NTraj;
     myprt << std::right << std::setw(5) << vx2.Pass;
@@ -5817,14 +5870,14 @@ namespace tca {
   Print3S(detinfo::DetectorPropertiesData const& detProp,
           std::string someText,
           mf::LogVerbatim& myprt,
+          TCContext& tcx,
+          TCSlice& slc,
+          unsigned short sliceIndex,
           ShowerStruct3D& ss3)
   {
     if (ss3.ID <= 0) return;
-    auto sIndx = GetSliceIndex("3S", ss3.UID);
-    if (sIndx.first == USHRT_MAX) return;
-    auto& slc = slices[sIndx.first];
     std::string str =
-      std::to_string(slc.ID) + ":" + std::to_string(sIndx.first) + ":" + std::to_string(ss3.ID);
+      std::to_string(slc.ID) + ":" + std::to_string(sliceIndex) + ":" + std::to_string(ss3.ID);
     str += "/" + std::to_string(ss3.UID);
     myprt << std::fixed << std::setw(12) << str;
     str = "--";
@@ -5837,8 +5890,8 @@ namespace tca {
     std::vector<float> projInPlane(slc.nPlanes);
     for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
       CTP_t inCTP = EncodeCTP(ss3.TPCID.Cryostat, ss3.TPCID.TPC, plane);
-      auto tp = MakeBareTP(detProp, slc, ss3.ChgPos, ss3.Dir, inCTP);
-      myprt << " " << PrintPos(slc, tp.Pos);
+      auto tp = MakeBareTP(detProp, tcx, slc, ss3.ChgPos, ss3.Dir, inCTP);
+      myprt << " " << PrintPos(tcx, slc, tp.Pos);
       projInPlane[plane] = tp.Delta;
     } // plane
     for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
@@ -5855,7 +5908,12 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  PrintT(std::string someText, mf::LogVerbatim& myprt, Trajectory& tj, bool& printHeader)
+  PrintT(std::string someText,
+         mf::LogVerbatim& myprt,
+         TCContext& tcx,
+         TCSlice& slc,
+         Trajectory& tj,
+         bool& printHeader)
   {
     // print a 2D vertex on one line
     if (tj.ID <= 0) return;
@@ -5868,9 +5926,6 @@ namespace tca {
                "Chg(k) chgRMS  Mom __Vtx__  PDG eLike  Par Pri NuPar   WorkID \n";
       printHeader = false;
     }
-    auto sIndx = GetSliceIndex("T", tj.UID);
-    if (sIndx.first == USHRT_MAX) return;
-    auto& slc = slices[sIndx.first];
     std::string str = "T" + std::to_string(tj.ID) + "/TU" + std::to_string(tj.UID);
     myprt << std::fixed << std::setw(12) << str;
     myprt << std::setw(6) << tj.CTP;
@@ -5878,7 +5933,7 @@ namespace tca {
     myprt << std::setw(5) << tj.EndPt[1] - tj.EndPt[0] + 1;
     unsigned short endPt0 = tj.EndPt[0];
     auto& tp0 = tj.Pts[endPt0];
-    int itick = tp0.Pos[1] / tcc.unitsPerTick;
+    int itick = tp0.Pos[1] / tcx.tcc.unitsPerTick;
     if (itick < 0) itick = 0;
     myprt << std::setw(6) << (int)(tp0.Pos[0] + 0.5) << ":" << itick; // W:T
     if (itick < 10) { myprt << " "; }
@@ -5902,7 +5957,7 @@ namespace tca {
     myprt << std::setw(5) << (int)tp0.AveChg;
     unsigned short endPt1 = tj.EndPt[1];
     auto& tp1 = tj.Pts[endPt1];
-    itick = tp1.Pos[1] / tcc.unitsPerTick;
+    itick = tp1.Pos[1] / tcx.tcc.unitsPerTick;
     myprt << std::setw(6) << (int)(tp1.Pos[0] + 0.5) << ":" << itick; // W:T
     if (itick < 10) { myprt << " "; }
     if (itick < 100) { myprt << " "; }
@@ -5933,7 +5988,7 @@ namespace tca {
     if (tj.VtxID[1] > 0) vxid = slc.vtxs[tj.VtxID[1] - 1].UID;
     myprt << std::setw(4) << vxid;
     myprt << std::setw(5) << tj.PDGCode;
-    myprt << std::setw(7) << std::setprecision(2) << ElectronLikelihood(slc, tj);
+    myprt << std::setw(7) << std::setprecision(2) << ElectronLikelihood(tcx, slc, tj);
     myprt << std::setw(5) << tj.ParentID;
     myprt << std::setw(5) << PrimaryID(slc, tj);
     myprt << std::setw(6) << NeutrinoPrimaryTjID(slc, tj);
@@ -5949,6 +6004,7 @@ namespace tca {
   void
   PrintAllTraj(detinfo::DetectorPropertiesData const& detProp,
                std::string someText,
+               TCContext& tcx,
                TCSlice& slc,
                unsigned short itj,
                unsigned short ipt,
@@ -5998,8 +6054,8 @@ namespace tca {
           myprt << std::right << std::setw(5) << nTruMatch;
           Point2_t pos;
           for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
-            PosInPlane(detProp, slc, vx3, plane, pos);
-            myprt << " " << PrintPos(slc, pos);
+            PosInPlane(detProp, tcx, slc, vx3, plane, pos);
+            myprt << " " << PrintPos(tcx, slc, pos);
           } // plane
           if (vx3.Wire == -2) {
             // find the Tjs that are attached to it
@@ -6047,9 +6103,9 @@ namespace tca {
                   << std::nearbyint(vx2.Pos[0]);
             myprt << std::right << std::setw(5) << std::setprecision(1) << vx2.PosErr[0];
             myprt << std::right << std::setw(8) << std::setprecision(0)
-                  << std::nearbyint(vx2.Pos[1] / tcc.unitsPerTick);
+                  << std::nearbyint(vx2.Pos[1] / tcx.tcc.unitsPerTick);
             myprt << std::right << std::setw(5) << std::setprecision(1)
-                  << vx2.PosErr[1] / tcc.unitsPerTick;
+                  << vx2.PosErr[1] / tcx.tcc.unitsPerTick;
             myprt << std::right << std::setw(7) << vx2.ChiDOF;
             myprt << std::right << std::setw(5) << vx2.NTraj;
             myprt << std::right << std::setw(5) << vx2.Pass;
@@ -6108,7 +6164,7 @@ namespace tca {
         myprt << std::setw(5) << aTj.EndPt[1] - aTj.EndPt[0] + 1;
         unsigned short endPt0 = aTj.EndPt[0];
         auto& tp0 = aTj.Pts[endPt0];
-        int itick = tp0.Pos[1] / tcc.unitsPerTick;
+        int itick = tp0.Pos[1] / tcx.tcc.unitsPerTick;
         if (itick < 0) itick = 0;
         myprt << std::setw(6) << (int)(tp0.Pos[0] + 0.5) << ":" << itick; // W:T
         if (itick < 10) { myprt << " "; }
@@ -6132,7 +6188,7 @@ namespace tca {
         myprt << std::setw(5) << (int)tp0.AveChg;
         unsigned short endPt1 = aTj.EndPt[1];
         auto& tp1 = aTj.Pts[endPt1];
-        itick = tp1.Pos[1] / tcc.unitsPerTick;
+        itick = tp1.Pos[1] / tcx.tcc.unitsPerTick;
         myprt << std::setw(6) << (int)(tp1.Pos[0] + 0.5) << ":" << itick; // W:T
         if (itick < 10) { myprt << " "; }
         if (itick < 100) { myprt << " "; }
@@ -6180,17 +6236,18 @@ namespace tca {
     if (ipt == USHRT_MAX) {
       // print all points
       for (unsigned short ii = 0; ii < aTj.Pts.size(); ++ii)
-        PrintTP(someText, slc, ii, aTj.StepDir, aTj.Pass, aTj.Pts[ii]);
+        PrintTP(someText, tcx, slc, ii, aTj.StepDir, aTj.Pass, aTj.Pts[ii]);
     }
     else {
       // print just one
-      PrintTP(someText, slc, ipt, aTj.StepDir, aTj.Pass, aTj.Pts[ipt]);
+      PrintTP(someText, tcx, slc, ipt, aTj.StepDir, aTj.Pass, aTj.Pts[ipt]);
     }
   } // PrintAllTraj
 
   //////////////////////////////////////////
   void
   PrintTrajectory(std::string someText,
+                  TCContext& tcx,
                   const TCSlice& slc,
                   const Trajectory& tj,
                   unsigned short tPoint)
@@ -6225,7 +6282,7 @@ namespace tca {
       }
       PrintTPHeader(someText);
       for (unsigned short ipt = 0; ipt < tj.Pts.size(); ++ipt)
-        PrintTP(someText, slc, ipt, tj.StepDir, tj.Pass, tj.Pts[ipt]);
+        PrintTP(someText, tcx, slc, ipt, tj.StepDir, tj.Pass, tj.Pts[ipt]);
       // See if this trajectory is a shower Tj
       if (tj.AlgMod[kShowerTj]) {
         for (unsigned short ic = 0; ic < slc.cots.size(); ++ic) {
@@ -6239,7 +6296,7 @@ namespace tca {
           if (ss.Envelope.empty()) { myprt << " NA"; }
           else {
             for (auto& vtx : ss.Envelope)
-              myprt << " " << (int)vtx[0] << ":" << (int)(vtx[1] / tcc.unitsPerTick);
+              myprt << " " << (int)vtx[0] << ":" << (int)(vtx[1] / tcx.tcc.unitsPerTick);
           }
           myprt << " Energy " << (int)ss.Energy;
           myprt << " Area " << std::fixed << std::setprecision(1) << (int)ss.EnvelopeArea
@@ -6276,7 +6333,7 @@ namespace tca {
         mf::LogVerbatim("TC") << "Can't print non-existent traj point " << tPoint;
         return;
       }
-      PrintTP(someText, slc, tPoint, tj.StepDir, tj.Pass, tj.Pts[tPoint]);
+      PrintTP(someText, tcx, slc, tPoint, tj.StepDir, tj.Pass, tj.Pts[tPoint]);
     }
   } // PrintTrajectory
 
@@ -6292,6 +6349,7 @@ namespace tca {
   ////////////////////////////////////////////////
   void
   PrintTP(std::string someText,
+          TCContext& tcx,
           const TCSlice& slc,
           unsigned short ipt,
           short dir,
@@ -6329,7 +6387,7 @@ namespace tca {
     else {
       for (unsigned short ii = 0; ii < tp.Hits.size(); ++ii) {
         unsigned int iht = tp.Hits[ii];
-        auto& hit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+        auto& hit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
         myprt << " " << hit.WireID().Wire << ":" << (int)hit.PeakTime();
         if (tp.UseHit[ii]) {
           // Distinguish used hits from nearby hits
@@ -6368,7 +6426,11 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  PrintPFP(std::string someText, TCSlice& slc, const PFPStruct& pfp, bool printHeader)
+  PrintPFP(std::string someText,
+           TCContext& tcx,
+           TCSlice& slc,
+           const PFPStruct& pfp,
+           bool printHeader)
   {
     mf::LogVerbatim myprt("TC");
     if (printHeader) {
@@ -6420,12 +6482,12 @@ namespace tca {
       myprt << std::setw(5) << std::setprecision(0) << length;
     }
     myprt << std::setw(5) << std::setprecision(2) << pfp.TP3Ds.size();
-    myprt << std::setw(7) << MCSMom(slc, pfp.TjIDs);
+    myprt << std::setw(7) << MCSMom(tcx, slc, pfp.TjIDs);
     myprt << std::setw(5) << IsShowerLike(slc, pfp.TjIDs);
     myprt << std::setw(5) << pfp.PDGCode;
     myprt << "      NA";
     myprt << std::setw(4) << pfp.ParentUID;
-    myprt << std::setw(5) << PrimaryUID(slc, pfp);
+    myprt << std::setw(5) << PrimaryUID(tcx, pfp);
     if (!pfp.TjIDs.empty()) {
       for (auto& tjID : pfp.TjIDs)
         myprt << " T" << tjID;
@@ -6439,7 +6501,7 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  PrintPFPs(std::string someText, TCSlice& slc)
+  PrintPFPs(std::string someText, TCContext& tcx, TCSlice& slc)
   {
     if (slc.pfps.empty()) return;
 
@@ -6450,7 +6512,7 @@ namespace tca {
          "________ePos_______  ______eDir______  ______edEdx_____ BstPln PDG TruPDG Par Prim E*P\n";
     bool printHeader = true;
     for (auto& pfp : slc.pfps) {
-      PrintPFP(someText, slc, pfp, printHeader);
+      PrintPFP(someText, tcx, slc, pfp, printHeader);
       printHeader = false;
     } // im
 
@@ -6501,38 +6563,38 @@ namespace tca {
 
   /////////////////////////////////////////
   std::string
-  PrintHitShort(const TCHit& tch)
+  PrintHitShort(TCContext& tcx, const TCHit& tch)
   {
-    if (tch.allHitsIndex > (*evt.allHits).size() - 1) return "NA";
-    auto& hit = (*evt.allHits)[tch.allHitsIndex];
+    if (tch.allHitsIndex > (*tcx.evt.allHits).size() - 1) return "NA";
+    auto& hit = (*tcx.evt.allHits)[tch.allHitsIndex];
     return std::to_string(hit.WireID().Plane) + ":" + std::to_string(hit.WireID().Wire) + ":" +
            std::to_string((int)hit.PeakTime());
   } // PrintHit
 
   /////////////////////////////////////////
   std::string
-  PrintHit(const TCHit& tch)
+  PrintHit(TCContext& tcx, const TCHit& tch)
   {
-    if (tch.allHitsIndex > (*evt.allHits).size() - 1) return "NA";
-    auto& hit = (*evt.allHits)[tch.allHitsIndex];
+    if (tch.allHitsIndex > (*tcx.evt.allHits).size() - 1) return "NA";
+    auto& hit = (*tcx.evt.allHits)[tch.allHitsIndex];
     return std::to_string(hit.WireID().Plane) + ":" + std::to_string(hit.WireID().Wire) + ":" +
            std::to_string((int)hit.PeakTime()) + "_" + std::to_string(tch.InTraj);
   } // PrintHit
 
   /////////////////////////////////////////
   std::string
-  PrintPos(const TCSlice& slc, const TrajPoint& tp)
+  PrintPos(TCContext& tcx, const TCSlice& slc, const TrajPoint& tp)
   {
-    return std::to_string(DecodeCTP(tp.CTP).Plane) + ":" + PrintPos(slc, tp.Pos);
+    return std::to_string(DecodeCTP(tp.CTP).Plane) + ":" + PrintPos(tcx, slc, tp.Pos);
   } // PrintPos
 
   /////////////////////////////////////////
   std::string
-  PrintPos(const TCSlice& slc, const Point2_t& pos)
+  PrintPos(TCContext& tcx, const TCSlice& slc, const Point2_t& pos)
   {
     unsigned int wire = 0;
     if (pos[0] > -0.4) wire = std::nearbyint(pos[0]);
-    int time = std::nearbyint(pos[1] / tcc.unitsPerTick);
+    int time = std::nearbyint(pos[1] / tcx.tcc.unitsPerTick);
     return std::to_string(wire) + ":" + std::to_string(time);
   } // PrintPos
 
@@ -45,7 +45,8 @@ trkf::TrackKalmanFitter::fitTrack(detinfo::DetectorPropertiesData const& detProp
                                   const bool flipDirection,
                                   recob::Track& outTrack,
                                   std::vector<art::Ptr<recob::Hit>>& outHits,
-                                  trkmkr::OptionalOutputs& optionals) const
+                                  trkmkr::OptionalOutputs& optionals,
+                                  Workspace* workspace) const
 {
   auto position = traj.Vertex();
   auto direction = traj.VertexDirection();
@@ -66,7 +67,8 @@ trkf::TrackKalmanFitter::fitTrack(detinfo::DetectorPropertiesData const& detProp
                           pdgid,
                           fwdTrack,
                           fwdHits,
-                          fwdoptionals);
+                          fwdoptionals,
+                          workspace);
 
     recob::Track bwdTrack;
     std::vector<art::Ptr<recob::Hit>> bwdHits;
@@ -83,7 +85,8 @@ trkf::TrackKalmanFitter::fitTrack(detinfo::DetectorPropertiesData const& detProp
                           pdgid,
                           bwdTrack,
                           bwdHits,
-                          bwdoptionals);
+                          bwdoptionals,
+                          workspace);
 
     if (okfwd == false && okbwd == false) { return false; }
     else if (okfwd == true && okbwd == true) {
@@ -130,7 +133,8 @@ trkf::TrackKalmanFitter::fitTrack(detinfo::DetectorPropertiesData const& detProp
                     pdgid,
                     outTrack,
                     outHits,
-                    optionals);
+                    optionals,
+                    workspace);
   }
 }
 
@@ -146,7 +150,8 @@ trkf::TrackKalmanFitter::fitTrack(detinfo::DetectorPropertiesData const& detProp
                                   const int pdgid,
                                   recob::Track& outTrack,
                                   std::vector<art::Ptr<recob::Hit>>& outHits,
-                                  trkmkr::OptionalOutputs& optionals) const
+                                  trkmkr::OptionalOutputs& optionals,
+                                  Workspace* workspace) const
 {
   if (dumpLevel_ > 1)
     std::cout << "Fitting track with tkID=" << tkID << " start pos=" << position
@@ -160,19 +165,24 @@ trkf::TrackKalmanFitter::fitTrack(detinfo::DetectorPropertiesData const& detProp
   // setup the KFTrackState we'll use throughout the fit
   KFTrackState trackState = setupInitialTrackState(position, direction, trackStateCov, pval, pdgid);
 
+  // buffers of the fit, reused from the caller's workspace if there is one
+  Workspace localWorkspace;
+  Workspace& ws = workspace ? *workspace : localWorkspace;
+  ws.clear();
+
   // setup vector of HitStates and flags, with either same or inverse order as input hit vector
   // this is what we'll loop over during the fit
-  std::vector<HitState> hitstatev;
-  std::vector<recob::TrajectoryPointFlags::Mask_t> hitflagsv;
+  std::vector<HitState>& hitstatev = ws.hitstatev;
+  std::vector<recob::TrajectoryPointFlags::Mask_t>& hitflagsv = ws.hitflagsv;
   bool inputok = setupInputStates(detProp, hits, flags, trackState, hitstatev, hitflagsv);
   if (!inputok) return false;
 
   // track and index vectors we use to store the fit results
-  std::vector<KFTrackState> fwdPrdTkState;
-  std::vector<KFTrackState> fwdUpdTkState;
-  std::vector<unsigned int> hitstateidx;
-  std::vector<unsigned int> rejectedhsidx;
-  std::vector<unsigned int> sortedtksidx;
+  std::vector<KFTrackState>& fwdPrdTkState = ws.fwdPrdTkState;
+  std::vector<KFTrackState>& fwdUpdTkState = ws.fwdUpdTkState;
+  std::vector<unsigned int>& hitstateidx = ws.hitstateidx;
+  std::vector<unsigned int>& rejectedhsidx = ws.rejectedhsidx;
+  std::vector<unsigned int>& sortedtksidx = ws.sortedtksidx;
 
   // do the actual fit
   bool fitok = doFitWork(trackState,
@@ -220,6 +230,18 @@ trkf::TrackKalmanFitter::fitTrack(detinfo::DetectorPropertiesData const& detProp
   return fillok;
 }
 
+void
+trkf::TrackKalmanFitter::Workspace::clear()
+{
+  hitstatev.clear();
+  hitflagsv.clear();
+  fwdPrdTkState.clear();
+  fwdUpdTkState.clear();
+  hitstateidx.clear();
+  rejectedhsidx.clear();
+  sortedtksidx.clear();
+}
+
 trkf::KFTrackState
 trkf::TrackKalmanFitter::setupInitialTrackState(const Point_t& position,
                                                 const Vector_t& direction,
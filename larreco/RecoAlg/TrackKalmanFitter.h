@@ -187,6 +187,21 @@ namespace trkf {
       dumpLevel_ = dumpLevel;
     }
 
+    /// Buffers used during the fit of a track. A caller fitting many tracks can
+    /// keep one (per thread) and pass it to fitTrack, so that their capacity
+    /// is reused from one track to the next.
+    struct Workspace {
+      std::vector<HitState> hitstatev;
+      std::vector<recob::TrajectoryPointFlags::Mask_t> hitflagsv;
+      std::vector<KFTrackState> fwdPrdTkState;
+      std::vector<KFTrackState> fwdUpdTkState;
+      std::vector<unsigned int> hitstateidx;
+      std::vector<unsigned int> rejectedhsidx;
+      std::vector<unsigned int> sortedtksidx;
+
+      void clear();
+    };
+
     /// Constructor from TrackStatePropagator and Parameters table
     explicit TrackKalmanFitter(const TrackStatePropagator* prop, Parameters const& p)
       : TrackKalmanFitter(prop,
@@ -222,7 +237,8 @@ namespace trkf {
                   const bool flipDirection,
                   recob::Track& outTrack,
                   std::vector<art::Ptr<recob::Hit>>& outHits,
-                  trkmkr::OptionalOutputs& optionals) const;
+                  trkmkr::OptionalOutputs& optionals,
+                  Workspace* workspace = nullptr) const;
 
     /// Fit track starting from intial position, direction, and flags
     bool fitTrack(detinfo::DetectorPropertiesData const& detProp,
@@ -236,7 +252,8 @@ namespace trkf {
                   const int pdgid,
                   recob::Track& outTrack,
                   std::vector<art::Ptr<recob::Hit>>& outHits,
-                  trkmkr::OptionalOutputs& optionals) const;
+                  trkmkr::OptionalOutputs& optionals,
+                  Workspace* workspace = nullptr) const;
 
     /// Function where the core of the fit is performed
     bool doFitWork(KFTrackState& trackState,
@@ -6,6 +6,7 @@
 #include "larreco/RecoAlg/TrackMomentumCalculator.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>
@@ -14,23 +15,11 @@
 #include <string>
 #include <tuple>
 
-#include "Math/Functor.h"
-#include "Math/GenVector/PositionVector3D.h"
 #include "Minuit2/Minuit2Minimizer.h"
-#include "Rtypes.h"
-#include "TAxis.h"
-#include "TGraphErrors.h"
-#include "TMath.h"
-#include "TMatrixDSymEigen.h"
-#include "TMatrixDSymfwd.h"
-#include "TMatrixDfwd.h"
-#include "TMatrixT.h"
-#include "TMatrixTSym.h"
-#include "TPolyLine3D.h"
+#include "TGraph.h"
 #include "TSpline.h"
-#include "TVectorDfwd.h"
-#include "TVectorT.h"
 #include "canvas/Persistency/Common/Ptr.h"
+#include "larcorealg/CoreUtils/quiet_Math_Functor.h"
 #include "lardataobj/RecoBase/Track.h"
 
 using std::cout;
@@ -60,11 +49,118 @@ namespace {
   TSpline3 const KEvsR_spline3{"KEvsRS", &KEvsR};
 
 
-  TVector3 const basex{1, 0, 0};
-  TVector3 const basey{0, 1, 0};
-  TVector3 const basez{0, 0, 1};
+  /// Just what the scattering angle kernels need of a 3D vector; the
+  /// operations are the ones of `TVector3`.
+  struct Vector3 {
+    double x, y, z;
+
+    double
+    Dot(Vector3 const& other) const
+    {
+      return x * other.x + y * other.y + z * other.z;
+    }
+
+    Vector3
+    Cross(Vector3 const& other) const
+    {
+      return {y * other.z - other.y * z, z * other.x - other.z * x, x * other.y - other.x * y};
+    }
+
+    Vector3
+    Unit() const
+    {
+      double const tot2 = Dot(*this);
+      double const tot = (tot2 > 0) ? 1.0 / std::sqrt(tot2) : 1.0;
+      return {x * tot, y * tot, z * tot};
+    }
+  };
+
+  constexpr Vector3 basex{1, 0, 0};
+  constexpr Vector3 basez{0, 0, 1};
   constexpr float kcal{0.0024};
 
+  std::vector<trkf::TrackMomentumCalculator::Point_t>
+  trackPoints(recob::Track const& trk)
+  {
+    std::vector<trkf::TrackMomentumCalculator::Point_t> points;
+    auto const n_points = trk.NumberTrajectoryPoints();
+    points.reserve(n_points);
+    for (std::size_t i = 0; i < n_points; ++i)
+      points.push_back(trk.LocationAtPoint(i));
+    return points;
+  }
+
+  /// Direction of the largest spread of the points (`vx`, `vy`, `vz`): the
+  /// eigenvector of the largest eigenvalue of their covariance matrix, found
+  /// with cyclic Jacobi rotations.
+  std::array<double, 3>
+  principalAxis(std::vector<float> const& vx,
+                std::vector<float> const& vy,
+                std::vector<float> const& vz)
+  {
+    double const na = vx.size();
+    double sumx = 0.0;
+    double sumy = 0.0;
+    double sumz = 0.0;
+    for (std::size_t i = 0; i < vx.size(); ++i) {
+      sumx += vx[i];
+      sumy += vy[i];
+      sumz += vz[i];
+    }
+    sumx /= na;
+    sumy /= na;
+    sumz /= na;
+
+    double m[3][3]{};
+    for (std::size_t i = 0; i < vx.size(); ++i) {
+      double const d[3]{vx[i] - sumx, vy[i] - sumy, vz[i] - sumz};
+      for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 3; ++c)
+          m[r][c] += d[r] * d[c] / na;
+    }
+
+    double v[3][3]{{1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}};
+    for (int sweep = 0; sweep < 50; ++sweep) {
+      double const off = cet::sum_of_squares(m[0][1], m[0][2], m[1][2]);
+      double const diag = cet::sum_of_squares(m[0][0], m[1][1], m[2][2]);
+      if (off <= 1e-30 * diag) break;
+
+      for (int p = 0; p < 2; ++p) {
+        for (int q = p + 1; q < 3; ++q) {
+          if (m[p][q] == 0.) continue;
+          double const theta = (m[q][q] - m[p][p]) / (2.0 * m[p][q]);
+          double const t = std::copysign(1.0, theta) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+          double const c = 1.0 / std::sqrt(t * t + 1.0);
+          double const s = t * c;
+          for (int k = 0; k < 3; ++k) {
+            double const mkp = m[k][p];
+            double const mkq = m[k][q];
+            m[k][p] = c * mkp - s * mkq;
+            m[k][q] = s * mkp + c * mkq;
+          }
+          for (int k = 0; k < 3; ++k) {
+            double const mpk = m[p][k];
+            double const mqk = m[q][k];
+            m[p][k] = c * mpk - s * mqk;
+            m[q][k] = s * mpk + c * mqk;
+          }
+          for (int k = 0; k < 3; ++k) {
+            double const vkp = v[k][p];
+            double const vkq = v[k][q];
+            v[k][p] = c * vkp - s * vkq;
+            v[k][q] = s * vkp + c * vkq;
+          }
+        }
+      }
+    }
+
+    int ind1 = 0;
+    for (int i = 1; i < 3; ++i) {
+      if (m[i][i] > m[ind1][ind1]) ind1 = i;
+    }
+    return {{v[0][ind1], v[1][ind1], v[2][ind1]}};
+  }
+
   class FcnWrapper {
   public:
     explicit FcnWrapper(std::vector<double>&& xmeas,
@@ -75,14 +171,20 @@ namespace {
       , eymeas_{eymeas}
     {}
 
+    /// Whether all the measurements have a non-zero error.
+    bool
+    valid() const
+    {
+      return std::none_of(eymeas_.begin(), eymeas_.end(), [](double ey) {
+        return std::abs(ey) < std::numeric_limits<double>::epsilon();
+      });
+    }
+
     double
-    my_mcs_chi2(double const* x) const
+    my_mcs_chi2(double const p, double const theta0) const
     {
       double result = 0.0;
 
-      double p = x[0];
-      double theta0 = x[1];
-
       auto const n = xmeas_.size();
       assert(n == ymeas_.size());
       assert(n == eymeas_.size());
@@ -92,11 +194,6 @@ namespace {
         double const yy = ymeas_[i];
         double const ey = eymeas_[i];
 
-        if (std::abs(ey) < std::numeric_limits<double>::epsilon()) {
-          std::cout << " Zero denominator in my_mcs_chi2 ! " << std::endl;
-          return -1;
-        }
-
         constexpr double rad_length{14.0};
         double const l0 = xx / rad_length;
         double res1 = 0.0;
@@ -130,8 +227,7 @@ namespace {
 
 namespace trkf {
 
-  TrackMomentumCalculator::TrackMomentumCalculator(double const min,
-                                                   double const max)
+  TrackMomentumCalculator::TrackMomentumCalculator(double const min, double const max)
     : minLength{min}
     , maxLength{max}
   {
@@ -251,16 +347,23 @@ namespace trkf {
 
   double
   TrackMomentumCalculator::GetMomentumMultiScatterLLHD(
-    const art::Ptr<recob::Track>& trk)
+    const art::Ptr<recob::Track>& trk) const
+  {
+    return GetMomentumMultiScatterLLHD(trackPoints(*trk));
+  }
+
+  double
+  TrackMomentumCalculator::GetMomentumMultiScatterLLHD(
+    std::vector<Point_t> const& points) const
   {
     std::vector<float> recoX;
     std::vector<float> recoY;
     std::vector<float> recoZ;
+    recoX.reserve(points.size());
+    recoY.reserve(points.size());
+    recoZ.reserve(points.size());
 
-    int n_points = trk->NumberTrajectoryPoints();
-
-    for (int i = 0; i < n_points; i++) {
-      auto const& pos = trk->LocationAtPoint(i);
+    for (auto const& pos : points) {
       recoX.push_back(pos.X());
       recoY.push_back(pos.Y());
       recoZ.push_back(pos.Z());
@@ -269,9 +372,6 @@ namespace trkf {
     if (recoX.size() < 2)
       return -1.0;
 
-    if (!plotRecoTracks_(recoX, recoY, recoZ))
-      return -1.0;
-
     constexpr double seg_size{10.};
 
     auto const segments = getSegTracks_(recoX, recoY, recoZ, seg_size);
@@ -320,10 +420,11 @@ namespace trkf {
 
   TVector3
   TrackMomentumCalculator::GetMultiScatterStartingPoint(
-    const art::Ptr<recob::Track>& trk)
+    const art::Ptr<recob::Track>& trk) const
   {
-    double const LLHDp = GetMuMultiScatterLLHD3(trk, true);
-    double const LLHDm = GetMuMultiScatterLLHD3(trk, false);
+    auto const points = trackPoints(*trk);
+    double const LLHDp = GetMuMultiScatterLLHD3(points, true);
+    double const LLHDm = GetMuMultiScatterLLHD3(points, false);
 
     if (LLHDp != -1 && LLHDm != -1 && LLHDp > LLHDm) {
       int const n_points = trk->NumberTrajectoryPoints();
@@ -339,16 +440,27 @@ namespace trkf {
   double
   TrackMomentumCalculator::GetMuMultiScatterLLHD3(
     art::Ptr<recob::Track> const& trk,
-    bool const dir)
+    bool const dir) const
+  {
+    return GetMuMultiScatterLLHD3(trackPoints(*trk), dir);
+  }
+
+  double
+  TrackMomentumCalculator::GetMuMultiScatterLLHD3(
+    std::vector<Point_t> const& points,
+    bool const dir) const
   {
     std::vector<float> recoX;
     std::vector<float> recoY;
     std::vector<float> recoZ;
+    recoX.reserve(points.size());
+    recoY.reserve(points.size());
+    recoZ.reserve(points.size());
 
-    int const n_points = trk->NumberTrajectoryPoints();
+    int const n_points = points.size();
     for (int i = 0; i < n_points; ++i) {
       auto const index = dir ? i : n_points - 1 - i;
-      auto const& pos = trk->LocationAtPoint(index);
+      auto const& pos = points[index];
       recoX.push_back(pos.X());
       recoY.push_back(pos.Y());
       recoZ.push_back(pos.Z());
@@ -357,9 +469,6 @@ namespace trkf {
     if (recoX.size() < 2)
       return -1.0;
 
-    if (!plotRecoTracks_(recoX, recoY, recoZ))
-      return -1.0;
-
     constexpr double seg_size{5.0};
     auto const segments = getSegTracks_(recoX, recoY, recoZ, seg_size);
     if (!segments.has_value())
@@ -416,9 +525,9 @@ namespace trkf {
       double const dy = segny.at(i);
       double const dz = segnz.at(i);
 
-      TVector3 const vec_z{dx, dy, dz};
-      TVector3 vec_x;
-      TVector3 vec_y;
+      Vector3 const vec_z{dx, dy, dz};
+      Vector3 vec_x;
+      Vector3 vec_y;
 
       double const switcher = basex.Dot(vec_z);
       if (std::abs(switcher) <= 0.995) {
@@ -431,10 +540,6 @@ namespace trkf {
         vec_x = vec_y.Cross(vec_z);
       }
 
-      TVector3 const Rx{vec_x.Dot(basex), vec_x.Dot(basey), vec_x.Dot(basez)};
-      TVector3 const Ry{vec_y.Dot(basex), vec_y.Dot(basey), vec_y.Dot(basez)};
-      TVector3 const Rz{vec_z.Dot(basex), vec_z.Dot(basey), vec_z.Dot(basez)};
-
       double const refL = segL.at(i);
 
       for (int j = i; j < tot; j++) {
@@ -449,13 +554,11 @@ namespace trkf {
           double const here_dy = segny.at(j);
           double const here_dz = segnz.at(j);
 
-          TVector3 const here_vec{here_dx, here_dy, here_dz};
-          TVector3 const rot_here{
-            Rx.Dot(here_vec), Ry.Dot(here_vec), Rz.Dot(here_vec)};
-
-          double const scx = rot_here.X();
-          double const scy = rot_here.Y();
-          double const scz = rot_here.Z();
+          // components in the frame (vec_x, vec_y, vec_z) of segment i
+          Vector3 const here_vec{here_dx, here_dy, here_dz};
+          double const scx = vec_x.Dot(here_vec);
+          double const scy = vec_y.Dot(here_vec);
+          double const scz = vec_z.Dot(here_vec);
 
           double const azy = find_angle(scz, scy);
           double const azx = find_angle(scz, scx);
@@ -491,16 +594,23 @@ namespace trkf {
 
   double
   TrackMomentumCalculator::GetMomentumMultiScatterChi2(
-    const art::Ptr<recob::Track>& trk)
+    const art::Ptr<recob::Track>& trk) const
+  {
+    return GetMomentumMultiScatterChi2(trackPoints(*trk));
+  }
+
+  double
+  TrackMomentumCalculator::GetMomentumMultiScatterChi2(
+    std::vector<Point_t> const& points) const
   {
     std::vector<float> recoX;
     std::vector<float> recoY;
     std::vector<float> recoZ;
+    recoX.reserve(points.size());
+    recoY.reserve(points.size());
+    recoZ.reserve(points.size());
 
-    int n_points = trk->NumberTrajectoryPoints();
-
-    for (int i = 0; i < n_points; i++) {
-      auto const& pos = trk->LocationAtPoint(i);
+    for (auto const& pos : points) {
       recoX.push_back(pos.X());
       recoY.push_back(pos.Y());
       recoZ.push_back(pos.Z());
@@ -509,9 +619,6 @@ namespace trkf {
     if (recoX.size() < 2)
       return -1.0;
 
-    if (!plotRecoTracks_(recoX, recoY, recoZ))
-      return -1.0;
-
     double const seg_size{steps_size};
     auto const segments = getSegTracks_(recoX, recoY, recoZ, seg_size);
     if (!segments.has_value())
@@ -525,9 +632,6 @@ namespace trkf {
     if (recoL < minLength || recoL > maxLength)
       return -1;
 
-    double ymax = -999.0;
-    double ymin = +999.0;
-
     std::vector<double> xmeas;
     std::vector<double> ymeas;
     std::vector<double> eymeas;
@@ -554,11 +658,6 @@ namespace trkf {
       xmeas.push_back(trial); // Is this what is intended?
       ymeas.push_back(rms);
       eymeas.push_back(std::sqrt(cet::sum_of_squares(rmse, 0.05 * rms))); // <--- conservative syst. error to fix chi^{2} behaviour !!!
-
-      if (ymin > rms)
-        ymin = rms;
-      if (ymax < rms)
-        ymax = rms;
     }
 
     assert(xmeas.size() == ymeas.size());
@@ -567,24 +666,18 @@ namespace trkf {
       return -1.0;
     }
 
-    TGraphErrors gr_meas{n_steps, xmeas.data(), ymeas.data(), nullptr, eymeas.data()};
-
-    gr_meas.SetTitle("(#Delta#theta)_{rms} versus material thickness; Material "
-                     "thickness in cm; (#Delta#theta)_{rms} in mrad");
-
-    gr_meas.SetLineColor(kBlack);
-    gr_meas.SetMarkerColor(kBlack);
-    gr_meas.SetMarkerStyle(20);
-    gr_meas.SetMarkerSize(1.2);
+    FcnWrapper const wrapper{move(xmeas), move(ymeas), move(eymeas)};
+    bool const valid = wrapper.valid();
+    if (!valid)
+      mf::LogWarning("TrackMomentumCalculator") << "Zero denominator in my_mcs_chi2";
 
-    gr_meas.GetXaxis()->SetLimits(steps.at(0) - steps.at(0),
-                                  steps.at(n_steps - 1) + steps.at(0));
-    gr_meas.SetMinimum(0.0);
-    gr_meas.SetMaximum(1.80 * ymax);
+    double const deltap = (recoL * kcal) / 2.0;
 
+    // A zero error made every call of the function return -1, and so does it here
     ROOT::Minuit2::Minuit2Minimizer mP{};
-    FcnWrapper const wrapper{move(xmeas), move(ymeas), move(eymeas)};
-    ROOT::Math::Functor FCA([&wrapper](double const* xs) { return wrapper.my_mcs_chi2(xs); }, 2);
+    ROOT::Math::Functor FCA(
+      [&wrapper, valid](double const* xs) { return valid ? wrapper.my_mcs_chi2(xs[0], xs[1]) : -1.; },
+      2);
 
     mP.SetFunction(FCA);
     mP.SetLimitedVariable(0, "p_{MCS}", 1.0, 0.01, 0.001, 7.5);
@@ -600,52 +693,16 @@ namespace trkf {
     mP.Hesse();
 
     const double* pars = mP.X();
-    const double* erpars = mP.Errors();
-
-    double const deltap = (recoL * kcal) / 2.0;
 
     double const p_mcs = pars[0] + deltap;
-    double const p_mcs_e [[maybe_unused]] = erpars[0];
     return mstatus ? p_mcs : -1.0;
   }
 
-  bool
-  TrackMomentumCalculator::plotRecoTracks_(std::vector<float> const& xxx,
-                                           std::vector<float> const& yyy,
-                                           std::vector<float> const& zzz)
-  {
-    auto const n = xxx.size();
-    auto const y_size = yyy.size();
-    auto const z_size = zzz.size();
-
-    if (n != y_size || n != z_size) {
-      cout << " ( Get reco tacks ) Error ! " << endl;
-      return false;
-    }
-
-    // Here, we perform a const-cast to float* because, sadly,
-    // TPolyLine3D requires a pointer to a non-const object.  We will
-    // trust that ROOT does not mess around with the underlying data.
-    auto xs = const_cast<float*>(xxx.data());
-    auto ys = const_cast<float*>(yyy.data());
-    auto zs = const_cast<float*>(zzz.data());
-
-    auto const narrowed_size =
-      static_cast<int>(n); // ROOT requires a signed integral type
-    delete gr_reco_xyz;
-    gr_reco_xyz = new TPolyLine3D{narrowed_size, zs, xs, ys};
-    gr_reco_yz = TGraph{narrowed_size, zzz.data(), yyy.data()};
-    gr_reco_xz = TGraph{narrowed_size, zzz.data(), xxx.data()};
-    gr_reco_xy = TGraph{narrowed_size, xxx.data(), yyy.data()};
-
-    return true;
-  }
-
   std::optional<TrackMomentumCalculator::Segments>
   TrackMomentumCalculator::getSegTracks_(std::vector<float> const& xxx,
                                          std::vector<float> const& yyy,
                                          std::vector<float> const& zzz,
-                                         double const seg_size)
+                                         double const seg_size) const
   {
     double stag = 0.0;
 
@@ -667,7 +724,7 @@ namespace trkf {
 
     int ntot = 0;
 
-    n_seg = 0;
+    int n_seg = 0;
 
     double x0{};
     double y0{};
@@ -698,10 +755,6 @@ namespace trkf {
 
         segL.push_back(stag);
 
-        x_seg[n_seg] = x0;
-        y_seg[n_seg] = y0;
-        z_seg[n_seg] = z0;
-
         n_seg++;
 
         vx.push_back(x0);
@@ -772,9 +825,6 @@ namespace trkf {
 
         segL.push_back(1.0 * n_seg * 1.0 * seg_size + stag);
 
-        x_seg[n_seg] = xp;
-        y_seg[n_seg] = yp;
-        z_seg[n_seg] = zp;
         n_seg++;
 
         x0 = xp;
@@ -787,74 +837,10 @@ namespace trkf {
 
         ntot++;
 
-        auto const na = vx.size();
-        double sumx = 0.0;
-        double sumy = 0.0;
-        double sumz = 0.0;
-
-        for (std::size_t i = 0; i < na; ++i) {
-          sumx += vx.at(i);
-          sumy += vy.at(i);
-          sumz += vz.at(i);
-        }
-
-        sumx /= na;
-        sumy /= na;
-        sumz /= na;
-
-        std::vector<double> mx;
-        std::vector<double> my;
-        std::vector<double> mz;
-
-        TMatrixDSym m(3);
-
-        for (std::size_t i = 0; i < na; ++i) {
-          double const xxw1 = vx.at(i);
-          double const yyw1 = vy.at(i);
-          double const zzw1 = vz.at(i);
-
-          mx.push_back(xxw1 - sumx);
-          my.push_back(yyw1 - sumy);
-          mz.push_back(zzw1 - sumz);
-
-          double const xxw0 = mx.at(i);
-          double const yyw0 = my.at(i);
-          double const zzw0 = mz.at(i);
-
-          m(0, 0) += xxw0 * xxw0 / na;
-          m(0, 1) += xxw0 * yyw0 / na;
-          m(0, 2) += xxw0 * zzw0 / na;
-
-          m(1, 0) += yyw0 * xxw0 / na;
-          m(1, 1) += yyw0 * yyw0 / na;
-          m(1, 2) += yyw0 * zzw0 / na;
-
-          m(2, 0) += zzw0 * xxw0 / na;
-          m(2, 1) += zzw0 * yyw0 / na;
-          m(2, 2) += zzw0 * zzw0 / na;
-        }
-
-        TMatrixDSymEigen me(m);
-
-        TVectorD eigenval = me.GetEigenValues();
-        TMatrixD eigenvec = me.GetEigenVectors();
-
-        double max1 = -666.0;
-
-        double ind1 = 0;
-
-        for (int i = 0; i < 3; ++i) {
-          double const p1 = eigenval(i);
-
-          if (p1 > max1) {
-            max1 = p1;
-            ind1 = i;
-          }
-        }
-
-        double ax = eigenvec(0, ind1);
-        double ay = eigenvec(1, ind1);
-        double az = eigenvec(2, ind1);
+        auto const axis = principalAxis(vx, vy, vz);
+        double ax = axis[0];
+        double ay = axis[1];
+        double az = axis[2];
 
         if (n_seg > 1) {
           if (segx.at(n_seg - 1) - segx.at(n_seg - 2) > 0)
@@ -912,9 +898,6 @@ namespace trkf {
         segz.push_back(zp);
         segL.push_back(1.0 * n_seg * 1.0 * seg_size + stag);
 
-        x_seg[n_seg] = xp;
-        y_seg[n_seg] = yp;
-        z_seg[n_seg] = zp;
         n_seg++;
 
         x0 = xp;
@@ -929,74 +912,10 @@ namespace trkf {
 
         ntot++;
 
-        double na = vx.size();
-
-        double sumx = 0.0;
-        double sumy = 0.0;
-        double sumz = 0.0;
-
-        for (std::size_t i = 0; i < na; ++i) {
-          sumx += vx.at(i);
-          sumy += vy.at(i);
-          sumz += vz.at(i);
-        }
-
-        sumx /= na;
-        sumy /= na;
-        sumz /= na;
-
-        std::vector<double> mx;
-        std::vector<double> my;
-        std::vector<double> mz;
-
-        TMatrixDSym m(3);
-
-        for (int i = 0; i < na; ++i) {
-          double const xxw1 = vx.at(i);
-          double const yyw1 = vy.at(i);
-          double const zzw1 = vz.at(i);
-
-          mx.push_back(xxw1 - sumx);
-          my.push_back(yyw1 - sumy);
-          mz.push_back(zzw1 - sumz);
-
-          double const xxw0 = mx.at(i);
-          double const yyw0 = my.at(i);
-          double const zzw0 = mz.at(i);
-
-          m(0, 0) += xxw0 * xxw0 / na;
-          m(0, 1) += xxw0 * yyw0 / na;
-          m(0, 2) += xxw0 * zzw0 / na;
-
-          m(1, 0) += yyw0 * xxw0 / na;
-          m(1, 1) += yyw0 * yyw0 / na;
-          m(1, 2) += yyw0 * zzw0 / na;
-
-          m(2, 0) += zzw0 * xxw0 / na;
-          m(2, 1) += zzw0 * yyw0 / na;
-          m(2, 2) += zzw0 * zzw0 / na;
-        }
-
-        TMatrixDSymEigen me(m);
-
-        TVectorD eigenval = me.GetEigenValues();
-        TMatrixD eigenvec = me.GetEigenVectors();
-
-        double max1 = -666.0;
-        double ind1 = 0;
-
-        for (int i = 0; i < 3; ++i) {
-          double const p1 = eigenval(i);
-
-          if (p1 > max1) {
-            max1 = p1;
-            ind1 = i;
-          }
-        }
-
-        double ax = eigenvec(0, ind1);
-        double ay = eigenvec(1, ind1);
-        double az = eigenvec(2, ind1);
+        auto const axis = principalAxis(vx, vy, vz);
+        double ax = axis[0];
+        double ay = axis[1];
+        double az = axis[2];
 
         if (n_seg > 1) {
           if (segx.at(n_seg - 1) - segx.at(n_seg - 2) > 0)
@@ -1039,12 +958,6 @@ namespace trkf {
         break;
     }
 
-    delete gr_seg_xyz;
-    gr_seg_xyz = new TPolyLine3D{n_seg, z_seg, x_seg, y_seg};
-    gr_seg_yz = TGraph{n_seg, z_seg, y_seg};
-    gr_seg_xz = TGraph{n_seg, z_seg, x_seg};
-    gr_seg_xy = TGraph{n_seg, x_seg, y_seg};
-
     return std::make_optional<Segments>(Segments{segx, segnx, segy, segny, segz, segnz, segL});
   }
 
@@ -1077,9 +990,9 @@ namespace trkf {
       double const dy = segny.at(i);
       double const dz = segnz.at(i);
 
-      TVector3 const vec_z{dx, dy, dz};
-      TVector3 vec_x;
-      TVector3 vec_y;
+      Vector3 const vec_z{dx, dy, dz};
+      Vector3 vec_x;
+      Vector3 vec_y;
 
       double const switcher = basex.Dot(vec_z);
 
@@ -1093,10 +1006,6 @@ namespace trkf {
         vec_x = vec_y.Cross(vec_z);
       }
 
-      TVector3 const Rx{vec_x.Dot(basex), vec_x.Dot(basey), vec_x.Dot(basez)};
-      TVector3 const Ry{vec_y.Dot(basex), vec_y.Dot(basey), vec_y.Dot(basez)};
-      TVector3 const Rz{vec_z.Dot(basex), vec_z.Dot(basey), vec_z.Dot(basez)};
-
       double const refL = segL.at(i);
 
       for (int j = i; j < tot; j++) {
@@ -1111,12 +1020,11 @@ namespace trkf {
           double const here_dy = segny.at(j);
           double const here_dz = segnz.at(j);
 
-          TVector3 const here_vec{here_dx, here_dy, here_dz};
-          TVector3 const rot_here{Rx.Dot(here_vec), Ry.Dot(here_vec), Rz.Dot(here_vec)};
-
-          double const scx = rot_here.X();
-          double const scy = rot_here.Y();
-          double const scz = rot_here.Z();
+          // components in the frame (vec_x, vec_y, vec_z) of segment i
+          Vector3 const here_vec{here_dx, here_dy, here_dz};
+          double const scx = vec_x.Dot(here_vec);
+          double const scy = vec_y.Dot(here_vec);
+          double const scz = vec_z.Dot(here_vec);
 
           double azy = find_angle(scz, scy);
           azy *= 1.0;
@@ -1189,31 +1097,31 @@ namespace trkf {
     else if (vz < 0 && vy > 0) {
       double ratio = std::abs(vy / vz);
       thetayz = std::atan(ratio);
-      thetayz = TMath::Pi() - thetayz;
+      thetayz = M_PI - thetayz;
     }
 
     else if (vz < 0 && vy < 0) {
       double ratio = std::abs(vy / vz);
       thetayz = std::atan(ratio);
-      thetayz = thetayz + TMath::Pi();
+      thetayz = thetayz + M_PI;
     }
 
     else if (vz > 0 && vy < 0) {
       double ratio = std::abs(vy / vz);
       thetayz = std::atan(ratio);
-      thetayz = 2.0 * TMath::Pi() - thetayz;
+      thetayz = 2.0 * M_PI - thetayz;
     }
 
     else if (vz == 0 && vy > 0) {
-      thetayz = TMath::Pi() / 2.0;
+      thetayz = M_PI / 2.0;
     }
 
     else if (vz == 0 && vy < 0) {
-      thetayz = 3.0 * TMath::Pi() / 2.0;
+      thetayz = 3.0 * M_PI / 2.0;
     }
 
-    if (thetayz > TMath::Pi()) {
-      thetayz = thetayz - 2.0 * TMath::Pi();
+    if (thetayz > M_PI) {
+      thetayz = thetayz - 2.0 * M_PI;
     }
 
     return 1000.0 * thetayz;
@@ -1229,7 +1137,7 @@ namespace trkf {
 
     double const arg = (xx - Q) / s;
     double const result =
-        -0.5 * std::log(2.0 * TMath::Pi()) - std::log(s) - 0.5 * arg * arg;
+        -0.5 * std::log(2.0 * M_PI) - std::log(s) - 0.5 * arg * arg;
 
     if (std::isnan(result) || std::isinf(result)) {
       cout << " Is nan ! my_g ! " << -std::log(s) << ", " << s << endl;
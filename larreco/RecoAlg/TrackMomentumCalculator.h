@@ -5,36 +5,49 @@
 #define TrackMomentumCalculator_H
 
 #include "canvas/Persistency/Common/Ptr.h"
-#include "larcorealg/CoreUtils/quiet_Math_Functor.h"
 #include "lardataobj/RecoBase/Track.h"
 
-#include "TGraph.h"
 #include "TVector3.h"
 
 #include <optional>
 #include <vector>
 #include <tuple>
 
-class TPolyLine3D;
-
 namespace trkf {
 
+  /// The multiple Coulomb scattering (MCS) estimates only use the trajectory
+  /// points they are given and local buffers, so that one calculator can be
+  /// shared by concurrent callers.
+  ///
+  /// The TGraph and TPolyLine3D data members that held the points of the last
+  /// track (gr_reco_xy, gr_seg_xz, ...) have been removed: they were private,
+  /// and never drawn nor saved.
   class TrackMomentumCalculator {
   public:
+    using Point_t = recob::tracking::Point_t;
+
     TrackMomentumCalculator(double minLength = 100.0,
                             double maxLength = 1350.0);
 
     double GetTrackMomentum(double trkrange, int pdg) const;
-    double GetMomentumMultiScatterChi2(art::Ptr<recob::Track> const& trk);
-    double GetMomentumMultiScatterLLHD(art::Ptr<recob::Track> const& trk);
-    double GetMuMultiScatterLLHD3(art::Ptr<recob::Track> const& trk, bool dir);
-    TVector3 GetMultiScatterStartingPoint(art::Ptr<recob::Track> const& trk);
+    double GetMomentumMultiScatterChi2(art::Ptr<recob::Track> const& trk) const;
+    double GetMomentumMultiScatterLLHD(art::Ptr<recob::Track> const& trk) const;
+    double GetMuMultiScatterLLHD3(art::Ptr<recob::Track> const& trk, bool dir) const;
+    TVector3 GetMultiScatterStartingPoint(art::Ptr<recob::Track> const& trk) const;
 
-  private:
-    bool plotRecoTracks_(std::vector<float> const& xxx,
-                         std::vector<float> const& yyy,
-                         std::vector<float> const& zzz);
+    /// MCS momentum [GeV/c] of the trajectory `points`, from a chi2 fit of
+    /// the RMS of the scattering angles; -1 if it can't be measured.
+    double GetMomentumMultiScatterChi2(std::vector<Point_t> const& points) const;
+
+    /// MCS momentum [GeV/c] of the trajectory `points` maximizing the
+    /// likelihood of the scattering angles; -1 if it can't be measured.
+    double GetMomentumMultiScatterLLHD(std::vector<Point_t> const& points) const;
 
+    /// -2 log likelihood of the scattering angles of `points`, walked forward
+    /// if `dir` is true and backward otherwise, for the momentum from range.
+    double GetMuMultiScatterLLHD3(std::vector<Point_t> const& points, bool dir) const;
+
+  private:
     struct Segments {
       std::vector<float> x, nx;
       std::vector<float> y, ny;
@@ -45,7 +58,7 @@ namespace trkf {
     std::optional<Segments> getSegTracks_(std::vector<float> const& xxx,
                                           std::vector<float> const& yyy,
                                           std::vector<float> const& zzz,
-                                          double seg_size);
+                                          double seg_size) const;
 
     std::tuple<double, double, double> getDeltaThetaRMS_(Segments const& segments,
                                                          double thick) const;
@@ -66,11 +79,6 @@ namespace trkf {
                        double x0, double x1) const;
 
     float seg_stop{-1.};
-    int n_seg{};
-
-    float x_seg[50000];
-    float y_seg[50000];
-    float z_seg[50000];
 
     double find_angle(double vz, double vy) const;
 
@@ -81,26 +89,6 @@ namespace trkf {
     double minLength;
     double maxLength;
 
-    // The following are objects that are created but not drawn or
-    // saved.  This class should consider accepting a "debug"
-    // parameter where if it is specified, then the graphs will be
-    // created; otherwise, their creation is unnecessary and impedes
-    // efficiency.
-    //
-    // N.B. TPolyLine3D objects are owned by ROOT, and we thus refer
-    // to them by pointer.  It is important that 'delete' is not
-    // called on the TPolyLine3D pointers during destruction of a
-    // TrackMomentumCalculator object.
-    TPolyLine3D* gr_reco_xyz{nullptr};
-    TGraph gr_reco_xy{};
-    TGraph gr_reco_yz{};
-    TGraph gr_reco_xz{};
-
-    TPolyLine3D* gr_seg_xyz{nullptr};
-    TGraph gr_seg_xy{};
-    TGraph gr_seg_yz{};
-    TGraph gr_seg_xz{};
-
   };
 
 } // namespace trkf
@@ -20,6 +20,9 @@
 
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
 namespace tca {
 
   //------------------------------------------------------------------------------
@@ -27,94 +30,98 @@ namespace tca {
   TrajClusterAlg::TrajClusterAlg(fhicl::ParameterSet const& pset)
     : fCaloAlg(pset.get<fhicl::ParameterSet>("CaloAlg")), fMVAReader("Silent")
   {
-    tcc.showerParentReader = &fMVAReader;
+    fConfig.showerParentReader = &fMVAReader;
 
     bool badinput = false;
     // set all configurable modes false
-    tcc.modes.reset();
+    fConfig.modes.reset();
 
     // default mode is stepping US -> DS
-    tcc.modes[kStepDir] = true;
+    fConfig.modes[kStepDir] = true;
     short userMode = 1;
     if (pset.has_key("Mode")) userMode = pset.get<short>("Mode");
-    if (userMode < 0) tcc.modes[kStepDir] = false;
-    if (pset.has_key("DoForecast")) tcc.doForecast = pset.get<bool>("DoForecast");
-    if (pset.has_key("UseChannelStatus")) tcc.useChannelStatus = pset.get<bool>("UseChannelStatus");
+    if (userMode < 0) fConfig.modes[kStepDir] = false;
+    if (pset.has_key("DoForecast")) fConfig.doForecast = pset.get<bool>("DoForecast");
+    if (pset.has_key("UseChannelStatus"))
+      fConfig.useChannelStatus = pset.get<bool>("UseChannelStatus");
     if (pset.has_key("StudyMode")) {
       std::cout << "StudyMode is not valid anymore. Try Study: 1 or Study: 2, etc/n";
     } // old StudyMode
     if (pset.has_key("Study")) {
       userMode = pset.get<short>("Study");
-      if (userMode == 1) tcc.modes[kStudy1] = true;
-      if (userMode == 2) tcc.modes[kStudy2] = true;
-      if (userMode == 3) tcc.modes[kStudy3] = true;
-      if (userMode == 4) tcc.modes[kStudy4] = true;
+      if (userMode == 1) fConfig.modes[kStudy1] = true;
+      if (userMode == 2) fConfig.modes[kStudy2] = true;
+      if (userMode == 3) fConfig.modes[kStudy3] = true;
+      if (userMode == 4) fConfig.modes[kStudy4] = true;
     } // new Study mode
     if (pset.has_key("SaveShowerTree"))
-      tcc.modes[kSaveShowerTree] = pset.get<bool>("SaveShowerTree");
-    if (pset.has_key("SaveCRTree")) tcc.modes[kSaveCRTree] = pset.get<bool>("SaveCRTree");
-    if (pset.has_key("TagCosmics")) tcc.modes[kTagCosmics] = pset.get<bool>("TagCosmics");
+      fConfig.modes[kSaveShowerTree] = pset.get<bool>("SaveShowerTree");
+    if (pset.has_key("SaveCRTree")) fConfig.modes[kSaveCRTree] = pset.get<bool>("SaveCRTree");
+    if (pset.has_key("TagCosmics")) fConfig.modes[kTagCosmics] = pset.get<bool>("TagCosmics");
     std::vector<std::string> skipAlgsVec;
     if (pset.has_key("SkipAlgs")) skipAlgsVec = pset.get<std::vector<std::string>>("SkipAlgs");
     std::vector<std::string> debugConfigVec;
     if (pset.has_key("DebugConfig"))
       debugConfigVec = pset.get<std::vector<std::string>>("DebugConfig");
 
-    tcc.hitErrFac = pset.get<float>("HitErrFac", 0.4);
+    fRunParallel = pset.get<bool>("RunParallel", false);
+    fCheckParallel = pset.get<bool>("CheckParallel", false);
+    fConfig.hitErrFac = pset.get<float>("HitErrFac", 0.4);
     // Allow the user to specify the typical hit rms for small-angle tracks
     std::vector<float> aveHitRMS;
     if (pset.has_key("AveHitRMS")) aveHitRMS = pset.get<std::vector<float>>("AveHitRMS");
     // Turn off the call to AnalyzeHits
     if (!aveHitRMS.empty()) {
-      evt.aveHitRMSValid = true;
-      evt.aveHitRMS = aveHitRMS;
+      fEvent.aveHitRMSValid = true;
+      fEvent.aveHitRMS = aveHitRMS;
     }
-    tcc.angleRanges = pset.get<std::vector<float>>("AngleRanges");
-    tcc.nPtsAve = pset.get<short>("NPtsAve", 20);
-    tcc.minPtsFit = pset.get<std::vector<unsigned short>>("MinPtsFit");
-    tcc.minPts = pset.get<std::vector<unsigned short>>("MinPts");
-    tcc.maxAngleCode = pset.get<std::vector<unsigned short>>("MaxAngleCode");
-    tcc.minMCSMom = pset.get<std::vector<short>>("MinMCSMom");
-    tcc.maxChi = pset.get<float>("MaxChi", 10);
-    tcc.chargeCuts = pset.get<std::vector<float>>("ChargeCuts", {3, 0.15, 0.25});
-    tcc.multHitSep = pset.get<float>("MultHitSep", 2.5);
-    tcc.kinkCuts = pset.get<std::vector<float>>("KinkCuts");
-    tcc.qualityCuts = pset.get<std::vector<float>>("QualityCuts", {0.8, 3});
-    tcc.maxWireSkipNoSignal = pset.get<float>("MaxWireSkipNoSignal", 1);
-    tcc.maxWireSkipWithSignal = pset.get<float>("MaxWireSkipWithSignal", 100);
-    tcc.projectionErrFactor = pset.get<float>("ProjectionErrFactor", 2);
-    tcc.VLAStepSize = pset.get<float>("VLAStepSize", 1.5);
-    tcc.JTMaxHitSep2 = pset.get<float>("JTMaxHitSep", 2);
-    tcc.deltaRayTag = pset.get<std::vector<short>>("DeltaRayTag", {-1, -1, -1});
-    tcc.muonTag = pset.get<std::vector<short>>("MuonTag", {-1, -1, -1, -1});
-    if (pset.has_key("ElectronTag")) tcc.electronTag = pset.get<std::vector<float>>("ElectronTag");
-    tcc.showerTag = pset.get<std::vector<float>>("ShowerTag", {-1, -1, -1, -1, -1, -1});
+    fConfig.angleRanges = pset.get<std::vector<float>>("AngleRanges");
+    fConfig.nPtsAve = pset.get<short>("NPtsAve", 20);
+    fConfig.minPtsFit = pset.get<std::vector<unsigned short>>("MinPtsFit");
+    fConfig.minPts = pset.get<std::vector<unsigned short>>("MinPts");
+    fConfig.maxAngleCode = pset.get<std::vector<unsigned short>>("MaxAngleCode");
+    fConfig.minMCSMom = pset.get<std::vector<short>>("MinMCSMom");
+    fConfig.maxChi = pset.get<float>("MaxChi", 10);
+    fConfig.chargeCuts = pset.get<std::vector<float>>("ChargeCuts", {3, 0.15, 0.25});
+    fConfig.multHitSep = pset.get<float>("MultHitSep", 2.5);
+    fConfig.kinkCuts = pset.get<std::vector<float>>("KinkCuts");
+    fConfig.qualityCuts = pset.get<std::vector<float>>("QualityCuts", {0.8, 3});
+    fConfig.maxWireSkipNoSignal = pset.get<float>("MaxWireSkipNoSignal", 1);
+    fConfig.maxWireSkipWithSignal = pset.get<float>("MaxWireSkipWithSignal", 100);
+    fConfig.projectionErrFactor = pset.get<float>("ProjectionErrFactor", 2);
+    fConfig.VLAStepSize = pset.get<float>("VLAStepSize", 1.5);
+    fConfig.JTMaxHitSep2 = pset.get<float>("JTMaxHitSep", 2);
+    fConfig.deltaRayTag = pset.get<std::vector<short>>("DeltaRayTag", {-1, -1, -1});
+    fConfig.muonTag = pset.get<std::vector<short>>("MuonTag", {-1, -1, -1, -1});
+    if (pset.has_key("ElectronTag"))
+      fConfig.electronTag = pset.get<std::vector<float>>("ElectronTag");
+    fConfig.showerTag = pset.get<std::vector<float>>("ShowerTag", {-1, -1, -1, -1, -1, -1});
     std::string fMVAShowerParentWeights = "NA";
     pset.get_if_present<std::string>("MVAShowerParentWeights", fMVAShowerParentWeights);
-    tcc.chkStopCuts = pset.get<std::vector<float>>("ChkStopCuts", {-1, -1, -1});
+    fConfig.chkStopCuts = pset.get<std::vector<float>>("ChkStopCuts", {-1, -1, -1});
     if (pset.has_key("MatchTruth")) {
       std::cout << "MatchTruth is not used. Use ClusterAnaV2 or DebugConfig to configure\n";
     }
-    tcc.vtx2DCuts = pset.get<std::vector<float>>("Vertex2DCuts", {-1, -1, -1, -1, -1, -1, -1});
-    tcc.vtx3DCuts = pset.get<std::vector<float>>("Vertex3DCuts", {-1, -1});
-    tcc.vtxScoreWeights = pset.get<std::vector<float>>("VertexScoreWeights");
-    tcc.match3DCuts = pset.get<std::vector<float>>("Match3DCuts", {-1, -1, -1, -1, -1});
-    tcc.pfpStitchCuts = pset.get<std::vector<float>>("PFPStitchCuts", {-1});
+    fConfig.vtx2DCuts = pset.get<std::vector<float>>("Vertex2DCuts", {-1, -1, -1, -1, -1, -1, -1});
+    fConfig.vtx3DCuts = pset.get<std::vector<float>>("Vertex3DCuts", {-1, -1});
+    fConfig.vtxScoreWeights = pset.get<std::vector<float>>("VertexScoreWeights");
+    fConfig.match3DCuts = pset.get<std::vector<float>>("Match3DCuts", {-1, -1, -1, -1, -1});
+    fConfig.pfpStitchCuts = pset.get<std::vector<float>>("PFPStitchCuts", {-1});
     // don't search for a neutrino vertex in test beam mode
-    tcc.modes[kTestBeam] = pset.get<bool>("TestBeam", false);
-    pset.get_if_present<std::vector<float>>("NeutralVxCuts", tcc.neutralVxCuts);
-    if (tcc.JTMaxHitSep2 > 0) tcc.JTMaxHitSep2 *= tcc.JTMaxHitSep2;
+    fConfig.modes[kTestBeam] = pset.get<bool>("TestBeam", false);
+    pset.get_if_present<std::vector<float>>("NeutralVxCuts", fConfig.neutralVxCuts);
+    if (fConfig.JTMaxHitSep2 > 0) fConfig.JTMaxHitSep2 *= fConfig.JTMaxHitSep2;
 
     // in the following section we ensure that the fcl vectors are appropriately sized so that later references are valid
-    if (tcc.minPtsFit.size() != tcc.minPts.size()) badinput = true;
-    if (tcc.maxAngleCode.size() != tcc.minPts.size()) badinput = true;
-    if (tcc.minMCSMom.size() != tcc.minPts.size()) badinput = true;
+    if (fConfig.minPtsFit.size() != fConfig.minPts.size()) badinput = true;
+    if (fConfig.maxAngleCode.size() != fConfig.minPts.size()) badinput = true;
+    if (fConfig.minMCSMom.size() != fConfig.minPts.size()) badinput = true;
     if (badinput)
       throw art::Exception(art::errors::Configuration)
         << "Bad input from fcl file. Vector lengths for MinPtsFit, MaxAngleRange and MinMCSMom "
            "should be defined for each reconstruction pass";
 
-    if (tcc.vtx2DCuts.size() < 10)
+    if (fConfig.vtx2DCuts.size() < 10)
       throw art::Exception(art::errors::Configuration)
         << "Vertex2DCuts must be size 11\n 0 = Max length definition for short TJs\n 1 = Max "
            "vtx-TJ sep short TJs\n 2 = Max vtx-TJ sep long TJs\n 3 = Max position pull for >2 "
@@ -122,21 +129,21 @@ namespace tca {
            "fraction of wires hit btw vtx and Tjs\n 7 = Min Score\n 8 = min ChgFrac at a vtx or "
            "merge point\n 9 = max MCSMom asymmetry, 10 = require chg on wires btw vtx and tjs in "
            "induction planes?";
-    if (tcc.vtx2DCuts.size() == 10) {
+    if (fConfig.vtx2DCuts.size() == 10) {
       // User didn't specify a requirement for the presence of charge between a vertex and the start of the
       // vertex Tjs in induction planes. Assume that it is required
-      tcc.vtx2DCuts.resize(11, 1.);
+      fConfig.vtx2DCuts.resize(11, 1.);
     }
-    if (tcc.vtx3DCuts.size() < 3)
+    if (fConfig.vtx3DCuts.size() < 3)
       throw art::Exception(art::errors::Configuration)
         << "Vertex3DCuts must be size > 2\n 0 = 2D Vtx max dX (cm)\n 1 = 2D Vtx max pull\n 2 = max "
            "3D separation (cm) btw PFP and vertex";
-    if (tcc.vtx3DCuts.size() == 2) {
+    if (fConfig.vtx3DCuts.size() == 2) {
       std::cout << "WARNING: Vertex3DCuts is size 2 but should be size 3, where Vertex3DCuts[2] = "
                    "max 3D separation (cm) btw a PFP and a 3D vertex. Setting it to 3 cm\n";
-      tcc.vtx3DCuts.resize(3, 3.);
+      fConfig.vtx3DCuts.resize(3, 3.);
     }
-    if (tcc.kinkCuts.size() < 4) {
+    if (fConfig.kinkCuts.size() < 4) {
       throw art::Exception(art::errors::Configuration)
         << "KinkCuts must be size 3\n 0 = Number of points to fit at the end of the trajectory\n 1 "
            "= Minimum kink significance\n 2 = Use charge in significance calculation? (yes if > "
@@ -144,42 +151,42 @@ namespace tca {
     }
     // throw an exception if the user appears to be using an old version of KinkCuts where
     // KinkCuts[0] was a kink angle cut
-    if (tcc.kinkCuts[0] > 0 && tcc.kinkCuts[0] < 1.) {
+    if (fConfig.kinkCuts[0] > 0 && fConfig.kinkCuts[0] < 1.) {
       throw art::Exception(art::errors::Configuration)
         << "Are you using an out-of-date specification for KinkCuts? KinkCuts[0] is the number of "
            "points to fit.\n";
     }
 
-    if (tcc.chargeCuts.size() != 3)
+    if (fConfig.chargeCuts.size() != 3)
       throw art::Exception(art::errors::Configuration)
         << "ChargeCuts must be size 3\n 0 = Charge pull cut\n 1 = Min allowed fractional chg RMS\n "
            "2 = Max allowed fractional chg RMS";
     // dressed muons - change next line
-    if (tcc.muonTag.size() < 4)
+    if (fConfig.muonTag.size() < 4)
       throw art::Exception(art::errors::Configuration)
         << "MuonTag must be size 4\n 0 = minPtsFit\n 1 = minMCSMom\n 2= maxWireSkipNoSignal\n 3 = "
            "min delta ray length for tagging\n 4 = dress muon window size (optional)";
-    if (tcc.deltaRayTag.size() != 3)
+    if (fConfig.deltaRayTag.size() != 3)
       throw art::Exception(art::errors::Configuration)
         << "DeltaRayTag must be size 3\n 0 = Max endpoint sep\n 1 = min MCSMom\n 2 = max MCSMom";
-    if (tcc.chkStopCuts.size() < 3)
+    if (fConfig.chkStopCuts.size() < 3)
       throw art::Exception(art::errors::Configuration)
         << "ChkStopCuts must be size 3\n 0 = Min Charge ratio\n 1 = Charge slope pull cut\n 2 = "
            "Charge fit chisq cut\n 3 = BraggSplit FOM (optional)";
-    if (tcc.showerTag.size() < 13) {
+    if (fConfig.showerTag.size() < 13) {
       std::cout
         << "ShowerTag must be size 13\n 0 = Mode\n 1 = max MCSMom\n 2 = max separation (WSE "
            "units)\n 3 = Max angle diff\n 4 = Factor * rms width\n 5 = Min half width\n 6 = min "
            "total Tps\n 7 = Min Tjs\n 8 = max parent FOM\n 9 = max direction FOM 10 = max "
            "AspectRatio\n 11 = min Score to preserve a vertex\n 12 = Debug showers in CTP\n";
       std::cout << " Fixing this problem...";
-      tcc.showerTag.resize(13);
+      fConfig.showerTag.resize(13);
       // set the min score to 0
-      tcc.showerTag[11] = 0;
+      fConfig.showerTag[11] = 0;
       // turn off printing
-      tcc.showerTag[12] = -1;
+      fConfig.showerTag[12] = -1;
     }
-    if (tcc.match3DCuts.size() < 6)
+    if (fConfig.match3DCuts.size() < 6)
       throw art::Exception(art::errors::Configuration)
         << "Match3DCuts must be size 5\n 0 = dx (cm) matching cut\n 1 = max number of 3D "
            "combinations\n 2 = min length for 2-view match\n 3 = number of TP3Ds in each plane to "
@@ -187,44 +194,44 @@ namespace tca {
            "ChiDOF for a SectionFit";
 
     // check the angle ranges and convert from degrees to radians
-    if (tcc.angleRanges.back() < 90) {
+    if (fConfig.angleRanges.back() < 90) {
       mf::LogVerbatim("TC") << "Last element of AngleRange != 90 degrees. Fixing it\n";
-      tcc.angleRanges.back() = 90;
+      fConfig.angleRanges.back() = 90;
     }
 
     // convert PFP stitch cuts
-    if (tcc.pfpStitchCuts.size() > 1 && tcc.pfpStitchCuts[0] > 0) {
+    if (fConfig.pfpStitchCuts.size() > 1 && fConfig.pfpStitchCuts[0] > 0) {
       // square the separation cut
-      tcc.pfpStitchCuts[0] *= tcc.pfpStitchCuts[0];
+      fConfig.pfpStitchCuts[0] *= fConfig.pfpStitchCuts[0];
       // convert angle to cos
-      tcc.pfpStitchCuts[1] = cos(tcc.pfpStitchCuts[1]);
+      fConfig.pfpStitchCuts[1] = cos(fConfig.pfpStitchCuts[1]);
     }
 
     // configure algorithm debugging. Configuration for debugging standard stepping
     // is done in Utils/AnalyzeHits when the input hit collection is passed to SetInputHits
-    tcc.modes[kDebug] = false;
-    tcc.dbgAlg.reset();
+    fConfig.modes[kDebug] = false;
+    fConfig.dbgAlg.reset();
     for (auto strng : debugConfigVec) {
       // try to interpret this as a C:T:P:W:Tick specification or something similar
-      if (!DecodeDebugString(strng)) {
+      if (!DecodeDebugString(fConfig, strng)) {
         // try to set a dbgAlg bit
         for (unsigned short ib = 0; ib < AlgBitNames.size(); ++ib) {
           if (strng == AlgBitNames[ib]) {
-            tcc.dbgAlg[ib] = true;
-            tcc.modes[kDebug] = true;
+            fConfig.dbgAlg[ib] = true;
+            fConfig.modes[kDebug] = true;
             break;
           }
         } // ib
         // print some instructions and quit if there was a failure
-        if (!tcc.modes[kDebug]) {
+        if (!fConfig.modes[kDebug]) {
           std::cout << "DecodeDebugString failed: " << strng << "\n";
-          DecodeDebugString("instruct");
+          DecodeDebugString(fConfig, "instruct");
           exit(1);
         }
       } // DecodeDebugString failed
     }   // strng
 
-    for (auto& range : tcc.angleRanges) {
+    for (auto& range : fConfig.angleRanges) {
       if (range < 0 || range > 90)
         throw art::Exception(art::errors::Configuration)
           << "Invalid angle range " << range << " Must be 0 - 90 degrees";
@@ -250,24 +257,24 @@ namespace tca {
 
     bool printHelp = false;
     for (unsigned short ib = 0; ib < AlgBitNames.size(); ++ib)
-      tcc.useAlg[ib] = true;
+      fConfig.useAlg[ib] = true;
 
     // turn off the special algs
     // Do an exhaustive (and slow) check of the hit -> trajectory associations
-    tcc.useAlg[kChkInTraj] = false;
+    fConfig.useAlg[kChkInTraj] = false;
 
     for (auto strng : skipAlgsVec) {
       bool gotit = false;
       if (strng == "All") {
         // turn everything off
         for (unsigned short ib = 0; ib < AlgBitNames.size(); ++ib)
-          tcc.useAlg[ib] = false;
+          fConfig.useAlg[ib] = false;
         gotit = true;
         break;
       } // All off
       for (unsigned short ib = 0; ib < AlgBitNames.size(); ++ib) {
         if (strng == AlgBitNames[ib]) {
-          tcc.useAlg[ib] = false;
+          fConfig.useAlg[ib] = false;
           gotit = true;
           break;
         }
@@ -285,57 +292,51 @@ namespace tca {
       std::cout << "Or specify All to turn all algs off\n";
     }
     // Configure the TMVA reader for the shower parent BDT
-    if (fMVAShowerParentWeights != "NA" && tcc.showerTag[0] > 0)
-      ConfigureMVA(tcc, fMVAShowerParentWeights);
+    if (fMVAShowerParentWeights != "NA" && fConfig.showerTag[0] > 0)
+      ConfigureMVA(fConfig, fMVAShowerParentWeights);
 
-    evt.eventsProcessed = 0;
+    fEvent.eventsProcessed = 0;
 
-    tcc.caloAlg = &fCaloAlg;
+    fConfig.caloAlg = &fCaloAlg;
   }
 
   ////////////////////////////////////////////////
   bool
-  TrajClusterAlg::SetInputHits(std::vector<recob::Hit> const& inputHits,
+  TrajClusterAlg::SetInputHits(TCContext& tcx,
+                               std::vector<recob::Hit> const& inputHits,
                                unsigned int run,
                                unsigned int event)
   {
     // defines the pointer to the input hit collection, analyzes them,
     // initializes global counters and refreshes service references
-    ClearResults();
-    evt.allHits = &inputHits;
-    evt.run = run;
-    evt.event = event;
+    ClearResults(tcx);
+    tcx.evt.allHits = &inputHits;
+    tcx.evt.run = run;
+    tcx.evt.event = event;
     // refresh service references
-    tcc.geom = lar::providerFrom<geo::Geometry>();
-    evt.WorkID = 0;
-    evt.globalT_UID = 0;
-    evt.global2V_UID = 0;
-    evt.global3V_UID = 0;
-    evt.globalP_UID = 0;
-    evt.global2S_UID = 0;
-    evt.global3S_UID = 0;
+    tcx.tcc.geom = lar::providerFrom<geo::Geometry>();
     // find the average hit RMS using the full hit collection and define the
     // configuration for the current TPC
 
-    if (tcc.modes[kDebug] && evt.eventsProcessed == 0) PrintDebugMode();
+    if (tcx.tcc.modes[kDebug] && tcx.evt.eventsProcessed == 0) PrintDebugMode(tcx.tcc);
 
-    return AnalyzeHits();
+    return AnalyzeHits(tcx);
   } // SetInputHits
 
   ////////////////////////////////////////////////
   void
-  TrajClusterAlg::SetSourceHits(std::vector<recob::Hit> const& srcHits)
+  TrajClusterAlg::SetSourceHits(TCContext& tcx, std::vector<recob::Hit> const& srcHits)
   {
-    evt.srcHits = &srcHits;
-    evt.tpcSrcHitRange.resize(tcc.geom->NTPC());
-    for (auto& thr : evt.tpcSrcHitRange)
+    tcx.evt.srcHits = &srcHits;
+    tcx.evt.tpcSrcHitRange.resize(tcx.tcc.geom->NTPC());
+    for (auto& thr : tcx.evt.tpcSrcHitRange)
       thr = {UINT_MAX, UINT_MAX};
-    for (unsigned int iht = 0; iht < (*evt.srcHits).size(); ++iht) {
-      auto& hit = (*evt.srcHits)[iht];
+    for (unsigned int iht = 0; iht < (*tcx.evt.srcHits).size(); ++iht) {
+      auto& hit = (*tcx.evt.srcHits)[iht];
       unsigned int tpc = hit.WireID().TPC;
-      if (tpc >= evt.tpcSrcHitRange.size()) return;
-      if (evt.tpcSrcHitRange[tpc].first == UINT_MAX) evt.tpcSrcHitRange[tpc].first = iht;
-      evt.tpcSrcHitRange[tpc].second = iht;
+      if (tpc >= tcx.evt.tpcSrcHitRange.size()) return;
+      if (tcx.evt.tpcSrcHitRange[tpc].first == UINT_MAX) tcx.evt.tpcSrcHitRange[tpc].first = iht;
+      tcx.evt.tpcSrcHitRange[tpc].second = iht;
     } // iht
   }   // SetSourceHits
 
@@ -343,89 +344,369 @@ namespace tca {
   void
   TrajClusterAlg::RunTrajClusterAlg(detinfo::DetectorClocksData const& clockData,
                                     detinfo::DetectorPropertiesData const& detProp,
+                                    TCContext& tcx,
                                     std::vector<unsigned int>& hitsInSlice,
                                     int sliceID)
   {
     // Reconstruct everything using the hits in a slice
 
-    if (slices.empty()) ++evt.eventsProcessed;
+    if (tcx.slices.empty()) ++tcx.evt.eventsProcessed;
     if (hitsInSlice.size() < 2) return;
-    if (tcc.recoSlice > 0 && sliceID != tcc.recoSlice) return;
+    if (tcx.tcc.recoSlice > 0 && sliceID != tcx.tcc.recoSlice) return;
 
-    if (!CreateSlice(clockData, detProp, hitsInSlice, sliceID)) return;
+    if (!CreateSlice(clockData, detProp, tcx, hitsInSlice, sliceID)) return;
 
-    seeds.resize(0);
     // get a reference to the stored slice
-    auto& slc = slices[slices.size() - 1];
+    auto& slc = tcx.slices[tcx.slices.size() - 1];
     // special debug mode reconstruction
-    if (tcc.recoTPC > 0 && (short)slc.TPCID.TPC != tcc.recoTPC) {
-      slices.pop_back();
+    if (tcx.tcc.recoTPC > 0 && (short)slc.TPCID.TPC != tcx.tcc.recoTPC) {
+      tcx.slices.pop_back();
       return;
     }
 
-    if (evt.aveHitRMS.size() != slc.nPlanes)
+    if (tcx.evt.aveHitRMS.size() != slc.nPlanes)
       throw art::Exception(art::errors::Configuration)
         << " AveHitRMS vector size != the number of planes ";
-    if (tcc.recoSlice)
+    if (tcx.tcc.recoSlice)
       std::cout << "Reconstruct " << hitsInSlice.size() << " hits in Slice " << sliceID
                 << " in TPC " << slc.TPCID.TPC << "\n";
+    // continue the event ID counters in this slice
+    slc.ids = tcx.ids;
+    if (ReconstructSlice(clockData, detProp, tcx, slc) && FinishSlice(detProp, tcx, slc))
+      CountAlgs(slc);
+    tcx.ids = slc.ids;
+
+  } // RunTrajClusterAlg
+
+  ////////////////////////////////////////////////
+  void
+  TrajClusterAlg::RunTrajClusterAlg(detinfo::DetectorClocksData const& clockData,
+                                    detinfo::DetectorPropertiesData const& detProp,
+                                    TCContext& tcx,
+                                    std::vector<std::vector<unsigned int>>& tpcSliceHits,
+                                    std::vector<int> const& sliceIDs)
+  {
+    // Reconstruct the slices of hits in one TPC, concurrently if RunParallel is set. If
+    // CheckParallel is also set, the slices are reconstructed serially in a copy of tcx as well
+    // and the results are compared
+
+    if (!CanRunParallel()) {
+      for (unsigned short isl = 0; isl < tpcSliceHits.size(); ++isl) {
+        if (tpcSliceHits[isl].empty()) continue;
+        RunTrajClusterAlg(clockData, detProp, tcx, tpcSliceHits[isl], sliceIDs[isl]);
+      } // isl
+      return;
+    }
+
+    if (!fCheckParallel) {
+      RunParallel(clockData, detProp, tcx, tpcSliceHits, sliceIDs);
+      return;
+    }
+
+    // the serial reconstruction shouldn't be counted
+    TCContext serial = tcx;
+    auto const eventsProcessed = tcx.evt.eventsProcessed;
+    auto const algModCount = fAlgModCount;
+    for (unsigned short isl = 0; isl < tpcSliceHits.size(); ++isl) {
+      if (tpcSliceHits[isl].empty()) continue;
+      RunTrajClusterAlg(clockData, detProp, serial, tpcSliceHits[isl], sliceIDs[isl]);
+    } // isl
+    tcx.evt.eventsProcessed = eventsProcessed;
+    fAlgModCount = algModCount;
+
+    std::size_t const firstSlice = tcx.slices.size();
+    RunParallel(clockData, detProp, tcx, tpcSliceHits, sliceIDs);
+    if (!SameResults(serial, tcx, firstSlice))
+      mf::LogWarning("TC") << "RunTrajClusterAlg: the slices in event " << tcx.evt.event
+                           << " were reconstructed differently by the serial and concurrent code";
+
+  } // RunTrajClusterAlg
+
+  ////////////////////////////////////////////////
+  bool
+  TrajClusterAlg::CanRunParallel() const
+  {
+    // Slices can be reconstructed concurrently unless the configuration requires
+    // writing to shared state: trees, debug output or the TMVA reader variables
+    if (!fRunParallel) return false;
+    if (fConfig.modes[kDebug] || fConfig.modes[kSaveShowerTree] || fConfig.modes[kSaveCRTree])
+      return false;
+    if (fConfig.recoSlice > 0 || fConfig.recoTPC > 0) return false;
+    if (fConfig.showerParentReader) return false;
+    if (fConfig.useAlg[kChkInTraj]) return false;
+    return true;
+  } // CanRunParallel
+
+  ////////////////////////////////////////////////
+  void
+  TrajClusterAlg::RunParallel(detinfo::DetectorClocksData const& clockData,
+                              detinfo::DetectorPropertiesData const& detProp,
+                              TCContext& tcx,
+                              std::vector<std::vector<unsigned int>>& tpcSliceHits,
+                              std::vector<int> const& sliceIDs)
+  {
+    // The slices are created in order and the trajectories, vertices and PFParticles are
+    // then found concurrently. ReconstructSlice only uses the slice, whose ID counters start
+    // at 0. The slices are then appended to tcx, their IDs are offset by the counts of the
+    // preceding slices and they are finished one after the other, since the PFParticle
+    // parent - daughter links and the showers may refer to PFParticles in other slices
+
+    std::vector<TCSlice> work;
+    for (unsigned short isl = 0; isl < tpcSliceHits.size(); ++isl) {
+      auto& hitsInSlice = tpcSliceHits[isl];
+      if (hitsInSlice.empty()) continue;
+      if (tcx.slices.empty() && work.empty()) ++tcx.evt.eventsProcessed;
+      if (hitsInSlice.size() < 2) continue;
+      if (!CreateSlice(clockData, detProp, tcx, hitsInSlice, sliceIDs[isl])) continue;
+      work.push_back(std::move(tcx.slices.back()));
+      tcx.slices.pop_back();
+      if (work.back().TPCID != work.front().TPCID)
+        throw art::Exception(art::errors::LogicError)
+          << "RunTrajClusterAlg: slices in more than one TPC";
+      if (tcx.evt.aveHitRMS.size() != work.back().nPlanes)
+        throw art::Exception(art::errors::Configuration)
+          << " AveHitRMS vector size != the number of planes ";
+    } // isl
+    if (work.empty()) return;
+    // the TPC dependent state in evt and tcc is now defined. Fill the wire intersection
+    // cache so that it is only read while the slices are reconstructed
+    if (tcx.tcc.match3DCuts[0] > 0) FillWireIntersections(tcx, work.front());
+
+    std::vector<char> matched(work.size(), false);
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, work.size(), 1),
+                      [&](tbb::blocked_range<std::size_t> const& range) {
+                        for (std::size_t isl = range.begin(); isl < range.end(); ++isl) {
+                          work[isl].ids = TCIDs();
+                          matched[isl] = ReconstructSlice(clockData, detProp, tcx, work[isl]);
+                        }
+                      });
+
+    // append and finish the slices in order as if they were reconstructed serially
+    for (std::size_t isl = 0; isl < work.size(); ++isl) {
+      AddIDOffsets(tcx.ids, work[isl]);
+      tcx.slices.push_back(std::move(work[isl]));
+      auto& slc = tcx.slices.back();
+      if (matched[isl] && FinishSlice(detProp, tcx, slc)) CountAlgs(slc);
+      tcx.ids = slc.ids;
+    } // isl
+
+  } // RunParallel
+
+  ////////////////////////////////////////////////
+  void
+  TrajClusterAlg::AddIDOffsets(TCIDs const& offsets, TCSlice& slc) const
+  {
+    // Convert the UIDs and work IDs of a slice that was reconstructed with the ID counters
+    // starting at 0 into event IDs by adding the counts in offsets. The PFParticle parent -
+    // daughter links are defined later by FinishSlice so there are none to correct here
+    for (auto& pfp : slc.pfps)
+      if (pfp.UID > 0) pfp.UID += offsets.globalP_UID;
+    for (auto& tj : slc.tjs) {
+      if (tj.UID > 0) tj.UID += offsets.globalT_UID;
+      if (tj.WorkID < 0) tj.WorkID += offsets.WorkID;
+    } // tj
+    for (auto& vx2 : slc.vtxs)
+      if (vx2.UID > 0) vx2.UID += offsets.global2V_UID;
+    for (auto& vx3 : slc.vtx3s)
+      if (vx3.UID > 0) vx3.UID += offsets.global3V_UID;
+    for (auto& ss : slc.cots)
+      if (ss.UID > 0) ss.UID += offsets.global2S_UID;
+    for (auto& ss3 : slc.showers)
+      if (ss3.UID > 0) ss3.UID += offsets.global3S_UID;
+    // and continue the event ID counters
+    slc.ids.WorkID += offsets.WorkID;
+    slc.ids.globalT_UID += offsets.globalT_UID;
+    slc.ids.globalP_UID += offsets.globalP_UID;
+    slc.ids.global2V_UID += offsets.global2V_UID;
+    slc.ids.global3V_UID += offsets.global3V_UID;
+    slc.ids.global2S_UID += offsets.global2S_UID;
+    slc.ids.global3S_UID += offsets.global3S_UID;
+  } // AddIDOffsets
+
+  ////////////////////////////////////////////////
+  bool
+  TrajClusterAlg::SameResults(TCContext const& serial,
+                              TCContext const& parallel,
+                              std::size_t firstSlice) const
+  {
+    // Compare the slices from firstSlice on that were reconstructed serially and concurrently.
+    // The differences are printed. Returns true if there are none
+    std::string diff;
+    auto differs = [&diff](std::string what, std::size_t isl, int id) {
+      diff += " " + what + std::to_string(id) + " in slice " + std::to_string(isl) + "\n";
+    };
+
+    if (serial.ids.WorkID != parallel.ids.WorkID ||
+        serial.ids.globalT_UID != parallel.ids.globalT_UID ||
+        serial.ids.globalP_UID != parallel.ids.globalP_UID ||
+        serial.ids.global2V_UID != parallel.ids.global2V_UID ||
+        serial.ids.global3V_UID != parallel.ids.global3V_UID ||
+        serial.ids.global2S_UID != parallel.ids.global2S_UID ||
+        serial.ids.global3S_UID != parallel.ids.global3S_UID)
+      diff += " ID counters\n";
+    if (serial.slices.size() != parallel.slices.size()) {
+      diff += " number of slices " + std::to_string(serial.slices.size()) + " != " +
+              std::to_string(parallel.slices.size()) + "\n";
+    }
+    else {
+      for (std::size_t isl = firstSlice; isl < serial.slices.size(); ++isl) {
+        auto& s1 = serial.slices[isl];
+        auto& s2 = parallel.slices[isl];
+        if (s1.ID != s2.ID || s1.isValid != s2.isValid || s1.slHits.size() != s2.slHits.size() ||
+            s1.tjs.size() != s2.tjs.size() || s1.vtxs.size() != s2.vtxs.size() ||
+            s1.vtx3s.size() != s2.vtx3s.size() || s1.pfps.size() != s2.pfps.size() ||
+            s1.cots.size() != s2.cots.size() || s1.showers.size() != s2.showers.size()) {
+          differs("sizes of slice ", isl, s1.ID);
+          continue;
+        }
+        for (std::size_t iht = 0; iht < s1.slHits.size(); ++iht) {
+          if (s1.slHits[iht].allHitsIndex != s2.slHits[iht].allHitsIndex ||
+              s1.slHits[iht].InTraj != s2.slHits[iht].InTraj)
+            differs("hit ", isl, s1.slHits[iht].allHitsIndex);
+        } // iht
+        for (std::size_t itj = 0; itj < s1.tjs.size(); ++itj) {
+          auto& t1 = s1.tjs[itj];
+          auto& t2 = s2.tjs[itj];
+          bool same = t1.ID == t2.ID && t1.UID == t2.UID && t1.WorkID == t2.WorkID &&
+                      t1.CTP == t2.CTP && t1.AlgMod == t2.AlgMod && t1.EndPt == t2.EndPt &&
+                      t1.VtxID == t2.VtxID && t1.ParentID == t2.ParentID &&
+                      t1.PDGCode == t2.PDGCode && t1.Pts.size() == t2.Pts.size();
+          for (std::size_t ipt = 0; same && ipt < t1.Pts.size(); ++ipt)
+            same = t1.Pts[ipt].Pos == t2.Pts[ipt].Pos && t1.Pts[ipt].Hits == t2.Pts[ipt].Hits &&
+                   t1.Pts[ipt].UseHit == t2.Pts[ipt].UseHit;
+          if (!same) differs("T", isl, t1.UID);
+        } // itj
+        for (std::size_t ivx = 0; ivx < s1.vtxs.size(); ++ivx) {
+          auto& v1 = s1.vtxs[ivx];
+          auto& v2 = s2.vtxs[ivx];
+          if (v1.ID != v2.ID || v1.UID != v2.UID || v1.Pos != v2.Pos || v1.Vx3ID != v2.Vx3ID ||
+              v1.Score != v2.Score)
+            differs("2V", isl, v1.UID);
+        } // ivx
+        for (std::size_t ivx = 0; ivx < s1.vtx3s.size(); ++ivx) {
+          auto& v1 = s1.vtx3s[ivx];
+          auto& v2 = s2.vtx3s[ivx];
+          if (v1.ID != v2.ID || v1.UID != v2.UID || v1.X != v2.X || v1.Y != v2.Y ||
+              v1.Z != v2.Z || v1.Vx2ID != v2.Vx2ID)
+            differs("3V", isl, v1.UID);
+        } // ivx
+        for (std::size_t ip = 0; ip < s1.pfps.size(); ++ip) {
+          auto& p1 = s1.pfps[ip];
+          auto& p2 = s2.pfps[ip];
+          if (p1.ID != p2.ID || p1.UID != p2.UID || p1.TjIDs != p2.TjIDs ||
+              p1.TjUIDs != p2.TjUIDs || p1.ParentUID != p2.ParentUID ||
+              p1.DtrUIDs != p2.DtrUIDs || p1.PDGCode != p2.PDGCode || p1.Vx3ID != p2.Vx3ID)
+            differs("P", isl, p1.UID);
+        } // ip
+        for (std::size_t iss = 0; iss < s1.cots.size(); ++iss) {
+          auto& c1 = s1.cots[iss];
+          auto& c2 = s2.cots[iss];
+          if (c1.ID != c2.ID || c1.UID != c2.UID || c1.TjIDs != c2.TjIDs ||
+              c1.ShowerTjID != c2.ShowerTjID)
+            differs("2S", isl, c1.UID);
+        } // iss
+        for (std::size_t iss = 0; iss < s1.showers.size(); ++iss) {
+          auto& c1 = s1.showers[iss];
+          auto& c2 = s2.showers[iss];
+          if (c1.ID != c2.ID || c1.UID != c2.UID || c1.CotIDs != c2.CotIDs ||
+              c1.PFPIndex != c2.PFPIndex)
+            differs("3S", isl, c1.UID);
+        } // iss
+      }   // isl
+    }     // same number of slices
+
+    if (diff.empty()) return true;
+    mf::LogWarning("TC") << "SameResults: serial and concurrent reconstruction differ:\n" << diff;
+    return false;
+  } // SameResults
+
+  ////////////////////////////////////////////////
+  bool
+  TrajClusterAlg::ReconstructSlice(detinfo::DetectorClocksData const& clockData,
+                                   detinfo::DetectorPropertiesData const& detProp,
+                                   TCContext& tcx,
+                                   TCSlice& slc)
+  {
+    // Find the trajectories, vertices and PFParticles in a slice that was defined by
+    // CreateSlice. Only the slice is used, so slices can be reconstructed concurrently.
+    // Returns false if the reconstruction was stopped before the end
+
+    slc.seeds.resize(0);
     for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
       CTP_t inCTP = EncodeCTP(slc.TPCID.Cryostat, slc.TPCID.TPC, plane);
-      ReconstructAllTraj(detProp, slc, inCTP);
-      if (!slc.isValid) return;
+      ReconstructAllTraj(detProp, tcx, slc, inCTP);
+      if (!slc.isValid) return false;
     } // plane
     // Compare 2D vertices in each plane and try to reconcile T -> 2V attachments using
     // 2D and 3D(?) information
-    Reconcile2Vs(slc);
-    Find3DVertices(detProp, slc);
-    ScoreVertices(slc);
+    Reconcile2Vs(tcx, slc);
+    Find3DVertices(detProp, tcx, slc);
+    ScoreVertices(tcx, slc);
     // Define the ParentID of trajectories using the vertex score
-    DefineTjParents(slc, false);
+    DefineTjParents(tcx, slc, false);
     for (unsigned short plane = 0; plane < slc.nPlanes; ++plane) {
       CTP_t inCTP = EncodeCTP(slc.TPCID.Cryostat, slc.TPCID.TPC, plane);
       if (!ChkVtxAssociations(slc, inCTP)) {
         std::cout << "RTC: ChkVtxAssociations found an error\n";
       }
     } // plane
-    if (tcc.match3DCuts[0] > 0) {
-      FindPFParticles(clockData, detProp, slc);
-      DefinePFPParents(slc, false);
-    } // 3D matching requested
-    KillPoorVertices(slc);
+    if (tcx.tcc.match3DCuts[0] > 0) FindPFParticles(clockData, detProp, tcx, slc);
+    return true;
+  } // ReconstructSlice
+
+  ////////////////////////////////////////////////
+  bool
+  TrajClusterAlg::FinishSlice(detinfo::DetectorPropertiesData const& detProp,
+                             TCContext& tcx,
+                             TCSlice& slc)
+  {
+    // Define the PFParticle parents and find the 3D showers in slc, the last slice in tcx, after
+    // ReconstructSlice. PFParticle links to a neutrino PFParticle are defined using the ID
+    // and are looked up by UID in all slices, so the slices must be finished in order.
+    // Returns false if the reconstruction was stopped before the end
+
+    if (tcx.tcc.match3DCuts[0] > 0) DefinePFPParents(tcx, slc, false);
+    KillPoorVertices(tcx, slc);
     // Use 3D matching information to find showers in 2D. FindShowers3D returns
     // true if the algorithm was successful indicating that the matching needs to be redone
-    if (tcc.showerTag[0] == 2 || tcc.showerTag[0] == 4) {
-      FindShowers3D(detProp, slc);
-      if (tcc.modes[kSaveShowerTree]) {
-        std::cout << "SHOWER TREE STAGE NUM SIZE: " << stv.StageNum.size() << std::endl;
+    if (tcx.tcc.showerTag[0] == 2 || tcx.tcc.showerTag[0] == 4) {
+      FindShowers3D(detProp, tcx, slc);
+      if (tcx.tcc.modes[kSaveShowerTree]) {
+        std::cout << "SHOWER TREE STAGE NUM SIZE: " << tcx.stv.StageNum.size() << std::endl;
         showertree->Fill();
       }
     } // 3D shower code
 
     if (!slc.isValid) {
       mf::LogVerbatim("TC") << "RunTrajCluster failed in MakeAllTrajClusters";
-      return;
+      return false;
     }
 
     // dump a trajectory?
-    if (tcc.modes[kDebug] && tcc.dbgDump) DumpTj();
+    if (tcx.tcc.modes[kDebug] && tcx.tcc.dbgDump) DumpTj(tcx);
 
-    Finish3DShowers(slc);
+    Finish3DShowers(tcx, slc);
 
+    // clear vectors that are not needed later
+    slc.mallTraj.resize(0);
+    return true;
+  } // FinishSlice
+
+  ////////////////////////////////////////////////
+  void
+  TrajClusterAlg::CountAlgs(TCSlice const& slc)
+  {
     // count algorithm usage
     for (auto& tj : slc.tjs) {
       for (unsigned short ib = 0; ib < AlgBitNames.size(); ++ib)
         if (tj.AlgMod[ib]) ++fAlgModCount[ib];
     } // tj
-
-    // clear vectors that are not needed later
-    slc.mallTraj.resize(0);
-
-  } // RunTrajClusterAlg
+  } // CountAlgs
 
   ////////////////////////////////////////////////
   void
   TrajClusterAlg::ReconstructAllTraj(detinfo::DetectorPropertiesData const& detProp,
+                                     TCContext& tcx,
                                      TCSlice& slc,
                                      CTP_t inCTP)
   {
@@ -439,13 +720,13 @@ namespace tca {
     // Make several passes through the hits with user-specified cuts for each
     // pass. In general these are to not reconstruct large angle trajectories on
     // the first pass
-    float maxHitsRMS = 4 * evt.aveHitRMS[plane];
-    for (unsigned short pass = 0; pass < tcc.minPtsFit.size(); ++pass) {
+    float maxHitsRMS = 4 * tcx.evt.aveHitRMS[plane];
+    for (unsigned short pass = 0; pass < tcx.tcc.minPtsFit.size(); ++pass) {
       for (unsigned int ii = 0; ii < nwires; ++ii) {
         // decide which way to step given the sign of StepDir
         unsigned int iwire = 0;
         unsigned int jwire = 0;
-        if (tcc.modes[kStepDir]) {
+        if (tcx.tcc.modes[kStepDir]) {
           // step DS
           iwire = slc.firstWire[plane] + ii;
           jwire = iwire + 1;
@@ -470,21 +751,21 @@ namespace tca {
           return;
         }
         for (unsigned int iht = ifirsthit; iht <= ilasthit; ++iht) {
-          tcc.dbgStp = (tcc.modes[kDebug] && (slc.slHits[iht].allHitsIndex == debug.Hit));
-          if (tcc.dbgStp) {
+          if (tcx.tcc.modes[kDebug]) tcx.tcc.dbgStp = (slc.slHits[iht].allHitsIndex == debug.Hit);
+          if (tcx.tcc.dbgStp) {
             mf::LogVerbatim("TC") << "+++++++ Pass " << pass << " Found debug hit "
-                                  << slices.size() - 1 << ":" << PrintHit(slc.slHits[iht])
+                                  << slc.ID << ":" << PrintHit(tcx, slc.slHits[iht])
                                   << " iht " << iht;
           }
           // Only consider hits that are available
           if (slc.slHits[iht].InTraj != 0) continue;
           // We hope to make a trajectory point at the hit position of iht in WSE units
           // with a direction pointing to jht
-          if (slc.slHits[iht].allHitsIndex > (*evt.allHits).size() - 1) {
+          if (slc.slHits[iht].allHitsIndex > (*tcx.evt.allHits).size() - 1) {
             std::cout << "RAT: Bad allHitsIndex\n";
             continue;
           }
-          auto& iHit = (*evt.allHits)[slc.slHits[iht].allHitsIndex];
+          auto& iHit = (*tcx.evt.allHits)[slc.slHits[iht].allHitsIndex];
           if (LongPulseHit(iHit)) continue;
           unsigned int fromWire = iHit.WireID().Wire;
           float fromTick = iHit.PeakTime();
@@ -497,21 +778,21 @@ namespace tca {
             iHitsInMultiplet[0] = iht;
           }
           else {
-            GetHitMultiplet(slc, iht, iHitsInMultiplet, false);
+            GetHitMultiplet(tcx, slc, iht, iHitsInMultiplet, false);
             if (iHitsInMultiplet.empty()) continue;
             // ignore very high multiplicities
             if (iHitsInMultiplet.size() > 4) continue;
           }
           if (iHitsInMultiplet.size() > 1) {
-            fromTick = HitsPosTick(slc, iHitsInMultiplet, iqtot, kUnusedHits);
-            hitsRMSTick = HitsRMSTick(slc, iHitsInMultiplet, kUnusedHits);
+            fromTick = HitsPosTick(tcx, slc, iHitsInMultiplet, iqtot, kUnusedHits);
+            hitsRMSTick = HitsRMSTick(tcx, slc, iHitsInMultiplet, kUnusedHits);
           }
           if (hitsRMSTick == 0) continue;
           bool fatIHit = (hitsRMSTick > maxHitsRMS);
-          if (tcc.dbgStp)
+          if (tcx.tcc.dbgStp)
             mf::LogVerbatim("TC") << " hit RMS " << iHit.RMS() << " BB Multiplicity "
                                   << iHitsInMultiplet.size() << " AveHitRMS[" << plane << "] "
-                                  << evt.aveHitRMS[plane] << " HitsRMSTick " << hitsRMSTick
+                                  << tcx.evt.aveHitRMS[plane] << " HitsRMSTick " << hitsRMSTick
                                   << " fatIHit " << fatIHit;
           for (unsigned int jht = jfirsthit; jht <= jlasthit; ++jht) {
             // Only consider hits that are available
@@ -520,13 +801,13 @@ namespace tca {
             // clear out any leftover work inTraj's that weren't cleaned up properly
             for (auto& slHit : slc.slHits) {
               if (slHit.InTraj < 0) {
-                std::cout << "RAT: Dirty hit " << PrintHit(slHit) << " EventsProcessed "
-                          << evt.eventsProcessed << " WorkID " << evt.WorkID << "\n";
+                std::cout << "RAT: Dirty hit " << PrintHit(tcx, slHit) << " EventsProcessed "
+                          << tcx.evt.eventsProcessed << " WorkID " << slc.ids.WorkID << "\n";
                 slHit.InTraj = 0;
               }
             }
             unsigned int toWire = jwire;
-            auto& jHit = (*evt.allHits)[slc.slHits[jht].allHitsIndex];
+            auto& jHit = (*tcx.evt.allHits)[slc.slHits[jht].allHitsIndex];
             if (LongPulseHit(jHit)) continue;
             float toTick = jHit.PeakTime();
             float jqtot = jHit.Integral();
@@ -537,12 +818,12 @@ namespace tca {
               jHitsInMultiplet[0] = jht;
             }
             else {
-              GetHitMultiplet(slc, jht, jHitsInMultiplet, false);
+              GetHitMultiplet(tcx, slc, jht, jHitsInMultiplet, false);
               if (jHitsInMultiplet.empty()) continue;
               // ignore very high multiplicities
               if (jHitsInMultiplet.size() > 4) continue;
             }
-            hitsRMSTick = HitsRMSTick(slc, jHitsInMultiplet, kUnusedHits);
+            hitsRMSTick = HitsRMSTick(tcx, slc, jHitsInMultiplet, kUnusedHits);
             if (hitsRMSTick == 0) continue;
             bool fatJHit = (hitsRMSTick > maxHitsRMS);
             if (pass == 0) {
@@ -552,89 +833,91 @@ namespace tca {
             else {
               // pass > 0
               if (jHitsInMultiplet.size() > 1)
-                toTick = HitsPosTick(slc, jHitsInMultiplet, jqtot, kUnusedHits);
+                toTick = HitsPosTick(tcx, slc, jHitsInMultiplet, jqtot, kUnusedHits);
             }
-            bool hitsOK = TrajHitsOK(slc, iHitsInMultiplet, jHitsInMultiplet);
+            bool hitsOK = TrajHitsOK(tcx, slc, iHitsInMultiplet, jHitsInMultiplet);
             // Ensure that the hits StartTick and EndTick have the proper overlap
             if (!hitsOK) continue;
             // start a trajectory with direction from iht -> jht
             Trajectory work;
-            if (!StartTraj(slc, work, fromWire, fromTick, toWire, toTick, inCTP, pass)) continue;
+            if (!StartTraj(tcx, slc, work, fromWire, fromTick, toWire, toTick, inCTP, pass))
+              continue;
             // check for a major failure
             if (!slc.isValid) {
               std::cout << "RAT: StartTraj major failure\n";
               return;
             }
             if (work.Pts.empty()) {
-              if (tcc.dbgStp) mf::LogVerbatim("TC") << "ReconstructAllTraj: StartTraj failed";
+              if (tcx.tcc.dbgStp) mf::LogVerbatim("TC") << "ReconstructAllTraj: StartTraj failed";
               continue;
             }
-            work.Pts[0].DeltaRMS = tcc.hitErrFac * tcc.unitsPerTick * hitsRMSTick;
+            work.Pts[0].DeltaRMS = tcx.tcc.hitErrFac * tcx.tcc.unitsPerTick * hitsRMSTick;
             // don't include the charge of iht since it will be low if this
             // is a starting/ending track
             work.AveChg = jqtot;
             // try to add close hits
             bool sigOK;
-            AddHits(slc, work, 0, sigOK);
+            AddHits(tcx, slc, work, 0, sigOK);
             // check for a major failure
             if (!slc.isValid) {
               std::cout << "RAT: AddHits major failure\n";
               return;
             }
             if (!sigOK || work.Pts[0].Chg == 0) {
-              if (tcc.dbgStp) mf::LogVerbatim("TC") << " No hits at initial trajectory point ";
+              if (tcx.tcc.dbgStp) mf::LogVerbatim("TC") << " No hits at initial trajectory point ";
               ReleaseHits(slc, work);
               continue;
             }
             // move the TP position to the hit position but don't mess with the direction
             work.Pts[0].Pos = work.Pts[0].HitPos;
             // print the header and the first TP
-            if (tcc.dbgStp) PrintTrajectory("RAT", slc, work, USHRT_MAX);
+            if (tcx.tcc.dbgStp) PrintTrajectory("RAT", tcx, slc, work, USHRT_MAX);
             // We can't update the trajectory yet because there is only one TP.
             work.EndPt[0] = 0;
             // now try stepping away
-            StepAway(slc, work);
+            StepAway(tcx, slc, work);
             // check for a major failure
             if (!slc.isValid) {
               std::cout << "RAT: StepAway major failure\n";
               return;
             }
-            if (tcc.dbgStp)
+            if (tcx.tcc.dbgStp)
               mf::LogVerbatim("TC") << " After first StepAway. IsGood " << work.IsGood;
             // Check the quality of the work trajectory
-            CheckTraj(slc, work);
+            CheckTraj(tcx, slc, work);
             // check for a major failure
             if (!slc.isValid) {
               std::cout << "RAT: CheckTraj major failure\n";
               return;
             }
-            if (tcc.dbgStp)
+            if (tcx.tcc.dbgStp)
               mf::LogVerbatim("TC") << "ReconstructAllTraj: After CheckTraj EndPt " << work.EndPt[0]
                                     << "-" << work.EndPt[1] << " IsGood " << work.IsGood;
-            if (tcc.dbgStp)
+            if (tcx.tcc.dbgStp)
               mf::LogVerbatim("TC")
                 << "StepAway done: IsGood " << work.IsGood << " NumPtsWithCharge "
-                << NumPtsWithCharge(slc, work, true) << " cut " << tcc.minPts[work.Pass];
+                << NumPtsWithCharge(tcx, slc, work, true) << " cut " << tcx.tcc.minPts[work.Pass];
             // decide if the trajectory is long enough for this pass
-            if (!work.IsGood || NumPtsWithCharge(slc, work, true) < tcc.minPts[work.Pass]) {
-              if (tcc.dbgStp)
+            if (!work.IsGood ||
+                NumPtsWithCharge(tcx, slc, work, true) < tcx.tcc.minPts[work.Pass]) {
+              if (tcx.tcc.dbgStp)
                 mf::LogVerbatim("TC")
-                  << " xxxxxxx Not enough points " << NumPtsWithCharge(slc, work, true)
-                  << " minimum " << tcc.minPts[work.Pass] << " or !IsGood";
+                  << " xxxxxxx Not enough points " << NumPtsWithCharge(tcx, slc, work, true)
+                  << " minimum " << tcx.tcc.minPts[work.Pass] << " or !IsGood";
               ReleaseHits(slc, work);
               continue;
             }
-            if (!StoreTraj(slc, work)) continue;
-            if (tcc.dbgStp) {
+            if (!StoreTraj(tcx, slc, work)) continue;
+            if (tcx.tcc.dbgStp) {
               auto& tj = slc.tjs[slc.tjs.size() - 1];
-              PrintTrajectory("RAT", slc, tj, USHRT_MAX);
-              if (!InTrajOK(slc, "RAT")) {
+              PrintTrajectory("RAT", tcx, slc, tj, USHRT_MAX);
+              if (!InTrajOK(tcx, slc, "RAT")) {
                 std::cout << "RAT: InTrajOK major failure. " << tj.ID << "\n";
                 return;
               }
             } // dbgStp
-            CheckTrajBeginChg(slc, slc.tjs.size() - 1);
-            BraggSplit(slc, slc.tjs.size() - 1);
+            CheckTrajBeginChg(tcx, slc, slc.tjs.size() - 1);
+            BraggSplit(tcx, slc, slc.tjs.size() - 1);
             break;
           } // jht
         }   // iht
@@ -642,21 +925,21 @@ namespace tca {
 
       // See if there are any seed trajectory points that were saved before reverse
       // propagation and try to make Tjs from them
-      for (auto tp : seeds) {
+      for (auto tp : slc.seeds) {
         unsigned short nAvailable = 0;
         for (unsigned short ii = 0; ii < tp.Hits.size(); ++ii) {
           if (!tp.UseHit[ii]) continue;
           unsigned int iht = tp.Hits[ii];
           if (slc.slHits[iht].InTraj == 0) ++nAvailable;
-          tcc.dbgStp = (tcc.modes[kDebug] && (slc.slHits[iht].allHitsIndex == debug.Hit));
-          if (tcc.dbgStp) {
-            mf::LogVerbatim("TC") << "+++++++ Seed debug hit " << slices.size() - 1 << ":"
-                                  << PrintHit(slc.slHits[iht]) << " iht " << iht;
+          if (tcx.tcc.modes[kDebug]) tcx.tcc.dbgStp = (slc.slHits[iht].allHitsIndex == debug.Hit);
+          if (tcx.tcc.dbgStp) {
+            mf::LogVerbatim("TC") << "+++++++ Seed debug hit " << slc.ID << ":"
+                                  << PrintHit(tcx, slc.slHits[iht]) << " iht " << iht;
           }
         } // ii
         if (nAvailable == 0) continue;
         Trajectory work;
-        work.ID = evt.WorkID;
+        work.ID = slc.ids.WorkID;
         for (unsigned short ii = 0; ii < tp.Hits.size(); ++ii) {
           if (!tp.UseHit[ii]) continue;
           unsigned int iht = tp.Hits[ii];
@@ -672,65 +955,65 @@ namespace tca {
         // don't allow yet another reverse propagation
         work.AlgMod[kRvPrp] = true;
         work.Pts.push_back(tp);
-        StepAway(slc, work);
-        CheckTraj(slc, work);
+        StepAway(tcx, slc, work);
+        CheckTraj(tcx, slc, work);
         // check for a major failure
         if (!slc.isValid) {
           std::cout << "RAT: CheckTraj major failure\n";
           return;
         }
         // decide if the trajectory is long enough for this pass
-        if (!work.IsGood || NumPtsWithCharge(slc, work, true) < tcc.minPts[work.Pass]) {
-          if (tcc.dbgStp)
+        if (!work.IsGood || NumPtsWithCharge(tcx, slc, work, true) < tcx.tcc.minPts[work.Pass]) {
+          if (tcx.tcc.dbgStp)
             mf::LogVerbatim("TC") << " xxxxxxx Not enough points "
-                                  << NumPtsWithCharge(slc, work, true) << " minimum "
-                                  << tcc.minPts[work.Pass] << " or !IsGood";
+                                  << NumPtsWithCharge(tcx, slc, work, true) << " minimum "
+                                  << tcx.tcc.minPts[work.Pass] << " or !IsGood";
           ReleaseHits(slc, work);
           continue;
         }
-        if (!StoreTraj(slc, work)) continue;
-        if (tcc.dbgStp) {
+        if (!StoreTraj(tcx, slc, work)) continue;
+        if (tcx.tcc.dbgStp) {
           auto& tj = slc.tjs[slc.tjs.size() - 1];
           mf::LogVerbatim("TC") << "TRP RAT Stored T" << tj.ID << " using seed TP "
-                                << PrintPos(slc, tp);
+                                << PrintPos(tcx, slc, tp);
         }
-        BraggSplit(slc, slc.tjs.size() - 1);
+        BraggSplit(tcx, slc, slc.tjs.size() - 1);
       } // seed
 
-      seeds.resize(0);
+      slc.seeds.resize(0);
 
-      bool lastPass = (pass == tcc.minPtsFit.size() - 1);
+      bool lastPass = (pass == tcx.tcc.minPtsFit.size() - 1);
       // don't use lastPass cuts if we will use LastEndMerge
-      if (tcc.useAlg[kLastEndMerge]) lastPass = false;
-      EndMerge(slc, inCTP, lastPass);
+      if (tcx.tcc.useAlg[kLastEndMerge]) lastPass = false;
+      EndMerge(tcx, slc, inCTP, lastPass);
       if (!slc.isValid) return;
 
-      Find2DVertices(detProp, slc, inCTP, pass);
+      Find2DVertices(detProp, tcx, slc, inCTP, pass);
 
     } // pass
 
     // Last attempt to merge long straight Tjs that failed the EndMerge cuts
-    LastEndMerge(slc, inCTP);
+    LastEndMerge(tcx, slc, inCTP);
 
     // make junk trajectories using nearby un-assigned hits
-    FindJunkTraj(slc, inCTP);
+    FindJunkTraj(tcx, slc, inCTP);
     // dressed muons with halo trajectories
-    if (tcc.muonTag.size() > 4 && tcc.muonTag[4] > 0) {
+    if (tcx.tcc.muonTag.size() > 4 && tcx.tcc.muonTag[4] > 0) {
       for (auto& tj : slc.tjs) {
         if (tj.AlgMod[kKilled]) continue;
         if (tj.PDGCode != 13) continue;
-        MakeHaloTj(slc, tj, tcc.dbgSlc);
+        MakeHaloTj(tcx, slc, tj, tcx.tcc.dbgSlc);
       } // tj
     }   // dressed muons
 
     // Tag ShowerLike Tjs
-    if (tcc.showerTag[0] > 0) TagShowerLike("RAT", slc, inCTP);
+    if (tcx.tcc.showerTag[0] > 0) TagShowerLike("RAT", tcx, slc, inCTP);
     // Set TP Environment bits
-    SetTPEnvironment(slc, inCTP);
-    Find2DVertices(detProp, slc, inCTP, USHRT_MAX);
-    SplitTrajCrossingVertices(slc, inCTP);
+    SetTPEnvironment(tcx, slc, inCTP);
+    Find2DVertices(detProp, tcx, slc, inCTP, USHRT_MAX);
+    SplitTrajCrossingVertices(tcx, slc, inCTP);
     // Make vertices between long Tjs and junk Tjs
-    MakeJunkVertices(slc, inCTP);
+    MakeJunkVertices(tcx, slc, inCTP);
     // check for a major failure
     if (!slc.isValid) {
       std::cout << "RAT: MakeJunkVertices major failure\n";
@@ -742,31 +1025,31 @@ namespace tca {
       auto& vx2 = slc.vtxs[ivx];
       if (vx2.ID == 0) continue;
       if (vx2.CTP != inCTP) continue;
-      AttachAnyTrajToVertex(slc, ivx, tcc.dbgStp || tcc.dbg2V);
+      AttachAnyTrajToVertex(tcx, slc, ivx, tcx.tcc.dbgStp || tcx.tcc.dbg2V);
     } // ivx
 
     // Set the kEnvOverlap bit true for all TPs that are close to other
     // trajectories that are close to vertices. The positions of TPs that
     // overlap are biased and shouldn't be used in a vertex fit. Also, these
     // TPs shouldn't be used to calculate dE/dx
-    UpdateVxEnvironment(slc);
+    UpdateVxEnvironment(tcx, slc);
 
     // Check the Tj <-> vtx associations and define the vertex quality
     if (!ChkVtxAssociations(slc, inCTP)) {
       std::cout << "RAT: ChkVtxAssociations found an error. Events processed "
-                << evt.eventsProcessed << " WorkID " << evt.WorkID << "\n";
+                << tcx.evt.eventsProcessed << " WorkID " << slc.ids.WorkID << "\n";
     }
 
   } // ReconstructAllTraj
 
   //////////////////////////////////////////
   void
-  TrajClusterAlg::FindJunkTraj(TCSlice& slc, CTP_t inCTP)
+  TrajClusterAlg::FindJunkTraj(TCContext& tcx, TCSlice& slc, CTP_t inCTP)
   {
     // Makes junk trajectories using unassigned hits
 
-    if (tcc.JTMaxHitSep2 <= 0) return;
-    if (!tcc.useAlg[kJunkTj]) return;
+    if (tcx.tcc.JTMaxHitSep2 <= 0) return;
+    if (!tcx.tcc.useAlg[kJunkTj]) return;
     unsigned short plane = DecodeCTP(inCTP).Plane;
     if ((int)slc.lastWire[plane] - 3 < (int)slc.firstWire[plane]) return;
 
@@ -794,24 +1077,24 @@ namespace tca {
         auto& islHit = slc.slHits[iht];
         if (islHit.InTraj != 0) continue;
         std::vector<unsigned int> iHits;
-        GetHitMultiplet(slc, iht, iHits, true);
-        prt =
-          (tcc.modes[kDebug] && std::find(iHits.begin(), iHits.end(), debug.Hit) != iHits.end());
+        GetHitMultiplet(tcx, slc, iht, iHits, true);
+        prt = (tcx.tcc.modes[kDebug] &&
+               std::find(iHits.begin(), iHits.end(), debug.Hit) != iHits.end());
         if (prt) mf::LogVerbatim("TC") << "FJT: debug iht multiplet size " << iHits.size();
         if (iHits.empty()) continue;
         for (unsigned int jht = jfirsthit; jht <= jlasthit; ++jht) {
           if(jht >= slc.slHits.size()) break;
           auto& jslHit = slc.slHits[jht];
           if (jslHit.InTraj != 0) continue;
-          if (prt && HitSep2(slc, iht, jht) < 100)
-            mf::LogVerbatim("TC") << " use " << PrintHit(jslHit) << " hitSep2 "
-                                  << HitSep2(slc, iht, jht);
-          if (HitSep2(slc, iht, jht) > tcc.JTMaxHitSep2) continue;
+          if (prt && HitSep2(tcx, slc, iht, jht) < 100)
+            mf::LogVerbatim("TC") << " use " << PrintHit(tcx, jslHit) << " hitSep2 "
+                                  << HitSep2(tcx, slc, iht, jht);
+          if (HitSep2(tcx, slc, iht, jht) > tcx.tcc.JTMaxHitSep2) continue;
           std::vector<unsigned int> jHits;
-          GetHitMultiplet(slc, jht, jHits, true);
+          GetHitMultiplet(tcx, slc, jht, jHits, true);
           if (jHits.empty()) continue;
           // check for hit overlap consistency
-          if (!TrajHitsOK(slc, iHits, jHits)) continue;
+          if (!TrajHitsOK(tcx, slc, iHits, jHits)) continue;
           tHits.clear();
           // add the available hits and flag them
           for (auto iht : iHits)
@@ -841,8 +1124,8 @@ namespace tca {
                 // this shouldn't be needed but do it anyway
                 if (std::find(tHits.begin(), tHits.end(), kht) != tHits.end()) continue;
                 // re-purpose jHits and check for consistency
-                GetHitMultiplet(slc, kht, jHits, true);
-                if (!TrajHitsOK(slc, tHits, jHits)) continue;
+                GetHitMultiplet(tcx, slc, kht, jHits, true);
+                if (!TrajHitsOK(tcx, slc, tHits, jHits)) continue;
                 // add them all and update the wire range
                 for (auto jht : jHits) {
                   if (slc.slHits[jht].InTraj != 0) continue;
@@ -867,12 +1150,12 @@ namespace tca {
             mf::LogVerbatim myprt("TC");
             myprt << "FJT: tHits";
             for (auto tht : tHits)
-              myprt << " " << PrintHit(slc.slHits[tht]);
+              myprt << " " << PrintHit(tcx, slc.slHits[tht]);
             myprt << "\n";
           } // prt
           // See if this is a ghost trajectory
-          if (IsGhost(slc, tHits)) break;
-          if (!MakeJunkTraj(slc, tHits)) {
+          if (IsGhost(tcx, slc, tHits)) break;
+          if (!MakeJunkTraj(tcx, slc, tHits)) {
             if (prt) mf::LogVerbatim() << "FJT: MakeJunkTraj failed";
             break;
           }
@@ -884,11 +1167,11 @@ namespace tca {
 
   ////////////////////////////////////////////////
   void
-  TrajClusterAlg::ChkInTraj(std::string someText, TCSlice& slc)
+  TrajClusterAlg::ChkInTraj(std::string someText, TCContext& tcx, TCSlice& slc)
   {
     // Check slc.tjs -> InTraj associations
 
-    if (!tcc.useAlg[kChkInTraj]) return;
+    if (!tcx.tcc.useAlg[kChkInTraj]) return;
 
     ++fAlgModCount[kChkInTraj];
 
@@ -922,7 +1205,7 @@ namespace tca {
       tHits = PutTrajHitsInVector(tj, kUsedHits);
       if (tHits.size() < 2) {
         mf::LogVerbatim("TC") << someText << " ChkInTraj: Insufficient hits in traj " << tj.ID;
-        PrintTrajectory("CIT", slc, tj, USHRT_MAX);
+        PrintTrajectory("CIT", tcx, slc, tj, USHRT_MAX);
         tj.AlgMod[kKilled] = true;
         continue;
       }
@@ -948,17 +1231,17 @@ namespace tca {
         myprt << "\n";
         myprt << "index     inTraj     UseHit \n";
         for (iht = 0; iht < atHits.size(); ++iht) {
-          myprt << "iht " << iht << " " << PrintHit(slc.slHits[atHits[iht]]);
-          if (iht < tHits.size()) myprt << " " << PrintHit(slc.slHits[tHits[iht]]);
+          myprt << "iht " << iht << " " << PrintHit(tcx, slc.slHits[atHits[iht]]);
+          if (iht < tHits.size()) myprt << " " << PrintHit(tcx, slc.slHits[tHits[iht]]);
           if (atHits[iht] != tHits[iht]) myprt << " <<< " << atHits[iht] << " != " << tHits[iht];
           myprt << "\n";
           slc.isValid = false;
         } // iht
         if (tHits.size() > atHits.size()) {
           for (iht = atHits.size(); iht < atHits.size(); ++iht) {
-            myprt << "atHits " << iht << " " << PrintHit(slc.slHits[atHits[iht]]) << "\n";
+            myprt << "atHits " << iht << " " << PrintHit(tcx, slc.slHits[atHits[iht]]) << "\n";
           } // iht
-          PrintTrajectory("CIT", slc, tj, USHRT_MAX);
+          PrintTrajectory("CIT", tcx, slc, tj, USHRT_MAX);
         } // tHit.size > atHits.size()
       }
       // check the VtxID
@@ -968,7 +1251,7 @@ namespace tca {
           std::cout << someText << " ChkInTraj: Bad VtxID " << tj.ID << " vtx size "
                     << slc.vtxs.size() << "\n";
           tj.AlgMod[kKilled] = true;
-          PrintTrajectory("CIT", slc, tj, USHRT_MAX);
+          PrintTrajectory("CIT", tcx, slc, tj, USHRT_MAX);
           slc.isValid = false;
           return;
         }
@@ -981,7 +1264,7 @@ namespace tca {
 
   //////////////////////////////////////////
   void
-  TrajClusterAlg::MergeTPHits(std::vector<unsigned int>& tpHits,
+  TrajClusterAlg::MergeTPHits(TCContext& tcx, std::vector<unsigned int>& tpHits,
                               std::vector<recob::Hit>& newHitCol,
                               std::vector<unsigned int>& newHitAssns) const
   {
@@ -992,12 +1275,12 @@ namespace tca {
 
     // no merge required. Just put a close copy of the single hit in the output hit collection
     if (tpHits.size() == 1) {
-      if (tpHits[0] > (*evt.allHits).size() - 1) {
+      if (tpHits[0] > (*tcx.evt.allHits).size() - 1) {
         std::cout << "MergeTPHits Bad input hit index " << tpHits[0] << " allHits size "
-                  << (*evt.allHits).size() << "\n";
+                  << (*tcx.evt.allHits).size() << "\n";
         return;
       }
-      newHitCol.push_back(MergeTPHitsOnWire(tpHits));
+      newHitCol.push_back(MergeTPHitsOnWire(tcx, tpHits));
       newHitAssns[tpHits[0]] = newHitCol.size() - 1;
       return;
     } // tpHits.size() == 1
@@ -1005,12 +1288,12 @@ namespace tca {
     // split the hit list into sub-lists of hits on a single wire
     std::vector<unsigned int> wires;
     std::vector<std::vector<unsigned int>> wireHits;
-    auto& firstHit = (*evt.allHits)[tpHits[0]];
+    auto& firstHit = (*tcx.evt.allHits)[tpHits[0]];
     wires.push_back(firstHit.WireID().Wire);
     std::vector<unsigned int> tmp(1, tpHits[0]);
     wireHits.push_back(tmp);
     for (unsigned short ii = 1; ii < tpHits.size(); ++ii) {
-      auto& hit = (*evt.allHits)[tpHits[ii]];
+      auto& hit = (*tcx.evt.allHits)[tpHits[ii]];
       unsigned int wire = hit.WireID().Wire;
       unsigned short indx = 0;
       for (indx = 0; indx < wires.size(); ++indx)
@@ -1025,7 +1308,7 @@ namespace tca {
     // now merge hits in each sub-list.
     for (unsigned short indx = 0; indx < wireHits.size(); ++indx) {
       auto& hitsOnWire = wireHits[indx];
-      newHitCol.push_back(MergeTPHitsOnWire(hitsOnWire));
+      newHitCol.push_back(MergeTPHitsOnWire(tcx, hitsOnWire));
       for (unsigned short ii = 0; ii < hitsOnWire.size(); ++ii) {
         newHitAssns[hitsOnWire[ii]] = newHitCol.size() - 1;
       }
@@ -1037,7 +1320,7 @@ namespace tca {
 
   //////////////////////////////////////////
   recob::Hit
-  TrajClusterAlg::MergeTPHitsOnWire(std::vector<unsigned int>& tpHits) const
+  TrajClusterAlg::MergeTPHitsOnWire(TCContext& tcx, std::vector<unsigned int>& tpHits) const
   {
     // merge the hits indexed by tpHits into one hit
 
@@ -1045,12 +1328,12 @@ namespace tca {
 
     // no merge required. Just return a slightly modified copy of the single hit
     if (tpHits.size() == 1) {
-      if (tpHits[0] > (*evt.allHits).size() - 1) {
+      if (tpHits[0] > (*tcx.evt.allHits).size() - 1) {
         std::cout << "MergeTPHits Bad input hit index " << tpHits[0] << " allHits size "
-                  << (*evt.allHits).size() << "\n";
+                  << (*tcx.evt.allHits).size() << "\n";
         return recob::Hit();
       }
-      auto& oldHit = (*evt.allHits)[tpHits[0]];
+      auto& oldHit = (*tcx.evt.allHits)[tpHits[0]];
       raw::TDCtick_t startTick = oldHit.PeakTime() - 3 * oldHit.RMS();
       raw::TDCtick_t endTick = oldHit.PeakTime() + 3 * oldHit.RMS();
 
@@ -1084,8 +1367,8 @@ namespace tca {
     raw::TDCtick_t startTick = INT_MAX;
     raw::TDCtick_t endTick = 0;
     for (auto allHitsIndex : tpHits) {
-      if (allHitsIndex > (*evt.allHits).size() - 1) return recob::Hit();
-      auto& hit = (*evt.allHits)[allHitsIndex];
+      if (allHitsIndex > (*tcx.evt.allHits).size() - 1) return recob::Hit();
+      auto& hit = (*tcx.evt.allHits)[allHitsIndex];
       if (hit.StartTick() < startTick) startTick = hit.StartTick();
       if (hit.EndTick() > endTick) endTick = hit.EndTick();
       double intgrl = hit.Integral();
@@ -1104,7 +1387,7 @@ namespace tca {
     // Create a signal shape vector to find the rms and peak tick
     std::vector<double> shape(endTick - startTick + 1, 0.);
     for (auto allHitsIndex : tpHits) {
-      auto& hit = (*evt.allHits)[allHitsIndex];
+      auto& hit = (*tcx.evt.allHits)[allHitsIndex];
       double peakTick = hit.PeakTime();
       double rms = hit.RMS();
       double peakAmp = hit.PeakAmplitude();
@@ -1137,7 +1420,7 @@ namespace tca {
     }
     double rms = std::sqrt(sigsumt / sigsum);
     // get a reference to the first hit to get the charge normalization, channel, view, etc
-    auto& firstHit = (*evt.allHits)[tpHits[0]];
+    auto& firstHit = (*tcx.evt.allHits)[tpHits[0]];
     double chgNorm = 2.507 * firstHit.PeakAmplitude() * firstHit.RMS() / firstHit.Integral();
     // find the amplitude from the integrated charge and the RMS
     peakAmp = (float)(integral * chgNorm / (2.507 * rms));
@@ -1175,39 +1458,39 @@ namespace tca {
   {
     showertree = t;
 
-    showertree->Branch("run", &evt.run, "run/I");
-    showertree->Branch("subrun", &evt.subRun, "subrun/I");
-    showertree->Branch("event", &evt.event, "event/I");
+    showertree->Branch("run", &fEvent.run, "run/I");
+    showertree->Branch("subrun", &fEvent.subRun, "subrun/I");
+    showertree->Branch("event", &fEvent.event, "event/I");
 
-    showertree->Branch("BeginWir", &stv.BeginWir);
-    showertree->Branch("BeginTim", &stv.BeginTim);
-    showertree->Branch("BeginAng", &stv.BeginAng);
-    showertree->Branch("BeginChg", &stv.BeginChg);
-    showertree->Branch("BeginVtx", &stv.BeginVtx);
+    showertree->Branch("BeginWir", &fShowerTreeVars.BeginWir);
+    showertree->Branch("BeginTim", &fShowerTreeVars.BeginTim);
+    showertree->Branch("BeginAng", &fShowerTreeVars.BeginAng);
+    showertree->Branch("BeginChg", &fShowerTreeVars.BeginChg);
+    showertree->Branch("BeginVtx", &fShowerTreeVars.BeginVtx);
 
-    showertree->Branch("EndWir", &stv.EndWir);
-    showertree->Branch("EndTim", &stv.EndTim);
-    showertree->Branch("EndAng", &stv.EndAng);
-    showertree->Branch("EndChg", &stv.EndChg);
-    showertree->Branch("EndVtx", &stv.EndVtx);
+    showertree->Branch("EndWir", &fShowerTreeVars.EndWir);
+    showertree->Branch("EndTim", &fShowerTreeVars.EndTim);
+    showertree->Branch("EndAng", &fShowerTreeVars.EndAng);
+    showertree->Branch("EndChg", &fShowerTreeVars.EndChg);
+    showertree->Branch("EndVtx", &fShowerTreeVars.EndVtx);
 
-    showertree->Branch("MCSMom", &stv.MCSMom);
+    showertree->Branch("MCSMom", &fShowerTreeVars.MCSMom);
 
-    showertree->Branch("PlaneNum", &stv.PlaneNum);
-    showertree->Branch("TjID", &stv.TjID);
-    showertree->Branch("IsShowerTj", &stv.IsShowerTj);
-    showertree->Branch("ShowerID", &stv.ShowerID);
-    showertree->Branch("IsShowerParent", &stv.IsShowerParent);
-    showertree->Branch("StageNum", &stv.StageNum);
-    showertree->Branch("StageName", &stv.StageName);
+    showertree->Branch("PlaneNum", &fShowerTreeVars.PlaneNum);
+    showertree->Branch("TjID", &fShowerTreeVars.TjID);
+    showertree->Branch("IsShowerTj", &fShowerTreeVars.IsShowerTj);
+    showertree->Branch("ShowerID", &fShowerTreeVars.ShowerID);
+    showertree->Branch("IsShowerParent", &fShowerTreeVars.IsShowerParent);
+    showertree->Branch("StageNum", &fShowerTreeVars.StageNum);
+    showertree->Branch("StageName", &fShowerTreeVars.StageName);
 
-    showertree->Branch("Envelope", &stv.Envelope);
-    showertree->Branch("EnvPlane", &stv.EnvPlane);
-    showertree->Branch("EnvStage", &stv.EnvStage);
-    showertree->Branch("EnvShowerID", &stv.EnvShowerID);
+    showertree->Branch("Envelope", &fShowerTreeVars.Envelope);
+    showertree->Branch("EnvPlane", &fShowerTreeVars.EnvPlane);
+    showertree->Branch("EnvStage", &fShowerTreeVars.EnvStage);
+    showertree->Branch("EnvShowerID", &fShowerTreeVars.EnvShowerID);
 
-    showertree->Branch("nStages", &stv.nStages);
-    showertree->Branch("nPlanes", &stv.nPlanes);
+    showertree->Branch("nStages", &fShowerTreeVars.nStages);
+    showertree->Branch("nPlanes", &fShowerTreeVars.nPlanes);
 
   } // end DefineShTree
 
@@ -1215,12 +1498,13 @@ namespace tca {
   bool
   TrajClusterAlg::CreateSlice(detinfo::DetectorClocksData const& clockData,
                               detinfo::DetectorPropertiesData const& detProp,
+                              TCContext& tcx,
                               std::vector<unsigned int>& hitsInSlice,
                               int sliceID)
   {
-    // Defines a TCSlice struct and pushes the slice onto slices.
+    // Defines a TCSlice struct and pushes the slice onto tcx.slices.
     // Sets the isValid flag true if successful.
-    if ((*evt.allHits).empty()) return false;
+    if ((*tcx.evt.allHits).empty()) return false;
     if (hitsInSlice.size() < 2) return false;
 
     TCSlice slc;
@@ -1232,13 +1516,13 @@ namespace tca {
     unsigned int cnt = 0;
     std::vector<unsigned int> nHitsInPln;
     for (auto iht : hitsInSlice) {
-      if (iht >= (*evt.allHits).size()) return false;
-      auto& hit = (*evt.allHits)[iht];
+      if (iht >= (*tcx.evt.allHits).size()) return false;
+      auto& hit = (*tcx.evt.allHits)[iht];
       if (first) {
         cstat = hit.WireID().Cryostat;
         tpc = hit.WireID().TPC;
         slc.TPCID = geo::TPCID(cstat, tpc);
-        nHitsInPln.resize(tcc.geom->Nplanes(slc.TPCID));
+        nHitsInPln.resize(tcx.tcc.geom->Nplanes(slc.TPCID));
         first = false;
       }
       if (hit.WireID().Cryostat != cstat || hit.WireID().TPC != tpc) return false;
@@ -1250,16 +1534,17 @@ namespace tca {
     for (auto hip : nHitsInPln)
       if (hip < 2) return false;
     // Define the TCEvent wire hit range vector for this new TPC for ALL hits
-    FillWireHitRange(slc.TPCID);
+    FillWireHitRange(tcx, slc.TPCID);
     // next define the Slice wire hit range vectors, UnitsPerTick, etc for this
     // slice
-    if (!FillWireHitRange(clockData, detProp, slc)) return false;
+    if (!FillWireHitRange(clockData, detProp, tcx, slc)) return false;
     slc.isValid = true;
-    slices.push_back(slc);
-    if (tcc.modes[kDebug] && debug.Slice >= 0 && !tcc.dbgSlc) {
-      tcc.dbgSlc = ((int)(slices.size() - 1) == debug.Slice);
-      if (tcc.dbgSlc) std::cout << "Enabled debugging in sub-slice " << slices.size() - 1 << "\n";
-      if (tcc.modes[kDebug] && (unsigned int)debug.Cryostat == cstat &&
+    tcx.slices.push_back(slc);
+    if (tcx.tcc.modes[kDebug] && debug.Slice >= 0 && !tcx.tcc.dbgSlc) {
+      tcx.tcc.dbgSlc = ((int)(tcx.slices.size() - 1) == debug.Slice);
+      if (tcx.tcc.dbgSlc)
+        std::cout << "Enabled debugging in sub-slice " << tcx.slices.size() - 1 << "\n";
+      if (tcx.tcc.modes[kDebug] && (unsigned int)debug.Cryostat == cstat &&
           (unsigned int)debug.TPC == tpc && debug.Plane >= 0) {
         debug.CTP = EncodeCTP(
           (unsigned int)debug.Cryostat, (unsigned int)debug.TPC, (unsigned int)debug.Plane);
@@ -1268,8 +1553,8 @@ namespace tca {
     // do a sanity check
     for (unsigned int iht = 0; iht < slc.slHits.size(); ++iht) {
       unsigned int ahi = slc.slHits[iht].allHitsIndex;
-      if (ahi >= (*evt.allHits).size()) {
-        std::cout << "CreateSlice: Bad allHitsIndex " << ahi << " " << (*evt.allHits).size()
+      if (ahi >= (*tcx.evt.allHits).size()) {
+        std::cout << "CreateSlice: Bad allHitsIndex " << ahi << " " << (*tcx.evt.allHits).size()
                   << "\n";
         return false;
       }
@@ -1279,15 +1564,17 @@ namespace tca {
 
   /////////////////////////////////////////
   void
-  TrajClusterAlg::FinishEvent()
+  TrajClusterAlg::FinishEvent(TCContext& tcx)
   {
     // final steps that involve correlations between slices
     // Stitch PFParticles between TPCs
 
     // define the PFP TjUIDs vector before calling StitchPFPs
-    for (auto& slc : slices) {
+    for (auto& slc : tcx.slices) {
       if (!slc.isValid) continue;
-      MakePFPTjs(slc);
+      slc.ids = tcx.ids;
+      MakePFPTjs(tcx, slc);
+      tcx.ids = slc.ids;
       for (auto& pfp : slc.pfps) {
         if (pfp.ID <= 0) continue;
         pfp.TjUIDs.resize(pfp.TjIDs.size());
@@ -1305,10 +1592,13 @@ namespace tca {
       }   // pfp
     }     // slc
 
-    StitchPFPs();
+    StitchPFPs(tcx);
     // Ensure that all PFParticles have a start vertex
-    for (auto& slc : slices)
+    for (auto& slc : tcx.slices) {
+      slc.ids = tcx.ids;
       PFPVertexCheck(slc);
+      tcx.ids = slc.ids;
+    } // slc
   } // FinishEvent
 
 } // namespace cluster
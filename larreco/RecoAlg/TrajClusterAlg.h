@@ -38,43 +38,52 @@ namespace tca {
   public:
     explicit TrajClusterAlg(fhicl::ParameterSet const& pset);
 
-    bool SetInputHits(std::vector<recob::Hit> const& inputHits,
+    /// Returns the context to reconstruct a new event with, which refers to the
+    /// configuration, event inputs and shower tree variables of this algorithm
+    TCContext
+    NewContext()
+    {
+      return TCContext{fConfig, fEvent, fShowerTreeVars};
+    }
+
+    bool SetInputHits(TCContext& tcx,
+                      std::vector<recob::Hit> const& inputHits,
                       unsigned int run,
                       unsigned int event);
     void
-    SetInputSpts(std::vector<recob::SpacePoint> const& sptHandle)
+    SetInputSpts(TCContext& tcx, std::vector<recob::SpacePoint> const& sptHandle)
     {
-      evt.sptHandle = &sptHandle;
+      tcx.evt.sptHandle = &sptHandle;
     }
-    void SetSourceHits(std::vector<recob::Hit> const& srcHits);
+    void SetSourceHits(TCContext& tcx, std::vector<recob::Hit> const& srcHits);
     void
-    ExpectSlicedHits()
+    ExpectSlicedHits(TCContext& tcx)
     {
-      evt.expectSlicedHits = true;
+      tcx.evt.expectSlicedHits = true;
     }
+    /// Reconstructs a slice of hits and appends it to tcx.slices
     void RunTrajClusterAlg(detinfo::DetectorClocksData const& clockData,
                            detinfo::DetectorPropertiesData const& detProp,
+                           TCContext& tcx,
                            std::vector<unsigned int>& hitsInSlice,
                            int sliceID);
+    /// Reconstructs the slices of hits in one TPC, concurrently if RunParallel is set.
+    /// The result is the same as calling RunTrajClusterAlg for each slice in turn
+    void RunTrajClusterAlg(detinfo::DetectorClocksData const& clockData,
+                           detinfo::DetectorPropertiesData const& detProp,
+                           TCContext& tcx,
+                           std::vector<std::vector<unsigned int>>& tpcSliceHits,
+                           std::vector<int> const& sliceIDs);
     bool CreateSlice(detinfo::DetectorClocksData const& clockData,
                      detinfo::DetectorPropertiesData const& detProp,
+                     TCContext& tcx,
                      std::vector<unsigned int>& hitsInSlice,
                      int sliceID);
-    void FinishEvent();
+    void FinishEvent(TCContext& tcx);
 
     void DefineShTree(TTree* t);
-
-    unsigned short
-    GetSlicesSize() const
-    {
-      return slices.size();
-    }
-    TCSlice const&
-    GetSlice(unsigned short sliceIndex) const
-    {
-      return slices[sliceIndex];
-    }
-    void MergeTPHits(std::vector<unsigned int>& tpHits,
+    void MergeTPHits(TCContext& tcx,
+                     std::vector<unsigned int>& tpHits,
                      std::vector<recob::Hit>& newHitCol,
                      std::vector<unsigned int>& newHitAssns) const;
 
@@ -91,15 +100,18 @@ namespace tca {
 
     /// Deletes all the results
     void
-    ClearResults()
+    ClearResults(TCContext& tcx)
     {
-      slices.resize(0);
-      evt.sptHits.resize(0);
-      evt.wireHitRange.resize(0);
+      tcx.evt.sptHits.resize(0);
+      tcx.evt.wireHitRange.resize(0);
     }
 
   private:
-    recob::Hit MergeTPHitsOnWire(std::vector<unsigned int>& tpHits) const;
+    recob::Hit MergeTPHitsOnWire(TCContext& tcx, std::vector<unsigned int>& tpHits) const;
+
+    TCConfig fConfig;                ///< the configuration
+    TCEvent fEvent;                  ///< the event inputs, some of which are kept between events
+    ShowerTreeVars fShowerTreeVars;  ///< the variables of the shower tree
 
     // SHOWER VARIABLE TREE
     TTree* showertree;
@@ -108,14 +120,36 @@ namespace tca {
     TMVA::Reader fMVAReader;
 
     std::vector<unsigned int> fAlgModCount;
+    bool fRunParallel;   ///< reconstruct the slices in a TPC concurrently
+    bool fCheckParallel; ///< also reconstruct them serially and compare the results
+
+    bool CanRunParallel() const;
+    void RunParallel(detinfo::DetectorClocksData const& clockData,
+                     detinfo::DetectorPropertiesData const& detProp,
+                     TCContext& tcx,
+                     std::vector<std::vector<unsigned int>>& tpcSliceHits,
+                     std::vector<int> const& sliceIDs);
+    bool ReconstructSlice(detinfo::DetectorClocksData const& clockData,
+                          detinfo::DetectorPropertiesData const& detProp,
+                          TCContext& tcx,
+                          TCSlice& slc);
+    bool FinishSlice(detinfo::DetectorPropertiesData const& detProp,
+                     TCContext& tcx,
+                     TCSlice& slc);
+    void AddIDOffsets(TCIDs const& offsets, TCSlice& slc) const;
+    void CountAlgs(TCSlice const& slc);
+    bool SameResults(TCContext const& serial,
+                     TCContext const& parallel,
+                     std::size_t firstSlice) const;
 
     void ReconstructAllTraj(detinfo::DetectorPropertiesData const& detProp,
+                            TCContext& tcx,
                             TCSlice& slc,
                             CTP_t inCTP);
     // Finds junk trajectories using unassigned hits
-    void FindJunkTraj(TCSlice& slc, CTP_t inCTP);
+    void FindJunkTraj(TCContext& tcx, TCSlice& slc, CTP_t inCTP);
     // Check allTraj -> inTraj associations
-    void ChkInTraj(std::string someText, TCSlice& slc);
+    void ChkInTraj(std::string someText, TCContext& tcx, TCSlice& slc);
 
   }; // class TrajClusterAlg
 
@@ -3,10 +3,22 @@
 #include "TMatrixDSym.h"
 #include "TMatrixDSymEigen.h"
 
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
 using namespace std;
 using namespace trkf;
 using namespace recob::tracking;
 
+namespace {
+  // the points of the coarse scan are every coarse-th point of the grid and its last point
+  int nextCoarsePoint(const int k, const int coarse, const int n) {
+    return (k==n-1 ? n : std::min(k+coarse, n-1));
+  }
+}
+
 recob::MCSFitResult TrajectoryMCSFitter::fitMcs(const recob::TrackTrajectory& traj, int pid, bool momDepConst) const {
   //
   // Break the trajectory in segments of length approximately equal to segLen_
@@ -46,8 +58,12 @@ recob::MCSFitResult TrajectoryMCSFitter::fitMcs(const recob::TrackTrajectory& tr
     cumLenFwd.push_back(cumseglens[i]);
     cumLenBwd.push_back(cumseglens.back()-cumseglens[i+2]);
   }
-  const ScanResult fwdResult = doLikelihoodScan(dtheta, segradlengths, cumLenFwd, true,  momDepConst, pid);
-  const ScanResult bwdResult = doLikelihoodScan(dtheta, segradlengths, cumLenBwd, false, momDepConst, pid);
+  const std::pair<ScanResult, ScanResult> results = ( scanMode_==1 ?
+    doFastLikelihoodScans(dtheta, segradlengths, cumLenFwd, cumLenBwd, momDepConst, pid) :
+    std::make_pair(doLikelihoodScan(dtheta, segradlengths, cumLenFwd, true,  momDepConst, pid),
+                   doLikelihoodScan(dtheta, segradlengths, cumLenBwd, false, momDepConst, pid)) );
+  const ScanResult& fwdResult = results.first;
+  const ScanResult& bwdResult = results.second;
   //
   return recob::MCSFitResult(pid,
 			     fwdResult.p,fwdResult.pUnc,fwdResult.logL,
@@ -132,6 +148,115 @@ const TrajectoryMCSFitter::ScanResult TrajectoryMCSFitter::doLikelihoodScan(std:
   return ScanResult(best_p, std::max(lunc,runc), best_logL);
 }
 
+std::pair<TrajectoryMCSFitter::ScanResult, TrajectoryMCSFitter::ScanResult> TrajectoryMCSFitter::doFastLikelihoodScans(std::vector<float>& dtheta, std::vector<float>& seg_nradlengths, std::vector<float>& cumLenFwd, std::vector<float>& cumLenBwd, bool momDepConst, int pid) const {
+  //
+  // same momentum values as in doLikelihoodScan
+  std::vector<double> grid;
+  for (double p_test = pMin_; p_test <= pMax_; p_test+=pStep_) grid.push_back(p_test);
+  const int n = grid.size();
+  if (n==0) {
+    const ScanResult noResult(-1.0, -1.0, std::numeric_limits<double>::max());
+    return std::make_pair(noResult, noResult);
+  }
+  //
+  // coarse scan of both fits, then every coarse-th grid point and the last one are known
+  const int coarse = std::max(1, int(std::lround(pStepCoarse_/pStep_)));
+  std::vector<double> vlogLFwd(n, std::numeric_limits<double>::quiet_NaN());
+  std::vector<double> vlogLBwd(n, std::numeric_limits<double>::quiet_NaN());
+  for (int k = 0; k < n; k = nextCoarsePoint(k, coarse, n)) {
+    mcsLikelihoods(grid[k], angResol_, dtheta, seg_nradlengths, cumLenFwd, cumLenBwd, momDepConst, pid, vlogLFwd[k], vlogLBwd[k]);
+  }
+  //
+  return std::make_pair(refineLikelihoodScan(grid, vlogLFwd, coarse, dtheta, seg_nradlengths, cumLenFwd, true,  momDepConst, pid),
+                        refineLikelihoodScan(grid, vlogLBwd, coarse, dtheta, seg_nradlengths, cumLenBwd, false, momDepConst, pid));
+}
+
+const TrajectoryMCSFitter::ScanResult TrajectoryMCSFitter::refineLikelihoodScan(const std::vector<double>& grid, std::vector<double>& vlogL, int coarse, std::vector<float>& dtheta, std::vector<float>& seg_nradlengths, std::vector<float>& cumLen, bool fwdFit, bool momDepConst, int pid) const {
+  //
+  // vlogL holds the likelihood at the grid points computed so far, NaN for the others
+  const int n = grid.size();
+  auto logL = [&](int k) {
+    if (std::isnan(vlogL[k])) vlogL[k] = mcsLikelihood(grid[k], angResol_, dtheta, seg_nradlengths, cumLen, fwdFit, momDepConst, pid);
+    return vlogL[k];
+  };
+  //
+  // best point of the coarse scan
+  int    best_idx  = -1;
+  double best_logL = std::numeric_limits<double>::max();
+  for (int k = 0; k < n; k = nextCoarsePoint(k, coarse, n)) {
+    if (vlogL[k] < best_logL) {
+      best_logL = vlogL[k];
+      best_idx  = k;
+    }
+  }
+  if (best_idx<0) return ScanResult(-1.0, -1.0, best_logL);
+  //
+  // golden section search between the neighbouring coarse points
+  constexpr double invphi = 0.6180339887498949;
+  int lo = std::max(0, best_idx-coarse);
+  int hi = std::min(n-1, best_idx+coarse);
+  while (hi-lo > 3) {
+    const int c1 = hi - int(std::lround(invphi*(hi-lo)));
+    const int c2 = std::max(c1+1, lo + int(std::lround(invphi*(hi-lo))));
+    if (logL(c1) < logL(c2)) hi = c2;
+    else lo = c1;
+  }
+  for (int k = lo; k <= hi; ++k) {
+    const double l = logL(k);
+    if (l < best_logL || (l == best_logL && k < best_idx)) {
+      best_logL = l;
+      best_idx  = k;
+    }
+  }
+  //
+  // the uncertainties are defined by the first grid point on each side with dLL >= 0.5 as in
+  // doLikelihoodScan (where dLL is in single precision); it is bracketed in coarse steps and then
+  // found by bisection
+  auto inside = [&](int k) {
+    const double l = logL(k);
+    return (l != std::numeric_limits<double>::max() && float(l)-float(best_logL) < 0.5);
+  };
+  double lunc = -1.0;
+  if (best_idx>0) {
+    int good = best_idx;
+    int bad  = -1;
+    for (int k = std::max(0, best_idx-coarse); ; k = std::max(0, k-coarse)) {
+      if (!inside(k)) {
+	bad = k;
+	break;
+      }
+      good = k;
+      if (k==0) break;
+    }
+    while (bad>=0 && good-bad>1) {
+      const int mid = (good+bad)/2;
+      if (inside(mid)) good = mid;
+      else bad = mid;
+    }
+    if (good<best_idx) lunc = (best_idx-good)*pStep_;
+  }
+  double runc = -1.0;
+  if (best_idx<n-1) {
+    int good = best_idx;
+    int bad  = n;
+    for (int k = std::min(n-1, best_idx+coarse); ; k = std::min(n-1, k+coarse)) {
+      if (!inside(k)) {
+	bad = k;
+	break;
+      }
+      good = k;
+      if (k==n-1) break;
+    }
+    while (bad<n && bad-good>1) {
+      const int mid = (good+bad)/2;
+      if (inside(mid)) good = mid;
+      else bad = mid;
+    }
+    if (good>best_idx) runc = (good-best_idx)*pStep_;
+  }
+  return ScanResult(grid[best_idx], std::max(lunc,runc), best_logL);
+}
+
 void TrajectoryMCSFitter::linearRegression(const recob::TrackTrajectory& traj, const size_t firstPoint, const size_t lastPoint, Vector_t& pcdir) const {
   //
   int npoints = 0;
@@ -197,7 +322,6 @@ double TrajectoryMCSFitter::mcsLikelihood(double p, double theta0x, std::vector<
   const double Etot = sqrt(p*p + m2);//Initial energy
   double Eij2 = 0.;
   //
-  double const fixedterm = 0.5 * std::log( 2.0 * M_PI );
   double result = 0;
   for (int i = beg; i != end; i+=incr ) {
     if (dthetaij[i]<0) {
@@ -216,25 +340,77 @@ double TrajectoryMCSFitter::mcsLikelihood(double p, double theta0x, std::vector<
       Eij2 = Eij*Eij;
     }
     //
-    if ( Eij2 <= m2 ) {
-      result = std::numeric_limits<double>::max();
+    const double segL = segmentLikelihood(Eij2, m2, theta0x, dthetaij[i], seg_nradl[i], momDepConst);
+    if (segL == std::numeric_limits<double>::max()) return segL;
+    result += segL;
+  }
+  return result;
+}
+
+void TrajectoryMCSFitter::mcsLikelihoods(double p, double theta0x, const std::vector<float>& dthetaij, const std::vector<float>& seg_nradl, const std::vector<float>& cumLenFwd, const std::vector<float>& cumLenBwd, bool momDepConst, int pid, double& logLFwd, double& logLBwd) const {
+  //
+  const int nseg = dthetaij.size();
+  const double m = mass(pid);
+  const double m2 = m*m;
+  const double Etot = sqrt(p*p + m2);//Initial energy
+  //
+  // energies at the fwd segments followed by the bwd ones
+  std::vector<double> Eij(2*nseg);
+  if (eLossMode_==1) {
+    // ELoss mode: MIP (constant)
+    constexpr double kcal = 0.002105;
+    for (int i = 0; i < nseg; ++i) {
+      Eij[i]      = Etot - kcal*cumLenFwd[i];
+      Eij[nseg+i] = Etot - kcal*cumLenBwd[i];
+    }
+  } else {
+    // Non constant energy loss distribution
+    std::vector<float> cumLen(cumLenFwd.begin(), cumLenFwd.begin()+nseg);
+    cumLen.insert(cumLen.end(), cumLenBwd.begin(), cumLenBwd.begin()+nseg);
+    GetE(Etot, cumLen, m, Eij);
+  }
+  //
+  // sum in the same order as mcsLikelihood
+  logLFwd = 0.;
+  for (int i = 0; i < nseg; ++i) {
+    if (dthetaij[i]<0) continue;
+    const double segL = segmentLikelihood(Eij[i]*Eij[i], m2, theta0x, dthetaij[i], seg_nradl[i], momDepConst);
+    if (segL == std::numeric_limits<double>::max()) {
+      logLFwd = segL;
       break;
     }
-    const double pij = sqrt(Eij2 - m2);//momentum at this segment
-    const double beta = sqrt( 1. - ((m2)/(pij*pij + m2)) );
-    constexpr double tuned_HL_term1 = 11.0038; // https://arxiv.org/abs/1703.06187
-    constexpr double HL_term2 = 0.038;
-    const double tH0 = ( (momDepConst ? MomentumDependentConstant(pij) : tuned_HL_term1) / (pij*beta) ) * ( 1.0 + HL_term2 * std::log( seg_nradl[i] ) ) * sqrt( seg_nradl[i] );
-    const double rms = sqrt( 2.0*( tH0 * tH0 + theta0x * theta0x ) );
-    if (rms==0.0) {
-      std::cout << " Error : RMS cannot be zero ! " << std::endl;
-      return std::numeric_limits<double>::max();
+    logLFwd += segL;
+  }
+  logLBwd = 0.;
+  for (int i = nseg-1; i >= 0; --i) {
+    if (dthetaij[i]<0) continue;
+    const double segL = segmentLikelihood(Eij[nseg+i]*Eij[nseg+i], m2, theta0x, dthetaij[i], seg_nradl[i], momDepConst);
+    if (segL == std::numeric_limits<double>::max()) {
+      logLBwd = segL;
+      break;
     }
-    const double arg = dthetaij[i]/rms;
-    result += ( std::log( rms ) + 0.5 * arg * arg + fixedterm);
-    // if (print && fwd==true) cout << "TrajectoryMCSFitter pij=" << pij << " dthetaij[i]=" << dthetaij[i] << " tH0=" << tH0 << " rms=" << rms << " prob=" << ( std::log( rms ) + 0.5 * arg * arg + fixedterm) << " const=" << (momDepConst ? MomentumDependentConstant(pij) : tuned_HL_term1) << " beta=" << beta << " red_length=" << seg_nradl[i] << endl;
+    logLBwd += segL;
   }
-  return result;
+}
+
+double TrajectoryMCSFitter::segmentLikelihood(const double Eij2, const double m2, const double theta0x, const float dthetaij, const float seg_nradl, bool momDepConst) const {
+  //
+  // -log of the likelihood of the scattering angle dthetaij for the energy Eij at this segment
+  //
+  if ( Eij2 <= m2 ) return std::numeric_limits<double>::max();
+  double const fixedterm = 0.5 * std::log( 2.0 * M_PI );
+  const double pij = sqrt(Eij2 - m2);//momentum at this segment
+  const double beta = sqrt( 1. - ((m2)/(pij*pij + m2)) );
+  constexpr double tuned_HL_term1 = 11.0038; // https://arxiv.org/abs/1703.06187
+  constexpr double HL_term2 = 0.038;
+  const double tH0 = ( (momDepConst ? MomentumDependentConstant(pij) : tuned_HL_term1) / (pij*beta) ) * ( 1.0 + HL_term2 * std::log( seg_nradl ) ) * sqrt( seg_nradl );
+  const double rms = sqrt( 2.0*( tH0 * tH0 + theta0x * theta0x ) );
+  if (rms==0.0) {
+    std::cout << " Error : RMS cannot be zero ! " << std::endl;
+    return std::numeric_limits<double>::max();
+  }
+  const double arg = dthetaij/rms;
+  return ( std::log( rms ) + 0.5 * arg * arg + fixedterm);
 }
 
 double TrajectoryMCSFitter::energyLossLandau(const double mass2,const double e2, const double x) const {
@@ -301,3 +477,27 @@ double TrajectoryMCSFitter::GetE(const double initial_E, const double length_tra
   }
   return current_E;
 }
+//
+void TrajectoryMCSFitter::GetE(const double initial_E, const std::vector<float>& length_travelled, const double m, std::vector<double>& E) const {
+  //
+  // the steps of GetE are done for all lengths together; the loop over the lengths is the inner one
+  const size_t n = length_travelled.size();
+  std::vector<double> step_size(n);
+  for (size_t i = 0; i < n; ++i) step_size[i] = double(length_travelled[i]) / nElossSteps_;
+  E.assign(n, initial_E);
+  //
+  const double m2 = m*m;
+  for (auto istep = 0; istep < nElossSteps_; ++istep) {
+    for (size_t i = 0; i < n; ++i) {
+      if (E[i] == 0.) continue;
+      if (eLossMode_==2) {
+	double dedx = energyLossBetheBloch(m,E[i]);
+	E[i] -= (dedx * step_size[i]);
+      } else {
+	// MPV of Landau energy loss distribution
+	E[i] -= energyLossLandau(m2,E[i]*E[i],step_size[i]);
+      }
+      if ( E[i] <= m ) E[i] = 0.;
+    }
+  }
+}
@@ -9,6 +9,9 @@
 #include "lardataobj/RecoBase/Track.h"
 #include "lardata/RecoObjects/TrackState.h"
 
+#include <utility>
+#include <vector>
+
 namespace trkf {
   /**
    * @file  larreco/RecoAlg/TrajectoryMCSFitter.h
@@ -87,10 +90,20 @@ namespace trkf {
 	Comment("Angular resolution parameter used in modified Highland formula. Unit is mrad."),
 	3.0
       };
+      fhicl::Atom<int> scanMode {
+        Name("scanMode"),
+	Comment("Default is a full likelihood scan from pMin to pMax in steps of pStep. Choose 1 for a scan in steps of pStepCoarse, refined with a golden section search on the pStep grid."),
+	0
+      };
+      fhicl::Atom<double> pStepCoarse {
+        Name("pStepCoarse"),
+	Comment("Step in momentum value of the coarse likelihood scan (scanMode 1)."),
+	0.1
+      };
     };
     using Parameters = fhicl::Table<Config>;
     //
-    TrajectoryMCSFitter(int pIdHyp, int minNSegs, double segLen, int minHitsPerSegment, int nElossSteps, int eLossMode, double pMin, double pMax, double pStep, double angResol){
+    TrajectoryMCSFitter(int pIdHyp, int minNSegs, double segLen, int minHitsPerSegment, int nElossSteps, int eLossMode, double pMin, double pMax, double pStep, double angResol, int scanMode = 0, double pStepCoarse = 0.1){
       pIdHyp_ = pIdHyp;
       minNSegs_ = minNSegs;
       segLen_ = segLen;
@@ -101,9 +114,11 @@ namespace trkf {
       pMax_ = pMax;
       pStep_ = pStep;
       angResol_ = angResol;
+      scanMode_ = scanMode;
+      pStepCoarse_ = pStepCoarse;
     }
     explicit TrajectoryMCSFitter(const Parameters & p)
-      : TrajectoryMCSFitter(p().pIdHypothesis(),p().minNumSegments(),p().segmentLength(),p().minHitsPerSegment(),p().nElossSteps(),p().eLossMode(),p().pMin(),p().pMax(),p().pStep(),p().angResol()) {}
+      : TrajectoryMCSFitter(p().pIdHypothesis(),p().minNumSegments(),p().segmentLength(),p().minHitsPerSegment(),p().nElossSteps(),p().eLossMode(),p().pMin(),p().pMax(),p().pStep(),p().angResol(),p().scanMode(),p().pStepCoarse()) {}
     //
     recob::MCSFitResult fitMcs(const recob::TrackTrajectory& traj, bool momDepConst = true) const { return fitMcs(traj,pIdHyp_,momDepConst); }
     recob::MCSFitResult fitMcs(const recob::Track& track,          bool momDepConst = true) const { return fitMcs(track,pIdHyp_,momDepConst); }
@@ -120,6 +135,8 @@ namespace trkf {
     void breakTrajInSegments(const recob::TrackTrajectory& traj, std::vector<size_t>& breakpoints, std::vector<float>& segradlengths, std::vector<float>& cumseglens) const;
     void linearRegression(const recob::TrackTrajectory& traj, const size_t firstPoint, const size_t lastPoint, recob::tracking::Vector_t& pcdir) const;
     double mcsLikelihood(double p, double theta0x, std::vector<float>& dthetaij, std::vector<float>& seg_nradl, std::vector<float>& cumLen, bool fwd, bool momDepConst, int pid) const;
+    /// Same as mcsLikelihood for the fwd and bwd fits, with the energy loss of all segments integrated in one pass
+    void mcsLikelihoods(double p, double theta0x, const std::vector<float>& dthetaij, const std::vector<float>& seg_nradl, const std::vector<float>& cumLenFwd, const std::vector<float>& cumLenBwd, bool momDepConst, int pid, double& logLFwd, double& logLBwd) const;
     //
     struct ScanResult {
       public:
@@ -128,6 +145,9 @@ namespace trkf {
     };
     //
     const ScanResult doLikelihoodScan(std::vector<float>& dtheta, std::vector<float>& seg_nradlengths, std::vector<float>& cumLen, bool fwdFit, bool momDepConst, int pid) const;
+    /// Fwd and bwd fits on the grid of doLikelihoodScan, evaluating the likelihood only at the points needed to
+    /// find the minimum and the uncertainty when the likelihood has a single minimum
+    std::pair<ScanResult, ScanResult> doFastLikelihoodScans(std::vector<float>& dtheta, std::vector<float>& seg_nradlengths, std::vector<float>& cumLenFwd, std::vector<float>& cumLenBwd, bool momDepConst, int pid) const;
     //
     inline double MomentumDependentConstant(const double p) const {
       //these are from https://arxiv.org/abs/1703.06187
@@ -146,8 +166,13 @@ namespace trkf {
     double energyLossLandau(const double mass2,const double E2, const double x) const;
     //
     double GetE(const double initial_E, const double length_travelled, const double mass) const;
+    /// GetE for several lengths at once; E[i] is the energy after length_travelled[i]
+    void GetE(const double initial_E, const std::vector<float>& length_travelled, const double mass, std::vector<double>& E) const;
     //
   private:
+    double segmentLikelihood(const double Eij2, const double m2, const double theta0x, const float dthetaij, const float seg_nradl, bool momDepConst) const;
+    const ScanResult refineLikelihoodScan(const std::vector<double>& grid, std::vector<double>& vlogL, int coarse, std::vector<float>& dtheta, std::vector<float>& seg_nradlengths, std::vector<float>& cumLen, bool fwdFit, bool momDepConst, int pid) const;
+    //
     int    pIdHyp_;
     int    minNSegs_;
     double segLen_;
@@ -158,6 +183,8 @@ namespace trkf {
     double pMax_;
     double pStep_;
     double angResol_;
+    int    scanMode_;
+    double pStepCoarse_;
   };
 }
 
@@ -0,0 +1,360 @@
+#include "PackedSolver.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <unordered_map>
+
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+template<class T> T sqr(T x){return x*x;}
+
+// ---------------------------------------------------------------------------
+PackedSolver::PackedSolver(const std::vector<CollectionWireHit*>& cwires,
+                           const std::vector<SpaceCharge*>& orphanSCs)
+{
+  std::unordered_map<const SpaceCharge*, unsigned int> scIdx;
+  std::unordered_map<const InductionWireHit*, int> iwIdx;
+
+  auto addIWire = [&](InductionWireHit* iwire, bool inCWire) -> int
+    {
+      if(!iwire) return -1;
+      auto it = iwIdx.find(iwire);
+      if(it == iwIdx.end()){
+        it = iwIdx.emplace(iwire, fIWires.size()).first;
+        fIWires.push_back(iwire);
+        fIWCharge.push_back(iwire->fCharge);
+        fIWPred.push_back(iwire->fPred);
+        fIWInCWire.push_back(false);
+      }
+      if(inCWire) fIWInCWire[it->second] = true;
+      return it->second;
+    };
+
+  auto addSC = [&](SpaceCharge* sc, bool inCWire)
+    {
+      scIdx[sc] = fSCs.size();
+      fSCs.push_back(sc);
+      fPred.push_back(sc->fPred);
+      fNeiPotential.push_back(sc->fNeiPotential);
+      fWire1.push_back(addIWire(sc->fWire1, inCWire));
+      fWire2.push_back(addIWire(sc->fWire2, inCWire));
+    };
+
+  fCWOffset.reserve(cwires.size()+1);
+  for(const CollectionWireHit* cwire: cwires){
+    fCWOffset.push_back(fSCs.size());
+    for(SpaceCharge* sc: cwire->fCrossings) addSC(sc, true);
+  }
+  fCWOffset.push_back(fSCs.size());
+
+  for(SpaceCharge* sc: orphanSCs) addSC(sc, false);
+
+  // Now all the indices are known we can fill the neighbours
+  fNeiOffset.reserve(fSCs.size()+1);
+  for(const SpaceCharge* sc: fSCs){
+    fNeiOffset.push_back(fNeiIdx.size());
+    for(const Neighbour& nei: sc->fNeighbours){
+      fNeiIdx.push_back(scIdx.at(nei.fSC));
+      fNeiCoupling.push_back(nei.fCoupling);
+    }
+  }
+  fNeiOffset.push_back(fNeiIdx.size());
+
+  ColourCWires();
+}
+
+// ---------------------------------------------------------------------------
+void PackedSolver::ColourCWires()
+{
+  const unsigned int Ncw = fCWOffset.size()-1;
+  const unsigned int Nsc = fSCs.size();
+
+  // The "resources" touched when updating a collection wire are its own
+  // SpaceCharges, their neighbours and their induction wires. Wires that
+  // share none of them are independent.
+  auto forEachResource = [this, Nsc](unsigned int cwire, auto&& f)
+    {
+      for(unsigned int sc = fCWOffset[cwire]; sc < fCWOffset[cwire+1]; ++sc){
+        f(sc);
+        if(fWire1[sc] >= 0) f(Nsc + fWire1[sc]);
+        if(fWire2[sc] >= 0) f(Nsc + fWire2[sc]);
+        for(unsigned int k = fNeiOffset[sc]; k < fNeiOffset[sc+1]; ++k) f(fNeiIdx[k]);
+      }
+    };
+
+  // Keep the "random" visiting order of Iterate() within each colour
+  std::vector<unsigned int> todo;
+  todo.reserve(Ncw);
+  unsigned int cwireIdx = 0;
+  if(Ncw > 0){
+    do{
+      todo.push_back(cwireIdx);
+      const unsigned int prime = 1299827;
+      cwireIdx = (cwireIdx+prime)%Ncw;
+    } while(cwireIdx != 0);
+  }
+
+  fColourOffset.assign(1, 0);
+  fColourCWires.clear();
+  fColourCWires.reserve(Ncw);
+
+  // Greedy colouring, 64 colours at a time. The wires that don't fit are
+  // coloured in another round, since colours are processed in sequence they
+  // only need to be independent of each other.
+  std::vector<uint64_t> used(Nsc + fIWires.size());
+  std::vector<std::vector<unsigned int>> colours(64);
+  while(!todo.empty()){
+    std::fill(used.begin(), used.end(), 0);
+    std::vector<unsigned int> overflow;
+
+    for(unsigned int cwire: todo){
+      uint64_t forbidden = 0;
+      forEachResource(cwire, [&](unsigned int r){forbidden |= used[r];});
+
+      if(forbidden == ~uint64_t(0)){
+        overflow.push_back(cwire);
+        continue;
+      }
+
+      const unsigned int colour = __builtin_ctzll(~forbidden);
+      forEachResource(cwire, [&](unsigned int r){used[r] |= uint64_t(1) << colour;});
+      colours[colour].push_back(cwire);
+    }
+
+    for(std::vector<unsigned int>& colour: colours){
+      if(colour.empty()) continue;
+      fColourCWires.insert(fColourCWires.end(), colour.begin(), colour.end());
+      fColourOffset.push_back(fColourCWires.size());
+      colour.clear();
+    }
+
+    todo.swap(overflow);
+  }
+}
+
+// ---------------------------------------------------------------------------
+void PackedSolver::AddCharge(unsigned int sc, double dq)
+{
+  fPred[sc] += dq;
+
+  for(unsigned int k = fNeiOffset[sc]; k < fNeiOffset[sc+1]; ++k)
+    fNeiPotential[fNeiIdx[k]] += dq * fNeiCoupling[k];
+
+  if(fWire1[sc] >= 0) fIWPred[fWire1[sc]] += dq;
+  if(fWire2[sc] >= 0) fIWPred[fWire2[sc]] += dq;
+}
+
+// ---------------------------------------------------------------------------
+double PackedSolver::Metric(double alpha) const
+{
+  double ret = 0;
+
+  for(unsigned int sc = 0; sc < fCWOffset.back(); ++sc){
+    if(alpha != 0){
+      ret -= alpha*sqr(fPred[sc]);
+      ret -= alpha * fPred[sc] * fNeiPotential[sc];
+    }
+  }
+
+  for(unsigned int iw = 0; iw < fIWCharge.size(); ++iw){
+    if(fIWInCWire[iw]) ret += sqr(fIWCharge[iw] - fIWPred[iw]);
+  }
+
+  return ret;
+}
+
+// ---------------------------------------------------------------------------
+QuadExpr PackedSolver::PairMetric(unsigned int sci, unsigned int scj,
+                                  double alpha) const
+{
+  // See Metric(const SpaceCharge*, const SpaceCharge*, double)
+  QuadExpr ret = 0;
+
+  // How much charge moves from scj to sci
+  QuadExpr x = QuadExpr::X();
+
+  if(alpha != 0){
+    const double scip = fPred[sci];
+    const double scjp = fPred[scj];
+
+    ret -= alpha*sqr(scip + x);
+    ret -= alpha*sqr(scjp - x);
+
+    ret -= 2 * alpha * (scip + x) * fNeiPotential[sci];
+    ret -= 2 * alpha * (scjp - x) * fNeiPotential[scj];
+
+    for(unsigned int k = fNeiOffset[sci]; k < fNeiOffset[sci+1]; ++k){
+      if(fNeiIdx[k] == scj){
+        ret += 2 * alpha * (scip + x) * scjp * fNeiCoupling[k];
+        ret += 2 * alpha * (scjp - x) * scip * fNeiCoupling[k];
+
+        ret -= 2 * alpha * (scip + x) * (scjp - x) * fNeiCoupling[k];
+        break;
+      }
+    }
+  }
+
+  const int iwires[2] = {fWire1[sci], fWire2[sci]};
+  const int jwires[2] = {fWire1[scj], fWire2[scj]};
+
+  for(int view = 0; view < 2; ++view){
+    const int iw = iwires[view];
+    const int jw = jwires[view];
+
+    if(iw == jw){
+      // Same wire means movement of charge cancels itself out
+      if(iw >= 0) ret += sqr(fIWCharge[iw] - fIWPred[iw]);
+    }
+    else{
+      if(iw >= 0) ret += sqr(fIWCharge[iw] - (fIWPred[iw] + x));
+      if(jw >= 0) ret += sqr(fIWCharge[jw] - (fIWPred[jw] - x));
+    }
+  }
+
+  return ret;
+}
+
+// ---------------------------------------------------------------------------
+QuadExpr PackedSolver::OrphanMetric(unsigned int sc, double alpha) const
+{
+  // See Metric(const SpaceCharge*, double)
+  QuadExpr ret = 0;
+
+  // How much charge is added to sc
+  QuadExpr x = QuadExpr::X();
+
+  if(alpha != 0){
+    const double scp = fPred[sc];
+
+    ret -= alpha*sqr(scp + x);
+    ret -= 2 * alpha * (scp + x) * fNeiPotential[sc];
+  }
+
+  ret += sqr(fIWCharge[fWire1[sc]] - (fIWPred[fWire1[sc]] + x));
+  ret += sqr(fIWCharge[fWire2[sc]] - (fIWPred[fWire2[sc]] + x));
+
+  return ret;
+}
+
+// ---------------------------------------------------------------------------
+double PackedSolver::SolvePair(unsigned int sci, unsigned int scj,
+                               double alpha) const
+{
+  const QuadExpr chisq = PairMetric(sci, scj, alpha);
+  const double chisq0 = chisq.Eval(0);
+
+  // Find the minimum of a quadratic expression
+  double x = -chisq.Linear()/(2*chisq.Quadratic());
+
+  // Don't allow either SpaceCharge to go negative
+  const double xmin = -fPred[sci];
+  const double xmax =  fPred[scj];
+
+  // Clamp to allowed range
+  x = std::min(xmax, x);
+  x = std::max(xmin, x);
+
+  const double chisq_new = chisq.Eval(x);
+
+  // The function might be convex, in which case the minimum is at one of the
+  // extremes of the range.
+  const double chisq_p = chisq.Eval(xmax);
+  const double chisq_n = chisq.Eval(xmin);
+
+  if(std::min(std::min(chisq_p, chisq_n), chisq_new) > chisq0+1){
+    std::cout << "Solution at " << x << " is worse than current state! Range " << xmin << " to " << xmax << std::endl;
+    std::cout << "Soln, original, up edge, low edge:" << std::endl;
+    std::cout << chisq_new << " " << chisq0 << " " << chisq_p << " " << chisq_n << std::endl;
+    abort();
+  }
+
+  if(std::min(chisq_n, chisq_p) < chisq_new){
+    if(chisq_n < chisq_p) return xmin;
+    return xmax;
+  }
+
+  return x;
+}
+
+// ---------------------------------------------------------------------------
+void PackedSolver::IterateCWire(unsigned int cwire, double alpha)
+{
+  // Consider all pairs of crossings
+  const unsigned int first = fCWOffset[cwire];
+  const unsigned int last = fCWOffset[cwire+1];
+
+  for(unsigned int sci = first; sci+1 < last; ++sci){
+    for(unsigned int scj = sci+1; scj < last; ++scj){
+      const double x = SolvePair(sci, scj, alpha);
+
+      if(x == 0) continue;
+
+      // Actually make the update
+      AddCharge(sci, +x);
+      AddCharge(scj, -x);
+    } // end for j
+  } // end for i
+}
+
+// ---------------------------------------------------------------------------
+void PackedSolver::IterateOrphan(unsigned int sc, double alpha)
+{
+  const QuadExpr chisq = OrphanMetric(sc, alpha);
+
+  // Find the minimum of a quadratic expression
+  double x = -chisq.Linear()/(2*chisq.Quadratic());
+
+  // Don't allow the SpaceCharge to go negative
+  const double xmin = -fPred[sc];
+
+  // Clamp to allowed range
+  x = std::max(xmin, x);
+
+  const double chisq_new = chisq.Eval(x);
+  const double chisq_n = chisq.Eval(xmin);
+
+  if(chisq_n < chisq_new)
+    AddCharge(sc, xmin);
+  else
+    AddCharge(sc, x);
+}
+
+// ---------------------------------------------------------------------------
+void PackedSolver::Iterate(double alpha, bool parallel)
+{
+  for(unsigned int colour = 0; colour+1 < fColourOffset.size(); ++colour){
+    const unsigned int first = fColourOffset[colour];
+    const unsigned int last = fColourOffset[colour+1];
+
+    if(parallel){
+      tbb::parallel_for(tbb::blocked_range<unsigned int>(first, last, 16),
+                        [this, alpha](const tbb::blocked_range<unsigned int>& r)
+                        {
+                          for(unsigned int i = r.begin(); i != r.end(); ++i)
+                            IterateCWire(fColourCWires[i], alpha);
+                        });
+    }
+    else{
+      for(unsigned int i = first; i < last; ++i)
+        IterateCWire(fColourCWires[i], alpha);
+    }
+  }
+
+  for(unsigned int sc = fCWOffset.back(); sc < fSCs.size(); ++sc)
+    IterateOrphan(sc, alpha);
+}
+
+// ---------------------------------------------------------------------------
+void PackedSolver::Unpack() const
+{
+  for(unsigned int sc = 0; sc < fSCs.size(); ++sc){
+    fSCs[sc]->fPred = fPred[sc];
+    fSCs[sc]->fNeiPotential = fNeiPotential[sc];
+  }
+
+  for(unsigned int iw = 0; iw < fIWires.size(); ++iw)
+    fIWires[iw]->fPred = fIWPred[iw];
+}
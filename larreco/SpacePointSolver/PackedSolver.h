@@ -0,0 +1,76 @@
+// Christopher Backhouse - bckhouse@fnal.gov
+
+#ifndef RECO3D_PACKEDSOLVER_H
+#define RECO3D_PACKEDSOLVER_H
+
+#include <vector>
+
+#include "Solver.h"
+
+/// The same minimization as Iterate() in Solver.h, but with the state of the
+/// system packed into flat arrays. The neighbours of each SpaceCharge, and the
+/// SpaceCharges of each collection wire, are stored in compressed row format.
+///
+/// Collection wires are coloured such that no two wires of the same colour
+/// share an induction wire or a (neighbouring) SpaceCharge. The wires of one
+/// colour can then be updated concurrently, and the result does not depend on
+/// whether they were or not.
+class PackedSolver
+{
+public:
+  PackedSolver(const std::vector<CollectionWireHit*>& cwires,
+               const std::vector<SpaceCharge*>& orphanSCs);
+
+  /// Equivalent to Metric(cwires, alpha)
+  double Metric(double alpha) const;
+
+  /// One pass over all the collection wires and then the orphans
+  void Iterate(double alpha, bool parallel);
+
+  /// Copy the charges back into the SpaceCharge and InductionWireHit objects
+  void Unpack() const;
+
+  unsigned int NColours() const {return fColourOffset.size()-1;}
+
+protected:
+  void AddCharge(unsigned int sc, double dq);
+
+  QuadExpr PairMetric(unsigned int sci, unsigned int scj, double alpha) const;
+  QuadExpr OrphanMetric(unsigned int sc, double alpha) const;
+
+  double SolvePair(unsigned int sci, unsigned int scj, double alpha) const;
+
+  void IterateCWire(unsigned int cwire, double alpha);
+  void IterateOrphan(unsigned int sc, double alpha);
+
+  void ColourCWires();
+
+  // Per SpaceCharge
+  std::vector<double> fPred;
+  std::vector<double> fNeiPotential;
+  std::vector<int> fWire1, fWire2; ///< Induction wire index, -1 if none
+
+  // Neighbours of SpaceCharge i are [fNeiOffset[i], fNeiOffset[i+1])
+  std::vector<unsigned int> fNeiOffset;
+  std::vector<unsigned int> fNeiIdx;
+  std::vector<double> fNeiCoupling;
+
+  // Per induction wire
+  std::vector<double> fIWCharge;
+  std::vector<double> fIWPred;
+  std::vector<bool> fIWInCWire; ///< Seen by a collection wire, ie in Metric()
+
+  // SpaceCharges of collection wire i are [fCWOffset[i], fCWOffset[i+1]), the
+  // orphans follow the last collection wire.
+  std::vector<unsigned int> fCWOffset;
+
+  // Collection wires of colour i are [fColourOffset[i], fColourOffset[i+1])
+  std::vector<unsigned int> fColourOffset;
+  std::vector<unsigned int> fColourCWires;
+
+  // To unpack into
+  std::vector<SpaceCharge*> fSCs;
+  std::vector<InductionWireHit*> fIWires;
+};
+
+#endif
@@ -3,8 +3,12 @@
 // Test file at Caltech: /nfs/raid11/dunesam/prodgenie_nu_dune10kt_1x2x6_mcc7.0/prodgenie_nu_dune10kt_1x2x6_63_20160811T171439_merged.root
 
 // C/C++ standard libraries
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <unordered_map>
 
 // framework libraries
 #include "art/Framework/Core/EDProducer.h"
@@ -29,6 +33,10 @@
 
 #include "larreco/SpacePointSolver/HitReaders/IHitReader.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+#include "PackedSolver.h"
 #include "Solver.h"
 #include "TripletFinder.h"
 
@@ -68,10 +76,7 @@ namespace reco3d {
                      bool incNei,
                      HitMap_t& hitmap) const;
 
-    void Minimize(const std::vector<CollectionWireHit*>& cwires,
-                  const std::vector<SpaceCharge*>& orphanSCs,
-                  double alpha,
-                  int maxiterations);
+    void Minimize(PackedSolver& solver, double alpha, int maxiterations) const;
 
     /// return whether the point was inserted (only happens when it has charge)
     bool AddSpacePoint(const SpaceCharge& sc,
@@ -101,6 +106,8 @@ namespace reco3d {
 
     int fMaxIterationsNoReg;
     int fMaxIterationsReg;
+    double fConvergenceTolerance;
+    bool fRunParallel;
 
     double fXHitOffset;
 
@@ -122,6 +129,8 @@ namespace reco3d {
     , fDistThreshDrift(pset.get<double>("WireIntersectThresholdDriftDir"))
     , fMaxIterationsNoReg(pset.get<int>("MaxIterationsNoReg"))
     , fMaxIterationsReg(pset.get<int>("MaxIterationsReg"))
+    , fConvergenceTolerance(pset.get<double>("ConvergenceTolerance", 1e-3))
+    , fRunParallel(pset.get<bool>("RunParallel", false))
     , fXHitOffset(pset.get<double>("XHitOffset"))
   {
     recob::ChargedSpacePointCollectionCreator::produces(producesCollector(), "pre");
@@ -147,90 +156,114 @@ namespace reco3d {
   {
     static const double kCritDist = 5;
 
-    // Could use a QuadTree or VPTree etc, but seems like overkill
-    class IntCoord {
-    public:
-      IntCoord(const SpaceCharge& sc)
-        : fX(sc.fX / kCritDist), fY(sc.fY / kCritDist), fZ(sc.fZ / kCritDist)
-      {}
-
-      bool
-      operator<(const IntCoord& i) const
-      {
-        return std::make_tuple(fX, fY, fZ) < std::make_tuple(i.fX, i.fY, i.fZ);
-      }
-
-      std::vector<IntCoord>
-      Neighbours() const
-      {
-        std::vector<IntCoord> ret;
-        for (int dx = -1; dx <= +1; ++dx) {
-          for (int dy = -1; dy <= +1; ++dy) {
-            for (int dz = -1; dz <= +1; ++dz) {
-              ret.push_back(IntCoord(fX + dx, fY + dy, fZ + dz));
-            }
-          }
-        }
-        return ret;
-      }
-
-    protected:
-      IntCoord(int x, int y, int z) : fX(x), fY(y), fZ(z) {}
+    // Could use a QuadTree or VPTree etc, but seems like overkill. Instead
+    // bin on an integer grid, the cells are at least kCritDist wide so only
+    // adjacent cells need to be searched.
+    auto cellCoord = [](double x) { return int(x / kCritDist); };
 
-      int fX, fY, fZ;
+    auto cellKey = [](int ix, int iy, int iz) {
+      const uint64_t offset = 1 << 20;
+      const uint64_t mask = (uint64_t(1) << 21) - 1;
+      return (((ix + offset) & mask) << 42) | (((iy + offset) & mask) << 21) |
+             ((iz + offset) & mask);
     };
 
-    std::map<IntCoord, std::vector<SpaceCharge*>> scMap;
-    for (SpaceCharge* sc : spaceCharges) {
-      scMap[IntCoord(*sc)].push_back(sc);
+    // Space charges ordered by cell, the order within a cell is the input one
+    std::vector<uint64_t> scKeys(spaceCharges.size());
+    for (size_t i = 0; i < spaceCharges.size(); ++i) {
+      const SpaceCharge* sc = spaceCharges[i];
+      scKeys[i] = cellKey(cellCoord(sc->fX), cellCoord(sc->fY), cellCoord(sc->fZ));
     }
 
-    std::cout << "Neighbour search..." << std::endl;
-
-    // Now that we know all the space charges, can go through and assign neighbours
-
-    int Ntests = 0;
-    int Nnei = 0;
-    for (SpaceCharge* sc1 : spaceCharges) {
-      IntCoord ic(*sc1);
-      for (IntCoord icn : ic.Neighbours()) {
-        for (SpaceCharge* sc2 : scMap[icn]) {
+    std::vector<unsigned int> cellOrder(spaceCharges.size());
+    for (size_t i = 0; i < cellOrder.size(); ++i)
+      cellOrder[i] = i;
+    std::stable_sort(cellOrder.begin(), cellOrder.end(), [&scKeys](unsigned int a, unsigned int b) {
+      return scKeys[a] < scKeys[b];
+    });
+
+    // Range of cellOrder occupied by each cell
+    std::unordered_map<uint64_t, std::pair<unsigned int, unsigned int>> cells;
+    cells.reserve(spaceCharges.size());
+    for (unsigned int i = 0; i < cellOrder.size(); ++i) {
+      auto it = cells.emplace(scKeys[cellOrder[i]], std::make_pair(i, i)).first;
+      it->second.second = i + 1;
+    }
 
-          ++Ntests;
+    std::cout << "Neighbour search..." << std::endl;
 
-          if (sc1 == sc2) continue;
-          double dist2 =
-            cet::sum_of_squares(sc1->fX - sc2->fX, sc1->fY - sc2->fY, sc1->fZ - sc2->fZ);
+    // Now that we know all the space charges, can go through and assign
+    // neighbours. Each space charge only modifies its own list.
+    std::atomic<long> Ntests(0);
+    std::atomic<long> Nnei(0);
 
-          if (dist2 > cet::square(kCritDist)) continue;
+    auto findNeighbours = [&](const tbb::blocked_range<size_t>& range) {
+      long nTests = 0;
+      long nNei = 0;
+      for (size_t i = range.begin(); i != range.end(); ++i) {
+        SpaceCharge* sc1 = spaceCharges[i];
+        const int ix = cellCoord(sc1->fX);
+        const int iy = cellCoord(sc1->fY);
+        const int iz = cellCoord(sc1->fZ);
 
-          if (dist2 == 0) {
-            std::cout << "ZERO DISTANCE SOMEHOW?" << std::endl;
-            std::cout << sc1->fCWire << " " << sc1->fWire1 << " " << sc1->fWire2 << std::endl;
-            std::cout << sc2->fCWire << " " << sc2->fWire1 << " " << sc2->fWire2 << std::endl;
-            std::cout << dist2 << " " << sc1->fX << " " << sc2->fX << " " << sc1->fY << " "
-                      << sc2->fY << " " << sc1->fZ << " " << sc2->fZ << std::endl;
-            continue;
-            dist2 = cet::square(kCritDist);
+        for (int dx = -1; dx <= +1; ++dx) {
+          for (int dy = -1; dy <= +1; ++dy) {
+            for (int dz = -1; dz <= +1; ++dz) {
+              auto cell = cells.find(cellKey(ix + dx, iy + dy, iz + dz));
+              if (cell == cells.end()) continue;
+
+              for (unsigned int k = cell->second.first; k < cell->second.second; ++k) {
+                SpaceCharge* sc2 = spaceCharges[cellOrder[k]];
+
+                ++nTests;
+
+                if (sc1 == sc2) continue;
+                double dist2 =
+                  cet::sum_of_squares(sc1->fX - sc2->fX, sc1->fY - sc2->fY, sc1->fZ - sc2->fZ);
+
+                if (dist2 > cet::square(kCritDist)) continue;
+
+                if (dist2 == 0) {
+                  std::cout << "ZERO DISTANCE SOMEHOW?" << std::endl;
+                  std::cout << sc1->fCWire << " " << sc1->fWire1 << " " << sc1->fWire2
+                            << std::endl;
+                  std::cout << sc2->fCWire << " " << sc2->fWire1 << " " << sc2->fWire2
+                            << std::endl;
+                  std::cout << dist2 << " " << sc1->fX << " " << sc2->fX << " " << sc1->fY << " "
+                            << sc2->fY << " " << sc1->fZ << " " << sc2->fZ << std::endl;
+                  continue;
+                }
+
+                ++nNei;
+
+                // This is a pretty random guess
+                const double coupling = exp(-sqrt(dist2) / 2);
+                sc1->fNeighbours.emplace_back(sc2, coupling);
+
+                if (isnan(1 / sqrt(dist2)) || isinf(1 / sqrt(dist2))) {
+                  std::cout << dist2 << " " << sc1->fX << " " << sc2->fX << " " << sc1->fY
+                            << " " << sc2->fY << " " << sc1->fZ << " " << sc2->fZ << std::endl;
+                  abort();
+                }
+              } // end for sc2
+            }
           }
+        } // end for neighbouring cells
 
-          ++Nnei;
+        // The neighbours lists use the most memory, so be careful to trim
+        sc1->fNeighbours.shrink_to_fit();
+      } // end for sc1
 
-          // This is a pretty random guess
-          const double coupling = exp(-sqrt(dist2) / 2);
-          sc1->fNeighbours.emplace_back(sc2, coupling);
+      Ntests += nTests;
+      Nnei += nNei;
+    };
 
-          if (isnan(1 / sqrt(dist2)) || isinf(1 / sqrt(dist2))) {
-            std::cout << dist2 << " " << sc1->fX << " " << sc2->fX << " " << sc1->fY << " "
-                      << sc2->fY << " " << sc1->fZ << " " << sc2->fZ << std::endl;
-            abort();
-          }
-        } // end for sc2
-      }   // end for icn
+    const tbb::blocked_range<size_t> allSCs(0, spaceCharges.size(), 256);
 
-      // The neighbours lists use the most memory, so be careful to trim
-      sc1->fNeighbours.shrink_to_fit();
-    } // end for sc1
+    if (fRunParallel)
+      tbb::parallel_for(allSCs, findNeighbours);
+    else
+      findNeighbours(allSCs);
 
     for (SpaceCharge* sc : spaceCharges) {
       for (Neighbour& nei : sc->fNeighbours) {
@@ -403,22 +436,19 @@ namespace reco3d {
 
   // ---------------------------------------------------------------------------
   void
-  SpacePointSolver::Minimize(const std::vector<CollectionWireHit*>& cwires,
-                             const std::vector<SpaceCharge*>& orphanSCs,
-                             double alpha,
-                             int maxiterations)
+  SpacePointSolver::Minimize(PackedSolver& solver, double alpha, int maxiterations) const
   {
-    double prevMetric = Metric(cwires, alpha);
+    double prevMetric = solver.Metric(alpha);
     std::cout << "Begin: " << prevMetric << std::endl;
     for (int i = 0; i < maxiterations; ++i) {
-      Iterate(cwires, orphanSCs, alpha);
-      const double metric = Metric(cwires, alpha);
+      solver.Iterate(alpha, fRunParallel);
+      const double metric = solver.Metric(alpha);
       std::cout << i << " " << metric << std::endl;
       if (metric > prevMetric) {
         std::cout << "Warning: metric increased" << std::endl;
         return;
       }
-      if (fabs(metric - prevMetric) < 1e-3 * fabs(prevMetric)) return;
+      if (fabs(metric - prevMetric) < fConvergenceTolerance * fabs(prevMetric)) return;
       prevMetric = metric;
     }
   }
@@ -492,7 +522,7 @@ namespace reco3d {
                        fDistThresh,
                        fDistThreshDrift,
                        fXHitOffset);
-      BuildSystem(tf.TripletsTwoView(), cwires, iwires, orphanSCs, fAlpha != 0, hitmap);
+      BuildSystem(tf.TripletsTwoView(fRunParallel), cwires, iwires, orphanSCs, fAlpha != 0, hitmap);
     }
     else {
       std::cout << "Finding XUV coincidences..." << std::endl;
@@ -506,21 +536,26 @@ namespace reco3d {
                        fDistThresh,
                        fDistThreshDrift,
                        fXHitOffset);
-      BuildSystem(tf.Triplets(), cwires, iwires, orphanSCs, fAlpha != 0, hitmap);
+      BuildSystem(tf.Triplets(fRunParallel), cwires, iwires, orphanSCs, fAlpha != 0, hitmap);
     }
 
     FillSystemToSpacePoints(cwires, orphanSCs, spcol_pre);
     spcol_pre.put();
 
     if (fFit) {
+      PackedSolver solver(cwires, orphanSCs);
+      std::cout << solver.NColours() << " independent sets of collection wires" << std::endl;
+
       std::cout << "Iterating with no regularization..." << std::endl;
-      Minimize(cwires, orphanSCs, 0, fMaxIterationsNoReg);
+      Minimize(solver, 0, fMaxIterationsNoReg);
+      solver.Unpack();
 
       FillSystemToSpacePoints(cwires, orphanSCs, spcol_noreg);
       spcol_noreg.put();
 
       std::cout << "Now with regularization..." << std::endl;
-      Minimize(cwires, orphanSCs, fAlpha, fMaxIterationsReg);
+      Minimize(solver, fAlpha, fMaxIterationsReg);
+      solver.Unpack();
 
       FillSystemToSpacePointsAndAssns(hitlist, cwires, orphanSCs, hitmap, spcol, *assns);
       spcol.put();
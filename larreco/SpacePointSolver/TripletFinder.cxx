@@ -4,6 +4,8 @@
 
 #include "TVector3.h"
 
+#include "tbb/parallel_for.h"
+
 #include "larcore/Geometry/Geometry.h"
 #include "larcorealg/Geometry/GeometryCore.h"
 #include "lardataalg/DetectorInfo/DetectorPropertiesData.h"
@@ -69,12 +71,20 @@ namespace reco3d {
     }
   }
 
+  // -------------------------------------------------------------------------
+  template <class T>
+  const std::vector<T>&
+  TripletFinder::ForTPC(const std::map<geo::TPCID, std::vector<T>>& m, geo::TPCID tpc)
+  {
+    static const std::vector<T> empty;
+    auto it = m.find(tpc);
+    return it == m.end() ? empty : it->second;
+  }
+
   // -------------------------------------------------------------------------
   class IntersectionCache {
   public:
-    IntersectionCache(geo::TPCID tpc)
-      : geom(art::ServiceHandle<geo::Geometry const>()->provider()), fTPC(tpc)
-    {}
+    IntersectionCache(const geo::GeometryCore* g, geo::TPCID tpc) : geom(g), fTPC(tpc) {}
 
     bool
     operator()(raw::ChannelID_t a, raw::ChannelID_t b, geo::WireIDIntersection& pt)
@@ -150,132 +160,175 @@ namespace reco3d {
     return a.a.hit == b.a.hit;
   }
 
+  // -------------------------------------------------------------------------
+  std::vector<TripletFinder::TPCTriplets>
+  TripletFinder::ForEachTPC(TPCTriplets (TripletFinder::*func)(geo::TPCID) const,
+                            bool parallel) const
+  {
+    std::vector<geo::TPCID> tpcs;
+    for (const auto& it : fX_by_tpc)
+      tpcs.push_back(it.first);
+
+    std::vector<TPCTriplets> ret(tpcs.size());
+
+    if (parallel) {
+      tbb::parallel_for(
+        size_t(0), tpcs.size(), [&](size_t i) { ret[i] = (this->*func)(tpcs[i]); });
+    }
+    else {
+      for (size_t i = 0; i < tpcs.size(); ++i)
+        ret[i] = (this->*func)(tpcs[i]);
+    }
+
+    return ret;
+  }
+
   // -------------------------------------------------------------------------
   std::vector<HitTriplet>
-  TripletFinder::Triplets()
+  TripletFinder::Triplets(bool parallel)
   {
     std::vector<HitTriplet> ret;
 
-    for (const auto& it : fX_by_tpc) {
-      const geo::TPCID& tpc = it.first;
+    auto it = fX_by_tpc.begin();
+    for (const TPCTriplets& trips : ForEachTPC(&TripletFinder::TripletsInTPC, parallel)) {
+      std::cout << (it++)->first << " " << trips.nxu << " XUs and " << trips.nxv << " XVs -> "
+                << trips.triplets.size() << " XUVs" << std::endl;
 
-      std::vector<ChannelDoublet> xus = DoubletsXU(tpc);
-      std::vector<ChannelDoublet> xvs = DoubletsXV(tpc);
+      ret.insert(ret.end(), trips.triplets.begin(), trips.triplets.end());
+    }
 
-      // Cache to prevent repeating the same questions
-      IntersectionCache isectUV(tpc);
+    std::cout << ret.size() << " XUVs total" << std::endl;
 
-      // For the efficient looping below to work we need to sort the doublet
-      // lists so the X hits occur in the same order.
-      std::sort(xus.begin(), xus.end(), LessThanXHit);
-      std::sort(xvs.begin(), xvs.end(), LessThanXHit);
+    return ret;
+  }
 
-      auto xvit_begin = xvs.begin();
+  // -------------------------------------------------------------------------
+  TripletFinder::TPCTriplets
+  TripletFinder::TripletsInTPC(geo::TPCID tpc) const
+  {
+    TPCTriplets ret;
 
-      int nxuv = 0;
-      for (const ChannelDoublet& xu : xus) {
-        const HitOrChan& x = xu.a;
-        const HitOrChan& u = xu.b;
+    std::vector<ChannelDoublet> xus = DoubletsXU(tpc);
+    std::vector<ChannelDoublet> xvs = DoubletsXV(tpc);
 
-        // Catch up until we're looking at the same X hit in XV
-        while (xvit_begin != xvs.end() && LessThanXHit(*xvit_begin, xu))
-          ++xvit_begin;
+    ret.nxu = xus.size();
+    ret.nxv = xvs.size();
 
-        // Loop through all those matching hits
-        for (auto xvit = xvit_begin; xvit != xvs.end() && SameXHit(*xvit, xu); ++xvit) {
-          const HitOrChan& v = xvit->b;
+    // Cache to prevent repeating the same questions
+    IntersectionCache isectUV(geom, tpc);
 
-          // Only allow one bad channel per triplet
-          if (!x.hit && !u.hit) continue;
-          if (!x.hit && !v.hit) continue;
-          if (!u.hit && !v.hit) continue;
+    // For the efficient looping below to work we need to sort the doublet
+    // lists so the X hits occur in the same order.
+    std::sort(xus.begin(), xus.end(), LessThanXHit);
+    std::sort(xvs.begin(), xvs.end(), LessThanXHit);
 
-          if (u.hit && v.hit && !CloseDrift(u.xpos, v.xpos)) continue;
+    auto xvit_begin = xvs.begin();
 
-          geo::WireIDIntersection ptUV;
-          if (!isectUV(u.chan, v.chan, ptUV)) continue;
+    for (const ChannelDoublet& xu : xus) {
+      const HitOrChan& x = xu.a;
+      const HitOrChan& u = xu.b;
 
-          if (!CloseSpace(xu.pt, xvit->pt) || !CloseSpace(xu.pt, ptUV) ||
-              !CloseSpace(xvit->pt, ptUV))
-            continue;
+      // Catch up until we're looking at the same X hit in XV
+      while (xvit_begin != xvs.end() && LessThanXHit(*xvit_begin, xu))
+        ++xvit_begin;
 
-          double xavg = 0;
-          int nx = 0;
-          if (x.hit) {
-            xavg += x.xpos;
-            ++nx;
-          }
-          if (u.hit) {
-            xavg += u.xpos;
-            ++nx;
-          }
-          if (v.hit) {
-            xavg += v.xpos;
-            ++nx;
-          }
-          xavg /= nx;
+      // Loop through all those matching hits
+      for (auto xvit = xvit_begin; xvit != xvs.end() && SameXHit(*xvit, xu); ++xvit) {
+        const HitOrChan& v = xvit->b;
 
-          const XYZ pt{
-            xavg, (xu.pt.y + xvit->pt.y + ptUV.y) / 3, (xu.pt.z + xvit->pt.z + ptUV.z) / 3};
+        // Only allow one bad channel per triplet
+        if (!x.hit && !u.hit) continue;
+        if (!x.hit && !v.hit) continue;
+        if (!u.hit && !v.hit) continue;
 
-          ret.emplace_back(HitTriplet{x.hit, u.hit, v.hit, pt});
-          ++nxuv;
-        } // end for xv
-      }   // end for xu
+        if (u.hit && v.hit && !CloseDrift(u.xpos, v.xpos)) continue;
 
-      std::cout << tpc << " " << xus.size() << " XUs and " << xvs.size() << " XVs -> " << nxuv
-                << " XUVs" << std::endl;
+        geo::WireIDIntersection ptUV;
+        if (!isectUV(u.chan, v.chan, ptUV)) continue;
 
-    } // end for tpc
+        if (!CloseSpace(xu.pt, xvit->pt) || !CloseSpace(xu.pt, ptUV) ||
+            !CloseSpace(xvit->pt, ptUV))
+          continue;
 
-    std::cout << ret.size() << " XUVs total" << std::endl;
+        double xavg = 0;
+        int nx = 0;
+        if (x.hit) {
+          xavg += x.xpos;
+          ++nx;
+        }
+        if (u.hit) {
+          xavg += u.xpos;
+          ++nx;
+        }
+        if (v.hit) {
+          xavg += v.xpos;
+          ++nx;
+        }
+        xavg /= nx;
+
+        const XYZ pt{
+          xavg, (xu.pt.y + xvit->pt.y + ptUV.y) / 3, (xu.pt.z + xvit->pt.z + ptUV.z) / 3};
+
+        ret.triplets.emplace_back(HitTriplet{x.hit, u.hit, v.hit, pt});
+      } // end for xv
+    }   // end for xu
 
     return ret;
   }
 
   // -------------------------------------------------------------------------
   std::vector<HitTriplet>
-  TripletFinder::TripletsTwoView()
+  TripletFinder::TripletsTwoView(bool parallel)
   {
     std::vector<HitTriplet> ret;
 
-    for (const auto& it : fX_by_tpc) {
-      const geo::TPCID& tpc = it.first;
+    for (const TPCTriplets& trips : ForEachTPC(&TripletFinder::TripletsTwoViewInTPC, parallel))
+      ret.insert(ret.end(), trips.triplets.begin(), trips.triplets.end());
 
-      std::vector<ChannelDoublet> xus = DoubletsXU(tpc);
+    std::cout << ret.size() << " XUs total" << std::endl;
 
-      for (const ChannelDoublet& xu : xus) {
-        const HitOrChan& x = xu.a;
-        const HitOrChan& u = xu.b;
+    return ret;
+  }
 
-        double xavg = x.xpos;
-        int nx = 1;
-        if (u.hit) {
-          xavg += u.xpos;
-          ++nx;
-        }
-        xavg /= nx;
+  // -------------------------------------------------------------------------
+  TripletFinder::TPCTriplets
+  TripletFinder::TripletsTwoViewInTPC(geo::TPCID tpc) const
+  {
+    TPCTriplets ret;
 
-        const XYZ pt{xavg, xu.pt.y, xu.pt.z};
+    std::vector<ChannelDoublet> xus = DoubletsXU(tpc);
 
-        ret.emplace_back(HitTriplet{x.hit, u.hit, 0, pt});
-      } // end for xu
-    }   // end for tpc
+    ret.nxu = xus.size();
 
-    std::cout << ret.size() << " XUs total" << std::endl;
+    for (const ChannelDoublet& xu : xus) {
+      const HitOrChan& x = xu.a;
+      const HitOrChan& u = xu.b;
+
+      double xavg = x.xpos;
+      int nx = 1;
+      if (u.hit) {
+        xavg += u.xpos;
+        ++nx;
+      }
+      xavg /= nx;
+
+      const XYZ pt{xavg, xu.pt.y, xu.pt.z};
+
+      ret.triplets.emplace_back(HitTriplet{x.hit, u.hit, 0, pt});
+    } // end for xu
 
     return ret;
   }
 
   // -------------------------------------------------------------------------
   std::vector<ChannelDoublet>
-  TripletFinder::DoubletsXU(geo::TPCID tpc)
+  TripletFinder::DoubletsXU(geo::TPCID tpc) const
   {
-    std::vector<ChannelDoublet> ret =
-      DoubletHelper(tpc, fX_by_tpc[tpc], fU_by_tpc[tpc], fUbad_by_tpc[tpc]);
+    std::vector<ChannelDoublet> ret = DoubletHelper(
+      tpc, ForTPC(fX_by_tpc, tpc), ForTPC(fU_by_tpc, tpc), ForTPC(fUbad_by_tpc, tpc));
 
     // Find X(bad)+U(good) doublets, have to flip them for the final result
-    for (auto it : DoubletHelper(tpc, fU_by_tpc[tpc], {}, fXbad_by_tpc[tpc])) {
+    for (auto it : DoubletHelper(tpc, ForTPC(fU_by_tpc, tpc), {}, ForTPC(fXbad_by_tpc, tpc))) {
       ret.push_back({it.b, it.a, it.pt});
     }
 
@@ -284,13 +337,13 @@ namespace reco3d {
 
   // -------------------------------------------------------------------------
   std::vector<ChannelDoublet>
-  TripletFinder::DoubletsXV(geo::TPCID tpc)
+  TripletFinder::DoubletsXV(geo::TPCID tpc) const
   {
-    std::vector<ChannelDoublet> ret =
-      DoubletHelper(tpc, fX_by_tpc[tpc], fV_by_tpc[tpc], fVbad_by_tpc[tpc]);
+    std::vector<ChannelDoublet> ret = DoubletHelper(
+      tpc, ForTPC(fX_by_tpc, tpc), ForTPC(fV_by_tpc, tpc), ForTPC(fVbad_by_tpc, tpc));
 
     // Find X(bad)+V(good) doublets, have to flip them for the final result
-    for (auto it : DoubletHelper(tpc, fV_by_tpc[tpc], {}, fXbad_by_tpc[tpc])) {
+    for (auto it : DoubletHelper(tpc, ForTPC(fV_by_tpc, tpc), {}, ForTPC(fXbad_by_tpc, tpc))) {
       ret.push_back({it.b, it.a, it.pt});
     }
 
@@ -306,7 +359,7 @@ namespace reco3d {
   {
     std::vector<ChannelDoublet> ret;
 
-    IntersectionCache isect(tpc);
+    IntersectionCache isect(geom, tpc);
 
     auto b_begin = bhits.begin();
 
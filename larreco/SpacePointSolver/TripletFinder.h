@@ -61,9 +61,11 @@ namespace reco3d {
                   double distThreshDrift,
                   double xhitOffset);
 
-    std::vector<HitTriplet> Triplets();
+    /// The TPCs are independent, \a parallel processes them concurrently.
+    /// Either way the triplets come out in TPC order.
+    std::vector<HitTriplet> Triplets(bool parallel = false);
     /// Only search for XU intersections
-    std::vector<HitTriplet> TripletsTwoView();
+    std::vector<HitTriplet> TripletsTwoView(bool parallel = false);
 
   protected:
     const geo::GeometryCore* geom;
@@ -79,14 +81,33 @@ namespace reco3d {
     bool CloseDrift(double xa, double xb) const;
     bool CloseSpace(geo::WireIDIntersection ra, geo::WireIDIntersection rb) const;
 
-    std::vector<ChannelDoublet> DoubletsXU(geo::TPCID tpc);
-    std::vector<ChannelDoublet> DoubletsXV(geo::TPCID tpc);
+    /// Triplets of a single TPC, with the number of XU and XV doublets
+    struct TPCTriplets {
+      std::vector<HitTriplet> triplets;
+      size_t nxu = 0, nxv = 0;
+    };
+
+    TPCTriplets TripletsInTPC(geo::TPCID tpc) const;
+    TPCTriplets TripletsTwoViewInTPC(geo::TPCID tpc) const;
+
+    /// Run \a func over all the TPCs with X hits, results in TPC order
+    std::vector<TPCTriplets> ForEachTPC(TPCTriplets (TripletFinder::*func)(geo::TPCID) const,
+                                        bool parallel) const;
+
+    std::vector<ChannelDoublet> DoubletsXU(geo::TPCID tpc) const;
+    std::vector<ChannelDoublet> DoubletsXV(geo::TPCID tpc) const;
 
     std::vector<ChannelDoublet> DoubletHelper(geo::TPCID tpc,
                                               const std::vector<HitOrChan>& ahits,
                                               const std::vector<HitOrChan>& bhits,
                                               const std::vector<raw::ChannelID_t>& bbads) const;
 
+    /// Entry for \a tpc, or an empty vector. Unlike operator[] safe to call
+    /// concurrently.
+    template <class T>
+    static const std::vector<T>& ForTPC(const std::map<geo::TPCID, std::vector<T>>& m,
+                                        geo::TPCID tpc);
+
     double fDistThresh;
     double fDistThreshDrift;
     double fXHitOffset;
@@ -35,6 +35,10 @@
 
 #include <memory>
 
+#include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+
 namespace trkf {
 
   class KalmanFilterFinalTrackFitter : public art::EDProducer {
@@ -127,6 +131,11 @@ namespace trkf {
                 "It may also modify the trajectory point flags. In order to avoid inconsistencies, "
                 "it has to be used with the following fitter options all set to false: "
                 "sortHitsByPlane, sortOutputHitsMinLength, skipNegProp.")};
+      fhicl::Atom<bool> runParallel{
+        Name("runParallel"),
+        Comment("Fit the tracks of the event concurrently (not yet validated against the serial "
+                "output)."),
+        false};
     };
 
     struct Config {
@@ -154,9 +163,12 @@ namespace trkf {
     Parameters p_;
     TrackStatePropagator prop;
     trkf::TrackKalmanFitter kalmanFitter;
-    mutable trkf::TrackMomentumCalculator tmc{};
+    trkf::TrackMomentumCalculator tmc{};
     bool inputFromPF;
 
+    /// Fit buffers of each thread, reused from one track to the next
+    mutable tbb::enumerable_thread_specific<TrackKalmanFitter::Workspace> workspaces;
+
     art::InputTag pfParticleInputTag;
     art::InputTag trackInputTag;
     art::InputTag showerInputTag;
@@ -181,6 +193,34 @@ namespace trkf {
                     TVector3& mcdir,
                     const std::vector<art::Ptr<recob::Vertex>>* vertices = 0) const;
 
+    /// A track or a shower to be fitted, with the inputs of the fit
+    struct FitInput {
+      unsigned int iPF = 0;
+      const recob::Track* track = nullptr;
+      const recob::Shower* shower = nullptr;
+      std::vector<art::Ptr<recob::Hit>> inHits;
+      double mom = 0.;
+      int pId = 0;
+      bool flipDir = false;
+    };
+
+    /// The result of the fit of a FitInput
+    struct FitOutput {
+      bool fitok = false;
+      recob::Track outTrack;
+      std::vector<art::Ptr<recob::Hit>> outHits;
+      trkmkr::OptionalOutputs optionals;
+    };
+
+    void fitInput(detinfo::DetectorPropertiesData const& detProp,
+                  const FitInput& input,
+                  FitOutput& output) const;
+
+    /// Fit all the inputs, concurrently if runParallel is set; the outputs are
+    /// in the same order as the inputs
+    std::vector<FitOutput> fitInputs(detinfo::DetectorPropertiesData const& detProp,
+                                     const std::vector<FitInput>& inputs) const;
+
     void restoreInputPoints(const recob::Trajectory& track,
                             const std::vector<art::Ptr<recob::Hit>>& inHits,
                             recob::Track& outTrack,
@@ -326,6 +366,42 @@ trkf::KalmanFilterFinalTrackFitter::produce(art::Event& e)
 
   auto const detProp = art::ServiceHandle<detinfo::DetectorPropertiesService const>()->DataFor(e);
 
+  // the inputs are collected in order, fitted (concurrently, if requested),
+  // and the fitted tracks are then stored in the same order
+  std::vector<FitInput> inputs;
+  auto storeOutputs = [&](std::vector<FitOutput> outputs, auto&& addPFAssn) {
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+      FitOutput& output = outputs[i];
+      if (!output.fitok) continue;
+
+      // tracks from PFParticles do not get space points
+      const bool withSpacePoints =
+        p_().options().produceSpacePoints() && (!inputFromPF || inputs[i].shower);
+
+      outputTracks->emplace_back(std::move(output.outTrack));
+      art::Ptr<recob::Track> aptr(tid, outputTracks->size() - 1, tidgetter);
+      unsigned int ip = 0;
+      for (auto const& trhit : output.outHits) {
+        //the fitter produces collections with 1-1 match between hits and point
+        recob::TrackHitMeta metadata(ip, -1);
+        outputHitsMeta->addSingle(aptr, trhit, metadata);
+        outputHits->addSingle(aptr, trhit);
+        if (withSpacePoints && outputTracks->back().HasValidPoint(ip)) {
+          auto& tp = outputTracks->back().Trajectory().LocationAtPoint(ip);
+          double fXYZ[3] = {tp.X(), tp.Y(), tp.Z()};
+          double fErrXYZ[6] = {0};
+          recob::SpacePoint sp(fXYZ, fErrXYZ, -1.);
+          outputSpacePoints->emplace_back(std::move(sp));
+          art::Ptr<recob::SpacePoint> apsp(spid, outputSpacePoints->size() - 1, spidgetter);
+          outputHitSpacePointAssn->addSingle(trhit, apsp);
+        }
+        ip++;
+      }
+      addPFAssn(inputs[i].iPF, aptr);
+      outputHitInfo->emplace_back(output.optionals.trackFitHitInfos());
+    }
+  };
+
   if (inputFromPF) {
 
     auto outputPFAssn = std::make_unique<art::Assns<recob::PFParticle, recob::Track>>();
@@ -356,53 +432,20 @@ trkf::KalmanFilterFinalTrackFitter::produce(art::Event& e)
 
           const recob::Track& track = *tracks[iTrack];
           art::Ptr<recob::Track> ptrack = tracks[iTrack];
-          const int pId = setPId(iTrack, trackId, inputPFParticle->at(iPF).PdgCode());
-          const double mom = setMomValue(ptrack, trackCalo, pMC, pId);
-          const bool flipDir = setDirFlip(track, mcdir, &vertices);
+          FitInput& input = inputs.emplace_back();
+          input.iPF = iPF;
+          input.track = &track;
+          input.pId = setPId(iTrack, trackId, inputPFParticle->at(iPF).PdgCode());
+          input.mom = setMomValue(ptrack, trackCalo, pMC, input.pId);
+          input.flipDir = setDirFlip(track, mcdir, &vertices);
 
           //this is not computationally optimal, but at least preserves the order unlike FindManyP
-          std::vector<art::Ptr<recob::Hit>> inHits;
           for (auto it = tkHitsAssn.begin(); it != tkHitsAssn.end(); ++it) {
             if (it->first == ptrack)
-              inHits.push_back(it->second);
-            else if (inHits.size() > 0)
+              input.inHits.push_back(it->second);
+            else if (input.inHits.size() > 0)
               break;
           }
-
-          recob::Track outTrack;
-          std::vector<art::Ptr<recob::Hit>> outHits;
-          trkmkr::OptionalOutputs optionals;
-          if (p_().options().produceTrackFitHitInfo()) optionals.initTrackFitInfos();
-          bool fitok = kalmanFitter.fitTrack(detProp,
-                                             track.Trajectory(),
-                                             track.ID(),
-                                             track.VertexCovarianceLocal5D(),
-                                             track.EndCovarianceLocal5D(),
-                                             inHits,
-                                             mom,
-                                             pId,
-                                             flipDir,
-                                             outTrack,
-                                             outHits,
-                                             optionals);
-          if (!fitok) continue;
-
-          if (p_().options().keepInputTrajectoryPoints()) {
-            restoreInputPoints(track.Trajectory().Trajectory(), inHits, outTrack, outHits);
-          }
-
-          outputTracks->emplace_back(std::move(outTrack));
-          art::Ptr<recob::Track> aptr(tid, outputTracks->size() - 1, tidgetter);
-          unsigned int ip = 0;
-          for (auto const& trhit : outHits) {
-            //the fitter produces collections with 1-1 match between hits and point
-            recob::TrackHitMeta metadata(ip, -1);
-            outputHitsMeta->addSingle(aptr, trhit, metadata);
-            outputHits->addSingle(aptr, trhit);
-            ip++;
-          }
-          outputPFAssn->addSingle(art::Ptr<recob::PFParticle>(inputPFParticle, iPF), aptr);
-          outputHitInfo->emplace_back(optionals.trackFitHitInfos());
         }
       }
 
@@ -426,54 +469,20 @@ trkf::KalmanFilterFinalTrackFitter::produce(art::Event& e)
             break;
         }
         for (unsigned int iShower = 0; iShower < showers.size(); ++iShower) {
-          const recob::Shower& shower = *showers[iShower];
-          recob::Track outTrack;
-          std::vector<art::Ptr<recob::Hit>> outHits;
-          trkmkr::OptionalOutputs optionals;
-          if (p_().options().produceTrackFitHitInfo()) optionals.initTrackFitInfos();
-          Point_t pos(shower.ShowerStart().X(), shower.ShowerStart().Y(), shower.ShowerStart().Z());
-          Vector_t dir(shower.Direction().X(), shower.Direction().Y(), shower.Direction().Z());
-          auto cov = SMatrixSym55();
-          auto pid = p_().options().pdgId();
-          auto mom = p_().options().pval();
-          bool fitok = kalmanFitter.fitTrack(detProp,
-                                             pos,
-                                             dir,
-                                             cov,
-                                             inHits,
-                                             std::vector<recob::TrajectoryPointFlags>(),
-                                             shower.ID(),
-                                             mom,
-                                             pid,
-                                             outTrack,
-                                             outHits,
-                                             optionals);
-          if (!fitok) continue;
-
-          outputTracks->emplace_back(std::move(outTrack));
-          art::Ptr<recob::Track> aptr(tid, outputTracks->size() - 1, tidgetter);
-          unsigned int ip = 0;
-          for (auto const& trhit : outHits) {
-            // the fitter produces collections with 1-1 match between hits and point
-            recob::TrackHitMeta metadata(ip, -1);
-            outputHitsMeta->addSingle(aptr, trhit, metadata);
-            outputHits->addSingle(aptr, trhit);
-            if (p_().options().produceSpacePoints() && outputTracks->back().HasValidPoint(ip)) {
-              auto& tp = outputTracks->back().Trajectory().LocationAtPoint(ip);
-              double fXYZ[3] = {tp.X(), tp.Y(), tp.Z()};
-              double fErrXYZ[6] = {0};
-              recob::SpacePoint sp(fXYZ, fErrXYZ, -1.);
-              outputSpacePoints->emplace_back(std::move(sp));
-              art::Ptr<recob::SpacePoint> apsp(spid, outputSpacePoints->size() - 1, spidgetter);
-              outputHitSpacePointAssn->addSingle(trhit, apsp);
-            }
-            ip++;
-          }
-          outputPFAssn->addSingle(art::Ptr<recob::PFParticle>(inputPFParticle, iPF), aptr);
-          outputHitInfo->emplace_back(optionals.trackFitHitInfos());
+          FitInput& input = inputs.emplace_back();
+          input.iPF = iPF;
+          input.shower = showers[iShower].get();
+          input.inHits = inHits;
+          input.mom = p_().options().pval();
+          input.pId = p_().options().pdgId();
         }
       }
     }
+
+    storeOutputs(fitInputs(detProp, inputs), [&](unsigned int iPF, art::Ptr<recob::Track> const& aptr) {
+      outputPFAssn->addSingle(art::Ptr<recob::PFParticle>(inputPFParticle, iPF), aptr);
+    });
+
     e.put(std::move(outputTracks));
     e.put(std::move(outputHitsMeta));
     e.put(std::move(outputHits));
@@ -502,62 +511,23 @@ trkf::KalmanFilterFinalTrackFitter::produce(art::Event& e)
 
       const recob::Track& track = inputTracks->at(iTrack);
       art::Ptr<recob::Track> ptrack(inputTracks, iTrack);
-      const int pId = setPId(iTrack, trackId);
-      const double mom = setMomValue(ptrack, trackCalo, pMC, pId);
-      const bool flipDir = setDirFlip(track, mcdir);
+      FitInput& input = inputs.emplace_back();
+      input.track = &track;
+      input.pId = setPId(iTrack, trackId);
+      input.mom = setMomValue(ptrack, trackCalo, pMC, input.pId);
+      input.flipDir = setDirFlip(track, mcdir);
 
       //this is not computationally optimal, but at least preserves the order unlike FindManyP
-      std::vector<art::Ptr<recob::Hit>> inHits;
       for (auto it = tkHitsAssn.begin(); it != tkHitsAssn.end(); ++it) {
         if (it->first == ptrack)
-          inHits.push_back(it->second);
-        else if (inHits.size() > 0)
+          input.inHits.push_back(it->second);
+        else if (input.inHits.size() > 0)
           break;
       }
+    }
 
-      recob::Track outTrack;
-      std::vector<art::Ptr<recob::Hit>> outHits;
-      trkmkr::OptionalOutputs optionals;
-      if (p_().options().produceTrackFitHitInfo()) optionals.initTrackFitInfos();
-      bool fitok = kalmanFitter.fitTrack(detProp,
-                                         track.Trajectory(),
-                                         track.ID(),
-                                         track.VertexCovarianceLocal5D(),
-                                         track.EndCovarianceLocal5D(),
-                                         inHits,
-                                         mom,
-                                         pId,
-                                         flipDir,
-                                         outTrack,
-                                         outHits,
-                                         optionals);
-      if (!fitok) continue;
-
-      if (p_().options().keepInputTrajectoryPoints()) {
-        restoreInputPoints(track.Trajectory().Trajectory(), inHits, outTrack, outHits);
-      }
+    storeOutputs(fitInputs(detProp, inputs), [](unsigned int, art::Ptr<recob::Track> const&) {});
 
-      outputTracks->emplace_back(std::move(outTrack));
-      art::Ptr<recob::Track> aptr(tid, outputTracks->size() - 1, tidgetter);
-      unsigned int ip = 0;
-      for (auto const& trhit : outHits) {
-        //the fitter produces collections with 1-1 match between hits and point
-        recob::TrackHitMeta metadata(ip, -1);
-        outputHitsMeta->addSingle(aptr, trhit, metadata);
-        outputHits->addSingle(aptr, trhit);
-        if (p_().options().produceSpacePoints() && outputTracks->back().HasValidPoint(ip)) {
-          auto& tp = outputTracks->back().Trajectory().LocationAtPoint(ip);
-          double fXYZ[3] = {tp.X(), tp.Y(), tp.Z()};
-          double fErrXYZ[6] = {0};
-          recob::SpacePoint sp(fXYZ, fErrXYZ, -1.);
-          outputSpacePoints->emplace_back(std::move(sp));
-          art::Ptr<recob::SpacePoint> apsp(spid, outputSpacePoints->size() - 1, spidgetter);
-          outputHitSpacePointAssn->addSingle(trhit, apsp);
-        }
-        ip++;
-      }
-      outputHitInfo->emplace_back(optionals.trackFitHitInfos());
-    }
     e.put(std::move(outputTracks));
     e.put(std::move(outputHitsMeta));
     e.put(std::move(outputHits));
@@ -569,6 +539,79 @@ trkf::KalmanFilterFinalTrackFitter::produce(art::Event& e)
   }
 }
 
+void
+trkf::KalmanFilterFinalTrackFitter::fitInput(detinfo::DetectorPropertiesData const& detProp,
+                                             const FitInput& input,
+                                             FitOutput& output) const
+{
+  TrackKalmanFitter::Workspace& workspace = workspaces.local();
+  if (p_().options().produceTrackFitHitInfo()) output.optionals.initTrackFitInfos();
+
+  if (input.track) {
+    const recob::Track& track = *input.track;
+    output.fitok = kalmanFitter.fitTrack(detProp,
+                                         track.Trajectory(),
+                                         track.ID(),
+                                         track.VertexCovarianceLocal5D(),
+                                         track.EndCovarianceLocal5D(),
+                                         input.inHits,
+                                         input.mom,
+                                         input.pId,
+                                         input.flipDir,
+                                         output.outTrack,
+                                         output.outHits,
+                                         output.optionals,
+                                         &workspace);
+    if (output.fitok && p_().options().keepInputTrajectoryPoints()) {
+      restoreInputPoints(
+        track.Trajectory().Trajectory(), input.inHits, output.outTrack, output.outHits);
+    }
+  }
+  else {
+    const recob::Shower& shower = *input.shower;
+    Point_t pos(shower.ShowerStart().X(), shower.ShowerStart().Y(), shower.ShowerStart().Z());
+    Vector_t dir(shower.Direction().X(), shower.Direction().Y(), shower.Direction().Z());
+    auto cov = SMatrixSym55();
+    output.fitok = kalmanFitter.fitTrack(detProp,
+                                         pos,
+                                         dir,
+                                         cov,
+                                         input.inHits,
+                                         std::vector<recob::TrajectoryPointFlags>(),
+                                         shower.ID(),
+                                         input.mom,
+                                         input.pId,
+                                         output.outTrack,
+                                         output.outHits,
+                                         output.optionals,
+                                         &workspace);
+  }
+}
+
+std::vector<trkf::KalmanFilterFinalTrackFitter::FitOutput>
+trkf::KalmanFilterFinalTrackFitter::fitInputs(detinfo::DetectorPropertiesData const& detProp,
+                                              const std::vector<FitInput>& inputs) const
+{
+  std::vector<FitOutput> outputs(inputs.size());
+  if (p_().options().runParallel()) {
+    // The first dereference of an art::Ptr fetches its product from the event,
+    // which is not safe to do concurrently, so resolve the hits here
+    for (auto const& input : inputs)
+      for (auto const& hit : input.inHits)
+        hit.get();
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, inputs.size(), 1),
+                      [&](const tbb::blocked_range<std::size_t>& range) {
+                        for (std::size_t i = range.begin(); i < range.end(); ++i)
+                          fitInput(detProp, inputs[i], outputs[i]);
+                      });
+  }
+  else {
+    for (std::size_t i = 0; i < inputs.size(); ++i)
+      fitInput(detProp, inputs[i], outputs[i]);
+  }
+  return outputs;
+}
+
 void
 trkf::KalmanFilterFinalTrackFitter::restoreInputPoints(
   const recob::Trajectory& track,
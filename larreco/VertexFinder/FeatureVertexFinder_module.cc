@@ -38,10 +38,18 @@
 // ////////////////////////////////////////////////////////////////////////
 
 // Basic C++ Includes
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <numeric>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 // Framework Includes
 #include "art/Framework/Core/EDProducer.h"
@@ -59,6 +67,7 @@
 #include "larcore/Geometry/Geometry.h"
 #include "larcorealg/Geometry/CryostatGeo.h"
 #include "larcorealg/Geometry/TPCGeo.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardataobj/RecoBase/Cluster.h"
@@ -499,165 +508,206 @@ namespace vertex {
     double yy2 = 0., zz2 = 0.;
     double yy3 = 0., zz3 = 0.;
 
+    size_t const nEndPoints = EndPoints.size();
+    std::vector<unsigned int> featurePlane(nEndPoints);
+    for (size_t endpt = 0; endpt < nEndPoints; endpt++) {
+      featurePlane[endpt] = EndPoints.at(endpt)->WireID().Plane;
+    }
+
+    std::vector<float> featureX(nEndPoints);
+    std::vector<raw::ChannelID_t> featureChannel(nEndPoints);
+    std::map<unsigned int, std::vector<std::pair<float, size_t>>> planeFeatures;
+    std::unordered_map<std::uint64_t, std::array<double, 3>> intersections;
+    std::vector<size_t> pairCandidates, tripletCandidates;
+
     for (size_t cstat = 0; cstat < geom->Ncryostats(); ++cstat) {
       for (size_t tpc = 0; tpc < geom->Cryostat(cstat).NTPC(); ++tpc) {
-        for (size_t endpt1 = 0; endpt1 < EndPoints.size(); endpt1++) {
-          for (size_t endpt2 = endpt1 + 1; endpt2 < EndPoints.size(); endpt2++) {
-
-            // Check to make sure we are comparing features from different
-            // planes
-
-            if (EndPoints.at(endpt1)->WireID().Plane != EndPoints.at(endpt2)->WireID().Plane) {
-
-              // Get the appropriate time offset for the two planes we are
-              // considering
-
-              float tempXFeature1 = detProp.ConvertTicksToX(EndPoints.at(endpt1)->DriftTime(),
-                                                            EndPoints.at(endpt1)->WireID().Plane,
-                                                            tpc,
-                                                            cstat);
-              float tempXFeature2 = detProp.ConvertTicksToX(EndPoints.at(endpt2)->DriftTime(),
-                                                            EndPoints.at(endpt2)->WireID().Plane,
-                                                            tpc,
-                                                            cstat);
-
-              // Checking to see if these features have intersecting
-              // channels and are within 0.5 cm in projected X
-
-              if (geom->ChannelsIntersect(
-                    geom->PlaneWireToChannel(EndPoints.at(endpt2)->WireID().Plane,
-                                             EndPoints.at(endpt2)->WireID().Wire,
-                                             tpc,
-                                             cstat),
-                    geom->PlaneWireToChannel(EndPoints.at(endpt1)->WireID().Plane,
-                                             EndPoints.at(endpt1)->WireID().Wire,
-                                             tpc,
-                                             cstat),
-                    yy,
-                    zz) &&
-                  std::abs(tempXFeature1 - tempXFeature2) < 0.5) {
-
-                // Use this fill if we are in a detector with fewer than 3
-                // plane (e.g. ArgoNeuT)
-
-                if (!PlaneDet) {
-                  candidate_x.push_back(tempXFeature1);
-                  candidate_y.push_back(yy);
-                  candidate_z.push_back(zz);
-                  candidate_strength.push_back(EndPoints.at(endpt1)->Strength() +
-                                               EndPoints.at(endpt2)->Strength());
-                } //<---End fill for 2 plane detector
-
-                // Adding a check to see if I am in a 3-plane detector and
-                // therefore need to check for a match across more than 2 planes
-
-                if (PlaneDet) {
-
-                  // Looping over the rest of the list
-
-                  for (size_t endpt3 = endpt2 + 1; endpt3 < EndPoints.size(); endpt3++) {
-
-                    // Check to make sure we are comparing features from
-                    // different planes
-
-                    if (EndPoints.at(endpt3)->WireID().Plane !=
-                          EndPoints.at(endpt2)->WireID().Plane &&
-                        EndPoints.at(endpt3)->WireID().Plane !=
-                          EndPoints.at(endpt1)->WireID().Plane &&
-                        EndPoints.at(endpt1)->WireID().Plane !=
-                          EndPoints.at(endpt2)->WireID().Plane) {
-                      float tempXFeature3 =
-                        detProp.ConvertTicksToX(EndPoints.at(endpt3)->DriftTime(),
-                                                EndPoints.at(endpt3)->WireID().Plane,
-                                                tpc,
-                                                cstat);
-
-                      // Checking to make sure our third feature has an
-                      // intersecting channel with our
-                      //         other two channels and is within 1.0 cm
-                      // projected in X
-
-                      if (geom->ChannelsIntersect(
-                            geom->PlaneWireToChannel(EndPoints.at(endpt3)->WireID().Plane,
-                                                     EndPoints.at(endpt3)->WireID().Wire,
-                                                     tpc,
-                                                     cstat),
-                            geom->PlaneWireToChannel(EndPoints.at(endpt1)->WireID().Plane,
-                                                     EndPoints.at(endpt1)->WireID().Wire,
-                                                     tpc,
-                                                     cstat),
-                            yy3,
-                            zz3) &&
-                          geom->ChannelsIntersect(
-                            geom->PlaneWireToChannel(EndPoints.at(endpt3)->WireID().Plane,
-                                                     EndPoints.at(endpt3)->WireID().Wire,
-                                                     tpc,
-                                                     cstat),
-                            geom->PlaneWireToChannel(EndPoints.at(endpt2)->WireID().Plane,
-                                                     EndPoints.at(endpt2)->WireID().Wire,
-                                                     tpc,
-                                                     cstat),
-                            yy2,
-                            zz2) &&
-                          geom->ChannelsIntersect(
-                            geom->PlaneWireToChannel(EndPoints.at(endpt2)->WireID().Plane,
-                                                     EndPoints.at(endpt2)->WireID().Wire,
-                                                     tpc,
-                                                     cstat),
-                            geom->PlaneWireToChannel(EndPoints.at(endpt1)->WireID().Plane,
-                                                     EndPoints.at(endpt1)->WireID().Wire,
-                                                     tpc,
-                                                     cstat),
-                            yy,
-                            zz) &&
-                          std::abs(tempXFeature3 - tempXFeature2) < 1.0 &&
-                          std::abs(tempXFeature3 - tempXFeature1) < 1.0 &&
-                          std::abs(tempXFeature1 - tempXFeature2) < 1.0) {
-                        candidate_x.push_back(
-                          detProp.ConvertTicksToX(EndPoints.at(endpt1)->DriftTime(),
-                                                  EndPoints.at(endpt1)->WireID().Plane,
-                                                  tpc,
-                                                  cstat));
-
-                        // Finding intersection points
-
-                        geom->IntersectionPoint(EndPoints.at(endpt1)->WireID().Wire,
-                                                EndPoints.at(endpt2)->WireID().Wire,
-                                                EndPoints.at(endpt1)->WireID().Plane,
-                                                EndPoints.at(endpt2)->WireID().Plane,
-                                                cstat,
-                                                tpc,
-                                                y,
-                                                z);
-
-                        candidate_y.push_back(y);
-                        candidate_z.push_back(z);
-                        candidate_strength.push_back(EndPoints.at(endpt1)->Strength() +
-                                                     EndPoints.at(endpt2)->Strength() +
-                                                     EndPoints.at(endpt3)->Strength());
-
-                        // Note: If I've made it here I have a matched
-                        // triplet...since I don't want to use any of
-                        // these features again I am going to iterate
-                        // each of the counters so we move to the next
-                        // one
-                        if (endpt1 < EndPoints.size()) { endpt1++; }
-                        if (endpt2 < EndPoints.size()) { endpt2++; }
-                        if (endpt3 < EndPoints.size()) { endpt3++; }
-                      } //<---End finding 3d point across all three planes
-
-                    } //<---End checking for all different planes
-                  }   //<---End endpt3
-
-                } //<---End fill for 3 plane detector
-
-              } //<---End intersecting channels
-
-            } //<---End making sure we are looking across planes
-          }   //<---End endpt2 loop
-        }     //<---End endpt1 loop
-      }       //<---End TPC loop
-    }         //<---End cstat
+
+        // Projected X and channel of each feature in this TPC, and the
+        // features of each plane sorted by X
+
+        planeFeatures.clear();
+        intersections.clear();
+        for (size_t endpt = 0; endpt < nEndPoints; endpt++) {
+          featureX[endpt] = detProp.ConvertTicksToX(
+            EndPoints.at(endpt)->DriftTime(), featurePlane[endpt], tpc, cstat);
+          featureChannel[endpt] = geom->PlaneWireToChannel(
+            featurePlane[endpt], EndPoints.at(endpt)->WireID().Wire, tpc, cstat);
+          planeFeatures[featurePlane[endpt]].emplace_back(featureX[endpt], endpt);
+        }
+        for (auto& features : planeFeatures) {
+          std::sort(features.second.begin(), features.second.end());
+        }
+
+        // Checking if the channels of two features intersect, remembering
+        // the answer since the same pairs are asked for again and again
+
+        auto channelsIntersect = [&](size_t endptA, size_t endptB, double& yi, double& zi) {
+          std::uint64_t const key =
+            (std::uint64_t(featureChannel[endptA]) << 32) | featureChannel[endptB];
+          auto iInter = intersections.find(key);
+          if (iInter == intersections.end()) {
+            double yc = 0., zc = 0.;
+            bool const intersect =
+              geom->ChannelsIntersect(featureChannel[endptA], featureChannel[endptB], yc, zc);
+            iInter = intersections.emplace(key, std::array<double, 3>{{yc, zc, intersect ? 1. : 0.}})
+                       .first;
+          }
+          yi = iInter->second[0];
+          zi = iInter->second[1];
+          return iInter->second[2] != 0.;
+        };
+
+        // Features after `after` and within `window` in X of `x`, in planes
+        // other than plane1 and plane2, in the order of EndPoints; the exact
+        // cuts are applied by the caller
+
+        auto featuresInWindow = [&](float x,
+                                    float window,
+                                    unsigned int plane1,
+                                    unsigned int plane2,
+                                    size_t after,
+                                    std::vector<size_t>& result) {
+          result.clear();
+          for (auto const& [plane, features] : planeFeatures) {
+            if (plane == plane1 || plane == plane2) { continue; }
+            auto const first = std::lower_bound(features.begin(),
+                                                features.end(),
+                                                std::make_pair(x - window - 0.01F, size_t(0)));
+            for (auto iFeature = first;
+                 iFeature != features.end() && iFeature->first <= x + window + 0.01F;
+                 ++iFeature) {
+              if (iFeature->second > after) { result.push_back(iFeature->second); }
+            }
+          }
+          std::sort(result.begin(), result.end());
+        };
+
+        // Matching features pairwise (and then in triplets) in the order of
+        // EndPoints, since the order of the candidates decides which of
+        // the duplicates are kept later on
+
+        for (size_t endpt1 = 0; endpt1 < nEndPoints; endpt1++) {
+          size_t endpt2 = endpt1;
+          size_t pairsOf = nEndPoints;
+          size_t iPair = 0;
+          while (true) {
+
+            // Only features from different planes within 0.5 cm in
+            // projected X can be paired with endpt1
+
+            if (pairsOf != endpt1) {
+              featuresInWindow(featureX[endpt1],
+                               0.5,
+                               featurePlane[endpt1],
+                               featurePlane[endpt1],
+                               endpt2,
+                               pairCandidates);
+              pairsOf = endpt1;
+              iPair = 0;
+            }
+            while (iPair < pairCandidates.size() && pairCandidates[iPair] <= endpt2) {
+              iPair++;
+            }
+            if (iPair == pairCandidates.size()) { break; }
+            endpt2 = pairCandidates[iPair];
+
+            // Checking to see if these features have intersecting
+            // channels and are within 0.5 cm in projected X
+
+            float const tempXFeature1 = featureX[endpt1];
+            float const tempXFeature2 = featureX[endpt2];
+            if (!(std::abs(tempXFeature1 - tempXFeature2) < 0.5 &&
+                  channelsIntersect(endpt2, endpt1, yy, zz))) {
+              continue;
+            }
+
+            // Use this fill if we are in a detector with fewer than 3
+            // plane (e.g. ArgoNeuT)
+
+            if (!PlaneDet) {
+              candidate_x.push_back(tempXFeature1);
+              candidate_y.push_back(yy);
+              candidate_z.push_back(zz);
+              candidate_strength.push_back(EndPoints.at(endpt1)->Strength() +
+                                           EndPoints.at(endpt2)->Strength());
+              continue;
+            } //<---End fill for 2 plane detector
+
+            // In a 3-plane detector look for a third feature matching
+            // both, in the rest of the list. The X cuts stay those of
+            // this pair after a triplet moved the counters on
+
+            size_t endpt3 = endpt2 + 1;
+            while (endpt3 < nEndPoints) {
+
+              // None matches if the first two features are not from
+              // different planes, within 1.0 cm in X and intersecting
+
+              float const x1 = tempXFeature1;
+              float const x2 = tempXFeature2;
+              if (featurePlane[endpt1] == featurePlane[endpt2] || !(std::abs(x1 - x2) < 1.0) ||
+                  !channelsIntersect(endpt2, endpt1, yy, zz)) {
+                break;
+              }
+
+              // The third feature must be from the third plane, within 1.0
+              // cm in projected X and intersect with the other two
+
+              featuresInWindow(x1,
+                               1.0,
+                               featurePlane[endpt1],
+                               featurePlane[endpt2],
+                               endpt3 - 1,
+                               tripletCandidates);
+              bool matched = false;
+              for (size_t const candidate : tripletCandidates) {
+                float const x3 = featureX[candidate];
+                if (std::abs(x3 - x2) < 1.0 && std::abs(x3 - x1) < 1.0 &&
+                    channelsIntersect(candidate, endpt1, yy3, zz3) &&
+                    channelsIntersect(candidate, endpt2, yy2, zz2)) {
+                  endpt3 = candidate;
+                  matched = true;
+                  break;
+                }
+              }
+              if (!matched) { break; }
+
+              candidate_x.push_back(detProp.ConvertTicksToX(
+                EndPoints.at(endpt1)->DriftTime(), featurePlane[endpt1], tpc, cstat));
+
+              // Finding intersection points
+
+              geom->IntersectionPoint(EndPoints.at(endpt1)->WireID().Wire,
+                                      EndPoints.at(endpt2)->WireID().Wire,
+                                      featurePlane[endpt1],
+                                      featurePlane[endpt2],
+                                      cstat,
+                                      tpc,
+                                      y,
+                                      z);
+
+              candidate_y.push_back(y);
+              candidate_z.push_back(z);
+              candidate_strength.push_back(EndPoints.at(endpt1)->Strength() +
+                                           EndPoints.at(endpt2)->Strength() +
+                                           EndPoints.at(endpt3)->Strength());
+
+              // Note: If I've made it here I have a matched
+              // triplet...since I don't want to use any of
+              // these features again I am going to iterate
+              // each of the counters so we move to the next
+              // one (and the search for a third feature goes on
+              // with the next two)
+              endpt1++;
+              endpt2++;
+              endpt3 += 2;
+            } //<---End endpt3
+
+          } //<---End endpt2 loop
+        }   //<---End endpt1 loop
+      }     //<---End TPC loop
+    }       //<---End cstat
 
   } //<---End Get3dVertexCandidates
 
@@ -835,117 +885,119 @@ namespace vertex {
 
     // Now loop over all the clusters found and establish a
     // preliminary set of 2d-verticies based on the slope/intercept of
-    // those clusters
-
-    for (unsigned int n = nClustersFound; n > 0; n--) {
-
-      // Looping over the clusters starting from the first cluster and
-      // checking against the nCluster
-
-      for (unsigned int m = 0; m < n; m++) {
+    // those clusters. Every pair of clusters in the same view gives
+    // candidates, so the clusters are listed by view (in increasing
+    // order) and only the pairs within a view are looked at
 
-        // Checking to make sure clusters are in the same view
+    std::map<double, std::vector<unsigned int>> planeClusters;
+    for (unsigned int c = 0; c < (unsigned int)nClustersFound; c++)
+      planeClusters[Clu_Plane[c]].push_back(c);
 
-        if (Clu_Plane[n] == Clu_Plane[m]) {
-          // --- Skip the vertex if the lines slope don't intercept ---
-          if (Clu_Slope[m] - Clu_Slope[n] == 0) { break; }
+    for (unsigned int n = nClustersFound; n-- > 1;) {
 
-          // === X intersection = (yInt2 - yInt1) / (slope1 - slope2) ===
-          float intersection_X =
-            (Clu_Yintercept[n] - Clu_Yintercept[m]) / (Clu_Slope[m] - Clu_Slope[n]);
+      // Looping over the clusters of the same view starting from the
+      // first cluster and checking against the nCluster
 
-          // === Y intersection = (slope1 * XInt) + yInt1 ===
-          float intersection_Y = (Clu_Slope[m] * intersection_X) + Clu_Yintercept[m];
+      for (unsigned int const m : planeClusters[Clu_Plane[n]]) {
+        if (m >= n) { break; }
 
-          // === X intersection = (yInt2 - yInt1) / (slope1 - slope2) ===
-          float intersection_X2 =
-            (Clu_Yintercept2[n] - Clu_Yintercept2[m]) / (Clu_Slope[m] - Clu_Slope[n]);
+        // --- Skip the vertex if the lines slope don't intercept ---
+        if (Clu_Slope[m] - Clu_Slope[n] == 0) { break; }
 
-          // === Y intersection = (slope1 * XInt) + yInt1 ===
-          float intersection_Y2 = (Clu_Slope[m] * intersection_X2) + Clu_Yintercept2[m];
+        // === X intersection = (yInt2 - yInt1) / (slope1 - slope2) ===
+        float intersection_X =
+          (Clu_Yintercept[n] - Clu_Yintercept[m]) / (Clu_Slope[m] - Clu_Slope[n]);
 
-          // Skipping crap intersection points
+        // === Y intersection = (slope1 * XInt) + yInt1 ===
+        float intersection_Y = (Clu_Slope[m] * intersection_X) + Clu_Yintercept[m];
 
-          if (intersection_X2 < 1) { intersection_X2 = -999; }
-          if (intersection_X2 > geom->Nwires(Clu_Plane[m], 0, 0)) { intersection_X2 = -999; }
-          if (intersection_Y2 < 0) { intersection_Y2 = -999; }
-          if (intersection_Y2 > detProp.NumberTimeSamples()) { intersection_Y2 = -999; }
-          if (intersection_X < 1) { intersection_X = -999; }
-          if (intersection_X > geom->Nwires(Clu_Plane[m], 0, 0)) { intersection_X = -999; }
-          if (intersection_Y < 0) { intersection_Y = -999; }
-          if (intersection_Y > detProp.NumberTimeSamples()) { intersection_Y = -999; }
+        // === X intersection = (yInt2 - yInt1) / (slope1 - slope2) ===
+        float intersection_X2 =
+          (Clu_Yintercept2[n] - Clu_Yintercept2[m]) / (Clu_Slope[m] - Clu_Slope[n]);
 
-          // Putting in a protection for the findManyHit function
+        // === Y intersection = (slope1 * XInt) + yInt1 ===
+        float intersection_Y2 = (Clu_Slope[m] * intersection_X2) + Clu_Yintercept2[m];
 
-          try {
-            // Gathering the hits associated with the current cluster
-            std::vector<art::Ptr<recob::Hit>> hitClu1 = fmhit.at(m);
-            std::vector<art::Ptr<recob::Hit>> hitClu2 = fmhit.at(n);
-
-            // If the intersection point is 80 or more wires away from
-            // either cluster and one of the clusters has fewer than 8 hits the
-            // intersection is likely a crap one and we won't save this point
-            if ((abs(Clu_EndPos_Wire[m] - intersection_X2) > 80 && hitClu1.size() < 8) ||
-                (abs(Clu_EndPos_Wire[n] - intersection_X2) > 80 && hitClu2.size() < 8)) {
-              intersection_X2 = -999;
-              intersection_Y2 = -999;
-            }
+        // Skipping crap intersection points
 
-            if ((abs(Clu_StartPos_Wire[m] - intersection_X) > 80 && hitClu1.size() < 8) ||
-                (abs(Clu_StartPos_Wire[n] - intersection_X) > 80 && hitClu2.size() < 8)) {
-              intersection_X = -999;
-              intersection_Y = -999;
-            }
+        if (intersection_X2 < 1) { intersection_X2 = -999; }
+        if (intersection_X2 > geom->Nwires(Clu_Plane[m], 0, 0)) { intersection_X2 = -999; }
+        if (intersection_Y2 < 0) { intersection_Y2 = -999; }
+        if (intersection_Y2 > detProp.NumberTimeSamples()) { intersection_Y2 = -999; }
+        if (intersection_X < 1) { intersection_X = -999; }
+        if (intersection_X > geom->Nwires(Clu_Plane[m], 0, 0)) { intersection_X = -999; }
+        if (intersection_Y < 0) { intersection_Y = -999; }
+        if (intersection_Y > detProp.NumberTimeSamples()) { intersection_Y = -999; }
 
-            // If the intersection point is 50 or more wires away from
-            // either cluster and the one of the clusters has fewer than 3 hits
-            // the intersection is likely a crap one and we won't save this
-            // point
-            if ((abs(Clu_EndPos_Wire[m] - intersection_X2) > 50 && hitClu1.size() < 4) ||
-                (abs(Clu_EndPos_Wire[n] - intersection_X2) > 50 && hitClu2.size() < 4)) {
-              intersection_X2 = -999;
-              intersection_Y2 = -999;
-            }
+        // Putting in a protection for the findManyHit function
 
-            if ((abs(Clu_StartPos_Wire[m] - intersection_X) > 50 && hitClu1.size() < 4) ||
-                (abs(Clu_StartPos_Wire[n] - intersection_X) > 50 && hitClu2.size() < 4)) {
-              intersection_X = -999;
-              intersection_Y = -999;
-            }
+        try {
+          // Gathering the hits associated with the current cluster
+          std::vector<art::Ptr<recob::Hit>> const& hitClu1 = fmhit.at(m);
+          std::vector<art::Ptr<recob::Hit>> const& hitClu2 = fmhit.at(n);
+
+          // If the intersection point is 80 or more wires away from
+          // either cluster and one of the clusters has fewer than 8 hits the
+          // intersection is likely a crap one and we won't save this point
+          if ((abs(Clu_EndPos_Wire[m] - intersection_X2) > 80 && hitClu1.size() < 8) ||
+              (abs(Clu_EndPos_Wire[n] - intersection_X2) > 80 && hitClu2.size() < 8)) {
+            intersection_X2 = -999;
+            intersection_Y2 = -999;
           }
-          catch (...) {
-            mf::LogWarning("FeatureVertexFinder") << "FindManyHit Function faild";
+
+          if ((abs(Clu_StartPos_Wire[m] - intersection_X) > 80 && hitClu1.size() < 8) ||
+              (abs(Clu_StartPos_Wire[n] - intersection_X) > 80 && hitClu2.size() < 8)) {
             intersection_X = -999;
             intersection_Y = -999;
+          }
+
+          // If the intersection point is 50 or more wires away from
+          // either cluster and the one of the clusters has fewer than 3 hits
+          // the intersection is likely a crap one and we won't save this
+          // point
+          if ((abs(Clu_EndPos_Wire[m] - intersection_X2) > 50 && hitClu1.size() < 4) ||
+              (abs(Clu_EndPos_Wire[n] - intersection_X2) > 50 && hitClu2.size() < 4)) {
             intersection_X2 = -999;
             intersection_Y2 = -999;
-            continue;
           }
 
-          // Push back a candidate 2dClusterVertex if it is inside the
-          // detector
+          if ((abs(Clu_StartPos_Wire[m] - intersection_X) > 50 && hitClu1.size() < 4) ||
+              (abs(Clu_StartPos_Wire[n] - intersection_X) > 50 && hitClu2.size() < 4)) {
+            intersection_X = -999;
+            intersection_Y = -999;
+          }
+        }
+        catch (...) {
+          mf::LogWarning("FeatureVertexFinder") << "FindManyHit Function faild";
+          intersection_X = -999;
+          intersection_Y = -999;
+          intersection_X2 = -999;
+          intersection_Y2 = -999;
+          continue;
+        }
 
-          if (intersection_X2 > 1 && intersection_Y2 > 0 &&
-              (intersection_X2 < geom->Nwires(Clu_Plane[m], 0, 0)) &&
-              (intersection_Y2 < detProp.NumberTimeSamples())) {
+        // Push back a candidate 2dClusterVertex if it is inside the
+        // detector
 
-            TwoDvtx_wire.push_back(intersection_X2);
-            TwoDvtx_time.push_back(intersection_Y2);
-            TwoDvtx_plane.push_back(Clu_Plane[m]);
-          } //<---End saving a "good 2d vertex" candidate
+        if (intersection_X2 > 1 && intersection_Y2 > 0 &&
+            (intersection_X2 < geom->Nwires(Clu_Plane[m], 0, 0)) &&
+            (intersection_Y2 < detProp.NumberTimeSamples())) {
 
-          // Push back a candidate 2dClusterVertex if it is inside the
-          // detector
+          TwoDvtx_wire.push_back(intersection_X2);
+          TwoDvtx_time.push_back(intersection_Y2);
+          TwoDvtx_plane.push_back(Clu_Plane[m]);
+        } //<---End saving a "good 2d vertex" candidate
 
-          if (intersection_X > 1 && intersection_Y > 0 &&
-              (intersection_X < geom->Nwires(Clu_Plane[m], 0, 0)) &&
-              (intersection_Y < detProp.NumberTimeSamples())) {
-            TwoDvtx_wire.push_back(intersection_X);
-            TwoDvtx_time.push_back(intersection_Y);
-            TwoDvtx_plane.push_back(Clu_Plane[m]);
-          } //<---End saving a "good 2d vertex" candidate
+        // Push back a candidate 2dClusterVertex if it is inside the
+        // detector
 
-        } //<---End check that they are in differnt planes
+        if (intersection_X > 1 && intersection_Y > 0 &&
+            (intersection_X < geom->Nwires(Clu_Plane[m], 0, 0)) &&
+            (intersection_Y < detProp.NumberTimeSamples())) {
+          TwoDvtx_wire.push_back(intersection_X);
+          TwoDvtx_time.push_back(intersection_Y);
+          TwoDvtx_plane.push_back(Clu_Plane[m]);
+        } //<---End saving a "good 2d vertex" candidate
       }   //<---End m loop
     }     //<---End n loop
 
@@ -974,41 +1026,73 @@ namespace vertex {
 
     // MERGING THE LONG LIST OF 2D CANDIDATES
 
+    // Two 2d-verticies are merged if they are in the same plane, within
+    // 3 wires and within 10 time ticks of each other. The verticies are
+    // kept in cells of 4 wires by 10 time ticks of each plane (in
+    // increasing order) so that for a vertex only the neighbouring cells
+    // are searched for the next one it can be merged with
+
+    size_t const n2dVtx = Wire_2dvtx.size();
+    std::map<std::array<long long, 3>, std::vector<size_t>> cells;
+    auto cellOf = [&](size_t vtx) {
+      return std::array<long long, 3>{{(long long)std::floor(Plane_2dvtx[vtx]),
+                                       (long long)std::floor(Wire_2dvtx[vtx] / 4.),
+                                       (long long)std::floor(Time_2dvtx[vtx] / 10.)}};
+    };
+    auto isFinite = [&](size_t vtx) {
+      return std::isfinite(Plane_2dvtx[vtx]) && std::isfinite(Wire_2dvtx[vtx]) &&
+             std::isfinite(Time_2dvtx[vtx]);
+    };
+
+    for (size_t vtx = 0; vtx < n2dVtx; vtx++) {
+      if (isFinite(vtx)) { cells[cellOf(vtx)].push_back(vtx); }
+    }
+
+    // First vertex from "first" on which can be merged with vtx (n2dVtx if none)
+    auto nextToMerge = [&](size_t vtx, size_t first) {
+      size_t next = n2dVtx;
+      if (!isFinite(vtx)) { return next; }
+      auto const cell = cellOf(vtx);
+      for (long long dw = -1; dw <= 1; dw++) {
+        for (long long dt = -1; dt <= 1; dt++) {
+          auto const iCell = cells.find({{cell[0], cell[1] + dw, cell[2] + dt}});
+          if (iCell == cells.end()) { continue; }
+          auto const& cellVtx = iCell->second;
+          for (auto iVtx = std::lower_bound(cellVtx.begin(), cellVtx.end(), first);
+               iVtx != cellVtx.end() && *iVtx < next;
+               ++iVtx) {
+            if (Wire_2dvtx[*iVtx] < 0) { continue; }
+            if (Plane_2dvtx[vtx] == Plane_2dvtx[*iVtx] &&
+                fabs(Wire_2dvtx[vtx] - Wire_2dvtx[*iVtx]) < 4 &&
+                fabs(Time_2dvtx[vtx] - Time_2dvtx[*iVtx]) < 10) {
+              next = *iVtx;
+              break;
+            }
+          }
+        }
+      }
+      return next;
+    };
+
     // Looping over 2d-verticies (loop1)
 
-    for (size_t vtxloop1 = 0; vtxloop1 < Wire_2dvtx.size(); vtxloop1++) {
+    for (size_t vtxloop1 = 0; vtxloop1 < n2dVtx; vtxloop1++) {
       if (Wire_2dvtx[vtxloop1] < 0) { continue; }
 
       merged = false;
 
-      // Looping over 2d-verticies (loop2)
-
-      for (size_t vtxloop2 = vtxloop1 + 1; vtxloop2 < Wire_2dvtx.size(); vtxloop2++) {
-        if (Wire_2dvtx[vtxloop2] < 0) { continue; }
-
-        // Make sure the 2d-Verticies are in the same plane
+      // Looping over the later 2d-verticies which can be merged (loop2)
 
-        if (Plane_2dvtx[vtxloop1] == Plane_2dvtx[vtxloop2]) {
-
-          // Considering merging 2d vertices if they
-          //    are within 3 wires of each other
-
-          if (fabs(Wire_2dvtx[vtxloop1] - Wire_2dvtx[vtxloop2]) < 4) {
-
-            // Merge the verticies if they are within 10 time ticks
-
-            if (fabs(Time_2dvtx[vtxloop1] - Time_2dvtx[vtxloop2]) < 10) {
-              vtx_wire_merged.push_back(((Wire_2dvtx[vtxloop2] + Wire_2dvtx[vtxloop1]) / 2));
-              vtx_time_merged.push_back(((Time_2dvtx[vtxloop2] + Time_2dvtx[vtxloop1]) / 2));
-              vtx_plane_merged.push_back(Plane_2dvtx[vtxloop1]);
+      for (size_t vtxloop2 = nextToMerge(vtxloop1, vtxloop1 + 1); vtxloop2 < n2dVtx;
+           vtxloop2 = nextToMerge(vtxloop1, vtxloop2 + 1)) {
+        vtx_wire_merged.push_back(((Wire_2dvtx[vtxloop2] + Wire_2dvtx[vtxloop1]) / 2));
+        vtx_time_merged.push_back(((Time_2dvtx[vtxloop2] + Time_2dvtx[vtxloop1]) / 2));
+        vtx_plane_merged.push_back(Plane_2dvtx[vtxloop1]);
 
-              merged = true;
-              if (vtxloop2 < Wire_2dvtx.size()) { vtxloop2++; }
-              if (vtxloop1 < Wire_2dvtx.size()) { vtxloop1++; }
-            } //<---End the check within 10 time ticks for merging
-          }   //<---Looking at vertices that are within 3 wires of each other
-        }     //<---Only looking at vertices that are in the same plane
-      }       //<---End vtxloop2
+        merged = true;
+        if (vtxloop2 < n2dVtx) { vtxloop2++; }
+        if (vtxloop1 < n2dVtx) { vtxloop1++; }
+      } //<---End vtxloop2
       if (!merged) {
         vtx_wire_merged.push_back(Wire_2dvtx[vtxloop1]);
         vtx_time_merged.push_back(Time_2dvtx[vtxloop1]);
@@ -1016,10 +1100,12 @@ namespace vertex {
       } //<---end saving unmerged verticies
     }   //<---End vtxloop1
 
-    // Variables for channel numbers
+    // Channel numbers and projected X of the merged verticies in a TPC
 
-    uint32_t vtx1_channel = 0;
-    uint32_t vtx2_channel = 0;
+    size_t const nMerged = vtx_wire_merged.size();
+    std::vector<bool> vtx_channel_ok(nMerged);
+    std::vector<raw::ChannelID_t> vtx_channel(nMerged);
+    std::vector<float> vtx_x(nMerged);
 
     // Having now found a very long list of potential 2-d end points
     // we need to check if any of them match between planes and only
@@ -1032,86 +1118,70 @@ namespace vertex {
       // Looping over TPC's
 
       for (size_t tpc = 0; tpc < geom->Cryostat(cstat).NTPC(); ++tpc) {
-        for (unsigned int vtx = vtx_wire_merged.size(); vtx > 0; vtx--) {
-          for (unsigned int vtx1 = 0; vtx1 < vtx; vtx1++) {
 
-            // Check to make sure we are comparing verticies from different
-            // planes
-
-            if (vtx_plane_merged[vtx1] != vtx_plane_merged[vtx]) {
-              // To figure out if these two verticies are from a
-              // common point we need to check if the channels
-              // intersect and if they are close in time ticks as
-              // well...to do this we have to do some converting to
-              // use geom->PlaneWireToChannel(PlaneNo, Wire, tpc,
-              // cstat)
-              bool match = false;
-
-              unsigned int vtx1_plane = vtx_plane_merged[vtx1];
-              unsigned int vtx1_wire = vtx_wire_merged[vtx1];
-              try {
-                vtx1_channel = geom->PlaneWireToChannel(vtx1_plane, vtx1_wire, tpc, cstat);
-              }
-              catch (...) {
-                mf::LogWarning("FeatureVertexFinder") << "PlaneWireToChannel Failed";
-                match = false;
-                continue;
-              }
+        // No more than 100 candidates are kept...because more than that
+        // seems silly
 
-              unsigned int vtx2_plane = vtx_plane_merged[vtx];
-              unsigned int vtx2_wire = vtx_wire_merged[vtx];
-              try {
-                vtx2_channel = geom->PlaneWireToChannel(vtx2_plane, vtx2_wire, tpc, cstat);
-              }
-              catch (...) {
-                mf::LogWarning("FeatureVertexFinder") << "PlaneWireToChannel Failed";
-                match = false;
-                continue;
-              }
+        if (candidate_x.size() >= 101) { return; }
 
-              // Check to see if the channels intersect and save the y and z
-              // coordinate
+        // To figure out if two verticies are from a common point we need
+        // to check if the channels intersect and if they are close in time
+        // ticks as well...to do this we have to do some converting to use
+        // geom->PlaneWireToChannel(PlaneNo, Wire, tpc, cstat)
 
-              try {
-                match = geom->ChannelsIntersect(vtx1_channel, vtx2_channel, y_coord, z_coord);
-              }
-              catch (...) {
-                mf::LogWarning("FeatureVertexFinder") << "match failed for some reason";
-                match = false;
-                continue;
-              }
+        for (size_t vtx = 0; vtx < nMerged; vtx++) {
+          unsigned int vtx_plane = vtx_plane_merged[vtx];
+          unsigned int vtx_wire = vtx_wire_merged[vtx];
+          try {
+            vtx_channel[vtx] = geom->PlaneWireToChannel(vtx_plane, vtx_wire, tpc, cstat);
+            vtx_channel_ok[vtx] = true;
+          }
+          catch (...) {
+            mf::LogWarning("FeatureVertexFinder") << "PlaneWireToChannel Failed";
+            vtx_channel_ok[vtx] = false;
+          }
+          vtx_x[vtx] = detProp.ConvertTicksToX(vtx_time_merged[vtx], vtx_plane, tpc, cstat);
+        }
+
+        for (size_t vtx = nMerged; vtx-- > 1;) {
+          if (!vtx_channel_ok[vtx]) { continue; }
+          for (size_t vtx1 = 0; vtx1 < vtx; vtx1++) {
+
+            // Check to make sure we are comparing verticies from different
+            // planes, that both have a channel and that they are within
+            // 0.5 cm when projected in X
 
-              // If the channels intersect establish if they are close in
-              // "X"
-
-              if (match) {
-                float tempXCluster1 =
-                  detProp.ConvertTicksToX(vtx_time_merged[vtx1], vtx1_plane, tpc, cstat);
-                float tempXCluster2 =
-                  detProp.ConvertTicksToX(vtx_time_merged[vtx], vtx2_plane, tpc, cstat);
-
-                // Now check if the matched channels are within 0.5 cm when
-                // projected in X and that we have less than 100 of these
-                // candidates...because more than that seems silly
-
-                if (std::abs(tempXCluster1 - tempXCluster2) < 0.5 && candidate_x.size() < 101) {
-                  candidate_x.push_back(detProp.ConvertTicksToX(
-                    vtx_time_merged[vtx1], vtx_plane_merged[vtx1], tpc, cstat));
-                  candidate_y.push_back(y_coord);
-                  candidate_z.push_back(z_coord);
-                  candidate_strength.push_back(
-                    10); //<--For cluster verticies I give it a strength of "10"
-                         // arbitrarily for now
-
-                } //<---End Checking if the vertices agree "well enough" in time
-                  // tick
-              }   //<---End Checking if verticies intersect
-
-            } //<--- End checking we are in different planes
-          }   //<---end vtx1 for loop
-        }     //<---End vtx for loop
-      }       //<---End loop over TPC's
-    }         //<---End loop over cryostats
+            if (vtx_plane_merged[vtx1] == vtx_plane_merged[vtx]) { continue; }
+            if (!vtx_channel_ok[vtx1]) { continue; }
+            if (!(std::abs(vtx_x[vtx1] - vtx_x[vtx]) < 0.5)) { continue; }
+
+            // Check to see if the channels intersect and save the y and z
+            // coordinate
+
+            bool match = false;
+            try {
+              match =
+                geom->ChannelsIntersect(vtx_channel[vtx1], vtx_channel[vtx], y_coord, z_coord);
+            }
+            catch (...) {
+              mf::LogWarning("FeatureVertexFinder") << "match failed for some reason";
+              continue;
+            }
+            if (!match) { continue; }
+
+            candidate_x.push_back(detProp.ConvertTicksToX(
+              vtx_time_merged[vtx1], vtx_plane_merged[vtx1], tpc, cstat));
+            candidate_y.push_back(y_coord);
+            candidate_z.push_back(z_coord);
+            candidate_strength.push_back(
+              10); //<--For cluster verticies I give it a strength of "10"
+                   // arbitrarily for now
+
+            if (candidate_x.size() >= 101) { return; }
+          } //<---end vtx1 for loop
+        }   //<---End vtx for loop
+      }     //<---End loop over TPC's
+    }       //<---End loop over cryostats
 
   } //<---End Find3dVtxFrom2dClusterVtxCand
 
@@ -1130,87 +1200,75 @@ namespace vertex {
     std::vector<double> z_3dVertex_dupRemoved = {0.};
     std::vector<double> strength_dupRemoved = {0.};
 
-    // Looping over the 3d candidates found thus far
-
-    for (size_t dup = 0; dup < merge_vtxX.size(); dup++) {
+    // A candidate is a duplicate if a later one matches it in x, y, and z
+    // within 0.1 cm for all 3 coordinates simultaneously. Looping over the
+    // 3d candidates backwards, the ones already seen are kept in 0.2 cm
+    // cells so that only the neighbouring cells are checked
+
+    size_t const nCandidates = merge_vtxX.size();
+    std::vector<bool> duplicate(nCandidates, false);
+    std::map<std::array<long long, 3>, std::vector<size_t>> cells;
+    auto cellOf = [](double x, double y, double z) {
+      return std::array<long long, 3>{{(long long)std::floor(x / 0.2),
+                                       (long long)std::floor(y / 0.2),
+                                       (long long)std::floor(z / 0.2)}};
+    };
+
+    for (size_t dup = nCandidates; dup-- > 0;) {
       // Temperary storing the current vertex
       float tempX_dup = merge_vtxX[dup];
       float tempY_dup = merge_vtxY[dup];
       float tempZ_dup = merge_vtxZ[dup];
-      float tempStgth = merge_vtxStgth[dup];
-
-      // Setting a boolian to see if this is a duplicate
-
-      bool duplicate_found = false;
-
-      // Looping over the rest of the list for duplicate check
 
-      for (size_t check = dup + 1; check < merge_vtxX.size(); check++) {
-
-        // I am going to call a duplicate vertex one that matches in x, y,
-        // and z within 0.1 cm for all 3 coordinates simultaneously
-
-        if (std::abs(merge_vtxX[check] - tempX_dup) < 0.1 &&
-            std::abs(merge_vtxY[check] - tempY_dup) < 0.1 &&
-            std::abs(merge_vtxZ[check] - tempZ_dup) < 0.1) {
-          duplicate_found = true;
-        } //<---End checking to see if this is a duplicate vertex
+      auto const cell = cellOf(tempX_dup, tempY_dup, tempZ_dup);
+      for (long long dx = -1; dx <= 1 && !duplicate[dup]; dx++) {
+        for (long long dy = -1; dy <= 1 && !duplicate[dup]; dy++) {
+          for (long long dz = -1; dz <= 1 && !duplicate[dup]; dz++) {
+            auto const iCell = cells.find({{cell[0] + dx, cell[1] + dy, cell[2] + dz}});
+            if (iCell == cells.end()) { continue; }
+            for (size_t const check : iCell->second) {
+              if (std::abs(merge_vtxX[check] - tempX_dup) < 0.1 &&
+                  std::abs(merge_vtxY[check] - tempY_dup) < 0.1 &&
+                  std::abs(merge_vtxZ[check] - tempZ_dup) < 0.1) {
+                duplicate[dup] = true;
+                break;
+              } //<---End checking to see if this is a duplicate vertex
+            }
+          }
+        }
+      } //<---End check of the neighbouring cells
 
-      } //<---End check for loop
+      cells[cellOf(merge_vtxX[dup], merge_vtxY[dup], merge_vtxZ[dup])].push_back(dup);
+    } //<---End dup for loop
 
-      // If we didn't find a duplicate then lets save this 3d vertex
-      // as a real candidate for consideration
+    // If we didn't find a duplicate then lets save this 3d vertex
+    // as a real candidate for consideration
 
-      if (!duplicate_found && tempX_dup > 0) {
+    for (size_t dup = 0; dup < nCandidates; dup++) {
+      float tempX_dup = merge_vtxX[dup];
+      if (!duplicate[dup] && tempX_dup > 0) {
         x_3dVertex_dupRemoved.push_back(tempX_dup);
-        y_3dVertex_dupRemoved.push_back(tempY_dup);
-        z_3dVertex_dupRemoved.push_back(tempZ_dup);
-        strength_dupRemoved.push_back(tempStgth);
+        y_3dVertex_dupRemoved.push_back(float(merge_vtxY[dup]));
+        z_3dVertex_dupRemoved.push_back(float(merge_vtxZ[dup]));
+        strength_dupRemoved.push_back(float(merge_vtxStgth[dup]));
       } //<---End storing only non-duplicates
-
-    } //<---End dup for loop
+    }
 
     // Sorting the verticies I have found such that the first in the
     // list is the vertex with the highest vertex strength and the
-    // lowest z location
-
-    int flag = 1;
-    double tempX, tempY, tempZ, tempS;
-
-    // Looping over all duplicate removed candidates
-
-    for (size_t npri = 0; (npri < x_3dVertex_dupRemoved.size()) && flag; npri++) {
-      flag = 0;
-      for (size_t mpri = 0; mpri < x_3dVertex_dupRemoved.size() - 1; mpri++) {
-        // Swap the order of the two elements
-        if (strength_dupRemoved[mpri + 1] > strength_dupRemoved[mpri] ||
-            (strength_dupRemoved[mpri + 1] == strength_dupRemoved[mpri] &&
-             z_3dVertex_dupRemoved[mpri] > z_3dVertex_dupRemoved[mpri + 1])) {
-          tempX = x_3dVertex_dupRemoved[mpri];
-          x_3dVertex_dupRemoved[mpri] = x_3dVertex_dupRemoved[mpri + 1];
-          x_3dVertex_dupRemoved[mpri + 1] = tempX;
-
-          tempY = y_3dVertex_dupRemoved[mpri];
-          y_3dVertex_dupRemoved[mpri] = y_3dVertex_dupRemoved[mpri + 1];
-          y_3dVertex_dupRemoved[mpri + 1] = tempY;
-
-          tempZ = z_3dVertex_dupRemoved[mpri];
-          z_3dVertex_dupRemoved[mpri] = z_3dVertex_dupRemoved[mpri + 1];
-          z_3dVertex_dupRemoved[mpri + 1] = tempZ;
-
-          tempS = strength_dupRemoved[mpri];
-          strength_dupRemoved[mpri] = strength_dupRemoved[mpri + 1];
-          strength_dupRemoved[mpri + 1] = tempS;
-
-          flag = 1;
+    // lowest z location (keeping the order of the equal ones)
 
-        } //<---Inside swap loop
-      }   //<---End mpri
-    }     //<---End npri loop
+    std::vector<size_t> order(x_3dVertex_dupRemoved.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return strength_dupRemoved[a] > strength_dupRemoved[b] ||
+             (strength_dupRemoved[a] == strength_dupRemoved[b] &&
+              z_3dVertex_dupRemoved[a] < z_3dVertex_dupRemoved[b]);
+    });
 
     // Pushing into a vector of merged and sorted verticies
 
-    for (size_t count = 0; count < x_3dVertex_dupRemoved.size(); count++) {
+    for (size_t const count : order) {
       MergeSort3dVtx_xpos.push_back(x_3dVertex_dupRemoved[count]);
       MergeSort3dVtx_ypos.push_back(y_3dVertex_dupRemoved[count]);
       MergeSort3dVtx_zpos.push_back(z_3dVertex_dupRemoved[count]);
@@ -0,0 +1,205 @@
+/**
+ * @file   CMergeManagerBroadPhase_test.cc
+ * @brief  Test of the broad phase of the cluster merging manager
+ * @see    CMergeManager.h, CBAlgoArray.h
+ *
+ * Clusters of hits are scattered on two planes and merged by a
+ * `cmtool::CBAlgoArray` mixing AND and OR steps, some of which declare the
+ * distance beyond which they are false. The pairs found to merge among the
+ * candidates of the broad phase of `cmtool::CMergeManager` must be the same as
+ * the ones found among all the pairs of clusters.
+ */
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+// boost test libraries
+#define BOOST_TEST_MODULE ( CMergeManagerBroadPhase_test )
+#include "cetlib/quiet_unit_test.hpp"
+
+// LArSoft libraries
+#include "lardata/Utilities/PxUtils.h"
+#include "larreco/RecoAlg/CMTool/CMTAlgMerge/CBAlgoArray.h"
+#include "larreco/RecoAlg/CMTool/CMToolBase/CBoolAlgoBase.h"
+#include "larreco/RecoAlg/CMTool/CMToolBase/CMergeBookKeeper.h"
+#include "larreco/RecoAlg/CMTool/CMToolBase/CMergeManager.h"
+#include "larreco/RecoAlg/ClusterRecoUtil/ClusterParamsAlg.h"
+
+
+namespace {
+
+  using Clusters_t = std::vector<cluster::ClusterParamsAlg>;
+  using Pairs_t = std::set<std::pair<size_t, size_t>>;
+
+
+  /// Distance between the boxes around the hits of two clusters
+  double EnvelopeDistance(cluster::ClusterParamsAlg const& c1, cluster::ClusterParamsAlg const& c2)
+  {
+    auto box = [](cluster::ClusterParamsAlg const& c) {
+      std::array<double, 4> b{{1e9, -1e9, 1e9, -1e9}};
+      for (auto const& hit : c.GetHitVector()) {
+        b[0] = std::min(b[0], hit.w);
+        b[1] = std::max(b[1], hit.w);
+        b[2] = std::min(b[2], hit.t);
+        b[3] = std::max(b[3], hit.t);
+      }
+      return b;
+    };
+    auto const b1 = box(c1), b2 = box(c2);
+    double const dw = std::max({0., b1[0] - b2[1], b2[0] - b1[1]});
+    double const dt = std::max({0., b1[2] - b2[3], b2[2] - b1[3]});
+    return std::sqrt(dw * dw + dt * dt);
+  } // EnvelopeDistance()
+
+
+  /// True for clusters closer than a distance, which it declares
+  class NearAlgo : public cmtool::CBoolAlgoBase {
+  public:
+    NearAlgo(double dist) : fDist(dist) {}
+    bool Bool(cluster::ClusterParamsAlg const& c1, cluster::ClusterParamsAlg const& c2) override
+      { return EnvelopeDistance(c1, c2) <= fDist; }
+    double MaxPairDistance() const override { return fDist; }
+  private:
+    double fDist;
+  }; // NearAlgo
+
+
+  /// True for some clusters at any distance; declares no distance
+  class HitCountAlgo : public cmtool::CBoolAlgoBase {
+  public:
+    bool Bool(cluster::ClusterParamsAlg const& c1, cluster::ClusterParamsAlg const& c2) override
+      { return (c1.GetNHits() + c2.GetNHits()) % 5 == 0; }
+  }; // HitCountAlgo
+
+
+  /// Exposes the candidate pairs of the merging manager
+  class TestMergeManager : public cmtool::CMergeManager {
+  public:
+    std::vector<std::pair<size_t, size_t>> Candidates(Clusters_t const& clusters)
+    {
+      ComputePriority(clusters);
+      cmtool::CMergeBookKeeper bk(clusters.size());
+      return MergeCandidates(clusters, std::vector<bool>(clusters.size(), true), bk);
+    }
+  }; // TestMergeManager
+
+
+  /// Clusters of 10 to 20 hits around random points of two planes
+  Clusters_t MakeClusters(std::mt19937& engine, unsigned int n)
+  {
+    std::uniform_real_distribution<double> center(0., 300.), spread(-4., 4.);
+    std::uniform_int_distribution<unsigned int> nHits(10, 20);
+    Clusters_t clusters;
+    for (unsigned int i = 0; i < n; ++i) {
+      double const w = center(engine), t = center(engine);
+      std::vector<util::PxHit> hits(nHits(engine));
+      for (auto& hit : hits) {
+        hit.plane = i % 2;
+        hit.w = w + spread(engine);
+        hit.t = t + spread(engine);
+        hit.charge = 1.;
+      }
+      clusters.emplace_back();
+      clusters.back().SetVerbose(false);
+      clusters.back().SetHits(hits);
+    }
+    return clusters;
+  } // MakeClusters()
+
+
+  /// The candidate pairs that the algorithm merges
+  Pairs_t MergingPairs(std::vector<std::pair<size_t, size_t>> const& candidates,
+                       cmtool::CBoolAlgoBase& algo,
+                       Clusters_t const& clusters)
+  {
+    Pairs_t pairs;
+    for (auto const& [i1, i2] : candidates)
+      if (algo.Bool(clusters[i1], clusters[i2])) pairs.emplace(std::min(i1, i2), std::max(i1, i2));
+    return pairs;
+  } // MergingPairs()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE( CMergeManagerBroadPhaseSuite )
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MaxPairDistanceTest)
+{
+  HitCountAlgo any;
+  NearAlgo near5(5.), near2(2.), near3(3.);
+
+  // any OR near5 AND near2 is true whenever `any` is
+  cmtool::CBAlgoArray anyOrNear;
+  anyOrNear.AddAlgo(&any);
+  anyOrNear.AddAlgo(&near5, false);
+  anyOrNear.AddAlgo(&near2, true);
+  BOOST_TEST(anyOrNear.MaxPairDistance() < 0.);
+
+  // near5 AND near2 OR near3
+  cmtool::CBAlgoArray nearOrNear;
+  nearOrNear.AddAlgo(&near5);
+  nearOrNear.AddAlgo(&near2, true);
+  nearOrNear.AddAlgo(&near3, false);
+  BOOST_TEST(nearOrNear.MaxPairDistance() == 3.);
+
+  cmtool::CBAlgoArray nearAndNear;
+  nearAndNear.AddAlgo(&near5);
+  nearAndNear.AddAlgo(&near2, true);
+  BOOST_TEST(nearAndNear.MaxPairDistance() == 2.);
+
+  cmtool::CBAlgoArray anyAndNear;
+  anyAndNear.AddAlgo(&any);
+  anyAndNear.AddAlgo(&near3, true);
+  BOOST_TEST(anyAndNear.MaxPairDistance() == 3.);
+} // BOOST_AUTO_TEST_CASE(MaxPairDistanceTest)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(BroadPhaseTest)
+{
+  std::mt19937 engine(24680);
+  auto const clusters = MakeClusters(engine, 200);
+
+  HitCountAlgo any;
+  NearAlgo near5(5.), near2(2.), near3(3.);
+
+  cmtool::CBAlgoArray anyOrNear;
+  anyOrNear.AddAlgo(&any);
+  anyOrNear.AddAlgo(&near5, false);
+  anyOrNear.AddAlgo(&near2, true);
+
+  cmtool::CBAlgoArray nearOrNear;
+  nearOrNear.AddAlgo(&near5);
+  nearOrNear.AddAlgo(&near2, true);
+  nearOrNear.AddAlgo(&near3, false);
+
+  for (auto* algo : {&anyOrNear, &nearOrNear}) {
+    TestMergeManager manager;
+    manager.AddMergeAlgo(algo);
+    auto const all = manager.Candidates(clusters);
+    manager.UseBroadPhase();
+    auto const broad = manager.Candidates(clusters);
+
+    auto const allMerging = MergingPairs(all, *algo, clusters);
+    auto const broadMerging = MergingPairs(broad, *algo, clusters);
+    BOOST_TEST(!allMerging.empty());
+    BOOST_TEST(broadMerging.size() == allMerging.size());
+    BOOST_TEST((broadMerging == allMerging));
+    // the broad phase is a subset of all the pairs, and prunes when it can
+    BOOST_TEST(broad.size() <= all.size());
+    if (algo->MaxPairDistance() >= 0.) BOOST_TEST(broad.size() < all.size());
+  } // algo
+
+} // BOOST_AUTO_TEST_CASE(BroadPhaseTest)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,249 @@
+/**
+ * @file   FlatKdTree_test.cc
+ * @brief  Test and benchmark of lar_cluster3d::FlatKdTree
+ * @see    FlatKdTree.h
+ *
+ * An event of about 100k 3D hits is simulated as a set of straight tracks in
+ * a MicroBooNE-like TPC. The neighborhoods found by the flat tree are
+ * compared with a brute force application of the `kdTree::consistentPairs()`
+ * criteria, and with the ones of the node based kdTree.
+ * The time spent by each tree is printed.
+ */
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+// boost test libraries
+#define BOOST_TEST_MODULE ( FlatKdTree_test )
+#include "cetlib/quiet_unit_test.hpp"
+
+// framework libraries
+#include "fhiclcpp/ParameterSet.h"
+
+// LArSoft libraries
+#include "larreco/RecoAlg/Cluster3DAlgs/Cluster3D.h"
+#include "larreco/RecoAlg/Cluster3DAlgs/FlatKdTree.h"
+#include "larreco/RecoAlg/Cluster3DAlgs/kdTree.h"
+
+
+namespace {
+
+  constexpr float WirePitch = 0.3;       ///< [cm]
+  constexpr float TicksPerCm = 18.2;     ///< drift velocity and sampling
+  constexpr float RefLeafBestDist = 1.99 * WirePitch; ///< as set by DBScanAlg
+  constexpr float PairSigmaPeakTime = 3.;
+
+  /// Wire numbers of a point on the three planes (+60, -60 and 0 degrees)
+  std::vector<geo::WireID> MakeWireIDs(float y, float z) {
+    float const cos60 = 0.5, sin60 = std::sqrt(3.) / 2.;
+    float const u = z * cos60 + (y + 120.) * sin60;
+    float const v = z * cos60 - (y - 120.) * sin60;
+    return {
+      geo::WireID(0, 0, 0, geo::WireID::WireID_t(u / WirePitch)),
+      geo::WireID(0, 0, 1, geo::WireID::WireID_t(v / WirePitch)),
+      geo::WireID(0, 0, 2, geo::WireID::WireID_t(z / WirePitch))
+    };
+  } // MakeWireIDs()
+
+
+  /// Simulates straight tracks with a 3D hit every wire pitch
+  reco::HitPairList MakeEvent(std::size_t nHits, unsigned int seed = 12345) {
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<float> xDist(0., 256.), yDist(-116., 116.), zDist(0., 1036.);
+    std::uniform_real_distribution<float> lengthDist(5., 250.), sigmaDist(1., 4.);
+    std::normal_distribution<float> dirDist(0., 1.), jitter(0., 0.05);
+
+    reco::HitPairList hits;
+    while (hits.size() < nHits) {
+      float pos[3] = { xDist(engine), yDist(engine), zDist(engine) };
+      float dir[3] = { dirDist(engine), dirDist(engine), dirDist(engine) };
+      float const norm = std::sqrt(dir[0]*dir[0] + dir[1]*dir[1] + dir[2]*dir[2]);
+      for (float& d: dir) d *= WirePitch / norm;
+
+      std::size_t const nSteps = lengthDist(engine) / WirePitch;
+      for (std::size_t step = 0; (step < nSteps) && (hits.size() < nHits); ++step) {
+        for (std::size_t i = 0; i < 3; ++i) pos[i] += dir[i];
+        if (pos[0] < 0. || pos[0] > 256. || std::abs(pos[1]) > 116. || pos[2] < 0. || pos[2] > 1036.) break;
+
+        Eigen::Vector3f const position
+          (pos[0] + jitter(engine), pos[1] + jitter(engine), pos[2] + jitter(engine));
+        hits.emplace_back(hits.size(), 0, position, 100., position[0] * TicksPerCm,
+          0., sigmaDist(engine), 1., 1., 0., 0., 0., reco::ClusterHit2DVec(),
+          std::vector<float>(3, 0.), MakeWireIDs(position[1], position[2]));
+      } // for steps
+    } // while
+    return hits;
+  } // MakeEvent()
+
+
+  fhicl::ParameterSet MakeTreeConfig() {
+    fhicl::ParameterSet pset;
+    pset.put("EnableMonitoring", true);
+    pset.put("PairSigmaPeakTime", PairSigmaPeakTime);
+    pset.put("RefLeafBestDist", RefLeafBestDist);
+    pset.put("LeafSize", 8);
+    return pset;
+  } // MakeTreeConfig()
+
+
+  /// The kdTree::consistentPairs() criteria, applied with RefLeafBestDist
+  bool AreNeighbors
+    (reco::ClusterHit3D const& ref, reco::ClusterHit3D const& hit, float& dist)
+  {
+    if (&ref == &hit) return false;
+    if (std::fabs(ref.getAvePeakTime() - hit.getAvePeakTime())
+      >= PairSigmaPeakTime * (ref.getSigmaPeakTime() + hit.getSigmaPeakTime()))
+      return false;
+    for (std::size_t i = 0; i < 3; ++i) {
+      if (std::abs(int(ref.getWireIDs()[i].Wire) - int(hit.getWireIDs()[i].Wire)) >= 3)
+        return false;
+    }
+    float const dy = ref.getY() - hit.getY(), dz = ref.getZ() - hit.getZ();
+    dist = std::max(float(0.0001), std::sqrt(dy*dy + dz*dz));
+    return dist < RefLeafBestDist;
+  } // AreNeighbors()
+
+
+  using HitSet_t = std::set<const reco::ClusterHit3D*>;
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE( FlatKdTreeSuite )
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(BruteForceTest)
+{
+  reco::HitPairList const hits = MakeEvent(10000);
+
+  lar_cluster3d::FlatKdTree const tree(MakeTreeConfig());
+  lar_cluster3d::FlatKdTree::TreeData treeData;
+  tree.BuildTree(hits, treeData);
+  BOOST_TEST(treeData.size() == hits.size());
+
+  lar_cluster3d::FlatKdTree::Neighborhoods neighborhoods;
+  tree.FindNearestNeighbors(treeData, neighborhoods);
+
+  std::size_t nNeighbors = 0;
+  lar_cluster3d::FlatKdTree::CandPairVec candPairVec;
+  std::size_t inputIdx = 0;
+  for (auto const& ref: hits) {
+    HitSet_t expected;
+    float dist = 0.;
+    for (auto const& hit: hits) if (AreNeighbors(ref, hit, dist)) expected.insert(&hit);
+    nNeighbors += expected.size();
+
+    // single hit query
+    candPairVec.clear();
+    tree.FindNearestNeighbors(&ref, treeData, candPairVec);
+    HitSet_t found;
+    for (auto const& pair: candPairVec) {
+      BOOST_TEST(AreNeighbors(ref, *pair.second, dist));
+      BOOST_TEST(pair.first == dist);
+      found.insert(pair.second);
+    }
+    BOOST_TEST(found.size() == candPairVec.size());
+    BOOST_TEST((found == expected));
+
+    // batched query
+    std::size_t const slot = treeData.inputToSlot[inputIdx++];
+    BOOST_TEST(treeData.hits[slot] == &ref);
+    HitSet_t batchFound;
+    for (auto it = neighborhoods.begin(slot); it != neighborhoods.end(slot); ++it)
+      batchFound.insert(treeData.hits[it->slot]);
+    BOOST_TEST((batchFound == expected));
+  } // for
+
+  // make sure the test is not trivial
+  BOOST_TEST(nNeighbors > 2 * hits.size());
+
+} // BOOST_AUTO_TEST_CASE(BruteForceTest)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(BenchmarkTest)
+{
+  reco::HitPairList const hits = MakeEvent(100000);
+
+  using clock_t = std::chrono::steady_clock;
+  std::chrono::duration<double> buildFlat{0}, queryFlat{0}, batchFlat{0}, buildNode{0}, queryNode{0};
+
+  fhicl::ParameterSet const config = MakeTreeConfig();
+
+  // node based tree
+  lar_cluster3d::kdTree const nodeTree(config);
+  auto start = clock_t::now();
+  lar_cluster3d::kdTree::KdTreeNodeList nodeContainer;
+  lar_cluster3d::kdTree::KdTreeNode topNode = nodeTree.BuildKdTree(hits, nodeContainer);
+  buildNode += clock_t::now() - start;
+
+  std::vector<lar_cluster3d::kdTree::CandPairList> nodeNeighbors(hits.size());
+  start = clock_t::now();
+  std::size_t nNodeNeighbors = 0, inputIdx = 0;
+  for (auto const& hit: hits) {
+    float bestDistance = std::numeric_limits<float>::max();
+    nNodeNeighbors += nodeTree.FindNearestNeighbors
+      (&hit, topNode, nodeNeighbors[inputIdx++], bestDistance);
+  }
+  queryNode += clock_t::now() - start;
+
+  // flat tree
+  lar_cluster3d::FlatKdTree const flatTree(config);
+  lar_cluster3d::FlatKdTree::TreeData treeData;
+  start = clock_t::now();
+  flatTree.BuildTree(hits, treeData);
+  buildFlat += clock_t::now() - start;
+
+  start = clock_t::now();
+  std::size_t nFlatNeighbors = 0;
+  lar_cluster3d::FlatKdTree::CandPairVec candPairVec;
+  for (auto const& hit: hits) {
+    candPairVec.clear();
+    nFlatNeighbors += flatTree.FindNearestNeighbors(&hit, treeData, candPairVec);
+  }
+  queryFlat += clock_t::now() - start;
+
+  start = clock_t::now();
+  lar_cluster3d::FlatKdTree::Neighborhoods neighborhoods;
+  flatTree.FindNearestNeighbors(treeData, neighborhoods);
+  batchFlat += clock_t::now() - start;
+
+  BOOST_TEST(neighborhoods.neighbors.size() == nFlatNeighbors);
+
+  // compare the neighborhoods: the node based tree may miss neighbors pruned
+  // on the drift coordinate, but it should not find any the flat one does not
+  std::size_t nDifferent = 0, nMissingInNode = 0;
+  inputIdx = 0;
+  for (auto const& nodeCandPairs: nodeNeighbors) {
+    std::size_t const slot = treeData.inputToSlot[inputIdx++];
+    HitSet_t found;
+    for (auto it = neighborhoods.begin(slot); it != neighborhoods.end(slot); ++it)
+      found.insert(treeData.hits[it->slot]);
+    if (found.size() == nodeCandPairs.size()) continue;
+    ++nDifferent;
+    for (auto const& pair: nodeCandPairs) BOOST_TEST(found.count(pair.second) == 1U);
+    nMissingInNode += found.size() - nodeCandPairs.size();
+  }
+
+  std::cout << "Neighborhoods of " << hits.size() << " hits:"
+    << "\n  kdTree:     build " << (buildNode.count() * 1e3) << " ms, query "
+      << (queryNode.count() * 1e3) << " ms, " << nNodeNeighbors << " neighbors"
+    << "\n  FlatKdTree: build " << (buildFlat.count() * 1e3) << " ms, query "
+      << (queryFlat.count() * 1e3) << " ms (batched: " << (batchFlat.count() * 1e3)
+      << " ms), " << nFlatNeighbors << " neighbors"
+    << "\n  " << nDifferent << " hits with different neighborhoods, "
+      << nMissingInNode << " neighbors not found by kdTree"
+    << std::endl;
+
+} // BOOST_AUTO_TEST_CASE(BenchmarkTest)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,263 @@
+/**
+ * @file   HoughTransformTiledCounters_test.cc
+ * @brief  Test of the dense Hough transform accumulator
+ * @see    HoughBaseAlg.h
+ *
+ * Hits are added to and removed from a `cluster::HoughTransformTiledCounters`
+ * the way `HoughTransform` does, and the counters and maxima are compared with
+ * the ones of a map of counters per angle, the layout of the accumulator based
+ * on `cluster::HoughTransformCounters`.
+ */
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+// boost test libraries
+#define BOOST_TEST_MODULE ( HoughTransformTiledCounters_test )
+#include "cetlib/quiet_unit_test.hpp"
+
+// LArSoft libraries
+#include "larreco/RecoAlg/HoughBaseAlg.h"
+
+
+namespace {
+
+  using Counter_t = signed char;
+  using Dense_t = cluster::HoughTransformTiledCounters<Counter_t>;
+
+  constexpr unsigned int NumAngleCells = 1000;
+  constexpr float RhoResolutionFactor = 5.;
+  constexpr int Dx = 400, Dy = 1000; // wires and ticks
+
+
+  /// Reference accumulator: one map of counters per angle
+  class MapAccumulator {
+  public:
+    std::pair<int, Counter_t>
+    increment_and_get_max(unsigned int angle, int begin, int end, Counter_t current_max)
+    {
+      std::pair<int, Counter_t> max{end, current_max};
+      for (int key = begin; key < end; ++key) {
+        Counter_t const value = ++fAccum[angle][key];
+        if (value > max.second) max = {key, value};
+      }
+      return max;
+    }
+    void
+    decrement(unsigned int angle, int begin, int end)
+    {
+      for (int key = begin; key < end; ++key)
+        --fAccum[angle][key];
+    }
+    Counter_t
+    get(unsigned int angle, int key) const
+    {
+      auto const iAngle = fAccum.find(angle);
+      if (iAngle == fAccum.end()) return 0;
+      auto const iKey = iAngle->second.find(key);
+      return (iKey == iAngle->second.end()) ? 0 : iKey->second;
+    }
+    std::map<unsigned int, std::map<int, Counter_t>> const&
+    accum() const
+    {
+      return fAccum;
+    }
+
+  private:
+    std::map<unsigned int, std::map<int, Counter_t>> fAccum;
+  }; // MapAccumulator
+
+
+  /// Sinusoid of the point (x, y), rasterized as in HoughTransform
+  template <typename Accum>
+  std::array<int, 3>
+  AddPoint(Accum& accum, int x, int y, bool subtract)
+  {
+    std::array<int, 3> max{{-1, -1, -1}};
+    int max_val = 2;
+    unsigned int const rowLength =
+      (unsigned int)(RhoResolutionFactor * 2 * std::sqrt(Dx * Dx + Dy * Dy));
+    int const distCenter = (int)(rowLength / 2.);
+    int lastDist = (int)(distCenter + (RhoResolutionFactor * x));
+    for (unsigned int iAngle = 1; iAngle < NumAngleCells; ++iAngle) {
+      double const a = iAngle * M_PI / NumAngleCells;
+      int const dist = (int)(distCenter + RhoResolutionFactor * (std::cos(a) * x + std::sin(a) * y));
+      int const first_dist = (lastDist == dist) ? dist : (dist > lastDist ? lastDist : dist + 1);
+      int const end_dist = (lastDist == dist) ? dist + 1 : (dist > lastDist ? dist : lastDist + 1);
+      if (subtract)
+        accum.decrement(iAngle, first_dist, end_dist);
+      else {
+        auto const max_counter = accum.increment_and_get_max(iAngle, first_dist, end_dist, max_val);
+        if (max_counter.second > max_val) {
+          max = {{max_counter.second, max_counter.first, (int)iAngle}};
+          max_val = max_counter.second;
+        }
+      }
+      lastDist = dist;
+    } // for angles
+    return max;
+  } // AddPoint()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE( HoughTransformTiledCountersSuite )
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(RangeTest)
+{
+  Dense_t accum;
+  accum.init(32, -2, 100);
+  BOOST_TEST(accum.n_tiles() == 0U);
+  BOOST_TEST(accum.get(5, 10) == 0);
+
+  // a range across two tiles, with the maximum in the second one
+  accum.increment_and_get_max(5, 60, 70, 0);
+  auto max = accum.increment_and_get_max(5, 65, 66, 0);
+  BOOST_TEST(max.first == 65);
+  BOOST_TEST(max.second == 2);
+  BOOST_TEST(accum.n_tiles() == 2U);
+
+  // no counter above the current maximum
+  max = accum.increment_and_get_max(5, 66, 68, 2);
+  BOOST_TEST(max.first == 68);
+  BOOST_TEST(max.second == 2);
+
+  // keys out of range extend the accumulator, keeping the existing counters
+  accum.increment_and_get_max(6, -10, 0, 0);
+  BOOST_TEST(accum.get(6, -11) == 0);
+  BOOST_TEST(accum.get(6, -10) == 1);
+  BOOST_TEST(accum.get(6, -2) == 1);
+  BOOST_TEST(accum.get(6, 0) == 0);
+  BOOST_TEST(accum.get(5, 65) == 2);
+  BOOST_TEST(accum.n_tiles() == 3U);
+  accum.set(7, 500, 4);
+  BOOST_TEST(accum.get(7, 500) == 4);
+  BOOST_TEST(accum.get(5, 65) == 2);
+  max = accum.get_max(7, 0);
+  BOOST_TEST(max.first == 500);
+  BOOST_TEST(max.second == 4);
+
+  accum.set(5, 67, 10);
+  max = accum.get_max(5, 0);
+  BOOST_TEST(max.first == 67);
+  BOOST_TEST(max.second == 10);
+  accum.decrement(5, 67, 68);
+  BOOST_TEST(accum.get(5, 67) == 9);
+
+  accum.init(32, 0, 100);
+  BOOST_TEST(accum.n_tiles() == 0U);
+  BOOST_TEST(accum.get(5, 67) == 0);
+  BOOST_TEST(accum.get(7, 500) == 0);
+
+  // same shape: the storage is reused, and the counters start from 0 again
+  accum.increment_and_get_max(5, 0, 100, 0);
+  accum.init(32, 0, 100);
+  BOOST_TEST(accum.n_tiles() == 0U);
+  for (int key = 0; key < 100; ++key)
+    BOOST_TEST(accum.get(5, key) == 0);
+} // BOOST_AUTO_TEST_CASE(RangeTest)
+
+
+//------------------------------------------------------------------------------
+namespace {
+
+  /// Fills dense (already initialized) and a map with the same points
+  void
+  CompareWithMap(Dense_t& dense, unsigned int seed)
+  {
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<int> wire(0, Dx), tick(0, Dy);
+    std::uniform_int_distribution<int> step(-3, 3);
+
+    unsigned int const rowLength =
+      (unsigned int)(RhoResolutionFactor * 2 * std::sqrt(Dx * Dx + Dy * Dy));
+    MapAccumulator reference;
+
+    // some lines of hits and some noise
+    std::vector<std::pair<int, int>> points;
+    for (int line = 0; line < 5; ++line) {
+      int x = wire(engine), y = tick(engine);
+      int const dy = step(engine);
+      for (int i = 0; i < 40 && x <= Dx && y >= 0 && y <= Dy; ++i, ++x, y += dy)
+        points.emplace_back(x, y);
+    }
+    for (int i = 0; i < 100; ++i)
+      points.emplace_back(wire(engine), tick(engine));
+    std::shuffle(points.begin(), points.end(), engine);
+
+    for (auto const& point : points) {
+      auto const denseMax = AddPoint(dense, point.first, point.second, false);
+      auto const refMax = AddPoint(reference, point.first, point.second, false);
+      BOOST_TEST(denseMax == refMax);
+    }
+    // remove a few
+    for (std::size_t i = 0; i < points.size(); i += 7) {
+      AddPoint(dense, points[i].first, points[i].second, true);
+      AddPoint(reference, points[i].first, points[i].second, true);
+    }
+
+    // all the counters touched by the map, and none else, are the same
+    int nNonZero = 0;
+    for (auto const& angle : reference.accum()) {
+      Counter_t refMaxValue = -1;
+      int refMaxKey = -1;
+      for (auto const& counter : angle.second) {
+        BOOST_TEST(dense.get(angle.first, counter.first) == counter.second);
+        if (counter.second != 0) ++nNonZero;
+        if (counter.second > refMaxValue) {
+          refMaxValue = counter.second;
+          refMaxKey = counter.first;
+        }
+      }
+      auto const denseMax = dense.get_max(angle.first, -1);
+      BOOST_TEST(denseMax.second == refMaxValue);
+      BOOST_TEST(denseMax.first == refMaxKey);
+    } // for angles
+    for (unsigned int angle = 0; angle < NumAngleCells; ++angle) {
+      for (int key = -2; key < (int)rowLength + 3; ++key)
+        if (dense.get(angle, key) != 0) --nNonZero;
+    }
+    BOOST_TEST(nNonZero == 0);
+  } // CompareWithMap()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MapComparisonTest)
+{
+  unsigned int const rowLength =
+    (unsigned int)(RhoResolutionFactor * 2 * std::sqrt(Dx * Dx + Dy * Dy));
+  Dense_t dense;
+  dense.init(NumAngleCells, -2, rowLength + 3);
+  CompareWithMap(dense, 13579);
+
+  // the same storage, reused
+  dense.init(NumAngleCells, -2, rowLength + 3);
+  CompareWithMap(dense, 24680);
+} // BOOST_AUTO_TEST_CASE(MapComparisonTest)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ExtensionTest)
+{
+  // a range much narrower than the distances: the accumulator has to extend
+  // itself on both sides, and still match the map
+  unsigned int const rowLength =
+    (unsigned int)(RhoResolutionFactor * 2 * std::sqrt(Dx * Dx + Dy * Dy));
+  Dense_t dense;
+  dense.init(NumAngleCells, rowLength / 2, rowLength / 2 + 1);
+  CompareWithMap(dense, 13579);
+} // BOOST_AUTO_TEST_CASE(ExtensionTest)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,289 @@
+/**
+ * @file   MultiGausFitter_test.cc
+ * @brief  Test and benchmark of hit::MultiGausFitter
+ * @see    MultiGausFitter.h
+ *
+ * The fit results are compared with the ones of the fitters used by the
+ * PeakFitterGaussian (ROOT, via hit::GausFitCache) and PeakFitterMrqdt
+ * (gshf::MarqFitAlg) tools, on a sample of simulated regions of interest
+ * with one to four overlapping pulses on a noisy baseline.
+ * The time spent by each fitter is printed.
+ */
+
+// C/C++ standard libraries
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// boost test libraries
+#define BOOST_TEST_MODULE ( MultiGausFitter_test )
+#include "cetlib/quiet_unit_test.hpp"
+
+// ROOT libraries
+#include "TF1.h"
+#include "TH1F.h"
+
+// LArSoft libraries
+#include "lardata/Utilities/MarqFitAlg.h"
+#include "larreco/RecoAlg/GausFitCache.h"
+#include "larreco/RecoAlg/MultiGausFitter.h"
+
+
+namespace {
+
+  template <typename T>
+  inline T sqr(T v) { return v*v; }
+
+  /// A simulated ROI with the true parameters of its pulses
+  struct TestROI {
+    std::vector<float> samples;
+    std::vector<double> params; ///< amplitude, mean, sigma for each pulse
+    std::size_t NGaus() const { return params.size() / 3; }
+  }; // struct TestROI
+
+
+  /// Creates `nROIs` ROIs with well separated enough pulses and noise
+  std::vector<TestROI> MakeROIs(std::size_t nROIs, unsigned int seed = 12345) {
+    std::mt19937 engine(seed);
+    std::uniform_int_distribution<std::size_t> nGausDist(1, 4);
+    std::uniform_real_distribution<double> ampDist(15., 80.);
+    std::uniform_real_distribution<double> sigmaDist(2., 5.);
+    std::normal_distribution<float> noise(0., 1.);
+
+    std::vector<TestROI> rois(nROIs);
+    for (TestROI& roi: rois) {
+      std::size_t const nGaus = nGausDist(engine);
+      double mean = 10.;
+      for (std::size_t iGaus = 0; iGaus < nGaus; ++iGaus) {
+        double const sigma = sigmaDist(engine);
+        roi.params.push_back(ampDist(engine));
+        roi.params.push_back(mean);
+        roi.params.push_back(sigma);
+        mean += 3. * sigma;
+      }
+      roi.samples.resize(std::size_t(mean + 10.));
+      for (std::size_t i = 0; i < roi.samples.size(); ++i) {
+        double const x = i + 0.5;
+        double value = noise(engine);
+        for (std::size_t iPar = 0; iPar < roi.params.size(); iPar += 3) {
+          value += roi.params[iPar]
+            * std::exp(-0.5 * sqr((x - roi.params[iPar + 1]) / roi.params[iPar + 2]));
+        }
+        roi.samples[i] = value;
+      }
+    } // for ROIs
+    return rois;
+  } // MakeROIs()
+
+
+  /// Starting values slightly off the truth, like candidate hit finders do
+  double StartValue(TestROI const& roi, std::size_t iPar) {
+    switch (iPar % 3) {
+      case 0: return roi.params[iPar] * 0.9;
+      case 1: return roi.params[iPar] + 0.5;
+      default: return roi.params[iPar] * 1.2;
+    }
+  } // StartValue()
+
+
+  //----------------------------------------------------------------------------
+  /// Fits with MultiGausFitter; fills `result` with amplitude, mean, sigma...
+  bool FitLM(hit::MultiGausFitter const& fitter, TestROI const& roi,
+             std::vector<double>& result, std::vector<double>& errors)
+  {
+    hit::MultiGausFitter::Parameters_t params;
+    params.nGaus = roi.NGaus();
+    for (std::size_t iGaus = 0; iGaus < roi.NGaus(); ++iGaus) {
+      double const amp = StartValue(roi, 3 * iGaus);
+      double const mean = StartValue(roi, 3 * iGaus + 1);
+      double const sigma = StartValue(roi, 3 * iGaus + 2);
+      params.SetGaussian(iGaus,
+        amp, 0.1 * amp, 2. * amp,
+        mean, mean - 2. * sigma, mean + 2. * sigma,
+        sigma, std::max(0.5, 0.1 * sigma), 3. * sigma);
+    }
+    auto const res = fitter.Fit
+      (roi.samples.data(), roi.samples.data() + roi.samples.size(), params);
+    result.assign(params.value.begin(), params.value.begin() + 3 * params.nGaus);
+    errors.assign(params.error.begin(), params.error.begin() + 3 * params.nGaus);
+    return res.valid;
+  } // FitLM()
+
+
+  /// Fits with MarqFitAlg the way PeakFitterMrqdt does
+  bool FitMrqdt(TestROI const& roi, std::vector<double>& result) {
+    gshf::MarqFitAlg marqFitAlg;
+    int const nParams = roi.params.size();
+    int const nData = roi.samples.size();
+    std::vector<float> y(roi.samples);
+    std::vector<float> p(nParams), plimmin(nParams), plimmax(nParams);
+    for (int iPar = 0; iPar < nParams; iPar += 3) {
+      double const amp = StartValue(roi, iPar);
+      double const mean = StartValue(roi, iPar + 1) - 0.5; // bin width shift
+      double const sigma = StartValue(roi, iPar + 2);
+      p[iPar] = amp;
+      plimmin[iPar] = 0.1 * amp;
+      plimmax[iPar] = 2. * amp;
+      p[iPar + 1] = mean;
+      plimmin[iPar + 1] = mean - 2. * sigma;
+      plimmax[iPar + 1] = mean + 2. * sigma;
+      p[iPar + 2] = sigma;
+      plimmin[iPar + 2] = std::max(0.5, 0.1 * sigma);
+      plimmax[iPar + 2] = 3. * sigma;
+    }
+    float lambda = -1.;
+    float chiSqr = 0., dchiSqr = 0.;
+    int fitResult = -1;
+    int trial = 0;
+    do {
+      fitResult = marqFitAlg.mrqdtfit(lambda, &p[0], &plimmin[0], &plimmax[0],
+        &y[0], nParams, nData, chiSqr, dchiSqr);
+      if (fitResult || (++trial > 100)) break;
+    } while (std::abs(dchiSqr) >= 1e-3);
+    result.assign(p.begin(), p.end());
+    for (int iPar = 1; iPar < nParams; iPar += 3) result[iPar] += 0.5;
+    return fitResult == 0;
+  } // FitMrqdt()
+
+
+  /// Fits with ROOT the way PeakFitterGaussian does
+  bool FitROOT(hit::GausFitCache& cache, TestROI const& roi, std::vector<double>& result) {
+    int const nData = roi.samples.size();
+    TH1F hist("MultiGausFitterTestHist", "", nData, 0., nData);
+    hist.SetDirectory(nullptr);
+    for (int i = 0; i < nData; ++i) hist.SetBinContent(i + 1, roi.samples[i]);
+    TF1& func = *(cache.Get(roi.NGaus()));
+    for (std::size_t iPar = 0; iPar < roi.params.size(); iPar += 3) {
+      double const amp = StartValue(roi, iPar);
+      double const mean = StartValue(roi, iPar + 1);
+      double const sigma = StartValue(roi, iPar + 2);
+      func.SetParameter(iPar, amp);
+      func.SetParameter(iPar + 1, mean);
+      func.SetParameter(iPar + 2, sigma);
+      func.SetParLimits(iPar, 0.1 * amp, 2. * amp);
+      func.SetParLimits(iPar + 1, mean - 2. * sigma, mean + 2. * sigma);
+      func.SetParLimits(iPar + 2, std::max(0.5, 0.1 * sigma), 3. * sigma);
+    }
+    int const fitResult = hist.Fit(&func, "QNWB", "", 0., nData);
+    result.resize(roi.params.size());
+    for (std::size_t iPar = 0; iPar < result.size(); ++iPar)
+      result[iPar] = func.GetParameter(iPar);
+    return fitResult == 0;
+  } // FitROOT()
+
+
+  /// Checks that two fits agree well within the statistical errors
+  void CheckCompatible(
+    std::vector<double> const& a, std::vector<double> const& errors,
+    std::vector<double> const& b
+  ) {
+    BOOST_REQUIRE_EQUAL(a.size(), b.size());
+    for (std::size_t iPar = 0; iPar < a.size(); ++iPar)
+      BOOST_CHECK_SMALL(a[iPar] - b[iPar], 0.2 * errors[iPar] + 1e-3);
+  } // CheckCompatible()
+
+} // local namespace
+
+
+//******************************************************************************
+BOOST_AUTO_TEST_SUITE( MultiGausFitterSuite )
+
+//******************************************************************************
+// fit of noiseless pulses recovers the exact parameters
+BOOST_AUTO_TEST_CASE(NoiselessFitTest)
+{
+  hit::MultiGausFitter const fitter;
+
+  std::vector<float> samples(60);
+  for (std::size_t i = 0; i < samples.size(); ++i) {
+    double const x = i + 0.5;
+    samples[i] = 30. * std::exp(-0.5 * sqr((x - 20.) / 3.))
+      + 15. * std::exp(-0.5 * sqr((x - 29.) / 4.)) + 2.;
+  }
+
+  hit::MultiGausFitter::Parameters_t params;
+  params.nGaus = 2;
+  params.floatBaseline = true;
+  params.SetGaussian(0, 25., 2.5, 50., 21., 15., 27., 2.5, 0.5, 7.5);
+  params.SetGaussian(1, 12., 1.2, 24., 28., 20., 36., 3.5, 0.5, 10.5);
+  params.SetBaseline(0., -12., 12.);
+
+  auto const res = fitter.Fit(samples.data(), samples.data() + samples.size(), params);
+  BOOST_REQUIRE(res.valid);
+  BOOST_CHECK_EQUAL(res.NDF, 60 - 7);
+  BOOST_CHECK_SMALL(res.chi2, 1e-6);
+  BOOST_CHECK_CLOSE(params.value[0], 30., 1e-3);
+  BOOST_CHECK_CLOSE(params.value[1], 20., 1e-3);
+  BOOST_CHECK_CLOSE(params.value[2],  3., 1e-3);
+  BOOST_CHECK_CLOSE(params.value[3], 15., 1e-3);
+  BOOST_CHECK_CLOSE(params.value[4], 29., 1e-3);
+  BOOST_CHECK_CLOSE(params.value[5],  4., 1e-3);
+  BOOST_CHECK_CLOSE(params.value[6],  2., 1e-3);
+
+} // NoiselessFitTest
+
+
+//******************************************************************************
+// too many Gaussians, or too few samples, are rejected
+BOOST_AUTO_TEST_CASE(InvalidFitTest)
+{
+  hit::MultiGausFitter const fitter;
+  std::vector<float> samples(10, 1.);
+
+  hit::MultiGausFitter::Parameters_t params;
+  params.nGaus = 4;
+  BOOST_CHECK(!fitter.Fit(samples.data(), samples.data() + samples.size(), params).valid);
+
+  params.nGaus = hit::MultiGausFitter::MaxGaussians + 1;
+  BOOST_CHECK(!fitter.Fit(samples.data(), samples.data() + samples.size(), params).valid);
+
+} // InvalidFitTest
+
+
+//******************************************************************************
+// comparison with the other fitters, and timing
+BOOST_AUTO_TEST_CASE(CompareFittersTest)
+{
+  std::vector<TestROI> const rois = MakeROIs(2000);
+
+  hit::MultiGausFitter const fitter;
+  hit::GausFitCache cache("MultiGausFitterTestCache");
+
+  using clock_t = std::chrono::steady_clock;
+  std::chrono::duration<double> timeLM{0}, timeMrqdt{0}, timeROOT{0};
+
+  std::vector<double> resLM, errLM, resMrqdt, resROOT;
+  unsigned int nValidLM = 0;
+  for (TestROI const& roi: rois) {
+    auto start = clock_t::now();
+    bool const validLM = FitLM(fitter, roi, resLM, errLM);
+    timeLM += clock_t::now() - start;
+
+    start = clock_t::now();
+    bool const validMrqdt = FitMrqdt(roi, resMrqdt);
+    timeMrqdt += clock_t::now() - start;
+
+    start = clock_t::now();
+    bool const validROOT = FitROOT(cache, roi, resROOT);
+    timeROOT += clock_t::now() - start;
+
+    if (!validLM) continue;
+    ++nValidLM;
+    if (validROOT) CheckCompatible(resLM, errLM, resROOT);
+    if (validMrqdt) CheckCompatible(resLM, errLM, resMrqdt);
+  } // for
+
+  // all these pulses are easy to fit
+  BOOST_CHECK_EQUAL(nValidLM, rois.size());
+
+  std::cout << "Fit of " << rois.size() << " ROIs:"
+    << "\n  MultiGausFitter: " << timeLM.count() << " s"
+    << "\n  MarqFitAlg:      " << timeMrqdt.count() << " s"
+    << "\n  ROOT:            " << timeROOT.count() << " s"
+    << std::endl;
+
+} // CompareFittersTest
+
+BOOST_AUTO_TEST_SUITE_END()
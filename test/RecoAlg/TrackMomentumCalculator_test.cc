@@ -0,0 +1,160 @@
+/**
+ * @file   TrackMomentumCalculator_test.cc
+ * @brief  Test of the multiple Coulomb scattering momentum estimates
+ * @see    TrackMomentumCalculator.h
+ *
+ * Muon-like trajectories are simulated with Gaussian scattering angles of the
+ * Highland width, and the chi2 and likelihood estimates of
+ * `trkf::TrackMomentumCalculator` are checked to follow the true momentum.
+ * The same calculator is then shared by several threads, which must reproduce
+ * the serial results.
+ */
+
+// C/C++ standard libraries
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+// boost test libraries
+#define BOOST_TEST_MODULE ( TrackMomentumCalculator_test )
+#include "cetlib/quiet_unit_test.hpp"
+
+// LArSoft libraries
+#include "larreco/RecoAlg/TrackMomentumCalculator.h"
+
+
+namespace {
+
+  using Point_t = trkf::TrackMomentumCalculator::Point_t;
+
+  constexpr double Step = 0.3;      ///< [cm] distance between trajectory points
+  constexpr double Smearing = 0.03; ///< [cm] position resolution
+  constexpr double dEdx = 0.0021;   ///< [GeV/cm]
+  constexpr double RadLength = 14.; ///< [cm]
+
+
+  /// Trajectory of a muon of momentum `p` [GeV/c] over `length` [cm]
+  std::vector<Point_t> MakeTrajectory(std::mt19937& engine, double p, double length)
+  {
+    std::normal_distribution<double> gaus(0., 1.);
+    double x = 0., y = 0., z = 0.;
+    double dx = 0.6, dy = 0., dz = 0.8;
+    std::vector<Point_t> points;
+    for (double s = 0.; s < length && p > 0.12; s += Step) {
+      points.emplace_back(x + Smearing * gaus(engine), y + Smearing * gaus(engine),
+                          z + Smearing * gaus(engine));
+      x += Step * dx;
+      y += Step * dy;
+      z += Step * dz;
+      p -= dEdx * Step;
+
+      double const l0 = Step / RadLength;
+      double const theta0 = 0.0136 / p * std::sqrt(l0) * (1. + 0.038 * std::log(l0));
+      // kick the direction along two axes orthogonal to it
+      double const ux = -dy, uy = dx; // z x (dx, dy, dz), unnormalized
+      double const un = std::hypot(ux, uy);
+      double const vx = -dz * uy / un, vy = dz * ux / un, vz = (dx * uy - dy * ux) / un;
+      double const a = theta0 * gaus(engine), b = theta0 * gaus(engine);
+      dx += a * ux / un + b * vx;
+      dy += a * uy / un + b * vy;
+      dz += b * vz;
+      double const norm = std::sqrt(dx * dx + dy * dy + dz * dz);
+      dx /= norm;
+      dy /= norm;
+      dz /= norm;
+    }
+    return points;
+  } // MakeTrajectory()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE( TrackMomentumCalculatorSuite )
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ShortTrackTest)
+{
+  trkf::TrackMomentumCalculator const tmc;
+  std::mt19937 engine(1357);
+  auto const points = MakeTrajectory(engine, 1., 50.); // below the minimum length
+  BOOST_TEST(tmc.GetMomentumMultiScatterChi2(points) == -1.);
+  BOOST_TEST(tmc.GetMomentumMultiScatterLLHD(points) == -1.);
+  BOOST_TEST(tmc.GetMomentumMultiScatterChi2(std::vector<Point_t>{points.front()}) == -1.);
+} // BOOST_AUTO_TEST_CASE(ShortTrackTest)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(MomentumScaleTest)
+{
+  trkf::TrackMomentumCalculator const tmc;
+  std::mt19937 engine(2468);
+
+  constexpr unsigned int nTracks = 20;
+  double chi2Low = 0., chi2High = 0., llhdLow = 0., llhdHigh = 0.;
+  for (unsigned int i = 0; i < nTracks; ++i) {
+    auto const low = MakeTrajectory(engine, 0.6, 400.);
+    auto const high = MakeTrajectory(engine, 2.0, 400.);
+    double const pChi2Low = tmc.GetMomentumMultiScatterChi2(low);
+    double const pChi2High = tmc.GetMomentumMultiScatterChi2(high);
+    double const pLLHDLow = tmc.GetMomentumMultiScatterLLHD(low);
+    double const pLLHDHigh = tmc.GetMomentumMultiScatterLLHD(high);
+    BOOST_TEST(pChi2Low > 0.);
+    BOOST_TEST(pChi2High > 0.);
+    BOOST_TEST(pLLHDLow > 0.);
+    BOOST_TEST(pLLHDHigh > 0.);
+    chi2Low += pChi2Low;
+    chi2High += pChi2High;
+    llhdLow += pLLHDLow;
+    llhdHigh += pLLHDHigh;
+  }
+  BOOST_TEST(chi2Low < chi2High);
+  BOOST_TEST(llhdLow < llhdHigh);
+  BOOST_TEST(chi2Low / nTracks < 1.5);
+  BOOST_TEST(llhdLow / nTracks < 1.5);
+
+  // the starting point favours the direction the muon was going
+  auto const points = MakeTrajectory(engine, 0.5, 200.);
+  BOOST_TEST(tmc.GetMuMultiScatterLLHD3(points, true) < tmc.GetMuMultiScatterLLHD3(points, false));
+} // BOOST_AUTO_TEST_CASE(MomentumScaleTest)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ConcurrencyTest)
+{
+  trkf::TrackMomentumCalculator const tmc;
+  std::mt19937 engine(97531);
+  std::uniform_real_distribution<double> momentum(0.4, 3.), length(150., 600.);
+
+  std::vector<std::vector<Point_t>> tracks;
+  std::vector<double> chi2, llhd;
+  for (unsigned int i = 0; i < 32; ++i) {
+    tracks.push_back(MakeTrajectory(engine, momentum(engine), length(engine)));
+    chi2.push_back(tmc.GetMomentumMultiScatterChi2(tracks.back()));
+    llhd.push_back(tmc.GetMomentumMultiScatterLLHD(tracks.back()));
+  }
+
+  constexpr unsigned int nThreads = 4;
+  std::vector<double> chi2Threaded(tracks.size()), llhdThreaded(tracks.size());
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < nThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (std::size_t i = t; i < tracks.size(); i += nThreads) {
+        chi2Threaded[i] = tmc.GetMomentumMultiScatterChi2(tracks[i]);
+        llhdThreaded[i] = tmc.GetMomentumMultiScatterLLHD(tracks[i]);
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  for (std::size_t i = 0; i < tracks.size(); ++i) {
+    BOOST_TEST(chi2Threaded[i] == chi2[i]);
+    BOOST_TEST(llhdThreaded[i] == llhd[i]);
+  }
+} // BOOST_AUTO_TEST_CASE(ConcurrencyTest)
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_SUITE_END()